@@ -0,0 +1,214 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "ChannelSnapshotManager.h"
+#include "EngineManager.h"
+
+
+using namespace Core;
+
+// constructor
+ChannelSnapshotManager::ChannelSnapshotManager()
+{
+}
+
+
+// destructor
+ChannelSnapshotManager::~ChannelSnapshotManager()
+{
+	mLock.Lock();
+	DestructArray(mSnapshots);
+	mLock.Unlock();
+}
+
+
+// get a snapshot holding at least the given number of samples
+ChannelSnapshot* ChannelSnapshotManager::Request(Channel<double>* channel, uint32 maxNumSamples)
+{
+	if (channel == NULL)
+		return NULL;
+
+	mLock.Lock();
+
+	// share an existing snapshot that is large enough
+	uint32 largestNumSamples = maxNumSamples;
+	const uint32 numSnapshots = mSnapshots.Size();
+	for (uint32 i=0; i<numSnapshots; ++i)
+	{
+		ChannelSnapshot* snapshot = mSnapshots[i];
+		if (snapshot->GetChannel() != channel)
+			continue;
+
+		if (snapshot->GetMaxNumSamples() >= maxNumSamples)
+		{
+			snapshot->mNumReferences++;
+			mLock.Unlock();
+			return snapshot;
+		}
+
+		largestNumSamples = Max<uint32>(largestNumSamples, snapshot->GetMaxNumSamples());
+	}
+
+	// the capacity of a snapshot is fixed (readers don't lock), so create a new one for larger requests
+	ChannelSnapshot* snapshot = new ChannelSnapshot(channel, largestNumSamples);
+	snapshot->mNumReferences = 1;
+	snapshot->Capture();
+	mSnapshots.Add(snapshot);
+
+	mLock.Unlock();
+	return snapshot;
+}
+
+
+// release a snapshot, it is destroyed together with the last reference
+void ChannelSnapshotManager::Release(ChannelSnapshot* snapshot)
+{
+	if (snapshot == NULL)
+		return;
+
+	mLock.Lock();
+
+	const uint32 index = mSnapshots.Find(snapshot);
+	if (index != CORE_INVALIDINDEX32)
+	{
+		snapshot->mNumReferences--;
+		if (snapshot->mNumReferences == 0)
+		{
+			mSnapshots.Remove(index);
+			delete snapshot;
+		}
+	}
+
+	mLock.Unlock();
+}
+
+
+// capture all snapshots
+void ChannelSnapshotManager::Update()
+{
+	mLock.Lock();
+
+	const uint32 numSnapshots = mSnapshots.Size();
+	for (uint32 i=0; i<numSnapshots; ++i)
+		mSnapshots[i]->Capture();
+
+	mLock.Unlock();
+}
+
+
+// detach all snapshots of the given channel
+void ChannelSnapshotManager::OnChannelDestroyed(ChannelBase* channel)
+{
+	mLock.Lock();
+
+	const uint32 numSnapshots = mSnapshots.Size();
+	for (uint32 i=0; i<numSnapshots; ++i)
+	{
+		if (mSnapshots[i]->mChannel == channel)
+			mSnapshots[i]->mChannel = NULL;
+	}
+
+	mLock.Unlock();
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// get the snapshot of the channel
+ChannelSnapshot* ChannelSnapshotSet::Get(Channel<double>* channel, uint32 maxNumSamples)
+{
+	if (channel == NULL)
+		return NULL;
+
+	ChannelSnapshotManager* manager = GetEngine()->GetChannelSnapshotManager();
+
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		Entry& entry = mEntries[i];
+		if (entry.mChannel != channel)
+			continue;
+
+		// reuse the snapshot unless it is too small or was detached (a new channel may live at the address of a destroyed one)
+		if (entry.mSnapshot->GetChannel() != channel || entry.mSnapshot->GetMaxNumSamples() < maxNumSamples)
+		{
+			manager->Release(entry.mSnapshot);
+			entry.mSnapshot = manager->Request(channel, maxNumSamples);
+		}
+
+		entry.mIsUsed = true;
+		return entry.mSnapshot;
+	}
+
+	Entry entry;
+	entry.mChannel	= channel;
+	entry.mSnapshot	= manager->Request(channel, maxNumSamples);
+	entry.mIsUsed	= true;
+	mEntries.Add(entry);
+
+	return entry.mSnapshot;
+}
+
+
+// release the snapshots that were not used since the last call
+void ChannelSnapshotSet::ReleaseUnused()
+{
+	ChannelSnapshotManager* manager = GetEngine()->GetChannelSnapshotManager();
+
+	for (uint32 i=0; i<mEntries.Size(); )
+	{
+		if (mEntries[i].mIsUsed == false)
+		{
+			manager->Release(mEntries[i].mSnapshot);
+			mEntries.Remove(i);
+		}
+		else
+		{
+			mEntries[i].mIsUsed = false;
+			++i;
+		}
+	}
+}
+
+
+void ChannelSnapshotSet::Clear()
+{
+	if (mEntries.IsEmpty() == true)
+		return;
+
+	// the engine may be shut down already
+	if (GetEngine() == NULL || GetEngine()->GetChannelSnapshotManager() == NULL)
+	{
+		mEntries.Clear();
+		return;
+	}
+
+	ChannelSnapshotManager* manager = GetEngine()->GetChannelSnapshotManager();
+
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+		manager->Release(mEntries[i].mSnapshot);
+
+	mEntries.Clear();
+}
@@ -0,0 +1,90 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_CHANNELSNAPSHOTMANAGER_H
+#define __NEUROMORE_CHANNELSNAPSHOTMANAGER_H
+
+// include required headers
+#include "Config.h"
+#include "Core/Array.h"
+#include "Core/Mutex.h"
+#include "DSP/ChannelSnapshot.h"
+
+
+// keeps the requested channel snapshots up to date
+//  - the engine captures all snapshots at the end of each update
+//  - snapshots are reference counted, request and release them from the thread that owns the engine lock (e.g. the UI thread while processing events)
+//  - a snapshot outlives its channel: it is detached when the channel is destroyed and keeps the last frame until it is released
+class ENGINE_API ChannelSnapshotManager
+{
+	public:
+		// constructor & destructor
+		ChannelSnapshotManager();
+		virtual ~ChannelSnapshotManager();
+
+		// get a snapshot holding at least the given number of samples (captures the channel right away)
+		ChannelSnapshot* Request(Channel<double>* channel, uint32 maxNumSamples);
+		void Release(ChannelSnapshot* snapshot);
+
+		// capture all snapshots (called by the engine after each update)
+		void Update();
+
+		// detach all snapshots of the given channel (called by the channel destructor)
+		void OnChannelDestroyed(ChannelBase* channel);
+
+		uint32 GetNumSnapshots() const												{ return mSnapshots.Size(); }
+
+	private:
+		Core::Array<ChannelSnapshot*>	mSnapshots;
+		Core::Mutex						mLock;
+};
+
+
+// the snapshots of a changing list of channels, e.g. the channels displayed by a widget
+class ENGINE_API ChannelSnapshotSet
+{
+	public:
+		// constructor & destructor
+		ChannelSnapshotSet()														{}
+		~ChannelSnapshotSet()														{ Clear(); }
+
+		// get the snapshot of the channel, it is requested in case it is not part of the set yet
+		ChannelSnapshot* Get(Channel<double>* channel, uint32 maxNumSamples);
+
+		// release the snapshots that were not used by Get() since the last call
+		void ReleaseUnused();
+		void Clear();
+
+	private:
+		struct Entry
+		{
+			Channel<double>*	mChannel;
+			ChannelSnapshot*	mSnapshot;
+			bool				mIsUsed;
+		};
+
+		Core::Array<Entry>		mEntries;
+};
+
+
+#endif
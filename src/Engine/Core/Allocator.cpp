@@ -0,0 +1,601 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include the required headers
+#include "StandardHeaders.h"
+#include <atomic>
+#include <mutex>
+
+
+namespace Core
+{
+
+//////////////////////////////////////////////////////////////////////////
+// block layout
+
+enum
+{
+	HEADER_SIZE			= 16,
+	NUM_SIZECLASSES		= 15,
+	MAX_POOLED_SIZE		= 1024,			// header included
+	SLAB_SIZE			= 64 * 1024,
+	MAX_CACHED_BLOCKS	= 256,			// per thread and size class, half of them go back to the depot if exceeded
+	MAX_BACKENDS		= 4,
+	INVALID_SIZECLASS	= 0xFF
+};
+
+// block sizes of the pools (header included)
+static constexpr uint32 gSizeClasses[NUM_SIZECLASSES] = { 32, 48, 64, 80, 96, 128, 160, 192, 256, 320, 384, 512, 640, 768, 1024 };
+
+// maps (size+15)/16 to the smallest size class that fits
+struct SizeClassTable
+{
+	uint8 mClass[MAX_POOLED_SIZE/16 + 1];
+
+	constexpr SizeClassTable() : mClass()
+	{
+		uint32 sizeClass = 0;
+		for (uint32 i=0; i<=MAX_POOLED_SIZE/16; ++i)
+		{
+			while (gSizeClasses[sizeClass] < i*16)
+				sizeClass++;
+			mClass[i] = (uint8)sizeClass;
+		}
+	}
+};
+
+static constexpr SizeClassTable gSizeClassTable;
+
+// precedes every block
+struct BlockHeader
+{
+	uint64	mNumBytes;		// requested size
+	uint8	mTag;
+	uint8	mSizeClass;		// INVALID_SIZECLASS for blocks from the backend
+	uint8	mBackend;		// backend of large blocks
+	uint8	mPadding[5];
+};
+
+static_assert(sizeof(BlockHeader) == HEADER_SIZE, "block header must keep the 16 byte alignment");
+
+inline BlockHeader* GetHeader(void* memory)			{ return reinterpret_cast<BlockHeader*>(static_cast<uint8*>(memory) - HEADER_SIZE); }
+inline void* GetMemory(BlockHeader* header)			{ return reinterpret_cast<uint8*>(header) + HEADER_SIZE; }
+
+
+//////////////////////////////////////////////////////////////////////////
+// backends
+
+static void* DefaultAllocate(size_t numBytes, void* userData)				{ return malloc(numBytes); }
+static void* DefaultRealloc(void* memory, size_t numBytes, void* userData)	{ return realloc(memory, numBytes); }
+static void DefaultFree(void* memory, void* userData)						{ free(memory); }
+
+static AllocatorBackend		gBackends[MAX_BACKENDS] = { { DefaultAllocate, DefaultRealloc, DefaultFree, NULL } };
+static std::atomic<uint32>	gNumBackends(1);
+
+
+bool SetAllocatorBackend(const AllocatorBackend& backend)
+{
+	if (backend.mAllocate == NULL || backend.mFree == NULL)
+		return false;
+
+	// the slot is written before it is published, readers only see complete backends
+	const uint32 index = gNumBackends.load(std::memory_order_relaxed);
+	if (index >= MAX_BACKENDS)
+		return false;
+
+	gBackends[index] = backend;
+	gNumBackends.store(index + 1, std::memory_order_release);
+	return true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// thread state
+
+enum
+{
+	COUNTER_LIVEBYTES = 0,
+	COUNTER_LIVEALLOCATIONS,
+	COUNTER_ALLOCATIONS,
+	COUNTER_REALLOCATIONS,
+	COUNTER_FREES,
+	COUNTER_REALTIMEALLOCATIONS,
+	NUM_COUNTERS
+};
+
+// accounting of one thread; only the owning thread writes, so plain load/store is enough and readers see a consistent value per counter
+struct Counters
+{
+	std::atomic<int64> mValues[NUM_MEMORYTAGS][NUM_COUNTERS];
+};
+
+struct FreeBlock
+{
+	FreeBlock* mNext;
+};
+
+// per-thread free lists and counters; both are handed over to the globals when the thread exits
+// note: trivially constructible, so the hot path accesses it without a thread_local init guard
+struct ThreadCache
+{
+	FreeBlock*		mLists[NUM_SIZECLASSES];
+	uint32			mSizes[NUM_SIZECLASSES];
+	Counters		mCounters;
+	ThreadCache*	mPrev;
+	ThreadCache*	mNext;
+	uint8			mState;
+};
+
+// returns the cache of its thread on thread exit
+struct ThreadCacheOwner
+{
+	~ThreadCacheOwner();
+};
+
+// protects the depot, the thread list and the counters of exited threads
+static std::mutex		gMutex;
+static FreeBlock*		gDepotLists[NUM_SIZECLASSES];	// surplus of the thread caches and blocks of exited threads
+static ThreadCache*		gThreadCaches = NULL;
+static Counters			gExitedCounters;
+static std::atomic<bool> gRealtimeAssert(false);
+
+enum { CACHE_UNINITIALIZED = 0, CACHE_ALIVE = 1, CACHE_DESTROYED = 2 };
+static thread_local ThreadCache			tCache;
+static thread_local ThreadCacheOwner	tCacheOwner;
+static thread_local uint8				tMemoryTag = MEMORYTAG_GENERAL;
+static thread_local bool				tIsRealtimeThread = false;
+
+
+static ThreadCache* InitThreadCache();
+
+// the cache of the current thread, NULL while the thread is shutting down
+static inline ThreadCache* GetThreadCache()
+{
+	if (tCache.mState == CACHE_ALIVE)
+		return &tCache;
+	return InitThreadCache();
+}
+
+
+static void AddExitedCounter(uint32 tag, uint32 counter, int64 value)
+{
+	std::lock_guard<std::mutex> lock(gMutex);
+	std::atomic<int64>& target = gExitedCounters.mValues[tag][counter];
+	target.store(target.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+
+static inline void AddCounter(ThreadCache* cache, uint32 tag, uint32 counter, int64 value)
+{
+	if (cache == NULL)
+	{
+		AddExitedCounter(tag, counter, value);
+		return;
+	}
+
+	std::atomic<int64>& target = cache->mCounters.mValues[tag][counter];
+	target.store(target.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+
+// move up to numBlocks blocks from the front of a list to the depot
+static void ReleaseToDepot(uint32 sizeClass, FreeBlock*& list, uint32& listSize, uint32 numBlocks)
+{
+	if (numBlocks == 0 || list == NULL)
+		return;
+
+	FreeBlock* first = list;
+	FreeBlock* last = list;
+	uint32 numMoved = 1;
+	while (numMoved < numBlocks && last->mNext != NULL)
+	{
+		last = last->mNext;
+		numMoved++;
+	}
+
+	list = last->mNext;
+	listSize -= numMoved;
+
+	std::lock_guard<std::mutex> lock(gMutex);
+	last->mNext = gDepotLists[sizeClass];
+	gDepotLists[sizeClass] = first;
+}
+
+
+// register the cache of the current thread on its first allocation
+static ThreadCache* InitThreadCache()
+{
+	ThreadCache* cache = &tCache;
+	if (cache->mState == CACHE_DESTROYED)
+		return NULL;
+
+	{
+		std::lock_guard<std::mutex> lock(gMutex);
+		cache->mPrev = NULL;
+		cache->mNext = gThreadCaches;
+		if (gThreadCaches != NULL)
+			gThreadCaches->mPrev = cache;
+		gThreadCaches = cache;
+	}
+
+	// construct the owner, so its destructor runs on thread exit
+	(void)&tCacheOwner;
+
+	cache->mState = CACHE_ALIVE;
+	return cache;
+}
+
+
+ThreadCacheOwner::~ThreadCacheOwner()
+{
+	ThreadCache* cache = &tCache;
+	if (cache->mState != CACHE_ALIVE)
+		return;
+
+	for (uint32 i=0; i<NUM_SIZECLASSES; ++i)
+		ReleaseToDepot(i, cache->mLists[i], cache->mSizes[i], cache->mSizes[i]);
+
+	std::lock_guard<std::mutex> lock(gMutex);
+	for (uint32 i=0; i<NUM_MEMORYTAGS; ++i)
+	{
+		for (uint32 j=0; j<NUM_COUNTERS; ++j)
+		{
+			std::atomic<int64>& target = gExitedCounters.mValues[i][j];
+			target.store(target.load(std::memory_order_relaxed) + cache->mCounters.mValues[i][j].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+	}
+
+	if (cache->mPrev != NULL)
+		cache->mPrev->mNext = cache->mNext;
+	else
+		gThreadCaches = cache->mNext;
+	if (cache->mNext != NULL)
+		cache->mNext->mPrev = cache->mPrev;
+
+	cache->mState = CACHE_DESTROYED;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// accounting
+
+EMemoryTag GetThreadMemoryTag()							{ return (EMemoryTag)tMemoryTag; }
+void SetThreadMemoryTag(EMemoryTag tag)					{ tMemoryTag = (uint8)tag; }
+bool IsRealtimeThread()									{ return tIsRealtimeThread; }
+void SetRealtimeThread(bool enabled)					{ tIsRealtimeThread = enabled; }
+void SetRealtimeAllocationAssert(bool enabled)			{ gRealtimeAssert.store(enabled, std::memory_order_relaxed); }
+bool IsRealtimeAllocationAssertEnabled()				{ return gRealtimeAssert.load(std::memory_order_relaxed); }
+
+
+// count (and optionally trap) heap activity on a real-time thread
+static inline void CheckRealtime(ThreadCache* cache, uint32 tag)
+{
+	gNumThreadAllocations++;
+
+	if (tIsRealtimeThread == false)
+		return;
+
+	AddCounter(cache, tag, COUNTER_REALTIMEALLOCATIONS, 1);
+	if (gRealtimeAssert.load(std::memory_order_relaxed) == true)
+		CORE_ASSERT(false && "heap allocation inside a real-time scope");
+}
+
+
+// sum over the running and the exited threads
+MemoryStatistics GetMemoryStatistics(EMemoryTag tag)
+{
+	int64 values[NUM_COUNTERS];
+
+	{
+		std::lock_guard<std::mutex> lock(gMutex);
+		for (uint32 i=0; i<NUM_COUNTERS; ++i)
+			values[i] = gExitedCounters.mValues[tag][i].load(std::memory_order_relaxed);
+
+		for (ThreadCache* cache=gThreadCaches; cache!=NULL; cache=cache->mNext)
+			for (uint32 i=0; i<NUM_COUNTERS; ++i)
+				values[i] += cache->mCounters.mValues[tag][i].load(std::memory_order_relaxed);
+	}
+
+	MemoryStatistics result;
+	result.mNumLiveBytes			= values[COUNTER_LIVEBYTES];
+	result.mNumLiveAllocations		= values[COUNTER_LIVEALLOCATIONS];
+	result.mNumAllocations			= (uint64)values[COUNTER_ALLOCATIONS];
+	result.mNumReallocations		= (uint64)values[COUNTER_REALLOCATIONS];
+	result.mNumFrees				= (uint64)values[COUNTER_FREES];
+	result.mNumRealtimeAllocations	= (uint64)values[COUNTER_REALTIMEALLOCATIONS];
+	return result;
+}
+
+
+MemoryStatistics GetMemoryStatistics()
+{
+	MemoryStatistics result;
+	memset(&result, 0, sizeof(MemoryStatistics));
+
+	for (uint32 i=0; i<NUM_MEMORYTAGS; ++i)
+	{
+		const MemoryStatistics stats = GetMemoryStatistics((EMemoryTag)i);
+		result.mNumLiveBytes			+= stats.mNumLiveBytes;
+		result.mNumLiveAllocations		+= stats.mNumLiveAllocations;
+		result.mNumAllocations			+= stats.mNumAllocations;
+		result.mNumReallocations		+= stats.mNumReallocations;
+		result.mNumFrees				+= stats.mNumFrees;
+		result.mNumRealtimeAllocations	+= stats.mNumRealtimeAllocations;
+	}
+
+	return result;
+}
+
+
+const char* GetMemoryTagName(EMemoryTag tag)
+{
+	switch (tag)
+	{
+		case MEMORYTAG_GENERAL:		return "General";
+		case MEMORYTAG_DSP:			return "DSP";
+		case MEMORYTAG_GRAPH:		return "Graph";
+		case MEMORYTAG_NETWORKING:	return "Networking";
+		case MEMORYTAG_STRING:		return "Strings";
+		default:					return "Unknown";
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// size-class pools
+
+// refill an empty list: take a batch from the depot or carve a new slab
+static bool RefillList(uint32 sizeClass, FreeBlock*& list, uint32& listSize)
+{
+	const uint32 blockSize = gSizeClasses[sizeClass];
+	const uint32 batchSize = SLAB_SIZE / blockSize / 4;
+
+	{
+		std::lock_guard<std::mutex> lock(gMutex);
+		FreeBlock*& depot = gDepotLists[sizeClass];
+		while (depot != NULL && listSize < batchSize)
+		{
+			FreeBlock* block = depot;
+			depot = block->mNext;
+			block->mNext = list;
+			list = block;
+			listSize++;
+		}
+	}
+
+	if (list != NULL)
+		return true;
+
+	const AllocatorBackend& backend = gBackends[gNumBackends.load(std::memory_order_acquire) - 1];
+	uint8* slab = static_cast<uint8*>(backend.mAllocate(SLAB_SIZE, backend.mUserData));
+	if (slab == NULL)
+		return false;
+
+	const uint32 numBlocks = SLAB_SIZE / blockSize;
+	for (uint32 i=numBlocks; i>0; --i)
+	{
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i-1) * blockSize);
+		block->mNext = list;
+		list = block;
+	}
+
+	listSize += numBlocks;
+	return true;
+}
+
+
+static BlockHeader* AllocatePooled(ThreadCache* cache, uint32 sizeClass)
+{
+	FreeBlock* block = NULL;
+
+	if (cache != NULL)
+	{
+		FreeBlock*& list = cache->mLists[sizeClass];
+		if (list == NULL && RefillList(sizeClass, list, cache->mSizes[sizeClass]) == false)
+			return NULL;
+
+		block = list;
+		list = block->mNext;
+		cache->mSizes[sizeClass]--;
+	}
+	else
+	{
+		// thread is shutting down: take one block and return the rest
+		FreeBlock* list = NULL;
+		uint32 listSize = 0;
+		if (RefillList(sizeClass, list, listSize) == false)
+			return NULL;
+
+		block = list;
+		list = block->mNext;
+		listSize--;
+		ReleaseToDepot(sizeClass, list, listSize, listSize);
+	}
+
+	BlockHeader* header = reinterpret_cast<BlockHeader*>(block);
+	header->mSizeClass = (uint8)sizeClass;
+	return header;
+}
+
+
+static void FreePooled(ThreadCache* cache, BlockHeader* header)
+{
+	const uint32 sizeClass = header->mSizeClass;
+	FreeBlock* block = reinterpret_cast<FreeBlock*>(header);
+
+	if (cache != NULL)
+	{
+		block->mNext = cache->mLists[sizeClass];
+		cache->mLists[sizeClass] = block;
+		if (++cache->mSizes[sizeClass] > MAX_CACHED_BLOCKS)
+			ReleaseToDepot(sizeClass, cache->mLists[sizeClass], cache->mSizes[sizeClass], MAX_CACHED_BLOCKS / 2);
+	}
+	else
+	{
+		block->mNext = NULL;
+		uint32 listSize = 1;
+		ReleaseToDepot(sizeClass, block, listSize, 1);
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// heap interface
+
+static BlockHeader* AllocateBlock(ThreadCache* cache, size_t numBytes)
+{
+	const size_t totalSize = numBytes + HEADER_SIZE;
+	if (totalSize <= MAX_POOLED_SIZE)
+		return AllocatePooled(cache, gSizeClassTable.mClass[(totalSize + 15) / 16]);
+
+	const uint32 backendIndex = gNumBackends.load(std::memory_order_acquire) - 1;
+	const AllocatorBackend& backend = gBackends[backendIndex];
+	BlockHeader* header = static_cast<BlockHeader*>(backend.mAllocate(totalSize, backend.mUserData));
+	if (header == NULL)
+		return NULL;
+
+	header->mSizeClass	= INVALID_SIZECLASS;
+	header->mBackend	= (uint8)backendIndex;
+	return header;
+}
+
+
+static void ReleaseBlock(ThreadCache* cache, BlockHeader* header)
+{
+	if (header->mSizeClass != INVALID_SIZECLASS)
+	{
+		FreePooled(cache, header);
+	}
+	else
+	{
+		const AllocatorBackend& backend = gBackends[header->mBackend];
+		backend.mFree(header, backend.mUserData);
+	}
+}
+
+
+void* Allocate(size_t numBytes)
+{
+	return Allocate(numBytes, (EMemoryTag)tMemoryTag);
+}
+
+
+void* Allocate(size_t numBytes, EMemoryTag tag)
+{
+	ThreadCache* cache = GetThreadCache();
+	CheckRealtime(cache, tag);
+
+	BlockHeader* header = AllocateBlock(cache, numBytes);
+	if (header == NULL)
+	{
+		CORE_ASSERT(false && "allocation failure");
+		return NULL;
+	}
+
+	header->mNumBytes	= numBytes;
+	header->mTag		= (uint8)tag;
+
+	AddCounter(cache, tag, COUNTER_LIVEBYTES, (int64)numBytes);
+	AddCounter(cache, tag, COUNTER_LIVEALLOCATIONS, 1);
+	AddCounter(cache, tag, COUNTER_ALLOCATIONS, 1);
+
+	return GetMemory(header);
+}
+
+
+// the block keeps its tag
+void* Realloc(void* memory, size_t numBytes)
+{
+	if (memory == NULL)
+		return Allocate(numBytes);
+
+	ThreadCache* cache = GetThreadCache();
+	BlockHeader* header = GetHeader(memory);
+	const uint32 tag = header->mTag;
+	const size_t oldNumBytes = header->mNumBytes;
+	const size_t totalSize = numBytes + HEADER_SIZE;
+
+	CheckRealtime(cache, tag);
+
+	BlockHeader* newHeader = NULL;
+	if (header->mSizeClass != INVALID_SIZECLASS && totalSize <= gSizeClasses[header->mSizeClass])
+	{
+		// still fits into the pool block
+		newHeader = header;
+	}
+	else if (header->mSizeClass == INVALID_SIZECLASS && totalSize > MAX_POOLED_SIZE && gBackends[header->mBackend].mRealloc != NULL)
+	{
+		// large block stays with its backend
+		const AllocatorBackend& backend = gBackends[header->mBackend];
+		newHeader = static_cast<BlockHeader*>(backend.mRealloc(header, totalSize, backend.mUserData));
+	}
+	else
+	{
+		// move between pools or between pool and backend
+		newHeader = AllocateBlock(cache, numBytes);
+		if (newHeader != NULL)
+		{
+			newHeader->mTag = (uint8)tag;
+			memcpy(GetMemory(newHeader), memory, oldNumBytes < numBytes ? oldNumBytes : numBytes);
+			ReleaseBlock(cache, header);
+		}
+	}
+
+	if (newHeader == NULL)
+	{
+		#ifdef CORE_DEBUG
+			#ifdef NEUROMORE_PLATFORM_WINDOWS
+				OutputDebugStringA("CRITICAL ERROR: REALLOCATION FAILURE");
+			#endif
+		#endif
+
+		CORE_ASSERT(newHeader != NULL);
+		return memory;
+	}
+
+	newHeader->mNumBytes = numBytes;
+
+	AddCounter(cache, tag, COUNTER_LIVEBYTES, (int64)numBytes - (int64)oldNumBytes);
+	AddCounter(cache, tag, COUNTER_REALLOCATIONS, 1);
+
+	return GetMemory(newHeader);
+}
+
+
+void Free(void* memory)
+{
+	if (memory == NULL)
+		return;
+
+	ThreadCache* cache = GetThreadCache();
+	BlockHeader* header = GetHeader(memory);
+	const uint32 tag = header->mTag;
+
+	AddCounter(cache, tag, COUNTER_LIVEBYTES, -(int64)header->mNumBytes);
+	AddCounter(cache, tag, COUNTER_LIVEALLOCATIONS, -1);
+	AddCounter(cache, tag, COUNTER_FREES, 1);
+
+	ReleaseBlock(cache, header);
+}
+
+} // namespace Core
@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __CORE_ALLOCATOR_H
+#define __CORE_ALLOCATOR_H
+
+// include required headers
+#include "Config.h"
+#include <stddef.h>
+
+
+namespace Core
+{
+
+// subsystem a heap allocation is accounted to
+enum EMemoryTag
+{
+	MEMORYTAG_GENERAL		= 0,
+	MEMORYTAG_DSP			= 1,		// channel sample buffers, processor state and scratch memory
+	MEMORYTAG_GRAPH			= 2,		// graph objects and everything the classifier update allocates
+	MEMORYTAG_NETWORKING	= 3,		// osc packets and messages
+	MEMORYTAG_STRING		= 4,		// heap storage of strings
+	NUM_MEMORYTAGS
+};
+
+// number of Allocate() and Realloc() calls made by the current thread (used by the node profiler)
+inline thread_local uint64 gNumThreadAllocations = 0;
+
+// heap interface used by all containers
+//  - every block carries a 16 byte header with its size, tag and origin
+//  - blocks up to 1 KB come from thread-local size-class pools, larger blocks from the backend
+//  - Allocate() without tag uses the tag of the current thread (see MemoryTagScope)
+//  - blocks may be freed on any thread
+ENGINE_API void* Allocate(size_t numBytes);
+ENGINE_API void* Allocate(size_t numBytes, EMemoryTag tag);
+ENGINE_API void* Realloc(void* memory, size_t numBytes);
+ENGINE_API void Free(void* memory);
+
+// backend for large blocks and pool slabs (default: malloc, realloc and free)
+struct AllocatorBackend
+{
+	void*	(*mAllocate)(size_t numBytes, void* userData);
+	void*	(*mRealloc)(void* memory, size_t numBytes, void* userData);		// optional
+	void	(*mFree)(void* memory, void* userData);
+	void*	mUserData;
+};
+
+// install a custom backend for all following allocations; blocks allocated earlier are still released through the backend they came from
+// note: pool slabs are never returned to the backend, returns false if no more backends can be installed
+ENGINE_API bool SetAllocatorBackend(const AllocatorBackend& backend);
+
+// accounting of one tag
+struct MemoryStatistics
+{
+	int64	mNumLiveBytes;				// requested bytes currently allocated
+	int64	mNumLiveAllocations;		// blocks currently allocated
+	uint64	mNumAllocations;			// total number of Allocate() calls
+	uint64	mNumReallocations;			// total number of Realloc() calls
+	uint64	mNumFrees;					// total number of Free() calls
+	uint64	mNumRealtimeAllocations;	// Allocate() and Realloc() calls made inside a RealtimeScope
+};
+
+ENGINE_API MemoryStatistics GetMemoryStatistics(EMemoryTag tag);
+ENGINE_API MemoryStatistics GetMemoryStatistics();		// sum of all tags
+ENGINE_API const char* GetMemoryTagName(EMemoryTag tag);
+
+// tag used by Allocate(numBytes) on the current thread
+ENGINE_API EMemoryTag GetThreadMemoryTag();
+ENGINE_API void SetThreadMemoryTag(EMemoryTag tag);
+
+// accounts all untagged allocations of the current thread to the given tag during its lifetime
+class MemoryTagScope
+{
+	public:
+		MemoryTagScope(EMemoryTag tag)											{ mPrevious = GetThreadMemoryTag(); SetThreadMemoryTag(tag); }
+		~MemoryTagScope()														{ SetThreadMemoryTag(mPrevious); }
+	private:
+		EMemoryTag mPrevious;
+};
+
+// real-time mode: allocations on a thread inside a RealtimeScope are counted per tag and assert if enabled
+// note: nested scopes can only enable the mode, never disable it
+ENGINE_API bool IsRealtimeThread();
+ENGINE_API void SetRealtimeThread(bool enabled);
+ENGINE_API void SetRealtimeAllocationAssert(bool enabled);
+ENGINE_API bool IsRealtimeAllocationAssertEnabled();
+
+class RealtimeScope
+{
+	public:
+		RealtimeScope(bool enabled = true)										{ mPrevious = IsRealtimeThread(); SetRealtimeThread(mPrevious == true || enabled == true); }
+		~RealtimeScope()														{ SetRealtimeThread(mPrevious); }
+	private:
+		bool mPrevious;
+};
+
+} // namespace Core
+
+
+#endif
@@ -64,6 +64,7 @@ namespace Core
 	{\
 		AttributeType* castAttribute = static_cast<AttributeType*>(attribute);\
 		castAttribute->SetValue( value );\
+		MarkAttributeDirty( index );\
 	}\
 	else\
 	{\
@@ -81,6 +82,7 @@ namespace Core
 	{\
 		AttributeType* castAttribute = static_cast<AttributeType*>(attribute);\
 		castAttribute->SetValue( value );\
+		MarkAttributeDirty( index );\
 	}\
 	else\
 	{\
@@ -119,20 +121,24 @@ namespace Core
 // add an attribute
 void AttributeSet::AddAttribute(AttributeSettings* settings, Attribute* attributeValue)
 { 
-	CORE_ASSERT( HasAttributeWithInternalName(settings->GetInternalName()) == false );
+	CORE_ASSERT( FindAttributeIndexByKey(settings->GetInternalNameKey()) == CORE_INVALIDINDEX32 );
 	mAttributes.AddEmpty();
 	mAttributes.GetLast().mSettings = settings;
 	mAttributes.GetLast().mValue	= attributeValue;
+
+	MarkAttributeDirty( mAttributes.Size()-1 );
 }
 
 
 // add an attribute
 void AttributeSet::AddAttribute(AttributeSettings* settings)
 {
-	CORE_ASSERT( HasAttributeWithInternalName(settings->GetInternalName()) == false );
+	CORE_ASSERT( FindAttributeIndexByKey(settings->GetInternalNameKey()) == CORE_INVALIDINDEX32 );
 	mAttributes.AddEmpty();
 	mAttributes.GetLast().mSettings = settings;
 	mAttributes.GetLast().mValue	= NULL;
+
+	MarkAttributeDirty( mAttributes.Size()-1 );
 }
 
 
@@ -150,6 +156,7 @@ void AttributeSet::RemoveAllAttributes(bool delFromMem)
 	}
 
 	mAttributes.Clear(true);
+	mDirtyMask = 0;
 }
 
 
@@ -165,18 +172,53 @@ bool AttributeSet::HasAttribute(Attribute* attribute) const
 }
 
 
-// find an attribute by its name
+// find an attribute by its name (compares the interned keys first, the string only on a key match)
 uint32 AttributeSet::FindAttributeIndexByInternalName(const char* name) const
+{
+	const uint32 key = AttributeKey(name);
+	const uint32 numAttributes = mAttributes.Size();
+	for (uint32 i=0; i<numAttributes; ++i)
+		if (mAttributes[i].mSettings->GetInternalNameKey() == key && mAttributes[i].mSettings->GetInternalNameString() == name)
+			return i;
+
+	return CORE_INVALIDINDEX32;
+}
+
+
+// find an attribute by its interned key, see AttributeKey()
+uint32 AttributeSet::FindAttributeIndexByKey(uint32 key) const
+{
+	const uint32 numAttributes = mAttributes.Size();
+	for (uint32 i=0; i<numAttributes; ++i)
+		if (mAttributes[i].mSettings->GetInternalNameKey() == key)
+			return i;
+
+	return CORE_INVALIDINDEX32;
+}
+
+
+// find an attribute by its precomputed key, comparing the internal name to rule out hash collisions
+uint32 AttributeSet::FindAttributeIndexByKey(uint32 key, const char* internalName) const
 {
 	const uint32 numAttributes = mAttributes.Size();
 	for (uint32 i=0; i<numAttributes; ++i)
-		if (mAttributes[i].mSettings->GetInternalNameString() == name)
+		if (mAttributes[i].mSettings->GetInternalNameKey() == key && mAttributes[i].mSettings->GetInternalNameString() == internalName)
 			return i;
 
 	return CORE_INVALIDINDEX32;
 }
 
 
+// mark the attribute with the given value as dirty
+void AttributeSet::MarkAttributeDirty(const Attribute* attribute)
+{
+	const uint32 numAttributes = mAttributes.Size();
+	for (uint32 i=0; i<numAttributes; ++i)
+		if (mAttributes[i].mValue == attribute)
+			MarkAttributeDirty(i);
+}
+
+
 // find an attribute by its name
 uint32 AttributeSet::FindAttributeIndexByName(const char* name) const
 {
@@ -192,9 +234,10 @@ uint32 AttributeSet::FindAttributeIndexByName(const char* name) const
 // find the attribute settings based on the internal name
 AttributeSettings* AttributeSet::FindAttributeSettingsByInternalName(const char* internalName) const
 {
+	const uint32 key = AttributeKey(internalName);
 	const uint32 numAttributes = mAttributes.Size();
 	for (uint32 i=0; i<numAttributes; ++i)
-		if (mAttributes[i].mSettings->GetInternalNameString().IsEqual(internalName) == true)
+		if (mAttributes[i].mSettings->GetInternalNameKey() == key && mAttributes[i].mSettings->GetInternalNameString().IsEqual(internalName) == true)
 			return mAttributes[i].mSettings;
 
 	return NULL;
@@ -216,6 +259,7 @@ void AttributeSet::CopyFrom(const AttributeSet& other)
 		mAttributes.AddEmpty();
 		mAttributes.GetLast().mSettings	= data.mSettings->Clone();
 		mAttributes.GetLast().mValue	= data.mValue->Clone();
+		MarkAttributeDirty(i);
 	}
 }
 
@@ -343,7 +387,10 @@ bool AttributeSet::Read(const Json& json, const Json::Item& parentItem, bool val
 		// read the attribute value
 		Json::Item valueItem = attributeItem.Find("value");
 		if (valueItem.IsNull() == false)
+		{
 			attribute->Read( json, valueItem );
+			MarkAttributeDirty( attributeIndex );
+		}
 	}
 
 	if (numWarnings > 0)
@@ -364,7 +411,10 @@ void AttributeSet::CreateDefaultAttributeValues()
 
 		// create a new clone of the default attribute and set it as attribute value
 		if (mAttributes[i].mValue == NULL)
+		{
 			mAttributes[i].mValue = attributeSettings->GetDefaultValue()->Clone();
+			MarkAttributeDirty(i);
+		}
 	}
 }
 
@@ -45,7 +45,7 @@ class Stream;
 class ENGINE_API AttributeSet
 {
 	public:
-		AttributeSet()																{}
+		AttributeSet()																{ mDirtyMask = 0; mGeneration = 0; }
 		virtual ~AttributeSet()														{ RemoveAllAttributes(); }
 
 		inline uint32 GetNumAttributes() const										{ return mAttributes.Size(); }
@@ -61,6 +61,8 @@ class ENGINE_API AttributeSet
 		void Resize(uint32 numAttributes)											{ mAttributes.Resize( numAttributes ); }
 
 		uint32 FindAttributeIndexByInternalName(const char* name) const;
+		uint32 FindAttributeIndexByKey(uint32 key) const;
+		uint32 FindAttributeIndexByKey(uint32 key, const char* internalName) const;
 		uint32 FindAttributeIndexByName(const char* name) const;
 
 		bool HasAttribute(Attribute* attribute) const;
@@ -114,6 +116,16 @@ class ENGINE_API AttributeSet
 
 		void CreateDefaultAttributeValues();
 
+		// dirty tracking: one bit per attribute (attributes from index 63 on share the last bit) plus a generation counter that increases with every change
+		// new attributes start dirty; the owner clears the bits once it has taken over the values
+		inline void MarkAttributeDirty(uint32 index)							{ mDirtyMask |= GetDirtyBit(index); mGeneration++; }
+		void MarkAttributeDirty(const Attribute* attribute);
+		inline bool IsAttributeDirty(uint32 index) const						{ return (mDirtyMask & GetDirtyBit(index)) != 0; }
+		inline bool HasDirtyAttributes() const									{ return mDirtyMask != 0; }
+		inline void ClearAttributeDirty(uint32 index)							{ mDirtyMask &= ~GetDirtyBit(index); }
+		inline void ClearDirtyAttributes()										{ mDirtyMask = 0; }
+		inline uint32 GetAttributeGeneration() const							{ return mGeneration; }
+
 		void CopyFrom(const AttributeSet& other);
 		void Log();
 
@@ -132,7 +144,11 @@ class ENGINE_API AttributeSet
 			~AttributeData() {}
 		};
 
+		static inline uint64 GetDirtyBit(uint32 index)							{ return (uint64)1 << (index < 63 ? index : 63); }
+
 		Array<AttributeData>	mAttributes;
+		uint64					mDirtyMask;
+		uint32					mGeneration;
 };
 
 } // namespace Core
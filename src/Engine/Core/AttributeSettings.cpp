@@ -39,6 +39,7 @@ AttributeSettings::AttributeSettings()
 	mDefaultValue	= NULL;
 	mIsEnabled		= true;
 	mIsVisible		= true;
+	mInternalNameKey= AttributeKey("");
 }
 
 
@@ -49,6 +50,7 @@ AttributeSettings::AttributeSettings(const char* internalName)
 	mMaxValue		= NULL;
 	mDefaultValue	= NULL;
 	mInternalName	= internalName;
+	mInternalNameKey= AttributeKey(internalName);
 	mName			= mInternalName;
 }
 
@@ -61,7 +63,7 @@ AttributeSettings::~AttributeSettings()
 }
 
 
-void AttributeSettings::SetInternalName(const char* internalName)					{ mInternalName = internalName; }
+void AttributeSettings::SetInternalName(const char* internalName)					{ mInternalName = internalName; mInternalNameKey = AttributeKey(internalName); }
 void AttributeSettings::SetName(const char* name)									{ mName = name; }
 const char* AttributeSettings::GetInternalName() const								{ return mInternalName.AsChar(); }
 const char* AttributeSettings::GetName() const										{ return mName.AsChar(); }
@@ -84,6 +86,7 @@ AttributeSettings& AttributeSettings::operator=(const AttributeSettings& other)
 	// copy the rest			
 	mName			= other.mName;
 	mInternalName	= other.mInternalName;
+	mInternalNameKey= other.mInternalNameKey;
 	mDescription	= other.mDescription;
 	mInterfaceType	= other.mInterfaceType;
 	mComboValues	= other.mComboValues;
@@ -56,6 +56,20 @@ enum
 };
 
 
+// interned attribute key: FNV-1a hash of the internal name, evaluated at compile time for string literals
+constexpr uint32 AttributeKey(const char* internalName)
+{
+	uint32 hash = 2166136261u;
+	for (; *internalName != '\0'; ++internalName)
+	{
+		hash ^= (uint8)*internalName;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+
 class ENGINE_API AttributeSettings
 {
 	public:
@@ -71,6 +85,7 @@ class ENGINE_API AttributeSettings
 
 		// accessors
 		const char* GetInternalName() const;
+		uint32 GetInternalNameKey() const								{ return mInternalNameKey; }
 		const char* GetName() const;
 		const char* GetDescription() const								{ return mDescription.AsChar(); }
 		uint32 GetInterfaceType() const									{ return mInterfaceType; }
@@ -118,6 +133,7 @@ class ENGINE_API AttributeSettings
 		String			mDescription;	
 		Core::String	mName;			
 		Core::String	mInternalName;	
+		uint32			mInternalNameKey;
 		uint32			mInterfaceType;	
 		bool			mIsEnabled;
 		bool			mIsVisible;
@@ -33,7 +33,9 @@ namespace Core
 
 EventManager::EventManager()
 {
-	mEventLogger = NULL;
+	mEventLogger		= NULL;
+	mQueueThreadEvents	= false;
+	mOwnerThread		= std::this_thread::get_id();
 
 #ifdef CORE_DEBUG
 	// enable event logging
@@ -45,11 +47,61 @@ EventManager::EventManager()
 
 EventManager::~EventManager()
 {
+	ClearQueuedEvents();
 	mEventHandlers.Clear();
 	delete mEventLogger;
 }
 
 
+// enable/disable queueing of events emitted from other threads (the calling thread becomes the owner thread)
+void EventManager::SetQueueThreadEvents(bool enable)
+{
+	mOwnerThread = std::this_thread::get_id();
+	mQueueThreadEvents = enable;
+
+	// pass events that were queued so far
+	if (enable == false)
+		DispatchQueuedEvents();
+}
+
+
+// pass all queued events to the event handlers (call from the owner thread only)
+void EventManager::DispatchQueuedEvents()
+{
+	// move the queued events over, so the handlers can run without holding the lock (and new events can be queued meanwhile)
+	mQueueLock.Lock();
+	const uint32 numEvents = mQueuedEvents.Size();
+	if (numEvents == 0)
+	{
+		mQueueLock.Unlock();
+		return;
+	}
+
+	// NOTE: local copy, handlers may dispatch recursively (e.g. by running a nested event loop)
+	Array<QueuedEvent*> events = mQueuedEvents;
+	mQueuedEvents.Clear(false);
+	mQueueLock.Unlock();
+
+	for (uint32 i=0; i<numEvents; ++i)
+	{
+		events[i]->Dispatch();
+		delete events[i];
+	}
+}
+
+
+// drop all queued events without dispatching them
+void EventManager::ClearQueuedEvents()
+{
+	mQueueLock.Lock();
+	const uint32 numEvents = mQueuedEvents.Size();
+	for (uint32 i=0; i<numEvents; ++i)
+		delete mQueuedEvents[i];
+	mQueuedEvents.Clear();
+	mQueueLock.Unlock();
+}
+
+
 void EventManager::AddEventHandler(EventHandler* eventHandler)
 {
 	CORE_ASSERT(FindEventHandlerIndex(eventHandler) == CORE_INVALIDINDEX32);
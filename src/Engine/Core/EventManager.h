@@ -28,9 +28,12 @@
 #include "Config.h"
 #include "Array.h"
 #include "String.h"
+#include "Mutex.h"
 #include "EventHandler.h"
 #include "EventLogger.h"
 #include "EventManagerHelpers.h"
+#include <thread>
+#include <type_traits>
 
 // forward declaration
 class Graph;
@@ -56,6 +59,13 @@ class ENGINE_API EventManager
 		uint32 GetNumEventHandlers() const						{ return mEventHandlers.Size(); }
 		uint32 FindEventHandlerIndex(EventHandler* eventHandler) const;
 
+		// queue events that are emitted from other threads than the calling thread (the owner thread), instead of calling the handlers directly
+		// the queued events are passed to the handlers by DispatchQueuedEvents(), which has to be called regularly by the owner thread
+		void SetQueueThreadEvents(bool enable);
+		bool GetQueueThreadEvents() const						{ return mQueueThreadEvents; }
+		void DispatchQueuedEvents();
+		void ClearQueuedEvents();
+
 		//---------------------------------------------------------------------
 
 		//
@@ -156,8 +166,36 @@ class ENGINE_API EventManager
 		EVENT_CREATE_NOTIFY_FUNCTION_1( OnCommand, const char*, command );
 
 	private:
+		// queued event (captures a copy of the event parameters)
+		class QueuedEvent
+		{
+			public:
+				virtual ~QueuedEvent()							{}
+				virtual void Dispatch() = 0;
+		};
+
+		template <class F>
+		class QueuedEventFunctor : public QueuedEvent
+		{
+			public:
+				QueuedEventFunctor(const F& functor) : mFunctor(functor)	{}
+				void Dispatch() override									{ mFunctor(); }
+			private:
+				F mFunctor;
+		};
+
+		bool IsQueueingEvents() const							{ return (mQueueThreadEvents == true && std::this_thread::get_id() != mOwnerThread); }
+
+		template <class F>
+		void QueueEvent(const F& functor)						{ mQueueLock.Lock(); mQueuedEvents.Add( new QueuedEventFunctor<F>(functor) ); mQueueLock.Unlock(); }
+
 		Core::Array<EventHandler*>			mEventHandlers;
 		EventLogger*						mEventLogger;
+
+		bool								mQueueThreadEvents;
+		std::thread::id						mOwnerThread;
+		Core::Array<QueuedEvent*>			mQueuedEvents;
+		Core::Mutex							mQueueLock;
 };
 
 } // namespace Core
@@ -28,9 +28,12 @@
  * Helper macros for implementing the notify functions (contain loops that call all registered EventHandlers) in the EventManager. 
  * They allow us to implement event callbacks with zero overhead which is useful for frequently used core events,
  * but on the flipside disallow us to selectively disable/block them.
+ * Events that are emitted from another thread than the owner thread of the event manager are queued (see EventManager::SetQueueThreadEvents()).
  */
 #define EVENT_CREATE_NOTIFY_FUNCTION_0(FNAME)					\
 	void FNAME() {												\
+		if (IsQueueingEvents() == true) {							\
+			QueueEvent( [this]() { FNAME(); } ); return; }		\
 		const uint32 size = mEventHandlers.Size();			\
 		for (uint32 i = 0; i<size; ++i)							\
 			if (mEventHandlers[i]->GetAcceptEvents() == true)	\
@@ -38,6 +41,9 @@
 
 #define EVENT_CREATE_NOTIFY_FUNCTION_1(FNAME, TYPE1, VNAME1)	\
 	void FNAME(TYPE1 VNAME1) {									\
+		if (IsQueueingEvents() == true) {							\
+			Core::EventArgument<TYPE1> arg1(VNAME1);				\
+			QueueEvent( [this, arg1]() { FNAME( arg1.Get() ); } ); return; }	\
 		const uint32 size = mEventHandlers.Size();			\
 		for (uint32 i = 0; i<size; ++i)							\
 			if (mEventHandlers[i]->GetAcceptEvents() == true)	\
@@ -45,6 +51,10 @@
 
 #define EVENT_CREATE_NOTIFY_FUNCTION_2(FNAME, TYPE1, VNAME1, TYPE2, VNAME2)	\
 	void FNAME(TYPE1 VNAME1, TYPE2 VNAME2) {								\
+		if (IsQueueingEvents() == true) {							\
+			Core::EventArgument<TYPE1> arg1(VNAME1);				\
+			Core::EventArgument<TYPE2> arg2(VNAME2);				\
+			QueueEvent( [this, arg1, arg2]() { FNAME( arg1.Get(), arg2.Get() ); } ); return; }	\
 		const uint32 size = mEventHandlers.Size();						\
 		for (uint32 i = 0; i<size; ++i)										\
 			if (mEventHandlers[i]->GetAcceptEvents() == true)				\
@@ -52,6 +62,11 @@
 
 #define EVENT_CREATE_NOTIFY_FUNCTION_3(FNAME, TYPE1, VNAME1, TYPE2, VNAME2, TYPE3, VNAME3)	\
 	void FNAME(TYPE1 VNAME1, TYPE2 VNAME2, TYPE3 VNAME3)	{								\
+		if (IsQueueingEvents() == true) {							\
+			Core::EventArgument<TYPE1> arg1(VNAME1);				\
+			Core::EventArgument<TYPE2> arg2(VNAME2);				\
+			Core::EventArgument<TYPE3> arg3(VNAME3);				\
+			QueueEvent( [this, arg1, arg2, arg3]() { FNAME( arg1.Get(), arg2.Get(), arg3.Get() ); } ); return; }	\
 		const uint32 size = mEventHandlers.Size();										\
 		for (uint32 i = 0; i<size; ++i)														\
 			if (mEventHandlers[i]->GetAcceptEvents() == true)								\
@@ -59,6 +74,12 @@
 
 #define EVENT_CREATE_NOTIFY_FUNCTION_4(FNAME, TYPE1, VNAME1, TYPE2, VNAME2, TYPE3, VNAME3, TYPE4, VNAME4)	\
 	void FNAME(TYPE1 VNAME1, TYPE2 VNAME2, TYPE3 VNAME3, TYPE4 VNAME4)	{									\
+		if (IsQueueingEvents() == true) {							\
+			Core::EventArgument<TYPE1> arg1(VNAME1);				\
+			Core::EventArgument<TYPE2> arg2(VNAME2);				\
+			Core::EventArgument<TYPE3> arg3(VNAME3);				\
+			Core::EventArgument<TYPE4> arg4(VNAME4);				\
+			QueueEvent( [this, arg1, arg2, arg3, arg4]() { FNAME( arg1.Get(), arg2.Get(), arg3.Get(), arg4.Get() ); } ); return; }	\
 		const uint32 size = mEventHandlers.Size();														\
 		for (uint32 i = 0; i<size; ++i)																		\
 			if (mEventHandlers[i]->GetAcceptEvents() == true)												\
@@ -66,10 +87,48 @@
 
 #define EVENT_CREATE_NOTIFY_FUNCTION_5(FNAME, TYPE1, VNAME1, TYPE2, VNAME2, TYPE3, VNAME3, TYPE4, VNAME4, TYPE5, VNAME5)	\
 	void FNAME(TYPE1 VNAME1, TYPE2 VNAME2, TYPE3 VNAME3, TYPE4 VNAME4, TYPE5 VNAME5)	{									\
+		if (IsQueueingEvents() == true) {							\
+			Core::EventArgument<TYPE1> arg1(VNAME1);				\
+			Core::EventArgument<TYPE2> arg2(VNAME2);				\
+			Core::EventArgument<TYPE3> arg3(VNAME3);				\
+			Core::EventArgument<TYPE4> arg4(VNAME4);				\
+			Core::EventArgument<TYPE5> arg5(VNAME5);				\
+			QueueEvent( [this, arg1, arg2, arg3, arg4, arg5]() { FNAME( arg1.Get(), arg2.Get(), arg3.Get(), arg4.Get(), arg5.Get() ); } ); return; }	\
 		const uint32 size = mEventHandlers.Size();																		\
 		for (uint32 i = 0; i<size; ++i)																						\
 			if (mEventHandlers[i]->GetAcceptEvents() == true)																\
 				mEventHandlers[i]->FNAME( VNAME1, VNAME2, VNAME3, VNAME4, VNAME5 ); }
 
 
+namespace Core
+{
+
+// copy of an event parameter, used to keep the parameters of queued events alive until they are dispatched
+template <typename T>
+class EventArgument
+{
+	public:
+		EventArgument(T value) : mValue(value)					{}
+		const typename std::decay<T>::type& Get() const			{ return mValue; }
+
+	private:
+		typename std::decay<T>::type mValue;
+};
+
+// strings are copied, the buffer of the caller may be gone already when the event is dispatched
+template <>
+class EventArgument<const char*>
+{
+	public:
+		EventArgument(const char* value) : mValue(value != NULL ? value : ""), mIsNull(value == NULL)		{}
+		const char* Get() const																				{ return (mIsNull == true ? NULL : mValue.AsChar()); }
+
+	private:
+		Core::String	mValue;
+		bool			mIsNull;
+};
+
+} // namespace Core
+
+
 #endif
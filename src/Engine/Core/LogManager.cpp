@@ -43,6 +43,10 @@ LogManager::LogManager()
 	// errors + warnings as default
 	mActiveLogPresetIndex = 1;
 
+	// log synchronously by default
+	mLogQueue		= NULL;
+	mAsyncLogging	= false;
+
 	// init temporary string to a generous size (32k)
 	mLineFormattingBuffer.Reserve(32*1024);
 	mVarArgBuffer.Reserve(32*1024);
@@ -52,6 +56,10 @@ LogManager::LogManager()
 // destructor
 LogManager::~LogManager()
 {
+	// log the remaining queued messages
+	SetAsyncLogging(false);
+	delete mLogQueue;
+
 	// get rid of the callbacks
 	ClearLogCallbacks();
 }
@@ -91,7 +99,10 @@ void LogManager::RemoveLogCallback(LogCallback* callback, bool delFromMem)
 
 	const uint32 index = FindLogCallback(callback);
 	if (mLogCallbacks.IsValidIndex(index) == false)
+	{
+		mLock.Unlock();
 		return;
+	}
 
 	if (delFromMem == true)
 		delete mLogCallbacks[index];
@@ -118,11 +129,19 @@ void LogManager::ClearLogCallbacks()
 
 // the main logging method
 void LogManager::LogMessage(const char* message, ELogLevel logLevel)
+{
+	// NOTE: thread lock _MUST_ be handled in the calling function.
+	LogMessage(Time::Now(), message, logLevel);
+}
+
+
+// log a message with the given timestamp
+void LogManager::LogMessage(const Time& time, const char* message, ELogLevel logLevel)
 {
 	// NOTE: thread lock _MUST_ be handled in the calling function.
 	
 	// append timestamp
-	mLineFormattingBuffer.Format("%s: %s", Time::Now().Format("%Y-%m-%d %H:%M:%S.%f").AsChar(), message);
+	mLineFormattingBuffer.Format("%s: %s", time.Format("%Y-%m-%d %H:%M:%S.%f").AsChar(), message);
 	
 	// iterate through all callbacks
 	const uint32 num = mLogCallbacks.Size();
@@ -136,6 +155,59 @@ void LogManager::LogMessage(const char* message, ELogLevel logLevel)
 }
 
 
+// switch between synchronous and asynchronous logging
+void LogManager::SetAsyncLogging(bool enabled)
+{
+	if (enabled == true)
+	{
+		if (mLogQueue == NULL)
+			mLogQueue = new LogQueue(this);
+
+		mLogQueue->Start();
+		mAsyncLogging = true;
+	}
+	else
+	{
+		// log synchronously again before the queue is flushed, so no message gets stuck in it
+		mAsyncLogging = false;
+
+		if (mLogQueue != NULL)
+		{
+			mLogQueue->Stop();
+			mLogQueue->Flush();
+		}
+	}
+}
+
+
+// log all queued messages
+void LogManager::Flush()
+{
+	if (mLogQueue != NULL)
+		mLogQueue->Flush();
+}
+
+
+// enqueue the message in async mode, returns false in case it has to be logged synchronously
+bool LogManager::LogAsync(ELogLevel logLevel, const char* what, va_list args)
+{
+	if (mAsyncLogging == false)
+		return false;
+
+	if (GetLogLevels() & logLevel)
+	{
+		mLogQueue->Push(logLevel, what, args);
+
+		// critical messages often precede a crash, make sure they are written right away
+		if (logLevel == LOGLEVEL_CRITICAL)
+			mLogQueue->Flush();
+	}
+
+	va_end(args);
+	return true;
+}
+
+
 // find the index of a given callback
 uint32 LogManager::FindLogCallback(LogCallback* callback) const
 {
@@ -195,6 +267,10 @@ void LogManager::SetActiveLogLevelPresetIndex(uint32 index)
 
 void LogManager::LogCritical_Internal(const char* what, va_list args)
 {
+	// async mode: enqueue without taking the lock
+	if (LogAsync(LOGLEVEL_CRITICAL, what, args) == true)
+		return;
+
 	mLock.Lock();
 
 	// skip the va list construction in case that the message won't be logged by any of the callbacks
@@ -216,6 +292,10 @@ void LogManager::LogCritical_Internal(const char* what, va_list args)
 
 void LogManager::LogError_Internal(const char* what, va_list args)
 {
+	// async mode: enqueue without taking the lock
+	if (LogAsync(LOGLEVEL_ERROR, what, args) == true)
+		return;
+
 	mLock.Lock();
 
 	// skip the va list construction in case that the message won't be logged by any of the callbacks
@@ -236,6 +316,10 @@ void LogManager::LogError_Internal(const char* what, va_list args)
 
 void LogManager::LogWarning_Internal(const char* what, va_list args)
 {
+	// async mode: enqueue without taking the lock
+	if (LogAsync(LOGLEVEL_WARNING, what, args) == true)
+		return;
+
 	mLock.Lock();
 
 	// skip the va list construction in case that the message won't be logged by any of the callbacks
@@ -256,6 +340,10 @@ void LogManager::LogWarning_Internal(const char* what, va_list args)
 
 void LogManager::LogInfo_Internal(const char* what, va_list args)
 {
+	// async mode: enqueue without taking the lock
+	if (LogAsync(LOGLEVEL_INFO, what, args) == true)
+		return;
+
 	mLock.Lock();
 
 	// skip the va list construction in case that the message won't be logged by any of the callbacks
@@ -276,6 +364,10 @@ void LogManager::LogInfo_Internal(const char* what, va_list args)
 
 void LogManager::LogDetailedInfo_Internal(const char* what, va_list args)
 {
+	// async mode: enqueue without taking the lock
+	if (LogAsync(LOGLEVEL_DETAILEDINFO, what, args) == true)
+		return;
+
 	mLock.Lock();
 
 	// skip the va list construction in case that the message won't be logged by any of the callbacks
@@ -296,6 +388,10 @@ void LogManager::LogDetailedInfo_Internal(const char* what, va_list args)
 
 void LogManager::LogDebug_Internal(const char* what, va_list args)
 {
+	// async mode: enqueue without taking the lock
+	if (LogAsync(LOGLEVEL_DEBUG, what, args) == true)
+		return;
+
 	mLock.Lock();
 
 	// skip the va list construction in case that the message won't be logged by any of the callbacks
@@ -30,6 +30,8 @@
 #include "String.h"
 #include "Mutex.h"
 #include "LogCallbacks.h"
+#include "LogQueue.h"
+#include "Time.h"
 
 
 namespace Core
@@ -62,6 +64,12 @@ class ENGINE_API LogManager
 
 		void LogMessage(const char* message, ELogLevel logLevel=LOGLEVEL_INFO);
 
+		// asynchronous logging: log calls only enqueue the message, the callbacks are called from a background thread (see LogQueue)
+		void SetAsyncLogging(bool enabled);
+		bool GetAsyncLogging() const																{ return mAsyncLogging; }
+		LogQueue* GetLogQueue()																		{ return mLogQueue; }
+		void Flush();
+
 		void LogCritical_Internal(const char* what, va_list args);
 		void LogError_Internal(const char* what, va_list args);
 		void LogWarning_Internal(const char* what, va_list args);
@@ -70,6 +78,11 @@ class ENGINE_API LogManager
 		void LogDebug_Internal(const char* what, va_list args);
 
 	private:
+		friend class LogQueue;
+
+		void LogMessage(const Time& time, const char* message, ELogLevel logLevel);
+		bool LogAsync(ELogLevel logLevel, const char* what, va_list args);
+
 		String					mLineFormattingBuffer;
 		String					mVarArgBuffer;
 
@@ -77,6 +90,9 @@ class ENGINE_API LogManager
 		Array<LogLevelPreset>	mLogPresets;
 		uint32					mActiveLogPresetIndex;
 		Mutex					mLock;
+
+		LogQueue*				mLogQueue;
+		std::atomic<bool>		mAsyncLogging;
 };
 
 
@@ -0,0 +1,341 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "LogQueue.h"
+#include "LogManager.h"
+#include "Time.h"
+#include <chrono>
+
+
+namespace Core
+{
+
+// unique ids, so threads can tell which of their rings belongs to a queue
+static std::atomic<uint32> gNextLogQueueId(1);
+
+
+// constructor
+LogQueue::LogQueue(LogManager* logManager)
+{
+	mLogManager				= logManager;
+	mId						= gNextLogQueueId++;
+	mSequence				= 0;
+	mNumDropped				= 0;
+	mNumSuppressed			= 0;
+	mNumReportedDropped		= 0;
+	mMaxMessagesPerSecond	= 50;
+	mThread					= NULL;
+	mShutdown				= false;
+}
+
+
+// destructor
+LogQueue::~LogQueue()
+{
+	Stop();
+	Flush();
+
+	// threads that are still alive forget the ring the next time they log (or when they exit)
+	const uint32 numRings = mRings.Size();
+	for (uint32 i=0; i<numRings; ++i)
+	{
+		mRings[i]->mClosed.store(true, std::memory_order_release);
+		mRings[i]->Release();
+	}
+}
+
+
+// start the background thread
+void LogQueue::Start()
+{
+	if (mThread != NULL)
+		return;
+
+	mShutdown = false;
+	mThread = new Thread(new Worker(this), "Log Thread");
+	mThread->Start();
+}
+
+
+// stop the background thread (blocks until it finished)
+void LogQueue::Stop()
+{
+	if (mThread == NULL)
+		return;
+
+	delete mThread;
+	mThread = NULL;
+}
+
+
+// thread exit: the queues drain the remaining records and free the rings
+LogQueue::ThreadRings::~ThreadRings()
+{
+	for (Ring* ring : mRings)
+	{
+		ring->mOrphaned.store(true, std::memory_order_release);
+		ring->Release();
+	}
+}
+
+
+// get the ring of the calling thread for this queue, it is created on first use
+LogQueue::Ring* LogQueue::GetThreadRing()
+{
+	static thread_local ThreadRings threadRings;
+
+	// usually a thread logs to one queue only
+	if (threadRings.mLastRing != NULL && threadRings.mLastRing->mQueueId == mId)
+		return threadRings.mLastRing;
+
+	Ring* ring = NULL;
+	for (size_t i=0; i<threadRings.mRings.size(); )
+	{
+		Ring* threadRing = threadRings.mRings[i];
+
+		// forget the rings of destroyed queues
+		if (threadRing->mClosed.load(std::memory_order_acquire) == true)
+		{
+			threadRings.mRings[i] = threadRings.mRings.back();
+			threadRings.mRings.pop_back();
+			threadRing->Release();
+			continue;
+		}
+
+		if (threadRing->mQueueId == mId)
+			ring = threadRing;
+		++i;
+	}
+
+	if (ring == NULL)
+	{
+		ring = new Ring(mId);
+		threadRings.mRings.push_back(ring);
+
+		mRingLock.Lock();
+		mRings.Add(ring);
+		mRingLock.Unlock();
+	}
+
+	threadRings.mLastRing = ring;
+	return ring;
+}
+
+
+// count the message of the call site, returns false in case it exceeds the rate limit
+// NOTE: the counters are approximate, call sites sharing a slot reset each other's window
+bool LogQueue::CheckRateLimit(const char* format, uint64 seconds, uint32* outNumSuppressed)
+{
+	*outNumSuppressed = 0;
+
+	const uint32 maxMessages = mMaxMessagesPerSecond;
+	if (maxMessages == 0)
+		return true;
+
+	// the format string address identifies the call site
+	const uintptr_t address = (uintptr_t)format;
+	CallSite& site = mCallSites[((address >> 4) ^ (address >> 12)) & (NUM_CALLSITES-1)];
+
+	// a new second started or the slot was used by another call site: start a new window and report the messages suppressed in the last one
+	if (site.mFormat.load(std::memory_order_relaxed) != format || site.mWindowStart.load(std::memory_order_relaxed) != seconds)
+	{
+		if (site.mFormat.exchange(format) == format)
+			*outNumSuppressed = site.mNumSuppressed.exchange(0);
+		else
+			site.mNumSuppressed = 0;
+
+		site.mWindowStart	= seconds;
+		site.mCount			= 0;
+	}
+
+	if (site.mCount.fetch_add(1, std::memory_order_relaxed) < maxMessages)
+		return true;
+
+	site.mNumSuppressed++;
+	mNumSuppressed++;
+	return false;
+}
+
+
+// enqueue a message into the ring of the calling thread
+bool LogQueue::Push(ELogLevel logLevel, const char* format, va_list args)
+{
+	const Time now = Time::Now();
+
+	uint32 numSuppressed;
+	if (CheckRateLimit(format, now.mSeconds, &numSuppressed) == false)
+		return false;
+
+	Ring* ring = GetThreadRing();
+
+	// drop the message in case the ring is full
+	const uint32 writePos = ring->mWritePos.load(std::memory_order_relaxed);
+	if (writePos - ring->mReadPos.load(std::memory_order_acquire) >= RING_SIZE)
+	{
+		mNumDropped++;
+		return false;
+	}
+
+	Record& record = ring->mRecords[writePos & (RING_SIZE-1)];
+	record.mSequence		= mSequence++;
+	record.mSeconds			= now.mSeconds;
+	record.mNanoSeconds		= now.mNanoSeconds;
+	record.mNumSuppressed	= numSuppressed;
+	record.mLogLevel		= logLevel;
+	record.mLongText		= NULL;
+
+	// format the message into the record, long messages have to be allocated
+	va_list argsCopy;
+	va_copy(argsCopy, args);
+
+	const int length = vsnprintf(record.mText, MAX_TEXT_LENGTH, format, args);
+	if (length >= MAX_TEXT_LENGTH)
+	{
+		record.mLongText = new char[length+1];
+		vsnprintf(record.mLongText, length+1, format, argsCopy);
+	}
+	else if (length < 0)
+		record.mText[0] = '\0';
+
+	va_end(argsCopy);
+
+	// publish the record
+	ring->mWritePos.store(writePos + 1, std::memory_order_release);
+	return true;
+}
+
+
+// log all enqueued records in the order they were pushed
+void LogQueue::Flush()
+{
+	mFlushLock.Lock();
+
+	// copy the ring list so we don't block threads that log for the first time
+	mRingLock.Lock();
+	mTempRings = mRings;
+	mRingLock.Unlock();
+
+	String line;
+	const uint32 numRings = mTempRings.Size();
+	while (true)
+	{
+		// find the oldest record of all rings
+		Ring* oldestRing = NULL;
+		Record* oldestRecord = NULL;
+		for (uint32 i=0; i<numRings; ++i)
+		{
+			Ring* ring = mTempRings[i];
+
+			const uint32 readPos = ring->mReadPos.load(std::memory_order_relaxed);
+			if (readPos == ring->mWritePos.load(std::memory_order_acquire))
+				continue;
+
+			Record* record = &ring->mRecords[readPos & (RING_SIZE-1)];
+			if (oldestRecord == NULL || record->mSequence < oldestRecord->mSequence)
+			{
+				oldestRing = ring;
+				oldestRecord = record;
+			}
+		}
+
+		if (oldestRecord == NULL)
+			break;
+
+		const char* text = (oldestRecord->mLongText != NULL ? oldestRecord->mLongText : oldestRecord->mText);
+		if (oldestRecord->mNumSuppressed > 0)
+		{
+			line.Format("%s (%i similar messages suppressed)", text, oldestRecord->mNumSuppressed);
+			text = line.AsChar();
+		}
+
+		mLogManager->mLock.Lock();
+		mLogManager->LogMessage(Time(oldestRecord->mSeconds, oldestRecord->mNanoSeconds), text, oldestRecord->mLogLevel);
+		mLogManager->mLock.Unlock();
+
+		delete[] oldestRecord->mLongText;
+		oldestRecord->mLongText = NULL;
+
+		// hand the slot back to the producer
+		oldestRing->mReadPos.store(oldestRing->mReadPos.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	// free the rings of exited threads once they are drained (the orphan flag is checked first, so no record can follow)
+	mRingLock.Lock();
+	for (uint32 i=0; i<mRings.Size(); )
+	{
+		Ring* ring = mRings[i];
+		if (ring->mOrphaned.load(std::memory_order_acquire) == true && ring->mReadPos.load(std::memory_order_relaxed) == ring->mWritePos.load(std::memory_order_acquire))
+		{
+			mRings.Remove(i);
+			ring->Release();
+			continue;
+		}
+		++i;
+	}
+	mRingLock.Unlock();
+
+	// report the dropped messages
+	const uint64 numDropped = mNumDropped;
+	if (numDropped != mNumReportedDropped)
+	{
+		line.Format("%i log messages dropped (log queue full)", (int32)(numDropped - mNumReportedDropped));
+		mNumReportedDropped = numDropped;
+
+		mLogManager->mLock.Lock();
+		mLogManager->LogMessage(Time::Now(), line.AsChar(), LOGLEVEL_WARNING);
+		mLogManager->mLock.Unlock();
+	}
+
+	mFlushLock.Unlock();
+}
+
+
+// background thread main loop
+void LogQueue::WorkerLoop()
+{
+	std::unique_lock<std::mutex> lock(mWorkerLock);
+	while (mShutdown == false)
+	{
+		lock.unlock();
+		Flush();
+		lock.lock();
+
+		// the logging threads never signal (that could cost them a system call), so we poll
+		mWorkerCondition.wait_for(lock, std::chrono::milliseconds(10), [this] { return mShutdown; });
+	}
+}
+
+
+// wake up and end the background thread
+void LogQueue::StopWorker()
+{
+	{
+		std::lock_guard<std::mutex> lock(mWorkerLock);
+		mShutdown = true;
+	}
+
+	mWorkerCondition.notify_all();
+}
+
+} // namespace Core
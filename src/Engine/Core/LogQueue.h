@@ -0,0 +1,171 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __CORE_LOGQUEUE_H
+#define __CORE_LOGQUEUE_H
+
+// include required headers
+#include "StandardHeaders.h"
+#include "Array.h"
+#include "Mutex.h"
+#include "Thread.h"
+#include "LogCallbacks.h"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+
+namespace Core
+{
+
+// forward declaration
+class LogManager;
+
+// asynchronous log pipeline used by the log manager
+//  - every logging thread writes fixed size records (level, timestamp, message) into its own single producer/single consumer ring, no lock is taken
+//  - a thread has one ring per queue; when the thread exits, its rings are drained and freed by the queue
+//  - a background thread merges the rings in logging order, formats the timestamps and calls the log callbacks
+//  - records are dropped (and counted) in case the ring of a thread is full
+//  - each call site (format string) may log a limited number of messages per second, the rest is suppressed and reported with the next message of the call site
+class ENGINE_API LogQueue
+{
+	public:
+		enum
+		{
+			MAX_TEXT_LENGTH		= 256,		// longer messages are allocated
+			RING_SIZE			= 512,		// records per thread (power of two)
+			NUM_CALLSITES		= 256		// rate limiter slots (power of two)
+		};
+
+		// constructor & destructor
+		LogQueue(LogManager* logManager);
+		~LogQueue();
+
+		// start/stop the background thread
+		void Start();
+		void Stop();
+		bool IsRunning() const														{ return mThread != NULL; }
+
+		// enqueue a message (called from any thread), returns false in case it was dropped or suppressed
+		bool Push(ELogLevel logLevel, const char* format, va_list args);
+
+		// format and log all enqueued records (called by the background thread, or to flush the queue)
+		void Flush();
+
+		// maximum number of messages per call site and second (0 = unlimited)
+		void SetMaxMessagesPerSecond(uint32 maxMessages)							{ mMaxMessagesPerSecond = maxMessages; }
+		uint32 GetMaxMessagesPerSecond() const										{ return mMaxMessagesPerSecond; }
+
+		uint64 GetNumDroppedMessages() const										{ return mNumDropped; }
+		uint32 GetNumRings()														{ mRingLock.Lock(); const uint32 numRings = mRings.Size(); mRingLock.Unlock(); return numRings; }
+		uint64 GetNumSuppressedMessages() const										{ return mNumSuppressed; }
+
+	private:
+		struct Record
+		{
+			uint64				mSequence;
+			uint64				mSeconds;
+			uint32				mNanoSeconds;
+			uint32				mNumSuppressed;
+			ELogLevel			mLogLevel;
+			char*				mLongText;
+			char				mText[MAX_TEXT_LENGTH];
+		};
+
+		struct Ring
+		{
+			Ring(uint32 queueId) : mQueueId(queueId), mWritePos(0), mReadPos(0), mOrphaned(false), mClosed(false), mNumRefs(2)	{}
+
+			// drop one of the two references (producer thread, queue), the last one frees the ring
+			void Release()															{ if (--mNumRefs == 0) delete this; }
+
+			Record					mRecords[RING_SIZE];
+			uint32					mQueueId;
+			std::atomic<uint32>		mWritePos;		// only written by the producer
+			std::atomic<uint32>		mReadPos;		// only written by the consumer
+			std::atomic<bool>		mOrphaned;		// the producer thread exited, nothing is written anymore
+			std::atomic<bool>		mClosed;		// the queue was destroyed, the producer has to forget the ring
+			std::atomic<uint32>		mNumRefs;
+		};
+
+		// rings of a thread, one per queue it logged to (thread local, the destructor runs when the thread exits)
+		struct ThreadRings
+		{
+			ThreadRings() : mLastRing(NULL)											{}
+			~ThreadRings();
+
+			Ring*					mLastRing;
+			std::vector<Ring*>		mRings;			// no engine allocations, this may be destroyed after the engine shut down
+		};
+
+		struct CallSite
+		{
+			CallSite() : mFormat(NULL), mWindowStart(0), mCount(0), mNumSuppressed(0) {}
+
+			std::atomic<const char*>	mFormat;
+			std::atomic<uint64>			mWindowStart;
+			std::atomic<uint32>			mCount;
+			std::atomic<uint32>			mNumSuppressed;
+		};
+
+		// background thread
+		class Worker : public ThreadHandler
+		{
+			public:
+				Worker(LogQueue* queue) : ThreadHandler()							{ mQueue = queue; }
+				void Execute() override												{ mQueue->WorkerLoop(); mIsFinished = true; }
+				void Terminate() override											{ mQueue->StopWorker(); }
+			private:
+				LogQueue*	mQueue;
+		};
+
+		Ring* GetThreadRing();
+		bool CheckRateLimit(const char* format, uint64 seconds, uint32* outNumSuppressed);
+		void WorkerLoop();
+		void StopWorker();
+
+		LogManager*					mLogManager;
+		uint32						mId;
+		Array<Ring*>				mRings;
+		Mutex						mRingLock;
+		Array<Ring*>				mTempRings;
+		Mutex						mFlushLock;
+		CallSite					mCallSites[NUM_CALLSITES];
+
+		std::atomic<uint64>			mSequence;
+		std::atomic<uint64>			mNumDropped;
+		std::atomic<uint64>			mNumSuppressed;
+		uint64						mNumReportedDropped;
+		std::atomic<uint32>			mMaxMessagesPerSecond;
+
+		Thread*						mThread;
+		std::mutex					mWorkerLock;
+		std::condition_variable		mWorkerCondition;
+		bool						mShutdown;
+};
+
+} // namespace Core
+
+
+#endif
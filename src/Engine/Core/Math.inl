@@ -8,7 +8,7 @@
 inline bool Math::IsNaN(float x)
 {
 #if (defined NEUROMORE_PLATFORM_ANDROID || defined NEUROMORE_PLATFORM_LINUX)
-	return x == NAN;
+	return std::isnan(x);
 #else
 	return isnan<float>(x);
 #endif
@@ -18,7 +18,7 @@ inline bool Math::IsNaN(float x)
 inline bool Math::IsNaND(double x)
 {
 #if (defined NEUROMORE_PLATFORM_ANDROID || defined NEUROMORE_PLATFORM_LINUX)
-	return x == NAN;
+	return std::isnan(x);
 #else
 	return isnan<double>(x);
 #endif
@@ -28,7 +28,7 @@ inline bool Math::IsNaND(double x)
 inline bool Math::IsInf(float x)
 {
 #if (defined NEUROMORE_PLATFORM_ANDROID || defined NEUROMORE_PLATFORM_LINUX)
-	return x == INFINITY;
+	return std::isinf(x);
 #else
 	return isinf<float>(x);
 #endif
@@ -38,7 +38,7 @@ inline bool Math::IsInf(float x)
 inline bool Math::IsInfD(double x)
 {
 #if (defined NEUROMORE_PLATFORM_ANDROID || defined NEUROMORE_PLATFORM_LINUX)
-	return x == INFINITY;
+	return std::isinf(x);
 #else
 	return isinf<double>(x);
 #endif
@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include the required headers
+#include "ScratchArena.h"
+
+
+namespace Core
+{
+
+// constructor
+ScratchArena::ScratchArena(uint32 blockSize)
+{
+	mBlockSize		= blockSize;
+	mCurrentBlock	= 0;
+	mOffset			= 0;
+	mNumUsedBytes	= 0;
+	mPeakUsedBytes	= 0;
+}
+
+
+// destructor
+ScratchArena::~ScratchArena()
+{
+	FreeBlocks();
+}
+
+
+void* ScratchArena::Allocate(uint32 numBytes)
+{
+	// round up, so the next allocation is aligned, too
+	numBytes = (numBytes + ALIGNMENT - 1) & ~(uint32)(ALIGNMENT - 1);
+	if (numBytes == 0)
+		numBytes = ALIGNMENT;
+
+	// find a block with enough space left (blocks after the current one are empty)
+	while (mCurrentBlock < mBlocks.Size() && mOffset + numBytes > mBlocks[mCurrentBlock].mSize)
+	{
+		mCurrentBlock++;
+		mOffset = 0;
+	}
+
+	if (mCurrentBlock >= mBlocks.Size())
+	{
+		AddBlock(numBytes);
+		mCurrentBlock = mBlocks.Size() - 1;
+		mOffset = 0;
+	}
+
+	void* result = mBlocks[mCurrentBlock].mData + mOffset;
+	mOffset += numBytes;
+
+	mNumUsedBytes += numBytes;
+	mPeakUsedBytes = Max(mPeakUsedBytes, mNumUsedBytes);
+
+	return result;
+}
+
+
+void ScratchArena::Reset()
+{
+	// several blocks were needed: replace them by a single one that can hold everything
+	if (mBlocks.Size() > 1)
+	{
+		const uint32 peakUsedBytes = mPeakUsedBytes;
+		FreeBlocks();
+		AddBlock(peakUsedBytes);
+	}
+
+	mCurrentBlock	= 0;
+	mOffset			= 0;
+	mNumUsedBytes	= 0;
+	mPeakUsedBytes	= 0;
+}
+
+
+void ScratchArena::Clear()
+{
+	FreeBlocks();
+
+	mCurrentBlock	= 0;
+	mOffset			= 0;
+	mNumUsedBytes	= 0;
+	mPeakUsedBytes	= 0;
+}
+
+
+uint32 ScratchArena::GetNumAllocatedBytes() const
+{
+	uint32 numBytes = 0;
+	const uint32 numBlocks = mBlocks.Size();
+	for (uint32 i=0; i<numBlocks; ++i)
+		numBytes += mBlocks[i].mSize;
+
+	return numBytes;
+}
+
+
+void ScratchArena::AddBlock(uint32 minSize)
+{
+	Block block;
+	block.mSize		= Max(minSize, mBlockSize);
+	block.mMemory	= (uint8*)Core::Allocate(block.mSize + ALIGNMENT - 1);
+	block.mData		= (uint8*)(((size_t)block.mMemory + ALIGNMENT - 1) & ~(size_t)(ALIGNMENT - 1));
+
+	mBlocks.Add(block);
+}
+
+
+void ScratchArena::FreeBlocks()
+{
+	const uint32 numBlocks = mBlocks.Size();
+	for (uint32 i=0; i<numBlocks; ++i)
+		Core::Free(mBlocks[i].mMemory);
+
+	mBlocks.Clear();
+}
+
+} // namespace Core
@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __CORE_SCRATCHARENA_H
+#define __CORE_SCRATCHARENA_H
+
+// include required headers
+#include "StandardHeaders.h"
+#include "Array.h"
+
+
+namespace Core
+{
+
+// linear (bump pointer) allocator for temporary buffers that only live during one update
+//  - allocations are aligned to cache lines and are never freed individually
+//  - Reset() releases everything at once; memory is kept, so after the first few updates no heap allocation happens anymore
+//  - use Scope to release the allocations of a single function early
+class ENGINE_API ScratchArena
+{
+	public:
+		enum { ALIGNMENT = 64 };
+
+		// constructor & destructor
+		ScratchArena(uint32 blockSize = 64 * 1024);
+		~ScratchArena();
+
+		// allocate uninitialized memory
+		void* Allocate(uint32 numBytes);
+		template <class T> T* Allocate(uint32 numElements)						{ return static_cast<T*>(Allocate(numElements * sizeof(T))); }
+
+		// release all allocations
+		void Reset();
+
+		// release all allocations and free the memory
+		void Clear();
+
+		// memory statistics
+		uint32 GetNumUsedBytes() const											{ return mNumUsedBytes; }
+		uint32 GetNumAllocatedBytes() const;
+
+		// releases all allocations made during its lifetime
+		class Scope
+		{
+			public:
+				Scope(ScratchArena& arena) : mArena(arena)						{ mBlockIndex = arena.mCurrentBlock; mOffset = arena.mOffset; mNumUsedBytes = arena.mNumUsedBytes; }
+				~Scope()														{ mArena.mCurrentBlock = mBlockIndex; mArena.mOffset = mOffset; mArena.mNumUsedBytes = mNumUsedBytes; }
+			private:
+				ScratchArena&	mArena;
+				uint32			mBlockIndex;
+				uint32			mOffset;
+				uint32			mNumUsedBytes;
+		};
+
+	private:
+		struct Block
+		{
+			uint8*	mMemory;			// allocated memory
+			uint8*	mData;				// aligned start
+			uint32	mSize;				// usable size
+		};
+
+		// not copyable
+		ScratchArena(const ScratchArena&);
+		ScratchArena& operator=(const ScratchArena&);
+
+		void AddBlock(uint32 minSize);
+		void FreeBlocks();
+
+		Array<Block>	mBlocks;
+		uint32			mBlockSize;		// size of a new block
+		uint32			mCurrentBlock;	// block we are allocating from
+		uint32			mOffset;		// offset inside the current block
+		uint32			mNumUsedBytes;	// sum of all live allocations
+		uint32			mPeakUsedBytes;	// high watermark since the last Reset()
+};
+
+} // namespace Core
+
+
+#endif
@@ -39,6 +39,9 @@
 #include <stdarg.h>
 #include <wchar.h>
 
+// heap interface
+#include "Allocator.h"
+
 
 #if (CORE_COMPILER != CORE_COMPILER_GCC)
 	#include <new.h>
@@ -85,36 +88,6 @@
 namespace Core
 {
 
-inline void* Allocate(size_t numBytes)
-{
-	return malloc(numBytes);
-}
-
-inline void* Realloc(void* memory, size_t numBytes)
-{
-	void* newMemPtr = realloc( memory, numBytes );
-
-	if (newMemPtr == NULL)
-	{
-        #ifdef CORE_DEBUG
-            #ifdef NEUROMORE_PLATFORM_WINDOWS
-        		OutputDebugStringA("CRITICAL ERROR: REALLOCATION FAILURE");
-            #endif
-        #endif
-
-		CORE_ASSERT(newMemPtr != 0);
-
-		return memory;
-	}
-
-	return newMemPtr;
-}
-
-inline void Free(void* memory)
-{ 
-	free(memory);
-}
-
 inline void* MemCopy(void* dest, const void* source, const size_t numBytes)
 {
 	return memcpy(dest, source, numBytes);
@@ -36,79 +36,55 @@ namespace Core
 // constructor
 String::String()
 {
-	mData		= NULL;
-	mLength		= 0;
-	mMaxLength	= 0;
+	InitInline();
 }
 
 
 // constructor
 String::String(const char* other)
 {
-	mData		= NULL;
-	mLength		= 0;
-	mMaxLength	= 0;
+	InitInline();
 
 	if (other == NULL)
 		return;
 	
 	Alloc( (uint32)strlen(other) );
-	
-	if (mData != NULL)
-		MemCopy( mData, other, mLength*sizeof(char) );
+	MemCopy( GetData(), other, mLength*sizeof(char) );
 }
 
 // constructor
 String::String(char c)
 {
-	mData		= NULL;
-	mLength		= 0;
-	mMaxLength	= 0;
+	InitInline();
 
 	Alloc(1);
-	
-	if (mData != NULL)
-		mData[0] = c;
+	GetData()[0] = c;
 }
 
 
 // copy constructor
 String::String(const String& other)
 {
-	mData		= NULL;
-	mLength		= 0;
-	mMaxLength	= 0;
+	InitInline();
 
-	if (other.mData == NULL)
-		return;
-	
 	Alloc(other.GetLength());
-	
-	if (mData != NULL)
-		Core::MemCopy( mData, other.mData, (other.GetLength()+1)*sizeof(char) );
+	Core::MemCopy( GetData(), other.GetData(), (other.GetLength()+1)*sizeof(char) );
 }
 
 
 // move constructor
 String::String(String&& other)
 {
-	// move data to this object
-	mData		= other.mData;
-	mLength		= other.mLength;
-	mMaxLength	= other.mMaxLength;
-
-	// release data from source object
-	other.mData = NULL;
-	other.mLength = 0;
-	other.mMaxLength = 0;
+	// move data to this object and release it from the source object
+	TakeData(other);
 }
 
 
 // destructor
 String::~String()
 { 
-	if (mData != NULL)
-		Core::Free( mData ); 
+	if (IsInline() == false)
+		Core::Free( mHeapData ); 
 }
 
 // construct this string from two strings
@@ -117,29 +93,36 @@ String::String(const char* sA, uint32 lengthA, const char* sB, uint32 lengthB)
 	CORE_ASSERT(sA);
 	CORE_ASSERT(sB);
 
-	mData		= NULL;
-	mMaxLength	= 0;
-	mLength		= 0;
+	InitInline();
 
 	Alloc(lengthA+lengthB, 0);
-	Core::MemCopy(mData, sA, lengthA * sizeof(char));
-	Core::MemCopy(mData+lengthA, sB, lengthB * sizeof(char));
+	char* data = GetData();
+	Core::MemCopy(data, sA, lengthA * sizeof(char));
+	Core::MemCopy(data+lengthA, sB, lengthB * sizeof(char));
 }
 
 
 // format a string, returns itself
+// the capacity is kept, so strings that are formatted repeatedly don't reallocate
 String& String::Format(const char* text, ...)
 {
-	if (mMaxLength < 1024)
-		Alloc(1024, 0);
-
 	va_list args;
 	va_start(args, text);
 	
-		//const int32 len = vsprintf(mData, text, args);
-		const int32 len = vsnprintf( mData, mMaxLength, text, args );
+		// try to format into the current buffer first
+		va_list argsCopy;
+		va_copy(argsCopy, args);
+		const int32 len = vsnprintf( GetData(), mMaxLength+1, text, argsCopy );
+		va_end(argsCopy);
 		CORE_ASSERT(len >= 0);
 
+		// the buffer is too small: grow it and format again
+		if ((uint32)len > mMaxLength)
+		{
+			Alloc((uint32)len, 0);
+			vsnprintf( GetData(), mMaxLength+1, text, args );
+		}
+
 	va_end(args);
 
 	Alloc((uint32)len, 0);
@@ -152,18 +135,23 @@ String& String::FormatAdd(const char* text, ...)
 {
 	const uint32 oldLength = mLength;
 
-	if (mMaxLength < 1024)
-		Alloc(1024, 0);
-
 	va_list args;
 	va_start(args, text);
 	
-		//const int32 len = vsprintf(mData+oldLength, text, args);
-		const int32 availableLength = mMaxLength-oldLength;
-		CORE_ASSERT(availableLength >= 0 );
-		const int32 len = vsnprintf( mData+oldLength, availableLength, text, args );
+		// try to format into the remaining space of the current buffer first
+		va_list argsCopy;
+		va_copy(argsCopy, args);
+		const int32 len = vsnprintf( GetData()+oldLength, mMaxLength-oldLength+1, text, argsCopy );
+		va_end(argsCopy);
 		CORE_ASSERT(len >= 0);
 
+		// the buffer is too small: grow it and format again
+		if (oldLength + (uint32)len > mMaxLength)
+		{
+			Alloc(oldLength + len, 0);
+			vsnprintf( GetData()+oldLength, mMaxLength-oldLength+1, text, args );
+		}
+
 	va_end(args);
 
 	Alloc(oldLength + len, 0);
@@ -178,32 +166,19 @@ String& String::Copy(const char* what, uint32 length)
 {
 	if (what == NULL)
 	{
-		if (mData)
-		{
-			Core::Free(mData);
-			mData		= NULL;
-			mLength		= 0;
-			mMaxLength	= 0;
-		}
+		FreeData();
 		return *this;
 	}
 
-	// remove existing data
-	if (mData)
-	{
-		//Core::Free(mData);
-		mLength		= 0;
-		mData[0]	= 0;
-	}
-
-	//mData = NULL;
+	// remove existing data (keep the memory)
+	mLength		= 0;
+	GetData()[0]= 0;
 	
 	// alloc new
 	Alloc(length, 0);
 
 	// copy new data
-	if (mData)
-		Core::MemCopy(mData, what, length * sizeof(char));
+	Core::MemCopy(GetData(), what, length * sizeof(char));
 
 	return *this;
 }
@@ -223,8 +198,9 @@ String& String::Concat(const char* what, uint32 length)
 	else
 		mLength += length;
 
-	Core::MemCopy(mData+oldLength, what, length * sizeof(char));
-	mData[mLength] = 0;
+	char* data = GetData();
+	Core::MemCopy(data+oldLength, what, length * sizeof(char));
+	data[mLength] = 0;
 	
 	return *this;
 }
@@ -232,36 +208,33 @@ String& String::Concat(const char* what, uint32 length)
 
 void String::Alloc(uint32 numCodeUnits, uint32 extraUnits)
 {
-	// if we have a zero length, do nothing if we don't have to
-	if (numCodeUnits+extraUnits == 0)
+	// grow the buffer (the data moves to the heap once it doesn't fit inline anymore)
+	if (numCodeUnits+extraUnits > mMaxLength)
 	{
-		if (mData != NULL)
-			mData[0] = 0;
-
-		mLength = 0;
-		return;
-	}
+		const uint32 maxLength = numCodeUnits+extraUnits;
 
-	if ((numCodeUnits+extraUnits > mMaxLength) || mData==NULL)
-	{
-		mLength		= numCodeUnits;
-		mMaxLength	= mLength+extraUnits;
+		char* data;
+		if (IsInline() == true)
+		{
+			data = (char*)Core::Allocate( (maxLength + 1)*sizeof(char), MEMORYTAG_STRING );
+			if (data == NULL)
+				return;
 
-		if (mData != NULL)
-			mData	= (char*)Core::Realloc(mData, (mMaxLength + 1)*sizeof(char) );
+			Core::MemCopy(data, mInlineData, (mLength + 1)*sizeof(char));
+		}
 		else
-			mData	= (char*)Core::Allocate( (mMaxLength + 1)*sizeof(char) );
-
-		if (mData == NULL)
-			return;
+		{
+			data = (char*)Core::Realloc(mHeapData, (maxLength + 1)*sizeof(char) );
+			if (data == NULL)
+				return;
+		}
 
-		mData[numCodeUnits] = 0;	
-	}
-	else
-	{
-		mLength	= numCodeUnits;
-		mData[numCodeUnits] = 0;	
+		mHeapData	= data;
+		mMaxLength	= maxLength;
 	}
+
+	mLength	= numCodeUnits;
+	GetData()[numCodeUnits] = 0;
 }
 
 
@@ -269,7 +242,7 @@ void String::Alloc(uint32 numCodeUnits, uint32 extraUnits)
 // convert the string to a boolean. string may be "1", "0", "true", "false", "yes", "no") (non case sensitive)
 bool String::ToBool() const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return false;
 
 	// check if it's true, else return false
@@ -280,36 +253,36 @@ bool String::ToBool() const
 // convert the string to an int32
 int32 String::ToInt() const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return 0;
 
-	return atoi(mData);
+	return atoi(GetData());
 }
 
 
 // convert the string to a float
 float String::ToFloat() const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return 0.0f;
 
-	return atof(mData);
+	return atof(GetData());
 }
 
 
 // convert the string to a double
 double String::ToDouble() const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return 0.0;
 
-	return atof(mData);
+	return atof(GetData());
 }
 
 
 bool String::IsValidFloat() const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return false;
 
 	const uint32 numValidChars = 15;
@@ -318,7 +291,7 @@ bool String::IsValidFloat() const
 	// check if all characters are valid
 	for (uint32 i=0; i<mLength; ++i)
 	{
-		char c = mData[i];
+		char c = GetData()[i];
 
 		// if the + or - is not the first character
 		// TODO: doesn't work well for scientific notation
@@ -346,7 +319,7 @@ bool String::IsValidFloat() const
 // check if this is a valid int
 bool String::IsValidInt() const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return false;
 
 	char validChars[] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '-' };
@@ -354,7 +327,7 @@ bool String::IsValidInt() const
 	// check if all characters are valid
 	for (uint32 i=0; i<mLength; ++i)
 	{
-		char c = mData[i];
+		char c = GetData()[i];
 
 		// if the + or - is not the first character
 		if (c == '+' || c =='-')
@@ -381,7 +354,7 @@ bool String::IsValidInt() const
 // check if this is a valid bool
 bool String::IsValidBool() const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return false;
 
 	if (IsEqualNoCase("1") || IsEqualNoCase("0") || IsEqualNoCase("false") || IsEqualNoCase("true") || IsEqualNoCase("yes") || IsEqualNoCase("no"))
@@ -404,16 +377,16 @@ void String::FromBool(bool value)
 // init from an integer
 void String::FromInt(int32 value)
 {
-	Alloc(32);
-	sprintf(mData, "%d", value);
-	Alloc( (uint32)strlen(mData) );
+	char buffer[32];
+	const int32 length = sprintf(buffer, "%d", value);
+	Copy(buffer, length);
 }
 
 
 // init from a float
 void String::FromFloat(float value)
 {
-	Alloc(32);
+	char buffer[64];
 
 	// determine whether to use normal or scientic view
 	const float maxValue = 1000000.0f;
@@ -423,12 +396,13 @@ void String::FromFloat(float value)
 
 
 	// convert float to string with fixed number of chars
+	int32 length;
 	if (useExponent == true)
-		sprintf(mData, "%.4e", value);
+		length = snprintf(buffer, sizeof(buffer), "%.4e", value);
 	else
-		sprintf(mData, "%.4f", value);
+		length = snprintf(buffer, sizeof(buffer), "%.4f", value);
 	
-	Alloc( (uint32)strlen(mData) );
+	Copy(buffer, Min<int32>(length, sizeof(buffer)-1));
 
 	// trim all ending zeros
 	if (useExponent == false)
@@ -446,7 +420,7 @@ void String::FromFloat(float value)
 // init from a double
 void String::FromDouble(double value)
 {
-	Alloc(32);
+	char buffer[384];
 
 	// determine whether to use normal or scientic view
 	const double maxValue = 100000000000.0;
@@ -456,12 +430,13 @@ void String::FromDouble(double value)
 
 
 	// convert float to string with fixed number of chars
+	int32 length;
 	if (useExponent == true)
-		sprintf(mData, "%0.8e", value);
+		length = snprintf(buffer, sizeof(buffer), "%0.8e", value);
 	else
-		sprintf(mData, "%.8f", value);
+		length = snprintf(buffer, sizeof(buffer), "%.8f", value);
 	
-	Alloc( (uint32)strlen(mData) );
+	Copy(buffer, Min<int32>(length, sizeof(buffer)-1));
 
 
 	// trim all ending zeros
@@ -503,7 +478,7 @@ void String::FromVector4(const Vector4& value)
 // check if this is a valid Vector4
 bool String::IsValidVector4() const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return false;
 
 	// split the string into different floats
@@ -528,7 +503,7 @@ StringCharacter String::GetLast() const
 		return StringCharacter();
 
 	// return the last char
-	return StringCharacter( mData[GetLength()-1] );
+	return StringCharacter( GetData()[GetLength()-1] );
 }
 
 
@@ -540,7 +515,7 @@ StringCharacter String::GetFirst() const
 		return StringCharacter();
 
 	// return the first char
-	return StringCharacter( mData[0] );
+	return StringCharacter( GetData()[0] );
 }
 
 
@@ -549,7 +524,7 @@ StringCharacter String::GetFirst() const
 // count the number of characters in a string
 uint32 String::CountNumChars(const StringCharacter& character) const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return 0;
 	 
 	uint32 count = 0;
@@ -568,25 +543,25 @@ uint32 String::CountNumChars(const StringCharacter& character) const
 // find a given substring, returns the position, or CORE_INVALIDINDEX32 when not found
 uint32 String::Find(const char* subString) const
 {
-	if (mData == NULL || mLength==0 || subString == NULL || subString[0] == 0)
+	if (mLength == 0 || subString == NULL || subString[0] == 0)
 		return CORE_INVALIDINDEX32;
 
 	// try to locate the string
-	const char* strResult = strstr(mData, subString);
+	const char* strResult = strstr(GetData(), subString);
 	
 	// if the string has not been found
 	if (strResult == NULL) 
 		return CORE_INVALIDINDEX32;
 	
 	// else return the position
-	return (strResult - mData);
+	return (strResult - GetData());
 }
 
 
 // search for a given character, starting from the end of the string to the start, and return the code unit index, or CORE_INVALIDINDEX32 when not found
 uint32 String::FindRight(const StringCharacter& character) const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return CORE_INVALIDINDEX32;
 
 	// search the string from end to start
@@ -608,7 +583,7 @@ uint32 String::FindRight(const StringCharacter& character) const
 Array<String> String::Split(const StringCharacter& splitChar) const
 {
 	Array<String> result;
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return result;
 
 	// count the number of split characters
@@ -633,9 +608,9 @@ Array<String> String::Split(const StringCharacter& splitChar) const
 			{
 				result.AddEmpty();
 				if (curChar != splitChar)
-					result.GetLast().Copy( &mData[startOffset], iterator.GetIndex() - startOffset );
+					result.GetLast().Copy( &GetData()[startOffset], iterator.GetIndex() - startOffset );
 				else
-					result.GetLast().Copy( &mData[startOffset], iterator.GetIndex() - startOffset - numSplitCharBytes );
+					result.GetLast().Copy( &GetData()[startOffset], iterator.GetIndex() - startOffset - numSplitCharBytes );
 			}
 			break;
 		}
@@ -644,7 +619,7 @@ Array<String> String::Split(const StringCharacter& splitChar) const
 		if (curChar == splitChar)
 		{
 			result.AddEmpty();
-			result.GetLast().Copy( &mData[startOffset], iterator.GetIndex() - startOffset - numSplitCharBytes );
+			result.GetLast().Copy( &GetData()[startOffset], iterator.GetIndex() - startOffset - numSplitCharBytes );
 			startOffset = iterator.GetIndex();
 		}
 	}
@@ -665,7 +640,7 @@ uint32 String::SplitFast(Array<const char*>& positions, Array<uint32>& lengths,
 	positions.Clear();
 	lengths.Clear();
 
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return 0;
 
 	// count number of delimiters and reserver space in arrays (allocs if arrays are too small)
@@ -688,7 +663,7 @@ uint32 String::SplitFast(Array<const char*>& positions, Array<uint32>& lengths,
 		{
 			if (startOffset != iterator.GetIndex())
 			{
-				positions.Add(&mData[startOffset]);
+				positions.Add(&GetData()[startOffset]);
 				if (curChar != splitChar)
 					lengths.Add(iterator.GetIndex() - startOffset);
 				else
@@ -700,7 +675,7 @@ uint32 String::SplitFast(Array<const char*>& positions, Array<uint32>& lengths,
 		// if the current character is the split character
 		if (curChar == splitChar)
 		{
-			positions.Add(&mData[startOffset]);
+			positions.Add(&GetData()[startOffset]);
 			lengths.Add(iterator.GetIndex() - startOffset - numSplitCharBytes);
 			startOffset = iterator.GetIndex();
 		}
@@ -709,7 +684,7 @@ uint32 String::SplitFast(Array<const char*>& positions, Array<uint32>& lengths,
 	// if there are no substrings, return itself
 	if (positions.Size() == 0)
 	{
-		positions.Add(mData);
+		positions.Add(GetData());
 		lengths.Add(mLength);
 	}
 
@@ -750,7 +725,7 @@ String& String::Join(const Array<String>& array, String separator,  String& resu
 bool String::IsEqual(const char* other) const
 {
 	// compare
-	return (SafeCompare(mData, other) == 0);
+	return (SafeCompare(GetData(), other) == 0);
 }
 
 
@@ -766,7 +741,7 @@ bool String::IsEqualNoCase(const char* other) const
 // compares two strings (case sensitive) returns 0 when equal, -1 when this string is bigger and 1 when other is bigger
 int32 String::Compare(const char* other) const
 {
-	return SafeCompare(mData, other);
+	return SafeCompare(GetData(), other);
 }
 
 
@@ -787,7 +762,7 @@ int32 String::CompareNoCase(const char* other) const
 // returns true if the string contains visible characters, false if it contains only whitespace
 bool String::ContainsVisibleCharacter() const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return false;
 
 	// iterate over string and check for ascii characters that are usually printed
@@ -808,7 +783,7 @@ bool String::ContainsVisibleCharacter() const
 // returns the number of words inside this string
 uint32 String::CalcNumWords() const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return 0;
 
 	uint32 numWords = 0;
@@ -865,7 +840,7 @@ String String::ExtractWord(uint32 wordNr) const
 {
 	CORE_ASSERT(wordNr < CalcNumWords());	// slow in debugmode, but more safe
 
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return String();
 
 	String result;
@@ -904,9 +879,9 @@ String String::ExtractWord(uint32 wordNr) const
 		if (numWords == wordNr)
 		{
 			if (iterator.HasReachedEnd() == false)
-				result.Copy( &mData[startOffset], curPos - startOffset );
+				result.Copy( &GetData()[startOffset], curPos - startOffset );
 			else
-				result.Copy( &mData[startOffset], curPos - startOffset + 1 );
+				result.Copy( &GetData()[startOffset], curPos - startOffset + 1 );
 
 			return result;
 		}
@@ -930,7 +905,7 @@ String String::ExtractWord(uint32 wordNr) const
 		{
 			if (numWords == wordNr)
 			{
-				result.Copy( &mData[curPos], mLength - curPos );
+				result.Copy( &GetData()[curPos], mLength - curPos );
 				return result;
 			}
 
@@ -954,7 +929,7 @@ bool String::RemoveFirstPart(const char* part)
 	const uint32 partLength = (uint32)strlen(part);
 
 	// remove the part
-	Core::MemMove(mData+pos, mData+pos+partLength, (mLength-(pos+partLength)) * sizeof(char) );
+	Core::MemMove(GetData()+pos, GetData()+pos+partLength, (mLength-(pos+partLength)) * sizeof(char) );
 
 	// resize the memory amount
 	Alloc(mLength - partLength, 0);
@@ -966,7 +941,7 @@ bool String::RemoveFirstPart(const char* part)
 // removes all given parts from a string (all occurences)
 bool String::RemoveAllParts(const char* part)
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return false;
 
 	bool result = false;
@@ -980,7 +955,7 @@ bool String::RemoveAllParts(const char* part)
 // removes a given set of characters from the string
 bool String::RemoveChars(const Array<StringCharacter>& charSet)
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return false;
 
 	bool result = false;
@@ -1004,7 +979,7 @@ bool String::RemoveChars(const Array<StringCharacter>& charSet)
 // removes a given set of characters from the string
 bool String::RemoveChars(const char* characterSet)
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return false;
 
 	bool result = false;
@@ -1034,7 +1009,7 @@ bool String::RemoveChars(const char* characterSet)
 // this removes everything after the last encountered dot, so "filename.bla" would result in "filename"
 void String::RemoveFileExtension()
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return;
 
 	// search for the dot, starting from the end of the string, searching towards the first character
@@ -1072,14 +1047,14 @@ void String::RemoveFileExtension()
 
 	// simply terminate the string at the dot location
 	mLength = dotPos;
-	mData[dotPos] = 0;
+	GetData()[dotPos] = 0;
 }
 
 
 // extract the file name
 String String::ExtractFilename() const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return String();
 
 	// find the forward slash and/or back slash
@@ -1100,7 +1075,7 @@ String String::ExtractFilename() const
 
 	// copy the filename into the result string
 	String result;
-	result.Copy(mData + index + 1, mLength - index - 1);
+	result.Copy(GetData() + index + 1, mLength - index - 1);
 
 	// if there is no dot in the filename, then there is no filename, so return an empty string
 	if (result.FindRight( StringCharacter::dot ) == CORE_INVALIDINDEX32)
@@ -1114,7 +1089,7 @@ String String::ExtractFilename() const
 // extract the path
 String String::ExtractPath(bool includeSlashAtEnd) const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return String();
 
 	// first extract the file name
@@ -1122,7 +1097,7 @@ String String::ExtractPath(bool includeSlashAtEnd) const
 
 	// since the filename is stored at the end, everything in front of the filename is considered as path
 	String result;
-	result.Copy(mData, mLength - filename.GetLength());
+	result.Copy(GetData(), mLength - filename.GetLength());
 
 	// find the forward slash and/or back slash
 	const uint32 forwardSlashIndex = result.FindRight( StringCharacter::forwardSlash );
@@ -1171,7 +1146,7 @@ String String::ExtractPath(bool includeSlashAtEnd) const
 // remove all given trimChars on the left of the string
 void String::TrimLeft(const StringCharacter& trimChar)
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return;
 
 	// for all characters in the string
@@ -1188,7 +1163,7 @@ void String::TrimLeft(const StringCharacter& trimChar)
 				return;
 
 			const uint32 numUnits = (mLength - index) + 1;	// +1 because of the '\0'
-			Core::MemMove(mData, mData + index, numUnits * sizeof(char));
+			Core::MemMove(GetData(), GetData() + index, numUnits * sizeof(char));
 			mLength -= index;
 			return;
 		}
@@ -1203,7 +1178,7 @@ void String::TrimLeft(const StringCharacter& trimChar)
 // remove all given trimChars on the right of the string
 void String::TrimRight(const StringCharacter& trimChar)
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return;
 	
 	StringIterator iterator( *this );
@@ -1219,7 +1194,7 @@ void String::TrimRight(const StringCharacter& trimChar)
 			if ((int32)index != (int32)(mLength-1))
 			{
 				mLength = index + 1;
-				mData[index+1] = 0;
+				GetData()[index+1] = 0;
 			}
 
 			return;
@@ -1243,7 +1218,7 @@ void String::Trim(const StringCharacter& trimChar)
 // remove the last character if it is equal to a given character
 void String::RemoveLastCharacterIfEqualTo(const StringCharacter& lastCharacter)
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return;
 	
 	StringIterator iterator( *this );
@@ -1254,7 +1229,7 @@ void String::RemoveLastCharacterIfEqualTo(const StringCharacter& lastCharacter)
 		// remove the last char
 		const uint32 index = c.GetIndex();
 		mLength = index;
-		mData[index] = 0;
+		GetData()[index] = 0;
 	}
 }
 
@@ -1262,16 +1237,16 @@ void String::RemoveLastCharacterIfEqualTo(const StringCharacter& lastCharacter)
 // remove the first character if it is equal to a given character
 void String::RemoveFirstCharacterIfEqualTo(const StringCharacter& firstCharacter)
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return;
 	
 	StringIterator iterator( *this );
 	StringCharacter c = iterator.GetNextCharacter();
 	if (c == firstCharacter)
 	{
-		MemMove((uint8*)mData, (uint8*)mData+sizeof(char), (mLength-1)*sizeof(char));
+		MemMove((uint8*)GetData(), (uint8*)GetData()+sizeof(char), (mLength-1)*sizeof(char));
 		mLength--;
-		mData[mLength] = 0;
+		GetData()[mLength] = 0;
 	}
 }
 
@@ -1279,7 +1254,7 @@ void String::RemoveFirstCharacterIfEqualTo(const StringCharacter& firstCharacter
 // extract the file extension
 String String::ExtractFileExtension() const
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return String();
 
 	// search for the dot, starting from the end of the string, searching towards the first character
@@ -1316,7 +1291,7 @@ String String::ExtractFileExtension() const
 		return String();
 
 	// return the extension
-	return String( (const char*)(&mData[dotPos+1]) );
+	return String( (const char*)(&GetData()[dotPos+1]) );
 }
 
 
@@ -1341,7 +1316,7 @@ String String::ConvertedToNativePath() const
 // for example replace all %NAME% parts of the string with a given name
 void String::Replace(const char* what, const char* with)
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return;
 
 	const uint32 withLen = (uint32)strlen(with);
@@ -1356,17 +1331,17 @@ void String::Replace(const char* what, const char* with)
 	{
 		//numPasses++;
 		temp.Alloc( mLength + (withLen - whatLen), 0 );
-		Core::MemCopy(temp.mData, mData, location * sizeof(char));
-		Core::MemCopy(temp.mData + location, with, withLen * sizeof(char));
-		Core::MemCopy(temp.mData + location + withLen, mData + location + whatLen, (mLength - location - whatLen) * sizeof(char));
+		Core::MemCopy(temp.GetData(), GetData(), location * sizeof(char));
+		Core::MemCopy(temp.GetData() + location, with, withLen * sizeof(char));
+		Core::MemCopy(temp.GetData() + location + withLen, GetData() + location + whatLen, (mLength - location - whatLen) * sizeof(char));
 		*this = temp;
 
 		// try to locate the string again
-		const char* strResult = strstr(mData + location + withLen, what);
+		const char* strResult = strstr(GetData() + location + withLen, what);
 		if (strResult == NULL) 
 			location = CORE_INVALIDINDEX32; // if the string has not been found break the loop
 		else
-			location = (strResult - mData); // in case the string has been found go again
+			location = (strResult - GetData()); // in case the string has been found go again
 	}
 }
 
@@ -1375,7 +1350,7 @@ void String::Replace(const char* what, const char* with)
 void String::Replace(const StringCharacter& c, const StringCharacter& with)
 {
 	// if no data has been allocated yet skip directly
-	if (c == with || mData == NULL || mLength == 0)
+	if (c == with || mLength == 0)
 		return;
 
 	const uint32 numCBytes = c.CalcNumRequiredUTF8Bytes();
@@ -1391,7 +1366,7 @@ void String::Replace(const StringCharacter& c, const StringCharacter& with)
 		{
 			uint32 numWithBytes = with.CalcNumRequiredUTF8Bytes();
 			if (numCBytes == numWithBytes)
-				with.AsUTF8( &mData[character.GetIndex()], &numWithBytes, false );
+				with.AsUTF8( &GetData()[character.GetIndex()], &numWithBytes, false );
 			else
 			{
 				const int32 numExtraChars = numWithBytes - numCBytes;
@@ -1399,11 +1374,11 @@ void String::Replace(const StringCharacter& c, const StringCharacter& with)
 					Resize( mLength + numExtraChars, ' ', false );
 
 				const uint32 numBytesToMove = mLength - character.GetIndex() - numExtraChars - 1;
-				MemMove( &mData[character.GetIndex()+numWithBytes], &mData[iterator.GetIndex()], numBytesToMove);
-				with.AsUTF8( &mData[character.GetIndex()], &numWithBytes, false );
+				MemMove( &GetData()[character.GetIndex()+numWithBytes], &GetData()[iterator.GetIndex()], numBytesToMove);
+				with.AsUTF8( &GetData()[character.GetIndex()], &numWithBytes, false );
 
 				if (numExtraChars < 0)
-					Resize( (uint32)strlen(mData) );	// adjust the length if we did shrink down
+					Resize( (uint32)strlen(GetData()) );	// adjust the length if we did shrink down
 
 				iterator.Init( *this );
 				iterator.SetIndex(character.GetIndex()+numWithBytes);
@@ -1417,7 +1392,7 @@ void String::Replace(const StringCharacter& c, const StringCharacter& with)
 void String::Remove(uint32 pos, uint32 length)
 {
 	// if no data has been allocated yet skip directly
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return;
 
 	// invalid range -> result is an unchanged string
@@ -1429,7 +1404,7 @@ void String::Remove(uint32 pos, uint32 length)
 		length = mLength - pos;
 
 	// move second part of the string up 
-	MemMove(&mData[pos], &mData[pos + length], 1 + mLength - pos - length);
+	MemMove(&GetData()[pos], &GetData()[pos + length], 1 + mLength - pos - length);
 
 	// set new string length
 	Resize(mLength - length);
@@ -1440,7 +1415,7 @@ void String::Remove(uint32 pos, uint32 length)
 void String::Crop(uint32 pos, uint32 length)
 {
 	// if no data has been allocated yet skip directly
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return;
 
 	// invalid range -> result is an unchanged string
@@ -1452,7 +1427,7 @@ void String::Crop(uint32 pos, uint32 length)
 		length = mLength - pos;
 
 	// move selection to the beginning
-	MemMove(&mData, &mData[pos], length);
+	MemMove(GetData(), &GetData()[pos], length);
 
 	// set new string length
 	Resize(length);
@@ -1475,7 +1450,7 @@ void String::Resize(uint32 length, char fillChar, bool doFill)
 	// make the string smaller
 	if (length < mLength)
 	{
-		mData[length] = 0;
+		GetData()[length] = 0;
 		mLength = length;
 		return;
 	}
@@ -1484,29 +1459,25 @@ void String::Resize(uint32 length, char fillChar, bool doFill)
 	const uint32 oldLength = mLength;
 	Alloc(length, 0);
 	if (doFill == true)
+	{
+		char* data = GetData();
 		for (uint32 i=oldLength; i<length; ++i)
-			mData[i] = fillChar;
+			data[i] = fillChar;
+	}
 }
 
 
 // pre-alloc space
 void String::Reserve(uint32 length)
 {
-	if (length == 0)
+	if (length <= mMaxLength)
 		return;
 
-	if ((length > mMaxLength) || mData==NULL)
-	{
-		mMaxLength	= length;
-
-		if (mData != NULL)
-			mData	= (char*)Core::Realloc(mData, (mMaxLength+1)*sizeof(char) );
-		else
-		{
-			mData	= (char*)Core::Allocate( (mMaxLength+1)*sizeof(char) );
-			mData[0] = 0;
-		}
-	}
+	// grow the buffer but keep the length
+	const uint32 oldLength = mLength;
+	Alloc(length, 0);
+	mLength = oldLength;
+	GetData()[oldLength] = 0;
 }
 
 
@@ -1531,7 +1502,7 @@ String String::Lowered() const
 // uppercase this string
 String& String::ToUpper()
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return *this;
 
 	StringIterator iterator(*this);
@@ -1539,7 +1510,7 @@ String& String::ToUpper()
 	{
 		StringCharacter c = iterator.GetNextCharacter();
 		if (c.CalcNumRequiredUTF8Bytes() == 1)
-			mData[c.GetIndex()] = toupper( mData[c.GetIndex()] );
+			GetData()[c.GetIndex()] = toupper( GetData()[c.GetIndex()] );
 	}
 
 	return *this;
@@ -1549,7 +1520,7 @@ String& String::ToUpper()
 // lowercase this string
 String& String::ToLower()
 {
-	if (mData == NULL || mLength == 0)
+	if (mLength == 0)
 		return *this;
 
 	StringIterator iterator(*this);
@@ -1557,7 +1528,7 @@ String& String::ToLower()
 	{
 		StringCharacter c = iterator.GetNextCharacter();
 		if (c.CalcNumRequiredUTF8Bytes() == 1)
-			mData[c.GetIndex()] = tolower( mData[c.GetIndex()] );
+			GetData()[c.GetIndex()] = tolower( GetData()[c.GetIndex()] );
 	}
 
 	return *this;
@@ -1568,7 +1539,7 @@ String& String::ToLower()
 String& String::Align(uint32 newNumCharacters, const StringCharacter& character)
 {
 	StringIterator iterator(*this);
-	const uint32 numCharacters = iterator.CalcNumCharacters( mData, mLength );
+	const uint32 numCharacters = iterator.CalcNumCharacters( GetData(), mLength );
 
 	// if the string is already long enough, there is nothing to do
 	if (numCharacters >= newNumCharacters)
@@ -1587,7 +1558,7 @@ String& String::Align(uint32 newNumCharacters, const StringCharacter& character)
 	uint32 offset = oldLength;
 	for (uint32 i=0; i<numExtraCharacters; ++i)
 	{
-		character.AsUTF8( &mData[offset], &numCharBytes, false );
+		character.AsUTF8( &GetData()[offset], &numCharBytes, false );
 		offset += numCharBytes;
 	}
 
@@ -52,17 +52,17 @@ class ENGINE_API String
 
 
 		String(const char* sA, uint32 lengthA, const char* sB, uint32 lengthB);
-		explicit String(int32 value)												: mData(NULL), mLength(0), mMaxLength(0)	{ FromInt(value); }
-		explicit String(uint32 value)												: mData(NULL), mLength(0), mMaxLength(0)	{ FromInt(value); }
-		explicit String(float value)												: mData(NULL), mLength(0), mMaxLength(0)	{ FromFloat(value); }
-		explicit String(double value)												: mData(NULL), mLength(0), mMaxLength(0)	{ FromDouble(value); }
+		explicit String(int32 value)												: mLength(0), mMaxLength(INLINE_LENGTH)	{ mInlineData[0] = '\0'; FromInt(value); }
+		explicit String(uint32 value)												: mLength(0), mMaxLength(INLINE_LENGTH)	{ mInlineData[0] = '\0'; FromInt(value); }
+		explicit String(float value)												: mLength(0), mMaxLength(INLINE_LENGTH)	{ mInlineData[0] = '\0'; FromFloat(value); }
+		explicit String(double value)												: mLength(0), mMaxLength(INLINE_LENGTH)	{ mInlineData[0] = '\0'; FromDouble(value); }
 		
 
-		inline char* AsChar() const												{ return (mData!=NULL) ? mData : (char*)""; }
+		inline char* AsChar() const												{ return GetData(); }
 		inline uint32 GetLength() const											{ return mLength; }
 		inline uint32 GetMaxLength() const										{ return mMaxLength; }
 		inline bool IsEmpty() const												{ return (mLength == 0); }
-		inline void Clear(bool keepMemory=true)									{ if (keepMemory) { mLength=0; if (mData) mData[0]='\0'; } else { if (mData) Core::Free(mData); mData=NULL; mLength=0; mMaxLength=0; } }
+		inline void Clear(bool keepMemory=true)									{ if (keepMemory) { mLength=0; GetData()[0]='\0'; } else { FreeData(); } }
 
 		// static version
 		static uint32 CalcLength(const char* text)								{ return (uint32)strlen(text); }
@@ -166,11 +166,11 @@ class ENGINE_API String
 		String& ToLower();
 
 		// Cast to const char*
-		inline operator const char*() const									{ return (mData!=NULL) ? mData : (const char*)""; }
+		inline operator const char*() const									{ return GetData(); }
 
 		// Copy and Move Assignment Operator
 		inline const String&	operator=(const String& other)				{ if (&other == this) return *this; return Copy(other.AsChar(), other.GetLength()); }
-		inline		 String&	operator=(String&& other)					{ if (&other == this) return *this; if (mData) Core::Free(mData); mData = other.mData; mLength = other.mLength; mMaxLength = other.mMaxLength; other.mData = NULL; other.mLength = 0; other.mMaxLength = 0; return *this; }
+		inline		 String&	operator=(String&& other)					{ if (&other == this) return *this; FreeData(); TakeData(other); return *this; }
 
 		// Other Assignment Operator
 		inline const String&	operator=(char c)							{ return Copy(&c, 1); }
@@ -193,18 +193,18 @@ class ENGINE_API String
 		inline const String& operator+=(double val)							{ String str(val); return Concat(str.AsChar(), str.GetLength()); }
 
 		// String Comparison Operators
-		inline bool	operator< (const String&	str)						{ return (SafeCompare(mData, str.AsChar())		<  0); }
-		inline bool	operator< (const char*		str)						{ return (SafeCompare(mData, str)				<  0); }
-		inline bool	operator> (const String&	str)						{ return (SafeCompare(mData, str.AsChar())		>  0); }
-		inline bool	operator> (const char*		str)						{ return (SafeCompare(mData, str)				>  0); }
-		inline bool	operator<=(const String&	str)						{ return (SafeCompare(mData, str.AsChar())		<= 0); }
-		inline bool	operator<=(const char*		str)						{ return (SafeCompare(mData, str)				<= 0); }
-		inline bool	operator>=(const String&	str)						{ return (SafeCompare(mData, str.AsChar())		>= 0); }
-		inline bool	operator>=(const char*		str)						{ return (SafeCompare(mData, str)				>= 0); }
-		inline bool	operator==(const String&	str)						{ return (SafeCompare(mData, str.AsChar())		== 0); }
-		inline bool	operator==(const char*		str)						{ return (SafeCompare(mData, str)				== 0); }
-		inline bool	operator!=(const String&	str)						{ return (SafeCompare(mData, str.AsChar())		!= 0); }
-		inline bool	operator!=(const char*		str)						{ return (SafeCompare(mData, str)				!= 0); }
+		inline bool	operator< (const String&	str)						{ return (SafeCompare(GetData(), str.AsChar())		<  0); }
+		inline bool	operator< (const char*		str)						{ return (SafeCompare(GetData(), str)				<  0); }
+		inline bool	operator> (const String&	str)						{ return (SafeCompare(GetData(), str.AsChar())		>  0); }
+		inline bool	operator> (const char*		str)						{ return (SafeCompare(GetData(), str)				>  0); }
+		inline bool	operator<=(const String&	str)						{ return (SafeCompare(GetData(), str.AsChar())		<= 0); }
+		inline bool	operator<=(const char*		str)						{ return (SafeCompare(GetData(), str)				<= 0); }
+		inline bool	operator>=(const String&	str)						{ return (SafeCompare(GetData(), str.AsChar())		>= 0); }
+		inline bool	operator>=(const char*		str)						{ return (SafeCompare(GetData(), str)				>= 0); }
+		inline bool	operator==(const String&	str)						{ return (SafeCompare(GetData(), str.AsChar())		== 0); }
+		inline bool	operator==(const char*		str)						{ return (SafeCompare(GetData(), str)				== 0); }
+		inline bool	operator!=(const String&	str)						{ return (SafeCompare(GetData(), str.AsChar())		!= 0); }
+		inline bool	operator!=(const char*		str)						{ return (SafeCompare(GetData(), str)				!= 0); }
 
 		inline static int32 SafeCompare(const char* strA, const char* strB)
 		{
@@ -236,9 +236,22 @@ class ENGINE_API String
 
 
 	private:
-		char*		mData;
+		// short strings are stored inside the object (no heap allocation), the union keeps the object relocatable (Array moves its items with memmove)
+		enum { INLINE_LENGTH = 23 };
+
+		union
+		{
+			char*	mHeapData;
+			char	mInlineData[INLINE_LENGTH+1];
+		};
 		uint32		mLength;		// num code units
-		uint32		mMaxLength;
+		uint32		mMaxLength;		// capacity in code units, the data is stored inline up to INLINE_LENGTH
+
+		inline bool IsInline() const											{ return (mMaxLength <= INLINE_LENGTH); }
+		inline char* GetData() const											{ return IsInline() ? (char*)mInlineData : mHeapData; }
+		inline void InitInline()												{ mInlineData[0] = '\0'; mLength = 0; mMaxLength = INLINE_LENGTH; }
+		inline void FreeData()													{ if (IsInline() == false) Core::Free(mHeapData); InitInline(); }
+		inline void TakeData(String& other)										{ Core::MemCopy(mInlineData, other.mInlineData, sizeof(mInlineData)); mLength = other.mLength; mMaxLength = other.mMaxLength; other.InitInline(); }
 
 		String& Concat(const char* what, uint32 length);			// append two strings
 		void Alloc(uint32 numCodeUnits, uint32 extraUnits=0);
@@ -69,9 +69,8 @@ bool Test::Run()
 			}			
 			catch (...)	// catches all exceptions
 			{
-				testPassed = test->Run();
+				testPassed = false;
 				exception = true;
-
 			}	
 
 			// evaluate result
@@ -82,7 +81,7 @@ bool Test::Run()
 			}
 			else
 			{
-				std::cout << " <<<<< FAILED >>>>>" << ( exception ? "(exception)" : "" ) << std::endl;
+				std::cout << " <<<<< FAILED >>>>>" << ( exception ? "(exception) " : " " ) << test->GetErrorDescription() << std::endl;
 				mNumTestCasesFailed++;
 					
 				passed = false;
@@ -51,13 +51,12 @@ class Test
 		uint32 GetNumTestCasesFailed() const		{ return mNumTestCasesFailed; }
 
 	protected:
-		// use this from Setup() to add all testcases
-		void AddTest(const TestCase&);
+		// use this from Setup() to add all testcases (takes ownership)
+		void AddTest(TestCase* testCase)			{ mTestCases.Add(testCase); }
 		
 	private:
 		const char* mTestName;
 		
-		void RunTest(const TestCase&);
 		void Reset()
 		{
 			mNumTestCasesPassed = 0;
@@ -99,6 +98,6 @@ class Test
 };
 
 // use this to implement unit tests that can be expressed in a single statement
-#define AssertTest (STATEMENT)	{ AddTest( new AssertTestCase(STATEMENT, "(STATEMENT) is not true") ); }
+#define AssertTest(STATEMENT)	{ AddTest( new AssertTestCase((STATEMENT), #STATEMENT) ); }
 
 #endif
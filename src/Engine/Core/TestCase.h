@@ -65,7 +65,7 @@ class AssertTestCase : public TestCase
 
 
 // the main assert function - use this to check statements inside Test implementations
-#define Assert (STATEMENT)	{  new AssertTestCase(STATEMENT, "(STATEMENT) is not true") ); }
+#define Assert(STATEMENT)	AssertTest(STATEMENT)
 
 
 #endif
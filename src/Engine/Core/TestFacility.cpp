@@ -91,11 +91,14 @@ bool TestFacility::Run(int argc, char** args)
 	{
 		std::cout << "======================================== ALL TESTS PASSED ========================================" << std::endl;
 	}
+	else
 	{
 		std::cout << "======================================== " << numTestsFailed  << " TEST" << (numTestsFailed == 1 ? "" : "S") << " FAILED ========================================" << std::endl;
 		
-		// TODO log fail summary here
-		std::cout << "Summary:" << std::endl << "  TODO " << std::endl;
+		std::cout << "Summary:" << std::endl;
+		for (uint32 i=0; i<numTests; i++)
+			if (mTests[i]->GetNumTestCasesFailed() > 0)
+				std::cout << "  " << mTests[i]->GetName() << ": " << mTests[i]->GetNumTestCasesFailed() << " of " << mTests[i]->GetNumTestCases() << " test cases failed" << std::endl;
 	}
 
 	return passed;
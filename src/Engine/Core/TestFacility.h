@@ -47,11 +47,13 @@ class TestFacility
 		//uint32 GetNumTestsPassed();
 		//uint32 GetNumTestsFailed();
 
+	protected:
+		// add all tests from the constructor of the derived facility (takes ownership)
+		void AddTest(Test* test)		{ mTests.Add(test); }
+
 	private:
 		const char* mFacilityName;
 
-		void AddTest(Test* test)		{ mTests.Add(test); }
-
 		uint32 GetNumTests() const		{ return mTests.Size(); }
 
 		Core::Array<Test*>  mTests;
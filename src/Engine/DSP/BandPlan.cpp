@@ -0,0 +1,206 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required files
+#include "BandPlan.h"
+#include "Spectrum.h"
+#include "../Core/Math.h"
+
+
+using namespace Core;
+
+// constructor
+BandPlan::BandPlan()
+{
+	mNumBins		= 0;
+	mMaxFrequency	= 0.0;
+	mFirstBin		= 0;
+	mLastBin		= 0;
+	mIsValid		= false;
+}
+
+
+// destructor
+BandPlan::~BandPlan()
+{
+}
+
+
+// remove all bands
+void BandPlan::Clear()
+{
+	mBands.Clear();
+	mIsValid = false;
+}
+
+
+// resize the band list (new bands are empty)
+void BandPlan::SetNumBands(uint32 numBands)
+{
+	const uint32 oldNumBands = mBands.Size();
+	if (oldNumBands == numBands)
+		return;
+
+	mBands.Resize(numBands);
+	for (uint32 i=oldNumBands; i<numBands; ++i)
+	{
+		mBands[i].mMinFrequency	= 0.0;
+		mBands[i].mMaxFrequency	= 0.0;
+		mBands[i].mFirstBin		= 0;
+		mBands[i].mNumBins		= 0;
+	}
+
+	mIsValid = false;
+}
+
+
+// add a band and return its index
+uint32 BandPlan::AddBand(double minFrequency, double maxFrequency)
+{
+	const uint32 index = mBands.Size();
+	SetNumBands(index + 1);
+	SetBand(index, minFrequency, maxFrequency);
+	return index;
+}
+
+
+// change the range of a band
+void BandPlan::SetBand(uint32 index, double minFrequency, double maxFrequency)
+{
+	Band& band = mBands[index];
+	if (band.mMinFrequency == minFrequency && band.mMaxFrequency == maxFrequency)
+		return;
+
+	band.mMinFrequency = minFrequency;
+	band.mMaxFrequency = maxFrequency;
+	mIsValid = false;
+}
+
+
+// resolve the bin ranges of all bands
+void BandPlan::Prepare(const Spectrum* spectrum)
+{
+	const uint32 numBins = spectrum->GetNumBins();
+	const double maxFrequency = spectrum->GetMaxFrequency();
+
+	if (mIsValid == true && mNumBins == numBins && mMaxFrequency == maxFrequency)
+		return;
+
+	mNumBins		= numBins;
+	mMaxFrequency	= maxFrequency;
+	mFirstBin		= CORE_INVALIDINDEX32;
+	mLastBin		= 0;
+
+	// bin frequencies are monotonic, so every band covers a contiguous bin range; use the exact same inclusion test as FrequencyBand
+	const uint32 numBands = mBands.Size();
+	for (uint32 b=0; b<numBands; ++b)
+	{
+		Band& band = mBands[b];
+		band.mFirstBin	= 0;
+		band.mNumBins	= 0;
+
+		for (uint32 i=0; i<numBins; ++i)
+		{
+			const double frequency = spectrum->CalcFrequency(i);
+			if (frequency > band.mMaxFrequency || frequency < band.mMinFrequency)
+				continue;
+
+			if (band.mNumBins == 0)
+				band.mFirstBin = i;
+			band.mNumBins++;
+		}
+
+		if (band.mNumBins == 0)
+			continue;
+
+		mFirstBin	= Min(mFirstBin, band.mFirstBin);
+		mLastBin	= Max(mLastBin, band.mFirstBin + band.mNumBins - 1);
+	}
+
+	// no band covers any bin
+	if (mFirstBin == CORE_INVALIDINDEX32)
+	{
+		mFirstBin	= 0;
+		mLastBin	= 0;
+		mBinValues.Clear();
+	}
+	else
+	{
+		mBinValues.Resize(mLastBin - mFirstBin + 1);
+	}
+
+	mIsValid = true;
+}
+
+
+// calculate all bands of one spectrum
+void BandPlan::Calc(const Spectrum* spectrum, EValueType valueType, double* outValues)
+{
+	Prepare(spectrum);
+
+	const uint32 numBands = mBands.Size();
+	const uint32 numValues = mBinValues.Size();
+	if (numValues == 0)
+	{
+		for (uint32 b=0; b<numBands; ++b)
+			outValues[b] = 0.0;
+		return;
+	}
+
+	// evaluate each covered bin only once
+	const Complex* bins = spectrum->GetBins() + mFirstBin;
+	double* values = mBinValues.GetPtr();
+	switch (valueType)
+	{
+		case VALUE_MAGNITUDE:	for (uint32 i=0; i<numValues; ++i) values[i] = bins[i].Norm();			break;
+		case VALUE_POWER:		for (uint32 i=0; i<numValues; ++i) values[i] = bins[i].SquaredNorm();	break;
+		case VALUE_PHASE:		for (uint32 i=0; i<numValues; ++i) values[i] = bins[i].Arg();			break;
+	}
+
+	// average the bin values of each band
+	for (uint32 b=0; b<numBands; ++b)
+	{
+		const Band& band = mBands[b];
+		if (band.mNumBins == 0)
+		{
+			outValues[b] = 0.0;
+			continue;
+		}
+
+		const double* bandValues = values + (band.mFirstBin - mFirstBin);
+		double sum = 0.0;
+		for (uint32 i=0; i<band.mNumBins; ++i)
+			sum += bandValues[i];
+
+		outValues[b] = sum / (double)band.mNumBins;
+	}
+}
+
+
+// calculate all bands of several spectra
+void BandPlan::Calc(const Spectrum* const* spectra, uint32 numSpectra, EValueType valueType, double* outValues)
+{
+	const uint32 numBands = mBands.Size();
+	for (uint32 s=0; s<numSpectra; ++s)
+		Calc(spectra[s], valueType, outValues + s * numBands);
+}
@@ -0,0 +1,90 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_BANDPLAN_H
+#define __NEUROMORE_BANDPLAN_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+
+
+// forward declaration
+class Spectrum;
+
+// precompiled set of frequency bands that are extracted from a spectrum together
+// the bin range of each band is resolved once per spectrum layout (number of bins, max frequency) instead of testing the frequency of every bin for every band;
+// a bin belongs to a band if its center frequency lies inside [min, max], the band value is the unweighted average over those bins (identical to FrequencyBand::CalcMagnitude() etc.)
+class ENGINE_API BandPlan
+{
+	public:
+		enum EValueType
+		{
+			VALUE_MAGNITUDE = 0,
+			VALUE_POWER,
+			VALUE_PHASE
+		};
+
+		// constructor & destructor
+		BandPlan();
+		~BandPlan();
+
+		// band configuration (changing the bands invalidates the bin ranges)
+		void Clear();
+		void SetNumBands(uint32 numBands);
+		uint32 AddBand(double minFrequency, double maxFrequency);
+		void SetBand(uint32 index, double minFrequency, double maxFrequency);
+		inline uint32 GetNumBands() const									{ return mBands.Size(); }
+		inline double GetMinFrequency(uint32 index) const					{ return mBands[index].mMinFrequency; }
+		inline double GetMaxFrequency(uint32 index) const					{ return mBands[index].mMaxFrequency; }
+
+		// resolve the bin ranges for the given spectrum layout (does nothing if the layout did not change)
+		void Prepare(const Spectrum* spectrum);
+
+		// calculate the values of all bands in one pass over the bins; outValues must hold GetNumBands() values
+		void Calc(const Spectrum* spectrum, EValueType valueType, double* outValues);
+
+		// calculate the values of all bands for several spectra (e.g. one per channel) that share the same layout; outValues is laid out as [spectrum][band]
+		void Calc(const Spectrum* const* spectra, uint32 numSpectra, EValueType valueType, double* outValues);
+
+	private:
+		struct Band
+		{
+			double	mMinFrequency;
+			double	mMaxFrequency;
+			uint32	mFirstBin;
+			uint32	mNumBins;
+		};
+
+		Core::Array<Band>	mBands;
+		Core::Array<double>	mBinValues;			// scratch: per-bin values of the covered bin range
+		uint32				mNumBins;			// spectrum layout the bin ranges were resolved for
+		double				mMaxFrequency;
+		uint32				mFirstBin;			// union of all band bin ranges
+		uint32				mLastBin;
+		bool				mIsValid;
+};
+
+
+#endif
@@ -32,6 +32,9 @@ using namespace Core;
 template<class T>
 Channel<T>::Channel(double sampleRate, uint32 bufferSize) : ChannelBase(bufferSize)
 {
+	mColdChunks = NULL;
+	mFirstHotChunk = 1;
+
 	SetSampleRate (sampleRate);
 
 	// initialize sample buffer
@@ -75,6 +78,7 @@ Channel<T>::Channel(double sampleRate, uint32 bufferSize) : ChannelBase(bufferSi
 template<class T>
 Channel<T>::~Channel()
 {
+	delete mColdChunks;
 }
 
 
@@ -83,6 +87,7 @@ template<class T>
 void Channel<T>::SetBufferSize(uint32 numSamples)
 {
 	LogTrace("SetBufferSize");
+	MemoryTagScope memoryTag(MEMORYTAG_DSP);
 
 	// resize only if the channel is configured as a buffer - and only shrink it, if samples do not get lost
 	// storage channel: initialize first chunk (size = 1 minute and no less than 100)
@@ -99,6 +104,12 @@ void Channel<T>::SetBufferSize(uint32 numSamples)
 			LogDebug("resizing sample array from %i to %i", mSamples[0].Size(), numSamples);
 			mSamples[0].Resize(numSamples);
 		}
+		// release the memory of shrunk buffers (the channel is cleared anyway)
+		else if (numSamples < mSamples[0].Size())
+		{
+			mSamples[0].Resize(numSamples);
+			mSamples[0].Shrink();
+		}
 	}
 
 	mBufferSize = numSamples;
@@ -140,6 +151,7 @@ template<class T>
 void Channel<T>::Clear(bool deallocate)
 {
 	LogTrace("Clear");
+	MemoryTagScope memoryTag(MEMORYTAG_DSP);
 
 	// dealloc samples only if channel is not a buffer
 	if (IsBuffer() == false)
@@ -151,6 +163,11 @@ void Channel<T>::Clear(bool deallocate)
 		mSamples[0].Resize(chunkSize);
 	}
 
+	// drop the cold chunks
+	delete mColdChunks;
+	mColdChunks = NULL;
+	mFirstHotChunk = 1;
+
 	mNumSamples	= 0;
 	mNumNewSamples = 0;
 	mSampleCounter = 0;
@@ -158,6 +175,103 @@ void Channel<T>::Clear(bool deallocate)
 }
 
 
+// add multiple samples at once; same semantics as calling AddSample() for each value, but copies contiguous runs
+template<class T>
+void Channel<T>::AddSamples(const T* values, uint32 numSamples)
+{
+	LogTraceRT("AddSamples");
+
+	while (numSamples > 0)
+	{
+		T* destination = NULL;
+		uint32 runLength = 0;
+
+		if (IsBuffer() == true)
+		{
+			// run ends at the wrap-around of the circular buffer
+			const uint32 arrIndex = mSampleCounter % mBufferSize;
+			runLength = Min<uint32>(numSamples, mBufferSize - arrIndex);
+			destination = mSamples[0].GetPtr() + arrIndex;
+		}
+		else
+		{
+			// grow storage channel by adding chunks
+			const uint32 chunkSize = mSamples[0].Size();
+			const uint64 currentMaxNumSamples = chunkSize * mSamples.Size();
+			if (currentMaxNumSamples == mSampleCounter)
+			{
+				MemoryTagScope memoryTag(MEMORYTAG_DSP);
+				mSamples.AddEmpty();
+				mSamples.GetLast().Resize(chunkSize);
+				LogDebug("added chunk %i (size = %i)", mSamples.Size(), chunkSize);
+
+				CoolChunks();
+			}
+
+			// run ends at the end of the chunk
+			const uint64 chunkIndex = mSampleCounter / chunkSize;
+			const uint32 arrIndex = mSampleCounter % chunkSize;
+			runLength = Min<uint32>(numSamples, chunkSize - arrIndex);
+			destination = mSamples[chunkIndex].GetPtr() + arrIndex;
+		}
+
+		for (uint32 i=0; i<runLength; ++i)
+			destination[i] = values[i];
+
+		mNumNewSamples += runLength;
+		mSampleCounter += runLength;
+
+		// number of available samples stops increasing when buffer is full
+		if (IsBuffer() == false)
+			mNumSamples += runLength;
+		else
+			mNumSamples = Min<uint32>(mNumSamples + runLength, mBufferSize);
+
+		values += runLength;
+		numSamples -= runLength;
+	}
+
+	// mark channel as active
+	SetAsActive();
+}
+
+
+// copy numSamples samples, beginning with the sample at startIndex, into a contiguous array
+template<class T>
+void Channel<T>::CopySamples(uint64 startIndex, uint32 numSamples, T* outValues) const
+{
+	CORE_ASSERT(numSamples == 0 || startIndex + numSamples <= mSampleCounter);
+
+	while (numSamples > 0)
+	{
+		const T* source = NULL;
+		uint32 runLength = 0;
+
+		if (IsBuffer() == true)
+		{
+			const uint32 arrIndex = startIndex % mBufferSize;
+			runLength = Min<uint32>(numSamples, mBufferSize - arrIndex);
+			source = mSamples[0].GetReadPtr() + arrIndex;
+		}
+		else
+		{
+			const uint32 chunkSize = mSamples[0].Size();
+			const uint64 chunkIndex = startIndex / chunkSize;
+			const uint32 arrIndex = startIndex % chunkSize;
+			runLength = Min<uint32>(numSamples, chunkSize - arrIndex);
+			source = (IsColdChunk(chunkIndex) == true ? GetColdChunk(chunkIndex) : mSamples[chunkIndex].GetReadPtr()) + arrIndex;
+		}
+
+		for (uint32 i=0; i<runLength; ++i)
+			outValues[i] = source[i];
+
+		outValues += runLength;
+		startIndex += runLength;
+		numSamples -= runLength;
+	}
+}
+
+
 // TODO optimize this method (get rid of checks and increse the buffer size elsewhere)
 // the central code for adding samples: get a reference to a sample (dont forget do write to it! :P )
 template<class T>
@@ -172,9 +286,12 @@ T* Channel<T>::GetNextSampleRef()
 		if (currentMaxNumSamples == mSampleCounter)
 		{
 			// add another chunk
+			MemoryTagScope memoryTag(MEMORYTAG_DSP);
 			mSamples.AddEmpty();
 			mSamples.GetLast().Resize(chunkSize);
 			LogDebug("added chunk %i (size = %i)", mSamples.Size(), chunkSize);
+
+			CoolChunks();
 		}
 	}
 
@@ -228,11 +345,69 @@ const T& Channel<T>::GetSample(uint64 index) const
 
 		//LogDebugRT("accessing storage sample %i (chunk %i, index %i)", index, chunkIndex, sampleIndex);
 
+		if (IsColdChunk(chunkIndex) == true)
+			return GetColdChunk(chunkIndex)[sampleIndex];
+
 		return mSamples[chunkIndex][sampleIndex];
 	}
 }
 
 
+// move the chunks that fell out of the hot duration into the chunk store (only doubles can be compressed)
+template<>
+void Channel<double>::CoolChunks()
+{
+	const uint64 numHotSamples = CalcNumHotSamples();
+	if (numHotSamples == 0)
+		return;
+
+	// keep at least the chunk that is being filled and its predecessor
+	const uint32 chunkSize = mSamples[0].Size();
+	const uint32 numHotChunks = Max<uint32>(2, (numHotSamples + chunkSize - 1) / chunkSize);
+	const uint32 numChunks = mSamples.Size();
+	if (numChunks - mFirstHotChunk <= numHotChunks)
+		return;
+
+	// the storage mode is chosen when the first chunk cools down and stays until the channel gets cleared
+	if (mColdChunks == NULL)
+		mColdChunks = CreateChunkStore();
+
+	while (numChunks - mFirstHotChunk > numHotChunks)
+	{
+		Array<double>& chunk = mSamples[mFirstHotChunk];
+		mColdChunks->Add(chunk.GetReadPtr(), chunk.Size());
+		chunk.Clear();
+
+		LogDebug("cooled chunk %i (%i encoded bytes)", mFirstHotChunk, (uint32)mColdChunks->GetNumEncodedBytes());
+		mFirstHotChunk++;
+	}
+}
+
+
+template<>
+void Channel<Spectrum>::CoolChunks()
+{
+	// spectrum channels stay in memory
+}
+
+
+// decoded samples of a cold chunk
+template<>
+const double* Channel<double>::GetColdChunk(uint64 chunkIndex) const
+{
+	return mColdChunks->GetChunk((uint32)chunkIndex - 1);
+}
+
+
+template<>
+const Spectrum* Channel<Spectrum>::GetColdChunk(uint64 chunkIndex) const
+{
+	// NOT IMPLEMENTED (spectrum channels never cool down)
+	CORE_ASSERT(false);
+	return mSamples[0].GetReadPtr();
+}
+
+
 // access samples by const ref
 template<class T>
 T* Channel<T>::GetSampleRef(uint64 index)
@@ -400,6 +575,9 @@ uint64 Channel<double>::CalculateMemoryAllocated(bool countBuffersOnly) const
 	for (uint32 i=0; i<mSamples.Size(); ++i)
 		numBytes += mSamples[i].Size() * sizeof(double);
 
+	if (mColdChunks != NULL)
+		numBytes += mColdChunks->CalculateMemoryAllocated();
+
 	return numBytes;
 }
 
@@ -31,6 +31,7 @@
 #include "../Core/Color.h"
 #include "Spectrum.h"
 #include "ChannelBase.h"
+#include "ChunkStore.h"
 
 
 // the Channel class
@@ -49,6 +50,10 @@ class Channel : public ChannelBase
 		Channel(double sampleRate = 0, uint32 bufferSize = 0);
 		//Channel(double sampleRate = 0, const Core::String& name = "", double minValue = 0, double maxValue = 0, Core::String unitString = "", const Core::Color& color = Core::Color(0, 159.0f/255.0f, 227.0f/255.0f));
 		virtual ~Channel();
+
+		// channels own their cold chunks and are never copied
+		Channel(const Channel&) = delete;
+		Channel& operator=(const Channel&) = delete;
 		
 		// type information
 		static ENGINE_API const uint32 TYPE_ID;
@@ -63,11 +68,16 @@ class Channel : public ChannelBase
 		// use these for adding samples (both increase the sample counter)
 		void AddSample(const T& value);
 		T* GetNextSampleRef();
+
+		// bulk versions of AddSample() and GetSample(): copy whole runs of the circular buffer / storage chunks at once
+		void AddSamples(const T* values, uint32 numSamples);
+		void CopySamples(uint64 startIndex, uint32 numSamples, T* outValues) const;
 	
 		// clear channel
 		virtual void Clear(bool deallocate = false) override;
 
 		// get sampless and sample time (pointer or const ref, we need both)
+		// NOTE samples of cold chunks are decoded on access: they are read only and the reference stays valid only for a few more cold accesses
 		T* GetSampleRef(uint64 index);
 		T* GetLastSampleRef();
 		const T& GetSample(uint64 index) const;
@@ -79,6 +89,11 @@ class Channel : public ChannelBase
 		Core::Array<T>& GetRawArray()									{ return mSamples[0]; }
 		void ForceUpdateSampleCounters()								{ mSampleCounter = mSamples[0].Size(); mNumSamples = mSamples.Size(); mTimeSinceLastAddSample = 0;}
 
+		// tiered storage: storage channels of doubles compress the chunks older than the hot duration (see EngineManager::ChannelStorageSettings)
+		// the first chunk defines the chunk size and always stays in memory
+		bool IsColdChunk(uint64 chunkIndex) const						{ return (chunkIndex != 0 && chunkIndex < mFirstHotChunk); }
+		const ChunkStore* GetColdChunks() const							{ return mColdChunks; }
+
 		// helpers
 		void CalculateAverage(T* outAverage, uint64 minSampleIndex = 0, uint64 maxSampleIndex = CORE_UINT64_MAX);
 		void CalculateMaximum(T* outMaximum, uint64 minSampleIndex = 0, uint64 maxSampleIndex = CORE_UINT64_MAX);
@@ -93,8 +108,16 @@ class Channel : public ChannelBase
 		uint64 CalculateMemoryUsed(bool countBuffersOnly = false) const override;
 
 	protected:
+		// move the chunks that fell out of the hot duration into the chunk store
+		void CoolChunks();
+		const T* GetColdChunk(uint64 chunkIndex) const;
+
 		// the sample storage arrays
 		Core::Array<Core::Array<T>>  mSamples;	 
+
+		// compressed chunks 1 .. mFirstHotChunk-1 of a storage channel (their arrays in mSamples are empty)
+		ChunkStore*		mColdChunks;
+		uint32			mFirstHotChunk;
 };
 
 
@@ -23,6 +23,7 @@
 
 // include required files
 #include "ChannelBase.h"
+#include "ChunkStore.h"
 #include "../EngineManager.h"
 #include "../Core/Counter.h"
 #include "../Core/Time.h"
@@ -59,6 +60,9 @@ ChannelBase::ChannelBase(uint32 bufferSize)
 // destructor
 ChannelBase::~ChannelBase()
 {
+	// detach the snapshots of this channel
+	if (GetEngine() != NULL && GetEngine()->GetChannelSnapshotManager() != NULL)
+		GetEngine()->GetChannelSnapshotManager()->OnChannelDestroyed(this);
 }
 
 void ChannelBase::Reset()
@@ -271,3 +275,30 @@ uint32 ChannelBase::FindIndexByTime(double time, bool roundToClosest, bool clamp
 
 	return index;
 }
+
+
+// number of recent samples of a storage channel that stay uncompressed
+uint64 ChannelBase::CalcNumHotSamples() const
+{
+	EngineManager* engine = GetEngine();
+	if (engine == NULL)
+		return 0;
+
+	const EngineManager::ChannelStorageSettings& settings = engine->GetChannelStorageSettings();
+	if (settings.mMode == EngineManager::CHANNELSTORAGE_MEMORY)
+		return 0;
+
+	return (uint64)Math::CeilD(settings.mHotDuration * mSampleRate);
+}
+
+
+// create the store for the compressed chunks of a storage channel
+ChunkStore* ChannelBase::CreateChunkStore() const
+{
+	MemoryTagScope memoryTag(MEMORYTAG_DSP);
+
+	const EngineManager::ChannelStorageSettings& settings = GetEngine()->GetChannelStorageSettings();
+	const ChunkStore::EMode mode = (settings.mMode == EngineManager::CHANNELSTORAGE_DISK ? ChunkStore::MODE_DISK : ChunkStore::MODE_MEMORY);
+
+	return new ChunkStore(mode, settings.mSpillFolder.AsChar());
+}
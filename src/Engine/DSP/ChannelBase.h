@@ -34,6 +34,7 @@
 
 template <class T>
 class Channel;
+class ChunkStore;
 
 // channel base class used for all template instances
 class ENGINE_API ChannelBase
@@ -152,6 +153,10 @@ class ENGINE_API ChannelBase
 		bool IsHighlighted() const												{ return mIsHighlighted; }
 
 	protected:
+		// tiered storage as configured in the engine: number of recent samples that stay uncompressed (0 = all samples stay in memory) and the store for the others
+		uint64 CalcNumHotSamples() const;
+		ChunkStore* CreateChunkStore() const;
+
 		double		mSampleRate;						// if > 0 we assume the channel's samples have fixed sample rate
 		Core::Time	mStartTime;							// time of the first sample
 		Core::Time	mElapsedTime;						// elapsed time of the channel (often differs from the time of the last sample! thats the point)
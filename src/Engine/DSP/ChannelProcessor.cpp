@@ -30,8 +30,9 @@
 using namespace Core;
 
 // constructor
-ChannelProcessor::ChannelProcessor()
+ChannelProcessor::ChannelProcessor() : mOwnScratchArena(4096)
 {
+	mScratchArena = NULL;
 }
 
 
@@ -75,6 +76,10 @@ void ChannelProcessor::Update()
 {
 	LogTraceRT("Update");
 
+	// the own scratch arena is reset here (a shared one is reset by its owner)
+	if (mScratchArena == NULL)
+		mOwnScratchArena.Reset();
+
 	// update channel input readers: get the number of new input samples
 	const uint32 numInputs = GetNumInputs();
 	for (uint32 i=0; i<numInputs; ++i)
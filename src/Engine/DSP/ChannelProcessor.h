@@ -29,6 +29,7 @@
 #include "Channel.h"
 #include "ChannelReader.h"
 #include "../Core/Time.h"
+#include "../Core/ScratchArena.h"
 
 class ENGINE_API ChannelProcessor
 {
@@ -64,6 +65,10 @@ class ENGINE_API ChannelProcessor
 		// if the processor is in working condition
 		bool IsInitialized() const																{ return mIsInitialized;  }
 
+		// scratch memory for temporary buffers inside Update() (usually shared by all processors of a classifier and reset every update)
+		void SetScratchArena(Core::ScratchArena* arena)											{ mScratchArena = arena; }
+		Core::ScratchArena& GetScratchArena()													{ return (mScratchArena != NULL ? *mScratchArena : mOwnScratchArena); }
+
 		//
 		// Inputs	
 		//
@@ -122,6 +127,10 @@ class ENGINE_API ChannelProcessor
 		
 		// Outputs
 		Core::Array<ChannelBase*>	mOutputs;
+
+		// scratch memory
+		Core::ScratchArena*			mScratchArena;
+		Core::ScratchArena			mOwnScratchArena;		// used if no shared arena was set
 		
 };
 
@@ -334,6 +334,28 @@ const T& ChannelReader::GetNewestSample()
 }
 
 
+// copy the oldest numSamples new samples into the given array without popping them
+template<class T>
+void ChannelReader::CopyOldestSamples(T* outSamples, uint32 numSamples)
+{
+	CORE_ASSERT(numSamples <= mNumNewSamples);
+	if (numSamples == 0)
+		return;
+
+	const uint64 startIndex = mChannel->GetSampleCounter() - mNumNewSamples;
+	mChannel->AsType<T>()->CopySamples(startIndex, numSamples, outSamples);
+}
+
+
+// pop operation on the oldest numSamples new samples
+template<class T>
+void ChannelReader::PopOldestSamples(T* outSamples, uint32 numSamples)
+{
+	CopyOldestSamples<T>(outSamples, numSamples);
+	Advance(numSamples);
+}
+
+
 // marks the oldest numSamples samples as processed
 void ChannelReader::Advance(uint32 numSamples)
 {
@@ -509,6 +531,12 @@ template const Spectrum& ChannelReader::GetSample<Spectrum>(uint32 index);
 template const double& ChannelReader::PopOldestSample<double>();
 template const Spectrum& ChannelReader::PopOldestSample<Spectrum>();
 
+template void ChannelReader::CopyOldestSamples<double>(double* outSamples, uint32 numSamples);
+template void ChannelReader::CopyOldestSamples<Spectrum>(Spectrum* outSamples, uint32 numSamples);
+
+template void ChannelReader::PopOldestSamples<double>(double* outSamples, uint32 numSamples);
+template void ChannelReader::PopOldestSamples<Spectrum>(Spectrum* outSamples, uint32 numSamples);
+
 template const double& ChannelReader::GetOldestSample<double>();
 template const Spectrum& ChannelReader::GetOldestSample<Spectrum>();
 
@@ -69,6 +69,10 @@ class ENGINE_API ChannelReader
 		template <class T> const T& PopOldestSample();		
 		template <class T> const T& GetNewestSample();			
 
+		// bulk access: copy the oldest numSamples new samples into a contiguous array (pop also marks them as processed)
+		template <class T> void CopyOldestSamples(T* outSamples, uint32 numSamples);
+		template <class T> void PopOldestSamples(T* outSamples, uint32 numSamples);
+
 
 		// returns the index of the sample inside the channel
 		uint64		GetSampleIndex(uint32 index);
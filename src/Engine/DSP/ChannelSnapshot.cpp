@@ -0,0 +1,193 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required files
+#include "ChannelSnapshot.h"
+
+
+using namespace Core;
+
+// constructor
+ChannelSnapshot::Frame::Frame()
+{
+	mNumSamples			= 0;
+	mFirstSampleIndex	= 0;
+	mSampleRate			= 0.0;
+	mStartTime			= 0.0;
+	mElapsedTime		= 0.0;
+	mLatency			= 0.0;
+}
+
+
+// index of the sample at the given time (rounded downwards and clamped to the samples of the frame)
+uint64 ChannelSnapshot::Frame::FindIndexByTime(double time) const
+{
+	if (mNumSamples == 0 || mSampleRate <= 0.0)
+		return mFirstSampleIndex;
+
+	const double floatIndex = (time - mStartTime) * mSampleRate - 1.0;
+	if (floatIndex <= (double)GetMinSampleIndex())
+		return GetMinSampleIndex();
+	if (floatIndex >= (double)GetMaxSampleIndex())
+		return GetMaxSampleIndex();
+
+	return (uint64)floatIndex;
+}
+
+
+// constructor
+ChannelSnapshot::ChannelSnapshot(Channel<double>* channel, uint32 maxNumSamples)
+{
+	mChannel			= channel;
+	mMaxNumSamples		= (maxNumSamples > 0 ? maxNumSamples : 1);
+	mLastSampleCounter	= 0;
+	mNumReferences		= 0;
+	mHasFrame			= false;
+	mPublished			= 0;
+
+	for (uint32 i=0; i<2; ++i)
+	{
+		Buffer& buffer = mBuffers[i];
+		buffer.mSequence			= 0;
+		buffer.mSamples.Resize(mMaxNumSamples);
+		buffer.mNumSamples			= 0;
+		buffer.mFirstSampleIndex	= 0;
+		buffer.mSampleRate			= 0.0;
+		buffer.mStartTime			= 0.0;
+		buffer.mElapsedTime			= 0.0;
+		buffer.mLatency				= 0.0;
+	}
+}
+
+
+// destructor
+ChannelSnapshot::~ChannelSnapshot()
+{
+}
+
+
+void ChannelSnapshot::BeginWrite(Buffer& buffer)
+{
+	const uint32 sequence = buffer.mSequence.load(std::memory_order_relaxed);
+	buffer.mSequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+
+void ChannelSnapshot::EndWrite(Buffer& buffer)
+{
+	const uint32 sequence = buffer.mSequence.load(std::memory_order_relaxed);
+	buffer.mSequence.store(sequence + 1, std::memory_order_release);
+}
+
+
+// publish the current channel state
+void ChannelSnapshot::Capture()
+{
+	if (mChannel == NULL)
+		return;
+
+	const uint64 sampleCounter = mChannel->GetSampleCounter();
+
+	// no new samples: only the timing has to be refreshed, do this in place instead of copying all samples again
+	if (mHasFrame == true && sampleCounter == mLastSampleCounter)
+	{
+		Buffer& buffer = mBuffers[mPublished.load(std::memory_order_relaxed)];
+		BeginWrite(buffer);
+		buffer.mElapsedTime	= mChannel->GetElapsedTime().InSeconds();
+		buffer.mLatency		= mChannel->GetLatency();
+		EndWrite(buffer);
+		return;
+	}
+
+	// fill the buffer that is not published
+	const uint32 index = (mHasFrame == true ? 1 - mPublished.load(std::memory_order_relaxed) : 0);
+	Buffer& buffer = mBuffers[index];
+
+	BeginWrite(buffer);
+
+	const uint64 numChannelSamples = mChannel->GetNumSamples();
+	const uint32 numSamples = (uint32)Min<uint64>(numChannelSamples, mMaxNumSamples);
+	if (numSamples > 0)
+	{
+		buffer.mFirstSampleIndex = mChannel->GetMaxSampleIndex() + 1 - numSamples;
+		mChannel->CopySamples(buffer.mFirstSampleIndex, numSamples, buffer.mSamples.GetPtr());
+	}
+	else
+	{
+		buffer.mFirstSampleIndex = 0;
+	}
+
+	buffer.mNumSamples	= numSamples;
+	buffer.mSampleRate	= mChannel->GetSampleRate();
+	buffer.mStartTime	= mChannel->GetStartTime().InSeconds();
+	buffer.mElapsedTime	= mChannel->GetElapsedTime().InSeconds();
+	buffer.mLatency		= mChannel->GetLatency();
+
+	EndWrite(buffer);
+
+	mPublished.store(index, std::memory_order_release);
+	mHasFrame = true;
+	mLastSampleCounter = sampleCounter;
+}
+
+
+// copy the last published frame
+bool ChannelSnapshot::Read(Frame& outFrame) const
+{
+	outFrame.mNumSamples = 0;
+
+	// the writer publishes far less often than a frame is copied, so in practice this succeeds on the first attempt
+	const uint32 maxNumAttempts = 100;
+	for (uint32 attempt=0; attempt<maxNumAttempts; ++attempt)
+	{
+		const Buffer& buffer = mBuffers[mPublished.load(std::memory_order_acquire)];
+
+		const uint32 sequenceBefore = buffer.mSequence.load(std::memory_order_acquire);
+		if ((sequenceBefore & 1) != 0)
+			continue;
+
+		// nothing published yet
+		if (sequenceBefore == 0)
+			return false;
+
+		const uint32 numSamples = Min<uint32>(buffer.mNumSamples, mMaxNumSamples);
+		outFrame.mSamples.Resize(numSamples);
+		if (numSamples > 0)
+			Core::MemCopy(outFrame.mSamples.GetPtr(), buffer.mSamples.GetReadPtr(), numSamples * sizeof(double));
+
+		outFrame.mNumSamples		= numSamples;
+		outFrame.mFirstSampleIndex	= buffer.mFirstSampleIndex;
+		outFrame.mSampleRate		= buffer.mSampleRate;
+		outFrame.mStartTime			= buffer.mStartTime;
+		outFrame.mElapsedTime		= buffer.mElapsedTime;
+		outFrame.mLatency			= buffer.mLatency;
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (buffer.mSequence.load(std::memory_order_relaxed) == sequenceBefore)
+			return true;
+	}
+
+	outFrame.mNumSamples = 0;
+	return false;
+}
@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_CHANNELSNAPSHOT_H
+#define __NEUROMORE_CHANNELSNAPSHOT_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+#include "Channel.h"
+#include <atomic>
+
+
+// copy of the most recent samples of a channel that can be read from other threads without touching the channel itself
+//  - the engine publishes a new frame with Capture() after each update (see ChannelSnapshotManager)
+//  - Read() copies the last published frame; it never blocks the engine
+//  - two buffers, each protected by a sequence counter (seqlock): the writer always fills the buffer that is not published,
+//    readers only have to retry if the writer wrapped around onto the buffer they are still copying
+class ENGINE_API ChannelSnapshot
+{
+	friend class ChannelSnapshotManager;
+
+	public:
+		// a consistent copy of the channel state, owned by the reader
+		class ENGINE_API Frame
+		{
+			friend class ChannelSnapshot;
+
+			public:
+				Frame();
+
+				bool IsEmpty() const												{ return mNumSamples == 0; }
+				uint32 GetNumSamples() const										{ return mNumSamples; }
+				uint64 GetMinSampleIndex() const									{ return mFirstSampleIndex; }
+				uint64 GetMaxSampleIndex() const									{ return mFirstSampleIndex + mNumSamples - 1; }
+
+				// sample access by channel sample index (must lie within GetMinSampleIndex() and GetMaxSampleIndex())
+				double GetSample(uint64 index) const								{ return mSamples[(uint32)(index - mFirstSampleIndex)]; }
+				double GetLastSample() const										{ return mSamples[mNumSamples - 1]; }
+				const double* GetSamples() const									{ return mSamples.GetReadPtr(); }
+
+				double GetSampleRate() const										{ return mSampleRate; }
+				double GetElapsedTime() const										{ return mElapsedTime; }
+				double GetLatency() const											{ return mLatency; }
+
+				// same as the channel functions
+				double GetSampleTime(uint64 index) const							{ return (mSampleRate > 0.0 ? mStartTime + (index + 1) / mSampleRate : 0.0); }
+				uint64 FindIndexByTime(double time) const;
+
+			private:
+				Core::Array<double>	mSamples;
+				uint32				mNumSamples;
+				uint64				mFirstSampleIndex;
+				double				mSampleRate;
+				double				mStartTime;
+				double				mElapsedTime;
+				double				mLatency;
+		};
+
+		// constructor & destructor
+		ChannelSnapshot(Channel<double>* channel, uint32 maxNumSamples);
+		~ChannelSnapshot();
+
+		// publish the current channel state (writer side, called by the thread that updates the channel)
+		void Capture();
+
+		// copy the last published frame; returns false if nothing was published yet (reader side, any thread)
+		bool Read(Frame& outFrame) const;
+
+		// the channel is reset to NULL when it gets destroyed, the snapshot keeps the last published frame
+		Channel<double>* GetChannel() const											{ return mChannel; }
+		uint32 GetMaxNumSamples() const												{ return mMaxNumSamples; }
+
+	private:
+		struct Buffer
+		{
+			std::atomic<uint32>	mSequence;				// odd while the writer is modifying the buffer
+			Core::Array<double>	mSamples;				// allocated once (mMaxNumSamples), never reallocated
+			uint32				mNumSamples;
+			uint64				mFirstSampleIndex;
+			double				mSampleRate;
+			double				mStartTime;
+			double				mElapsedTime;
+			double				mLatency;
+		};
+
+		void BeginWrite(Buffer& buffer);
+		void EndWrite(Buffer& buffer);
+
+		Buffer					mBuffers[2];
+		std::atomic<uint32>		mPublished;				// index of the buffer holding the most recent frame
+		bool					mHasFrame;
+
+		Channel<double>*		mChannel;
+		uint32					mMaxNumSamples;
+		uint64					mLastSampleCounter;		// sample counter at the last capture
+		uint32					mNumReferences;			// managed by the ChannelSnapshotManager
+};
+
+
+#endif
@@ -0,0 +1,707 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "ChunkStore.h"
+#include "../Core/LogManager.h"
+#include "../Core/Allocator.h"
+#include "../Core/Math.h"
+#include <atomic>
+
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	#include <windows.h>
+	#include <intrin.h>
+#else
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+using namespace Core;
+
+
+// bit helpers (the argument must not be zero)
+static inline uint32 CountLeadingZeros(uint64 x)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse64(&index, x);
+	return 63 - index;
+#else
+	return __builtin_clzll(x);
+#endif
+}
+
+static inline uint32 CountTrailingZeros(uint64 x)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, x);
+	return index;
+#else
+	return __builtin_ctzll(x);
+#endif
+}
+
+
+// packs values of up to 64 bits into a byte array (least significant bit first)
+class ChunkBitWriter
+{
+	public:
+		ChunkBitWriter(Array<uint8>& bytes) : mBytes(bytes)				{ mBits = 0; mNumBits = 0; }
+
+		void Write(uint64 value, uint32 numBits)
+		{
+			// split wide values, so the accumulator never overflows
+			if (numBits > 32)
+			{
+				Write(value & 0xFFFFFFFF, 32);
+				Write(value >> 32, numBits - 32);
+				return;
+			}
+
+			mBits |= (value & ((1ULL << numBits) - 1)) << mNumBits;
+			mNumBits += numBits;
+
+			while (mNumBits >= 8)
+			{
+				mBytes.Add((uint8)mBits);
+				mBits >>= 8;
+				mNumBits -= 8;
+			}
+		}
+
+		void Flush()
+		{
+			if (mNumBits > 0)
+				mBytes.Add((uint8)mBits);
+
+			mBits = 0;
+			mNumBits = 0;
+		}
+
+	private:
+		Array<uint8>&	mBytes;
+		uint64			mBits;
+		uint32			mNumBits;
+};
+
+
+// reads back what the ChunkBitWriter packed (reads past the end return zeros)
+class ChunkBitReader
+{
+	public:
+		ChunkBitReader(const uint8* bytes, uint32 numBytes)				{ mBytes = bytes; mNumBytes = numBytes; mPosition = 0; mBits = 0; mNumBits = 0; }
+
+		uint64 Read(uint32 numBits)
+		{
+			if (numBits > 32)
+			{
+				const uint64 low = Read(32);
+				return low | (Read(numBits - 32) << 32);
+			}
+
+			while (mNumBits < numBits)
+			{
+				const uint64 byte = (mPosition < mNumBytes ? mBytes[mPosition++] : 0);
+				mBits |= byte << mNumBits;
+				mNumBits += 8;
+			}
+
+			const uint64 value = mBits & ((1ULL << numBits) - 1);
+			mBits >>= numBits;
+			mNumBits -= numBits;
+			return value;
+		}
+
+	private:
+		const uint8*	mBytes;
+		uint32			mNumBytes;
+		uint32			mPosition;
+		uint64			mBits;
+		uint32			mNumBits;
+};
+
+
+// constructor
+ChunkStore::ChunkStore(EMode mode, const char* spillFolder)
+{
+	mMode			= mode;
+	mCacheCounter	= 0;
+	mSpillFile		= -1;
+	mSpillFileSize	= 0;
+	mSpillMapping	= NULL;
+	mSpillData		= NULL;
+	mSpillDataSize	= 0;
+
+	for (uint32 i=0; i<NUM_CACHED_CHUNKS; ++i)
+	{
+		mCache[i].mChunkIndex	= CORE_INVALIDINDEX32;
+		mCache[i].mLastUse		= 0;
+	}
+
+	// without a spill file all chunks stay in memory
+	if (mMode == MODE_DISK && OpenSpillFile(spillFolder) == false)
+	{
+		LogError("ChunkStore: cannot create spill file in '%s', keeping compressed samples in memory", mSpillFilename.AsChar());
+		mMode = MODE_MEMORY;
+	}
+}
+
+
+// destructor
+ChunkStore::~ChunkStore()
+{
+	CloseSpillFile();
+}
+
+
+// encode a chunk and append it
+void ChunkStore::Add(const double* values, uint32 numValues)
+{
+	MemoryTagScope memoryTag(MEMORYTAG_DSP);
+
+	mLock.Lock();
+
+	Chunk& chunk = mChunks.AddEmpty();
+	chunk.mFileOffset	= mSpillFileSize;
+	chunk.mNumValues	= numValues;
+
+	Encode(values, numValues, mEncodeBuffer);
+	chunk.mNumBytes = mEncodeBuffer.Size();
+
+	// spill the chunk, keep it in memory only if that fails
+	if (mMode == MODE_DISK && WriteSpillFile(mEncodeBuffer.GetReadPtr(), mEncodeBuffer.Size()) == true)
+	{
+		mSpillFileSize += chunk.mNumBytes;
+	}
+	else
+	{
+		chunk.mBytes.Resize(chunk.mNumBytes);
+		if (chunk.mNumBytes > 0)
+			memcpy(chunk.mBytes.GetPtr(), mEncodeBuffer.GetReadPtr(), chunk.mNumBytes);
+	}
+
+	mLock.Unlock();
+}
+
+
+// decoded values of a chunk
+const double* ChunkStore::GetChunk(uint32 index) const
+{
+	CORE_ASSERT(index < mChunks.Size());
+
+	mLock.Lock();
+
+	// cache hit
+	CachedChunk* cached = NULL;
+	for (uint32 i=0; i<NUM_CACHED_CHUNKS; ++i)
+	{
+		if (mCache[i].mChunkIndex == index)
+		{
+			cached = &mCache[i];
+			break;
+		}
+	}
+
+	// cache miss: decode into the least recently used slot
+	if (cached == NULL)
+	{
+		MemoryTagScope memoryTag(MEMORYTAG_DSP);
+
+		cached = &mCache[0];
+		for (uint32 i=1; i<NUM_CACHED_CHUNKS; ++i)
+		{
+			if (mCache[i].mLastUse < cached->mLastUse)
+				cached = &mCache[i];
+		}
+
+		const Chunk& chunk = mChunks[index];
+		const uint8* bytes = chunk.mBytes.GetReadPtr();
+		if (chunk.mBytes.Size() != chunk.mNumBytes)
+		{
+			const uint8* spillData = MapSpillFile(chunk.mFileOffset + chunk.mNumBytes);
+			bytes = (spillData != NULL ? spillData + chunk.mFileOffset : NULL);
+		}
+
+		cached->mChunkIndex = index;
+		cached->mValues.Resize(chunk.mNumValues);
+
+		if (bytes != NULL)
+		{
+			Decode(bytes, chunk.mNumBytes, cached->mValues.GetPtr(), chunk.mNumValues);
+		}
+		else
+		{
+			LogError("ChunkStore: cannot map spill file '%s'", mSpillFilename.AsChar());
+			for (uint32 i=0; i<chunk.mNumValues; ++i)
+				cached->mValues[i] = 0.0;
+		}
+	}
+
+	cached->mLastUse = ++mCacheCounter;
+	const double* values = cached->mValues.GetReadPtr();
+
+	mLock.Unlock();
+
+	return values;
+}
+
+
+// total number of stored values
+uint64 ChunkStore::GetNumValues() const
+{
+	uint64 numValues = 0;
+
+	const uint32 numChunks = mChunks.Size();
+	for (uint32 i=0; i<numChunks; ++i)
+		numValues += mChunks[i].mNumValues;
+
+	return numValues;
+}
+
+
+// size of all encoded chunks
+uint64 ChunkStore::GetNumEncodedBytes() const
+{
+	uint64 numBytes = 0;
+
+	const uint32 numChunks = mChunks.Size();
+	for (uint32 i=0; i<numChunks; ++i)
+		numBytes += mChunks[i].mNumBytes;
+
+	return numBytes;
+}
+
+
+// memory used by the store (spilled chunks only count with their bookkeeping)
+uint64 ChunkStore::CalculateMemoryAllocated() const
+{
+	uint64 numBytes = mChunks.Size() * sizeof(Chunk) + mEncodeBuffer.Size();
+
+	const uint32 numChunks = mChunks.Size();
+	for (uint32 i=0; i<numChunks; ++i)
+		numBytes += mChunks[i].mBytes.Size();
+
+	for (uint32 i=0; i<NUM_CACHED_CHUNKS; ++i)
+		numBytes += mCache[i].mValues.Size() * sizeof(double);
+
+	return numBytes;
+}
+
+
+// chunk formats (first byte of every encoded chunk)
+enum EChunkFormat
+{
+	CHUNKFORMAT_RAW		= 0,		// uncompressed values
+	CHUNKFORMAT_XOR		= 1,		// values XORed with their predecessor
+	CHUNKFORMAT_DECIMAL	= 2			// integers with a fixed number of decimals (second byte), delta and rice coded
+};
+
+static const double gDecimalScales[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+static const uint32 gNumDecimalScales = 10;
+
+
+// encode values in the smallest of the formats
+void ChunkStore::Encode(const double* values, uint32 numValues, Array<uint8>& outBytes)
+{
+	outBytes.Clear(false);
+	outBytes.Reserve(numValues * sizeof(double) / 2);
+
+	// values that were parsed from or rounded to decimals (e.g. recordings)
+	const uint32 numDecimals = FindNumDecimals(values, numValues);
+	if (numDecimals != CORE_INVALIDINDEX32)
+	{
+		outBytes.Add(CHUNKFORMAT_DECIMAL);
+		outBytes.Add((uint8)numDecimals);
+		EncodeDecimal(values, numValues, gDecimalScales[numDecimals], outBytes);
+	}
+
+	// XOR coding wins on long runs of repeating values, encode it behind the decimal format and keep the smaller one
+	const uint32 xorStart = outBytes.Size();
+	outBytes.Add(CHUNKFORMAT_XOR);
+	EncodeXor(values, numValues, outBytes);
+
+	const uint32 xorSize = outBytes.Size() - xorStart;
+	if (xorStart > 0)
+	{
+		if (xorSize < xorStart)
+		{
+			memmove(outBytes.GetPtr(), outBytes.GetPtr() + xorStart, xorSize);
+			outBytes.Resize(xorSize);
+		}
+		else
+		{
+			outBytes.Resize(xorStart);
+		}
+	}
+
+	// store noise as it is
+	if (outBytes.Size() > 1 + numValues * sizeof(double))
+	{
+		outBytes.Resize(1 + numValues * sizeof(double));
+		outBytes[0] = CHUNKFORMAT_RAW;
+		memcpy(outBytes.GetPtr() + 1, values, numValues * sizeof(double));
+	}
+}
+
+
+// decode values written by Encode()
+void ChunkStore::Decode(const uint8* bytes, uint32 numBytes, double* outValues, uint32 numValues)
+{
+	if (numBytes == 0)
+		return;
+
+	switch (bytes[0])
+	{
+		case CHUNKFORMAT_DECIMAL:
+			DecodeDecimal(bytes + 2, numBytes - 2, gDecimalScales[bytes[1]], outValues, numValues);
+			break;
+
+		case CHUNKFORMAT_XOR:
+			DecodeXor(bytes + 1, numBytes - 1, outValues, numValues);
+			break;
+
+		default:
+			memcpy(outValues, bytes + 1, numValues * sizeof(double));
+			break;
+	}
+}
+
+
+// smallest number of decimals that represents all values exactly (CORE_INVALIDINDEX32 if there is none)
+uint32 ChunkStore::FindNumDecimals(const double* values, uint32 numValues)
+{
+	const double maxInteger = 9007199254740992.0;	// 2^53
+
+	for (uint32 d=0; d<gNumDecimalScales; ++d)
+	{
+		const double scale = gDecimalScales[d];
+
+		uint32 i = 0;
+		for (; i<numValues; ++i)
+		{
+			const double scaled = values[i] * scale;
+			if (!(Math::AbsD(scaled) < maxInteger))
+				return CORE_INVALIDINDEX32;
+
+			// the value has to come back bit by bit (this also rejects -0)
+			const double decoded = (double)llround(scaled) / scale;
+			if (memcmp(&decoded, values + i, sizeof(double)) != 0)
+				break;
+		}
+
+		if (i == numValues)
+			return d;
+	}
+
+	return CORE_INVALIDINDEX32;
+}
+
+
+// XOR with the previous value, then store only the bits between the leading and trailing zeros
+//  '0'                      value repeats
+//  '10' + bits              difference fits into the window of the previous difference
+//  '11' + 5 + 6 bits + bits new window (leading zeros and number of significant bits)
+void ChunkStore::EncodeXor(const double* values, uint32 numValues, Array<uint8>& outBytes)
+{
+	ChunkBitWriter writer(outBytes);
+
+	uint64 previous = 0;
+	uint32 windowLeading = 64;		// no window yet
+	uint32 windowTrailing = 0;
+
+	for (uint32 i=0; i<numValues; ++i)
+	{
+		uint64 bits;
+		memcpy(&bits, values + i, sizeof(double));
+
+		const uint64 x = bits ^ previous;
+		previous = bits;
+
+		if (x == 0)
+		{
+			writer.Write(0, 1);
+			continue;
+		}
+
+		const uint32 leading = Min<uint32>(CountLeadingZeros(x), 31);
+		const uint32 trailing = CountTrailingZeros(x);
+
+		if (leading >= windowLeading && trailing >= windowTrailing)
+		{
+			writer.Write(1, 2);		// bits '1', '0'
+			writer.Write(x >> windowTrailing, 64 - windowLeading - windowTrailing);
+		}
+		else
+		{
+			const uint32 numSignificantBits = 64 - leading - trailing;
+			writer.Write(3, 2);		// bits '1', '1'
+			writer.Write(leading, 5);
+			writer.Write(numSignificantBits - 1, 6);
+			writer.Write(x >> trailing, numSignificantBits);
+
+			windowLeading = leading;
+			windowTrailing = trailing;
+		}
+	}
+
+	writer.Flush();
+}
+
+
+void ChunkStore::DecodeXor(const uint8* bytes, uint32 numBytes, double* outValues, uint32 numValues)
+{
+	ChunkBitReader reader(bytes, numBytes);
+
+	uint64 previous = 0;
+	uint32 windowLeading = 0;
+	uint32 windowTrailing = 0;
+
+	for (uint32 i=0; i<numValues; ++i)
+	{
+		uint64 x = 0;
+		if (reader.Read(1) != 0)
+		{
+			// new window
+			if (reader.Read(1) != 0)
+			{
+				windowLeading = (uint32)reader.Read(5);
+				windowTrailing = 64 - windowLeading - ((uint32)reader.Read(6) + 1);
+			}
+
+			x = reader.Read(64 - windowLeading - windowTrailing) << windowTrailing;
+		}
+
+		previous ^= x;
+		memcpy(outValues + i, &previous, sizeof(double));
+	}
+}
+
+
+// rice parameter that fits the running mean of the coded deltas
+static inline uint32 CalcRiceParameter(uint64 meanSum)
+{
+	const uint64 mean = meanSum >> 4;
+	return (mean > 0 ? 63 - CountLeadingZeros(mean) : 0);
+}
+
+
+// scale to integers, then rice code the zigzag mapped differences with a parameter that follows their running mean
+//  q ones + '0' + k bits    difference >> k in unary, then the lower k bits
+//  24 ones + 64 bits        escape for outliers
+void ChunkStore::EncodeDecimal(const double* values, uint32 numValues, double scale, Array<uint8>& outBytes)
+{
+	const uint32 maxUnaryLength = 24;
+
+	ChunkBitWriter writer(outBytes);
+
+	int64 previous = 0;
+	uint64 meanSum = 0;
+
+	for (uint32 i=0; i<numValues; ++i)
+	{
+		const int64 value = llround(values[i] * scale);
+		const int64 delta = value - previous;
+		previous = value;
+
+		const uint64 u = ((uint64)delta << 1) ^ (uint64)(delta >> 63);
+		const uint32 k = CalcRiceParameter(meanSum);
+		const uint64 q = u >> k;
+
+		if (q < maxUnaryLength)
+		{
+			writer.Write((1ULL << q) - 1, (uint32)q + 1);		// q ones and the terminating zero
+			writer.Write(u, k);
+		}
+		else
+		{
+			writer.Write((1ULL << maxUnaryLength) - 1, maxUnaryLength);
+			writer.Write(u, 64);
+		}
+
+		meanSum += u - (meanSum >> 4);
+	}
+
+	writer.Flush();
+}
+
+
+void ChunkStore::DecodeDecimal(const uint8* bytes, uint32 numBytes, double scale, double* outValues, uint32 numValues)
+{
+	const uint32 maxUnaryLength = 24;
+
+	ChunkBitReader reader(bytes, numBytes);
+
+	int64 previous = 0;
+	uint64 meanSum = 0;
+
+	for (uint32 i=0; i<numValues; ++i)
+	{
+		const uint32 k = CalcRiceParameter(meanSum);
+
+		uint32 q = 0;
+		while (q < maxUnaryLength && reader.Read(1) != 0)
+			++q;
+
+		const uint64 u = (q < maxUnaryLength ? ((uint64)q << k) | reader.Read(k) : reader.Read(64));
+		meanSum += u - (meanSum >> 4);
+
+		const int64 delta = (int64)(u >> 1) ^ -(int64)(u & 1);
+		previous += delta;
+
+		outValues[i] = (double)previous / scale;
+	}
+}
+
+
+// create the spill file (it is deleted again when it gets closed)
+bool ChunkStore::OpenSpillFile(const char* spillFolder)
+{
+	static std::atomic<uint32> fileCounter(0);
+
+	String folder = spillFolder;
+	if (folder.IsEmpty() == true)
+	{
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+		char tempPath[MAX_PATH];
+		if (GetTempPathA(MAX_PATH, tempPath) > 0)
+			folder = tempPath;
+#else
+		const char* tempPath = getenv("TMPDIR");
+		folder = (tempPath != NULL ? tempPath : "/tmp");
+#endif
+	}
+
+	if (folder.IsEmpty() == false && folder.GetLast() != StringCharacter::forwardSlash && folder.GetLast() != StringCharacter::backSlash)
+		folder += "/";
+
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	mSpillFilename.Format("%sneuromore-%u-%u.spill", folder.AsChar(), (uint32)GetCurrentProcessId(), (uint32)fileCounter++);
+
+	HANDLE file = CreateFileA( mSpillFilename.AsChar(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_NEW, FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE, NULL );
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	mSpillFile = (intptr_t)file;
+#else
+	mSpillFilename.Format("%sneuromore-%u-%u.spill", folder.AsChar(), (uint32)getpid(), (uint32)fileCounter++);
+
+	const int file = open( mSpillFilename.AsChar(), O_RDWR | O_CREAT | O_EXCL, 0600 );
+	if (file < 0)
+		return false;
+
+	// the file stays accessible through the descriptor and disappears with it, even after a crash
+	unlink(mSpillFilename.AsChar());
+	mSpillFile = file;
+#endif
+
+	return true;
+}
+
+
+// unmap and close the spill file
+void ChunkStore::CloseSpillFile()
+{
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	if (mSpillData != NULL)			UnmapViewOfFile(mSpillData);
+	if (mSpillMapping != NULL)		CloseHandle(mSpillMapping);
+	if (mSpillFile != -1)			CloseHandle((HANDLE)mSpillFile);
+#else
+	if (mSpillData != NULL)			munmap( (void*)mSpillData, mSpillDataSize );
+	if (mSpillFile != -1)			close((int)mSpillFile);
+#endif
+
+	mSpillFile		= -1;
+	mSpillFileSize	= 0;
+	mSpillMapping	= NULL;
+	mSpillData		= NULL;
+	mSpillDataSize	= 0;
+}
+
+
+// append bytes to the spill file
+bool ChunkStore::WriteSpillFile(const uint8* bytes, uint32 numBytes)
+{
+	if (numBytes == 0)
+		return true;
+
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	LARGE_INTEGER position;
+	position.QuadPart = mSpillFileSize;
+	if (SetFilePointerEx((HANDLE)mSpillFile, position, NULL, FILE_BEGIN) == FALSE)
+		return false;
+
+	DWORD numWritten = 0;
+	return (WriteFile((HANDLE)mSpillFile, bytes, numBytes, &numWritten, NULL) == TRUE && numWritten == numBytes);
+#else
+	uint32 numWritten = 0;
+	while (numWritten < numBytes)
+	{
+		const ssize_t result = pwrite( (int)mSpillFile, bytes + numWritten, numBytes - numWritten, mSpillFileSize + numWritten );
+		if (result <= 0)
+			return false;
+
+		numWritten += (uint32)result;
+	}
+
+	return true;
+#endif
+}
+
+
+// map the first numBytes of the spill file (remaps the whole file if it grew past the current mapping)
+const uint8* ChunkStore::MapSpillFile(uint64 numBytes) const
+{
+	if (numBytes <= mSpillDataSize)
+		return mSpillData;
+
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	if (mSpillData != NULL)			UnmapViewOfFile(mSpillData);
+	if (mSpillMapping != NULL)		CloseHandle(mSpillMapping);
+	mSpillData = NULL;
+	mSpillDataSize = 0;
+
+	mSpillMapping = CreateFileMappingA( (HANDLE)mSpillFile, NULL, PAGE_READONLY, (DWORD)(mSpillFileSize >> 32), (DWORD)mSpillFileSize, NULL );
+	if (mSpillMapping == NULL)
+		return NULL;
+
+	mSpillData = (const uint8*)MapViewOfFile( mSpillMapping, FILE_MAP_READ, 0, 0, 0 );
+#else
+	if (mSpillData != NULL)
+		munmap( (void*)mSpillData, mSpillDataSize );
+	mSpillData = NULL;
+	mSpillDataSize = 0;
+
+	void* data = mmap( NULL, mSpillFileSize, PROT_READ, MAP_SHARED, (int)mSpillFile, 0 );
+	if (data == MAP_FAILED)
+		return NULL;
+
+	mSpillData = (const uint8*)data;
+#endif
+
+	if (mSpillData != NULL)
+		mSpillDataSize = mSpillFileSize;
+
+	return mSpillData;
+}
@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_CHUNKSTORE_H
+#define __NEUROMORE_CHUNKSTORE_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+#include "../Core/String.h"
+#include "../Core/Mutex.h"
+
+
+// compressed storage for the older sample chunks of a storage channel (see Channel<T>)
+//  - chunks are encoded losslessly: values with a fixed number of decimals (e.g. parsed recordings) as rice coded integer deltas,
+//    everything else XORed with its predecessor so only the significant bits of the difference are stored (noise is stored as it is)
+//  - encoded chunks are kept in memory or appended to a temporary spill file that is mapped for reading
+//  - the most recently decoded chunks are cached, so sequential reads decode every chunk only once
+class ENGINE_API ChunkStore
+{
+	public:
+		enum EMode
+		{
+			MODE_MEMORY	= 0,		// keep the encoded chunks in memory
+			MODE_DISK	= 1			// append the encoded chunks to a spill file
+		};
+
+		// constructor & destructor (an empty spill folder selects the temp folder of the system)
+		ChunkStore(EMode mode, const char* spillFolder = "");
+		~ChunkStore();
+
+		EMode GetMode() const													{ return mMode; }
+
+		// encode a chunk and append it (falls back to memory if the spill file can't be written)
+		void Add(const double* values, uint32 numValues);
+
+		// decoded values of a chunk (valid until the chunk drops out of the cache)
+		const double* GetChunk(uint32 index) const;
+
+		uint32 GetNumChunks() const												{ return mChunks.Size(); }
+		uint64 GetNumValues() const;
+
+		// size of the encoded chunks (in memory and on disk) and memory used by the store
+		uint64 GetNumEncodedBytes() const;
+		uint64 CalculateMemoryAllocated() const;
+
+		// the codec
+		static void Encode(const double* values, uint32 numValues, Core::Array<uint8>& outBytes);
+		static void Decode(const uint8* bytes, uint32 numBytes, double* outValues, uint32 numValues);
+
+	private:
+		static uint32 FindNumDecimals(const double* values, uint32 numValues);
+		static void EncodeXor(const double* values, uint32 numValues, Core::Array<uint8>& outBytes);
+		static void DecodeXor(const uint8* bytes, uint32 numBytes, double* outValues, uint32 numValues);
+		static void EncodeDecimal(const double* values, uint32 numValues, double scale, Core::Array<uint8>& outBytes);
+		static void DecodeDecimal(const uint8* bytes, uint32 numBytes, double scale, double* outValues, uint32 numValues);
+
+		struct Chunk
+		{
+			Core::Array<uint8>	mBytes;					// encoded chunk (empty if it was spilled)
+			uint64				mFileOffset;			// position in the spill file
+			uint32				mNumBytes;
+			uint32				mNumValues;
+		};
+
+		// recently decoded chunks
+		enum { NUM_CACHED_CHUNKS = 4 };
+		struct CachedChunk
+		{
+			uint32				mChunkIndex;
+			uint32				mLastUse;
+			Core::Array<double>	mValues;
+		};
+
+		// spill file
+		bool OpenSpillFile(const char* spillFolder);
+		void CloseSpillFile();
+		bool WriteSpillFile(const uint8* bytes, uint32 numBytes);
+		const uint8* MapSpillFile(uint64 numBytes) const;
+
+		EMode					mMode;
+		Core::Array<Chunk>		mChunks;
+		Core::Array<uint8>		mEncodeBuffer;
+
+		mutable CachedChunk		mCache[NUM_CACHED_CHUNKS];
+		mutable uint32			mCacheCounter;
+		mutable Core::Mutex		mLock;
+
+		Core::String			mSpillFilename;
+		intptr_t				mSpillFile;				// file handle (Windows) or descriptor, -1 if there is no spill file
+		uint64					mSpillFileSize;
+		mutable void*			mSpillMapping;			// file mapping handle (Windows only)
+		mutable const uint8*	mSpillData;				// mapped part of the spill file
+		mutable uint64			mSpillDataSize;
+};
+
+
+#endif
@@ -100,10 +100,15 @@ void ClockGenerator::Update(const Time& elapsed, const Time& delta)
 		maxElapsedTime = elapsed;
 	}
 
-	// calculate the number of new ticks that occured
+	// clock is already ahead (time is unsigned, the interval must not underflow)
+	if (maxElapsedTime <= mElapsedTime)
+		return;
+
+	// calculate the number of new ticks that occured; the tick time is rounded to full nanoseconds, so a tick that falls exactly
+	// on the elapsed time must not get lost to rounding (otherwise the tick count depends on the sequence of update deltas)
 	const double samplePeriod = 1.0 / mFrequency;
 	Time intervalLength = maxElapsedTime - mElapsedTime;
-	uint32 numTicks = intervalLength.InSeconds() / samplePeriod;
+	uint32 numTicks = (intervalLength.InSeconds() + 1E-8) * mFrequency;
 	
 	// advance clock
 	mNewTicks += numTicks;
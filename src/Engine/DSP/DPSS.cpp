@@ -0,0 +1,273 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required files
+#include "DPSS.h"
+#include "../Core/Array.h"
+#include "../Core/Math.h"
+#include "../Core/Mutex.h"
+
+
+using namespace Core;
+
+//-----------------------------------------------
+// taper cache
+//-----------------------------------------------
+
+// all tapers that were requested so far (never released, there are only a few different lengths and bandwidths in use)
+class DPSSCache
+{
+	public:
+		struct Table
+		{
+			uint32			mNumSamples;
+			double			mTimeBandwidth;
+			uint32			mNumTapers;
+			Array<double>	mValues;
+		};
+
+		~DPSSCache()
+		{
+			const uint32 numTables = mTables.Size();
+			for (uint32 i=0; i<numTables; ++i)
+				delete mTables[i];
+		}
+
+		const double* GetTapers(uint32 numSamples, double timeBandwidth, uint32 numTapers, void (*calcFunction)(uint32, double, uint32, double*))
+		{
+			mLock.Lock();
+
+			const uint32 numTables = mTables.Size();
+			for (uint32 i=0; i<numTables; ++i)
+			{
+				if (mTables[i]->mNumSamples == numSamples && mTables[i]->mTimeBandwidth == timeBandwidth && mTables[i]->mNumTapers == numTapers)
+				{
+					const double* values = mTables[i]->mValues.GetReadPtr();
+					mLock.Unlock();
+					return values;
+				}
+			}
+
+			// calculate new tapers
+			Table* table = new Table();
+			table->mNumSamples = numSamples;
+			table->mTimeBandwidth = timeBandwidth;
+			table->mNumTapers = numTapers;
+			table->mValues.Resize(numTapers * numSamples);
+			calcFunction(numSamples, timeBandwidth, numTapers, table->mValues.GetPtr());
+
+			mTables.Add(table);
+			mLock.Unlock();
+
+			return table->mValues.GetReadPtr();
+		}
+
+	private:
+		Array<Table*>	mTables;
+		Mutex			mLock;
+};
+
+
+// number of well concentrated tapers
+uint32 DPSS::CalcNumTapers(double timeBandwidth)
+{
+	const int32 numTapers = (int32)Math::FloorD(2.0 * timeBandwidth) - 1;
+	return (numTapers < 1 ? 1 : numTapers);
+}
+
+
+// get the (cached) tapers
+const double* DPSS::GetTapers(uint32 numSamples, double timeBandwidth, uint32 numTapers)
+{
+	static DPSSCache cache;
+	return cache.GetTapers(numSamples, timeBandwidth, numTapers, CalcTapers);
+}
+
+
+//-----------------------------------------------
+// taper calculation
+//-----------------------------------------------
+
+// The tapers are the eigenvectors of the symmetric tridiagonal matrix (Percival & Walden)
+//   T[i][i]   = ((N-1-2i)/2)^2 * cos(2*pi*W)
+//   T[i][i-1] = i*(N-i)/2
+// that belong to its largest eigenvalues. The eigenvalues are located with Sturm sequence bisection and the
+// eigenvectors with inverse iteration, so the cost is O(N) per taper and long windows remain cheap.
+
+// number of eigenvalues of the tridiagonal matrix that are smaller than x
+static uint32 CountEigenvaluesBelow(const Array<double>& diag, const Array<double>& offDiag, double x, double tiny)
+{
+	const uint32 numSamples = diag.Size();
+
+	uint32 count = 0;
+	double q = diag[0] - x;
+	if (q < 0.0)
+		count++;
+
+	for (uint32 i=1; i<numSamples; ++i)
+	{
+		if (Math::AbsD(q) < tiny)
+			q = tiny;
+
+		q = diag[i] - x - offDiag[i] * offDiag[i] / q;
+		if (q < 0.0)
+			count++;
+	}
+
+	return count;
+}
+
+
+void DPSS::CalcTapers(uint32 numSamples, double timeBandwidth, uint32 numTapers, double* outTapers)
+{
+	const uint32 N = numSamples;
+
+	// trivial window length
+	if (N <= 1)
+	{
+		for (uint32 k=0; k<numTapers; ++k)
+			for (uint32 i=0; i<N; ++i)
+				outTapers[k*N + i] = (k == 0 ? 1.0 : 0.0);
+		return;
+	}
+
+	// setup the tridiagonal matrix
+	const double cosW = Math::CosD(2.0 * Math::piD * timeBandwidth / N);
+	Array<double> diag;
+	Array<double> offDiag;		// offDiag[i] couples i-1 and i
+	diag.Resize(N);
+	offDiag.Resize(N);
+
+	double lowerBound = DBL_MAX;
+	double upperBound = -DBL_MAX;
+	double scale = 0.0;
+	for (uint32 i=0; i<N; ++i)
+	{
+		const double center = (N - 1.0 - 2.0 * i) * 0.5;
+		diag[i] = center * center * cosW;
+		offDiag[i] = i * (N - i) * 0.5;
+	}
+
+	// Gershgorin bounds of the eigenvalues
+	for (uint32 i=0; i<N; ++i)
+	{
+		const double radius = offDiag[i] + (i+1 < N ? offDiag[i+1] : 0.0);
+		lowerBound = Min(lowerBound, diag[i] - radius);
+		upperBound = Max(upperBound, diag[i] + radius);
+		scale = Max(scale, Math::AbsD(diag[i]) + radius);
+	}
+
+	const double tiny = scale * DBL_EPSILON;
+
+	Array<double> lower, upper, rhs;
+	lower.Resize(N);
+	upper.Resize(N);
+	rhs.Resize(N);
+
+	for (uint32 k=0; k<numTapers; ++k)
+	{
+		double* taper = outTapers + k * N;
+
+		// more tapers than samples: remaining tapers are zero
+		if (k >= N)
+		{
+			for (uint32 i=0; i<N; ++i)
+				taper[i] = 0.0;
+			continue;
+		}
+
+		// 1) find the k-th largest eigenvalue by bisection
+		const uint32 ascendingIndex = N - 1 - k;
+		double a = lowerBound;
+		double b = upperBound;
+		for (uint32 iteration=0; iteration<256; ++iteration)
+		{
+			const double mid = 0.5 * (a + b);
+			if (mid <= a || mid >= b)
+				break;
+
+			if (CountEigenvaluesBelow(diag, offDiag, mid, tiny) > ascendingIndex)
+				b = mid;
+			else
+				a = mid;
+		}
+		const double eigenvalue = 0.5 * (a + b);
+
+		// 2) inverse iteration: solve (T - eigenvalue*I) x = x a few times, starting from a vector that is neither symmetric nor antisymmetric
+		for (uint32 i=0; i<N; ++i)
+			taper[i] = 1.0 + (double)i / N;
+
+		for (uint32 iteration=0; iteration<3; ++iteration)
+		{
+			// tridiagonal solve (Thomas algorithm); the system is nearly singular by design, so tiny pivots are clamped
+			double pivot = diag[0] - eigenvalue;
+			if (Math::AbsD(pivot) < tiny)
+				pivot = tiny;
+			upper[0] = (N > 1 ? offDiag[1] / pivot : 0.0);
+			rhs[0] = taper[0] / pivot;
+			for (uint32 i=1; i<N; ++i)
+			{
+				pivot = diag[i] - eigenvalue - offDiag[i] * upper[i-1];
+				if (Math::AbsD(pivot) < tiny)
+					pivot = tiny;
+				upper[i] = (i+1 < N ? offDiag[i+1] / pivot : 0.0);
+				rhs[i] = (taper[i] - offDiag[i] * rhs[i-1]) / pivot;
+			}
+
+			taper[N-1] = rhs[N-1];
+			for (int32 i=N-2; i>=0; --i)
+				taper[i] = rhs[i] - upper[i] * taper[i+1];
+
+			// orthogonalize against the previous tapers (guards against close eigenvalues)
+			for (uint32 j=0; j<k; ++j)
+			{
+				const double* other = outTapers + j * N;
+				double dot = 0.0;
+				for (uint32 i=0; i<N; ++i)
+					dot += taper[i] * other[i];
+				for (uint32 i=0; i<N; ++i)
+					taper[i] -= dot * other[i];
+			}
+
+			// normalize to unit energy
+			double energy = 0.0;
+			for (uint32 i=0; i<N; ++i)
+				energy += taper[i] * taper[i];
+
+			const double norm = (energy > 0.0 ? 1.0 / Math::SqrtD(energy) : 0.0);
+			for (uint32 i=0; i<N; ++i)
+				taper[i] *= norm;
+		}
+
+		// 3) sign convention: symmetric tapers have a positive sum, antisymmetric tapers start with a positive lobe
+		double polarity = 0.0;
+		for (uint32 i=0; i<N; ++i)
+			polarity += taper[i] * (k % 2 == 0 ? 1.0 : (N - 1.0 - 2.0 * i));
+
+		if (polarity < 0.0)
+		{
+			for (uint32 i=0; i<N; ++i)
+				taper[i] = -taper[i];
+		}
+	}
+}
@@ -0,0 +1,48 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_DPSS_H
+#define __NEUROMORE_DPSS_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+
+
+// discrete prolate spheroidal sequences (Slepian tapers) for multitaper spectral estimation
+class ENGINE_API DPSS
+{
+	public:
+		// number of well concentrated tapers for a time-bandwidth product (2NW-1, at least one)
+		static uint32 CalcNumTapers(double timeBandwidth);
+
+		// the first numTapers sequences of length numSamples with half bandwidth W = timeBandwidth / numSamples;
+		// returns numTapers * numSamples values (taper after taper), each taper has unit energy; the tables are shared process-wide and stay valid until the program ends
+		static const double* GetTapers(uint32 numSamples, double timeBandwidth, uint32 numTapers);
+
+	private:
+		static void CalcTapers(uint32 numSamples, double timeBandwidth, uint32 numTapers, double* outTapers);
+};
+
+
+#endif
@@ -27,6 +27,7 @@
 #include "Channel.h"
 #include "WindowFunction.h"
 #include "Spectrum.h"
+#include <algorithm>
 
 
 using namespace Core;
@@ -41,6 +42,9 @@ Epoch::Epoch(ChannelBase* channel, uint32 length)
 
 	// no window function by default
 	mWindowFunction = NULL;
+	mWindowTable = NULL;
+
+	mSamples = NULL;
 }
 
 
@@ -75,6 +79,7 @@ void Epoch::SetPositionByOffset(uint32 offset)
 		return;
 
 	mPosition = mChannel->GetMaxSampleIndex() - (uint64)offset;
+	mSamples = NULL;
 }
 
 
@@ -99,8 +104,8 @@ uint32 Epoch::GetNumSamples() const
 }
 
 
-// sample accessor for double value (can apply window function)
-double Epoch::GetSample(uint32 index) const
+// read a sample from the channel (can apply window function)
+double Epoch::ReadSample(uint32 index) const
 {
 	if (HasChannel() == false)
 		return 0;
@@ -138,11 +143,94 @@ double Epoch::GetSample(uint32 index) const
 
 	// apply window function (if any)
 	if (mWindowFunction != NULL)
-		value = value * mWindowFunction->Evaluate(index, mLength);
+	{
+		if (mWindowTable == NULL)
+			mWindowTable = mWindowFunction->GetTable(mLength);
+
+		value = value * mWindowTable[index];
+	}
 
 	return value;
 }
 
+
+// copy the whole epoch; same values as calling GetSample() for every index, but the channel is read in bulk and the window is applied in a single pass
+void Epoch::CopySamples(double* outValues) const
+{
+	if (mWindowFunction != NULL && mWindowTable == NULL)
+		mWindowTable = mWindowFunction->GetTable(mLength);
+
+	CopySamples(outValues, mWindowTable, false);
+}
+
+
+void Epoch::CopySamples(double* outValues, const double* windowTable, bool removeMean) const
+{
+	if (mLength == 0)
+		return;
+
+	// padding and invalid samples are zero
+	Core::MemSet(outValues, 0, mLength * sizeof(double));
+
+	if (HasChannel() == false)
+		return;
+
+	// incomplete epoch and padding disabled : epoch contains only zero values
+	const uint32 maxEpochIndex = mLength - 1;
+	if (mPosition < maxEpochIndex && mPaddingEnabled == false)
+		return;
+
+	Channel<double>* channel = mChannel->AsType<double>();
+	if (channel->GetNumSamples() == 0)
+		return;
+
+	// range of epoch indices that map to valid channel samples
+	const int64 baseIndex	= (int64)mPosition - (int64)maxEpochIndex;
+	const int64 firstIndex	= Core::Max<int64>(0, (int64)channel->GetMinSampleIndex() - baseIndex);
+	const int64 lastIndex	= Core::Min<int64>(maxEpochIndex, (int64)channel->GetMaxSampleIndex() - baseIndex);
+	if (firstIndex > lastIndex)
+		return;
+
+	const uint32 numValidSamples = (uint32)(lastIndex - firstIndex + 1);
+	double* validSamples = outValues + firstIndex;
+	channel->CopySamples(baseIndex + firstIndex, numValidSamples, validSamples);
+
+	// mean of the valid samples
+	double mean = 0.0;
+	if (removeMean == true)
+	{
+		for (uint32 i=0; i<numValidSamples; ++i)
+			mean += validSamples[i];
+		mean /= numValidSamples;
+	}
+
+	// remove mean and apply window in one pass (the padding stays zero)
+	if (windowTable != NULL)
+	{
+		const double* window = windowTable + firstIndex;
+		for (uint32 i=0; i<numValidSamples; ++i)
+			validSamples[i] = (validSamples[i] - mean) * window[i];
+	}
+	else if (removeMean == true)
+	{
+		for (uint32 i=0; i<numValidSamples; ++i)
+			validSamples[i] -= mean;
+	}
+}
+
+
+const double* Epoch::Materialize(ScratchArena& arena)
+{
+	if (mSamples != NULL)
+		return mSamples;
+
+	double* samples = arena.Allocate<double>(mLength);
+	CopySamples(samples);
+
+	mSamples = samples;
+	return mSamples;
+}
+
 //
 //// sample accessor for all other values
 //template<class T>
@@ -345,15 +433,28 @@ double Epoch::GeometricMean() const
 }
 
 
+// select the value from a sorted array without actually sorting it (the values are reordered)
+double Epoch::SelectQuantile(uint32 q, uint32 n, double* values, uint32 numValues)
+{
+	// calculate index
+	const double normedIndex = (double)n / (double)q;
+	const uint32 index = (numValues - 1) * normedIndex;
+
+	CORE_ASSERT( index <= numValues-1 );
+
+	std::nth_element(values, values + index, values + numValues);
+	return values[index];
+}
+
+
 double Epoch::Quantile(uint32 q, uint32 n, Array<double>& tempArray) const
 {
 	// sanity check
 	if (n > q)
 		return 0.0;
 
-	const uint32 numValidSamples = mLength - GetNumPaddingSamples();
-	if (numValidSamples == 0)
-		return 0;
+	const uint32 numPaddingSamples = GetNumPaddingSamples();
+	const uint32 numValidSamples = mLength - numPaddingSamples;
 
 	// handle special cases
 	if (numValidSamples == 0)
@@ -362,20 +463,10 @@ double Epoch::Quantile(uint32 q, uint32 n, Array<double>& tempArray) const
 		return GetSample(mLength-1);
 
 	// resize and copy values
-	tempArray.Resize(numValidSamples);
-	for (uint32 i = GetNumPaddingSamples(); i < mLength; ++i)
-		tempArray[i] = GetSample(i);
-
-	// sort values
-	tempArray.Sort();
-
-	// calculate index
-	const double normedIndex = (double)n / (double)q;
-	const uint32 index = (numValidSamples - 1) * normedIndex;
+	tempArray.Resize(mLength);
+	CopySamples(tempArray.GetPtr());
 
-	CORE_ASSERT( index <= numValidSamples-1 );
-	// return value
-	return tempArray[index];
+	return SelectQuantile(q, n, tempArray.GetPtr() + numPaddingSamples, numValidSamples);
 }
 
 
@@ -389,3 +480,42 @@ double Epoch::Median(Array<double>& tempArray) const
 {
 	return Quantile(2, 1, tempArray);
 }
+
+
+double Epoch::Quantile(uint32 q, uint32 n, ScratchArena& arena) const
+{
+	// sanity check
+	if (n > q)
+		return 0.0;
+
+	const uint32 numPaddingSamples = GetNumPaddingSamples();
+	const uint32 numValidSamples = mLength - numPaddingSamples;
+
+	// handle special cases
+	if (numValidSamples == 0)
+		return 0.0;
+	else if (numValidSamples == 1)
+		return GetSample(mLength-1);
+
+	// borrow the temporary array from the arena
+	ScratchArena::Scope scope(arena);
+	double* values = arena.Allocate<double>(mLength);
+	if (mSamples != NULL)
+		Core::MemCopy(values, mSamples, mLength * sizeof(double));
+	else
+		CopySamples(values);
+
+	return SelectQuantile(q, n, values + numPaddingSamples, numValidSamples);
+}
+
+
+double Epoch::Percentile(uint32 n, ScratchArena& arena) const
+{
+	return Quantile(100, n, arena);
+}
+
+
+double Epoch::Median(ScratchArena& arena) const
+{
+	return Quantile(2, 1, arena);
+}
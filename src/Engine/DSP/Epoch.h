@@ -27,6 +27,7 @@
 // include required headers
 #include "../Config.h"
 #include "ChannelBase.h"
+#include "../Core/ScratchArena.h"
 
 
 // forward declaration
@@ -43,20 +44,20 @@ class ENGINE_API Epoch
 
 		// set/get default window function for this sample data interval
 		WindowFunction* GetWindowFunction() const									{ return mWindowFunction; }
-		void SetWindowFunction(WindowFunction* windowFunction)						{ mWindowFunction = windowFunction; }
+		void SetWindowFunction(WindowFunction* windowFunction)						{ mWindowFunction = windowFunction; mWindowTable = NULL; mSamples = NULL; }
 
 		// the channel this epoch is applied to
-		void SetChannel(ChannelBase* channel)										{ mChannel = channel; }
+		void SetChannel(ChannelBase* channel)										{ mChannel = channel; mSamples = NULL; }
 		bool HasChannel() const														{ return (mChannel != NULL); }
 
 		// length of the epoch, in samples
-		void SetLength(uint32 length)												{ mLength = length; }
+		void SetLength(uint32 length)												{ mLength = length; mWindowTable = NULL; mSamples = NULL; }
 		uint32 GetLength() const													{ return mLength; }
 
 		// epoch position inside the channel
-		void SetPosition(uint32 index)												{ mPosition = index; }
+		void SetPosition(uint64 index)												{ mPosition = index; mSamples = NULL; }
 		void SetPositionByOffset(uint32 offset);
-		uint32 GetPosition() const													{ return mPosition; }
+		uint64 GetPosition() const													{ return mPosition; }
 		
 		// zero padding
 		void SetZeroPaddingEnabled(bool enable)										{ mPaddingEnabled = enable; }
@@ -64,7 +65,17 @@ class ENGINE_API Epoch
 
 		// access samples in the (windowed) epoch. Sample number 0 is the oldest sample.
 		uint32 GetNumSamples() const;
-		double GetSample(uint32 index) const;
+		double GetSample(uint32 index) const										{ if (mSamples != NULL) return mSamples[index]; return ReadSample(index); }
+
+		// copy all samples of the (windowed, zero padded) epoch into contiguous memory (GetLength() values)
+		void CopySamples(double* outValues) const;
+
+		// copy the samples, remove the mean of the valid samples (optional) and multiply with a window table (optional, GetLength() values), e.g. to fill an FFT input buffer
+		void CopySamples(double* outValues, const double* windowTable, bool removeMean) const;
+
+		// copy the samples into scratch memory once; afterwards GetSample() reads from there (valid until the arena is reset)
+		const double* Materialize(Core::ScratchArena& arena);
+		const double* GetMaterializedSamples() const								{ return mSamples; }
 		
 		// get last sample of epoch (newest)
 		double GetLastSample() const												{ return GetSample(mLength - 1); }
@@ -91,7 +102,18 @@ class ENGINE_API Epoch
 		double Percentile(uint32 n, Core::Array<double>& sortingArray) const;			// calculates the nth Percentile
 		double Median(Core::Array<double>& sortingArray) const;							// median = the first (and single) 2-quantile
 
+		// same as above, but the temporary array is borrowed from a scratch arena
+		double Quantile(uint32 q, uint32 n, Core::ScratchArena& arena) const;
+		double Percentile(uint32 n, Core::ScratchArena& arena) const;
+		double Median(Core::ScratchArena& arena) const;
+
 	private:
+		// read one sample directly from the channel
+		double ReadSample(uint32 index) const;
+
+		// select the nth q-quantile from the given values (reorders them)
+		static double SelectQuantile(uint32 q, uint32 n, double* values, uint32 numValues);
+
 		// the channel this epoch is associated with
 		ChannelBase*			mChannel;
 
@@ -106,6 +128,12 @@ class ENGINE_API Epoch
 
 		// the windowfunction that is applied to the samples (NULL also means no window function)
 		WindowFunction*			mWindowFunction;
+
+		// precalculated values of the window function (shared table, looked up on first use)
+		mutable const double*	mWindowTable;
+
+		// materialized samples (owned by a scratch arena, NULL if not materialized)
+		const double*			mSamples;
 };
 
 
@@ -26,6 +26,7 @@
 #include "../Core/LogManager.h"
 #include "Channel.h"
 #include "ChannelProcessor.h"
+#include "DPSS.h"
 
 
 using namespace Core;
@@ -35,6 +36,12 @@ FFTProcessor::FFTProcessor()
 {
 	Init();
 	mIsInitialized = false;
+	mWindowTable = NULL;
+	mWindowGain = 1.0;
+	mUseSlidingDFT = false;
+	mNumCosineTerms = 0;
+	mTapers = NULL;
+	mNumTapers = 0;
 }
 
 
@@ -81,9 +88,16 @@ void FFTProcessor::ReInit()
 	// calculate number of FFT input samples
 	mSettings.mNumFFTSamples = Math::Pow(2, mSettings.mFFTOrder);
 
+	// clamp PSD parameters
+	if (mSettings.mNumSegments == 0)
+		mSettings.mNumSegments = 1;
+	if (mSettings.mTimeBandwidth < 1.0)
+		mSettings.mTimeBandwidth = 1.0;
+
 	// configure input reader epoching
+	const uint32 epochLength = CalcEpochLength();
 	ChannelReader*	inputReader = GetInputReader(0);
-	inputReader->SetEpochLength(mSettings.mNumFFTSamples);
+	inputReader->SetEpochLength(epochLength);
 	inputReader->SetEpochZeroPadding(mSettings.mUseZeroPadding);
 	inputReader->SetEpochShift(mSettings.mEpochShift);
 
@@ -98,6 +112,37 @@ void FFTProcessor::ReInit()
 	// init FFT
 	mFFT.Init(mSettings.mNumFFTSamples);
 
+	// look up the window; its coherent gain (mean) is compensated after the FFT, so the amplitudes don't depend on the window type
+	// without windowing the input is copied as is and the output is not rescaled (identical to graphs that predate the window option)
+	mWindowTable = NULL;
+	mWindowGain = 1.0;
+	if (mSettings.mApplyWindow == true)
+	{
+		mWindowTable = mSettings.mWindowFunction.GetTable(mSettings.mNumFFTSamples);
+		double windowSum = 0.0;
+		for (uint32 i=0; i<mSettings.mNumFFTSamples; ++i)
+			windowSum += mWindowTable[i];
+		mWindowGain = (windowSum > 0.0 ? windowSum / mSettings.mNumFFTSamples : 1.0);
+	}
+
+	// averaged PSD estimate
+	mTapers = NULL;
+	mNumTapers = 0;
+	if (mSettings.mEstimator != FFTSettings::ESTIMATOR_PERIODOGRAM)
+	{
+		mEpochSamples.Resize(epochLength);
+		mPowerSums.Resize(mSettings.mNumFFTSamples / 2 + 1);
+
+		if (mSettings.mEstimator == FFTSettings::ESTIMATOR_MULTITAPER)
+		{
+			mNumTapers = DPSS::CalcNumTapers(mSettings.mTimeBandwidth);
+			mTapers = DPSS::GetTapers(mSettings.mNumFFTSamples, mSettings.mTimeBandwidth, mNumTapers);
+		}
+	}
+
+	// incremental mode
+	ReInitSlidingDFT(input->GetSampleRate());
+
 	// calculate output sample rate
 	double outputSampleRate = input->GetSampleRate() / (double)mSettings.mEpochShift;
 
@@ -117,6 +162,12 @@ void FFTProcessor::Update()
 	// update input readers
 	ChannelProcessor::Update();
 
+	if (mUseSlidingDFT == true)
+	{
+		UpdateSlidingDFT();
+		return;
+	}
+
 	ChannelBase* inputChannel = GetInput();
 	ChannelReader* inputReader = GetInputReader();
 
@@ -138,11 +189,20 @@ void FFTProcessor::Update()
 	{
 		// 1) get the input epoch
 		Epoch inputEpoch = inputReader->PopOldestEpoch();
+
+		// averaged PSD estimate instead of a single periodogram
+		if (mSettings.mEstimator != FFTSettings::ESTIMATOR_PERIODOGRAM)
+		{
+			Spectrum* spectrum = output->GetNextSampleRef();
+			spectrum->SetMaxFrequency(inputChannel->GetSampleRate() / 2.0);
+			spectrum->SetNumBins(numBins);
+			CalcPSD(inputEpoch, spectrum);
+			spectrum->SetTime(input->GetSampleTime(inputEpoch.GetPosition()).InSeconds());
+			continue;
+		}
 	
-		// 2) copy values to FFT input
-		double* inputBuffer = mFFT.GetInput();
-		for (uint32 s=0; s < mSettings.mNumFFTSamples; ++s)
-			inputBuffer[s] = inputEpoch.GetSample(s);
+		// 2) copy values to FFT input, remove DC and apply the window in one pass
+		inputEpoch.CopySamples(mFFT.GetInput(), mWindowTable, mSettings.mRemoveDC);
 
 		// 3) calculate Discrete Fourier Transform
 		mFFT.CalcFFT();
@@ -155,10 +215,10 @@ void FFTProcessor::Update()
 		// 5) calculate spectrum power from complex spectrum
 		// 5.1) copy over 0Hz bin (DC part; scaled by 2 due to half symmetry of complex spectrum)
 		const Complex* complexSpectrum = mFFT.GetOutput();
-		spectrum->SetBin(0, complexSpectrum[0].mReal / numBins / 2.0);
+		spectrum->SetBin(0, complexSpectrum[0].mReal / numBins / 2.0 / mWindowGain);
 
 		// 5.2) calculate real-valued power spectrum (L2-Norm of complex frequency values), scale by mNumBins/2, and double the value (due to spectrum symmetrie)
-		const double scalingFactor = 1.0 / (numBins-1) / 2.0 * 2.0;		// for clarity (is optimized by compiler)
+		const double scalingFactor = 1.0 / (numBins-1) / 2.0 * 2.0 / mWindowGain;		// for clarity (is optimized by compiler)
 		for (uint32 b = 1; b < numBins; b++)
 			spectrum->SetBin(b, complexSpectrum[b] * scalingFactor);
 		
@@ -170,12 +230,292 @@ void FFTProcessor::Update()
 
 
 
+// number of input samples per output spectrum
+uint32 FFTProcessor::CalcEpochLength() const
+{
+	if (mSettings.mEstimator == FFTSettings::ESTIMATOR_WELCH && mSettings.mNumSegments > 1)
+		return mSettings.mNumFFTSamples + (mSettings.mNumSegments - 1) * Max<uint32>(1, mSettings.mNumFFTSamples / 2);
+
+	return mSettings.mNumFFTSamples;
+}
+
+
+// averaged power spectral density estimate of one epoch
+// Welch: average the periodograms of 50% overlapping windowed segments; multitaper: average the periodograms of the same samples multiplied with the DPSS tapers.
+// The output bins hold the square root of the averaged power (real valued, zero phase) with the same amplitude scaling as the periodogram,
+// so magnitude-based and power-based consumers both see the averaged estimate. The tapers have unit energy and are rescaled to the energy
+// of the rectangular window, so noise levels match the periodogram.
+void FFTProcessor::CalcPSD(const Epoch& epoch, Spectrum* spectrum)
+{
+	const uint32 numSamples = mSettings.mNumFFTSamples;
+	const uint32 numBins = numSamples / 2 + 1;
+	const bool isMultitaper = (mSettings.mEstimator == FFTSettings::ESTIMATOR_MULTITAPER);
+	const uint32 numSegments = (isMultitaper == true ? mNumTapers : mSettings.mNumSegments);
+	const uint32 segmentShift = (isMultitaper == true ? 0 : Max<uint32>(1, numSamples / 2));
+	const double taperScale = Math::SqrtD(numSamples);
+
+	epoch.CopySamples(mEpochSamples.GetPtr(), NULL, false);
+
+	double* powerSums = mPowerSums.GetPtr();
+	for (uint32 b=0; b<numBins; ++b)
+		powerSums[b] = 0.0;
+
+	double* fftInput = mFFT.GetInput();
+	for (uint32 s=0; s<numSegments; ++s)
+	{
+		const double* segment = mEpochSamples.GetReadPtr() + s * segmentShift;
+
+		// remove the mean of each segment
+		double mean = 0.0;
+		if (mSettings.mRemoveDC == true)
+		{
+			for (uint32 i=0; i<numSamples; ++i)
+				mean += segment[i];
+			mean /= numSamples;
+		}
+
+		// apply the window or taper
+		if (isMultitaper == true)
+		{
+			const double* taper = mTapers + s * numSamples;
+			for (uint32 i=0; i<numSamples; ++i)
+				fftInput[i] = (segment[i] - mean) * taper[i] * taperScale;
+		}
+		else if (mWindowTable != NULL)
+		{
+			for (uint32 i=0; i<numSamples; ++i)
+				fftInput[i] = (segment[i] - mean) * mWindowTable[i];
+		}
+		else
+		{
+			for (uint32 i=0; i<numSamples; ++i)
+				fftInput[i] = segment[i] - mean;
+		}
+
+		mFFT.CalcFFT();
+
+		const Complex* fftOutput = mFFT.GetOutput();
+		for (uint32 b=0; b<numBins; ++b)
+			powerSums[b] += fftOutput[b].SquaredNorm();
+	}
+
+	// average and convert to amplitudes (same scaling as the periodogram, tapers have no coherent gain compensation)
+	const double windowGain = (isMultitaper == true ? 1.0 : mWindowGain);
+	const double scalingFactor = 1.0 / (numBins-1) / windowGain;
+	spectrum->SetBin(0, Math::SqrtD(powerSums[0] / numSegments) / numBins / 2.0 / windowGain);
+	for (uint32 b=1; b<numBins; ++b)
+		spectrum->SetBin(b, Math::SqrtD(powerSums[b] / numSegments) * scalingFactor);
+}
+
+
+//
+// sliding DFT
+//
+// The unwindowed DFT of the last N samples is updated recursively with every new sample: X_k = (X_k + x_new - x_old) * e^(j*2*pi*k/N).
+// Only the bins of the requested frequency range (plus the neighbours the window needs) are tracked, so the cost is O(bins) per sample.
+// Cosine-sum windows are applied in the frequency domain as a short convolution over neighbouring bins (periodic window form).
+// To keep the rounding errors of the recursion from accumulating, the tracked bins are recalculated exactly once every N samples.
+//
+
+// prepare the sliding DFT state (or disable it if the settings require the FFT)
+void FFTProcessor::ReInitSlidingDFT(double sampleRate)
+{
+	mUseSlidingDFT = false;
+	if (mSettings.mSlidingDFT == false || mSettings.mEstimator != FFTSettings::ESTIMATOR_PERIODOGRAM)
+		return;
+
+	// the window has to be a sum of cosines so it can be applied in the frequency domain
+	const WindowFunction::EWindowFunction windowType = (mSettings.mApplyWindow == true ? mSettings.mWindowFunction.GetType() : WindowFunction::WINDOWFUNCTION_RECTANGULAR);
+	mNumCosineTerms = WindowFunction::GetCosineTerms(windowType, mCosineTerms);
+	if (mNumCosineTerms == 0)
+	{
+		LogDebug("FFTProcessor: sliding DFT does not support the '%s' window, falling back to the FFT.", WindowFunction::GetName(windowType));
+		return;
+	}
+
+	const uint32 numSamples = mSettings.mNumFFTSamples;
+	const uint32 numBins = numSamples / 2 + 1;
+
+	// the coherent gain of the periodic cosine window is its constant term
+	mWindowGain = mCosineTerms[0];
+
+	// output bin range
+	mOutputFirstBin = 0;
+	mOutputLastBin = numBins - 1;
+	if (mSettings.mMaxFrequency > 0.0 && sampleRate > 0.0)
+	{
+		const double binWidth = (sampleRate / 2.0) / (numBins - 1);
+		mOutputFirstBin = Min<uint32>( (uint32)Math::CeilD(Max(mSettings.mMinFrequency, 0.0) / binWidth), numBins - 1 );
+		mOutputLastBin = Min<uint32>( (uint32)Math::FloorD(mSettings.mMaxFrequency / binWidth), numBins - 1 );
+		if (mOutputLastBin < mOutputFirstBin)
+			mOutputLastBin = mOutputFirstBin;
+	}
+
+	// unwindowed bins required by the window convolution
+	mTrackedFirstBin = numBins - 1;
+	mTrackedLastBin = 0;
+	for (uint32 b=mOutputFirstBin; b<=mOutputLastBin; ++b)
+	{
+		for (uint32 k=0; k<mNumCosineTerms; ++k)
+		{
+			for (int32 sign=-1; sign<=1; sign+=2)
+			{
+				int32 index = ((int32)b + sign * (int32)k) % (int32)numSamples;
+				if (index < 0)
+					index += numSamples;
+				if (index > (int32)numSamples / 2)
+					index = numSamples - index;
+
+				mTrackedFirstBin = Min<uint32>(mTrackedFirstBin, index);
+				mTrackedLastBin = Max<uint32>(mTrackedLastBin, index);
+			}
+		}
+	}
+
+	// twiddle factors of the recursion
+	mSlidingBins.Resize(numBins);
+	mSlidingTwiddles.Resize(numBins);
+	for (uint32 k=0; k<numBins; ++k)
+	{
+		const double angle = 2.0 * Math::piD * k / (double)numSamples;
+		mSlidingBins[k] = Complex(0.0, 0.0);
+		mSlidingTwiddles[k] = Complex(Math::CosD(angle), Math::SinD(angle));
+	}
+
+	// start with an empty (zero) window
+	mHistory.Resize(numSamples);
+	for (uint32 i=0; i<numSamples; ++i)
+		mHistory[i] = 0.0;
+
+	mHistoryPos				= 0;
+	mNumHistorySamples		= 0;
+	mNumSamplesSinceResync	= 0;
+
+	mUseSlidingDFT = true;
+}
+
+
+// unwindowed bin of the full (two-sided) DFT; removing DC zeroes the 0Hz bin (it is the sum of the window)
+Complex FFTProcessor::GetSlidingBin(int32 index) const
+{
+	const int32 numSamples = mSettings.mNumFFTSamples;
+
+	index %= numSamples;
+	if (index < 0)
+		index += numSamples;
+
+	if (index == 0 && mSettings.mRemoveDC == true)
+		return Complex(0.0, 0.0);
+
+	// real input: the upper half mirrors the lower half
+	if (index > numSamples / 2)
+		return ComplexMath::Conjugate(mSlidingBins[numSamples - index]);
+
+	return mSlidingBins[index];
+}
+
+
+// recalculate the tracked bins exactly from the ring buffer
+void FFTProcessor::ResyncSlidingDFT()
+{
+	const uint32 numSamples = mSettings.mNumFFTSamples;
+
+	// unroll the ring buffer, oldest sample first
+	double* fftInput = mFFT.GetInput();
+	for (uint32 i=0; i<numSamples; ++i)
+		fftInput[i] = mHistory[(mHistoryPos + i) % numSamples];
+
+	mFFT.CalcFFT();
+
+	const Complex* fftOutput = mFFT.GetOutput();
+	for (uint32 k=mTrackedFirstBin; k<=mTrackedLastBin; ++k)
+		mSlidingBins[k] = fftOutput[k];
+
+	mNumSamplesSinceResync = 0;
+}
+
+
+// consume the new input samples one by one and output a spectrum every epoch shift samples
+void FFTProcessor::UpdateSlidingDFT()
+{
+	ChannelBase* inputChannel = GetInput();
+	ChannelReader* inputReader = GetInputReader();
+	Channel<Spectrum>* output = GetOutput()->AsType<Spectrum>();
+
+	const uint32 numSamples = mSettings.mNumFFTSamples;
+	const uint32 numBins = numSamples / 2 + 1;
+	const double scalingFactor = 1.0 / (numBins-1) / mWindowGain;
+
+	Complex* bins = mSlidingBins.GetPtr();
+	const Complex* twiddles = mSlidingTwiddles.GetReadPtr();
+
+	const uint32 numNewSamples = inputReader->GetNumNewSamples();
+	for (uint32 i=0; i<numNewSamples; ++i)
+	{
+		// 1) replace the oldest sample of the window
+		const uint64 sampleIndex = inputReader->GetOldestSampleIndex();
+		const double newSample = inputReader->PopOldestSample<double>();
+		const double oldSample = mHistory[mHistoryPos];
+		mHistory[mHistoryPos] = newSample;
+		mHistoryPos = (mHistoryPos + 1) % numSamples;
+		mNumHistorySamples++;
+
+		// 2) update the tracked bins
+		const double delta = newSample - oldSample;
+		for (uint32 k=mTrackedFirstBin; k<=mTrackedLastBin; ++k)
+			bins[k] = (bins[k] + delta) * twiddles[k];
+
+		if (++mNumSamplesSinceResync >= numSamples)
+			ResyncSlidingDFT();
+
+		// 3) output a spectrum every epoch shift samples, starting with the first sample (same epochs as the FFT path)
+		if ((mNumHistorySamples - 1) % mSettings.mEpochShift != 0)
+			continue;
+
+		Spectrum* spectrum = output->GetNextSampleRef();
+		spectrum->SetMaxFrequency(inputChannel->GetSampleRate() / 2.0);
+		spectrum->SetNumBins(numBins);
+
+		// incomplete windows are zeroed out completely, unless zero padding is enabled
+		const bool isZeroed = (mSettings.mUseZeroPadding == false && mNumHistorySamples < numSamples);
+
+		for (uint32 b=0; b<numBins; ++b)
+		{
+			if (isZeroed == true || b < mOutputFirstBin || b > mOutputLastBin)
+			{
+				spectrum->SetBin(b, Complex(0.0, 0.0));
+				continue;
+			}
+
+			// apply the window (convolution with the cosine terms)
+			Complex value = GetSlidingBin(b) * mCosineTerms[0];
+			for (uint32 k=1; k<mNumCosineTerms; ++k)
+			{
+				const Complex lower = GetSlidingBin((int32)b - (int32)k);
+				const Complex upper = GetSlidingBin((int32)b + (int32)k);
+				const double term = (k % 2 == 0 ? mCosineTerms[k] : -mCosineTerms[k]) * 0.5;
+				value += (lower + upper) * term;
+			}
+
+			// same scaling as the FFT path (DC bin is halved)
+			if (b == 0)
+				spectrum->SetBin(0, value.mReal / numBins / 2.0 / mWindowGain);
+			else
+				spectrum->SetBin(b, value * scalingFactor);
+		}
+
+		// time of the newest sample in the window (the epoch position)
+		spectrum->SetTime(inputChannel->GetSampleTime(sampleIndex).InSeconds());
+	}
+}
+
+
 uint32 FFTProcessor::GetDelay(uint32 inputPortIndex, uint32 outputPortIndex) const
 {
 	// zero padding reduces the delay to zero
 	if (mSettings.mUseZeroPadding == true)
 		return 0;
 	else
-		return mSettings.mNumFFTSamples;
+		return CalcEpochLength();
 
 }
@@ -43,7 +43,7 @@ class ENGINE_API FFTProcessor : public ChannelProcessor
 			public:
 				enum { TYPE_ID = 0x0016 };
 
-				FFTSettings()									{ mFFTOrder = 8; mUseZeroPadding = false; mEpochMode = ON; mEpochShift = 1; }
+				FFTSettings()									{ mFFTOrder = 8; mUseZeroPadding = false; mApplyWindow = false; mRemoveDC = false; mEpochMode = ON; mEpochShift = 1; mSlidingDFT = false; mMinFrequency = 0.0; mMaxFrequency = 0.0; mEstimator = ESTIMATOR_PERIODOGRAM; mNumSegments = 4; mTimeBandwidth = 2.5; }
 				virtual ~FFTSettings()							{}
 			
 				uint32 GetType() const override					{ return FFTProcessor::TYPE_ID; }
@@ -52,10 +52,23 @@ class ENGINE_API FFTProcessor : public ChannelProcessor
 				uint32			mNumFFTSamples;
 				WindowFunction	mWindowFunction;
 				bool			mUseZeroPadding;		// if false, incomplete epochs are zeroed out completely; otherwise it will be padded
+				bool			mApplyWindow;			// multiply the input with mWindowFunction; off = rectangular window (the behaviour of older graphs)
+				bool			mRemoveDC;				// subtract the mean of each epoch before windowing
 
 				enum EEpochMode { ON, OFF, CUSTOM };
 				EEpochMode		mEpochMode;
 				uint32			mEpochShift;
+
+				// sliding DFT: update the bins with every input sample instead of running an FFT per epoch (cosine-sum windows only, others fall back to the FFT)
+				bool			mSlidingDFT;
+				double			mMinFrequency;			// range of bins the sliding DFT calculates, all other bins are zero (max <= 0: all bins)
+				double			mMaxFrequency;
+
+				// spectral estimator: a single periodogram per epoch or an averaged PSD estimate (amplitude = square root of the averaged power)
+				enum EEstimator { ESTIMATOR_PERIODOGRAM, ESTIMATOR_WELCH, ESTIMATOR_MULTITAPER };
+				EEstimator		mEstimator;
+				uint32			mNumSegments;			// Welch: number of 50% overlapping windowed segments averaged per output spectrum
+				double			mTimeBandwidth;			// multitaper: time-bandwidth product NW (2NW-1 DPSS tapers are averaged)
 		};
 
 		// constructors & destructor
@@ -76,14 +89,21 @@ class ENGINE_API FFTProcessor : public ChannelProcessor
 		void SetFFTOrder(uint32 order)											{ mSettings.mFFTOrder = order; }
 		void SetEpochShift(uint32 shift)										{ mSettings.mEpochShift = shift; }
 		void SetUseZeroPadding(bool enable)										{ mSettings.mUseZeroPadding = enable; }
+		void SetApplyWindow(bool enable)										{ mSettings.mApplyWindow = enable; }
+		void SetRemoveDC(bool enable)											{ mSettings.mRemoveDC = enable; }
+		void SetSlidingDFT(bool enable, double minFrequency = 0.0, double maxFrequency = 0.0)	{ mSettings.mSlidingDFT = enable; mSettings.mMinFrequency = minFrequency; mSettings.mMaxFrequency = maxFrequency; }
+		bool IsSlidingDFT() const												{ return mUseSlidingDFT; }
+		void SetEstimator(FFTSettings::EEstimator estimator)					{ mSettings.mEstimator = estimator; }
+		void SetNumSegments(uint32 numSegments)									{ mSettings.mNumSegments = numSegments; }
+		void SetTimeBandwidth(double timeBandwidth)								{ mSettings.mTimeBandwidth = timeBandwidth; }
 
 		const WindowFunction& GetWindowFunction()								{ return mSettings.mWindowFunction; }
 	
 		// DSP related properties
 		uint32 GetDelay(uint32 inputPortIndex, uint32 outputPortIndex) const override;
-		double GetLatency(uint32 inputPortIndex, uint32 outputPortIndex) const override			{ return (mSettings.mNumFFTSamples / 2.0) / GetOutput()->GetSampleRate(); /* very coarse assumption (half epoch)*/ }
+		double GetLatency(uint32 inputPortIndex, uint32 outputPortIndex) const override			{ return (CalcEpochLength() / 2.0) / GetOutput()->GetSampleRate(); /* very coarse assumption (half epoch)*/ }
 		double GetSampleRatio(uint32 inputPortIndex, uint32 outputPortIndex) const override		{ return mSettings.mEpochShift - 1; }
-		uint32 GetNumEpochSamples(uint32 inputPortIndex) const override							{ return mSettings.mNumFFTSamples + mSettings.mEpochShift; }
+		uint32 GetNumEpochSamples(uint32 inputPortIndex) const override							{ return CalcEpochLength() + mSettings.mEpochShift; }
 
 	private:
 		// processor settins
@@ -91,6 +111,41 @@ class ENGINE_API FFTProcessor : public ChannelProcessor
 
 		// FFT
 		FFT					mFFT;
+
+		// precalculated window (shared table, NULL = rectangular) and its coherent gain
+		const double*		mWindowTable;
+		double				mWindowGain;
+
+		// number of input samples per output spectrum (Welch segments span more than one FFT length)
+		uint32 CalcEpochLength() const;
+
+		// averaged PSD estimate of one epoch (Welch / multitaper)
+		void CalcPSD(const Epoch& epoch, Spectrum* spectrum);
+
+		Core::Array<double>			mEpochSamples;
+		Core::Array<double>			mPowerSums;
+		const double*				mTapers;					// DPSS tapers (shared table), multitaper only
+		uint32						mNumTapers;
+
+		// sliding DFT
+		void ReInitSlidingDFT(double sampleRate);
+		void UpdateSlidingDFT();
+		void ResyncSlidingDFT();
+		inline Core::Complex GetSlidingBin(int32 index) const;
+
+		bool						mUseSlidingDFT;
+		Core::Array<double>			mHistory;					// ring buffer with the last N input samples
+		uint32						mHistoryPos;				// position of the oldest sample in the ring buffer
+		uint64						mNumHistorySamples;			// number of samples that went through the ring buffer
+		uint32						mNumSamplesSinceResync;
+		Core::Array<Core::Complex>	mSlidingBins;				// unwindowed DFT of the ring buffer (only the tracked range is updated)
+		Core::Array<Core::Complex>	mSlidingTwiddles;
+		uint32						mTrackedFirstBin;			// unwindowed bins required for the output range
+		uint32						mTrackedLastBin;
+		uint32						mOutputFirstBin;			// bins that are calculated
+		uint32						mOutputLastBin;
+		double						mCosineTerms[WindowFunction::MAX_COSINE_TERMS];
+		uint32						mNumCosineTerms;
 };
 
 
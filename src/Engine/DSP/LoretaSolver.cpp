@@ -0,0 +1,584 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "LoretaSolver.h"
+#include "../Core/Math.h"
+#include "../Core/LogManager.h"
+#include <thread>
+#include <float.h>
+
+
+using namespace Core;
+
+// number of lead field columns that are processed together in the gram matrix kernel (keeps the column block of all electrodes in cache)
+#define LORETASOLVER_COLUMNBLOCKSIZE	512
+
+// below this number of voxels per thread, the work is not split
+#define LORETASOLVER_MINVOXELSPERTHREAD	64
+
+
+// constructor
+LoretaSolver::LoretaSolver()
+{
+	mIsInitialized		= false;
+	mNumElectrodes		= 0;
+	mNumVoxels			= 0;
+	mElectrodeValues	= NULL;
+	mNumThreadsSetting	= 0;
+	mGeneration			= 0;
+	mNumPendingWorkers	= 0;
+	mJob				= JOB_SOLVE;
+	mShutdown			= false;
+}
+
+
+// destructor
+LoretaSolver::~LoretaSolver()
+{
+	DestroyWorkers();
+}
+
+
+// configure the number of threads; takes effect with the next Init()
+void LoretaSolver::SetNumThreads(uint32 numThreads)
+{
+	mNumThreadsSetting = numThreads;
+}
+
+
+void LoretaSolver::Clear()
+{
+	mIsInitialized = false;
+	mNumElectrodes = 0;
+	mNumVoxels = 0;
+
+	mLeadField.Clear();
+	mGramMatrix.Clear();
+	mGramInverse.Clear();
+	mInverseOperator.Clear();
+	mResolutionInverse.Clear();
+	mCurrentDensity.Clear();
+	mPower.Clear();
+}
+
+
+// precalculate everything that only depends on the electrode layout and the voxel grid
+bool LoretaSolver::Init(const Array<Vector3>& electrodePositions, const Array<Vector3>& voxelPositions, double conductivity, double regularization)
+{
+	Clear();
+
+	mNumElectrodes	= electrodePositions.Size();
+	mNumVoxels		= voxelPositions.Size();
+	if (mNumElectrodes == 0 || mNumVoxels == 0)
+		return false;
+
+	// (re)create the worker threads
+	uint32 numThreads = mNumThreadsSetting;
+	if (numThreads == 0)
+		numThreads = Max<uint32>(1, std::thread::hardware_concurrency());
+	if (mThreads.Size() != numThreads - 1)
+	{
+		DestroyWorkers();
+		StartWorkers(numThreads - 1);
+	}
+
+	// 1) lead field K
+	CalcLeadField(electrodePositions, voxelPositions, conductivity);
+
+	// 2) regularized gram matrix K*K^t + a*H and its pseudo-inverse
+	CalcRegularizedGramMatrix(regularization);
+	if (CalcPseudoInverse(mGramMatrix, mNumElectrodes, mGramInverse) == false)
+	{
+		LogError("LoretaSolver: could not invert the gram matrix.");
+		Clear();
+		return false;
+	}
+
+	// 3) inverse operator T = K^t * (K*K^t + a*H)^+ and the per-voxel resolution matrices
+	mInverseOperator.Resize(3 * mNumVoxels * mNumElectrodes);
+	mResolutionInverse.Resize(6 * mNumVoxels);
+	RunParallel(JOB_INVERSEOPERATOR);
+	RunParallel(JOB_RESOLUTION);
+
+	// the gram matrices are not needed anymore
+	mGramMatrix.Clear();
+
+	// allocate the results
+	mCurrentDensity.Resize(3 * mNumVoxels);
+	mCurrentDensity.SetAll(0.0);
+	mPower.Resize(mNumVoxels);
+	mPower.SetAll(0.0);
+
+	mIsInitialized = true;
+	return true;
+}
+
+
+// calculate one frame
+void LoretaSolver::Solve(const double* electrodeValues)
+{
+	if (mIsInitialized == false)
+		return;
+
+	mElectrodeValues = electrodeValues;
+	RunParallel(JOB_SOLVE);
+	mElectrodeValues = NULL;
+}
+
+
+//-----------------------------------------------
+// matrix kernels
+//-----------------------------------------------
+
+// the lead field of a dipole in an infinite homogenous medium: K_ev = (r_e - r_v) / (4*pi*sigma*|r_e - r_v|^3)
+void LoretaSolver::CalcLeadField(const Array<Vector3>& electrodePositions, const Array<Vector3>& voxelPositions, double conductivity)
+{
+	const uint32 numColumns = 3 * mNumVoxels;
+	mLeadField.Resize(mNumElectrodes * numColumns);
+
+	// fall back to a conductivity of 1 if none was specified
+	const double scale = 1.0 / (4.0 * Math::piD * (conductivity > 0.0 ? conductivity : 1.0));
+
+	for (uint32 e=0; e<mNumElectrodes; ++e)
+	{
+		const Vector3& electrode = electrodePositions[e];
+		double* row = mLeadField.GetPtr() + e * numColumns;
+
+		for (uint32 v=0; v<mNumVoxels; ++v)
+		{
+			// subtract in double precision, a float difference costs the lead field about half of its significant digits
+			const double dx = (double)electrode.x - voxelPositions[v].x;
+			const double dy = (double)electrode.y - voxelPositions[v].y;
+			const double dz = (double)electrode.z - voxelPositions[v].z;
+			const double distance = Math::SqrtD(dx*dx + dy*dy + dz*dz);
+			const double factor = (distance > 0.0 ? scale / (distance * distance * distance) : 0.0);
+
+			row[3*v + 0] = dx * factor;
+			row[3*v + 1] = dy * factor;
+			row[3*v + 2] = dz * factor;
+		}
+	}
+}
+
+
+// K*K^t + a*H, where H is the average reference (centering) matrix; only the upper triangle is calculated (the matrix is symmetric)
+void LoretaSolver::CalcRegularizedGramMatrix(double regularization)
+{
+	const uint32 n = mNumElectrodes;
+	const uint32 numColumns = 3 * mNumVoxels;
+	const double* leadField = mLeadField.GetReadPtr();
+
+	mGramMatrix.Resize(n * n);
+	mGramMatrix.SetAll(0.0);
+	double* gram = mGramMatrix.GetPtr();
+
+	// cache-blocked over the (long) voxel dimension
+	for (uint32 blockStart=0; blockStart<numColumns; blockStart+=LORETASOLVER_COLUMNBLOCKSIZE)
+	{
+		const uint32 blockLength = Min<uint32>(LORETASOLVER_COLUMNBLOCKSIZE, numColumns - blockStart);
+		for (uint32 i=0; i<n; ++i)
+		{
+			const double* rowI = leadField + i * numColumns + blockStart;
+			for (uint32 j=i; j<n; ++j)
+			{
+				const double* rowJ = leadField + j * numColumns + blockStart;
+
+				double sum = 0.0;
+				for (uint32 c=0; c<blockLength; ++c)
+					sum += rowI[c] * rowJ[c];
+
+				gram[i * n + j] += sum;
+			}
+		}
+	}
+
+	// mirror and add regularization
+	const double invN = 1.0 / (double)n;
+	for (uint32 i=0; i<n; ++i)
+	{
+		for (uint32 j=i; j<n; ++j)
+		{
+			const double centering = (i == j ? 1.0 : 0.0) - invN;
+			gram[i * n + j] += regularization * centering;
+			gram[j * n + i] = gram[i * n + j];
+		}
+	}
+}
+
+
+// pseudo-inverse of a symmetric matrix via cyclic jacobi eigenvalue decomposition (same result as an SVD based pseudo-inverse)
+bool LoretaSolver::CalcPseudoInverse(const Array<double>& matrix, uint32 n, Array<double>& outInverse)
+{
+	Array<double> a = matrix;
+	Array<double> v(n * n);
+	v.SetAll(0.0);
+	for (uint32 i=0; i<n; ++i)
+		v[i * n + i] = 1.0;
+
+	double norm = 0.0;
+	for (uint32 i=0; i<n*n; ++i)
+		norm += a[i] * a[i];
+	if (norm == 0.0 || Math::IsValidNumberD(norm) == false)
+		return false;
+
+	const uint32 maxNumSweeps = 64;
+	for (uint32 sweep=0; sweep<maxNumSweeps; ++sweep)
+	{
+		// sum of the squared off-diagonal elements
+		double offDiagonal = 0.0;
+		for (uint32 p=0; p<n; ++p)
+			for (uint32 q=p+1; q<n; ++q)
+				offDiagonal += a[p * n + q] * a[p * n + q];
+
+		if (offDiagonal <= norm * DBL_EPSILON * DBL_EPSILON)
+			break;
+
+		for (uint32 p=0; p<n; ++p)
+		{
+			for (uint32 q=p+1; q<n; ++q)
+			{
+				const double apq = a[p * n + q];
+				if (apq == 0.0)
+					continue;
+
+				// rotation angle that zeros a_pq
+				const double theta = (a[q * n + q] - a[p * n + p]) / (2.0 * apq);
+				const double t = (theta >= 0.0 ? 1.0 : -1.0) / (Math::AbsD(theta) + Math::SqrtD(theta * theta + 1.0));
+				const double c = 1.0 / Math::SqrtD(t * t + 1.0);
+				const double s = t * c;
+
+				// A = J^t * A * J
+				for (uint32 k=0; k<n; ++k)
+				{
+					const double akp = a[k * n + p];
+					const double akq = a[k * n + q];
+					a[k * n + p] = c * akp - s * akq;
+					a[k * n + q] = s * akp + c * akq;
+				}
+				for (uint32 k=0; k<n; ++k)
+				{
+					const double apk = a[p * n + k];
+					const double aqk = a[q * n + k];
+					a[p * n + k] = c * apk - s * aqk;
+					a[q * n + k] = s * apk + c * aqk;
+				}
+
+				// V = V * J
+				for (uint32 k=0; k<n; ++k)
+				{
+					const double vkp = v[k * n + p];
+					const double vkq = v[k * n + q];
+					v[k * n + p] = c * vkp - s * vkq;
+					v[k * n + q] = s * vkp + c * vkq;
+				}
+			}
+		}
+	}
+
+	// invert the eigenvalues, dropping the ones that are numerically zero
+	double maxEigenvalue = 0.0;
+	for (uint32 i=0; i<n; ++i)
+		maxEigenvalue = Max<double>(maxEigenvalue, Math::AbsD(a[i * n + i]));
+
+	const double tolerance = maxEigenvalue * n * DBL_EPSILON;
+	Array<double> invEigenvalues(n);
+	for (uint32 i=0; i<n; ++i)
+	{
+		const double eigenvalue = a[i * n + i];
+		invEigenvalues[i] = (Math::AbsD(eigenvalue) > tolerance ? 1.0 / eigenvalue : 0.0);
+	}
+
+	// A^+ = V * D^-1 * V^t
+	outInverse.Resize(n * n);
+	for (uint32 i=0; i<n; ++i)
+	{
+		for (uint32 j=i; j<n; ++j)
+		{
+			double sum = 0.0;
+			for (uint32 k=0; k<n; ++k)
+				sum += v[i * n + k] * invEigenvalues[k] * v[j * n + k];
+
+			outInverse[i * n + j] = sum;
+			outInverse[j * n + i] = sum;
+		}
+	}
+
+	return true;
+}
+
+
+// T_v = K_v^t * G^+ for the voxels in the given range (three rows of T per voxel)
+void LoretaSolver::CalcInverseOperator(uint32 firstVoxel, uint32 lastVoxel)
+{
+	const uint32 n = mNumElectrodes;
+	const uint32 numColumns = 3 * mNumVoxels;
+	const double* leadField = mLeadField.GetReadPtr();
+	const double* gramInverse = mGramInverse.GetReadPtr();
+
+	for (uint32 v=firstVoxel; v<lastVoxel; ++v)
+	{
+		double* rowX = mInverseOperator.GetPtr() + (3*v + 0) * n;
+		double* rowY = mInverseOperator.GetPtr() + (3*v + 1) * n;
+		double* rowZ = mInverseOperator.GetPtr() + (3*v + 2) * n;
+
+		for (uint32 j=0; j<n; ++j)
+		{
+			rowX[j] = 0.0;
+			rowY[j] = 0.0;
+			rowZ[j] = 0.0;
+		}
+
+		// one pass over G^+ per voxel, accumulating all three rows at once
+		for (uint32 k=0; k<n; ++k)
+		{
+			const double kx = leadField[k * numColumns + 3*v + 0];
+			const double ky = leadField[k * numColumns + 3*v + 1];
+			const double kz = leadField[k * numColumns + 3*v + 2];
+			const double* gramRow = gramInverse + k * n;
+
+			for (uint32 j=0; j<n; ++j)
+			{
+				rowX[j] += kx * gramRow[j];
+				rowY[j] += ky * gramRow[j];
+				rowZ[j] += kz * gramRow[j];
+			}
+		}
+	}
+}
+
+
+// (T_v * K_v)^-1 for the voxels in the given range; the 3x3 matrix is symmetric, so only its upper triangle is stored
+void LoretaSolver::CalcResolutionMatrices(uint32 firstVoxel, uint32 lastVoxel)
+{
+	const uint32 n = mNumElectrodes;
+	const uint32 numColumns = 3 * mNumVoxels;
+	const double* leadField = mLeadField.GetReadPtr();
+
+	for (uint32 v=firstVoxel; v<lastVoxel; ++v)
+	{
+		// S_v = T_v * K_v
+		double s[3][3];
+		for (uint32 r=0; r<3; ++r)
+		{
+			const double* rowT = mInverseOperator.GetReadPtr() + (3*v + r) * n;
+			for (uint32 c=0; c<3; ++c)
+			{
+				double sum = 0.0;
+				for (uint32 k=0; k<n; ++k)
+					sum += rowT[k] * leadField[k * numColumns + 3*v + c];
+				s[r][c] = sum;
+			}
+		}
+
+		// symmetrize to get rid of rounding differences
+		const double a = s[0][0];
+		const double b = 0.5 * (s[0][1] + s[1][0]);
+		const double c = 0.5 * (s[0][2] + s[2][0]);
+		const double d = s[1][1];
+		const double e = 0.5 * (s[1][2] + s[2][1]);
+		const double f = s[2][2];
+
+		// inverse via the adjugate
+		const double cofA = d*f - e*e;
+		const double cofB = c*e - b*f;
+		const double cofC = b*e - c*d;
+		const double cofD = a*f - c*c;
+		const double cofE = b*c - a*e;
+		const double cofF = a*d - b*b;
+		const double determinant = a*cofA + b*cofB + c*cofC;
+
+		double* result = mResolutionInverse.GetPtr() + 6*v;
+		if (Math::AbsD(determinant) <= DBL_MIN || Math::IsValidNumberD(determinant) == false)
+		{
+			for (uint32 i=0; i<6; ++i)
+				result[i] = 0.0;
+			continue;
+		}
+
+		const double invDeterminant = 1.0 / determinant;
+		result[0] = cofA * invDeterminant;
+		result[1] = cofB * invDeterminant;
+		result[2] = cofC * invDeterminant;
+		result[3] = cofD * invDeterminant;
+		result[4] = cofE * invDeterminant;
+		result[5] = cofF * invDeterminant;
+	}
+}
+
+
+// J_v = T_v * phi and the standardized power J_v^t * (T_v * K_v)^-1 * J_v
+void LoretaSolver::CalcSolution(uint32 firstVoxel, uint32 lastVoxel)
+{
+	const uint32 n = mNumElectrodes;
+	const double* phi = mElectrodeValues;
+	const double* inverseOperator = mInverseOperator.GetReadPtr();
+
+	for (uint32 v=firstVoxel; v<lastVoxel; ++v)
+	{
+		const double* rowX = inverseOperator + (3*v + 0) * n;
+		const double* rowY = inverseOperator + (3*v + 1) * n;
+		const double* rowZ = inverseOperator + (3*v + 2) * n;
+
+		double jx = 0.0, jy = 0.0, jz = 0.0;
+		for (uint32 k=0; k<n; ++k)
+		{
+			jx += rowX[k] * phi[k];
+			jy += rowY[k] * phi[k];
+			jz += rowZ[k] * phi[k];
+		}
+
+		mCurrentDensity[3*v + 0] = jx;
+		mCurrentDensity[3*v + 1] = jy;
+		mCurrentDensity[3*v + 2] = jz;
+
+		const double* m = mResolutionInverse.GetReadPtr() + 6*v;
+		mPower[v] = m[0]*jx*jx + m[3]*jy*jy + m[5]*jz*jz + 2.0 * (m[1]*jx*jy + m[2]*jx*jz + m[4]*jy*jz);
+	}
+}
+
+
+//-----------------------------------------------
+// threading
+//-----------------------------------------------
+
+// split the voxels evenly into slices
+void LoretaSolver::CalcVoxelRange(uint32 sliceIndex, uint32 numSlices, uint32* outFirstVoxel, uint32* outLastVoxel) const
+{
+	*outFirstVoxel	= (uint32)(((uint64)mNumVoxels * sliceIndex) / numSlices);
+	*outLastVoxel	= (uint32)(((uint64)mNumVoxels * (sliceIndex + 1)) / numSlices);
+}
+
+
+void LoretaSolver::RunJob(EJob job, uint32 firstVoxel, uint32 lastVoxel)
+{
+	switch (job)
+	{
+		case JOB_INVERSEOPERATOR:	{ CalcInverseOperator(firstVoxel, lastVoxel); }		break;
+		case JOB_RESOLUTION:		{ CalcResolutionMatrices(firstVoxel, lastVoxel); }	break;
+		case JOB_SOLVE:				{ CalcSolution(firstVoxel, lastVoxel); }			break;
+	}
+}
+
+
+// run a job on all threads; the calling thread processes the last slice and waits for the workers to finish theirs
+void LoretaSolver::RunParallel(EJob job)
+{
+	const uint32 numWorkers = mThreads.Size();
+	if (numWorkers == 0 || mNumVoxels < LORETASOLVER_MINVOXELSPERTHREAD * (numWorkers + 1))
+	{
+		RunJob(job, 0, mNumVoxels);
+		return;
+	}
+
+	// wake up the workers
+	{
+		std::unique_lock<std::mutex> lock(mWorkLock);
+		mJob = job;
+		mNumPendingWorkers = numWorkers;
+		mGeneration++;
+	}
+	mWorkCondition.notify_all();
+
+	// process own slice
+	uint32 firstVoxel, lastVoxel;
+	CalcVoxelRange(numWorkers, numWorkers + 1, &firstVoxel, &lastVoxel);
+	RunJob(job, firstVoxel, lastVoxel);
+
+	// wait for the workers
+	std::unique_lock<std::mutex> lock(mWorkLock);
+	mDoneCondition.wait(lock, [this] { return mNumPendingWorkers == 0; });
+}
+
+
+void LoretaSolver::WorkerLoop(uint32 sliceIndex)
+{
+	uint64 lastGeneration = 0;
+	while (true)
+	{
+		EJob job;
+		{
+			std::unique_lock<std::mutex> lock(mWorkLock);
+			mWorkCondition.wait(lock, [this, lastGeneration] { return mShutdown == true || mGeneration != lastGeneration; });
+			if (mShutdown == true)
+				return;
+
+			lastGeneration = mGeneration;
+			job = mJob;
+		}
+
+		uint32 firstVoxel, lastVoxel;
+		CalcVoxelRange(sliceIndex, mThreads.Size() + 1, &firstVoxel, &lastVoxel);
+		RunJob(job, firstVoxel, lastVoxel);
+
+		{
+			std::unique_lock<std::mutex> lock(mWorkLock);
+			mNumPendingWorkers--;
+			if (mNumPendingWorkers == 0)
+				mDoneCondition.notify_one();
+		}
+	}
+}
+
+
+void LoretaSolver::StartWorkers(uint32 numWorkers)
+{
+	// NOTE: workers start at generation zero, so no job may be pending at this point
+	mShutdown = false;
+	mGeneration = 0;
+	mNumPendingWorkers = 0;
+
+	for (uint32 i=0; i<numWorkers; ++i)
+	{
+		Thread* thread = new Thread(new Worker(this, i), "LoretaSolver");
+		mThreads.Add(thread);
+	}
+
+	// start them only after the thread array is complete (workers use its size)
+	for (uint32 i=0; i<numWorkers; ++i)
+		mThreads[i]->Start();
+}
+
+
+void LoretaSolver::StopWorkers()
+{
+	{
+		std::unique_lock<std::mutex> lock(mWorkLock);
+		mShutdown = true;
+	}
+	mWorkCondition.notify_all();
+}
+
+
+void LoretaSolver::DestroyWorkers()
+{
+	StopWorkers();
+
+	// deleting the thread waits for it to finish and deletes the worker
+	const uint32 numThreads = mThreads.Size();
+	for (uint32 i=0; i<numThreads; ++i)
+		delete mThreads[i];
+	mThreads.Clear();
+
+	mShutdown = false;
+}
@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_LORETASOLVER_H
+#define __NEUROMORE_LORETASOLVER_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+#include "../Core/Vector.h"
+#include "../Core/Thread.h"
+#include <mutex>
+#include <condition_variable>
+
+
+// sLORETA source localization solver
+//  - Init() builds the lead field K for one electrode layout and precalculates the inverse operator T = K^t * (K*K^t + a*H)^+
+//    and the inverted 3x3 voxel resolution matrices (T_v * K_v)^-1
+//  - Solve() is then a single matrix-vector product J = T * phi and one 3x3 quadratic form per voxel
+//  - all voxel-wise work is split over a small pool of worker threads
+class ENGINE_API LoretaSolver
+{
+	public:
+		// constructor & destructor
+		LoretaSolver();
+		virtual ~LoretaSolver();
+
+		// number of threads (including the calling thread) used by Init() and Solve(); 0 = use all cores
+		void SetNumThreads(uint32 numThreads);
+		uint32 GetNumThreads() const											{ return mThreads.Size() + 1; }
+
+		// precalculate all matrices for the given electrode and voxel positions (call this once per electrode layout)
+		bool Init(const Core::Array<Core::Vector3>& electrodePositions, const Core::Array<Core::Vector3>& voxelPositions, double conductivity, double regularization);
+		void Clear();
+		bool IsInitialized() const												{ return mIsInitialized; }
+
+		uint32 GetNumElectrodes() const											{ return mNumElectrodes; }
+		uint32 GetNumVoxels() const												{ return mNumVoxels; }
+
+		// calculate the current density and the standardized power of all voxels for one frame of electrode values (numElectrodes values)
+		void Solve(const double* electrodeValues);
+
+		// results of the last Solve(): 3 values (x,y,z) per voxel and one power value per voxel
+		const double* GetCurrentDensity() const									{ return mCurrentDensity.GetReadPtr(); }
+		const double* GetPower() const											{ return mPower.GetReadPtr(); }
+
+	private:
+		// the jobs that are split over the voxels
+		enum EJob
+		{
+			JOB_INVERSEOPERATOR,
+			JOB_RESOLUTION,
+			JOB_SOLVE
+		};
+
+		void RunParallel(EJob job);
+		void RunJob(EJob job, uint32 firstVoxel, uint32 lastVoxel);
+		void CalcVoxelRange(uint32 sliceIndex, uint32 numSlices, uint32* outFirstVoxel, uint32* outLastVoxel) const;
+
+		// matrix kernels
+		void CalcLeadField(const Core::Array<Core::Vector3>& electrodePositions, const Core::Array<Core::Vector3>& voxelPositions, double conductivity);
+		void CalcRegularizedGramMatrix(double regularization);
+		bool CalcPseudoInverse(const Core::Array<double>& matrix, uint32 size, Core::Array<double>& outInverse);
+		void CalcInverseOperator(uint32 firstVoxel, uint32 lastVoxel);
+		void CalcResolutionMatrices(uint32 firstVoxel, uint32 lastVoxel);
+		void CalcSolution(uint32 firstVoxel, uint32 lastVoxel);
+
+		bool					mIsInitialized;
+		uint32					mNumElectrodes;
+		uint32					mNumVoxels;
+
+		Core::Array<double>		mLeadField;				// K: numElectrodes x 3*numVoxels (row-major)
+		Core::Array<double>		mGramMatrix;			// K*K^t + a*H: numElectrodes x numElectrodes
+		Core::Array<double>		mGramInverse;			// pseudo-inverse of the gram matrix
+		Core::Array<double>		mInverseOperator;		// T: 3*numVoxels x numElectrodes (row-major)
+		Core::Array<double>		mResolutionInverse;		// (T_v*K_v)^-1: 6 values per voxel (upper triangle of the symmetric 3x3 matrix)
+
+		const double*			mElectrodeValues;		// input of the current Solve() call
+		Core::Array<double>		mCurrentDensity;		// J = T*phi: 3 values per voxel
+		Core::Array<double>		mPower;					// J_v^t * (T_v*K_v)^-1 * J_v: one value per voxel
+
+		// worker threads
+		class Worker : public Core::ThreadHandler
+		{
+			public:
+				Worker(LoretaSolver* solver, uint32 sliceIndex) : Core::ThreadHandler()		{ mSolver = solver; mSliceIndex = sliceIndex; mIsFinished = false; }
+				void Execute() override														{ mSolver->WorkerLoop(mSliceIndex); mIsFinished = true; }
+				void Terminate() override													{ mSolver->StopWorkers(); }
+			private:
+				LoretaSolver*	mSolver;
+				uint32			mSliceIndex;
+		};
+
+		void WorkerLoop(uint32 sliceIndex);
+		void StartWorkers(uint32 numWorkers);
+		void StopWorkers();
+		void DestroyWorkers();
+
+		Core::Array<Core::Thread*>	mThreads;
+		uint32						mNumThreadsSetting;
+		std::mutex					mWorkLock;
+		std::condition_variable		mWorkCondition;
+		std::condition_variable		mDoneCondition;
+		uint64						mGeneration;
+		uint32						mNumPendingWorkers;
+		EJob						mJob;
+		bool						mShutdown;
+};
+
+
+#endif
@@ -132,6 +132,22 @@ void MultiChannelReader::Start(const Time& time)
 
 
 
+// copy the oldest numSamples samples of every channel into one contiguous tile, so consumers can process them in blocks
+uint32 MultiChannelReader::PopOldestSamples(uint32 numSamples, Array<double>& outTile)
+{
+	const uint32 numChannels = mChannelReaders.Size();
+	const uint32 stride = CalcTileStride(numSamples);
+	
+	// only grows, so the tile memory is reused across updates
+	outTile.Resize(numChannels * stride);
+
+	for (uint32 i = 0; i<numChannels; ++i)
+		mChannelReaders[i].PopOldestSamples<double>(outTile.GetPtr() + i * stride, numSamples);
+
+	return stride;
+}
+
+
 // mark x new samples in all readers as processed
 void MultiChannelReader::Advance(uint32 numSamples)
 {
@@ -77,6 +77,11 @@ class ENGINE_API MultiChannelReader
 		// get number of samples that can be read from all channels
 		uint32 GetMinNumNewSamples() const;
 
+		// bulk read: copy the next numSamples new samples of all channels into a channel-major tile and mark them as processed
+		// NOTE: row c (channel c) starts at outTile[c * stride]; rows are padded to the returned stride
+		uint32 PopOldestSamples(uint32 numSamples, Core::Array<double>& outTile);
+		static uint32 CalcTileStride(uint32 numSamples)						{ return (numSamples + 3) & ~3; }
+
 		// advance the channel readers (separately or all together)
 		void Advance(uint32 numSamples);
 		void Flush(bool independent = false);
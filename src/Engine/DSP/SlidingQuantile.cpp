@@ -0,0 +1,314 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "SlidingQuantile.h"
+#include "../Core/Math.h"
+
+
+using namespace Core;
+
+// constructor
+SlidingQuantile::SlidingQuantile()
+{
+	mWindowSize		= 0;
+	mNumValues		= 0;
+	mWindowStart	= 0;
+	mRoot			= CORE_INVALIDINDEX32;
+	mSequence		= 0;
+	mRandomState	= 0x9E3779B9;
+}
+
+
+// destructor
+SlidingQuantile::~SlidingQuantile()
+{
+}
+
+
+void SlidingQuantile::Init(uint32 windowSize)
+{
+	mWindowSize = windowSize;
+	mNodes.Resize(windowSize);
+	mWindow.Resize(windowSize);
+	Clear();
+}
+
+
+void SlidingQuantile::Clear()
+{
+	mNumValues		= 0;
+	mWindowStart	= 0;
+	mRoot			= CORE_INVALIDINDEX32;
+	mSequence		= 0;
+
+	// each ring buffer slot owns one node of the pool
+	for (uint32 i=0; i<mWindowSize; ++i)
+		mWindow[i] = i;
+}
+
+
+void SlidingQuantile::AddValue(double value)
+{
+	if (mWindowSize == 0)
+		return;
+
+	// NaN and infinity have no rank (NaN compares false both ways and would break the tree order), they neither enter nor advance the window
+	if (Math::IsValidNumberD(value) == false)
+		return;
+
+	// window full: expire the oldest value and reuse its node
+	uint32 slot;
+	if (mNumValues == mWindowSize)
+	{
+		slot = mWindowStart;
+		mRoot = Erase(mRoot, mWindow[slot]);
+		mWindowStart = (mWindowStart + 1) % mWindowSize;
+		mNumValues--;
+	}
+	else
+	{
+		slot = (mWindowStart + mNumValues) % mWindowSize;
+	}
+
+	const uint32 index = mWindow[slot];
+	Node& node		= mNodes[index];
+	node.mValue		= value;
+	node.mSequence	= mSequence++;
+	node.mPriority	= NextPriority();
+	node.mLeft		= CORE_INVALIDINDEX32;
+	node.mRight		= CORE_INVALIDINDEX32;
+	node.mSize		= 1;
+	node.mSum		= value;
+
+	// insert the node between the smaller and the larger values
+	uint32 left, right;
+	Split(mRoot, index, &left, &right);
+	mRoot = Merge(Merge(left, index), right);
+
+	mNumValues++;
+}
+
+
+double SlidingQuantile::GetValue(uint32 rank) const
+{
+	if (rank >= mNumValues)
+		return 0.0;
+
+	uint32 node = mRoot;
+	while (node != CORE_INVALIDINDEX32)
+	{
+		const uint32 leftSize = GetSize(mNodes[node].mLeft);
+		if (rank < leftSize)
+		{
+			node = mNodes[node].mLeft;
+		}
+		else if (rank == leftSize)
+		{
+			return mNodes[node].mValue;
+		}
+		else
+		{
+			rank -= leftSize + 1;
+			node = mNodes[node].mRight;
+		}
+	}
+
+	return 0.0;
+}
+
+
+double SlidingQuantile::CalcSum(uint32 numValues) const
+{
+	double sum = 0.0;
+	uint32 node = mRoot;
+	while (node != CORE_INVALIDINDEX32 && numValues > 0)
+	{
+		const Node& current = mNodes[node];
+		const uint32 leftSize = GetSize(current.mLeft);
+		if (numValues <= leftSize)
+		{
+			node = current.mLeft;
+		}
+		else
+		{
+			sum += GetSum(current.mLeft) + current.mValue;
+			numValues -= leftSize + 1;
+			node = current.mRight;
+		}
+	}
+
+	return sum;
+}
+
+
+uint32 SlidingQuantile::CountLess(double value) const
+{
+	uint32 count = 0;
+	uint32 node = mRoot;
+	while (node != CORE_INVALIDINDEX32)
+	{
+		const Node& current = mNodes[node];
+		if (current.mValue < value)
+		{
+			count += GetSize(current.mLeft) + 1;
+			node = current.mRight;
+		}
+		else
+		{
+			node = current.mLeft;
+		}
+	}
+
+	return count;
+}
+
+
+uint32 SlidingQuantile::CountLessEqual(double value) const
+{
+	uint32 count = 0;
+	uint32 node = mRoot;
+	while (node != CORE_INVALIDINDEX32)
+	{
+		const Node& current = mNodes[node];
+		if (current.mValue <= value)
+		{
+			count += GetSize(current.mLeft) + 1;
+			node = current.mRight;
+		}
+		else
+		{
+			node = current.mLeft;
+		}
+	}
+
+	return count;
+}
+
+
+double SlidingQuantile::CalcQuantile(double quantile) const
+{
+	if (mNumValues == 0)
+		return 0.0;
+
+	quantile = Clamp<double>(quantile, 0.0, 1.0);
+
+	const double position = quantile * (mNumValues - 1);
+	const uint32 lowerRank = (uint32)position;
+	const double fraction = position - lowerRank;
+
+	const double lowerValue = GetValue(lowerRank);
+	if (fraction == 0.0 || lowerRank + 1 >= mNumValues)
+		return lowerValue;
+
+	return lowerValue + fraction * (GetValue(lowerRank + 1) - lowerValue);
+}
+
+
+//-----------------------------------------------
+// treap operations
+//-----------------------------------------------
+
+void SlidingQuantile::UpdateNode(uint32 index)
+{
+	Node& node = mNodes[index];
+	node.mSize = GetSize(node.mLeft) + GetSize(node.mRight) + 1;
+	node.mSum = GetSum(node.mLeft) + GetSum(node.mRight) + node.mValue;
+}
+
+
+// merge two trees, all keys of the left tree must be smaller than the ones of the right tree
+uint32 SlidingQuantile::Merge(uint32 left, uint32 right)
+{
+	if (left == CORE_INVALIDINDEX32)
+		return right;
+	if (right == CORE_INVALIDINDEX32)
+		return left;
+
+	if (mNodes[left].mPriority > mNodes[right].mPriority)
+	{
+		mNodes[left].mRight = Merge(mNodes[left].mRight, right);
+		UpdateNode(left);
+		return left;
+	}
+	else
+	{
+		mNodes[right].mLeft = Merge(left, mNodes[right].mLeft);
+		UpdateNode(right);
+		return right;
+	}
+}
+
+
+// split a tree into the nodes with a key smaller than the key node and the rest
+void SlidingQuantile::Split(uint32 node, uint32 keyNode, uint32* outLeft, uint32* outRight)
+{
+	if (node == CORE_INVALIDINDEX32)
+	{
+		*outLeft = CORE_INVALIDINDEX32;
+		*outRight = CORE_INVALIDINDEX32;
+		return;
+	}
+
+	if (IsLess(mNodes[node], mNodes[keyNode]) == true)
+	{
+		Split(mNodes[node].mRight, keyNode, &mNodes[node].mRight, outRight);
+		*outLeft = node;
+	}
+	else
+	{
+		Split(mNodes[node].mLeft, keyNode, outLeft, &mNodes[node].mLeft);
+		*outRight = node;
+	}
+
+	UpdateNode(node);
+}
+
+
+// remove the key node from the tree and return the new root
+uint32 SlidingQuantile::Erase(uint32 node, uint32 keyNode)
+{
+	if (node == CORE_INVALIDINDEX32)
+		return CORE_INVALIDINDEX32;
+
+	if (node == keyNode)
+		return Merge(mNodes[node].mLeft, mNodes[node].mRight);
+
+	if (IsLess(mNodes[keyNode], mNodes[node]) == true)
+		mNodes[node].mLeft = Erase(mNodes[node].mLeft, keyNode);
+	else
+		mNodes[node].mRight = Erase(mNodes[node].mRight, keyNode);
+
+	UpdateNode(node);
+	return node;
+}
+
+
+// xorshift32
+uint32 SlidingQuantile::NextPriority()
+{
+	mRandomState ^= mRandomState << 13;
+	mRandomState ^= mRandomState >> 17;
+	mRandomState ^= mRandomState << 5;
+	return mRandomState;
+}
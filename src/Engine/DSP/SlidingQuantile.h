@@ -0,0 +1,104 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_SLIDINGQUANTILE_H
+#define __NEUROMORE_SLIDINGQUANTILE_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+
+
+// order statistics over the last N values of a stream
+//  - the values of the window are kept sorted in a treap (randomized balanced binary tree) that stores the size and the sum of each subtree
+//  - adding a value and expiring the oldest one are O(log N), rank, quantile and partial sum queries too
+//  - unlike a histogram, there is no value range to maintain and nothing has to be rebuilt when the signal drifts
+class ENGINE_API SlidingQuantile
+{
+	public:
+		// constructor & destructor
+		SlidingQuantile();
+		~SlidingQuantile();
+
+		// set the window size (clears all values)
+		void Init(uint32 windowSize);
+		void Clear();
+
+		// add a value; once the window is full, the oldest value is removed (non-finite values are ignored)
+		void AddValue(double value);
+
+		uint32 GetWindowSize() const									{ return mWindowSize; }
+		uint32 GetNumValues() const										{ return mNumValues; }
+
+		// smallest/largest value in the window (0 if the window is empty)
+		double GetMinValue() const										{ return (mNumValues > 0 ? GetValue(0) : 0.0); }
+		double GetMaxValue() const										{ return (mNumValues > 0 ? GetValue(mNumValues - 1) : 0.0); }
+
+		// value with the given rank (0 = smallest)
+		double GetValue(uint32 rank) const;
+
+		// sum of the numValues smallest values
+		double CalcSum(uint32 numValues) const;
+
+		// number of values that are smaller (or equal) than the given value
+		uint32 CountLess(double value) const;
+		uint32 CountLessEqual(double value) const;
+
+		// quantile (0..1) with linear interpolation between the closest ranks
+		double CalcQuantile(double quantile) const;
+
+	private:
+		struct Node
+		{
+			double		mValue;
+			uint64		mSequence;		// insertion counter, makes the keys unique if values are equal
+			uint32		mPriority;
+			uint32		mLeft;
+			uint32		mRight;
+			uint32		mSize;			// number of nodes in the subtree
+			double		mSum;			// sum of the values in the subtree
+		};
+
+		inline bool IsLess(const Node& a, const Node& b) const			{ return (a.mValue < b.mValue || (a.mValue == b.mValue && a.mSequence < b.mSequence)); }
+		inline uint32 GetSize(uint32 node) const						{ return (node != CORE_INVALIDINDEX32 ? mNodes[node].mSize : 0); }
+		inline double GetSum(uint32 node) const							{ return (node != CORE_INVALIDINDEX32 ? mNodes[node].mSum : 0.0); }
+
+		void UpdateNode(uint32 node);
+		uint32 Merge(uint32 left, uint32 right);
+		void Split(uint32 node, uint32 keyNode, uint32* outLeft, uint32* outRight);
+		uint32 Erase(uint32 node, uint32 keyNode);
+		uint32 NextPriority();
+
+		Core::Array<Node>		mNodes;			// node pool (windowSize nodes)
+		Core::Array<uint32>		mWindow;		// ring buffer of node indices in insertion order
+		uint32					mWindowSize;
+		uint32					mNumValues;
+		uint32					mWindowStart;	// ring buffer index of the oldest value
+		uint32					mRoot;
+		uint64					mSequence;
+		uint32					mRandomState;
+};
+
+
+#endif
@@ -66,6 +66,7 @@ class ENGINE_API Spectrum
 
 		double GetBin(uint32 index) const;
 		Core::Complex GetComplexBin(uint32 index) const;
+		const Core::Complex* GetBins() const									{ return mBins.GetReadPtr(); }
 
 		void SetBin(uint32 index, Core::Complex complex)						{ mBins[index] = complex; }
 		bool IsEmpty() const													{ return mBins.IsEmpty(); }
@@ -0,0 +1,262 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "SphericalSpline.h"
+#include "../Core/Math.h"
+#include "../Core/LogManager.h"
+
+
+using namespace Core;
+
+// constructor
+SphericalSpline::SphericalSpline()
+{
+	mIsInitialized	= false;
+	mNumElectrodes	= 0;
+	mNumTargets		= 0;
+}
+
+
+// destructor
+SphericalSpline::~SphericalSpline()
+{
+}
+
+
+void SphericalSpline::Clear()
+{
+	mIsInitialized	= false;
+	mNumElectrodes	= 0;
+	mNumTargets		= 0;
+
+	mSeriesFactors.Clear();
+	mOperator.Clear();
+}
+
+
+// precalculate the operator that maps the electrode values directly to the target values
+bool SphericalSpline::Init(const Array<Vector3>& electrodePositions, const Array<Vector3>& targetPositions, uint32 order, uint32 numLegendreTerms, double regularization)
+{
+	Clear();
+
+	const uint32 numElectrodes	= electrodePositions.Size();
+	const uint32 numTargets		= targetPositions.Size();
+	if (numElectrodes == 0 || numTargets == 0 || numLegendreTerms == 0)
+		return false;
+
+	// legendre series factors
+	mSeriesFactors.Resize(numLegendreTerms);
+	for (uint32 i=0; i<numLegendreTerms; ++i)
+	{
+		const double n = i + 1;
+		mSeriesFactors[i] = (2.0 * n + 1.0) / (Math::PowD(n * (n + 1.0), (double)order) * 4.0 * Math::piD);
+	}
+
+	// normalized electrode positions
+	Array<double> electrodes(3 * numElectrodes);
+	for (uint32 i=0; i<numElectrodes; ++i)
+	{
+		const Vector3& p = electrodePositions[i];
+		const double length = Math::SqrtD((double)p.x * p.x + (double)p.y * p.y + (double)p.z * p.z);
+		if (length <= 0.0)
+			return false;
+
+		electrodes[3 * i + 0] = p.x / length;
+		electrodes[3 * i + 1] = p.y / length;
+		electrodes[3 * i + 2] = p.z / length;
+	}
+
+	// 1) spline system A = [G+a*I 1; 1^t 0] and its inverse
+	const uint32 size = numElectrodes + 1;
+	Array<double> system(size * size);
+	for (uint32 i=0; i<numElectrodes; ++i)
+	{
+		const double* ei = electrodes.GetReadPtr() + 3 * i;
+		for (uint32 j=i; j<numElectrodes; ++j)
+		{
+			const double* ej = electrodes.GetReadPtr() + 3 * j;
+			double g = CalcBasis(ei[0] * ej[0] + ei[1] * ej[1] + ei[2] * ej[2]);
+			if (i == j)
+				g += regularization;
+
+			system[i * size + j] = g;
+			system[j * size + i] = g;
+		}
+
+		system[i * size + numElectrodes] = 1.0;
+		system[numElectrodes * size + i] = 1.0;
+	}
+	system[numElectrodes * size + numElectrodes] = 0.0;
+
+	Array<double> inverse;
+	if (CalcInverse(system, size, inverse) == false)
+	{
+		LogError("SphericalSpline: could not invert the spline matrix.");
+		return false;
+	}
+
+	// 2) operator M = H * A^-1 restricted to the electrode columns, with the target basis rows H = [g(t*e_1) .. g(t*e_n) 1]
+	mOperator.Resize(numTargets * numElectrodes);
+	Array<double> basis(size);
+	for (uint32 t=0; t<numTargets; ++t)
+	{
+		const Vector3& p = targetPositions[t];
+		double length = Math::SqrtD((double)p.x * p.x + (double)p.y * p.y + (double)p.z * p.z);
+		if (length <= 0.0)
+			length = 1.0;
+
+		const double x = p.x / length;
+		const double y = p.y / length;
+		const double z = p.z / length;
+		for (uint32 j=0; j<numElectrodes; ++j)
+		{
+			const double* ej = electrodes.GetReadPtr() + 3 * j;
+			basis[j] = CalcBasis(x * ej[0] + y * ej[1] + z * ej[2]);
+		}
+		basis[numElectrodes] = 1.0;
+
+		double* row = mOperator.GetPtr() + t * numElectrodes;
+		for (uint32 e=0; e<numElectrodes; ++e)
+			row[e] = 0.0;
+
+		for (uint32 k=0; k<size; ++k)
+		{
+			const double h = basis[k];
+			const double* inverseRow = inverse.GetReadPtr() + k * size;
+			for (uint32 e=0; e<numElectrodes; ++e)
+				row[e] += h * inverseRow[e];
+		}
+	}
+
+	mNumElectrodes	= numElectrodes;
+	mNumTargets		= numTargets;
+	mIsInitialized	= true;
+	return true;
+}
+
+
+// interpolate one frame: single matrix-vector product
+void SphericalSpline::Interpolate(const double* electrodeValues, double* outTargetValues) const
+{
+	const double* row = mOperator.GetReadPtr();
+	for (uint32 t=0; t<mNumTargets; ++t)
+	{
+		double sum = 0.0;
+		for (uint32 e=0; e<mNumElectrodes; ++e)
+			sum += row[e] * electrodeValues[e];
+
+		outTargetValues[t] = sum;
+		row += mNumElectrodes;
+	}
+}
+
+
+// spline basis function via the legendre recurrence P_n = ((2n-1)*x*P_n-1 - (n-1)*P_n-2) / n
+double SphericalSpline::CalcBasis(double cosAngle) const
+{
+	const double x = Clamp(cosAngle, -1.0, 1.0);
+
+	double previous = 1.0;		// P_0
+	double current = x;			// P_1
+	double result = mSeriesFactors[0] * current;
+
+	const uint32 numTerms = mSeriesFactors.Size();
+	for (uint32 i=1; i<numTerms; ++i)
+	{
+		const double n = i + 1;
+		const double next = ((2.0 * n - 1.0) * x * current - (n - 1.0) * previous) / n;
+		previous = current;
+		current = next;
+		result += mSeriesFactors[i] * current;
+	}
+
+	return result;
+}
+
+
+// gauss-jordan elimination with partial pivoting (the bordered spline system is symmetric but indefinite)
+bool SphericalSpline::CalcInverse(const Array<double>& matrix, uint32 n, Array<double>& outInverse)
+{
+	Array<double> a = matrix;
+	outInverse.Resize(n * n);
+	outInverse.SetAll(0.0);
+	for (uint32 i=0; i<n; ++i)
+		outInverse[i * n + i] = 1.0;
+
+	for (uint32 col=0; col<n; ++col)
+	{
+		// find the pivot
+		uint32 pivot = col;
+		double pivotValue = Math::AbsD(a[col * n + col]);
+		for (uint32 r=col+1; r<n; ++r)
+		{
+			const double value = Math::AbsD(a[r * n + col]);
+			if (value > pivotValue)
+			{
+				pivot = r;
+				pivotValue = value;
+			}
+		}
+
+		if (pivotValue == 0.0 || Math::IsValidNumberD(pivotValue) == false)
+			return false;
+
+		// swap the rows
+		if (pivot != col)
+		{
+			for (uint32 k=0; k<n; ++k)
+			{
+				Swap(a[col * n + k], a[pivot * n + k]);
+				Swap(outInverse[col * n + k], outInverse[pivot * n + k]);
+			}
+		}
+
+		// normalize the pivot row
+		const double scale = 1.0 / a[col * n + col];
+		for (uint32 k=0; k<n; ++k)
+		{
+			a[col * n + k] *= scale;
+			outInverse[col * n + k] *= scale;
+		}
+
+		// eliminate the column from all other rows
+		for (uint32 r=0; r<n; ++r)
+		{
+			if (r == col)
+				continue;
+
+			const double factor = a[r * n + col];
+			if (factor == 0.0)
+				continue;
+
+			for (uint32 k=0; k<n; ++k)
+			{
+				a[r * n + k] -= factor * a[col * n + k];
+				outInverse[r * n + k] -= factor * outInverse[col * n + k];
+			}
+		}
+	}
+
+	return true;
+}
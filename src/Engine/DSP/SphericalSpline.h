@@ -0,0 +1,75 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_SPHERICALSPLINE_H
+#define __NEUROMORE_SPHERICALSPLINE_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+#include "../Core/Vector.h"
+
+
+// spherical spline interpolation (Perrin et al. 1989) between electrode positions and arbitrary target positions on the unit sphere
+//  - Init() solves the spline system [G+a*I 1; 1^t 0] once per electrode layout and folds it together with the target
+//    basis functions into one numTargets x numElectrodes interpolation operator
+//  - Interpolate() is then a single matrix-vector product
+class ENGINE_API SphericalSpline
+{
+	public:
+		// constructor & destructor
+		SphericalSpline();
+		~SphericalSpline();
+
+		// precalculate the interpolation operator (positions are projected onto the unit sphere)
+		bool Init(const Core::Array<Core::Vector3>& electrodePositions, const Core::Array<Core::Vector3>& targetPositions, uint32 order = 4, uint32 numLegendreTerms = 7, double regularization = 1e-5);
+		void Clear();
+		bool IsInitialized() const												{ return mIsInitialized; }
+
+		uint32 GetNumElectrodes() const											{ return mNumElectrodes; }
+		uint32 GetNumTargets() const											{ return mNumTargets; }
+
+		// interpolate one frame of electrode values (numElectrodes values) to all targets (numTargets values)
+		void Interpolate(const double* electrodeValues, double* outTargetValues) const;
+
+		// the interpolation operator: numTargets x numElectrodes (row-major)
+		const double* GetOperator() const										{ return mOperator.GetReadPtr(); }
+
+	private:
+		// spline basis function g(x) = 1/(4*pi) * sum (2n+1) / (n*(n+1))^m * P_n(x), using the precalculated series factors
+		double CalcBasis(double cosAngle) const;
+
+		// invert a general square matrix (gauss-jordan with partial pivoting)
+		static bool CalcInverse(const Core::Array<double>& matrix, uint32 size, Core::Array<double>& outInverse);
+
+		bool					mIsInitialized;
+		uint32					mNumElectrodes;
+		uint32					mNumTargets;
+
+		Core::Array<double>		mSeriesFactors;			// (2n+1) / (n*(n+1))^m / (4*pi) for n = 1..numLegendreTerms
+		Core::Array<double>		mOperator;				// numTargets x numElectrodes (row-major)
+};
+
+
+#endif
@@ -113,12 +113,15 @@ void StatisticsProcessor::Update()
 
 	// number of new epochs we can process
 	const uint32 numNewEpochs = inputReader->GetNumEpochs();
+	ScratchArena& scratchArena = GetScratchArena();
 	
 	// calculate statistics for this epoch
 	for (uint32 e=0; e<numNewEpochs; ++e)
 	{
-		// 1) get the input epoch
+		// 1) get the input epoch and copy its samples to scratch memory once (all statistics read the epoch at least once)
+		ScratchArena::Scope scratchScope(scratchArena);
 		Epoch inputEpoch = inputReader->PopOldestEpoch();
+		inputEpoch.Materialize(scratchArena);
 	
 		// 2) calculate statistic over epoch
 		double statisticValue = 0;
@@ -162,7 +165,7 @@ void StatisticsProcessor::Update()
 				break;
 
 			case Percentile:
-				statisticValue = inputEpoch.Percentile(mSettings.mPercentile, mTempArray);
+				statisticValue = inputEpoch.Percentile(mSettings.mPercentile, scratchArena);
 				break;
 
 			case HarmonicMean:
@@ -174,7 +177,7 @@ void StatisticsProcessor::Update()
 				break;
 
 			case Median:
-				statisticValue = inputEpoch.Median(mTempArray);
+				statisticValue = inputEpoch.Median(scratchArena);
 				break;
 
 			// TODO add other quantiles here (needs additional attribute in statistics node
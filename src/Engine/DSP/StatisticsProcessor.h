@@ -106,9 +106,6 @@ class ENGINE_API StatisticsProcessor : public ChannelProcessor
 	
 	private:
 		StatisticsSettings		mSettings;
-
-		// temporary array for things like sorting
-		Core::Array<double>		mTempArray;
 };
 
 
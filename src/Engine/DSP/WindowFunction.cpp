@@ -24,6 +24,7 @@
 // include required files
 #include "WindowFunction.h"
 #include "../Core/LogManager.h"
+#include "../Core/Mutex.h"
 
 
 using namespace Core;
@@ -103,12 +104,114 @@ void WindowFunction::SetType(EWindowFunction windowType)
 	};
 }
 
+//-----------------------------------------------
+// window table cache
+//-----------------------------------------------
+
+// all window tables that were requested so far (never released, there are only a few different types and lengths in use)
+class WindowTableCache
+{
+	public:
+		struct Table
+		{
+			WindowFunction::EWindowFunction		mType;
+			uint32								mNumSamples;
+			Array<double>						mValues;
+		};
+
+		~WindowTableCache()
+		{
+			const uint32 numTables = mTables.Size();
+			for (uint32 i=0; i<numTables; ++i)
+				delete mTables[i];
+		}
+
+		const double* GetTable(WindowFunction::EWindowFunction windowType, uint32 numSamples)
+		{
+			mLock.Lock();
+
+			const uint32 numTables = mTables.Size();
+			for (uint32 i=0; i<numTables; ++i)
+			{
+				if (mTables[i]->mType == windowType && mTables[i]->mNumSamples == numSamples)
+				{
+					const double* values = mTables[i]->mValues.GetReadPtr();
+					mLock.Unlock();
+					return values;
+				}
+			}
+
+			// calculate new table
+			WindowFunction windowFunction;
+			windowFunction.SetType(windowType);
+
+			Table* table = new Table();
+			table->mType = windowType;
+			table->mNumSamples = numSamples;
+			table->mValues.Resize(numSamples);
+			for (uint32 i=0; i<numSamples; ++i)
+				table->mValues[i] = (numSamples > 1 ? windowFunction.Evaluate(i, numSamples) : 1.0);
+
+			mTables.Add(table);
+			mLock.Unlock();
+
+			return table->mValues.GetReadPtr();
+		}
+
+	private:
+		Array<Table*>	mTables;
+		Mutex			mLock;
+};
+
+
+const double* WindowFunction::GetTable(EWindowFunction windowType, uint32 numSamples)
+{
+	static WindowTableCache cache;
+	return cache.GetTable(windowType, numSamples);
+}
+
+
 //-----------------------------------------------
 // the window functions
 //-----------------------------------------------
 
 #define ZERO_OUTBOUNDS(index, numSamples)	if (index < 0.0 || index >= numSamples) { return 0.0; }
 
+// coefficients of the generalized cosine windows (w = a0 - a1*cos(x) + a2*cos(2x) - ...)
+static const double gHannTerms[]			= { 0.5, 0.5 };
+static const double gHammingTerms[]			= { 0.53836, 0.46164 };
+static const double gBlackmanTerms[]		= { 0.42659, 0.49656, 0.076849 };			// exact values, these place zeros at the third and fourth sidelobes (0.42, 0.5, 0.08 by common convention)
+static const double gNuttallTerms[]			= { 0.355768, 0.487396, 0.144232, 0.012604 };
+static const double gBlackmanNuttallTerms[]	= { 0.3635819, 0.4891775, 0.1365995, 0.0106411 };
+static const double gBlackmanHarrisTerms[]	= { 0.35875, 0.48829, 0.14128, 0.01168 };
+static const double gFlatTopTerms[]			= { 1.0, 1.93, 1.29, 0.388, 0.028 };
+
+
+// get the coefficients of a generalized cosine window
+uint32 WindowFunction::GetCosineTerms(EWindowFunction windowType, double* outTerms)
+{
+	const double* terms;
+	uint32 numTerms;
+	switch (windowType)
+	{
+		case WINDOWFUNCTION_RECTANGULAR:	{ outTerms[0] = 1.0; return 1; }
+		case WINDOWFUNCTION_HANN:			{ terms = gHannTerms;				numTerms = 2; break; }
+		case WINDOWFUNCTION_HAMMING:		{ terms = gHammingTerms;			numTerms = 2; break; }
+		case WINDOWFUNCTION_BLACKMAN:		{ terms = gBlackmanTerms;			numTerms = 3; break; }
+		case WINDOWFUNCTION_NUTTALL:		{ terms = gNuttallTerms;			numTerms = 4; break; }
+		case WINDOWFUNCTION_BLACKMANNUTTALL:{ terms = gBlackmanNuttallTerms;	numTerms = 4; break; }
+		case WINDOWFUNCTION_BLACKMANHARRIS:	{ terms = gBlackmanHarrisTerms;		numTerms = 4; break; }
+		case WINDOWFUNCTION_FLATTOP:		{ terms = gFlatTopTerms;			numTerms = 5; break; }
+		default:							{ return 0; }
+	}
+
+	for (uint32 i=0; i<numTerms; ++i)
+		outTerms[i] = terms[i];
+
+	return numTerms;
+}
+
+
 // rectangular window
 double WindowFunction::CalculateRectangularWindow(double index, double numSamples)
 {
@@ -154,14 +257,14 @@ double WindowFunction::CalculateGeneralizedHammingWindow(double index, double nu
 double WindowFunction::CalculateHannWindow(double index, double numSamples)
 {
 	ZERO_OUTBOUNDS( index, numSamples );
-	return CalculateGeneralizedHammingWindow( index, numSamples, 0.5, 0.5 );
+	return CalculateGeneralizedHammingWindow( index, numSamples, gHannTerms[0], gHannTerms[1] );
 }
 
 
 double WindowFunction::CalculateHammingWindow(double index, double numSamples)
 {
 	ZERO_OUTBOUNDS( index, numSamples );
-	return CalculateGeneralizedHammingWindow( index, numSamples, 0.53836, 0.46164 );
+	return CalculateGeneralizedHammingWindow( index, numSamples, gHammingTerms[0], gHammingTerms[1] );
 }
 
 
@@ -170,13 +273,9 @@ double WindowFunction::CalculateBlackmanWindow(double index, double numSamples)
 {
 	ZERO_OUTBOUNDS( index, numSamples );
 
-	//const double alpha	= 0.16;				// by common convention, as 0.16 approximates most closely to the "exact Blackman"
-	//const double alpha0	= (1-alpha) * 0.5;
-	//const double alpha1	= 0.5;
-	//const double alpha2	= alpha * 0.5;
-	const double alpha0		= 0.42659;			// exact values, these place zeros at the third and fourth sidelobes
-	const double alpha1		= 0.49656;
-	const double alpha2		= 0.076849;
+	const double alpha0		= gBlackmanTerms[0];
+	const double alpha1		= gBlackmanTerms[1];
+	const double alpha2		= gBlackmanTerms[2];
 
 	return alpha0 - alpha1 * cos( (2*Math::pi*index) / (numSamples-1.0) ) + alpha2 * cos( (4*Math::pi*index) / (numSamples-1.0) );
 }
@@ -195,10 +294,10 @@ double WindowFunction::CalculateNuttallWindow(double index, double numSamples)
 {
 	ZERO_OUTBOUNDS( index, numSamples );
 
-	const double alpha0	= 0.355768;
-	const double alpha1	= 0.487396;
-	const double alpha2	= 0.144232;
-	const double alpha3	= 0.012604;
+	const double alpha0	= gNuttallTerms[0];
+	const double alpha1	= gNuttallTerms[1];
+	const double alpha2	= gNuttallTerms[2];
+	const double alpha3	= gNuttallTerms[3];
 
 	return CalculateGeneralizedThirdOrderCosineWindow( index, numSamples, alpha0, alpha1, alpha2, alpha3 );
 }
@@ -209,10 +308,10 @@ double WindowFunction::CalculateBlackmanNuttallWindow(double index, double numSa
 {
 	ZERO_OUTBOUNDS( index, numSamples );
 
-	const double alpha0	= 0.3635819;
-	const double alpha1	= 0.4891775;
-	const double alpha2	= 0.1365995;
-	const double alpha3	= 0.0106411;
+	const double alpha0	= gBlackmanNuttallTerms[0];
+	const double alpha1	= gBlackmanNuttallTerms[1];
+	const double alpha2	= gBlackmanNuttallTerms[2];
+	const double alpha3	= gBlackmanNuttallTerms[3];
 
 	return CalculateGeneralizedThirdOrderCosineWindow( index, numSamples, alpha0, alpha1, alpha2, alpha3 );
 }
@@ -223,10 +322,10 @@ double WindowFunction::CalculateBlackmanHarrisWindow(double index, double numSam
 {
 	ZERO_OUTBOUNDS( index, numSamples );
 
-	const double alpha0	= 0.35875;
-	const double alpha1	= 0.48829;
-	const double alpha2	= 0.14128;
-	const double alpha3	= 0.01168;
+	const double alpha0	= gBlackmanHarrisTerms[0];
+	const double alpha1	= gBlackmanHarrisTerms[1];
+	const double alpha2	= gBlackmanHarrisTerms[2];
+	const double alpha3	= gBlackmanHarrisTerms[3];
 
 	return CalculateGeneralizedThirdOrderCosineWindow( index, numSamples, alpha0, alpha1, alpha2, alpha3 );
 }
@@ -237,11 +336,11 @@ double WindowFunction::CalculateFlatTopWindow(double index, double numSamples)
 {
 	ZERO_OUTBOUNDS( index, numSamples );
 
-	const double alpha0	= 1.0;
-	const double alpha1	= 1.93;
-	const double alpha2	= 1.29;
-	const double alpha3	= 0.388;
-	const double alpha4	= 0.028;
+	const double alpha0	= gFlatTopTerms[0];
+	const double alpha1	= gFlatTopTerms[1];
+	const double alpha2	= gFlatTopTerms[2];
+	const double alpha3	= gFlatTopTerms[3];
+	const double alpha4	= gFlatTopTerms[4];
 
 	return alpha0 - alpha1 * cos( (2.0*Math::pi*index) / (numSamples-1.0) ) + alpha2 * cos( (4.0*Math::pi*index) / (numSamples-1.0) ) - alpha3 * cos( (6.0*Math::pi*index) / (numSamples-1.0) ) + alpha4 * cos( (8.0*Math::pi*index) / (numSamples-1.0) );
 }
@@ -68,6 +68,14 @@ class ENGINE_API WindowFunction
 		// main function to evaluate the window
 		inline double Evaluate(double index, double numSamples)											{ return mFunction(index, numSamples); }
 
+		// precalculated window values (numSamples values); the tables are shared process-wide and stay valid until the program ends
+		static const double* GetTable(EWindowFunction windowType, uint32 numSamples);
+		const double* GetTable(uint32 numSamples) const													{ return GetTable(mType, numSamples); }
+
+		// coefficients a0..ak of generalized cosine windows (w = a0 - a1*cos(x) + a2*cos(2x) - ...); returns the number of terms or 0 if the window is not a cosine sum
+		enum { MAX_COSINE_TERMS = 5 };
+		static uint32 GetCosineTerms(EWindowFunction windowType, double* outTerms);
+
 	private:
 		// function pointer definition
 		typedef double (CORE_CDECL *WindowFunctionPointer)(double index, double numSamples);
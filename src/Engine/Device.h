@@ -90,6 +90,9 @@ class ENGINE_API Device : public OscReceiver, public Core::EventSource
 		bool HasDeviceDriver() const											{ return mDeviceDriver != NULL; }
 		DeviceDriver* GetDeviceDriver() const									{ return mDeviceDriver; }
 
+		// the device or its driver may only be used on the thread that created them
+		virtual bool HasThreadAffinity() const									{ return (mDeviceDriver != NULL && mDeviceDriver->HasThreadAffinity() == true); }
+
 		// base type
 		virtual uint32 GetBaseType() const										{ return BASE_TYPE_ID; }
 
@@ -62,6 +62,9 @@ class ENGINE_API DeviceDriver
 		// main update function
 		virtual void Update(const Core::Time& delta, const Core::Time& elapsed) = 0;
 
+		// the driver owns objects that may only be used on the thread that created them (e.g. Qt objects), see DeviceManager::UpdateThreadAffine()
+		virtual bool HasThreadAffinity() const									{ return false; }
+
 		// enable/disable device driver
 		bool IsEnabled() const													{ return mIsEnabled; }
 		virtual void SetEnabled(bool enabled = true);
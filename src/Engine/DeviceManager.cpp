@@ -43,6 +43,8 @@ DeviceManager::DeviceManager()
 
 	// enable autoremoval by default
 	mRemoveInactiveDevices = true;
+
+	mDeferDeviceListUpdate = false;
 }
 
 
@@ -101,6 +103,55 @@ void DeviceManager::Update(const Time& elapsed, const Time& delta)
 {
 	mFpsCounter.BeginTiming();
 
+	// add/remove devices
+	if (mDeferDeviceListUpdate == false)
+		UpdateDeviceList();
+
+	// the owner of the deferred device list updates the drivers and devices that live on its thread
+	const bool updateThreadAffine = (mDeferDeviceListUpdate == false);
+
+	// update device systems
+	const uint32 numDrivers = mDeviceDrivers.Size();
+	for (uint32 i=0; i<numDrivers; ++i)
+	{
+		if (updateThreadAffine == true || mDeviceDrivers[i]->HasThreadAffinity() == false)
+			mDeviceDrivers[i]->Update(elapsed, delta);
+	}
+
+	// update devices
+	const uint32 numDevices = mDevices.Size();
+	for (uint32 i=0; i<numDevices; ++i)
+	{
+		if (updateThreadAffine == true || mDevices[i]->HasThreadAffinity() == false)
+			mDevices[i]->Update(elapsed, delta);
+	}
+
+	mFpsCounter.StopTiming();
+}
+
+
+// update the drivers and devices with thread affinity
+void DeviceManager::UpdateThreadAffine(const Time& elapsed, const Time& delta)
+{
+	const uint32 numDrivers = mDeviceDrivers.Size();
+	for (uint32 i=0; i<numDrivers; ++i)
+	{
+		if (mDeviceDrivers[i]->HasThreadAffinity() == true)
+			mDeviceDrivers[i]->Update(elapsed, delta);
+	}
+
+	const uint32 numDevices = mDevices.Size();
+	for (uint32 i=0; i<numDevices; ++i)
+	{
+		if (mDevices[i]->HasThreadAffinity() == true)
+			mDevices[i]->Update(elapsed, delta);
+	}
+}
+
+
+// add/remove devices
+void DeviceManager::UpdateDeviceList()
+{
 	// check for inactive devices and remove them (if feature is enabled)
 	if (mRemoveInactiveDevices == true)
 		RemoveInactiveDevices();
@@ -120,18 +171,6 @@ void DeviceManager::Update(const Time& elapsed, const Time& delta)
 		RemoveDevice(mDevicesToRemove[i]);
 	mDevicesToRemove.Clear();
 	mRemoveLock.Unlock();
-
-	// update device systems
-	const uint32 numDrivers = mDeviceDrivers.Size();
-	for (uint32 i=0; i<numDrivers; ++i)
-		mDeviceDrivers[i]->Update(elapsed, delta);
-
-	// update devices
-	const uint32 numDevices = mDevices.Size();
-	for (uint32 i=0; i<numDevices; ++i)
-		mDevices[i]->Update(elapsed, delta);
-
-	mFpsCounter.StopTiming();
 }
 
 
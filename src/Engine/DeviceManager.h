@@ -47,6 +47,16 @@ class ENGINE_API DeviceManager : public Core::EventSource, OscReceiver
 		// init, update, sync
 		bool Init();
 		void Update(const Core::Time& elapsed, const Core::Time& delta);
+
+		// add/remove the queued devices and remove the inactive ones (called by Update() unless it is deferred)
+		void UpdateDeviceList();
+
+		// update the drivers and devices with thread affinity (called by Update() unless the device list update is deferred)
+		void UpdateThreadAffine(const Core::Time& elapsed, const Core::Time& delta);
+
+		// let the owner call UpdateDeviceList() and UpdateThreadAffine() on its own thread instead (e.g. the UI thread, while the engine is updated on a separate thread)
+		void SetDeferDeviceListUpdate(bool defer)						{ mDeferDeviceListUpdate = defer; }
+		bool GetDeferDeviceListUpdate() const							{ return mDeferDeviceListUpdate; }
 		
 		void SyncDevices(double syncTime);
 		void ResetDevices();
@@ -175,6 +185,7 @@ class ENGINE_API DeviceManager : public Core::EventSource, OscReceiver
 
 		// device manager config
 		bool							mRemoveInactiveDevices;
+		bool							mDeferDeviceListUpdate;
 
 		// misc
 		Core::String					mTempOscAddressPattern;
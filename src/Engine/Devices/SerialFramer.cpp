@@ -0,0 +1,190 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "SerialFramer.h"
+#include <string.h>
+
+
+using namespace Core;
+
+// constructor
+SerialFramer::SerialFramer()
+{
+	mFrameSize			= 0;
+	mHeader				= 0;
+	mFooter				= 0;
+	mFooterMask			= 0xFF;
+	mReadPos			= 0;
+	mWritePos			= 0;
+	mNumParsedFrames	= 0;
+	mNumDroppedBytes	= 0;
+}
+
+
+// destructor
+SerialFramer::~SerialFramer()
+{
+}
+
+
+void SerialFramer::Init(uint32 frameSize, uint8 header, uint8 footer, uint8 footerMask)
+{
+	mFrameSize	= frameSize;
+	mHeader		= header;
+	mFooter		= footer & footerMask;
+	mFooterMask	= footerMask;
+
+	Clear();
+}
+
+
+void SerialFramer::Clear()
+{
+	mReadPos			= 0;
+	mWritePos			= 0;
+	mNumParsedFrames	= 0;
+	mNumDroppedBytes	= 0;
+	mFrames.Clear(false);
+}
+
+
+// make room for numBytes at the end of the buffer (moves the unparsed bytes to the front, this invalidates the frame pointers)
+uint8* SerialFramer::BeginWrite(uint32 numBytes)
+{
+	mFrames.Clear(false);
+
+	const uint32 numBuffered = mWritePos - mReadPos;
+	if (mReadPos > 0)
+	{
+		if (numBuffered > 0)
+			memmove(mBuffer.GetPtr(), mBuffer.GetPtr() + mReadPos, numBuffered);
+
+		mReadPos = 0;
+		mWritePos = numBuffered;
+	}
+
+	if (mBuffer.Size() < mWritePos + numBytes)
+		mBuffer.Resize(mWritePos + numBytes);
+
+	return mBuffer.GetPtr() + mWritePos;
+}
+
+
+void SerialFramer::Write(const uint8* data, uint32 numBytes)
+{
+	uint8* destination = BeginWrite(numBytes);
+	memcpy(destination, data, numBytes);
+	EndWrite(numBytes);
+}
+
+
+// state machine: search header -> wait for the complete frame -> check footer (resync one byte after the header on a mismatch)
+uint32 SerialFramer::Parse()
+{
+	mFrames.Clear(false);
+	if (mFrameSize == 0)
+		return 0;
+
+	const uint8* buffer = mBuffer.GetReadPtr();
+	uint32 position = mReadPos;
+	while (position < mWritePos)
+	{
+		// fast path: the next frame starts right here
+		const uint8* start = buffer + position;
+		if (*start != mHeader)
+		{
+			const uint8* header = (const uint8*)memchr(start, mHeader, mWritePos - position);
+			if (header == NULL)
+			{
+				mNumDroppedBytes += mWritePos - position;
+				position = mWritePos;
+				break;
+			}
+
+			const uint32 headerPosition = (uint32)(header - buffer);
+			mNumDroppedBytes += headerPosition - position;
+			position = headerPosition;
+			start = header;
+		}
+
+		// incomplete frame: wait for more bytes
+		if (mWritePos - position < mFrameSize)
+			break;
+
+		// the header byte can also be part of the payload, so only a matching footer confirms the frame
+		if ((start[mFrameSize - 1] & mFooterMask) != mFooter)
+		{
+			mNumDroppedBytes++;
+			position++;
+			continue;
+		}
+
+		mFrames.Add(start);
+		position += mFrameSize;
+	}
+
+	mReadPos = position;
+	mNumParsedFrames += mFrames.Size();
+	return mFrames.Size();
+}
+
+
+// decode 24 bit big-endian two's complement values (one value of all frames at a time, so the inner loop has a fixed stride)
+void SerialFramer::DecodeInt24(const uint8* const* frames, uint32 numFrames, uint32 byteOffset, uint32 numValues, const double* scales, double* out, uint32 stride)
+{
+	for (uint32 v=0; v<numValues; ++v)
+	{
+		const uint32 offset = byteOffset + 3 * v;
+		const double scale = scales[v];
+		double* row = out + v * stride;
+
+		for (uint32 f=0; f<numFrames; ++f)
+		{
+			const uint8* bytes = frames[f] + offset;
+
+			// shift the 24 bits to the top and back down to sign-extend them
+			const int32 value = (int32)(((uint32)bytes[0] << 24) | ((uint32)bytes[1] << 16) | ((uint32)bytes[2] << 8)) >> 8;
+			row[f] = value * scale;
+		}
+	}
+}
+
+
+// decode 16 bit big-endian two's complement values
+void SerialFramer::DecodeInt16(const uint8* const* frames, uint32 numFrames, uint32 byteOffset, uint32 numValues, const double* scales, double* out, uint32 stride)
+{
+	for (uint32 v=0; v<numValues; ++v)
+	{
+		const uint32 offset = byteOffset + 2 * v;
+		const double scale = scales[v];
+		double* row = out + v * stride;
+
+		for (uint32 f=0; f<numFrames; ++f)
+		{
+			const uint8* bytes = frames[f] + offset;
+			const int16 value = (int16)(((uint16)bytes[0] << 8) | bytes[1]);
+			row[f] = value * scale;
+		}
+	}
+}
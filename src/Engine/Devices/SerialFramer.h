@@ -0,0 +1,91 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_SERIALFRAMER_H
+#define __NEUROMORE_SERIALFRAMER_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+
+
+// framing state machine for fixed-size serial stream packets that start with a header byte and end with a footer byte
+//  - raw bytes are appended in bulk (BeginWrite()/EndWrite()), Parse() then scans for headers with memchr and collects all
+//    complete frames at once; bytes that do not belong to a valid frame are dropped and counted
+//  - frames are returned as pointers into the internal buffer, so they can be decoded in place; they stay valid until the next write
+//  - the buffer is linear and compacted on write, so frames and headers are always contiguous in memory
+class ENGINE_API SerialFramer
+{
+	public:
+		// constructor & destructor
+		SerialFramer();
+		~SerialFramer();
+
+		// fixed frame size including header and footer; a footer byte matches if (byte & footerMask) == footer
+		void Init(uint32 frameSize, uint8 header, uint8 footer, uint8 footerMask = 0xFF);
+		void Clear();
+
+		uint32 GetFrameSize() const												{ return mFrameSize; }
+
+		// append raw bytes: get a pointer to space for numBytes and commit the number of bytes actually written
+		uint8* BeginWrite(uint32 numBytes);
+		void EndWrite(uint32 numBytesWritten)									{ mWritePos += numBytesWritten; }
+		void Write(const uint8* data, uint32 numBytes);
+
+		// collect all complete frames from the buffered bytes, returns the number of frames found
+		uint32 Parse();
+
+		// the frames found by the last Parse()
+		uint32 GetNumFrames() const												{ return mFrames.Size(); }
+		const uint8* GetFrame(uint32 index) const								{ return mFrames[index]; }
+		const uint8* const* GetFrames() const									{ return mFrames.GetReadPtr(); }
+
+		// statistics
+		uint64 GetNumParsedFrames() const										{ return mNumParsedFrames; }
+		uint64 GetNumDroppedBytes() const										{ return mNumDroppedBytes; }
+		uint32 GetNumBufferedBytes() const										{ return mWritePos - mReadPos; }
+
+		// decode numValues consecutive big-endian signed integers at byteOffset of every frame into a channel-major tile
+		// (value v of frame f is written to out[v * stride + f], multiplied with scales[v])
+		static void DecodeInt24(const uint8* const* frames, uint32 numFrames, uint32 byteOffset, uint32 numValues, const double* scales, double* out, uint32 stride);
+		static void DecodeInt16(const uint8* const* frames, uint32 numFrames, uint32 byteOffset, uint32 numValues, const double* scales, double* out, uint32 stride);
+
+	private:
+		uint32					mFrameSize;
+		uint8					mHeader;
+		uint8					mFooter;
+		uint8					mFooterMask;
+
+		Core::Array<uint8>		mBuffer;
+		uint32					mReadPos;				// first byte that was not parsed yet
+		uint32					mWritePos;				// end of the buffered bytes
+
+		Core::Array<const uint8*> mFrames;				// frames of the last Parse() (pointers into mBuffer)
+
+		uint64					mNumParsedFrames;
+		uint64					mNumDroppedBytes;
+};
+
+
+#endif
@@ -33,8 +33,29 @@ using namespace Core;
 // the global neuromore Engine manager
 ENGINE_API EngineManager* gEngineManager = NULL;
 
+// engine bound to the calling thread (see EngineScope)
+static thread_local EngineManager* tThreadEngine = NULL;
+
 //--------------------------------------------------
 
+// engine of the calling thread
+EngineManager* EngineManager::GetCurrent()
+{
+	if (tThreadEngine != NULL)
+		return tThreadEngine;
+
+	return gEngineManager;
+}
+
+
+EngineManager* EngineManager::BindToThread(EngineManager* engine)
+{
+	EngineManager* previous = tThreadEngine;
+	tThreadEngine = engine;
+	return previous;
+}
+
+
 // constructor
 EngineManager::EngineManager()
 {
@@ -42,6 +63,7 @@ EngineManager::EngineManager()
 	mCounter			= NULL;
 	mEventManager		= NULL;
 	mAttributeFactory	= NULL;
+	mChannelSnapshotManager = NULL;
 
 	// set version
 	mVersion = Version( NEUROMORE_ENGINE_VERSION_MAJOR, NEUROMORE_ENGINE_VERSION_MINOR, NEUROMORE_ENGINE_VERSION_PATCH );
@@ -83,6 +105,10 @@ EngineManager::~EngineManager()
 	// serial port manager
 	delete mSerialPortManager;
 
+	// channel snapshots (after everything that owns channels)
+	delete mChannelSnapshotManager;
+	mChannelSnapshotManager = NULL;
+
 
 	// destruct core systems
 
@@ -115,6 +141,8 @@ bool EngineManager::Init()
 	mAttributeFactory	= new AttributeFactory();
 	mEventManager		= new EventManager();
 
+	// channel snapshots (before anything that creates channels)
+	mChannelSnapshotManager	= new ChannelSnapshotManager();
 
 	// state
 	mActiveBci				= NULL;
@@ -123,6 +151,7 @@ bool EngineManager::Init()
 	mActiveExperience		= NULL;
 	mIsRunning				= true;
 	mIsSoftPaused			= false;
+	mIsOfflineMode			= false;
 	mAllowAssetStreaming	= false;
 	mElapsedTime			= 0;
 
@@ -137,6 +166,10 @@ bool EngineManager::Init()
 	mDriftCorrectionSettings.mMaxForwardDrift	= 0.2;
 	mDriftCorrectionSettings.mMaxBackwardDrift	= 1.0;
 
+	// channel storage settings
+	mChannelStorageSettings.mMode			= CHANNELSTORAGE_MEMORY;
+	mChannelStorageSettings.mHotDuration	= 60.0;
+
 	// callbacks
 	mCallback				= NULL;
 
@@ -177,6 +210,9 @@ bool EngineManager::Init()
 // update the core manager
 void EngineManager::Update(Time delta)
 {
+	// everything below resolves the managers of this engine, no matter which thread updates it
+	EngineScope engineScope(this);
+
 	// skip the update in case the whole system is paused
 	if (mIsRunning == false)
 		return;
@@ -229,9 +265,19 @@ void EngineManager::Update(Time delta)
 	if (mActiveStateMachine != NULL)
 		mActiveStateMachine->Update(mElapsedTime, delta);
 
-	// update and output the classifier
+	// update and output the classifier (one profiler frame per update)
 	if (mActiveClassifier != NULL)
+	{
+		mNodeProfiler.BeginFrame();
 		mActiveClassifier->Update(mElapsedTime, delta);
+		mNodeProfiler.EndFrame();
+	}
+
+	// send the OSC messages the output nodes bundled during this update
+	mOscMessageRouter->FlushOutputBundle();
+
+	// 6) publish the channel snapshots
+	mChannelSnapshotManager->Update();
 
 	mFpsCounter.StopTiming();
 }
@@ -629,3 +675,32 @@ void EngineInitializer::Shutdown()
 	delete gEngineManager;
 	gEngineManager = NULL;
 }
+
+
+// create an additional engine instance
+EngineManager* EngineInitializer::CreateInstance()
+{
+	EngineManager* engine = new EngineManager();
+
+	// the managers of the new engine must see the engine while they get constructed
+	EngineScope engineScope(engine);
+	if (engine->Init() == false)
+	{
+		delete engine;
+		return NULL;
+	}
+
+	return engine;
+}
+
+
+// destroy an additional engine instance
+void EngineInitializer::DestroyInstance(EngineManager* engine)
+{
+	if (engine == NULL || engine == gEngineManager)
+		return;
+
+	EngineScope engineScope(engine);
+	LogInfo("Shutting down engine instance ...");
+	delete engine;
+}
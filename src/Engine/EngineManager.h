@@ -45,10 +45,12 @@
 #include "Graph/GraphManager.h"
 #include "Graph/GraphObjectFactory.h"
 #include "Graph/Classifier.h"
+#include "Graph/NodeProfiler.h"
 #include "Graph/StateMachine.h"
 #include "Networking/OscMessageRouter.h"
 #include "DeviceManager.h"
 #include "SerialPortManager.h"
+#include "ChannelSnapshotManager.h"
 #include "Core/AttributeFactory.h"
 
 // forward declarations
@@ -70,6 +72,12 @@ class ENGINE_API EngineManager : public Core::EventSource
 				virtual Core::Time Now() = 0;
 		};
 
+		// engine of the calling thread: the one bound by an EngineScope, otherwise the default engine (gEngineManager)
+		static EngineManager* GetCurrent();
+
+		// bind an engine to the calling thread (NULL unbinds), returns the previously bound engine
+		static EngineManager* BindToThread(EngineManager* engine);
+
 		// callback
 		void SetCallback(Callback* callback)									{ mCallback = callback; }
 		Callback* GetCallback()													{ return mCallback; }
@@ -81,6 +89,12 @@ class ENGINE_API EngineManager : public Core::EventSource
 
 		// main update function
 		void Update(Core::Time delta);
+
+		// engine lock for running the update on a separate thread: the updating thread holds it during Update(),
+		// all other threads must hold it while they access graphs, devices or channels
+		void Lock()																{ mUpdateLock.Lock(); }
+		void Unlock()															{ mUpdateLock.Unlock(); }
+		bool TryLock()															{ return mUpdateLock.TryLock(); }
 		
 		// TODO add another type of reset  (unload everything, so its like brand new; Reset() doesn't do that for us
 		// engine reset
@@ -103,6 +117,11 @@ class ENGINE_API EngineManager : public Core::EventSource
 		void SoftContinue();
 		bool IsSoftPaused() const												{ return mIsSoftPaused; }
 
+		// offline mode: time is driven by the recorded data instead of the wall clock (file readers stop at the end of their data instead of looping,
+		// file writers write on every update, no sensor drift correction), so the engine can be updated with large simulated steps as fast as possible
+		void SetOfflineMode(bool enabled)										{ mIsOfflineMode = enabled; }
+		bool IsOfflineMode() const												{ return mIsOfflineMode; }
+
 		// FIXME make these private, they should never be called from outside
 		// asynchronous executed sample-level synchronization accross all sensors
 		void Sync();
@@ -175,6 +194,9 @@ class ENGINE_API EngineManager : public Core::EventSource
 		// serial port management
 		SerialPortManager* GetSerialPortManager() const							{ return mSerialPortManager; }
 
+		// channel snapshots for readers on other threads (captured after each update)
+		ChannelSnapshotManager* GetChannelSnapshotManager() const				{ return mChannelSnapshotManager; }
+
 		// Note: this is only used to select which BCI should be displayed in the studio. This should not be here.
 		// neuro headset management
 		void SetActiveBci(BciDevice* device);
@@ -201,6 +223,9 @@ class ENGINE_API EngineManager : public Core::EventSource
 
 		// performance statistics
 		const Core::FpsCounter& GetFpsCounter() const							{ return mFpsCounter; }
+
+		// per-node profiling of the classifier update
+		NodeProfiler* GetNodeProfiler()											{ return &mNodeProfiler; }
 		
 		// version
 		Core::Version GetVersion() const										{ return mVersion; }
@@ -254,6 +279,23 @@ class ENGINE_API EngineManager : public Core::EventSource
 
 		DriftCorrectionSettings& GetDriftCorrectionSettings()					{ return mDriftCorrectionSettings; }
 
+		// storage channels (recordings): samples older than the hot duration can be compressed and spilled to disk
+		enum EChannelStorageMode
+		{
+			CHANNELSTORAGE_MEMORY		= 0,		// keep all samples uncompressed in memory
+			CHANNELSTORAGE_COMPRESSED	= 1,		// compress older samples and keep them in memory
+			CHANNELSTORAGE_DISK			= 2			// compress older samples and move them into a temporary file
+		};
+
+		struct ChannelStorageSettings
+		{
+			EChannelStorageMode mMode;
+			double mHotDuration;					// seconds of the most recent samples that stay uncompressed
+			Core::String mSpillFolder;				// folder of the temporary files (empty = temp folder of the system)
+		};
+
+		ChannelStorageSettings& GetChannelStorageSettings()						{ return mChannelStorageSettings; }
+
 	protected:
 
 		// constructor & destructor
@@ -279,6 +321,7 @@ class ENGINE_API EngineManager : public Core::EventSource
 		Session*						mSession;
 		bool							mIsRunning;
 		bool							mIsSoftPaused;
+		bool							mIsOfflineMode;
 		Core::Time						mElapsedTime;
 		bool							mAllowAssetStreaming;
 
@@ -296,6 +339,7 @@ class ENGINE_API EngineManager : public Core::EventSource
 		BciDevice*						mActiveBci;
 		EEGElectrodes*					mEEGElectrodes;
 		SerialPortManager*				mSerialPortManager;
+		ChannelSnapshotManager*			mChannelSnapshotManager;
 
 		// networking
 		OscMessageRouter*				mOscMessageRouter;
@@ -310,6 +354,7 @@ class ENGINE_API EngineManager : public Core::EventSource
 		bool							mAutoSyncEnabled;
 		bool							mAutoDetectionEnabled;
 		DriftCorrectionSettings			mDriftCorrectionSettings;
+		ChannelStorageSettings			mChannelStorageSettings;
 
 		// graphs and graphbjects
 		GraphManager*					mGraphManager;
@@ -330,7 +375,22 @@ class ENGINE_API EngineManager : public Core::EventSource
 
 		// performance timing
 		Core::FpsCounter				mFpsCounter;
+		NodeProfiler					mNodeProfiler;
+
+		// held during the update when running on a separate thread
+		Core::Mutex						mUpdateLock;
+
+};
 
+
+// binds an engine to the calling thread during its lifetime, so that GetEngine() and all manager shortcuts resolve to it
+class EngineScope
+{
+	public:
+		EngineScope(EngineManager* engine)										{ mPrevious = EngineManager::BindToThread(engine); }
+		~EngineScope()															{ EngineManager::BindToThread(mPrevious); }
+	private:
+		EngineManager* mPrevious;
 };
 
 
@@ -338,33 +398,39 @@ class ENGINE_API EngineManager : public Core::EventSource
 class ENGINE_API EngineInitializer
 {
 	public:
+		// default engine (gEngineManager), used by all threads without an EngineScope
 		static bool Init();
 		static void Shutdown();
+
+		// additional independent engine instances; each owns its own devices, graphs, session and core systems
+		// note: bind the instance with an EngineScope before calling into it (EngineManager::Update() binds itself)
+		static EngineManager* CreateInstance();
+		static void DestroyInstance(EngineManager* engine);
 };
 
 
-// the global
+// the default engine
 extern ENGINE_API EngineManager* gEngineManager;
 
 // core shortcuts
-#define CORE_LOGMANAGER			(gEngineManager->GetLogManager())
-#define CORE_COUNTER			(gEngineManager->GetCounter())
-#define CORE_STRINGIDGENERATOR	(gEngineManager->GetStringIdGenerator())
-#define CORE_ATTRIBUTEFACTORY	(gEngineManager->GetAttributeFactory())
-#define CORE_EVENTMANAGER		(gEngineManager->GetEventManager())
-
-// shortcuts
-inline EngineManager*		GetEngine()						{ return gEngineManager; }
-inline User*				GetUser()						{ return gEngineManager->GetUser(); }
-inline User*				GetSessionUser()				{ return gEngineManager->GetSessionUser(); }
-inline DeviceManager*		GetDeviceManager()				{ return gEngineManager->GetDeviceManager(); }
-inline EEGElectrodes*		GetEEGElectrodes()				{ return gEngineManager->GetEEGElectrodes(); }
-inline Session*				GetSession()					{ return gEngineManager->GetSession(); }
-inline GraphObjectFactory*	GetGraphObjectFactory()			{ return gEngineManager->GetGraphObjectFactory(); }
-inline GraphManager*		GetGraphManager()				{ return gEngineManager->GetGraphManager(); }
-inline OscMessageRouter*	GetOscMessageRouter()			{ return gEngineManager->GetOscMessageRouter(); }
-inline SerialPortManager*	GetSerialPortManager()			{ return gEngineManager->GetSerialPortManager(); }
-
-inline Core::String		GenerateRandomUuid()			{ EngineManager::Callback* callback = gEngineManager->GetCallback(); if (callback == NULL) return ""; return callback->GenerateRandomUUID(); }
+#define CORE_LOGMANAGER			(GetEngine()->GetLogManager())
+#define CORE_COUNTER			(GetEngine()->GetCounter())
+#define CORE_STRINGIDGENERATOR	(GetEngine()->GetStringIdGenerator())
+#define CORE_ATTRIBUTEFACTORY	(GetEngine()->GetAttributeFactory())
+#define CORE_EVENTMANAGER		(GetEngine()->GetEventManager())
+
+// shortcuts (all resolve to the engine of the calling thread)
+inline EngineManager*		GetEngine()						{ return EngineManager::GetCurrent(); }
+inline User*				GetUser()						{ return GetEngine()->GetUser(); }
+inline User*				GetSessionUser()				{ return GetEngine()->GetSessionUser(); }
+inline DeviceManager*		GetDeviceManager()				{ return GetEngine()->GetDeviceManager(); }
+inline EEGElectrodes*		GetEEGElectrodes()				{ return GetEngine()->GetEEGElectrodes(); }
+inline Session*				GetSession()					{ return GetEngine()->GetSession(); }
+inline GraphObjectFactory*	GetGraphObjectFactory()			{ return GetEngine()->GetGraphObjectFactory(); }
+inline GraphManager*		GetGraphManager()				{ return GetEngine()->GetGraphManager(); }
+inline OscMessageRouter*	GetOscMessageRouter()			{ return GetEngine()->GetOscMessageRouter(); }
+inline SerialPortManager*	GetSerialPortManager()			{ return GetEngine()->GetSerialPortManager(); }
+
+inline Core::String		GenerateRandomUuid()			{ EngineManager::Callback* callback = GetEngine()->GetCallback(); if (callback == NULL) return ""; return callback->GenerateRandomUUID(); }
 
 #endif
@@ -33,9 +33,7 @@ using namespace Core;
 // constructor
 AutoThresholdNode::AutoThresholdNode(Graph* graph) : ProcessorNode(graph, new AutoThresholdNode::Processor())
 {
-	mSettings.mNumBins = 10000;
 	mSettings.mNumSamples = 128;
-	mSettings.mRequiredEpochLength = 256;
 	mSettings.mTargetMode = TARGETMODE_SCORE;
 	mSettings.mThresholdInputMode = THRESHOLDINPUTMODE_RELATIVE;
 	mSettings.mInvertTarget = false;
@@ -69,10 +67,12 @@ void AutoThresholdNode::Init()
 	GetOutputPort(OUTPUTPORT_LOW).Setup("Low", "lowOut", AttributeChannels<double>::TYPE_ID, OUTPUTPORT_LOW);
 
 	// ATTRIBUTES
+	// hidden, unused: the thresholds are calculated from the exact sample values now, the attribute is only kept so older graphs still load
 	Core::AttributeSettings* numBinsAttrib = RegisterAttribute("Number of Bins", "numBins", "", Core::ATTRIBUTE_INTERFACETYPE_INTSPINNER);
-	numBinsAttrib->SetDefaultValue( Core::AttributeInt32::Create(mSettings.mNumBins) );
+	numBinsAttrib->SetDefaultValue( Core::AttributeInt32::Create(10000) );
 	numBinsAttrib->SetMinValue( Core::AttributeInt32::Create(100) );
 	numBinsAttrib->SetMaxValue( Core::AttributeInt32::Create(CORE_INT32_MAX) );
+	numBinsAttrib->SetVisible(false);
 
 	Core::AttributeSettings* numSamplesAttrib = RegisterAttribute("Sample Count", "numSamples", "", Core::ATTRIBUTE_INTERFACETYPE_INTSPINNER);
 	numSamplesAttrib->SetDefaultValue( Core::AttributeInt32::Create(mSettings.mNumSamples) );
@@ -178,13 +178,6 @@ void AutoThresholdNode::ReInit(const Time& elapsed, const Time& delta)
 	//	}
 	//}
 
-	// calculate the required input buffer size (we need an epoch longer than mNumSamples because we need to remove the old ones too, 
-	const double sampleRate = (signalChannels != NULL ? signalChannels->GetSampleRate() : 0.0);
-	if (sampleRate > 0)
-		mSettings.mRequiredEpochLength = mSettings.mNumSamples + sampleRate * 5.0; // allow 5 second lag
-	else
-		mSettings.mRequiredEpochLength = mSettings.mNumSamples + Max<uint32>(mSettings.mNumSamples * 2, 100);
-
 	PostReInit(elapsed, delta);
 }
 
@@ -208,7 +201,6 @@ void AutoThresholdNode::Update(const Time& elapsed, const Time& delta)
 
 void AutoThresholdNode::OnAttributesChanged()
 {
-	mSettings.mNumBins			  = GetInt32Attribute(ATTRIB_NUMBINS);
 	mSettings.mNumSamples		  = GetInt32Attribute(ATTRIB_NUMSAMPLES);
 	mSettings.mTargetMode		  = (ETargetMode)GetInt32Attribute(ATTRIB_TARGETMODE);
 	mSettings.mInvertTarget		  = GetBoolAttribute(ATTRIB_INVERT_TARGET);
@@ -230,17 +222,11 @@ void AutoThresholdNode::Processor::ReInit()
 
 	mIsInitialized = false;
 
-	mHistogram.Clear();
+	// the sliding window keeps its own copy of the values, so the signal input buffer doesn't have to hold the whole interval
+	mValues.Init(mSettings.mNumSamples);
 	
 	// NOTE: don't check inputs here, everything was checked in the nodes ReInit function
 
-
-	// configure input epoch for signal port
-	ChannelReader* signalInputReader = GetInputReader(INPUTPORT_SIGNAL);
-	signalInputReader->SetEpochLength(mSettings.mNumSamples);
-	signalInputReader->SetEpochShift(1);
-	signalInputReader->SetEpochZeroPadding(false);
-
 	// forward sample rate (from control ports, not the signal port)
 	ChannelBase* targetInput = GetInput(INPUTPORT_TARGET)->AsType<double>();
 	ChannelBase* highOutput = GetOutput(OUTPUTPORT_HIGH)->AsType<double>();
@@ -265,8 +251,6 @@ void AutoThresholdNode::Processor::Update()
 	const EOutputMode outputMode = (GetInput(INPUTPORT_HIGH) != NULL ? OUTPUTMODE_LOW: OUTPUTMODE_HIGH);
 
 	// input/output channels
-	Channel<double>* signalInput = GetInput(INPUTPORT_SIGNAL)->AsType<double>();
-
 	ChannelReader* signalInputReader = GetInputReader(INPUTPORT_SIGNAL);
 	ChannelReader* targetInputReader = GetInputReader(INPUTPORT_TARGET);
 	ChannelReader* thresholdInputReader = (outputMode == OUTPUTMODE_LOW ? GetInputReader(INPUTPORT_HIGH) : GetInputReader(INPUTPORT_LOW)); 
@@ -278,82 +262,19 @@ void AutoThresholdNode::Processor::Update()
 	const uint32 numSignalSamples = signalInputReader->GetNumNewSamples();
 	const uint32 numControlSamples = Min(targetInputReader->GetNumNewSamples(), thresholdInputReader->GetNumNewSamples());
 
-	//LogDebug("AutoThresholdNode::Processor::Update(): have %i signal samples, %i control samples", numSignalSamples, numControlSamples);
-
-	// Step 1: check if histogram is still sufficient for the sample range by checking the new samples first
-	double minValue = mHistogram.GetMinValue();
-	double maxValue = mHistogram.GetMaxValue();
+	// Step 1: add the new samples to the sliding window (values that leave the interval are removed automatically)
+	// skip invalid samples (e.g. device dropouts), they would count against the window without having a rank
 	for (uint32 i=0; i<numSignalSamples; ++i)
 	{
 		const double value = signalInputReader->GetSample<double>(i);
-		minValue = Min(minValue, value);
-		maxValue = Max(maxValue, value);
-	}
-
-	// Step 2: Reinitialize Histogram if necessary
-	const bool canRebuildHistogram = signalInputReader->GetNumEpochs() > 0;
-	
-	const bool isEmpty = (mHistogram.GetNumValues() == 0);
-	const bool isTooSmall = (minValue < mHistogram.GetMinValue() || maxValue > mHistogram.GetMaxValue());				// histogram range doesn't cover the input values
-	//const bool isTooLarge = (mHistogram.GetMaxValue() - mHistogram.GetMinValue()) > 20.0 * (maxValue - minValue);		// only 5% of the histogram are actually used
-	const bool isTooLarge = (maxValue - minValue) / mHistogram.GetBinWidth();		// value range is covered by less than 100 bins (= possible 'steps' in the output)
-	const bool needRebuildHistogram = isEmpty || isTooSmall || isTooLarge;
-
-	if (needRebuildHistogram && canRebuildHistogram)
-	{
-		//LogDebug("Rebuilding Histogram");
-
-		// recalculate histogram by using the newest epoch
-		const uint32 newestEpochIndex = signalInputReader->GetNumEpochs() - 1;
-		Epoch epoch = signalInputReader->GetEpoch(newestEpochIndex);
-
-		const double epochMin = epoch.Min();
-		const double epochMax = epoch.Max();
-		const double newRange = epochMax - epochMin;
-
-		const double headroom = newRange / 4.0;					// init new histogram with a certain amount of free space in both directions to reduce number of reinitializations
-		const double newMinValue = epochMin - headroom;
-		const double newMaxValue = epochMax + headroom;
-
-		//LogDebug("Reinitializing Histogram %i (%f .. %f)", mSettings.mNumBins, newMinValue, newMaxValue);
-		mHistogram.Init(mSettings.mNumBins, newMinValue, newMaxValue);
-
-		// add all the samples
-		const uint32 numEpochSamples = epoch.GetNumSamples();
-		for (uint32 i=0; i<numEpochSamples; ++i)
-			mHistogram.AddValue(epoch.GetSample(i));
-
-		//LogDebug("%i samples added to Histogram", numEpochSamples);
-
-
-		// Note: we don't have to process new samples, they are already contained in the processed epoch
-	}
-	else if (needRebuildHistogram == false) // update histogram from the signal by adding new and removing old values
-	{
-		// Step 2.1: add new samples and remove old ones
-		for (uint32 i=0; i<numSignalSamples; ++i)
-		{
-			// add new sample to histogram
-			const uint64 index = signalInputReader->GetSampleIndex(i);
-			//LogDebug("Adding Sample %i", index);
-			mHistogram.AddValue(signalInput->GetSample(index));
-
-			// remove old values that 'leave' the interval
-			if (mHistogram.GetNumValues() >= mSettings.mNumSamples && index >= mSettings.mNumSamples)
-			{
-				const uint32 removeIndex = index - mSettings.mNumSamples;
-				CORE_ASSERT(signalInput->IsValidSample(removeIndex));
-
-				//LogDebug("Removing Sample %i", removeIndex);
-				mHistogram.RemoveValue(signalInput->GetSample(removeIndex));
-			}
-		}
+		if (Math::IsValidNumberD(value) == true)
+			mValues.AddValue(value);
 	}
 
 	// all input from signal port is now processed
 	signalInputReader->Flush();
 
-	// Step 3: process control port samples and produce outputs (based on the latest histogram that we get after processing all signal samples)
+	// Step 2: process control port samples and produce outputs (based on the window we get after processing all signal samples)
 	
 	//
 	// run algorithm and produce output samples
@@ -396,12 +317,12 @@ void AutoThresholdNode::Processor::Update()
 	
 double AutoThresholdNode::Processor::CalcHighInputThreshold (double inputValue)
 {
-	// select high threshold relativ to the upper value of the high bin of the current histogram
+	// select high threshold relativ to the largest value of the interval
 	if (mSettings.mThresholdInputMode == THRESHOLDINPUTMODE_RELATIVE)
 	{
-		const double highBinValue = mHistogram.GetBinMaxValue( mHistogram.FindHighBin() );
-		const double offset = highBinValue * inputValue;
-		return highBinValue + offset;
+		const double maxValue = mValues.GetMaxValue();
+		const double offset = maxValue * inputValue;
+		return maxValue + offset;
 	}		
 	else  // THRESHOLDINPUTMODE_ABSOLUTE
 	{
@@ -412,12 +333,12 @@ double AutoThresholdNode::Processor::CalcHighInputThreshold (double inputValue)
 	
 double AutoThresholdNode::Processor::CalcLowInputThreshold (double inputValue)
 {
-	// select low threshold relativ to the lower value of the low bin of the current histogram
+	// select low threshold relativ to the smallest value of the interval
 	if (mSettings.mThresholdInputMode == THRESHOLDINPUTMODE_RELATIVE)
 	{
-		const double lowBinValue = mHistogram.GetBinMinValue( mHistogram.FindLowBin() );
-		const double offset = lowBinValue * inputValue;
-		return lowBinValue + offset;
+		const double minValue = mValues.GetMinValue();
+		const double offset = minValue * inputValue;
+		return minValue + offset;
 	}		
 	else  // THRESHOLDINPUTMODE_ABSOLUTE
 	{
@@ -426,145 +347,114 @@ double AutoThresholdNode::Processor::CalcLowInputThreshold (double inputValue)
 }
 
 
+// Note: both auto threshold searches only look at the sample values as thresholds. The time ratio and the score grow monotonically with the
+// distance between the thresholds, so the best sample can be found with a binary search over the ranks of the sorted interval.
 double AutoThresholdNode::Processor::CalcHighAutoThreshold (double lowThreshold, double target)
 {
-	if (mHistogram.GetNumValues() == 0)
+	const uint32 numSamples = mValues.GetNumValues();
+	if (numSamples == 0)
 		return 0;
 
-	// targets for both mode
-	const uint32 numSamples = mHistogram.GetNumValues();
-	const uint32 scoreTargetSampleCount = numSamples * target;
+	// the samples with a rank of at least firstRank are above the low threshold
+	const uint32 firstRank = mValues.CountLess(lowThreshold);
 
-	// find threshold so the target is matched as closely as possible
-	uint32 currentSampleCount = 0;
-	double currentInverseArea = 0;
-
-	const int32 highBinIndex = mHistogram.GetNumBins()-1;;//mHistogram.FindHighBin(); 
-	const int32 lowBinIndex = mHistogram.CalcBinIndex(lowThreshold);
-
-	for (int32 i=lowBinIndex; i<=highBinIndex; ++i)
+	if (mSettings.mTargetMode == TARGETMODE_TIME)
 	{
-		// move low threshold one bin down and increase the current sample count
-		const uint32 binSize = mHistogram.GetBin(i);
+		// the high threshold is the sample that has exactly the target number of samples between both thresholds
+		const uint32 timeTargetSampleCount = numSamples * target;
+		if (timeTargetSampleCount == 0)
+			return lowThreshold;
 
-		// proposed low threshold that will be tested for the target
-		const double highThreshold = mHistogram.GetBinMaxValue(i);
+		const uint32 rank = firstRank + timeTargetSampleCount - 1;
+		if (rank >= numSamples)
+			return mValues.GetMaxValue();		// goal was not reached, return the largest value we have
 
-		// current sample count
-		currentSampleCount += binSize;
+		return mValues.GetValue(rank);
+	}
+	else // TARGETMODE_SCORE
+	{
+		// area between the waveform and the high threshold, relative to the area between both thresholds, must reach the target
+		const double firstSum = mValues.CalcSum(firstRank);
 
-		if (mSettings.mTargetMode == TARGETMODE_TIME)
+		// find the first rank that reaches the target
+		uint32 begin = firstRank;
+		uint32 end = numSamples;
+		while (begin < end)
 		{
-			// reached target count?
-			if (currentSampleCount >= scoreTargetSampleCount)
-			{
-				// fine-adjust the threshold within BinMinValue and BinMaxValue by assuming equal sample distribution within the bin;
-				const uint32 numSamplesOvershoot = currentSampleCount - scoreTargetSampleCount;
-				const double correctionOffset = (binSize == 0 ? 0 : mHistogram.GetBinWidth() *  ( (double)numSamplesOvershoot / (double)binSize)); // Note: this check is probably unnecessary because the currentSampleCount never increases when binSize is zero ?!
-				return highThreshold - correctionOffset;
-			}
+			const uint32 rank = begin + (end - begin) / 2;
+			const double highThreshold = mValues.GetValue(rank);
+			const double height = highThreshold - lowThreshold;
+
+			// area of the samples within the thresholds
+			const uint32 numInside = rank - firstRank + 1;
+			const double sumInside = mValues.CalcSum(rank + 1) - firstSum;
+			const double currentArea = numInside * highThreshold - sumInside;
+			const double targetArea = height * (double)numSamples * target;
+
+			if (height > 0 && currentArea >= targetArea)
+				end = rank;
+			else
+				begin = rank + 1;
 		}
-		else // TARGETMODE_SCORE
-		{
-			const double height = (highThreshold - lowThreshold);
-
-			if (height == 0)
-				continue;
 
-			// increment current (inverse) area
-			currentInverseArea += height * binSize;
+		if (begin >= numSamples)
+			return mValues.GetMaxValue();		// goal was not reached, return the largest value we have
 
-			const double totalArea = height * (double)numSamples;
-
-			// calculate real area taken up by the waveform within the thresholds
-			const double nonVisitedInverseArea = height * (numSamples - currentSampleCount);
-			const double currentArea = totalArea - (currentInverseArea + nonVisitedInverseArea);
-
-			// calculate target area from current thresholds
-			const double targetArea = totalArea * target;
-			
-			if (currentArea >= targetArea)
-			{
-				// TODO fine-adjust the threshold if possible? same as above?? -> whiteboard time!
-				return highThreshold;
-			}
-		}
+		return mValues.GetValue(begin);
 	}
-
-	// goal was not reached, return the largest value we have			// TODO: add some kind of 'success' output to the node? 
-	return mHistogram.GetBinMaxValue( highBinIndex );
 }
 
 
 double AutoThresholdNode::Processor::CalcLowAutoThreshold (double highThreshold, double target)
 {
-	if (mHistogram.GetNumValues() == 0)
+	const uint32 numSamples = mValues.GetNumValues();
+	if (numSamples == 0)
 		return 0;
 
-	// targets for both mode
-	const uint32 numSamples = mHistogram.GetNumValues();
-	const uint32 scoreTargetSampleCount = numSamples * target;
-
-	// find threshold so the target is matched as closely as possible
-	uint32 currentSampleCount = 0;
-	double currentInverseArea = 0;
-
-	const int32 highBinIndex = mHistogram.CalcBinIndex(highThreshold);
-	const int32 lowBinIndex = 0;//mHistogram.FindLowBin();
+	// the samples with a rank below endRank are below the high threshold
+	const uint32 endRank = mValues.CountLessEqual(highThreshold);
 
-	for (int32 i=highBinIndex; i>=lowBinIndex; --i)
+	if (mSettings.mTargetMode == TARGETMODE_TIME)
 	{
-		// move low threshold one bin down and increase the current sample count
-		const uint32 binSize = mHistogram.GetBin(i);
+		// the low threshold is the sample that has exactly the target number of samples between both thresholds
+		const uint32 timeTargetSampleCount = numSamples * target;
+		if (timeTargetSampleCount == 0)
+			return highThreshold;
 
-		// proposed low threshold that will be tested for the target
-		const double lowThreshold = mHistogram.GetBinMinValue(i);
+		if (timeTargetSampleCount > endRank)
+			return mValues.GetMinValue();		// goal was not reached, return the smallest value we have
 
-		// current sample count
-		currentSampleCount += binSize;
+		return mValues.GetValue(endRank - timeTargetSampleCount);
+	}
+	else // TARGETMODE_SCORE
+	{
+		// area between the low threshold and the waveform, relative to the area between both thresholds, must reach the target
+		const double endSum = mValues.CalcSum(endRank);
 
-		if (mSettings.mTargetMode == TARGETMODE_TIME)
+		// count the ranks that reach the target (they are all below the ones that don't)
+		uint32 begin = 0;
+		uint32 end = endRank;
+		while (begin < end)
 		{
-			// reached target count?
-			if (currentSampleCount >= scoreTargetSampleCount)
-			{
-				// fine-adjust the threshold within BinMinValue and BinMaxValue by assuming equal sample distribution within the bin;
-				const uint32 numSamplesOvershoot = currentSampleCount - scoreTargetSampleCount;
-				const double correctionOffset = (binSize == 0 ? 0 : mHistogram.GetBinWidth() *  ( (double)numSamplesOvershoot / (double)binSize)); // Note: this check is probably unnecessary because the currentSampleCount never increases when binSize is zero ?!
-				return lowThreshold + correctionOffset;
-			}
+			const uint32 rank = begin + (end - begin) / 2;
+			const double lowThreshold = mValues.GetValue(rank);
+			const double height = highThreshold - lowThreshold;
+
+			// area of the samples within the thresholds
+			const uint32 numInside = endRank - rank;
+			const double sumInside = endSum - mValues.CalcSum(rank);
+			const double currentArea = sumInside - numInside * lowThreshold;
+			const double targetArea = height * (double)numSamples * target;
+
+			if (height > 0 && currentArea >= targetArea)
+				begin = rank + 1;
+			else
+				end = rank;
 		}
-		else // TARGETMODE_SCORE
-		{
-			const double height = (highThreshold - lowThreshold);
-
-			if (height == 0)
-				continue;
-
-			// increment current (inverse) area
-			currentInverseArea += height * binSize;
-
-			const double totalArea = height * (double)numSamples;
 
-			// calculate real area taken up by the waveform within the thresholds
-			const double nonVisitedInverseArea = height * (numSamples - currentSampleCount);
-			const double currentArea = totalArea - (currentInverseArea + nonVisitedInverseArea);
+		if (begin == 0)
+			return mValues.GetMinValue();		// goal was not reached, return the smallest value we have
 
-			// calculate target area from current thresholds
-			const double targetArea = totalArea * target;
-			
-			if (currentArea >= targetArea)
-			{
-				// TODO fine-adjust the threshold if possible? same as above?? -> whiteboard time!
-				return lowThreshold;
-			}
-		}
+		return mValues.GetValue(begin - 1);
 	}
-
-	// goal was not reached, return the smallest value we have			// TODO: add some kind of 'success' output to the node? 
-	return mHistogram.GetBinMinValue( lowBinIndex );
 }
-
-
-
-
@@ -29,7 +29,7 @@
 #include "../Core/StandardHeaders.h"
 #include "ProcessorNode.h"
 #include "../DSP/ChannelProcessor.h"
-#include "../DSP/Histogram.h"
+#include "../DSP/SlidingQuantile.h"
 
 
 class ENGINE_API AutoThresholdNode : public ProcessorNode
@@ -107,9 +107,7 @@ class ENGINE_API AutoThresholdNode : public ProcessorNode
 				ETargetMode				mTargetMode;
 				bool					mInvertTarget;
 				EThresholdInputMode		mThresholdInputMode;
-				uint32					mNumBins;					// total number of histogram bins
 				uint32					mNumSamples;				// size of the interval we base the thresholding calc on
-				uint32					mRequiredEpochLength;		// number of samples that must be present in the signal input buffer (interval length + safety buffer)
 		};
 		
 		ProcessorSettings	mSettings;
@@ -130,8 +128,6 @@ class ENGINE_API AutoThresholdNode : public ProcessorNode
 				void Setup(const ChannelProcessor::Settings& settings) override					{ mSettings = static_cast<const ProcessorSettings&>(settings); }
 				const Settings& GetSettings() const	override									{ return mSettings; }
 		
-				uint32 GetNumEpochSamples(uint32 inputPortIndex) const override final			{ if (inputPortIndex == 0) return mSettings.mRequiredEpochLength; else return 0; }
-
 				void Init() override
 				{
 					AddInput<double>();
@@ -149,7 +145,7 @@ class ENGINE_API AutoThresholdNode : public ProcessorNode
 			private:
 				ProcessorSettings		mSettings;
 
-				Histogram				mHistogram;
+				SlidingQuantile			mValues;					// sorted signal values of the interval
 
 				double CalcHighInputThreshold (double inputValue);
 				double CalcLowInputThreshold (double inputValue);
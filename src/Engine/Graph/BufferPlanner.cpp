@@ -0,0 +1,320 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "BufferPlanner.h"
+#include "Classifier.h"
+#include "SPNode.h"
+#include "InputNode.h"
+#include "DeviceInputNode.h"
+#include "../Core/LogManager.h"
+#include "../Core/Math.h"
+
+using namespace Core;
+
+
+// constructor
+BufferPlanner::BufferPlanner()
+{
+	mHeadroomDuration = 0.0;
+	mIsShrinkPending = false;
+}
+
+
+// destructor
+BufferPlanner::~BufferPlanner()
+{
+}
+
+
+// output ports with buffered channels get a planned size
+bool BufferPlanner::IsPlannedPort(SPNode* node, uint32 outputPortIndex)
+{
+	MultiChannel* channels = node->GetOutputPort(outputPortIndex).GetChannels();
+	return (channels != NULL && channels->GetNumChannels() > 0 && channels->IsBuffer() == true);
+}
+
+
+// plan and resize the output buffers of all nodes
+void BufferPlanner::Plan(Classifier* classifier, double headroomSeconds, bool allowShrink)
+{
+	mEntries.Clear(false);
+	mOutputTimes.clear();
+	mHeadroomDuration = headroomSeconds;
+	mIsShrinkPending = false;
+
+	// headroom of channels without a fixed sample rate
+	const uint32 defaultNumHeadroomSamples = 500;
+
+	const uint32 numNodes = classifier->GetNumNodes();
+	for (uint32 n=0; n<numNodes; ++n)
+	{
+		Node* node = classifier->GetNode(n);
+		if (node->GetNodeType() == Node::NODE_TYPE)
+			continue;
+
+		SPNode* spNode = static_cast<SPNode*>(node);
+		const bool isGrowOnly = (node->GetNodeType() == InputNode::NODE_TYPE || node->GetNodeType() == DeviceInputNode::NODE_TYPE);
+
+		const uint32 numOutPorts = spNode->GetNumOutputPorts();
+		for (uint32 p=0; p<numOutPorts; ++p)
+		{
+			// skip empty sets and channels that are not buffers
+			if (IsPlannedPort(spNode, p) == false)
+				continue;
+
+			Port& port = spNode->GetOutputPort(p);
+			MultiChannel* channels = port.GetChannels();
+
+			const double sampleRate = channels->GetSampleRate();
+
+			// 1) lookback: the most any consumer reads at once
+			uint32 numLookbackSamples = 1;
+			Node* limitingConsumer = NULL;
+
+			const uint32 numConnections = classifier->CalcNumOutputConnections(spNode, p);
+			for (uint32 c=0; c<numConnections; ++c)
+			{
+				Connection* connection = classifier->GetConnection(classifier->FindOutputConnection(spNode, p, c));
+				Node* consumer = connection->GetTargetNode();
+				if (consumer->GetNodeType() == Node::NODE_TYPE)
+					continue;
+
+				SPNode* consumerSPNode = static_cast<SPNode*>(consumer);
+				const uint32 inputPortIndex = connection->GetTargetPort();
+				const uint32 numSamples = consumerSPNode->GetNumEpochSamples(inputPortIndex) + CalcNumSyncSamples(consumerSPNode, inputPortIndex, sampleRate);
+
+				if (numSamples > numLookbackSamples)
+				{
+					numLookbackSamples = numSamples;
+					limitingConsumer = consumer;
+				}
+			}
+
+			// 2) headroom: everything a single update may add before the consumers read it
+			const uint32 numHeadroomSamples = (sampleRate > 0.0 ? (uint32)Math::CeilD(headroomSeconds * sampleRate) : defaultNumHeadroomSamples);
+			const uint32 plannedSize = numLookbackSamples + numHeadroomSamples;
+
+			// 3) resize the channels (resets them), continue them where they ended
+			Entry entry;
+			entry.mPlannedSize	= plannedSize;
+			entry.mNumChannels	= channels->GetNumChannels();
+			entry.mBufferSize	= 0;
+			entry.mNumBytes		= 0;
+
+			for (uint32 c=0; c<entry.mNumChannels; ++c)
+			{
+				ChannelBase* channel = channels->GetChannel(c);
+
+				// keep larger buffers of sensor outputs and of a running session, the resize would drop their samples
+				uint32 bufferSize = plannedSize;
+				if (channel->GetBufferSize() > plannedSize && (isGrowOnly == true || allowShrink == false))
+				{
+					bufferSize = channel->GetBufferSize();
+					if (isGrowOnly == false)
+						mIsShrinkPending = true;
+				}
+
+				if (bufferSize != channel->GetBufferSize())
+				{
+					LogDebug("BufferPlanner: resizing buffer of %s from %i to %i", node->GetName(), channel->GetBufferSize(), bufferSize);
+
+					const Time lastSampleTime = channel->GetLastSampleTime();
+					channel->SetBufferSize(bufferSize);
+					channel->SetStartTime(lastSampleTime);
+				}
+
+				entry.mBufferSize = Max(entry.mBufferSize, bufferSize);
+				entry.mNumBytes += channel->CalculateMemoryAllocated(true);
+			}
+
+			entry.mNode					= spNode;
+			entry.mPortIndex			= p;
+			entry.mNodeName				= node->GetName();
+			entry.mPortName				= port.GetName();
+			entry.mConsumerName			= (limitingConsumer != NULL ? limitingConsumer->GetName() : "");
+			entry.mSampleRate			= sampleRate;
+			entry.mNumLookbackSamples	= numLookbackSamples;
+			entry.mNumHeadroomSamples	= numHeadroomSamples;
+			entry.mIsGrowOnly			= isGrowOnly;
+			mEntries.Add(entry);
+		}
+	}
+
+	mOutputTimes.clear();
+}
+
+
+// check if the last plan still covers all output buffers
+bool BufferPlanner::IsValid(Classifier* classifier, bool allowShrink) const
+{
+	if (allowShrink == true && mIsShrinkPending == true)
+		return false;
+
+	// visit the ports in the same order as the plan
+	const uint32 numEntries = mEntries.Size();
+	uint32 entryIndex = 0;
+
+	const uint32 numNodes = classifier->GetNumNodes();
+	for (uint32 n=0; n<numNodes; ++n)
+	{
+		Node* node = classifier->GetNode(n);
+		if (node->GetNodeType() == Node::NODE_TYPE)
+			continue;
+
+		SPNode* spNode = static_cast<SPNode*>(node);
+		const uint32 numOutPorts = spNode->GetNumOutputPorts();
+		for (uint32 p=0; p<numOutPorts; ++p)
+		{
+			if (IsPlannedPort(spNode, p) == false)
+				continue;
+
+			if (entryIndex >= numEntries)
+				return false;
+
+			const Entry& entry = mEntries[entryIndex++];
+			if (entry.mNode != spNode || entry.mPortIndex != p)
+				return false;
+
+			MultiChannel* channels = spNode->GetOutputPort(p).GetChannels();
+			if (channels->GetNumChannels() != entry.mNumChannels || channels->GetSampleRate() != entry.mSampleRate)
+				return false;
+
+			// recreated channels start with their default size
+			for (uint32 c=0; c<entry.mNumChannels; ++c)
+			{
+				if (channels->GetChannel(c)->GetBufferSize() < entry.mPlannedSize)
+					return false;
+			}
+		}
+	}
+
+	return (entryIndex == numEntries);
+}
+
+
+// samples that queue up on the given input while the consumer waits for its slowest input (inputs are read in sync)
+uint32 BufferPlanner::CalcNumSyncSamples(SPNode* consumer, uint32 inputPortIndex, double sampleRate)
+{
+	const uint32 numInputs = consumer->GetNumInputPorts();
+	if (numInputs < 2 || sampleRate <= 0.0)
+		return 0;
+
+	// the time a sample needs from the inputs of the graph to this port
+	double portTime = 0.0;
+	double maxTime = 0.0;
+	for (uint32 i=0; i<numInputs; ++i)
+	{
+		if (consumer->GetInputPort(i).HasConnection() == false)
+			continue;
+
+		const PortTime inputTime = FindInputTime(consumer, i);
+		const double time = inputTime.mLatency + inputTime.mDelay;
+		if (i == inputPortIndex)
+			portTime = time;
+
+		maxTime = Max(maxTime, time);
+	}
+
+	return (uint32)Math::CeilD((maxTime - portTime) * sampleRate);
+}
+
+
+// maximum latency and delay of an input: the time of the connected output port
+BufferPlanner::PortTime BufferPlanner::FindInputTime(SPNode* node, uint32 inputPortIndex)
+{
+	PortTime time;
+	time.mLatency	= 0.0;
+	time.mDelay		= 0.0;
+
+	Port& input = node->GetInputPort(inputPortIndex);
+	if (input.HasConnection() == false)
+		return time;
+
+	// in case source node is not an SPNode (this can only be a deprecated node or a bug), do nothing
+	Node* sourceNode = input.GetConnection()->GetSourceNode();
+	if (sourceNode->GetNodeType() == Node::NODE_TYPE)
+		return time;
+
+	return FindOutputTime(static_cast<SPNode*>(sourceNode), input.GetConnection()->GetSourcePort());
+}
+
+
+// maximum latency and delay of an output: the slowest input plus the node latency/delay between that input and the output
+const BufferPlanner::PortTime& BufferPlanner::FindOutputTime(SPNode* node, uint32 outputPortIndex)
+{
+	const Port* port = &node->GetOutputPort(outputPortIndex);
+	std::unordered_map<const Port*, PortTime>::const_iterator cached = mOutputTimes.find(port);
+	if (cached != mOutputTimes.end())
+		return cached->second;
+
+	PortTime time;
+	time.mLatency	= 0.0;
+	time.mDelay		= 0.0;
+
+	const uint32 numInputs = node->GetNumInputPorts();
+	for (uint32 i=0; i<numInputs; ++i)
+	{
+		if (node->GetInputPort(i).HasConnection() == false)
+			continue;
+
+		const PortTime inputTime = FindInputTime(node, i);
+		time.mLatency	= Max(time.mLatency, inputTime.mLatency + node->GetLatency(i, outputPortIndex));
+		time.mDelay		= Max(time.mDelay, inputTime.mDelay + node->GetDelay(i, outputPortIndex));
+	}
+
+	// references to the elements stay valid when the map grows
+	PortTime& result = mOutputTimes[port];
+	result = time;
+	return result;
+}
+
+
+// memory of all planned buffers
+uint64 BufferPlanner::CalcNumBytes() const
+{
+	uint64 numBytes = 0;
+
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+		numBytes += mEntries[i].mNumBytes;
+
+	return numBytes;
+}
+
+
+// memory of the planned buffers that holds history read by the consumers (the rest is headroom)
+uint64 BufferPlanner::CalcNumLookbackBytes() const
+{
+	uint64 numBytes = 0;
+
+	const uint32 numEntries = mEntries.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		const Entry& entry = mEntries[i];
+		if (entry.mBufferSize > 0)
+			numBytes += entry.mNumBytes * Min(entry.mNumLookbackSamples, entry.mBufferSize) / entry.mBufferSize;
+	}
+
+	return numBytes;
+}
@@ -0,0 +1,109 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_BUFFERPLANNER_H
+#define __NEUROMORE_BUFFERPLANNER_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+#include "../Core/String.h"
+#include <unordered_map>
+
+// forward declaration
+class Classifier;
+class SPNode;
+class Port;
+
+// sizes the output buffers of a classifier by what their consumers actually read
+//  - lookback: the largest epoch a consumer reads at once, plus the samples that queue up while a consumer with several inputs waits for the slowest one
+//  - headroom: the samples a single update can produce (the classifier buffer duration)
+// sensor outputs (input nodes) are only grown, devices and visualizations read their history directly
+// resizing clears a buffer, so while the session runs buffers are only grown and shrinking waits for the next plan after the session
+class ENGINE_API BufferPlanner
+{
+	public:
+		// the planned size of one output port
+		struct Entry
+		{
+			SPNode*			mNode;
+			uint32			mPortIndex;
+			Core::String	mNodeName;
+			Core::String	mPortName;
+			Core::String	mConsumerName;			// consumer with the largest lookback (empty if no consumer reads more than one sample)
+			uint32			mNumChannels;
+			double			mSampleRate;
+			uint32			mNumLookbackSamples;
+			uint32			mNumHeadroomSamples;
+			uint32			mPlannedSize;			// lookback plus headroom
+			uint32			mBufferSize;			// applied size, larger than planned for grown-only sensor outputs and while the session runs
+			uint64			mNumBytes;				// memory of all channels of the port
+			bool			mIsGrowOnly;
+		};
+
+		// constructor & destructor
+		BufferPlanner();
+		~BufferPlanner();
+
+		// plan and resize the output buffers of all nodes (call after the nodes were reinitialized), larger buffers are only shrunk if allowed
+		void Plan(Classifier* classifier, double headroomSeconds, bool allowShrink);
+		void Clear()															{ mEntries.Clear(); mIsShrinkPending = false; }
+
+		// check if the last plan still covers all output buffers (same ports, channels and sample rates, no buffer smaller than planned)
+		bool IsValid(Classifier* classifier, bool allowShrink) const;
+
+		// the last plan
+		uint32 GetNumEntries() const											{ return mEntries.Size(); }
+		const Entry& GetEntry(uint32 index) const								{ return mEntries[index]; }
+		double GetHeadroomDuration() const										{ return mHeadroomDuration; }
+
+		uint64 CalcNumBytes() const;
+		uint64 CalcNumLookbackBytes() const;
+
+	private:
+		// maximum latency and delay from the inputs of the graph to an output port
+		struct PortTime
+		{
+			double			mLatency;
+			double			mDelay;
+		};
+
+		// buffered output ports in plan order
+		static bool IsPlannedPort(SPNode* node, uint32 outputPortIndex);
+
+		// samples that queue up on the given input while the consumer waits for its slowest input
+		uint32 CalcNumSyncSamples(SPNode* consumer, uint32 inputPortIndex, double sampleRate);
+
+		// memoized version of SPNode::FindMaximumLatencyForInput() and FindMaximumDelayForInput() (the recursion visits shared upstream paths only once)
+		PortTime FindInputTime(SPNode* node, uint32 inputPortIndex);
+		const PortTime& FindOutputTime(SPNode* node, uint32 outputPortIndex);
+
+		Core::Array<Entry>							mEntries;
+		std::unordered_map<const Port*, PortTime>	mOutputTimes;		// only valid during a plan
+		double										mHeadroomDuration;
+		bool										mIsShrinkPending;	// a buffer was kept larger than planned because shrinking was not allowed
+};
+
+
+#endif
@@ -146,14 +146,19 @@ void ChannelMathNode::Update(const Time& elapsed, const Time& delta)
 	if (mIsInitialized == false)
 		return;
 
-	// apply calculate function
+	// read all new samples of all channels into the tile
 	MultiChannelReader* input = GetInputReader();
 	const uint32 numSamples = input->GetMinNumNewSamples();
-	for (uint32 i=0; i<numSamples; ++i)
-	{
-		const double result = RunCalculation(input);
-		mChannel.AddSample(result);
-	}
+	if (numSamples == 0)
+		return;
+
+	const uint32 numChannels = input->GetNumChannels();
+	const uint32 stride = input->PopOldestSamples(numSamples, mTile);
+
+	// apply calculate function on the whole block and write the results in one go
+	mResults.Resize(numSamples);
+	RunCalculation(mTile.GetReadPtr(), stride, numChannels, numSamples, mResults.GetPtr());
+	mChannel.AddSamples(mResults.GetReadPtr(), numSamples);
 }
 
 
@@ -282,176 +287,163 @@ const char* ChannelMathNode::GetFunctionString(EMathFunction function)
 }
 
 
+// NOTE: all functions iterate channel by channel over contiguous rows of the tile, so the inner loops vectorize
+
 // Sum: (s1 + s2 + s3 + ...)
-double ChannelMathNode::CalculateSum(MultiChannelReader* reader)				
+void ChannelMathNode::CalculateSum(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults)
 { 
-	const uint32 numChannels = reader->GetChannels()->GetNumChannels();
+	for (uint32 i=0; i<numSamples; ++i)
+		outResults[i] = 0.0;
 
-	double sum = 0;
 	for (uint32 c=0; c<numChannels; ++c)
 	{
-		double sample = reader->GetReader(c)->PopOldestSample<double>();
-		sum += sample;
+		const double* samples = tile + c * stride;
+		for (uint32 i=0; i<numSamples; ++i)
+			outResults[i] += samples[i];
 	}
-
-	return sum;	
 }
 
 // Product: (s1 * s2 * s3 * ...)
-double ChannelMathNode::CalculateProduct(MultiChannelReader* reader)				
+void ChannelMathNode::CalculateProduct(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults)
 { 
-	const uint32 numChannels = reader->GetChannels()->GetNumChannels();
+	for (uint32 i=0; i<numSamples; ++i)
+		outResults[i] = 1.0;
 
-	double product = 1;
 	for (uint32 c=0; c<numChannels; ++c)
 	{
-		double sample = reader->GetReader(c)->PopOldestSample<double>();
-		product *= sample;
+		const double* samples = tile + c * stride;
+		for (uint32 i=0; i<numSamples; ++i)
+			outResults[i] *= samples[i];
 	}
-
-	return product;	
 }
 
 // Average: (s1 + s2 + s3 + ...) / n
-double ChannelMathNode::CalculateAverage(MultiChannelReader* reader)				
+void ChannelMathNode::CalculateAverage(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults)
 { 
-	const uint32 numChannels = reader->GetChannels()->GetNumChannels();
+	CalculateSum(tile, stride, numChannels, numSamples, outResults);
 
-	double sum = 0;
-	for (uint32 c=0; c<numChannels; ++c)
-	{
-		double sample = reader->GetReader(c)->PopOldestSample<double>();
-		sum += sample;
-	}
-
-	double average = sum / (double)numChannels;
-	return average;	
+	const double n = (double)numChannels;
+	for (uint32 i=0; i<numSamples; ++i)
+		outResults[i] /= n;
 }
 
 
 // Minimum: Min(s1, s2, ...)
-double ChannelMathNode::CalculateMin(MultiChannelReader* reader)				
+void ChannelMathNode::CalculateMin(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults)
 { 
-	const uint32 numChannels = reader->GetChannels()->GetNumChannels();
-
 	// guard agains div by zero
-	if (numChannels == 0)
-		return 0;
+	const double initialValue = (numChannels == 0 ? 0.0 : DBL_MAX);
+	for (uint32 i=0; i<numSamples; ++i)
+		outResults[i] = initialValue;
 
-	double minVal = DBL_MAX;
 	for (uint32 c=0; c<numChannels; ++c)
 	{
-		double sample = reader->GetReader(c)->PopOldestSample<double>();
-		minVal = Min<double>(minVal, sample);
+		const double* samples = tile + c * stride;
+		for (uint32 i=0; i<numSamples; ++i)
+			outResults[i] = (samples[i] < outResults[i] ? samples[i] : outResults[i]);
 	}
-
-	return minVal;	
 }
 
 // Maximum: Max(s1, s2, ...)
-double ChannelMathNode::CalculateMax(MultiChannelReader* reader)				
+void ChannelMathNode::CalculateMax(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults)
 { 
-	const uint32 numChannels = reader->GetChannels()->GetNumChannels();
-	
-	double maxVal = -DBL_MAX;
+	for (uint32 i=0; i<numSamples; ++i)
+		outResults[i] = -DBL_MAX;
+
 	for (uint32 c=0; c<numChannels; ++c)
 	{
-		double sample = reader->GetReader(c)->PopOldestSample<double>();
-		maxVal = Max<double>(maxVal, sample);
+		const double* samples = tile + c * stride;
+		for (uint32 i=0; i<numSamples; ++i)
+			outResults[i] = (samples[i] > outResults[i] ? samples[i] : outResults[i]);
 	}
-
-	return maxVal;	
 }
 
 // Harmonic Mean: result = n / (1/s1 + 1/s2 + 1/s3 + ...)
-double ChannelMathNode::CalculateHarmonicMean(MultiChannelReader* reader)				
+void ChannelMathNode::CalculateHarmonicMean(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults)
 { 
-	const uint32 numChannels = reader->GetChannels()->GetNumChannels();
+	// sum of reciprocals (zero samples are skipped here and handled below)
+	for (uint32 i=0; i<numSamples; ++i)
+		outResults[i] = 0.0;
 
-	double result = 0;
 	for (uint32 c=0; c<numChannels; ++c)
 	{
-		const double sample = reader->GetReader(c)->PopOldestSample<double>();
-
-		// harmonic mean is 0 if one term is 0
-		if (sample == 0)
-			return 0;
-
-		const double reciprocal = 1.0 / sample;
-		result += reciprocal;
+		const double* samples = tile + c * stride;
+		for (uint32 i=0; i<numSamples; ++i)
+			outResults[i] += (samples[i] != 0.0 ? 1.0 / samples[i] : 0.0);
 	}
 
-	// NOTE: result can only be zero if numChannels == 0, and we catch that earlier
-	//  Update: can also be zero if sample == DBL_MAX? lets better check to be sure no div by zero happens
-
-	if (result == 0.0)
-		return 0;
+	// harmonic mean is 0 if one term is 0
+	for (uint32 c=0; c<numChannels; ++c)
+	{
+		const double* samples = tile + c * stride;
+		for (uint32 i=0; i<numSamples; ++i)
+			outResults[i] = (samples[i] != 0.0 ? outResults[i] : 0.0);
+	}
 
 	// n / sum
-	result = (double)numChannels / result;
-
-	return result;	
+	// NOTE: sum can also be zero if sample == DBL_MAX? lets better check to be sure no div by zero happens
+	const double n = (double)numChannels;
+	for (uint32 i=0; i<numSamples; ++i)
+		outResults[i] = (outResults[i] != 0.0 ? n / outResults[i] : 0.0);
 }
 
 
 // Geometric Mean: n-th root of ( s1 * s2 * ...)
-double ChannelMathNode::CalculateGeometricMean(MultiChannelReader* reader)				
+void ChannelMathNode::CalculateGeometricMean(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults)
 { 
-	const uint32 numChannels = reader->GetChannels()->GetNumChannels();
-
 	// guard agains div by zero
 	if (numChannels == 0)
-		return 0;
-
-	double result = CalculateProduct(reader);
+	{
+		for (uint32 i=0; i<numSamples; ++i)
+			outResults[i] = 0.0;
+		return;
+	}
 
-	// cannot have negative value in geometric mean :) (roots, dude!)
-	if (result <= 0)
-		return 0;
+	CalculateProduct(tile, stride, numChannels, numSamples, outResults);
 
 	// n-th root
 	const double exponent = 1.0 / (double)numChannels;
-	result = Math::PowD(result, exponent);
-
-	return result;	
-
+	for (uint32 i=0; i<numSamples; ++i)
+	{
+		// cannot have negative value in geometric mean :) (roots, dude!)
+		if (outResults[i] <= 0)
+			outResults[i] = 0.0;
+		else
+			outResults[i] = Math::PowD(outResults[i], exponent);
+	}
 }
 
 // Root Mean Square (quadratic mean): root of (mean of (sum of squares))
-double ChannelMathNode::CalculateRootMeanSquare(MultiChannelReader* reader)				
+void ChannelMathNode::CalculateRootMeanSquare(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults)
 { 
-	const uint32 numChannels = reader->GetChannels()->GetNumChannels();
-	
 	// guard agains div by zero
 	if (numChannels == 0)
-		return 0;
+	{
+		for (uint32 i=0; i<numSamples; ++i)
+			outResults[i] = 0.0;
+		return;
+	}
 
 	// sum of squares
-	double result = CalculateSumOfSquares(reader);
+	CalculateSumOfSquares(tile, stride, numChannels, numSamples, outResults);
 
-	// mean
-	result = result / (double)numChannels;
-
-	// square root
-	result = Math::SqrtD(result);
-
-	return result;	
+	// square root of the mean
+	const double n = (double)numChannels;
+	for (uint32 i=0; i<numSamples; ++i)
+		outResults[i] = Math::SqrtD(outResults[i] / n);
 }
 
 
 // Sum of Square: s1*s1 + s2*s2 + s3*s3 + ....
-double ChannelMathNode::CalculateSumOfSquares(MultiChannelReader* reader)				
+void ChannelMathNode::CalculateSumOfSquares(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults)
 { 
-	const uint32 numChannels = reader->GetChannels()->GetNumChannels();
+	for (uint32 i=0; i<numSamples; ++i)
+		outResults[i] = 0.0;
 
-	double sum = 0;
 	for (uint32 c=0; c<numChannels; ++c)
 	{
-		double sample = reader->GetReader(c)->PopOldestSample<double>();
-		const double sampleSquared = sample * sample;
-		sum += sampleSquared;
+		const double* samples = tile + c * stride;
+		for (uint32 i=0; i<numSamples; ++i)
+			outResults[i] += samples[i] * samples[i];
 	}
-	return sum;	
 }
-
-
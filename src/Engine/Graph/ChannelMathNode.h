@@ -95,20 +95,24 @@ class ENGINE_API ChannelMathNode : public SPNode
 
 		const char* GetFunctionString(EMathFunction function);
 
-		// Math functions 
-		typedef double (CORE_CDECL *MathFunction)(MultiChannelReader* reader);
-		static double CORE_CDECL CalculateSum(MultiChannelReader* reader);
-		static double CORE_CDECL CalculateProduct(MultiChannelReader* reader);
-
-		static double CORE_CDECL CalculateAverage(MultiChannelReader* reader);
-		static double CORE_CDECL CalculateMin(MultiChannelReader* reader);
-		static double CORE_CDECL CalculateMax(MultiChannelReader* reader);
+		// Math functions (block versions: reduce a channel-major tile of numChannels x numSamples into numSamples results)
+		typedef void (CORE_CDECL *MathFunction)(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults);
+		static void CORE_CDECL CalculateSum(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults);
+		static void CORE_CDECL CalculateProduct(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults);
+
+		static void CORE_CDECL CalculateAverage(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults);
+		static void CORE_CDECL CalculateMin(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults);
+		static void CORE_CDECL CalculateMax(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults);
 		
-		static double CORE_CDECL CalculateHarmonicMean(MultiChannelReader* reader);
-		static double CORE_CDECL CalculateGeometricMean(MultiChannelReader* reader);
-		static double CORE_CDECL CalculateRootMeanSquare(MultiChannelReader* reader);
-		static double CORE_CDECL CalculateSumOfSquares(MultiChannelReader* reader);
+		static void CORE_CDECL CalculateHarmonicMean(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults);
+		static void CORE_CDECL CalculateGeometricMean(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults);
+		static void CORE_CDECL CalculateRootMeanSquare(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults);
+		static void CORE_CDECL CalculateSumOfSquares(const double* tile, uint32 stride, uint32 numChannels, uint32 numSamples, double* outResults);
 		
+		// scratch memory for the block processing (reused across updates)
+		Core::Array<double> mTile;
+		Core::Array<double> mResults;
+
 		// Active math function
 		MathFunction RunCalculation;
 };
@@ -38,7 +38,8 @@ Classifier::Classifier(Graph* parentNode) : Graph(parentNode)
 	mIsDirty		= false;
 	mIsRunning		= true;
 	mIsFinalized	= false;
-	mBufferDuration	= 10.0;
+	mIsBufferPlanDirty = true;
+	mBufferDuration	= 2.0;
 }
 
 
@@ -51,6 +52,8 @@ Classifier::~Classifier()
 // update the graph
 void Classifier::Update(const Time& elapsed, const Time& delta)
 {
+	MemoryTagScope memoryTag(MEMORYTAG_GRAPH);
+
 	// start performance timing
 	mFpsCounter.BeginTiming();
 		
@@ -67,13 +70,19 @@ void Classifier::Update(const Time& elapsed, const Time& delta)
 		/////////////////////////////////////////////////////////////
 		// Phase 2: Update
 		
+		// once the session runs, the update is real-time: heap activity is counted per memory tag
+		RealtimeScope realtime(GetSession()->IsRunning());
+
 		// reset update ready flags for all nodes
 		ResetUpdateReadyFlags();
 
+		// release the scratch memory of the last update
+		mScratchArena.Reset();
+
 		// update all nodes
 		const uint32 numEndNodes = mEndNodes.Size();
 		for (uint32 i = 0; i<numEndNodes; ++i)
-			mEndNodes[i]->Update(elapsed, delta);
+			Node::UpdateNode(mEndNodes[i], elapsed, delta);
 	}
 
 	// always update channel activity (but only required for rendering) 
@@ -103,6 +112,7 @@ void Classifier::Reset()
 void Classifier::ReInitAsync()
 {
 	mIsFinalized = false;
+	mIsBufferPlanDirty = true;
 }
 
 
@@ -115,10 +125,12 @@ void Classifier::ReInit(const Time& elapsed, const Time& delta)
 	// recursively reinit all nodes, beginning with the endnodes
 	const uint32 numEndNodes = mEndNodes.Size();
 	for (uint32 i = 0; i<numEndNodes; ++i)
-		mEndNodes[i]->ReInit(elapsed, delta);
+		Node::ReInitNode(mEndNodes[i], elapsed, delta);
 
-	// resize buffers
-	ResizeBuffers(mBufferDuration);
+	// resize buffers only if the graph changed (the nodes are reinitialized at every update)
+	const bool allowShrink = (GetSession()->IsRunning() == false);
+	if (mIsBufferPlanDirty == true || mBufferPlanner.IsValid(this, allowShrink) == false)
+		ResizeBuffers();
 }
 
 
@@ -160,33 +172,14 @@ void Classifier::Continue()
 }
 
 
-// reset the resize buffer ready flag of all nodes
-void Classifier::ResetResizeBuffersReadyFlags()
+// plan the size of all output buffers: the lookback of their consumers plus the headroom of one update
+void Classifier::ResizeBuffers()
 {
-	// get the number of nodes, iterate through them and reset their update ready flag
-	const uint32 numNodes = mNodes.Size();
-	for (uint32 i=0; i<numNodes; ++i)
-	{
-		Node* node = mNodes[i];
-		const uint32 nodeType = node->GetNodeType();
+	// resizing clears the buffers: never shrink them while the session runs
+	const bool allowShrink = (GetSession()->IsRunning() == false);
+	mBufferPlanner.Plan(this, mBufferDuration, allowShrink);
 
-		// update only SPNodes
-		if (nodeType != Node::NODE_TYPE)
-			static_cast<SPNode*>(node)->SetResizeBuffersReady(false);
-	}
-}
-
-
-// resize all buffers in the graph to hold at least this many seconds of samples
-void Classifier::ResizeBuffers(double seconds)
-{
-	// reset resize buffer flags of all nodes
-	ResetResizeBuffersReadyFlags();
-
-	// call recursive buffer resize, beginning with the end nodes
-	const uint32 numEndNodes = mEndNodes.Size();
-	for (uint32 i = 0; i<numEndNodes; ++i)
-		mEndNodes[i]->ResizeBuffers(seconds);
+	mIsBufferPlanDirty = false;
 }
 
 
@@ -248,6 +241,7 @@ void Classifier::CollectNodes()
 	uint32 numPointNodes			= 0;
 	uint32 numViewNodes				= 0;
 	uint32 numLoretaNodes			= 0;
+	uint32 numTopographicMapNodes	= 0;
 	uint32 numParameterNodes		= 0;
 	uint32 numCloudInputNodes		= 0;
 	uint32 numCloudOutputNodes		= 0;
@@ -288,6 +282,10 @@ void Classifier::CollectNodes()
 		else if (node->GetType() == LoretaNode::TYPE_ID)
 			numLoretaNodes++;
 
+		// is the given node a topographic map node?
+		else if (node->GetType() == TopographicMapNode::TYPE_ID)
+			numTopographicMapNodes++;
+
 		// is the node an input of the graph?
 		else if (node->GetType() == ParameterNode::TYPE_ID)
 			numParameterNodes++;
@@ -337,6 +335,7 @@ void Classifier::CollectNodes()
 	if (mPointsNodes.Size() != numPointNodes)					mPointsNodes.Resize( numPointNodes );
 	if (mViewNodes.Size() != numViewNodes)						mViewNodes.Resize(numViewNodes);
 	if (mLoretaNodes.Size() != numLoretaNodes)					mLoretaNodes.Resize(numLoretaNodes);
+	if (mTopographicMapNodes.Size() != numTopographicMapNodes)	mTopographicMapNodes.Resize(numTopographicMapNodes);
 	if (mParameterNodes.Size() != numParameterNodes)			mParameterNodes.Resize(numParameterNodes);
 	if (mCloudInputNodes.Size() != numCloudInputNodes)			mCloudInputNodes.Resize(numCloudInputNodes);
 	if (mCloudOutputNodes.Size() != numCloudOutputNodes)		mCloudOutputNodes.Resize(numCloudOutputNodes);
@@ -351,6 +350,7 @@ void Classifier::CollectNodes()
 	uint32 pointNodeIndex = 0;
 	uint32 viewNodeIndex = 0;
 	uint32 loretaNodeIndex = 0;
+	uint32 topographicMapNodeIndex = 0;
 	uint32 parameterNodeIndex = 0;
 	uint32 cloudInputNodeIndex = 0;
 	uint32 cloudOutputNodeIndex = 0;
@@ -407,6 +407,13 @@ void Classifier::CollectNodes()
 			loretaNodeIndex++;
 		}
 
+		// is the given node a topographic map node?
+		else if (node->GetType() == TopographicMapNode::TYPE_ID)
+		{
+			mTopographicMapNodes[topographicMapNodeIndex] = static_cast<TopographicMapNode*>(node);
+			topographicMapNodeIndex++;
+		}
+
 		// is the given node a parameter node?
 		else if (node->GetType() == ParameterNode::TYPE_ID)
 		{
@@ -478,6 +485,7 @@ void Classifier::CollectNodes()
 	mCustomFeedbackNodes.Sort(NodeVisualYCompare);
 	mViewNodes.Sort(NodeVisualYCompare);
 	mLoretaNodes.Sort(NodeVisualYCompare);
+	mTopographicMapNodes.Sort(NodeVisualYCompare);
 	mParameterNodes.Sort(NodeVisualYCompare);
 	mCloudInputNodes.Sort(NodeVisualYCompare);
 	mCloudOutputNodes.Sort(NodeVisualYCompare);
@@ -964,6 +972,9 @@ void Classifier::OnGraphModified(Graph* graph, GraphObject* object)
 
 	// immediately update nodes lists
 	CollectObjects();
+
+	// replan the buffers with the next reinit
+	mIsBufferPlanDirty = true;
 }
 
 
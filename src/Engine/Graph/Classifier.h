@@ -28,7 +28,9 @@
 #include "../Config.h"
 #include "../Core/Array.h"
 #include "../Core/EventHandler.h"
+#include "../Core/ScratchArena.h"
 #include "Graph.h"
+#include "BufferPlanner.h"
 #include "CustomFeedbackNode.h"
 #include "BodyFeedbackNode.h"
 #include "PointsNode.h"
@@ -36,6 +38,7 @@
 #include "InputNode.h"
 #include "ViewNode.h"
 #include "LoretaNode.h"
+#include "TopographicMapNode.h"
 #include "ThresholdNode.h"
 #include "ParameterNode.h"
 #include "CloudInputNode.h"
@@ -107,6 +110,10 @@ class ENGINE_API Classifier : public Graph, public Core::EventHandler
 		LoretaNode* GetLoretaNode(uint32 index) const						{ return mLoretaNodes[index]; }
 		uint32 GetNumLoretaNodes() const									{ return mLoretaNodes.Size(); }
 
+		// Topographic map nodes
+		TopographicMapNode* GetTopographicMapNode(uint32 index) const		{ return mTopographicMapNodes[index]; }
+		uint32 GetNumTopographicMapNodes() const							{ return mTopographicMapNodes.Size(); }
+
 		// Annotation nodes
 		AnnotationNode* GetAnnotationNode(uint32 index) const				{ return mAnnotationNodes[index]; }
 		uint32 GetNumAnnotationNodes() const								{ return mAnnotationNodes.Size(); }
@@ -174,15 +181,16 @@ class ENGINE_API Classifier : public Graph, public Core::EventHandler
 		//  Buffers
 		//
 		
-		// the the number of seconds the buffers can hold at maximum
-		void SetBufferDuration(double seconds)								{ mBufferDuration = seconds; }
+		// the longest time span a single update may cover: every buffer holds this many seconds on top of what its consumers read at once
+		void SetBufferDuration(double seconds)								{ mBufferDuration = seconds; mIsBufferPlanDirty = true; }
+		double GetBufferDuration() const									{ return mBufferDuration; }
 
 		// reset buffers
 		void ResetBuffers();
 
-		// recursive resize of all buffers
-		void ResizeBuffers(double seconds);
-		void ResetResizeBuffersReadyFlags();
+		// size all output buffers by the lookback of their consumers (done during reinit if the graph changed or the plan does not cover all buffers anymore)
+		void ResizeBuffers();
+		const BufferPlanner& GetBufferPlanner() const						{ return mBufferPlanner; }
 
 		//
 		// Sync and Timing
@@ -221,6 +229,9 @@ class ENGINE_API Classifier : public Graph, public Core::EventHandler
 		// number of buffers
 		uint32 CalcNumBufferChannelsUsed() const;
 
+		// temporary memory for the node processors, reset at the beginning of every update
+		Core::ScratchArena& GetScratchArena()								{ return mScratchArena; }
+
 	
 	protected:
 		// graph internal callback
@@ -233,6 +244,7 @@ class ENGINE_API Classifier : public Graph, public Core::EventHandler
 		Core::Array<PointsNode*>				mPointsNodes;			// point output nodes
 		Core::Array<ViewNode*>					mViewNodes;				// all instances of ViewNode
 		Core::Array<LoretaNode*>				mLoretaNodes;			// all instances of LoretaNode
+		Core::Array<TopographicMapNode*>		mTopographicMapNodes;	// all instances of TopographicMapNode
 		Core::Array<ParameterNode*>				mParameterNodes;		// all instances of ParameterNode
 		Core::Array<CloudInputNode*>			mCloudInputNodes;		// all instances of CloudInputNode
 		Core::Array<CloudOutputNode*>			mCloudOutputNodes;		// all instances of CloudOutputNode
@@ -251,10 +263,14 @@ class ENGINE_API Classifier : public Graph, public Core::EventHandler
 		Core::Array<MultiChannel>				mViewSpectrumChannels;	// all view channels (Spectrum)
 		Core::Array<ViewNode*>					mViewNodeSpectrumMap;	// all the nodes that provide the spectrum channels
 
+		Core::ScratchArena						mScratchArena;			// shared scratch memory of all node processors
+		BufferPlanner							mBufferPlanner;			// the buffer sizes planned during the last replan
+
 		bool	mIsRunning;				
 		bool	mIsPaused;				
 		bool	mIsFinalized;			// true, after finalize() was called, until something is changed
-		double  mBufferDuration;		// number of seconds the buffers can take (also defines the absolute minimum update frequency)
+		bool	mIsBufferPlanDirty;		// replan the buffers during the next reinit
+		double  mBufferDuration;		// buffer headroom in seconds (also defines the absolute minimum update frequency)
 };
 
 
@@ -344,7 +344,7 @@ void DeviceInputNode::OnAttributesChanged()
 // find the first corresponding device
 Device* DeviceInputNode::FindDevice()
 {
-	uint32 deviceID = GetInt32AttributeByName("ID");
+	uint32 deviceID = GetInt32Attribute(ATTRIB_DEVICEINDEX);
 	if (deviceID == 0)
 		deviceID = 1;
 	
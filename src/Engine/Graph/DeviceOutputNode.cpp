@@ -240,7 +240,7 @@ void DeviceOutputNode::OnAttributesChanged()
 // find the first corresponding device
 Device* DeviceOutputNode::FindDevice()
 {
-	uint32 deviceID = GetInt32AttributeByName("ID");
+	uint32 deviceID = GetInt32Attribute(ATTRIB_DEVICEINDEX);
 	if (deviceID == 0)
 		deviceID = 1;
 	
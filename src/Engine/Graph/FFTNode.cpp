@@ -68,7 +68,7 @@ void FFTNode::Init()
 	FFTOrderAttr->SetMaxValue(Core::AttributeInt32::Create(20));
 
 	// window type
-	Core::AttributeSettings* winFuncAttr = RegisterAttribute( "Window Function", "WindowFunction", "The Time-Domain Window Function that is applied to the input of the FFT.", Core::ATTRIBUTE_INTERFACETYPE_WINDOWFUNCTION );
+	Core::AttributeSettings* winFuncAttr = RegisterAttribute( "Window Function", "WindowFunction", "The Time-Domain Window Function that is applied to the input of the FFT (if 'Apply Window' is enabled).", Core::ATTRIBUTE_INTERFACETYPE_WINDOWFUNCTION );
 	winFuncAttr->ResizeComboValues( WindowFunction::WINDOWFUNCTION_NUMFUNCTIONS );
 	for (uint32 i = 0; i < WindowFunction::WINDOWFUNCTION_NUMFUNCTIONS; i++)
 		winFuncAttr->SetComboValue(i, WindowFunction::GetName((WindowFunction::EWindowFunction)i));
@@ -79,6 +79,47 @@ void FFTNode::Init()
 	winShiftAttr->SetDefaultValue(Core::AttributeInt32::Create(mSettings.mEpochShift));
 	winShiftAttr->SetMinValue(Core::AttributeInt32::Create(1));
 	winShiftAttr->SetMaxValue(Core::AttributeInt32::Create(1024));
+
+	// DC removal
+	Core::AttributeSettings* removeDCAttr = RegisterAttribute( "Remove DC", "RemoveDC", "Subtract the mean of each input window before the FFT.", Core::ATTRIBUTE_INTERFACETYPE_CHECKBOX );
+	removeDCAttr->SetDefaultValue(Core::AttributeBool::Create(mSettings.mRemoveDC));
+
+	// sliding DFT
+	Core::AttributeSettings* slidingAttr = RegisterAttribute( "Sliding DFT", "SlidingDFT", "Update the spectrum with every input sample instead of recalculating the whole FFT (only for cosine windows like Hann, Hamming or Blackman).", Core::ATTRIBUTE_INTERFACETYPE_CHECKBOX );
+	slidingAttr->SetDefaultValue(Core::AttributeBool::Create(mSettings.mSlidingDFT));
+
+	// sliding DFT frequency range
+	Core::AttributeSettings* minFreqAttr = RegisterAttribute( "Lower Frequency", "MinFrequency", "Sliding DFT only: lower bound of the calculated frequency range.", Core::ATTRIBUTE_INTERFACETYPE_FLOATSLIDER );
+	minFreqAttr->SetDefaultValue(Core::AttributeFloat::Create(mSettings.mMinFrequency));
+	minFreqAttr->SetMinValue(Core::AttributeFloat::Create(0));
+	minFreqAttr->SetMaxValue(Core::AttributeFloat::Create(200));
+
+	Core::AttributeSettings* maxFreqAttr = RegisterAttribute( "Upper Frequency", "MaxFrequency", "Sliding DFT only: upper bound of the calculated frequency range (0 = all frequencies).", Core::ATTRIBUTE_INTERFACETYPE_FLOATSLIDER );
+	maxFreqAttr->SetDefaultValue(Core::AttributeFloat::Create(mSettings.mMaxFrequency));
+	maxFreqAttr->SetMinValue(Core::AttributeFloat::Create(0));
+	maxFreqAttr->SetMaxValue(Core::AttributeFloat::Create(200));
+
+	// spectral estimator
+	Core::AttributeSettings* estimatorAttr = RegisterAttribute( "Estimator", "Estimator", "Single periodogram per window or averaged power spectrum (Welch: overlapping segments, Multitaper: DPSS tapers). Use a larger window shift to reduce the output rate.", Core::ATTRIBUTE_INTERFACETYPE_COMBOBOX );
+	estimatorAttr->ResizeComboValues(3);
+	estimatorAttr->SetComboValue(FFTProcessor::FFTSettings::ESTIMATOR_PERIODOGRAM, "Periodogram");
+	estimatorAttr->SetComboValue(FFTProcessor::FFTSettings::ESTIMATOR_WELCH, "Welch");
+	estimatorAttr->SetComboValue(FFTProcessor::FFTSettings::ESTIMATOR_MULTITAPER, "Multitaper");
+	estimatorAttr->SetDefaultValue(Core::AttributeInt32::Create(mSettings.mEstimator));
+
+	Core::AttributeSettings* numSegmentsAttr = RegisterAttribute( "Welch Segments", "NumSegments", "Welch only: number of 50% overlapping segments that are averaged.", Core::ATTRIBUTE_INTERFACETYPE_INTSPINNER );
+	numSegmentsAttr->SetDefaultValue(Core::AttributeInt32::Create(mSettings.mNumSegments));
+	numSegmentsAttr->SetMinValue(Core::AttributeInt32::Create(1));
+	numSegmentsAttr->SetMaxValue(Core::AttributeInt32::Create(64));
+
+	Core::AttributeSettings* timeBandwidthAttr = RegisterAttribute( "Time-Bandwidth", "TimeBandwidth", "Multitaper only: time-bandwidth product NW (2NW-1 tapers are averaged).", Core::ATTRIBUTE_INTERFACETYPE_FLOATSPINNER );
+	timeBandwidthAttr->SetDefaultValue(Core::AttributeFloat::Create(mSettings.mTimeBandwidth));
+	timeBandwidthAttr->SetMinValue(Core::AttributeFloat::Create(1.0));
+	timeBandwidthAttr->SetMaxValue(Core::AttributeFloat::Create(16.0));
+
+	// windowing is opt-in: graphs saved before this attribute existed always got the rectangular window
+	Core::AttributeSettings* applyWindowAttr = RegisterAttribute( "Apply Window", "ApplyWindow", "Multiply the input of the FFT with the selected window function (the amplitudes are corrected by the window's coherent gain). If disabled, the rectangular window is used.", Core::ATTRIBUTE_INTERFACETYPE_CHECKBOX );
+	applyWindowAttr->SetDefaultValue(Core::AttributeBool::Create(mSettings.mApplyWindow));
 }
 
 
@@ -111,11 +152,27 @@ void FFTNode::OnAttributesChanged()
 	const uint32 fftOrder = GetInt32Attribute(ATTRIB_FFTORDER);
 	const uint32 shiftSteps = GetInt32Attribute(ATTRIB_SHIFTSAMPLES);
 	const uint32 windowFunctionID = GetInt32Attribute(ATTRIB_WINDOWFUNCTION);
+	const bool applyWindow = GetBoolAttribute(ATTRIB_APPLYWINDOW);
+	const bool removeDC = GetBoolAttribute(ATTRIB_REMOVEDC);
+	const bool slidingDFT = GetBoolAttribute(ATTRIB_SLIDINGDFT);
+	const double minFrequency = GetFloatAttribute(ATTRIB_MINFREQ);
+	const double maxFrequency = GetFloatAttribute(ATTRIB_MAXFREQ);
+	const uint32 estimator = GetInt32Attribute(ATTRIB_ESTIMATOR);
+	const uint32 numSegments = GetInt32Attribute(ATTRIB_NUMSEGMENTS);
+	const double timeBandwidth = GetFloatAttribute(ATTRIB_TIMEBANDWIDTH);
 
 	// check if settings have changed
 	if (mSettings.mFFTOrder == fftOrder && 
 		mSettings.mEpochShift == shiftSteps && 
-		mSettings.mWindowFunction.GetType() == (WindowFunction::EWindowFunction)windowFunctionID)
+		mSettings.mWindowFunction.GetType() == (WindowFunction::EWindowFunction)windowFunctionID &&
+		mSettings.mApplyWindow == applyWindow &&
+		mSettings.mRemoveDC == removeDC &&
+		mSettings.mSlidingDFT == slidingDFT &&
+		mSettings.mMinFrequency == minFrequency &&
+		mSettings.mMaxFrequency == maxFrequency &&
+		mSettings.mEstimator == (FFTProcessor::FFTSettings::EEstimator)estimator &&
+		mSettings.mNumSegments == numSegments &&
+		mSettings.mTimeBandwidth == timeBandwidth)
 	{
 		return;
 	}
@@ -123,6 +180,14 @@ void FFTNode::OnAttributesChanged()
 	mSettings.mFFTOrder = fftOrder;
 	mSettings.mEpochShift = shiftSteps;
 	mSettings.mWindowFunction.SetType((WindowFunction::EWindowFunction)windowFunctionID);
+	mSettings.mApplyWindow = applyWindow;
+	mSettings.mRemoveDC = removeDC;
+	mSettings.mSlidingDFT = slidingDFT;
+	mSettings.mMinFrequency = minFrequency;
+	mSettings.mMaxFrequency = maxFrequency;
+	mSettings.mEstimator = (FFTProcessor::FFTSettings::EEstimator)estimator;
+	mSettings.mNumSegments = numSegments;
+	mSettings.mTimeBandwidth = timeBandwidth;
 
 	ResetAsync();
 }
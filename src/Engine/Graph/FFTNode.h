@@ -41,7 +41,15 @@ class ENGINE_API FFTNode : public ProcessorNode
 		{
 			ATTRIB_FFTORDER			= 0,
 			ATTRIB_WINDOWFUNCTION	= 1,
-			ATTRIB_SHIFTSAMPLES		= 2
+			ATTRIB_SHIFTSAMPLES		= 2,
+			ATTRIB_REMOVEDC			= 3,
+			ATTRIB_SLIDINGDFT		= 4,
+			ATTRIB_MINFREQ			= 5,
+			ATTRIB_MAXFREQ			= 6,
+			ATTRIB_ESTIMATOR		= 7,
+			ATTRIB_NUMSEGMENTS		= 8,
+			ATTRIB_TIMEBANDWIDTH	= 9,
+			ATTRIB_APPLYWINDOW		= 10
 
 		};
 
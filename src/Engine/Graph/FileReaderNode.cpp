@@ -33,6 +33,8 @@ using namespace Core;
 FileReaderNode::FileReaderNode(Graph* graph) : InputNode(graph)
 {
 	mHasLoadError = false;
+	mHasData = false;
+	mNumSamples = 0;
 
 	// color output channels automatically
 	UseChannelColoring();
@@ -267,6 +269,7 @@ void FileReaderNode::Start(const Time& elapsed)
 		sensor->Reset();
 		sensor->SetName(mFileChannels[i]->GetName());
 		sensor->SetDriftCorrectionEnabled(false);
+		sensor->GetInput()->SetSampleRate(mFileChannels[i]->GetSampleRate());	// samples are generated at the file rate, forward them instead of holding the last one
 		sensor->SetSampleRate(mFileChannels[i]->GetSampleRate());
 		sensor->GetChannel()->SetBufferSize(100);	// arbitrary start buffer size 
 		channels->AddChannel(sensor->GetChannel());
@@ -328,11 +331,18 @@ void FileReaderNode::GenerateSamples()
 
 	const uint32 numNewSamples = mClock.GetNumNewTicks();
 	const uint32 numChannels = GetNumSensors();			
+	const bool loop = (GetEngine()->IsOfflineMode() == false);
 	
 	// push samples from data channels into sensor queue
 	for (uint32 i = 0; i < numNewSamples; ++i)
 	{
-		const uint32 sampleIndex = mClock.PopOldestTick() % (uint64)mNumSamples;	// index loop happens here
+		const uint64 tick = mClock.PopOldestTick();
+
+		// offline playback ends with the recording
+		if (loop == false && tick >= (uint64)mNumSamples)
+			continue;
+
+		const uint32 sampleIndex = tick % (uint64)mNumSamples;	// index loop happens here
 		for (uint32 c = 0; c < numChannels; ++c)
 		{
 			const double sampleValue = mFileChannels[c]->GetSample(sampleIndex);
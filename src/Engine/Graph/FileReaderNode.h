@@ -85,6 +85,11 @@ class ENGINE_API FileReaderNode : public InputNode
 
 		void GenerateSamples() override;
 
+		// true once every sample of the file was played back (in offline mode playback stops there, otherwise the file is looped)
+		bool IsEndOfData() const												{ return mHasData == true && mClock.GetElapsedTicks() >= (uint64)mNumSamples; }
+		bool HasData() const													{ return mHasData; }
+		bool HasLoadError() const												{ return mHasLoadError; }
+
 		bool IsUploadEnabled() const											{ return false; }
 
 	private:
@@ -46,6 +46,9 @@ FileWriterNode::FileWriterNode(Graph* graph) : SPNode(graph)
 // destructor
 FileWriterNode::~FileWriterNode()
 {
+	// close file, if open
+	if (mFile != NULL)
+		fclose(mFile);
 }
 
 
@@ -211,6 +214,7 @@ void FileWriterNode::ReInit(const Time& elapsed, const Time& delta)
 					mHasWriteError = true;
 					mIsInitialized = false;
 					fclose( mFile );
+					mFile = NULL;
 				}
 				else
 				{
@@ -254,8 +258,11 @@ void FileWriterNode::Update(const Time& elapsed, const Time& delta)
 
 	mClock.Update(elapsed, delta);
 
+	// offline mode writes on every update, so nothing is left unwritten when the recording ends
+	const bool isOffline = GetEngine()->IsOfflineMode();
+
 	// write out data on every clock tick (may tick more than once during very long engine stalls, we ignore that)
-	if (mClock.GetNumNewTicks() > 0)
+	if (mClock.GetNumNewTicks() > 0 || isOffline == true)
 	{
 		mClock.ClearNewTicks();
 
@@ -272,8 +279,8 @@ void FileWriterNode::Update(const Time& elapsed, const Time& delta)
 			mHasWriteError = true;
 		}
 
-			// force write to disk
-		if (mFile != NULL)
+		// force write to disk (offline runs write far more often, the file is flushed when it gets closed)
+		if (mFile != NULL && isOffline == false)
 			fflush( mFile );
 
 		// mark samples as processed
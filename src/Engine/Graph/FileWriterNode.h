@@ -54,6 +54,15 @@ class ENGINE_API FileWriterNode : public SPNode
 			ERROR_FILE_ALREADY_EXISTS	= GraphObjectError::ERROR_RUNTIME | 0x02,
 		};
 
+		// values of the write mode attribute
+		enum EWriteMode
+		{
+			WRITEMODE_KEEP = 0, 
+			WRITEMODE_OVERWRITE_ALWAYS,
+			WRITEMODE_OVERWRITE_SESSION,
+			WRITEMODE_APPEND
+		};
+
 
 		// constructor & destructor
 		FileWriterNode(Graph* graph);
@@ -92,15 +101,6 @@ class ENGINE_API FileWriterNode : public SPNode
 		bool							mHasWriteError;		// remember file write errors
 		bool							mIsWriting;			// file write state (true after header was written)
 
-
-		enum EWriteMode
-		{
-			WRITEMODE_KEEP = 0, 
-			WRITEMODE_OVERWRITE_ALWAYS,
-			WRITEMODE_OVERWRITE_SESSION,
-			WRITEMODE_APPEND
-		};
-
 		EWriteMode					mWriteMode;			// overwrite/append modes
 
 
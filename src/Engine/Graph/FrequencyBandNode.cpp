@@ -277,6 +277,18 @@ void FrequencyBandNode::Processor::ReInit()
 }
 
 
+// setup the processor and its single band plan
+void FrequencyBandNode::Processor::Setup(const ChannelProcessor::Settings& settings)
+{
+	mSettings = static_cast<const FrequencyBandSettings&>(settings);
+
+	if (mBandPlan.GetNumBands() == 0)
+		mBandPlan.AddBand(mSettings.mBand.GetMinFrequency(), mSettings.mBand.GetMaxFrequency());
+	else
+		mBandPlan.SetBand(0, mSettings.mBand.GetMinFrequency(), mSettings.mBand.GetMaxFrequency());
+}
+
+
 // calculate one average magnitude per incoming spectrum
 void FrequencyBandNode::Processor::Update()
 {
@@ -291,37 +303,20 @@ void FrequencyBandNode::Processor::Update()
 
 	const uint32 numNewSpectrums = input->GetNumNewSamples();
 
+	// map the value type onto the band plan
+	BandPlan::EValueType valueType;
 	switch (mSettings.mValueType)
 	{
-		case VALUE_AMPLITUDE:
-
-			for (uint32 i = 0; i<numNewSpectrums; i++)
-			{
-				const Spectrum&  spectrum = input->PopOldestSample<Spectrum>();
-				double magnitude = mSettings.mBand.CalcMagnitude(&spectrum);
-				output->AddSample(magnitude);
-			}
-			break;
-
-		case VALUE_POWER:
-
-			for (uint32 i = 0; i<numNewSpectrums; i++)
-			{
-				const Spectrum&  spectrum = input->PopOldestSample<Spectrum>();
-				double magnitude = mSettings.mBand.CalcPower(&spectrum);
-				output->AddSample(magnitude);
-			}
-			break;
-
-		case VALUE_PHASE:
-
-			for (uint32 i = 0; i<numNewSpectrums; i++)
-			{
-				const Spectrum&  spectrum = input->PopOldestSample<Spectrum>();
-				double magnitude = mSettings.mBand.CalcPhase(&spectrum);
-				output->AddSample(magnitude);
-			}
-			break;
+		case VALUE_POWER:	valueType = BandPlan::VALUE_POWER;		break;
+		case VALUE_PHASE:	valueType = BandPlan::VALUE_PHASE;		break;
+		default:			valueType = BandPlan::VALUE_MAGNITUDE;	break;
 	}
 
+	for (uint32 i = 0; i<numNewSpectrums; i++)
+	{
+		const Spectrum& spectrum = input->PopOldestSample<Spectrum>();
+		double value;
+		mBandPlan.Calc(&spectrum, valueType, &value);
+		output->AddSample(value);
+	}
 }
@@ -30,6 +30,7 @@
 #include "ProcessorNode.h"
 #include "../DSP/ChannelProcessor.h"
 #include "../DSP/FrequencyBand.h"
+#include "../DSP/BandPlan.h"
 
 
 class ENGINE_API FrequencyBandNode : public ProcessorNode
@@ -124,7 +125,7 @@ class ENGINE_API FrequencyBandNode : public ProcessorNode
 				const FrequencyBand& GetFrequencyBand()							{ return mSettings.mBand; }
 
 				// settings
-				void Setup(const ChannelProcessor::Settings& settings) override	{ mSettings = static_cast<const FrequencyBandSettings&>(settings); }
+				void Setup(const ChannelProcessor::Settings& settings) override;
 				virtual const Settings& GetSettings() const override			{ return mSettings; }
 	
 				void Init() override
@@ -139,6 +140,7 @@ class ENGINE_API FrequencyBandNode : public ProcessorNode
 
 			private:
 				FrequencyBandSettings		mSettings;
+				BandPlan					mBandPlan;
 		};
 };
 
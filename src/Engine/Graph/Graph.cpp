@@ -634,6 +634,7 @@ bool Graph::OnAttributeChanged(Attribute* attribute)
 	// update this node
 	if (HasAttribute(attribute) == true)
 	{
+		MarkAttributeDirty(attribute);
 		GraphObject::OnAttributesChanged();
 		GraphObject::OnAttributeChanged(attribute);
 		containsAttribute = true;
@@ -648,6 +649,7 @@ bool Graph::OnAttributeChanged(Attribute* attribute)
 #ifdef CORE_DEBUG
 			LogDebug("OnAttributesChanged() : Attribute %s of graph object '%s' (at %x) changed", attribute->GetTypeString(), mObjects[i]->GetName(), mObjects[i]);
 #endif
+			mObjects[i]->MarkAttributeDirty(attribute);
 			mObjects[i]->OnAttributesChanged();
 			mObjects[i]->OnAttributeChanged(attribute);
 			
@@ -675,14 +677,19 @@ bool Graph::ApplySettings(const GraphSettings& settings)
 	const uint32 numSettings = settings.Size();
 
 	// for each graph object setting
+	String before;
 	for (uint32 i=0; i<numSettings; ++i)
 	{
 		const char* attributeName = settings.GetName(i);
+		const uint32 attributeKey = AttributeKey(attributeName);
 
 		// graph's attributes
-		const uint32 graphAttribute = FindAttributeIndexByInternalName(attributeName);
+		const uint32 graphAttribute = FindAttributeIndexByKey(attributeKey, attributeName);
 		if (graphAttribute != CORE_INVALIDINDEX32)
+		{
 			GetAttributeValue(graphAttribute)->InitFromString(settings.GetValue(i));
+			MarkAttributeDirty(graphAttribute);
+		}
 
 		// find matching object in graph
 		for (uint32 j=0; j<numObjects; ++j)
@@ -700,7 +707,7 @@ bool Graph::ApplySettings(const GraphSettings& settings)
 
 			if (uuidMatched || typeMatched || nameMatched)
 			{
-				uint32 attributeIndex = object->FindAttributeIndexByInternalName(attributeName);
+				uint32 attributeIndex = object->FindAttributeIndexByKey(attributeKey, attributeName);
 
 				// settings not found; this is not an error, we don't know if the graph has the settings or not. Just continue.
 				if (attributeIndex == CORE_INVALIDINDEX32)
@@ -708,7 +715,15 @@ bool Graph::ApplySettings(const GraphSettings& settings)
 
 				Attribute* attribute = object->GetAttributeValue(attributeIndex);
 
-				String before; attribute->ConvertToString(before);
+				// value did not change: only remember it as a change, but don't make the object reconfigure itself
+				attribute->ConvertToString(before);
+				if (before == settings.GetValue(i))
+				{
+					object->GraphObject::OnAttributeChanged(attribute);
+					numApplied++;
+					continue;
+				}
+
 				LogDebug("GraphSettings: Changing value of attribute '%s' (in object '%s') from '%s' to '%s'", attributeName, object->GetName(), before.AsChar(), settings.GetValue(i));
 
 				// update attribute
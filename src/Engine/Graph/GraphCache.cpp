@@ -0,0 +1,532 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required files
+#include "GraphCache.h"
+#include "../Core/LogManager.h"
+#include "../Core/Timer.h"
+#include "../Core/MemoryFile.h"
+#include "../Core/AttributeFloat.h"
+#include "../Core/AttributeInt32.h"
+#include "../Core/AttributeBool.h"
+#include "../Core/AttributeColor.h"
+#include "../EngineManager.h"
+#include "Connection.h"
+
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+
+using namespace Core;
+
+// file layout (native byte order, all strings are length-prefixed and zero-terminated so they can be used in-place):
+//   header:      magic, cache version, engine version, source hash, revision, uuid, node count, connection count
+//   node:        type id, type uuid, name, uuid, enabled, locked, posX, posY, collapsed state, attribute count, attributes
+//   attribute:   attribute index, internal name, attribute type, value
+//   connection:  source node index, source port, target node index, target port
+static const char gCacheMagic[4] = { 'N', 'M', 'G', 'C' };
+
+
+//
+// writing helpers
+//
+
+static void WriteUInt32(MemoryFile& file, uint32 value)		{ file.Write( &value, sizeof(uint32) ); }
+static void WriteInt32(MemoryFile& file, int32 value)		{ file.Write( &value, sizeof(int32) ); }
+
+static void WriteString(MemoryFile& file, const char* value)
+{
+	const uint32 length = (uint32)strlen(value);
+	WriteUInt32( file, length );
+	file.Write( value, length + 1 );
+}
+
+
+// write the attribute value; the common types are stored raw, everything else in its string form
+static bool WriteAttributeValue(MemoryFile& file, const Attribute* attribute)
+{
+	switch (attribute->GetType())
+	{
+		case AttributeFloat::TYPE_ID:
+		{
+			const double value = static_cast<const AttributeFloat*>(attribute)->GetValue();
+			file.Write( &value, sizeof(double) );
+			return true;
+		}
+
+		case AttributeInt32::TYPE_ID:
+		{
+			WriteInt32( file, static_cast<const AttributeInt32*>(attribute)->GetValue() );
+			return true;
+		}
+
+		case AttributeBool::TYPE_ID:
+		{
+			WriteUInt32( file, static_cast<const AttributeBool*>(attribute)->GetValue() ? 1 : 0 );
+			return true;
+		}
+
+		case AttributeColor::TYPE_ID:
+		{
+			const Color& color = static_cast<const AttributeColor*>(attribute)->GetValue();
+			const float values[4] = { color.r, color.g, color.b, color.a };
+			file.Write( values, sizeof(values) );
+			return true;
+		}
+
+		default:
+		{
+			String value;
+			if (attribute->ConvertToString(value) == false)
+				return false;
+
+			WriteString( file, value.AsChar() );
+			return true;
+		}
+	}
+}
+
+
+//
+// reading helpers
+//
+
+// bounds-checked reader on top of the mapped file
+class GraphCacheReader
+{
+	public:
+		GraphCacheReader(const uint8* data, uint64 size)			{ mData = data; mEnd = data + size; mIsValid = true; }
+
+		bool IsValid() const										{ return mIsValid; }
+
+		const void* Read(uint64 numBytes)
+		{
+			if (mIsValid == false || (uint64)(mEnd - mData) < numBytes)
+			{
+				mIsValid = false;
+				return NULL;
+			}
+
+			const void* result = mData;
+			mData += numBytes;
+			return result;
+		}
+
+		uint32 ReadUInt32()											{ uint32 value = 0; const void* data = Read(sizeof(uint32)); if (data != NULL) memcpy(&value, data, sizeof(uint32)); return value; }
+		int32 ReadInt32()											{ int32 value = 0; const void* data = Read(sizeof(int32)); if (data != NULL) memcpy(&value, data, sizeof(int32)); return value; }
+		double ReadDouble()											{ double value = 0.0; const void* data = Read(sizeof(double)); if (data != NULL) memcpy(&value, data, sizeof(double)); return value; }
+
+		// returns a pointer into the mapped file
+		const char* ReadString()
+		{
+			const uint32 length = ReadUInt32();
+			const char* value = (const char*)Read( (uint64)length + 1 );
+			if (value == NULL || value[length] != '\0')
+			{
+				mIsValid = false;
+				return "";
+			}
+
+			return value;
+		}
+
+	private:
+		const uint8*	mData;
+		const uint8*	mEnd;
+		bool			mIsValid;
+};
+
+
+static bool ReadAttributeValue(GraphCacheReader& reader, uint32 type, Attribute* attribute)
+{
+	switch (type)
+	{
+		case AttributeFloat::TYPE_ID:	{ const double value = reader.ReadDouble(); if (attribute != NULL) static_cast<AttributeFloat*>(attribute)->SetValue(value); break; }
+		case AttributeInt32::TYPE_ID:	{ const int32 value = reader.ReadInt32(); if (attribute != NULL) static_cast<AttributeInt32*>(attribute)->SetValue(value); break; }
+		case AttributeBool::TYPE_ID:	{ const uint32 value = reader.ReadUInt32(); if (attribute != NULL) static_cast<AttributeBool*>(attribute)->SetValue(value != 0); break; }
+
+		case AttributeColor::TYPE_ID:
+		{
+			const float* values = (const float*)reader.Read( 4 * sizeof(float) );
+			if (values != NULL && attribute != NULL)
+			{
+				float color[4];
+				memcpy( color, values, sizeof(color) );
+				static_cast<AttributeColor*>(attribute)->SetValue( Color(color[0], color[1], color[2], color[3]) );
+			}
+			break;
+		}
+
+		default:
+		{
+			const char* value = reader.ReadString();
+			if (attribute != NULL && reader.IsValid() == true && attribute->InitFromString(value) == false)
+				return false;
+			break;
+		}
+	}
+
+	return reader.IsValid();
+}
+
+
+// read-only mapping of the whole cache file
+class GraphCacheMapping
+{
+	public:
+		GraphCacheMapping()											{ mData = NULL; mSize = 0; mFile = NULL; mMapping = NULL; }
+		~GraphCacheMapping()										{ Close(); }
+
+		const uint8* GetData() const								{ return mData; }
+		uint64 GetSize() const										{ return mSize; }
+
+		bool Open(const char* filename)
+		{
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+			mFile = CreateFileA( filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+			if (mFile == INVALID_HANDLE_VALUE)
+			{
+				mFile = NULL;
+				return false;
+			}
+
+			LARGE_INTEGER fileSize;
+			if (GetFileSizeEx(mFile, &fileSize) == FALSE || fileSize.QuadPart == 0)
+				return false;
+
+			mMapping = CreateFileMappingA( mFile, NULL, PAGE_READONLY, 0, 0, NULL );
+			if (mMapping == NULL)
+				return false;
+
+			mData = (const uint8*)MapViewOfFile( mMapping, FILE_MAP_READ, 0, 0, 0 );
+			mSize = fileSize.QuadPart;
+#else
+			const int file = open( filename, O_RDONLY );
+			if (file < 0)
+				return false;
+
+			struct stat fileStat;
+			if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+			{
+				close(file);
+				return false;
+			}
+
+			// the mapping stays valid after closing the descriptor
+			void* data = mmap( NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+			close(file);
+			if (data == MAP_FAILED)
+				return false;
+
+			mData = (const uint8*)data;
+			mSize = fileStat.st_size;
+#endif
+			return (mData != NULL);
+		}
+
+		void Close()
+		{
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+			if (mData != NULL)		UnmapViewOfFile(mData);
+			if (mMapping != NULL)	CloseHandle(mMapping);
+			if (mFile != NULL)		CloseHandle(mFile);
+#else
+			if (mData != NULL)		munmap( (void*)mData, mSize );
+#endif
+			mData		= NULL;
+			mSize		= 0;
+			mFile		= NULL;
+			mMapping	= NULL;
+		}
+
+	private:
+		const uint8*	mData;
+		uint64			mSize;
+		void*			mFile;
+		void*			mMapping;
+};
+
+
+//
+// GraphCache
+//
+
+// FNV-1a hash of the JSON string
+uint32 GraphCache::CalcSourceHash(const char* jsonString)
+{
+	uint32 hash = 2166136261u;
+	for (const uint8* c = (const uint8*)jsonString; *c != '\0'; ++c)
+	{
+		hash ^= *c;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+
+String GraphCache::GetFilename(const char* folder, const char* uuid)
+{
+	String filename;
+	filename.Format( "%sClassifierCache_%s.bin", folder, uuid );
+	return filename;
+}
+
+
+// write the loaded classifier into the cache file
+bool GraphCache::Save(const char* filename, Classifier* classifier, uint32 sourceHash)
+{
+	MemoryFile file;
+	file.Open();
+
+	// header
+	const Version engineVersion = GetEngine()->GetVersion();
+	file.Write( gCacheMagic, sizeof(gCacheMagic) );
+	WriteUInt32( file, VERSION );
+	WriteUInt32( file, engineVersion.GetMajor() );
+	WriteUInt32( file, engineVersion.GetMinor() );
+	WriteUInt32( file, engineVersion.GetPatch() );
+	WriteUInt32( file, sourceHash );
+	WriteUInt32( file, classifier->GetRevision() );
+	WriteString( file, classifier->GetUuid() );
+
+	const uint32 numNodes = classifier->GetNumNodes();
+	const uint32 numConnections = classifier->GetNumConnections();
+	WriteUInt32( file, numNodes );
+	WriteUInt32( file, numConnections );
+
+	// nodes
+	for (uint32 i=0; i<numNodes; ++i)
+	{
+		Node* node = classifier->GetNode(i);
+
+		WriteUInt32( file, node->GetType() );
+		WriteString( file, node->GetTypeUuid() );
+		WriteString( file, node->GetName() );
+		WriteString( file, node->GetUuid() );
+		WriteUInt32( file, node->IsEnabled() ? 1 : 0 );
+		WriteUInt32( file, node->IsLocked() ? 1 : 0 );
+		WriteInt32( file, node->GetVisualPosX() );
+		WriteInt32( file, node->GetVisualPosY() );
+		WriteUInt32( file, node->GetCollapsedState() );
+
+		const uint32 numAttributes = node->GetNumAttributes();
+		WriteUInt32( file, numAttributes );
+		for (uint32 a=0; a<numAttributes; ++a)
+		{
+			const Attribute* attribute = node->GetAttributeValue(a);
+
+			WriteUInt32( file, a );
+			WriteString( file, node->GetAttributeSettings(a)->GetInternalName() );
+			WriteUInt32( file, attribute->GetType() );
+			if (WriteAttributeValue(file, attribute) == false)
+			{
+				LogDetailedInfo( "GraphCache::Save(): Attribute '%s' of node '%s' cannot be cached, skipping cache.", node->GetAttributeSettings(a)->GetInternalName(), node->GetName() );
+				return false;
+			}
+		}
+	}
+
+	// connections
+	for (uint32 i=0; i<numConnections; ++i)
+	{
+		Connection* connection = classifier->GetConnection(i);
+		WriteUInt32( file, classifier->FindNodeIndex(connection->GetSourceNode()) );
+		WriteUInt32( file, connection->GetSourcePort() );
+		WriteUInt32( file, classifier->FindNodeIndex(connection->GetTargetNode()) );
+		WriteUInt32( file, connection->GetTargetPort() );
+	}
+
+	// write to a temporary file first, so that a crash never leaves a half-written cache behind
+	String tempFilename = filename;
+	tempFilename += ".tmp";
+
+	FILE* diskFile = fopen( tempFilename.AsChar(), "wb" );
+	if (diskFile == NULL)
+	{
+		LogWarning( "GraphCache::Save(): Cannot create file '%s'.", tempFilename.AsChar() );
+		return false;
+	}
+
+	const bool written = (fwrite(file.GetData(), file.GetSize(), 1, diskFile) == 1);
+	fclose(diskFile);
+
+	remove(filename);
+	if (written == false || rename(tempFilename.AsChar(), filename) != 0)
+	{
+		LogWarning( "GraphCache::Save(): Cannot write file '%s'.", filename );
+		remove( tempFilename.AsChar() );
+		return false;
+	}
+
+	return true;
+}
+
+
+// construct the classifier from the cache file
+bool GraphCache::Load(const char* filename, Classifier* classifier, const char* uuid, uint32 revision, uint32 sourceHash)
+{
+	Timer loadTimer;
+
+	GraphCacheMapping mapping;
+	if (mapping.Open(filename) == false)
+		return false;
+
+	GraphCacheReader reader( mapping.GetData(), mapping.GetSize() );
+
+	// validate the header; anything that does not match exactly means the cache is outdated
+	const Version engineVersion = GetEngine()->GetVersion();
+	const char* magic = (const char*)reader.Read( sizeof(gCacheMagic) );
+	if (magic == NULL || memcmp(magic, gCacheMagic, sizeof(gCacheMagic)) != 0)
+		return false;
+
+	const bool isValid =	reader.ReadUInt32() == VERSION &&
+							reader.ReadUInt32() == engineVersion.GetMajor() &&
+							reader.ReadUInt32() == engineVersion.GetMinor() &&
+							reader.ReadUInt32() == engineVersion.GetPatch() &&
+							reader.ReadUInt32() == sourceHash &&
+							reader.ReadUInt32() == revision &&
+							strcmp(reader.ReadString(), uuid) == 0;
+	if (isValid == false || reader.IsValid() == false)
+		return false;
+
+	const uint32 numNodes = reader.ReadUInt32();
+	const uint32 numConnections = reader.ReadUInt32();
+
+	classifier->SetEmitEvents(false);
+
+	// nodes
+	for (uint32 i=0; i<numNodes && reader.IsValid() == true; ++i)
+	{
+		const uint32 typeID		= reader.ReadUInt32();
+		const char* typeUuid	= reader.ReadString();
+		const char* name		= reader.ReadString();
+		const char* nodeUuid	= reader.ReadString();
+		const bool isEnabled	= (reader.ReadUInt32() != 0);
+		const bool isLocked		= (reader.ReadUInt32() != 0);
+		const int32 posX		= reader.ReadInt32();
+		const int32 posY		= reader.ReadInt32();
+		const uint32 collapsed	= reader.ReadUInt32();
+		if (reader.IsValid() == false)
+			break;
+
+		GraphObject* object = GetGraphObjectFactory()->CreateObjectByTypeID( classifier, typeID );
+		if (object == NULL || strcmp(object->GetTypeUuid(), typeUuid) != 0)
+		{
+			delete object;
+			return false;
+		}
+
+		Node* node = static_cast<Node*>(object);
+		node->SetEmitEvents(false);
+		node->SetName(name);
+		node->SetUuid(nodeUuid);
+		node->SetEnabled(isEnabled);
+		node->SetLocked(isLocked);
+
+		// attributes; the stored index is used directly as long as the internal name still matches
+		const uint32 numAttributes = reader.ReadUInt32();
+		for (uint32 a=0; a<numAttributes && reader.IsValid() == true; ++a)
+		{
+			uint32 attributeIndex		= reader.ReadUInt32();
+			const char* internalName	= reader.ReadString();
+			const uint32 attributeType	= reader.ReadUInt32();
+			if (reader.IsValid() == false)
+				break;
+
+			if (attributeIndex >= node->GetNumAttributes() || strcmp(node->GetAttributeSettings(attributeIndex)->GetInternalName(), internalName) != 0)
+				attributeIndex = node->FindAttributeIndexByInternalName(internalName);
+
+			// unknown attributes are skipped, just like the JSON importer does
+			Attribute* attribute = NULL;
+			if (attributeIndex != CORE_INVALIDINDEX32 && node->GetAttributeValue(attributeIndex)->GetType() == attributeType)
+				attribute = node->GetAttributeValue(attributeIndex);
+
+			if (ReadAttributeValue(reader, attributeType, attribute) == false)
+				break;
+
+			if (attribute != NULL)
+				node->MarkAttributeDirty(attributeIndex);
+		}
+
+		if (reader.IsValid() == false)
+		{
+			delete node;
+			break;
+		}
+
+		node->OnAttributesChanged();
+		node->SetVisualPos( posX, posY );
+		if (collapsed < Node::NUM_COLLAPSED_STATES)
+			node->SetCollapsedState( (Node::ECollapsedState)collapsed );
+		node->SetIsDirty(false);
+		node->SetEmitEvents(true);
+
+		classifier->AddNode(node);
+	}
+
+	// connections
+	for (uint32 i=0; i<numConnections && reader.IsValid() == true; ++i)
+	{
+		const uint32 sourceNodeIndex	= reader.ReadUInt32();
+		const uint32 sourcePort			= reader.ReadUInt32();
+		const uint32 targetNodeIndex	= reader.ReadUInt32();
+		const uint32 targetPort			= reader.ReadUInt32();
+		if (reader.IsValid() == false || sourceNodeIndex >= classifier->GetNumNodes() || targetNodeIndex >= classifier->GetNumNodes())
+			return false;
+
+		Node* sourceNode = classifier->GetNode(sourceNodeIndex);
+		Node* targetNode = classifier->GetNode(targetNodeIndex);
+		if (sourcePort >= sourceNode->GetNumOutputPorts() || targetPort >= targetNode->GetNumInputPorts())
+			return false;
+
+		if (targetNode->GetInputPort(targetPort).IsCompatibleWith(sourceNode->GetOutputPort(sourcePort)) == false)
+			return false;
+
+		classifier->AddConnection( sourceNode, sourcePort, targetNode, targetPort );
+	}
+
+	if (reader.IsValid() == false)
+	{
+		LogWarning( "GraphCache::Load(): Cache file '%s' is truncated.", filename );
+		return false;
+	}
+
+	// reset graph (same as the JSON importer)
+	classifier->Init();
+	classifier->CreateDefaultAttributeValues();
+	classifier->Reset();
+	classifier->SetIsDirty(false);
+	classifier->SetEmitEvents(true);
+
+	const float loadTime = loadTimer.GetTime().InSeconds();
+	LogInfo( "Loading %s from cache took %.1f ms.", classifier->GetReadableType(), loadTime * 1000.0f );
+
+	return true;
+}
@@ -0,0 +1,55 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_GRAPHCACHE_H
+#define __NEUROMORE_GRAPHCACHE_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/String.h"
+#include "Classifier.h"
+
+
+// binary cache of loaded classifiers, so that the next load can skip the JSON parser and the attribute lookups
+// the file is keyed by classifier uuid + revision + hash of the JSON source; any mismatch makes the caller fall back to JSON
+class ENGINE_API GraphCache
+{
+	public:
+		enum { VERSION = 1 };
+
+		// hash of the JSON source string (FNV-1a)
+		static uint32 CalcSourceHash(const char* jsonString);
+
+		// cache filename of the given classifier inside the given folder
+		static Core::String GetFilename(const char* folder, const char* uuid);
+
+		// write the already loaded classifier into the cache file
+		static bool Save(const char* filename, Classifier* classifier, uint32 sourceHash);
+
+		// construct the (empty) classifier from the cache file; returns false if the file is missing, outdated or broken
+		static bool Load(const char* filename, Classifier* classifier, const char* uuid, uint32 revision, uint32 sourceHash);
+};
+
+
+#endif
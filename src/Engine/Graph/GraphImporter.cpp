@@ -37,6 +37,8 @@ using namespace Core;
 
 bool GraphImporter::LoadFromJSON(const Json& json, const Json::Item& rootItem, Graph* rootNode)
 {
+	MemoryTagScope memoryTag(MEMORYTAG_GRAPH);
+
 	// disable events when loading the graph
 	rootNode->SetEmitEvents( false );
 
@@ -132,10 +132,9 @@ bool GraphObject::OnAttributeChanged(Attribute* attribute)
 			continue;
 
 		AttributeSettings* settings = GetAttributeSettings(i);
-		const char* internalName = settings->GetInternalName();
 
-		// already containe in modified attributes list?
-		const uint32 modifiedIndex = mChangedAttributes.FindAttributeIndexByInternalName(internalName);
+		// already contained in modified attributes list?
+		const uint32 modifiedIndex = mChangedAttributes.FindAttributeIndexByKey(settings->GetInternalNameKey(), settings->GetInternalName());
 		if (modifiedIndex == CORE_INVALIDINDEX32)
 		{
 			// add attribute to modified list
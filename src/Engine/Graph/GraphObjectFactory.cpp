@@ -63,6 +63,7 @@
   #include "PairwiseMathNode.h"
 #endif
 #include "IntegralNode.h"
+#include "TopographicMapNode.h"
 
 // DSP
 #include "FFTNode.h"
@@ -176,6 +177,7 @@ GraphObjectFactory::GraphObjectFactory()
 		RegisterObjectType( new PairwiseMathNode(NULL) );
 #endif
 		RegisterObjectType( new IntegralNode(NULL) );
+		RegisterObjectType( new TopographicMapNode(NULL) );
 
 		// DSP nodes
 		RegisterObjectType( new FFTNode(NULL) );
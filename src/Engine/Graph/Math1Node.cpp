@@ -33,7 +33,7 @@ Math1Node::Math1Node(Graph* graph) : ProcessorNode(graph, new Math1Node::Process
 {
 	// default on addition
 	mSettings.mMathFunction	 = MATHFUNCTION_SIN;
-	mSettings.mCalculateFunc = CalculateSin;
+	mSettings.mCalculateFunc = CalculateBlock<CalculateSin>;
 }
 
 
@@ -102,32 +102,32 @@ void Math1Node::OnAttributesChanged()
 	mSettings.mMathFunction = function;
 	switch (mSettings.mMathFunction)
 	{
-		case MATHFUNCTION_SIN:				mSettings.mCalculateFunc = CalculateSin;				break;
-		case MATHFUNCTION_COS:				mSettings.mCalculateFunc = CalculateCos;				break;
-		case MATHFUNCTION_TAN:				mSettings.mCalculateFunc = CalculateTan;				break;
-		case MATHFUNCTION_SQR:				mSettings.mCalculateFunc = CalculateSqr;				break;
-		case MATHFUNCTION_SQRT:				mSettings.mCalculateFunc = CalculateSqrt;				break;
-		case MATHFUNCTION_ABS:				mSettings.mCalculateFunc = CalculateAbs;				break;
-		case MATHFUNCTION_FLOOR:			mSettings.mCalculateFunc = CalculateFloor;				break;
-		case MATHFUNCTION_CEIL:				mSettings.mCalculateFunc = CalculateCeil;				break;
-		case MATHFUNCTION_ONEOVERINPUT:		mSettings.mCalculateFunc = CalculateOneOverInput;		break;
-		case MATHFUNCTION_INVSQRT:			mSettings.mCalculateFunc = CalculateInvSqrt;			break;
-		case MATHFUNCTION_LOG:				mSettings.mCalculateFunc = CalculateLog;				break;
-		case MATHFUNCTION_LOG10:			mSettings.mCalculateFunc = CalculateLog10;				break;
-		case MATHFUNCTION_EXP:				mSettings.mCalculateFunc = CalculateExp;				break;
-		case MATHFUNCTION_FRACTION:			mSettings.mCalculateFunc = CalculateFraction;			break;
-		case MATHFUNCTION_SIGN:				mSettings.mCalculateFunc = CalculateSign;				break;
-		case MATHFUNCTION_ISPOSITIVE:		mSettings.mCalculateFunc = CalculateIsPositive;			break;
-		case MATHFUNCTION_ISNEGATIVE:		mSettings.mCalculateFunc = CalculateIsNegative;			break;
-		case MATHFUNCTION_ISNEARZERO:		mSettings.mCalculateFunc = CalculateIsNearZero;			break;
-		case MATHFUNCTION_RANDOMFLOAT:		mSettings.mCalculateFunc = CalculateRandomFloat;		break;
-		case MATHFUNCTION_RADTODEG:			mSettings.mCalculateFunc = CalculateRadToDeg;			break;
-		case MATHFUNCTION_DEGTORAD:			mSettings.mCalculateFunc = CalculateDegToRad;			break;
-		case MATHFUNCTION_SMOOTHSTEPCOS:	mSettings.mCalculateFunc = CalculateSmoothStepCos;		break;
-		case MATHFUNCTION_ACOS:				mSettings.mCalculateFunc = CalculateACos;				break;
-		case MATHFUNCTION_ASIN:				mSettings.mCalculateFunc = CalculateASin;				break;
-		case MATHFUNCTION_ATAN:				mSettings.mCalculateFunc = CalculateATan;				break;
-		case MATHFUNCTION_SMOOTHSTEPPOLY:	mSettings.mCalculateFunc = CalculateSmoothStepPoly;		break;
+		case MATHFUNCTION_SIN:				mSettings.mCalculateFunc = CalculateBlock<CalculateSin>;				break;
+		case MATHFUNCTION_COS:				mSettings.mCalculateFunc = CalculateBlock<CalculateCos>;				break;
+		case MATHFUNCTION_TAN:				mSettings.mCalculateFunc = CalculateBlock<CalculateTan>;				break;
+		case MATHFUNCTION_SQR:				mSettings.mCalculateFunc = CalculateBlock<CalculateSqr>;				break;
+		case MATHFUNCTION_SQRT:				mSettings.mCalculateFunc = CalculateBlock<CalculateSqrt>;				break;
+		case MATHFUNCTION_ABS:				mSettings.mCalculateFunc = CalculateBlock<CalculateAbs>;				break;
+		case MATHFUNCTION_FLOOR:			mSettings.mCalculateFunc = CalculateBlock<CalculateFloor>;				break;
+		case MATHFUNCTION_CEIL:				mSettings.mCalculateFunc = CalculateBlock<CalculateCeil>;				break;
+		case MATHFUNCTION_ONEOVERINPUT:		mSettings.mCalculateFunc = CalculateBlock<CalculateOneOverInput>;		break;
+		case MATHFUNCTION_INVSQRT:			mSettings.mCalculateFunc = CalculateBlock<CalculateInvSqrt>;			break;
+		case MATHFUNCTION_LOG:				mSettings.mCalculateFunc = CalculateBlock<CalculateLog>;				break;
+		case MATHFUNCTION_LOG10:			mSettings.mCalculateFunc = CalculateBlock<CalculateLog10>;				break;
+		case MATHFUNCTION_EXP:				mSettings.mCalculateFunc = CalculateBlock<CalculateExp>;				break;
+		case MATHFUNCTION_FRACTION:			mSettings.mCalculateFunc = CalculateBlock<CalculateFraction>;			break;
+		case MATHFUNCTION_SIGN:				mSettings.mCalculateFunc = CalculateBlock<CalculateSign>;				break;
+		case MATHFUNCTION_ISPOSITIVE:		mSettings.mCalculateFunc = CalculateBlock<CalculateIsPositive>;			break;
+		case MATHFUNCTION_ISNEGATIVE:		mSettings.mCalculateFunc = CalculateBlock<CalculateIsNegative>;			break;
+		case MATHFUNCTION_ISNEARZERO:		mSettings.mCalculateFunc = CalculateBlock<CalculateIsNearZero>;			break;
+		case MATHFUNCTION_RANDOMFLOAT:		mSettings.mCalculateFunc = CalculateBlock<CalculateRandomFloat>;		break;
+		case MATHFUNCTION_RADTODEG:			mSettings.mCalculateFunc = CalculateBlock<CalculateRadToDeg>;			break;
+		case MATHFUNCTION_DEGTORAD:			mSettings.mCalculateFunc = CalculateBlock<CalculateDegToRad>;			break;
+		case MATHFUNCTION_SMOOTHSTEPCOS:	mSettings.mCalculateFunc = CalculateBlock<CalculateSmoothStepCos>;		break;
+		case MATHFUNCTION_ACOS:				mSettings.mCalculateFunc = CalculateBlock<CalculateACos>;				break;
+		case MATHFUNCTION_ASIN:				mSettings.mCalculateFunc = CalculateBlock<CalculateASin>;				break;
+		case MATHFUNCTION_ATAN:				mSettings.mCalculateFunc = CalculateBlock<CalculateATan>;				break;
+		case MATHFUNCTION_SMOOTHSTEPPOLY:	mSettings.mCalculateFunc = CalculateBlock<CalculateSmoothStepPoly>;		break;
 
 		default: CORE_ASSERT(1==0);	// function unknown
 	};
@@ -145,6 +145,14 @@ void Math1Node::OnAttributesChanged()
 //-----------------------------------------------
 // the math functions
 //-----------------------------------------------
+
+template <Math1Node::Math1Function FUNCTION>
+void Math1Node::CalculateBlock(const double* x, uint32 numSamples, double* outResults)
+{
+	for (uint32 i=0; i<numSamples; ++i)
+		outResults[i] = FUNCTION(x[i]);
+}
+
 double Math1Node::CalculateSin(double input)					{ return Core::Math::SinD( input ); }
 double Math1Node::CalculateCos(double input)					{ return Core::Math::CosD( input ); }
 double Math1Node::CalculateTan(double input)					{ return Core::Math::TanD( input ); }
@@ -246,15 +254,18 @@ void Math1Node::Processor::Update()
 	ChannelBase* output = GetOutput();
 				
 	// get number of samples
-	uint32 numNewSamples = input->GetNumNewSamples();
-	// process input samples
-	for (uint32 i=0; i<numNewSamples; ++i)
-	{
-		// apply math function
-		const double value = input->PopOldestSample<double>();
-		const double result = mSettings.mCalculateFunc(value);
+	const uint32 numNewSamples = input->GetNumNewSamples();
+	if (numNewSamples == 0)
+		return;
 
-		// add result to output
-		output->AsType<double>()->AddSample(result);
-	}
+	// read all input samples at once
+	mInputSamples.Resize(numNewSamples);
+	mResults.Resize(numNewSamples);
+	input->PopOldestSamples<double>(mInputSamples.GetPtr(), numNewSamples);
+
+	// apply math function
+	mSettings.mCalculateFunc(mInputSamples.GetReadPtr(), numNewSamples, mResults.GetPtr());
+
+	// add results to output
+	output->AsType<double>()->AddSamples(mResults.GetReadPtr(), numNewSamples);
 }
@@ -72,6 +72,11 @@ class ENGINE_API Math1Node : public ProcessorNode
 
 	private:
 		typedef double (CORE_CDECL *Math1Function)(double x);
+
+		// block version of a math function: applies it on a contiguous sample array (instantiated per function, so it is inlined and vectorized)
+		typedef void (CORE_CDECL *Math1BlockFunction)(const double* x, uint32 numSamples, double* outResults);
+		template <Math1Function FUNCTION>
+		static void CORE_CDECL CalculateBlock(const double* x, uint32 numSamples, double* outResults);
 		
 		// Math functions 
 		static double CORE_CDECL CalculateSin(double input);
@@ -147,7 +152,7 @@ class ENGINE_API Math1Node : public ProcessorNode
 
 				// math function and one default-value
 				EMathFunction   mMathFunction;
-				Math1Function	mCalculateFunc;
+				Math1BlockFunction	mCalculateFunc;
 				double			mDefaultValue;
 		};
 		
@@ -180,6 +185,10 @@ class ENGINE_API Math1Node : public ProcessorNode
 
 			private:
 				ProcessorSettings		mSettings;
+
+				// scratch memory for the block processing (reused across updates)
+				Core::Array<double>		mInputSamples;
+				Core::Array<double>		mResults;
 		};
 };
 
@@ -33,7 +33,7 @@ Math2Node::Math2Node(Graph* graph) : ProcessorNode(graph, new Math2Node::Process
 {
 	// default settings
 	mSettings.mMathFunction	 = MATHFUNCTION_ADD;
-	mSettings.mCalculateFunc = CalculateAdd;
+	mSettings.mCalculateFunc = CalculateBlock<CalculateAdd>;
 	mSettings.mDefaultValue = 1;
 }
 
@@ -153,16 +153,16 @@ void Math2Node::OnAttributesChanged()
 	mSettings.mMathFunction = function;
 	switch (mSettings.mMathFunction)
 	{
-		case MATHFUNCTION_ADD:			mSettings.mCalculateFunc = CalculateAdd;			break;
-		case MATHFUNCTION_SUBTRACT:		mSettings.mCalculateFunc = CalculateSubtract;		break;
-		case MATHFUNCTION_MULTIPLY:		mSettings.mCalculateFunc = CalculateMultiply;		break;
-		case MATHFUNCTION_DIVIDE:		mSettings.mCalculateFunc = CalculateDivide;			break;
-		case MATHFUNCTION_AVERAGE:		mSettings.mCalculateFunc = CalculateAverage;		break;
-		case MATHFUNCTION_RANDOMFLOAT:	mSettings.mCalculateFunc = CalculateRandomFloat;	break;
-		case MATHFUNCTION_MOD:			mSettings.mCalculateFunc = CalculateMod;			break;
-		case MATHFUNCTION_MIN:			mSettings.mCalculateFunc = CalculateMin;			break;
-		case MATHFUNCTION_MAX:			mSettings.mCalculateFunc = CalculateMax;			break;
-		case MATHFUNCTION_POW:			mSettings.mCalculateFunc = CalculatePow;			break;
+		case MATHFUNCTION_ADD:			mSettings.mCalculateFunc = CalculateBlock<CalculateAdd>;			break;
+		case MATHFUNCTION_SUBTRACT:		mSettings.mCalculateFunc = CalculateBlock<CalculateSubtract>;		break;
+		case MATHFUNCTION_MULTIPLY:		mSettings.mCalculateFunc = CalculateBlock<CalculateMultiply>;		break;
+		case MATHFUNCTION_DIVIDE:		mSettings.mCalculateFunc = CalculateBlock<CalculateDivide>;			break;
+		case MATHFUNCTION_AVERAGE:		mSettings.mCalculateFunc = CalculateBlock<CalculateAverage>;		break;
+		case MATHFUNCTION_RANDOMFLOAT:	mSettings.mCalculateFunc = CalculateBlock<CalculateRandomFloat>;	break;
+		case MATHFUNCTION_MOD:			mSettings.mCalculateFunc = CalculateBlock<CalculateMod>;			break;
+		case MATHFUNCTION_MIN:			mSettings.mCalculateFunc = CalculateBlock<CalculateMin>;			break;
+		case MATHFUNCTION_MAX:			mSettings.mCalculateFunc = CalculateBlock<CalculateMax>;			break;
+		case MATHFUNCTION_POW:			mSettings.mCalculateFunc = CalculateBlock<CalculatePow>;			break;
 		default: CORE_ASSERT(1==0);	// function unknown
 	};
 
@@ -198,6 +198,14 @@ const char* Math2Node::GetFunctionString(EMathFunction function)
 //-----------------------------------------------
 // the math functions
 //-----------------------------------------------
+
+template <Math2Node::Math2Function FUNCTION>
+void Math2Node::CalculateBlock(const double* x, const double* y, uint32 numSamples, double* outResults)
+{
+	for (uint32 i=0; i<numSamples; ++i)
+		outResults[i] = FUNCTION(x[i], y[i]);
+}
+
 double Math2Node::CalculateAdd(double x, double y)				{ return x + y; }
 double Math2Node::CalculateSubtract(double x, double y)			{ return x - y; }
 double Math2Node::CalculateMultiply(double x, double y)			{ return x * y; }
@@ -340,26 +348,28 @@ void Math2Node::Processor::Update()
 	// 3) produce the output samples
 	//
 
-	for (uint32 i=0; i<numSamplesOut; ++i)
-	{
-		double x, y;
-		
-		// channel x
-		if (haveChannelX || (haveNonuniformChannelX && !haveChannelY) )
-			x = inputX->PopOldestSample<double>();
-		else
-			x = defaultValueX;
-
-		// channel y
-		if (haveChannelY || (!haveChannelX && haveNonuniformChannelY) )
-			y = inputY->PopOldestSample<double>();
-		else
-			y = defaultValueY;
-
-		// apply math function
-		const double result = mSettings.mCalculateFunc(x,y);
-
-		// add result to output
-		output->AsType<double>()->AddSample(result);
-	}
+	if (numSamplesOut == 0)
+		return;
+
+	mSamplesX.Resize(numSamplesOut);
+	mSamplesY.Resize(numSamplesOut);
+	mResults.Resize(numSamplesOut);
+
+	// channel x
+	if (haveChannelX || (haveNonuniformChannelX && !haveChannelY) )
+		inputX->PopOldestSamples<double>(mSamplesX.GetPtr(), numSamplesOut);
+	else
+		mSamplesX.SetAll(defaultValueX);
+
+	// channel y
+	if (haveChannelY || (!haveChannelX && haveNonuniformChannelY) )
+		inputY->PopOldestSamples<double>(mSamplesY.GetPtr(), numSamplesOut);
+	else
+		mSamplesY.SetAll(defaultValueY);
+
+	// apply math function
+	mSettings.mCalculateFunc(mSamplesX.GetReadPtr(), mSamplesY.GetReadPtr(), numSamplesOut, mResults.GetPtr());
+
+	// add results to output
+	output->AsType<double>()->AddSamples(mResults.GetReadPtr(), numSamplesOut);
 }
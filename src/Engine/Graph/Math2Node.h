@@ -113,6 +113,11 @@ class ENGINE_API Math2Node : public ProcessorNode
 	
 		typedef double (CORE_CDECL *Math2Function)(double x, double y);
 
+		// block version of a math function: applies it on two contiguous sample arrays (instantiated per function, so it is inlined and vectorized)
+		typedef void (CORE_CDECL *Math2BlockFunction)(const double* x, const double* y, uint32 numSamples, double* outResults);
+		template <Math2Function FUNCTION>
+		static void CORE_CDECL CalculateBlock(const double* x, const double* y, uint32 numSamples, double* outResults);
+
 		class ProcessorSettings : public ChannelProcessor::Settings
 		{
 			public:
@@ -125,7 +130,7 @@ class ENGINE_API Math2Node : public ProcessorNode
 
 				// math function and one default-value
 				EMathFunction   mMathFunction;
-				Math2Function	mCalculateFunc;
+				Math2BlockFunction	mCalculateFunc;
 				double			mDefaultValue;
 		};
 
@@ -158,6 +163,11 @@ class ENGINE_API Math2Node : public ProcessorNode
 
 			private:
 				ProcessorSettings		mSettings;
+
+				// scratch memory for the block processing (reused across updates)
+				Core::Array<double>		mSamplesX;
+				Core::Array<double>		mSamplesY;
+				Core::Array<double>		mResults;
 		};
 
 };
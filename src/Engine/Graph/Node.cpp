@@ -40,6 +40,7 @@ Node::Node(Graph* parentGraph) : GraphObject(parentGraph)
 	mIsUpdateReady		= false;
 	mIsFirstUpdateReady = true;
 	mIsInitialized		= false;
+	mProfilerId			= CORE_INVALIDINDEX32;
 
 	Reset();
 }
@@ -296,11 +297,46 @@ void Node::UpdateAllIncomingNodes(const Time& elapsed, const Time& delta)
 	{
 		Connection* connection = mInputPorts[i].GetConnection();
 		if (connection != NULL)
-			connection->GetSourceNode()->Update(elapsed, delta);
+			UpdateNode(connection->GetSourceNode(), elapsed, delta);
 	}
 }
 
 
+// update a node, wrapped in a profiler scope if a frame is being recorded
+void Node::UpdateNode(Node* node, const Time& elapsed, const Time& delta)
+{
+	NodeProfiler* profiler = GetEngine()->GetNodeProfiler();
+
+	// already updated nodes return immediately, don't record them again
+	if (profiler->IsRecording() == false || node->IsUpdateReady() == true)
+	{
+		node->Update(elapsed, delta);
+		return;
+	}
+
+	profiler->BeginNode(node, NodeProfiler::PHASE_UPDATE);
+	node->Update(elapsed, delta);
+	profiler->EndNode(node);
+}
+
+
+// reinit a node, wrapped in a profiler scope if a frame is being recorded
+void Node::ReInitNode(Node* node, const Time& elapsed, const Time& delta)
+{
+	NodeProfiler* profiler = GetEngine()->GetNodeProfiler();
+
+	if (profiler->IsRecording() == false || node->IsReInitReady() == true)
+	{
+		node->ReInit(elapsed, delta);
+		return;
+	}
+
+	profiler->BeginNode(node, NodeProfiler::PHASE_REINIT);
+	node->ReInit(elapsed, delta);
+	profiler->EndNode(node);
+}
+
+
 // shared basis update helper
 bool Node::BaseUpdate(const Time& elapsed, const Time& delta)
 {
@@ -345,7 +381,7 @@ void Node::ReInitAllIncomingNodes(const Time& elapsed, const Time& delta)
 	{
 		Connection* connection = mInputPorts[i].GetConnection();
 		if (connection != NULL)
-			connection->GetSourceNode()->ReInit(elapsed, delta);
+			ReInitNode(connection->GetSourceNode(), elapsed, delta);
 	}
 }
 	
@@ -31,6 +31,7 @@
 #include "Connection.h"
 #include "StateTransition.h"
 #include "Port.h"
+#include "NodeProfiler.h"
 
 
 // forward declaration
@@ -65,6 +66,16 @@ class ENGINE_API Node : public GraphObject
 
 		bool IsInitialized() const												{ return mIsInitialized; }
 
+		// update/reinit a node from the graph traversal, instrumented when the node profiler is recording
+		static void UpdateNode(Node* node, const Core::Time& elapsed, const Core::Time& delta);
+		static void ReInitNode(Node* node, const Core::Time& elapsed, const Core::Time& delta);
+
+		// profiling
+		NodeProfiler::Statistics& GetProfilerStatistics()						{ return mProfilerStatistics; }
+		const NodeProfiler::Statistics& GetProfilerStatistics() const			{ return mProfilerStatistics; }
+		uint32 GetProfilerId() const											{ return mProfilerId; }
+		void SetProfilerId(uint32 id)											{ mProfilerId = id; }
+
 		// Async reset forces a node reset during the next ReInit() call. Node will startup immediately, if it can.
 		void ResetAsync()														{ mDoAsyncReset = true; }
 
@@ -176,6 +187,10 @@ class ENGINE_API Node : public GraphObject
 		bool					mIsUpdateReady;
 		bool					mIsReInitReady;
 		bool					mIsFirstUpdateReady;
+
+		// profiling
+		NodeProfiler::Statistics mProfilerStatistics;
+		uint32					mProfilerId;
 };
 
 
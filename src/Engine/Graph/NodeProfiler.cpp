@@ -0,0 +1,331 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "NodeProfiler.h"
+#include "Node.h"
+#include "../Core/LogManager.h"
+#include "../Core/Math.h"
+#include <chrono>
+
+
+using namespace Core;
+
+// weight of the newest value in the per-node running averages
+static const double gStatisticsSmoothing = 0.1;
+
+// constructor
+NodeProfiler::NodeProfiler()
+{
+	mFirstFrame		= 0;
+	mNumFrames		= 0;
+	mFrameCounter	= 0;
+	mCurrentFrame	= NULL;
+	mOwnAllocations	= 0;
+	mIsEnabled		= false;
+	mStartTick		= std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+// destructor
+NodeProfiler::~NodeProfiler()
+{
+}
+
+
+// remove all recorded frames
+void NodeProfiler::Clear()
+{
+	mLock.Lock();
+	for (uint32 i=0; i<NUM_FRAMES; ++i)
+		mFrames[i].mEvents.Clear();
+	mFirstFrame	= 0;
+	mNumFrames	= 0;
+	mLock.Unlock();
+}
+
+
+// current time in microseconds since construction
+double NodeProfiler::GetTime() const
+{
+	const uint64 tick = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	return (tick - mStartTick) / 1000.0;
+}
+
+
+// start recording a new frame, recycling the oldest one if the ring is full
+void NodeProfiler::BeginFrame()
+{
+	if (mIsEnabled == false)
+		return;
+
+	mLock.Lock();
+
+	uint32 index;
+	if (mNumFrames < NUM_FRAMES)
+	{
+		index = (mFirstFrame + mNumFrames) % NUM_FRAMES;
+	}
+	else
+	{
+		index = mFirstFrame;
+		mFirstFrame = (mFirstFrame + 1) % NUM_FRAMES;
+		mNumFrames--;
+	}
+
+	mCurrentFrame = &mFrames[index];
+	mLock.Unlock();
+
+	// keep the event memory of the recycled frame
+	mCurrentFrame->mEvents.Clear(false);
+	mCurrentFrame->mIndex		= mFrameCounter++;
+	mCurrentFrame->mStartTime	= GetTime();
+	mCurrentFrame->mDuration	= 0.0;
+	mScopeStack.Clear(false);
+}
+
+
+// finish the current frame and make it visible to readers
+void NodeProfiler::EndFrame()
+{
+	if (mCurrentFrame == NULL)
+		return;
+
+	mCurrentFrame->mDuration = GetTime() - mCurrentFrame->mStartTime;
+
+	mLock.Lock();
+	mCurrentFrame = NULL;
+	mNumFrames++;
+	mLock.Unlock();
+}
+
+
+// open a node scope
+void NodeProfiler::BeginNode(Node* node, EPhase phase)
+{
+	if (mCurrentFrame == NULL)
+		return;
+
+	// don't account the bookkeeping allocations of the profiler to the node
+	const uint64 numAllocations = gNumThreadAllocations;
+
+	Event& event = mCurrentFrame->mEvents.AddEmpty();
+	event.mNodeId			= GetNodeId(node);
+	event.mPhase			= phase;
+	event.mDepth			= mScopeStack.Size();
+	event.mInclusiveTime	= 0.0;
+	event.mExclusiveTime	= 0.0;
+	event.mNumSamplesIn		= 0;
+	event.mNumSamplesOut	= 0;
+	event.mNumAllocations	= 0;
+
+	Scope& scope = mScopeStack.AddEmpty();
+	scope.mNode				= node;
+	scope.mEventIndex		= mCurrentFrame->mEvents.Size() - 1;
+	scope.mChildTime		= 0.0;
+	scope.mChildAllocations	= 0;
+
+	mOwnAllocations += gNumThreadAllocations - numAllocations;
+	scope.mStartAllocations	= gNumThreadAllocations - mOwnAllocations;
+
+	// start the clock last
+	event.mStartTime = scope.mStartTime = GetTime();
+}
+
+
+// close the innermost node scope
+void NodeProfiler::EndNode(Node* node)
+{
+	const double endTime = GetTime();
+	const uint64 endAllocations = gNumThreadAllocations - mOwnAllocations;
+
+	if (mCurrentFrame == NULL || mScopeStack.IsEmpty() == true)
+		return;
+
+	const Scope scope = mScopeStack.GetLast();
+	mScopeStack.RemoveLast();
+	CORE_ASSERT(scope.mNode == node);
+
+	const double inclusiveTime			= endTime - scope.mStartTime;
+	const uint64 inclusiveAllocations	= endAllocations - scope.mStartAllocations;
+
+	Event& event = mCurrentFrame->mEvents[scope.mEventIndex];
+	event.mInclusiveTime	= inclusiveTime;
+	event.mExclusiveTime	= Max(0.0, inclusiveTime - scope.mChildTime);
+	event.mNumAllocations	= (uint32)(inclusiveAllocations - scope.mChildAllocations);
+
+	// children are timed inclusively by their parent
+	if (mScopeStack.IsEmpty() == false)
+	{
+		Scope& parent = mScopeStack.GetLast();
+		parent.mChildTime			+= inclusiveTime;
+		parent.mChildAllocations	+= inclusiveAllocations;
+	}
+
+	// update the running averages stored in the node
+	NodeProfiler::Statistics& stats = node->GetProfilerStatistics();
+	const double a = (stats.mNumUpdates == 0 ? 1.0 : gStatisticsSmoothing);
+	if (event.mPhase == PHASE_REINIT)
+	{
+		stats.mReInitTime = stats.mReInitTime + a * (inclusiveTime - stats.mReInitTime);
+		return;
+	}
+
+	event.mNumSamplesIn		= CalcNumNewSamples(node, true);
+	event.mNumSamplesOut	= CalcNumNewSamples(node, false);
+
+	stats.mUpdateTime		= stats.mUpdateTime		+ a * (inclusiveTime				- stats.mUpdateTime);
+	stats.mExclusiveTime	= stats.mExclusiveTime	+ a * (event.mExclusiveTime			- stats.mExclusiveTime);
+	stats.mNumSamplesIn		= stats.mNumSamplesIn	+ a * (event.mNumSamplesIn			- stats.mNumSamplesIn);
+	stats.mNumSamplesOut	= stats.mNumSamplesOut	+ a * (event.mNumSamplesOut			- stats.mNumSamplesOut);
+	stats.mNumAllocations	= stats.mNumAllocations	+ a * (event.mNumAllocations		- stats.mNumAllocations);
+	stats.mNumUpdates++;
+}
+
+
+// sum of the new samples on all channels of the input or output ports
+uint32 NodeProfiler::CalcNumNewSamples(Node* node, bool inputPorts)
+{
+	uint32 numSamples = 0;
+
+	const uint32 numPorts = (inputPorts ? node->GetNumInputPorts() : node->GetNumOutputPorts());
+	for (uint32 i=0; i<numPorts; ++i)
+	{
+		const Port& port = (inputPorts ? (Port&)node->GetInputPort(i) : (Port&)node->GetOutputPort(i));
+		MultiChannel* channels = port.GetChannels();
+		if (channels == NULL)
+			continue;
+
+		const uint32 numChannels = channels->GetNumChannels();
+		for (uint32 c=0; c<numChannels; ++c)
+			numSamples += channels->GetChannel(c)->GetNumNewSamples();
+	}
+
+	return numSamples;
+}
+
+
+// nodes are referenced by index into a name table, so recorded frames never point to deleted nodes
+uint32 NodeProfiler::GetNodeId(Node* node)
+{
+	uint32 id = node->GetProfilerId();
+	if (id == CORE_INVALIDINDEX32)
+	{
+		mLock.Lock();
+		id = mNodeNames.Size();
+		mNodeNames.Add(node->GetNameString());
+		mLock.Unlock();
+
+		node->SetProfilerId(id);
+	}
+
+	return id;
+}
+
+
+// name of a profiled node
+const char* NodeProfiler::GetNodeName(uint32 nodeId) const
+{
+	if (nodeId >= mNodeNames.Size())
+		return "";
+
+	return mNodeNames[nodeId].AsChar();
+}
+
+
+// copy out all completed frames, oldest first
+void NodeProfiler::GetFrames(Array<Frame>& outFrames)
+{
+	mLock.Lock();
+
+	outFrames.Resize(mNumFrames);
+	for (uint32 i=0; i<mNumFrames; ++i)
+		outFrames[i] = mFrames[(mFirstFrame + i) % NUM_FRAMES];
+
+	mLock.Unlock();
+}
+
+
+// export the recorded frames as trace event JSON (complete events, one track per phase)
+void NodeProfiler::ExportTrace(String& outJson)
+{
+	Array<Frame> frames;
+	GetFrames(frames);
+
+	outJson.Reserve(128 + frames.Size() * 64);
+	outJson = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	outJson.FormatAdd("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%i,\"args\":{\"name\":\"Update\"}},\n", (int32)PHASE_UPDATE);
+	outJson.FormatAdd("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%i,\"args\":{\"name\":\"ReInit\"}}", (int32)PHASE_REINIT);
+
+	outJson.FormatAdd(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"Frames\"}}");
+
+	// the name table is only appended to by the engine, so hold the lock while resolving names
+	mLock.Lock();
+
+	String name;
+	const uint32 numFrames = frames.Size();
+	for (uint32 f=0; f<numFrames; ++f)
+	{
+		const Frame& frame = frames[f];
+		outJson.FormatAdd(",\n{\"name\":\"Frame %i\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":%.3f,\"dur\":%.3f}", frame.mIndex, frame.mStartTime, frame.mDuration);
+
+		const uint32 numEvents = frame.mEvents.Size();
+		for (uint32 e=0; e<numEvents; ++e)
+		{
+			const Event& event = frame.mEvents[e];
+
+			// escape the node name for JSON
+			name = GetNodeName(event.mNodeId);
+			name.Replace("\\", "\\\\");
+			name.Replace("\"", "\\\"");
+
+			outJson.FormatAdd(",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%i,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"exclusive\":%.3f,\"samplesIn\":%i,\"samplesOut\":%i,\"allocations\":%i}}",
+				name.AsChar(), (event.mPhase == PHASE_UPDATE ? "update" : "reinit"), (int32)event.mPhase, event.mStartTime, event.mInclusiveTime,
+				event.mExclusiveTime, event.mNumSamplesIn, event.mNumSamplesOut, event.mNumAllocations);
+		}
+	}
+
+	mLock.Unlock();
+
+	outJson += "\n]}\n";
+}
+
+
+// write the trace event JSON to a file
+bool NodeProfiler::ExportTrace(const char* filename)
+{
+	String json;
+	ExportTrace(json);
+
+	FILE* file = fopen(filename, "wt");
+	if (file == NULL)
+	{
+		LogError("NodeProfiler: Cannot write trace file '%s'.", filename);
+		return false;
+	}
+
+	const bool success = (fwrite(json.AsChar(), 1, json.GetLength(), file) == json.GetLength());
+	fclose(file);
+
+	return success;
+}
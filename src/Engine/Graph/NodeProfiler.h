@@ -0,0 +1,149 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_NODEPROFILER_H
+#define __NEUROMORE_NODEPROFILER_H
+
+// include required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "../Core/Array.h"
+#include "../Core/String.h"
+#include "../Core/Mutex.h"
+
+// forward declaration
+class Node;
+
+// per-node instrumentation of the recursive graph Update() and ReInit() calls
+// records inclusive/exclusive time, samples in/out and allocations of every node into a ring of per-frame records
+class ENGINE_API NodeProfiler
+{
+	public:
+		enum EPhase
+		{
+			PHASE_UPDATE	= 0,
+			PHASE_REINIT	= 1
+		};
+
+		enum { NUM_FRAMES = 128 };
+
+		// running averages of a single node, stored inside the node itself (times in microseconds)
+		struct ENGINE_API Statistics
+		{
+			double	mUpdateTime;			// inclusive update time (including the upstream nodes that were updated by this node)
+			double	mExclusiveTime;			// update time of the node alone
+			double	mReInitTime;			// inclusive reinit time
+			double	mNumSamplesIn;			// new samples on the input ports per update
+			double	mNumSamplesOut;			// new samples on the output ports per update
+			double	mNumAllocations;		// allocations per update
+			uint32	mNumUpdates;
+
+			Statistics()															{ Clear(); }
+			void Clear()															{ mUpdateTime = mExclusiveTime = mReInitTime = mNumSamplesIn = mNumSamplesOut = mNumAllocations = 0.0; mNumUpdates = 0; }
+		};
+
+		// a single profiled Update() or ReInit() call
+		struct Event
+		{
+			uint32	mNodeId;				// index into the node name table
+			uint16	mPhase;
+			uint16	mDepth;					// recursion depth (0 = end node)
+			double	mStartTime;				// in microseconds since the profiler was created
+			double	mInclusiveTime;
+			double	mExclusiveTime;
+			uint32	mNumSamplesIn;
+			uint32	mNumSamplesOut;
+			uint32	mNumAllocations;
+		};
+
+		// all events of one engine update
+		struct Frame
+		{
+			uint32				mIndex;
+			double				mStartTime;
+			double				mDuration;
+			Core::Array<Event>	mEvents;
+		};
+
+		// constructor & destructor
+		NodeProfiler();
+		~NodeProfiler();
+
+		// profiling is off by default; when disabled the instrumentation costs a single branch per node call
+		void SetEnabled(bool enabled)											{ mIsEnabled = enabled; }
+		bool IsEnabled() const													{ return mIsEnabled; }
+
+		// true between BeginFrame() and EndFrame() of a frame that started while profiling was enabled
+		bool IsRecording() const												{ return mCurrentFrame != NULL; }
+
+		// remove all recorded frames
+		void Clear();
+
+		// frame boundaries (called by the engine around each update)
+		void BeginFrame();
+		void EndFrame();
+
+		// node scope (called around Node::Update() / Node::ReInit())
+		void BeginNode(Node* node, EPhase phase);
+		void EndNode(Node* node);
+
+		// recorded frames (oldest first); copy out under the lock as the engine may be recording
+		uint32 GetNumFrames() const												{ return mNumFrames; }
+		void GetFrames(Core::Array<Frame>& outFrames);
+		const char* GetNodeName(uint32 nodeId) const;							// not locked, call from the engine thread or while holding the engine lock
+
+		// chrome://tracing / Perfetto trace event JSON of all recorded frames
+		void ExportTrace(Core::String& outJson);
+		bool ExportTrace(const char* filename);
+
+	private:
+		struct Scope
+		{
+			Node*	mNode;
+			uint32	mEventIndex;
+			double	mStartTime;
+			double	mChildTime;
+			uint64	mStartAllocations;
+			uint64	mChildAllocations;
+		};
+
+		double GetTime() const;
+		uint32 GetNodeId(Node* node);
+		static uint32 CalcNumNewSamples(Node* node, bool inputPorts);
+
+		Frame					mFrames[NUM_FRAMES];
+		uint32					mFirstFrame;			// ring index of the oldest frame
+		uint32					mNumFrames;
+		uint32					mFrameCounter;
+		Frame*					mCurrentFrame;			// NULL outside of BeginFrame()/EndFrame()
+
+		Core::Array<Scope>		mScopeStack;
+		Core::Array<Core::String>	mNodeNames;
+		Core::Mutex				mLock;
+		uint64					mOwnAllocations;		// allocations made by the profiler bookkeeping itself
+		uint64					mStartTick;
+		bool					mIsEnabled;
+};
+
+
+#endif
@@ -33,6 +33,7 @@ using namespace Core;
 // constructor
 OscOutputNode::OscOutputNode(Graph* parentGraph) : OutputNode(parentGraph)
 {
+	mHasSentSample = false;
 }
 
 
@@ -64,6 +65,16 @@ void OscOutputNode::Init()
 	// create the OSC address
 	AttributeSettings* attributeOscAddress = RegisterAttribute("OSC Address", "oscAddress", "e.g. /out/1.", ATTRIBUTE_INTERFACETYPE_STRING);
 	attributeOscAddress->SetDefaultValue( AttributeString::Create( uniqueOscAddress.AsChar() ) );
+
+	// bundle the messages (all new samples and all OSC output nodes are packed into as few datagrams as possible)
+	AttributeSettings* attributeBundle = RegisterAttribute("Bundle Messages", "bundleMessages", "Pack the messages into timetagged OSC bundles instead of sending one datagram per sample.", ATTRIBUTE_INTERFACETYPE_CHECKBOX);
+	attributeBundle->SetDefaultValue( AttributeBool::Create(false) );
+
+	// decimate the output
+	AttributeSettings* attributeMaxRate = RegisterAttribute("Max Rate", "maxRate", "Maximum number of messages per second (0 = send every sample).", ATTRIBUTE_INTERFACETYPE_FLOATSPINNER);
+	attributeMaxRate->SetDefaultValue( AttributeFloat::Create(0.0) );
+	attributeMaxRate->SetMinValue( AttributeFloat::Create(0.0) );
+	attributeMaxRate->SetMaxValue( AttributeFloat::Create(CORE_FLOAT_MAX) );
 	
 	// hide upload attribute
 	GetAttributeSettings(ATTRIB_UPLOAD)->SetVisible(false);
@@ -94,6 +105,8 @@ void OscOutputNode::ReInit(const Time& elapsed, const Time& delta)
 void OscOutputNode::Reset()
 {
 	OutputNode::Reset();
+
+	mHasSentSample = false;
 }
 
 
@@ -109,20 +122,53 @@ void OscOutputNode::Update(const Time& elapsed, const Time& delta)
 
 	UpdateResamplers(elapsed, delta);
 
-	// queue a packet for each new sample
-	Channel<double >* channel = GetOutputChannel(INPUTPORT_VALUE);
+	// only send out OSC messages in case we have samples inside the channel already
+	if (IsValidInput(INPUTPORT_VALUE) == false)
+		return;
+
+	Channel<double>* channel = GetOutputChannel(INPUTPORT_VALUE);
 	const uint32 numNewSamples = channel->GetNumNewSamples();
-	for (uint32 i = 0; i < numNewSamples; ++i)
+	if (numNewSamples == 0 || channel->GetNumSamples() == 0)
+		return;
+
+	OscMessageRouter* router = GetOscMessageRouter();
+	const bool bundleMessages = GetBoolAttribute(ATTRIB_BUNDLE);
+	const double maxRate = GetFloatAttribute(ATTRIB_MAXRATE);
+	const double minInterval = (maxRate > 0.0 ? 1.0 / maxRate : 0.0);
+	const uint32 bundledMessageSize = OscMessageRouter::CalcBundledMessageSize(GetOscAddress(), 1);
+
+	// all new samples that are still in the channel
+	const uint64 maxSampleIndex = channel->GetMaxSampleIndex();
+	const uint64 minSampleIndex = Max<uint64>(channel->GetSampleCounter() - numNewSamples, channel->GetMinSampleIndex());
+	const Time lastSampleTime = channel->GetLastSampleTime();
+
+	for (uint64 i = minSampleIndex; i <= maxSampleIndex; ++i)
 	{
-		// get free packet from server
-		OscPacket* packet = GetOscMessageRouter()->GetOscPacketFromPool();
-		packet->Clear();
+		// decimate to the max rate
+		const Time sampleTime = channel->GetSampleTime(i);
+		if (minInterval > 0.0 && mHasSentSample == true && (sampleTime - mLastSentTime).InSeconds() < minInterval)
+			continue;
 
-		// write message into packet
-		WriteOscMessage(packet);
+		mLastSentTime = sampleTime;
+		mHasSentSample = true;
 
-		// push into queue
-		GetOscMessageRouter()->QueueOutputPacket(packet);
+		const float value = channel->GetSample(i);
+
+		// add the message to the shared bundle, inside a nested bundle that carries the sample's timetag
+		OscPacketParser::OutStream* outStream = (bundleMessages == true ? router->BeginBundledMessage(bundledMessageSize) : NULL);
+		if (outStream != NULL)
+		{
+			outStream->BeginPacket( OscMessageRouter::CalcTimeTag((lastSampleTime - sampleTime).InSeconds()) );
+				WriteOscMessage(outStream, value);
+			outStream->EndPacket();
+		}
+		else
+		{
+			// one packet per sample (also used for messages that are too large for a bundle)
+			OscPacket* packet = router->AcquireOutputPacket();
+			WriteOscMessage(packet, value);
+			router->QueueOutputPacket(packet);
+		}
 	}
 }
 
@@ -149,19 +195,22 @@ void OscOutputNode::OnAttributesChanged()
 }
 
 
-// write the OSC message
+// write the OSC message with the current value
 void OscOutputNode::WriteOscMessage(OscPacketParser::OutStream* outStream)
 {
 	// only send out the OSC message in case we have samples inside the channel already
 	if (IsValidInput(INPUTPORT_VALUE) == false)
 		return;
 
-	outStream->BeginMessage( GetOscAddress() );
+	WriteOscMessage(outStream, GetCurrentValue());
+}
 
-		// output a float value and not the double (more OSC conform)
-		const float value = GetCurrentValue();
-		outStream->WriteValue( value );
 
+// write the OSC message with the given value (a float value and not the double, more OSC conform)
+void OscOutputNode::WriteOscMessage(OscPacketParser::OutStream* outStream, float value)
+{
+	outStream->BeginMessage( GetOscAddress() );
+		outStream->WriteValue( value );
 	outStream->EndMessage();
 }
 
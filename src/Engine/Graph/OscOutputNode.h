@@ -44,7 +44,9 @@ class ENGINE_API OscOutputNode: public OutputNode
 		
 		enum
 		{
-			ATTRIB_OSCADDRESS		= NUM_BASEATTRIBUTES + 0
+			ATTRIB_OSCADDRESS		= NUM_BASEATTRIBUTES + 0,
+			ATTRIB_BUNDLE			= NUM_BASEATTRIBUTES + 1,
+			ATTRIB_MAXRATE			= NUM_BASEATTRIBUTES + 2
 		};
 
 		enum EError
@@ -80,6 +82,7 @@ class ENGINE_API OscOutputNode: public OutputNode
 		bool IsEmpty() const													{ return mChannels[INPUTPORT_VALUE]->GetNumSamples() == 0; }
 
 		void WriteOscMessage(OscPacketParser::OutStream* outStream);
+		void WriteOscMessage(OscPacketParser::OutStream* outStream, float value);
 
 		static Core::Color GetColor(uint32 index);
 
@@ -87,6 +90,9 @@ class ENGINE_API OscOutputNode: public OutputNode
 		Core::String GenerateUniqueOscAddress();
 		bool IsOscAddressUnique(const char* address);
 
+		// time of the last sample that was sent (for the max rate decimation)
+		Core::Time		mLastSentTime;
+		bool			mHasSentSample;
 };
 
 #endif
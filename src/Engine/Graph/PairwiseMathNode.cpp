@@ -144,30 +144,25 @@ void PairwiseMathNode::Update(const Time& elapsed, const Time& delta)
 	CORE_ASSERT(numOutputs == CalcNumOutputs(numInputs, true));
 
 	const uint32 numSamples = mInputReader.GetMinNumNewSamples();
-	for (uint32 i=0; i<numSamples; ++i)
-	{
-		// Step 1: process all pairs of inputs
-		uint32 index = 0;
-		for (uint32 j = 0; j < numInputs; ++j)
-		{
-			ChannelReader* channelReaderA = mInputReader.GetReader(j);
-			for (uint32 k = 0; k < j; k++)
-			{
-				ChannelReader* channelReaderB = mInputReader.GetReader(k);
-
-				const double valueA = channelReaderA->GetOldestSample<double>();
-				const double valueB = channelReaderB->GetOldestSample<double>();
-				const double result = RunCalculation(valueA, valueB);
+	if (numSamples == 0)
+		return;
 
-				mOutputChannels[index].AddSample(result);
+	// Step 1: read the new samples of all inputs into the tile (this also advances all input channel readers)
+	const uint32 stride = mInputReader.PopOldestSamples(numSamples, mTile);
+	mResults.Resize(numSamples);
 
-				index++;
-			}
+	// Step 2: process all pairs of inputs, block by block
+	uint32 index = 0;
+	for (uint32 j = 0; j < numInputs; ++j)
+	{
+		const double* samplesA = mTile.GetReadPtr() + j * stride;
+		for (uint32 k = 0; k < j; k++)
+		{
+			const double* samplesB = mTile.GetReadPtr() + k * stride;
+			RunCalculation(samplesA, samplesB, numSamples, mResults.GetPtr());
+			mOutputChannels[index].AddSamples(mResults.GetReadPtr(), numSamples);
+			index++;
 		}
-
-		// Step 2: advance all input channel readers (they have to be read multiple during Step 1, so we can't pop the samples there)
-		for (uint32 j = 0; j < numInputs; ++j)
-			mInputReader.GetReader(j)->Advance(1);
 	}
 }
 
@@ -229,7 +224,7 @@ void PairwiseMathNode::ReInitOutputChannels()
 	for (uint32 i = 0; i < numOutputs; ++i)
 	{
 
-		ChannelBase* channelOut = &mOutputChannels[index];
+		ChannelBase* channelOut = &mOutputChannels[i];
 		channelOut->Clear();
 		GetOutputPort(OUTPUTPORT_RESULT).GetChannels()->AddChannel(channelOut);
 	}
@@ -306,16 +301,16 @@ void PairwiseMathNode::SetMathFunction(EMathFunction function)
 	mMathFunction = function;
 	switch (mMathFunction)
 	{
-		case MATHFUNCTION_SUM:				{ RunCalculation = CalculateSum; }						break;
-		case MATHFUNCTION_PRODUCT:			{ RunCalculation = CalculateProduct; }					break;
-		case MATHFUNCTION_AVERAGE:			{ RunCalculation = CalculateAverage; }					break;
-		case MATHFUNCTION_MIN:				{ RunCalculation = CalculateMin; }						break;
-		case MATHFUNCTION_MAX:				{ RunCalculation = CalculateMax; }						break;
-		case MATHFUNCTION_EUCLID_DISTANCE:	{ RunCalculation = CalculateEuclideanDistance; }		break;
-		case MATHFUNCTION_L2_DISTANCE:		{ RunCalculation = CalculateL2Distance; }				break;
-		case MATHFUNCTION_AND:				{ RunCalculation = CalculateAnd; }						break;
-		case MATHFUNCTION_OR:				{ RunCalculation = CalculateOr; }						break;
-		case MATHFUNCTION_XOR:				{ RunCalculation = CalculateXor; }						break;
+		case MATHFUNCTION_SUM:				{ RunCalculation = CalculateBlock<CalculateSum>; }						break;
+		case MATHFUNCTION_PRODUCT:			{ RunCalculation = CalculateBlock<CalculateProduct>; }					break;
+		case MATHFUNCTION_AVERAGE:			{ RunCalculation = CalculateBlock<CalculateAverage>; }					break;
+		case MATHFUNCTION_MIN:				{ RunCalculation = CalculateBlock<CalculateMin>; }						break;
+		case MATHFUNCTION_MAX:				{ RunCalculation = CalculateBlock<CalculateMax>; }						break;
+		case MATHFUNCTION_EUCLID_DISTANCE:	{ RunCalculation = CalculateBlock<CalculateEuclideanDistance>; }		break;
+		case MATHFUNCTION_L2_DISTANCE:		{ RunCalculation = CalculateBlock<CalculateL2Distance>; }				break;
+		case MATHFUNCTION_AND:				{ RunCalculation = CalculateBlock<CalculateAnd>; }						break;
+		case MATHFUNCTION_OR:				{ RunCalculation = CalculateBlock<CalculateOr>; }						break;
+		case MATHFUNCTION_XOR:				{ RunCalculation = CalculateBlock<CalculateXor>; }						break;
 		default:							{ CORE_ASSERT(false); }
 	}
 
@@ -345,6 +340,14 @@ const char* PairwiseMathNode::GetFunctionString(EMathFunction function)
 //-----------------------------------------------
 // the math functions
 //-----------------------------------------------
+
+template <PairwiseMathNode::MathFunction FUNCTION>
+void PairwiseMathNode::CalculateBlock(const double* x, const double* y, uint32 numSamples, double* outResults)
+{
+	for (uint32 i=0; i<numSamples; ++i)
+		outResults[i] = FUNCTION(x[i], y[i]);
+}
+
 double PairwiseMathNode::CalculateSum(double x, double y)						{ return x + y; }
 double PairwiseMathNode::CalculateProduct(double x, double y)					{ return x * y; }
 double PairwiseMathNode::CalculateAverage(double x, double y)					{ return (x + y)*0.5f; }
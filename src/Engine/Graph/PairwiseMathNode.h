@@ -115,9 +115,18 @@ class ENGINE_API PairwiseMathNode : public SPNode
 		static double CORE_CDECL CalculateAnd(double x, double y);
 		static double CORE_CDECL CalculateOr(double x, double y);
 		static double CORE_CDECL CalculateXor(double x, double y);
+
+		// block version of a math function: applies it on two contiguous sample arrays (instantiated per function, so it is inlined and vectorized)
+		typedef void (CORE_CDECL *MathBlockFunction)(const double* x, const double* y, uint32 numSamples, double* outResults);
+		template <MathFunction FUNCTION>
+		static void CORE_CDECL CalculateBlock(const double* x, const double* y, uint32 numSamples, double* outResults);
 		
 		// Active math function
-		MathFunction RunCalculation;
+		MathBlockFunction RunCalculation;
+
+		// scratch memory for the block processing (reused across updates)
+		Core::Array<double> mTile;
+		Core::Array<double> mResults;
 };
 
 
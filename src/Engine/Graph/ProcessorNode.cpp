@@ -24,7 +24,7 @@
 // include required files
 #include "ProcessorNode.h"
 #include "../DSP/Channel.h"
-#include "ProcessorNode.h"
+#include "Classifier.h"
 
 
 using namespace Core;
@@ -153,10 +153,12 @@ void ProcessorNode::Start(const Time& elapsed)
 		delete mProcessors[i];
 	mProcessors.Clear();
 
-	// create new processors
+	// create new processors (they share the scratch memory of the classifier)
+	ScratchArena* scratchArena = FindScratchArena();
 	for (uint32 i = 0; i<numProcessors; ++i)
 	{
 		ChannelProcessor* processor = mProcessorPrototype->Clone();
+		processor->SetScratchArena(scratchArena);
 		mProcessors.Add(processor);
 	}
 
@@ -321,6 +323,20 @@ void ProcessorNode::ReInitProcessors()
 		mProcessors[i]->ReInit();
 }
 
+
+// find the scratch arena of the classifier this node belongs to
+ScratchArena* ProcessorNode::FindScratchArena() const
+{
+	for (Graph* graph = GetParent(); graph != NULL; graph = graph->GetParent())
+	{
+		if (graph->GetType() == Classifier::TYPE_ID)
+			return &static_cast<Classifier*>(graph)->GetScratchArena();
+	}
+
+	return NULL;
+}
+
+
 double ProcessorNode::GetDelay(uint32 inputPortIndex, uint32 outputPortIndex) const
 {
 	if (mProcessors.Size() == 0)
@@ -69,6 +69,7 @@ class ENGINE_API ProcessorNode : public SPNode
 		void SetupProcessors();
 		void ReInitProcessors();
 		bool ValidateConnections();
+		Core::ScratchArena* FindScratchArena() const;
 
 		Core::Array<ChannelProcessor*>	mProcessors;
 
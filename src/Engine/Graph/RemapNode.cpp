@@ -129,6 +129,12 @@ void RemapNode::Update(const Time& elapsed, const Time& delta)
 
 void RemapNode::OnAttributesChanged()
 {
+	// nothing changed since the last call
+	if (HasDirtyAttributes() == false)
+		return;
+
+	ClearDirtyAttributes();
+
 	const double inputMin = GetFloatAttribute (ATTRIB_INPUTMIN);
 	const double inputMax = GetFloatAttribute (ATTRIB_INPUTMAX);
 	const double outputMin = GetFloatAttribute(ATTRIB_OUTPUTMIN);
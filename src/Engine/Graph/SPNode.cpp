@@ -648,100 +648,6 @@ void SPNode::UpdateChannelActivity(double timePassedInSeconds)
 }
 
 
-// this resizes the output buffers recursively
-void SPNode::ResizeBuffers(double seconds)
-{
-	LogTraceRT("ResizeBuffers");
-
-	// buffers already resized -> do nothing
-	if (IsResizeBuffersReady() == true)
-		return;
-
-	SetResizeBuffersReady(true);
-
-	// depth-first recursive: call ResizeBuffers of all parent nodes
-	const uint32 numInPorts = GetNumInputPorts();
-	for (uint32 i=0; i<numInPorts; ++i)
-	{
-		if (mInputPorts[i].HasConnection() == false)
-			continue;
-
-		Connection* connection = mInputPorts[i].GetConnection();
-		if (connection != NULL)
-		{
-			Node* parentNode = connection->GetSourceNode();
-			CORE_ASSERT(parentNode->GetNodeType() != Node::NODE_TYPE);
-			
-			SPNode* parentSPNode = static_cast<SPNode*>(parentNode);
-			parentSPNode->ResizeBuffers(seconds);
-		}
-	}
-
-	// resize this node's buffers 
-	const uint32 numOutPorts = GetNumOutputPorts();
-	for (uint32 i = 0; i < numOutPorts; ++i)
-	{
-		Port& port = GetOutputPort(i);
-
-		// get the output channel (if its a multichannel, use the first in the set)
-		MultiChannel* channels = port.GetChannels();
-
-		// skip empty sets
-		if (channels->GetNumChannels() == 0)
-			continue;
-
-		// skip channels that are not buffers (for example sensor channels)
-		if (channels->IsBuffer() == false)
-			continue;
-
-		uint32 minBufferSizeForReader = 1;
-
-		// 1) find the number of minimum required samples by iterating over all child nodes
-		const uint32 numChildren = mParentGraph->CalcNumOutputConnections(this, i);
-		for (uint32 c = 0; c < numChildren; c++)
-		{
-			Connection* connection = mParentGraph->GetConnection(mParentGraph->FindOutputConnection(this, i, c));
-			Node* childNode = connection->GetTargetNode();
-			CORE_ASSERT(childNode->GetNodeType() != Node::NODE_TYPE);
-			SPNode* childSPNode = static_cast<SPNode*>(childNode);
-
-			// find max buffer size of all children
-			const uint32 portIndex = connection->GetTargetPort();
-			minBufferSizeForReader = Max(minBufferSizeForReader, childSPNode->GetNumEpochSamples(portIndex));
-		}
-
-		// 2) calculate minimum buffer size, by time
-		const uint32 defaultMinBufferSize = 500;
-		const double sampleRate = channels->GetSampleRate();
-		const uint32 minBufferSizeForRealtime = (sampleRate > 0 ? seconds * sampleRate : defaultMinBufferSize);
-		const uint32 newBufferSize = minBufferSizeForReader + minBufferSizeForRealtime;
-
-		// 3) resize all buffers and reset node if size has changed
-		const uint32 numChannels = channels->GetNumChannels();
-		for (uint32 c = 0; c<numChannels; ++c)
-		{
-			ChannelBase* channel = channels->GetChannel(c);
-
-			// only grow buffers
-			if (newBufferSize > channel->GetBufferSize())
-			{
-				LogDebug("SPNode::ResizeBuffers: resizing buffers from %i to %i", channel->GetBufferSize(), newBufferSize);
-
-				// get last sampletime before resetting it
-				Time newStartTime = channel->GetLastSampleTime();
-
-				// set new buffer size (grow only, resets channel)
-				channel->SetBufferSize(newBufferSize);
-
-				// continue channel where it ended
-				channel->SetStartTime(newStartTime);
-			}
-		}
-	}
-}
-
-
-
 //
 // Recursive Max Delay Calculations
 //
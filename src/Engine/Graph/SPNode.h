@@ -123,11 +123,6 @@ class ENGINE_API SPNode : public Node
 		// reset output channels
 		void ResetBuffers();
 
-		// resize buffers and that of and all parent nodes recursively
-		void ResizeBuffers(double seconds);
-		bool IsResizeBuffersReady() const							{ return mIsResizeBuffersReady; }
-		void SetResizeBuffersReady(bool isReady)					{ mIsResizeBuffersReady = isReady; }
-
 		// recursively find maxmimum delay of this node
 		virtual double FindMaximumDelay();
 		virtual double FindMaximumDelayForInput(uint32 inputPortIndex);
@@ -158,7 +153,7 @@ class ENGINE_API SPNode : public Node
 		// TODO deprecate this
 		virtual uint32 GetNumStartupSamples (uint32 inputPortIndex) const							{ return 1; }
 
-		// number of samples the input will read at once
+		// number of samples the input will read at once (sizes the buffer of the connected output, nodes that read older samples have to include them)
 		virtual uint32 GetNumEpochSamples(uint32 inputPortIndex) const								{ return 1; }
 		
 		// get buffer stats
@@ -174,9 +169,6 @@ class ENGINE_API SPNode : public Node
 		// will store mIsInitialized right the beginning of SPNode::ReInit() so we can detect a change in state
 		bool		mLastActivityState;
 
-		// marker flag for recursive buffer reize; true if this node's buffers were already resized
-		bool		mIsResizeBuffersReady;
-
 		// helper list for storing the mapping : input port multichannel index after multiplication <-> channel reader indices
 		Core::Array<uint32> mChannelReaderMap;		// array of all multichannel indices of all port (for all ports: for all [multiplied] channels of port)
 			
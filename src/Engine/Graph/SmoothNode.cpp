@@ -95,12 +95,15 @@ void SmoothNode::Update(const Time& elapsed, const Time& delta)
 // update the settings
 void SmoothNode::OnAttributesChanged()
 {
-	const double interpolationSpeed = GetFloatAttributeByName("interpolationSpeed");
-	const double startValue = GetFloatAttributeByName("startValue");
+	// only reconfigure the processors if one of our attributes changed
+	if (IsAttributeDirty(ATTRIB_INTERPOLATIONSPEED) == false && IsAttributeDirty(ATTRIB_STARTVALUE) == false)
+		return;
+
+	mSettings.mInterpolationSpeed = GetFloatAttribute(ATTRIB_INTERPOLATIONSPEED);
+	mSettings.mStartValue = GetFloatAttribute(ATTRIB_STARTVALUE);
+	ClearAttributeDirty(ATTRIB_INTERPOLATIONSPEED);
+	ClearAttributeDirty(ATTRIB_STARTVALUE);
 
-	mSettings.mInterpolationSpeed = interpolationSpeed;
-	mSettings.mStartValue = startValue;
-	
 	// update settings
 	SetupProcessors();
 }
@@ -867,42 +867,98 @@ uint32 StateMachine::CollectAssets(bool forceUpdate)
 	//
 	const uint32 numStates = mActionStates.Size();
 	for (uint32 i=0; i<numStates; ++i)
+		CollectStateAssets( mActionStates[i], mAssets );
+
+	// TODO recursively collect the assets of all child statemachines
+
+	mAssetsInitialized = true;
+	return mAssets.Size();
+}
+
+
+// add the on-enter and on-exit action assets of the given state
+void StateMachine::CollectStateAssets(State* state, Array<Asset>& outAssets)
+{
+	if (state->GetType() != ActionState::TYPE_ID)
+		return;
+
+	ActionState* actionState = static_cast<ActionState*>(state);
+
+	// add on-enter action assets
+	uint32 numActions = actionState->GetOnEnterActions().GetNumActions();
+	for (uint32 j=0; j<numActions; ++j)
 	{
-		ActionState* state = mActionStates[i];
+		Action* action = actionState->GetOnEnterActions().GetAction(j);
 
-		// add on-enter action assets
-		uint32 numActions = state->GetOnEnterActions().GetNumActions();
-		for (uint32 j=0; j<numActions; ++j)
-		{
-			Action* action = state->GetOnEnterActions().GetAction(j);
-			
-			Asset asset;
-			action->GetAsset( &asset.mLocation, &asset.mType, &asset.mAllowStreaming );
-			if (asset.mType == Action::ASSET_NONE)
-				continue;
+		Asset asset;
+		action->GetAsset( &asset.mLocation, &asset.mType, &asset.mAllowStreaming );
+		if (asset.mType == Action::ASSET_NONE)
+			continue;
 
-			mAssets.Add( asset );
-		}
+		outAssets.Add( asset );
+	}
 
-		// add on-exit action assets
-		numActions = state->GetOnExitActions().GetNumActions();
-		for (uint32 j=0; j<numActions; ++j)
-		{
-			Action* action = state->GetOnExitActions().GetAction(j);
+	// add on-exit action assets
+	numActions = actionState->GetOnExitActions().GetNumActions();
+	for (uint32 j=0; j<numActions; ++j)
+	{
+		Action* action = actionState->GetOnExitActions().GetAction(j);
 
-			Asset asset;
-			action->GetAsset( &asset.mLocation, &asset.mType, &asset.mAllowStreaming );
-			if (asset.mType == Action::ASSET_NONE)
-				continue;
+		Asset asset;
+		action->GetAsset( &asset.mLocation, &asset.mType, &asset.mAllowStreaming );
+		if (asset.mType == Action::ASSET_NONE)
+			continue;
 
-			mAssets.Add( asset );
-		}
+		outAssets.Add( asset );
 	}
+}
 
-	// TODO recursively collect the assets of all child statemachines
 
-	mAssetsInitialized = true;
-	return mAssets.Size();
+// collect the assets of the states that can be reached next (breadth first over the enabled transitions)
+void StateMachine::CollectUpcomingAssets(Array<Asset>& outAssets, uint32 numStatesAhead)
+{
+	outAssets.Clear(false);
+
+	Array<State*> visitedStates;
+	Array<State*> currentStates;
+	Array<State*> nextStates;
+
+	// start at the active states, or at the entry states in case the state machine didn't start yet
+	if (mActiveStates.Size() > 0)
+		currentStates = mActiveStates;
+	else
+	{
+		const uint32 numEntryStates = mEntryStates.Size();
+		for (uint32 i=0; i<numEntryStates; ++i)
+			currentStates.Add( (State*)mEntryStates[i] );
+	}
+
+	for (uint32 depth=0; depth<=numStatesAhead && currentStates.Size() > 0; ++depth)
+	{
+		nextStates.Clear(false);
+
+		const uint32 numCurrentStates = currentStates.Size();
+		for (uint32 i=0; i<numCurrentStates; ++i)
+		{
+			State* state = currentStates[i];
+			if (visitedStates.Contains(state) == true)
+				continue;
+
+			visitedStates.Add( state );
+			CollectStateAssets( state, outAssets );
+
+			// follow the outgoing transitions
+			const uint32 numOutTransitions = FindNumOutTransitions( state, true );
+			for (uint32 t=0; t<numOutTransitions; ++t)
+			{
+				State* targetState = FindOutTransition( state, t, true )->GetTargetState();
+				if (targetState != NULL && visitedStates.Contains(targetState) == false)
+					nextStates.Add( targetState );
+			}
+		}
+
+		currentStates = nextStates;
+	}
 }
 
 
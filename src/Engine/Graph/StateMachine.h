@@ -98,6 +98,8 @@ class ENGINE_API StateMachine : public Graph
 		};
 
 		uint32 CollectAssets(bool forceUpdate=false);
+		// assets of the active states and of the states reachable within the given number of transitions (entry states if none is active)
+		void CollectUpcomingAssets(Core::Array<Asset>& outAssets, uint32 numStatesAhead);
 		Core::Array<Asset>& GetAssets()						{ return mAssets; }
 		Asset* FindAssetByLocation(const char* location);
 		void SetAssetActivity(const char* location, Asset::EActivity activity);
@@ -175,6 +177,7 @@ class ENGINE_API StateMachine : public Graph
 
 	private:
 		bool SaveTransitions(Core::Json& json, Core::Json::Item& item);
+		void CollectStateAssets(State* state, Core::Array<Asset>& outAssets);
 
 		Core::Array<State*>				mActiveStates;		
 		Core::Array<StateTransition*>	mActiveTransitions;
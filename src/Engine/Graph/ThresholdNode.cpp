@@ -298,11 +298,15 @@ void ThresholdNode::Processor::Update()
 	double lowThreshold = mSettings.mLowThreshold;
 	double highThreshold = mSettings.mHighThreshold;
 
+	ScratchArena& scratchArena = GetScratchArena();
+
 	// calculate statistics for this epoch
 	for (uint32 e = 0; e < numNewEpochs; ++e)
 	{
-		// get the input epoch
+		// get the input epoch and copy its samples to scratch memory
+		ScratchArena::Scope scratchScope(scratchArena);
 		Epoch inputEpoch = inputReader->PopOldestEpoch();
+		inputEpoch.Materialize(scratchArena);
 
 		// get the first threshold value from the input (if there is a sample aligned to the epoc (time of last sample))
 		ChannelBase* lowChannel = lowThresholdReader->GetChannel();
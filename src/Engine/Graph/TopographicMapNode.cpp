@@ -0,0 +1,317 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "TopographicMapNode.h"
+#include "../Core/Math.h"
+#include "../EngineManager.h"
+
+
+using namespace Core;
+
+// constructor
+TopographicMapNode::TopographicMapNode(Graph* graph) : SPNode(graph)
+{
+	UseChannelMetadataPropagation(false);
+	UseChannelColoring(false);
+
+	mResolution		= 16;
+	mSplineOrder	= 4;
+	mMapResolution	= 0;
+}
+
+
+// destructor
+TopographicMapNode::~TopographicMapNode()
+{
+	DeleteOutputChannels();
+}
+
+
+// initialize the node
+void TopographicMapNode::Init()
+{
+	// init base class first
+	SPNode::Init();
+
+	// configure SPNode behaviour
+	RequireMatchingSampleRates();
+	RequireInputConnection();
+
+	// SETUP PORTS
+
+	// setup the input ports
+	InitInputPorts(1);
+	GetInputPort(INPUTPORT).SetupAsChannels<double>("EEG", "x", INPUTPORT);
+
+	// setup the output ports
+	InitOutputPorts(1);
+	GetOutputPort(OUTPUTPORT).SetupAsChannels<double>("Map", "y", OUTPUTPORT);
+
+	// ATTRIBUTES
+
+	// map resolution
+	Core::AttributeSettings* resolutionAttr = RegisterAttribute("Resolution", "resolution", "Width and height of the scalp map in pixels (one output channel per pixel).", Core::ATTRIBUTE_INTERFACETYPE_INTSPINNER);
+	resolutionAttr->SetDefaultValue( Core::AttributeInt32::Create(mResolution) );
+	resolutionAttr->SetMinValue( Core::AttributeInt32::Create(2) );
+	resolutionAttr->SetMaxValue( Core::AttributeInt32::Create(64) );
+
+	// spline order
+	Core::AttributeSettings* orderAttr = RegisterAttribute("Spline Order", "splineOrder", "Order m of the spherical spline. Higher orders give smoother maps.", Core::ATTRIBUTE_INTERFACETYPE_INTSPINNER);
+	orderAttr->SetDefaultValue( Core::AttributeInt32::Create(mSplineOrder) );
+	orderAttr->SetMinValue( Core::AttributeInt32::Create(2) );
+	orderAttr->SetMaxValue( Core::AttributeInt32::Create(6) );
+}
+
+
+// reset everything
+void TopographicMapNode::Reset()
+{
+	SPNode::Reset();
+
+	DeleteOutputChannels();
+
+	mSpline.Clear();
+	mElectrodes.Clear();
+	mElectrodeReaders.Clear();
+	mPixelToTarget.Clear();
+	mScalpMap.Clear();
+	mMapResolution = 0;
+}
+
+
+void TopographicMapNode::ReInit(const Time& elapsed, const Time& delta)
+{
+	if (BaseReInit(elapsed, delta) == false)
+		return;
+
+	// reinit baseclass
+	SPNode::ReInit(elapsed, delta);
+
+	PostReInit(elapsed, delta);
+}
+
+
+// precalculate the interpolation operator and create the output channels
+void TopographicMapNode::Start(const Time& elapsed)
+{
+	if (InitMontage() == false)
+		mIsInitialized = false;
+
+	ReInitOutputChannels();
+
+	// Note: we have to call SPNode::Start after we created the channels
+	SPNode::Start(elapsed);
+}
+
+
+// update the node
+void TopographicMapNode::Update(const Time& elapsed, const Time& delta)
+{
+	if (BaseUpdate(elapsed, delta) == false)
+		return;
+
+	// update the baseclass
+	SPNode::Update(elapsed, delta);
+
+	// nothing to do if node is not initialized
+	if (mIsInitialized == false || mSpline.IsInitialized() == false)
+		return;
+
+	const uint32 numSamples = mInputReader.GetMinNumNewSamples();
+	if (numSamples == 0)
+		return;
+
+	// read all new samples at once
+	const uint32 stride = mInputReader.PopOldestSamples(numSamples, mTile);
+
+	const uint32 numElectrodes = mElectrodes.Size();
+	const uint32 numPixels = mPixelToTarget.Size();
+	for (uint32 s=0; s<numSamples; ++s)
+	{
+		// one frame of electrode values
+		for (uint32 e=0; e<numElectrodes; ++e)
+			mElectrodeValues[e] = mTile[mElectrodeReaders[e] * stride + s];
+
+		// interpolate and scatter the values into the map
+		mSpline.Interpolate(mElectrodeValues.GetReadPtr(), mTargetValues.GetPtr());
+		for (uint32 p=0; p<numPixels; ++p)
+		{
+			const uint32 target = mPixelToTarget[p];
+			const double value = (target != CORE_INVALIDINDEX32 ? mTargetValues[target] : 0.0);
+
+			mScalpMap[p] = value;
+			mOutputChannels[p]->AddSample(value);
+		}
+	}
+}
+
+
+// update the data
+void TopographicMapNode::OnAttributesChanged()
+{
+	const uint32 resolution = GetInt32Attribute(ATTRIB_RESOLUTION);
+	const uint32 splineOrder = GetInt32Attribute(ATTRIB_SPLINEORDER);
+	if (resolution == mResolution && splineOrder == mSplineOrder)
+		return;
+
+	mResolution = resolution;
+	mSplineOrder = splineOrder;
+
+	// the operator has to be recalculated
+	ResetAsync();
+}
+
+
+// map input channels to EEG electrodes by name and precalculate the spline operator for this montage and map resolution
+bool TopographicMapNode::InitMontage()
+{
+	mSpline.Clear();
+	mElectrodes.Clear();
+	mElectrodeReaders.Clear();
+	mMapResolution = 0;
+
+	EEGElectrodes* eegElectrodes = GetEngine()->GetEEGElectrodes();
+	bool electrodeNotFound = false;
+
+	// go through all channels and check if they are named like our electrodes
+	Array<Vector3> electrodePositions;
+	const uint32 numChannels = mInputReader.GetNumChannels();
+	for (uint32 i=0; i<numChannels; ++i)
+	{
+		const String& name = mInputReader.GetChannel(i)->GetNameString();
+		if (eegElectrodes->IsValidElectrodeID(name) == false)
+		{
+			electrodeNotFound = true;
+			continue;
+		}
+
+		const EEGElectrodes::Electrode electrode = eegElectrodes->GetElectrodeByID(name);
+
+		// project the 2D layout position back onto the upper unit sphere, so map and electrode plots share the same projection
+		const Vector2 position = eegElectrodes->Get2DPosition(electrode);
+		const double radius = Math::SqrtD((double)position.x * position.x + (double)position.y * position.y);
+		const double angle = radius * 0.5 * Math::piD;
+		const double scale = (radius > 0.0 ? Math::SinD(angle) / radius : 0.0);
+
+		electrodePositions.Add( Vector3(position.x * scale, position.y * scale, Math::CosD(angle)) );
+		mElectrodes.Add(electrode);
+		mElectrodeReaders.Add(i);
+	}
+
+	// show node error message if there were some unknown IDs
+	if (electrodeNotFound == true)
+		SetError(ERROR_ELECTRODE_NAMES, "Input channels are not named like electrodes (case-sensitive).");
+	else
+		ClearError(ERROR_ELECTRODE_NAMES);
+
+	// pixel grid: pixel centers in [-1,1], row 0 is the front of the head (+x), column 0 the left side (+y)
+	const uint32 numPixels = mResolution * mResolution;
+	mPixelToTarget.Resize(numPixels);
+	mScalpMap.Resize(numPixels);
+	mScalpMap.SetAll(0.0);
+
+	Array<Vector3> targetPositions;
+	for (uint32 row=0; row<mResolution; ++row)
+	{
+		for (uint32 col=0; col<mResolution; ++col)
+		{
+			const double x = 1.0 - (2.0 * row + 1.0) / mResolution;
+			const double y = 1.0 - (2.0 * col + 1.0) / mResolution;
+			const double radius = Math::SqrtD(x * x + y * y);
+
+			const uint32 pixel = row * mResolution + col;
+			if (radius > 1.0)
+			{
+				mPixelToTarget[pixel] = CORE_INVALIDINDEX32;
+				continue;
+			}
+
+			const double angle = radius * 0.5 * Math::piD;
+			const double scale = (radius > 0.0 ? Math::SinD(angle) / radius : 0.0);
+
+			mPixelToTarget[pixel] = targetPositions.Size();
+			targetPositions.Add( Vector3(x * scale, y * scale, Math::CosD(angle)) );
+		}
+	}
+
+	// precalculate the operator once for this montage
+	if (electrodePositions.Size() == 0 || mSpline.Init(electrodePositions, targetPositions, mSplineOrder) == false)
+	{
+		SetError(ERROR_SPLINE, "Could not calculate the interpolation for the connected electrodes.");
+		return false;
+	}
+	ClearError(ERROR_SPLINE);
+
+	mElectrodeValues.Resize(mElectrodes.Size());
+	mTargetValues.Resize(targetPositions.Size());
+	mMapResolution = mResolution;
+	return true;
+}
+
+
+// create one output channel per pixel
+void TopographicMapNode::ReInitOutputChannels()
+{
+	DeleteOutputChannels();
+
+	const double sampleRate = mInputReader.GetSampleRate();
+	const uint32 numPixels = mResolution * mResolution;
+	mOutputChannels.Resize(numPixels);
+
+	MultiChannel* multichannel = GetOutputPort(OUTPUTPORT).GetChannels();
+	for (uint32 i=0; i<numPixels; ++i)
+	{
+		Channel<double>* channel = new Channel<double>();
+
+		mTempString.Format("%i,%i", i / mResolution, i % mResolution);
+		channel->SetBufferSize(10);		// set any buffersize > 0
+		channel->SetName(mTempString);
+		channel->SetSampleRate(sampleRate);
+
+		mOutputChannels[i] = channel;
+		multichannel->AddChannel(channel);
+	}
+}
+
+
+// delete all output channels and remove them from the port
+void TopographicMapNode::DeleteOutputChannels()
+{
+	if (GetNumOutputPorts() > 0)
+		GetOutputPort(OUTPUTPORT).GetChannels()->Clear();
+
+	DestructArray(mOutputChannels);
+	mOutputChannels.Clear();
+}
+
+
+Core::String& TopographicMapNode::GetDebugString(Core::String& inout)
+{
+	SPNode::GetDebugString(inout);
+
+	mTempString.Format("Num Electrodes: %i\nResolution: %i\n", mElectrodes.Size(), mResolution);
+	inout += mTempString;
+
+	return inout;
+}
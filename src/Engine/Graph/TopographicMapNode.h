@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_TOPOGRAPHICMAPNODE_H
+#define __NEUROMORE_TOPOGRAPHICMAPNODE_H
+
+// include the required headers
+#include "../Config.h"
+#include "../Core/StandardHeaders.h"
+#include "SPNode.h"
+#include "../EEGElectrodes.h"
+#include "../DSP/SphericalSpline.h"
+
+
+// interpolates the electrode channels onto a square scalp map (one output channel per pixel, row by row)
+//  - the spherical spline operator is precalculated once per montage in Start(), each sample is then a single matrix-vector product
+//  - pixels are placed on the same azimuthal projection as EEGElectrodes::Get2DPosition(); pixels outside the head circle are zero
+class ENGINE_API TopographicMapNode : public SPNode
+{
+	public:
+		enum { TYPE_ID = 0x0060 };
+		static const char* Uuid () { return "108f6928-cbc9-11f1-abcc-02fc00000001"; }
+
+		enum
+		{
+			INPUTPORT	= 0,
+			OUTPUTPORT	= 0,
+		};
+
+		enum
+		{
+			ATTRIB_RESOLUTION	= 0,
+			ATTRIB_SPLINEORDER,
+		};
+
+		enum EError
+		{
+			ERROR_ELECTRODE_NAMES	= GraphObjectError::ERROR_CONFIGURATION | 0x01,
+			ERROR_SPLINE			= GraphObjectError::ERROR_CONFIGURATION | 0x02,
+		};
+
+		// constructor & destructor
+		TopographicMapNode(Graph* graph);
+		~TopographicMapNode();
+
+		// initialize & update
+		void Init() override;
+		void Reset() override;
+		void ReInit(const Core::Time& elapsed, const Core::Time& delta) override;
+		void Start(const Core::Time& elapsed) override;
+		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+
+		void OnAttributesChanged() override;
+
+		Core::Color GetColor() const override								{ return Core::RGBA(20, 110, 105); }
+		uint32 GetType() const override											{ return TYPE_ID; }
+		const char* GetTypeUuid() const override final							{ return Uuid(); }
+		const char* GetReadableType() const override							{ return "Topographic Map"; }
+		const char* GetRuleName() const override final							{ return "NODE_TopographicMap"; }
+		uint32 GetPaletteCategory() const override								{ return CATEGORY_MATH; }
+		GraphObject* Clone(Graph* graph) override								{ TopographicMapNode* clone = new TopographicMapNode(graph); return clone; }
+
+		// the latest scalp map (resolution x resolution values, row by row, front of the head at row 0)
+		uint32 GetResolution() const											{ return mMapResolution; }
+		const double* GetScalpMap() const										{ return mScalpMap.GetReadPtr(); }
+		bool IsInsideHead(uint32 pixelIndex) const								{ return mPixelToTarget[pixelIndex] != CORE_INVALIDINDEX32; }
+
+		// the electrodes that are used for the interpolation
+		uint32 GetNumElectrodes() const											{ return mElectrodes.Size(); }
+		const EEGElectrodes::Electrode& GetElectrode(uint32 index) const		{ return mElectrodes[index]; }
+
+		Core::String& GetDebugString(Core::String& inout) override;
+
+	private:
+		// map input channels to electrodes and precalculate the interpolation operator
+		bool InitMontage();
+
+		// outputs
+		void ReInitOutputChannels();
+		void DeleteOutputChannels();
+
+		uint32									mResolution;
+		uint32									mSplineOrder;
+		uint32									mMapResolution;			// resolution of the current map (attribute changes only apply after the restart)
+
+		SphericalSpline							mSpline;
+		Core::Array<EEGElectrodes::Electrode>	mElectrodes;			// one electrode per used input channel
+		Core::Array<uint32>						mElectrodeReaders;		// input reader index of each electrode
+		Core::Array<uint32>						mPixelToTarget;			// spline target index of each pixel (invalid for pixels outside the head)
+
+		Core::Array<double>						mTile;					// new samples of all input channels (channel-major)
+		Core::Array<double>						mElectrodeValues;		// one frame of electrode values
+		Core::Array<double>						mTargetValues;			// one frame of interpolated values (inside the head only)
+		Core::Array<double>						mScalpMap;				// the latest full map
+
+		Core::Array<Channel<double>*>			mOutputChannels;		// one channel per pixel
+};
+
+
+#endif
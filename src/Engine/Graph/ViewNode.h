@@ -104,7 +104,10 @@ class ENGINE_API ViewNode : public SPNode
 		MultiChannel* GetSpectrumChannels();
 		Channel<Spectrum>* GetSpectrumChannel(uint32 index);
 
-		void SetViewDuration(double seconds)									{ mViewDuration = seconds; }
+		// the displayed range can't exceed the maximum view duration, the input buffers are planned for the maximum (so changing the range never resizes them)
+		void SetViewDuration(double seconds)									{ mViewDuration = Core::Clamp(seconds, 0.0, mMaxViewDuration); }
+		double GetViewDuration() const											{ return mViewDuration; }
+		double GetMaxViewDuration() const										{ return mMaxViewDuration; }
 		
 		virtual uint32 GetNumEpochSamples(uint32 inputPortIndex) const override;
 
@@ -24,6 +24,7 @@
 // include required headers
 #include "OscMessageRouter.h"
 #include "../Core/LogManager.h"
+#include <chrono>
 
 
 // constructor
@@ -32,6 +33,7 @@ OscMessageRouter::OscMessageRouter()
 	mNumMessagesRoutedTotal		= 0;
 	mNumMessagesInvalidAddress	= 0;
 	mCatchAllReceiver			= NULL;
+	mOutputBundle				= NULL;
 
 	mReceiverLinkObjects.Resize(0);
 
@@ -44,6 +46,11 @@ OscMessageRouter::OscMessageRouter()
 OscMessageRouter::~OscMessageRouter()
 {
 	UnregisterAllReceivers();
+
+	// destruct the router-owned output packets
+	const uint32 numOutputPackets = mOutputPackets.Size();
+	for (uint32 i=0; i<numOutputPackets; ++i)
+		delete mOutputPackets[i];
 }
  
 
@@ -262,3 +269,112 @@ void OscMessageRouter::ScrubPacketPool()
 	if (mPacketPool.GetNumUsedPackets() > scrubFactor * mPacketPool.GetNumPackets())
 		mPacketPool.ReleaseProcessedPackets();
 }
+
+
+// get a free output packet (engine side)
+OscPacket* OscMessageRouter::AcquireOutputPacket()
+{
+	mOutputLock.Lock();
+
+	OscPacket* packet = NULL;
+	if (mFreeOutputPackets.Size() > 0)
+	{
+		const uint32 lastIndex = mFreeOutputPackets.Size() - 1;
+		packet = mFreeOutputPackets[lastIndex];
+		mFreeOutputPackets.Remove(lastIndex);
+	}
+	else
+	{
+		packet = new OscPacket1k();
+		mOutputPackets.Add(packet);
+	}
+
+	mOutputLock.Unlock();
+
+	packet->Clear();
+	return packet;
+}
+
+
+// push a written packet into the output queue
+void OscMessageRouter::QueueOutputPacket(OscPacket* packet)
+{
+	mOutputLock.Lock();
+	mOutputPacketQueue.Add(packet);
+	mOutputLock.Unlock();
+}
+
+
+// get the open output bundle, start a new one if the message does not fit anymore
+OscPacketParser::OutStream* OscMessageRouter::BeginBundledMessage(uint32 numBytes)
+{
+	// output packets are 1k packets, so the datagram limit is also the buffer capacity: messages that don't fit into an empty bundle (16 byte header) have to be sent on their own
+	if (numBytes + 16 > MAX_DATAGRAM_SIZE)
+		return NULL;
+
+	if (mOutputBundle != NULL && mOutputBundle->GetSize() + numBytes > MAX_DATAGRAM_SIZE)
+		FlushOutputBundle();
+
+	if (mOutputBundle == NULL)
+	{
+		mOutputBundle = AcquireOutputPacket();
+		mOutputBundle->BeginPacket();
+	}
+
+	return mOutputBundle;
+}
+
+
+// close the open bundle and queue it
+void OscMessageRouter::FlushOutputBundle()
+{
+	if (mOutputBundle == NULL)
+		return;
+
+	mOutputBundle->EndPacket();
+	QueueOutputPacket(mOutputBundle);
+	mOutputBundle = NULL;
+}
+
+
+// move all queued packets to the given array
+void OscMessageRouter::TakeOutputPackets(Core::Array<OscPacket*>& outPackets)
+{
+	mOutputLock.Lock();
+	outPackets.Add(mOutputPacketQueue);
+	mOutputPacketQueue.Clear(false);
+	mOutputLock.Unlock();
+}
+
+
+// give sent packets back to the router
+void OscMessageRouter::ReleaseOutputPackets(const Core::Array<OscPacket*>& packets)
+{
+	mOutputLock.Lock();
+	mFreeOutputPackets.Add(packets);
+	mOutputLock.Unlock();
+}
+
+
+// size of an osc message: padded address, padded type tags (",fff...") and the 4 byte arguments
+uint32 OscMessageRouter::CalcMessageSize(const char* address, uint32 numFloats)
+{
+	const uint32 addressSize = ((uint32)strlen(address) + 1 + 3) & ~3;
+	const uint32 typeTagSize = (numFloats + 2 + 3) & ~3;
+	return addressSize + typeTagSize + numFloats * 4;
+}
+
+
+// NTP timetag: seconds since 1900 in the upper, fraction of a second in the lower 32 bits
+uint64 OscMessageRouter::CalcTimeTag(double secondsAgo)
+{
+	const uint64 ntpEpochOffset = 2208988800ULL;
+
+	const int64 nowMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	const int64 microseconds = nowMicroseconds - (int64)(secondsAgo * 1000000.0);
+
+	const uint64 seconds = (uint64)(microseconds / 1000000) + ntpEpochOffset;
+	const uint64 fraction = ((uint64)(microseconds % 1000000) << 32) / 1000000;
+
+	return (seconds << 32) | fraction;
+}
@@ -71,10 +71,30 @@ class ENGINE_API OscMessageRouter
 		// OUTGOING packets
 		// routing packets from anywhere in studio -> Network
 
-		// a Simple queue for outgoing packets because OscServer is not accessible from Engine
-		void QueueOutputPacket(OscPacket* packet)				{ mOutputPacketQueue.Add(packet); }
-		Core::Array<OscPacket*>& GetOutputPacketQueue()			{ return mOutputPacketQueue; }
-		
+		// max size of an outgoing datagram; stays below the ethernet MTU (1500 bytes minus IP/UDP headers) so bundles are never fragmented
+		enum { MAX_DATAGRAM_SIZE = 1024 };
+
+		// a simple queue for outgoing packets because OscServer is not accessible from Engine
+		// output packets are owned by the router: the pool recycles packets without parsed messages, which would free them before they are sent
+		OscPacket* AcquireOutputPacket();
+		void QueueOutputPacket(OscPacket* packet);
+
+		// coalesce messages of all output nodes into bundles: returns the stream of the open bundle, which has room for at least numBytes (NULL if the message is too large for a bundle, send it unbundled then)
+		OscPacketParser::OutStream* BeginBundledMessage(uint32 numBytes);
+		// close the open bundle and queue it for sending (called once per engine update)
+		void FlushOutputBundle();
+
+		// called by the network layer: take all queued packets and hand them back after they were sent
+		void TakeOutputPackets(Core::Array<OscPacket*>& outPackets);
+		void ReleaseOutputPackets(const Core::Array<OscPacket*>& packets);
+
+		// size of a message with the given address and number of float arguments, and of a timetagged bundle around it
+		static uint32 CalcMessageSize(const char* address, uint32 numFloats);
+		static uint32 CalcBundledMessageSize(const char* address, uint32 numFloats)	{ return 20 + 4 + CalcMessageSize(address, numFloats); }
+
+		// NTP timetag of the current wall-clock time minus the given number of seconds
+		static uint64 CalcTimeTag(double secondsAgo);
+
 		OscPacket* GetOscPacketFromPool()						{ return mPacketPool.AcquirePacket(); }
 		void ScrubPacketPool();
 		uint32 GetNumPooledPacketsFree() const					{ return mPacketPool.GetNumFreePackets(); }
@@ -106,7 +126,13 @@ class ENGINE_API OscMessageRouter
 
 		// packet pool for outgoing packets
 		OscPacketPool						mPacketPool;
+
+		// router-owned output packets
+		Core::Array<OscPacket*>				mOutputPackets;
+		Core::Array<OscPacket*>				mFreeOutputPackets;
 		Core::Array<OscPacket*>				mOutputPacketQueue;
+		OscPacket*							mOutputBundle;
+		Core::Mutex							mOutputLock;
 		
 		// FPS counter
 		Core::FpsCounter					mFpsCounter;
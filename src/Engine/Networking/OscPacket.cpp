@@ -32,7 +32,7 @@ using namespace Core;
 OscPacket::OscPacket(uint32 numBytes) : OscPacketParser::OutStream()
 {
 	// packet data 
-	mData = (char*)Allocate(numBytes);
+	mData = (char*)Allocate(numBytes, MEMORYTAG_NETWORKING);
 	mMaxSize = numBytes;
 
 	// also use packet data as write buffer
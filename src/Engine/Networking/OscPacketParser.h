@@ -94,6 +94,7 @@ class ENGINE_API OscPacketParser
 
 			const char* GetData()		{ return mBuffer; }
 			uint32		GetSize()		{ return (uint32)mOscPackStream->Size(); }
+			uint32		GetCapacity()	{ return mBufferSize; }
 			
 			// special message tokens
 			OutStream& operator<<(const BeginMessage& token)	{ BeginMessage(token.mPath);  return *this; }
@@ -113,6 +114,7 @@ class ENGINE_API OscPacketParser
 			inline void BeginMessage (const char* path)			{ CORE_ASSERT(mInitialized); (*mOscPackStream) << osc::BeginMessage(path);		}
 			inline void EndMessage()							{ CORE_ASSERT(mInitialized); (*mOscPackStream) << osc::MessageTerminator();	}
 			inline void BeginPacket()							{ CORE_ASSERT(mInitialized); (*mOscPackStream) << osc::BeginBundleImmediate;	}
+			inline void BeginPacket(uint64 timeTag)				{ CORE_ASSERT(mInitialized); (*mOscPackStream) << osc::BeginBundle(timeTag);	}
 			inline void EndPacket()								{ CORE_ASSERT(mInitialized); (*mOscPackStream) << osc::EndBundle;				}
 			// values
 			inline void WriteValue(bool value)					{ CORE_ASSERT(mInitialized); (*mOscPackStream) << value; }
@@ -0,0 +1,144 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "OfflineRunner.h"
+#include "EngineManager.h"
+#include "Graph/FileReaderNode.h"
+
+using namespace Core;
+
+// constructor
+OfflineRunner::OfflineRunner()
+{
+	mStepSize		= 1.0;
+	mMaxDuration	= 0.0;
+	mNumUpdates		= 0;
+	mDuration		= 0;
+}
+
+
+// destructor
+OfflineRunner::~OfflineRunner()
+{
+}
+
+
+// run the active classifier until its recordings ended
+bool OfflineRunner::Run()
+{
+	mNumUpdates	= 0;
+	mDuration	= 0;
+
+	EngineManager* engine = GetEngine();
+	Classifier* classifier = engine->GetActiveClassifier();
+	if (classifier == NULL)
+	{
+		LogError("OfflineRunner: No active classifier.");
+		return false;
+	}
+
+	// a paused engine would never advance
+	if (engine->IsRunning() == false || mStepSize <= 0.0)
+	{
+		LogError("OfflineRunner: Engine is paused or the step size is invalid.");
+		return false;
+	}
+
+	// without file input and without time limit the run would never end
+	uint32 numFileReaders = 0;
+	const uint32 numNodes = classifier->GetNumNodes();
+	for (uint32 i=0; i<numNodes; ++i)
+	{
+		if (classifier->GetNode(i)->GetType() == FileReaderNode::TYPE_ID)
+			numFileReaders++;
+	}
+
+	if (numFileReaders == 0 && mMaxDuration <= 0.0)
+	{
+		LogError("OfflineRunner: Classifier has no file reader node and no maximum duration was set.");
+		return false;
+	}
+
+	// every update has to fit into the classifier buffers
+	double stepSize = mStepSize;
+	const double maxStepSize = classifier->GetBufferDuration() * 0.5;
+	if (stepSize > maxStepSize)
+	{
+		LogWarning("OfflineRunner: Step size of %.2f s does not fit into the classifier buffers, using %.2f s.", stepSize, maxStepSize);
+		stepSize = maxStepSize;
+	}
+
+	const bool wasOffline = engine->IsOfflineMode();
+	engine->SetOfflineMode(true);
+
+	engine->Reset();
+	GetSession()->Start();
+
+	const Time delta = stepSize;
+	bool isFlushing = false;
+	while (true)
+	{
+		engine->Update(delta);
+		mNumUpdates++;
+		mDuration = engine->GetElapsedTime();
+
+		OnUpdate(mDuration);
+
+		if (mMaxDuration > 0.0 && mDuration >= mMaxDuration)
+			break;
+
+		// one more update after the recordings ended, for samples that are still on their way through the graph
+		if (HasPendingInput(classifier) == true)
+			isFlushing = false;
+		else if (isFlushing == true)
+			break;
+		else
+			isFlushing = true;
+	}
+
+	GetSession()->Stop();
+	engine->SetOfflineMode(wasOffline);
+
+	return true;
+}
+
+
+// true while at least one file reader still has samples left to play back
+bool OfflineRunner::HasPendingInput(Classifier* classifier) const
+{
+	const uint32 numNodes = classifier->GetNumNodes();
+	for (uint32 i=0; i<numNodes; ++i)
+	{
+		Node* node = classifier->GetNode(i);
+		if (node->GetType() != FileReaderNode::TYPE_ID)
+			continue;
+
+		// readers that could not load their file (or whose file is empty) have nothing to play back
+		FileReaderNode* reader = static_cast<FileReaderNode*>(node);
+		if (reader->HasData() == true && reader->IsEndOfData() == false)
+			return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,72 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_OFFLINERUNNER_H
+#define __NEUROMORE_OFFLINERUNNER_H
+
+// include required headers
+#include "Config.h"
+#include "Core/StandardHeaders.h"
+#include "Core/Time.h"
+#include "Graph/Classifier.h"
+
+
+// runs the active classifier of the current engine over its recorded inputs (file reader nodes) as fast as the data allows
+// the engine is switched into offline mode and updated with fixed simulated steps, so two runs over the same data give the same results
+class ENGINE_API OfflineRunner
+{
+	public:
+		// constructor & destructor
+		OfflineRunner();
+		virtual ~OfflineRunner();
+
+		// simulated time per engine update (larger steps mean fewer updates, but every step has to fit into the classifier buffers)
+		void SetStepSize(double seconds)										{ mStepSize = seconds; }
+		double GetStepSize() const												{ return mStepSize; }
+
+		// upper bound of the simulated time, required for classifiers that have no file input (0 = unlimited)
+		void SetMaxDuration(double seconds)										{ mMaxDuration = seconds; }
+		double GetMaxDuration() const											{ return mMaxDuration; }
+
+		// reset the engine, start a session and update until all file readers played back their recordings
+		bool Run();
+
+		// called after every engine update of the run
+		virtual void OnUpdate(const Core::Time& elapsed)						{}
+
+		// statistics of the last run
+		uint32 GetNumUpdates() const											{ return mNumUpdates; }
+		const Core::Time& GetDuration() const									{ return mDuration; }
+
+	private:
+		// true while at least one file reader still has samples left to play back
+		bool HasPendingInput(Classifier* classifier) const;
+
+		double			mStepSize;
+		double			mMaxDuration;
+		uint32			mNumUpdates;
+		Core::Time		mDuration;
+};
+
+
+#endif
@@ -149,7 +149,9 @@ void Sensor::Update(const Time& elapsed, const Time& delta)
 		mRealSampleRate = numSamplesReceivedTotal / realElapsedTime.InSeconds();
 
 	// correct hardware clock drift (iff enabled in sensor and in engine and input channel is of constant sample rate)
-	if (mUseDriftCorrection == true && GetEngine()->GetDriftCorrectionSettings().mIsEnabled == true)
+	// offline the samples are the clock, there is no hardware that could drift
+	EngineManager* engine = GetEngine();
+	if (mUseDriftCorrection == true && engine->GetDriftCorrectionSettings().mIsEnabled == true && engine->IsOfflineMode() == false)
 		CorrectForDrift();
 }
 
@@ -204,6 +206,20 @@ void Sensor::AddQueuedSample(double value)
 }
 
 
+// bulk version of AddQueuedSample(): lock the queue only once
+void Sensor::AddQueuedSamples(const double* values, uint32 numValues)
+{
+	if (numValues == 0)
+		return;
+
+	mQueuedSamplesLock.Lock();
+	const uint32 offset = mQueuedSamples.Size();
+	mQueuedSamples.Resize(offset + numValues);
+	MemCopy(mQueuedSamples.GetPtr() + offset, values, numValues * sizeof(double));
+	mQueuedSamplesLock.Unlock();
+}
+
+
 void Sensor::ClearQueuedSamples()
 { 
 	mQueuedSamplesLock.Lock();
@@ -64,6 +64,7 @@ class ENGINE_API Sensor
 
 		// input sample queue
 		void AddQueuedSample(double value);
+		void AddQueuedSamples(const double* values, uint32 numValues);
 		uint32 GetNumQueuedSamples() const										{ return mQueuedSamples.Size(); }
 
 		// the output channel
@@ -34,6 +34,7 @@
 #include "CloudParameters.h"
 #include "SessionExporter.h"
 #include "Graph/GraphImporter.h"
+#include "Graph/GraphCache.h"
 #include "Graph/StateTransitionButtonCondition.h"
 #include "Graph/StateTransitionAudioCondition.h"
 #include "Graph/StateTransitionVideoCondition.h"
@@ -59,8 +60,6 @@ using namespace Core;
 
 namespace neuromoreEngine
 {
-    
-Callback*				gCallback		= NULL;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // neuromore Engine Data Storage
@@ -68,6 +67,8 @@ Callback*				gCallback		= NULL;
 
 // forward declaration
 class EngineThreadHandler;
+class NMEngineEventHandler;
+class neuromoreEngineLogCallback;
 
 struct FeedbackData
 {
@@ -140,9 +141,15 @@ class NMEngineData
 {
 	public:
 		// constructor & destructor
-		NMEngineData()						{} 
+		NMEngineData()						{ mEngine = NULL; mCallback = NULL; mEventHandler = NULL; mLogCallback = NULL; mThread = NULL; mThreadHandler = NULL; }
 		~NMEngineData()						{}
 
+		// the engine this instance drives and the host callback its events are routed to
+		EngineManager*					mEngine;
+		Callback*						mCallback;
+		NMEngineEventHandler*			mEventHandler;
+		neuromoreEngineLogCallback*		mLogCallback;
+
 		Array<StateMachine::Asset> mStateMachineAssets;
 
 		MemoryFile		mTempMemoryFile;
@@ -174,62 +181,66 @@ class NMEngineData
 class NMEngineEventHandler : public Core::EventHandler
 {
 	public:
-		NMEngineEventHandler() : EventHandler()																				{}
+		NMEngineEventHandler(NMEngineData* instance) : EventHandler()														{ mInstance = instance; }
 		virtual ~NMEngineEventHandler()																						{}
 
-		void OnPlayAudio(const char* url, int32 numLoops, double beginAt, double volume, bool allowStream) override final			{ if (gCallback != NULL) gCallback->OnPlayAudio(url, numLoops, beginAt, volume); }
-		void OnStopAudio(const char* url) override final																			{ if (gCallback != NULL) gCallback->OnStopAudio(url); }
-		void OnPauseAudio(const char* url, bool unPause) override final																{ if (gCallback != NULL) gCallback->OnPauseAudio(url, unPause); }
-		void OnSetAudioVolume(const char* url, double volume) override final														{ if (gCallback != NULL) gCallback->OnSetAudioVolume(url, volume); }
-		void OnSeekAudio(const char* url, uint32 millisecs) override final															{ if (gCallback != NULL) gCallback->OnSeekAudio(url, millisecs); }
+		void OnPlayAudio(const char* url, int32 numLoops, double beginAt, double volume, bool allowStream) override final			{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnPlayAudio(url, numLoops, beginAt, volume); }
+		void OnStopAudio(const char* url) override final																			{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnStopAudio(url); }
+		void OnPauseAudio(const char* url, bool unPause) override final																{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnPauseAudio(url, unPause); }
+		void OnSetAudioVolume(const char* url, double volume) override final														{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnSetAudioVolume(url, volume); }
+		void OnSeekAudio(const char* url, uint32 millisecs) override final															{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnSeekAudio(url, millisecs); }
+
+		void OnPlayVideo(const char* url, int32 numLoops, double beginAt, double volume, bool allowStream) override final			{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnPlayVideo(url, numLoops, beginAt, volume); }
+		void OnStopVideo() override final																							{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnStopVideo(); }
+		void OnPauseVideo(const char* url, bool unPause) override final																{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnPauseVideo(url, unPause); }
+		void OnSetVideoVolume(const char* url, double volume) override final														{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnSetVideoVolume(url, volume); }
+		void OnSeekVideo(const char* url, uint32 millisecs) override final															{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnSeekVideo(url, millisecs); }
 
-		void OnPlayVideo(const char* url, int32 numLoops, double beginAt, double volume, bool allowStream) override final			{ if (gCallback != NULL) gCallback->OnPlayVideo(url, numLoops, beginAt, volume); }
-		void OnStopVideo() override final																							{ if (gCallback != NULL) gCallback->OnStopVideo(); }
-		void OnPauseVideo(const char* url, bool unPause) override final																{ if (gCallback != NULL) gCallback->OnPauseVideo(url, unPause); }
-		void OnSetVideoVolume(const char* url, double volume) override final														{ if (gCallback != NULL) gCallback->OnSetVideoVolume(url, volume); }
-		void OnSeekVideo(const char* url, uint32 millisecs) override final															{ if (gCallback != NULL) gCallback->OnSeekVideo(url, millisecs); }
+		void OnShowImage(const char* url) override final																			{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnShowImage(url); }
+		void OnHideImage() override final																							{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnHideImage(); }
 
-		void OnShowImage(const char* url) override final																			{ if (gCallback != NULL) gCallback->OnShowImage(url); }
-		void OnHideImage() override final																							{ if (gCallback != NULL) gCallback->OnHideImage(); }
+		void OnShowText(const char* text, const Core::Color& color) override final													{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnShowText(text, color.r, color.g, color.b, color.a); }
+		void OnHideText() override final																							{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnHideText(); }
 
-		void OnShowText(const char* text, const Core::Color& color) override final													{ if (gCallback != NULL) gCallback->OnShowText(text, color.r, color.g, color.b, color.a); }
-		void OnHideText() override final																							{ if (gCallback != NULL) gCallback->OnHideText(); }
+		void OnSetFourZoneAVEColors(const float* red, const float* green, const float* blue, const float* alpha) override final		{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnSetFourZoneAVEColors(red, green, blue, alpha); }
+		void OnHideFourZoneAVE() override final																						{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnHideFourZoneAVE(); }
 
-		void OnSetFourZoneAVEColors(const float* red, const float* green, const float* blue, const float* alpha) override final		{ if (gCallback != NULL) gCallback->OnSetFourZoneAVEColors(red, green, blue, alpha); }
-		void OnHideFourZoneAVE() override final																						{ if (gCallback != NULL) gCallback->OnHideFourZoneAVE(); }
+		void OnShowButton(const char* text, uint32 buttonId) override final															{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnShowButton(text, buttonId); }
+		void OnClearButtons() override final																						{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnClearButtons(); }
 
-		void OnShowButton(const char* text, uint32 buttonId) override final															{ if (gCallback != NULL) gCallback->OnShowButton(text, buttonId); }
-		void OnClearButtons() override final																						{ if (gCallback != NULL) gCallback->OnClearButtons(); }
+		void OnCommand(const char* command) override final																			{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnCommand(command); }
+		void OnExitStateReached(uint32 exitStatus) override final																	{ if (mInstance->mCallback != NULL) mInstance->mCallback->OnStop((Callback::EStatus)exitStatus);  }
 
-		void OnCommand(const char* command) override final																			{ if (gCallback != NULL) gCallback->OnCommand(command); }
-		void OnExitStateReached(uint32 exitStatus) override final																	{ if (gCallback != NULL) gCallback->OnStop((Callback::EStatus)exitStatus);  }
+	private:
+		NMEngineData*	mInstance;
 };
 
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Globals
+// Instance Binding
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-NMEngineData*			gNMEngineData	= NULL;
-NMEngineEventHandler*	gEventHandler	= NULL;
+
+// resolve the handle and bind its engine to the calling thread for the rest of the function
+#define BIND_INSTANCE(handle, failResult) \
+	NMEngineData* instance = reinterpret_cast<NMEngineData*>(handle); \
+	if (instance == NULL) return failResult; \
+	EngineScope engineScope(instance->mEngine)
 
 
 // get the time delta since the last call (returns 0.0 in case session is not running)
 // TODO: REMOVE THIS ONCE WE SWITCHED OVER TO THE THREADED WAY!!!
-Time GetTimeDelta()
+Time GetTimeDelta(NMEngineData* instance)
 {
-	if (gNMEngineData == NULL)
-		return 0.0;
-
-	const Time timeDelta = gNMEngineData->mUpdateTimer.GetTimeDelta();
+	const Time timeDelta = instance->mUpdateTimer.GetTimeDelta();
 
-	if (IsRunning() == false)
+	if (GetSession()->IsRunning() == false)
 		return 0.0;
 
 	return timeDelta;
 }
 
 
-void UpdateFeedbackData()
+void UpdateFeedbackData(NMEngineData* instance)
 {
 	EngineManager* engine = GetEngine();
 	if (engine == NULL)
@@ -241,7 +252,7 @@ void UpdateFeedbackData()
 	{
 		// resize the feedback data
 		const uint32 numFeedbacks = classifier->GetNumCustomFeedbackNodes();
-		gNMEngineData->mFeedbackData.Resize( numFeedbacks );
+		instance->mFeedbackData.Resize( numFeedbacks );
 
 		// update feedback data
 		for (uint32 i=0; i<numFeedbacks; ++i)
@@ -251,14 +262,14 @@ void UpdateFeedbackData()
 			// output values
 			const double minValue = node->GetFloatAttribute(CustomFeedbackNode::ATTRIB_RANGEMIN);
 			const double maxValue = node->GetFloatAttribute(CustomFeedbackNode::ATTRIB_RANGEMAX);
-			gNMEngineData->mFeedbackData.SetFeedbackData(i, node->GetName(), node->GetCurrentValue(), minValue, maxValue );
+			instance->mFeedbackData.SetFeedbackData(i, node->GetName(), node->GetCurrentValue(), minValue, maxValue );
 		}
 	}
 }
 
 
 // update the engine
-bool Update(const Time& timeDelta)
+bool Update(NMEngineData* instance, const Time& timeDelta)
 {
 	EngineManager* engine = GetEngine();
 	if (engine == NULL)
@@ -268,15 +279,17 @@ bool Update(const Time& timeDelta)
 	engine->Update( timeDelta );
 
 	// update feedback data
-	UpdateFeedbackData();
+	UpdateFeedbackData(instance);
 
 	return true;
 }
 
 
-bool Update()
+bool Update(EngineHandle handle)
 {
-	return Update( GetTimeDelta() );
+	BIND_INSTANCE(handle, false);
+
+	return Update( instance, GetTimeDelta(instance) );
 }
 
 
@@ -289,8 +302,8 @@ class EngineThreadHandler : public Core::ThreadHandler
 {
 	public:
 		// constructor & destructor
-		EngineThreadHandler() : ThreadHandler()			{ mBreak = false;}
-		virtual ~EngineThreadHandler()					{}
+		EngineThreadHandler(NMEngineData* instance) : ThreadHandler()			{ mInstance = instance; mBreak = false;}
+		virtual ~EngineThreadHandler()											{}
 
 		// start thread execution
 		void Execute() override
@@ -298,6 +311,9 @@ class EngineThreadHandler : public Core::ThreadHandler
 			mIsFinished = false;
 			mBreak = false;
 
+			// the update thread drives this instance's engine only
+			EngineScope engineScope(mInstance->mEngine);
+
 			// get access to the engine
 			EngineManager* engine = GetEngine();
 			if (engine == NULL)
@@ -333,14 +349,14 @@ class EngineThreadHandler : public Core::ThreadHandler
 				mUpdateTimer.GetTimeDelta();
 
 				// update engine
-				Update( timeDelta );
+				Update( mInstance, timeDelta );
 
 				const double updateTime = mUpdateTimer.GetTimeDelta().InSeconds();
 				mFpsCounter.StopTiming();
 
 				// update the fps statistics of the engine data (thread safe operation)
 				PerformanceStatistics perfStats( mFpsCounter.GetFps(), mFpsCounter.GetTheoreticalFps(), mFpsCounter.GetAveragedTimeDelta(), mFpsCounter.GetBestCaseTiming(), mFpsCounter.GetWorstCaseTiming() );
-				gNMEngineData->SetPerformanceStatistics( perfStats );
+				mInstance->SetPerformanceStatistics( perfStats );
 
 				// update rate control
 				const double sleepTime = desiredFpsDeltaTime - updateTime;
@@ -358,6 +374,7 @@ class EngineThreadHandler : public Core::ThreadHandler
 		}
 
 	private:
+		NMEngineData*			mInstance;
 		FpsCounter				mFpsCounter;
 		Timer					mRealTimer;			// times the differences between full real-time loop iterations (real time!)
 		Timer					mUpdateTimer;		// times how long the engine->Update() call takes
@@ -374,14 +391,15 @@ class neuromoreEngineLogCallback : public LogCallback
 {
 	public:
 		enum { TYPE_ID = 0x5b407 };
-		neuromoreEngineLogCallback() : LogCallback()				{}
+		neuromoreEngineLogCallback(NMEngineData* instance) : LogCallback()	{ mInstance = instance; }
 		virtual ~neuromoreEngineLogCallback()						{}
 		uint32 GetType() const override                             { return TYPE_ID; }
 
 		void Log(const char* text, Core::ELogLevel logLevel) override final
 		{
             // make sure the callback is present
-            if (gCallback == NULL)
+            Callback* callback = mInstance->mCallback;
+            if (callback == NULL)
                 return;
             
             // make sure the logged text is valid and meaningful
@@ -391,30 +409,59 @@ class neuromoreEngineLogCallback : public LogCallback
 			// add the log level parameter
 			switch (logLevel)
 			{
-				case LOGLEVEL_CRITICAL:			{ String errorMessage;  errorMessage.Format( "[CRITICAL]: %s", text );   gCallback->OnLog( errorMessage.AsChar() ); break; }
-				case LOGLEVEL_ERROR:			{ String errorMessage;  errorMessage.Format( "[ERROR]: %s", text );      gCallback->OnLog( errorMessage.AsChar() ); break; }
-				case LOGLEVEL_WARNING:			{ String errorMessage;  errorMessage.Format( "[WARNING]: %s", text );    gCallback->OnLog( errorMessage.AsChar() ); break; }
-				default:						{ gCallback->OnLog( text );break; }
+				case LOGLEVEL_CRITICAL:			{ String errorMessage;  errorMessage.Format( "[CRITICAL]: %s", text );   callback->OnLog( errorMessage.AsChar() ); break; }
+				case LOGLEVEL_ERROR:			{ String errorMessage;  errorMessage.Format( "[ERROR]: %s", text );      callback->OnLog( errorMessage.AsChar() ); break; }
+				case LOGLEVEL_WARNING:			{ String errorMessage;  errorMessage.Format( "[WARNING]: %s", text );    callback->OnLog( errorMessage.AsChar() ); break; }
+				default:						{ callback->OnLog( text );break; }
 			}
 		}
+
+	private:
+		NMEngineData*	mInstance;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Initialization, cleanup and update
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-// initialization
-bool Init()
+// serializes Init() and Shutdown() of the instances (hosts may create and destroy them from different threads)
+static Mutex gInstanceLock;
+// number of live instances; the default engine stays alive until the last one is shut down as the others fall back to it on unbound threads
+static uint32 gNumInstances = 0;
+// the default engine was created by Init() (and not by the host), so it has to be shut down with the last instance
+static bool gOwnsDefaultEngine = false;
+
+
+EngineHandle InitInstance()
 {
-	// initialize core helper system
-	if (EngineInitializer::Init() == false)
+	// the first instance initializes the core helper system and becomes the default engine, every further one gets its own engine
+	EngineManager* engine = NULL;
+	if (gEngineManager == NULL)
 	{
-		LogCritical("Failed to initialize the neuromore Engine.");
-		return false;
+		if (EngineInitializer::Init() == false)
+		{
+			LogCritical("Failed to initialize the neuromore Engine.");
+			EngineInitializer::Shutdown();
+			return NULL;
+		}
+
+		gOwnsDefaultEngine = true;
+		engine = gEngineManager;
+	}
+	else
+	{
+		engine = EngineInitializer::CreateInstance();
+		if (engine == NULL)
+		{
+			LogCritical("Failed to initialize the neuromore Engine instance.");
+			return NULL;
+		}
 	}
 
 	// construct data object
-	gNMEngineData = new NMEngineData();
+	NMEngineData* instance = new NMEngineData();
+	instance->mEngine = engine;
+	EngineScope engineScope(engine);
 
 	// start engine by default
 	GetEngine()->SetIsRunning(true);
@@ -423,8 +470,8 @@ bool Init()
 	GetEngine()->SetAutoSyncSetting(false);
 
 	// create and register our log callback
-	neuromoreEngineLogCallback* logCallback = new neuromoreEngineLogCallback();
-	CORE_LOGMANAGER.AddLogCallback( logCallback );
+	instance->mLogCallback = new neuromoreEngineLogCallback(instance);
+	CORE_LOGMANAGER.AddLogCallback( instance->mLogCallback );
 
 	// register all core devices and their nodes (force disabling of CRUD check, we don't have that here)
 	DeviceInventory::RegisterDevices(true);
@@ -433,23 +480,39 @@ bool Init()
 	GetDeviceManager()->SetRemoveInactiveDevicesEnabled(false);
 
 	// create the event handler
-	gEventHandler = new NMEngineEventHandler();
-	CORE_EVENTMANAGER.AddEventHandler( gEventHandler );
+	instance->mEventHandler = new NMEngineEventHandler(instance);
+	CORE_EVENTMANAGER.AddEventHandler( instance->mEventHandler );
 
-	return true;
+	gNumInstances++;
+	return reinterpret_cast<EngineHandle>(instance);
+}
+
+
+// initialization
+EngineHandle Init()
+{
+	gInstanceLock.Lock();
+	EngineHandle handle = InitInstance();
+	gInstanceLock.Unlock();
+
+	return handle;
 }
 
 
 // is initialized?
-bool IsInitialized()
+bool IsInitialized(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, false);
+
 	EngineManager* engine = GetEngine();
 	return (engine != NULL);
 }
 
 
-void SetSessionLength(double seconds)
+void SetSessionLength(EngineHandle handle, double seconds)
 {
+	BIND_INSTANCE(handle, );
+
 	// zero or negativ means infinite session length
 	if (seconds <= 0)
 		seconds = DBL_MAX;
@@ -459,13 +522,15 @@ void SetSessionLength(double seconds)
 
 
 // set classifier buffer size
-bool SetBufferLength(double seconds)
+bool SetBufferLength(EngineHandle handle, double seconds)
 {
-	if (IsRunning() == true)
+	BIND_INSTANCE(handle, false);
+
+	if (IsRunning(handle) == true)
 		return false;
 	
 	Classifier* classifier = GetEngine()->GetActiveClassifier();
-	if (classifier != NULL)
+	if (classifier == NULL)
 		return false;
 
 	// resize classifier buffers
@@ -476,9 +541,11 @@ bool SetBufferLength(double seconds)
 
 
 // set the power line frequency type
-bool SetPowerLineFrequencyType(EPowerLineFrequencyType powerLineFrequencyType)
+bool SetPowerLineFrequencyType(EngineHandle handle, EPowerLineFrequencyType powerLineFrequencyType)
 {
-	if (IsRunning() == true)
+	BIND_INSTANCE(handle, false);
+
+	if (IsRunning(handle) == true)
 		return false;
 
 	GetEngine()->SetPowerLineFrequencyType( (EngineManager::EPowerLineFrequencyType)powerLineFrequencyType );
@@ -486,8 +553,10 @@ bool SetPowerLineFrequencyType(EPowerLineFrequencyType powerLineFrequencyType)
 }
 
 
-double GetPowerLineFrequency()
+double GetPowerLineFrequency(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, 0.0);
+
 	if (GetEngine() == NULL)
 		return 0.0;
 
@@ -496,14 +565,16 @@ double GetPowerLineFrequency()
 
 
 // Check if the engine is ready to start
-bool IsReady()
+bool IsReady(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, false);
+
 	// an running engine is not ready to start
-	if (IsRunning() == true)
+	if (IsRunning(handle) == true)
 		return false;
 
 	// no classifier loaded
-	if (HasClassifier() == false)
+	if (HasClassifier(handle) == false)
 		return false;
 
 	//Classifier* classifier = GetEngine()->GetActiveClassifier();
@@ -527,10 +598,12 @@ bool IsReady()
 
 
 // Begin processing data.
-bool Start()
+bool Start(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, false);
+
 	// do nothing if not ready
-	if (IsReady() == false)
+	if (IsReady(handle) == false)
 	{
 		LogError("neuromoreEngine::Start(): Cannot start as engine is not ready.");
 		return false;
@@ -539,14 +612,14 @@ bool Start()
 	// Note: don't reset classifier here, as it would reset the parameters
 
 	// reset start state machine
-	if (HasStateMachine() == true)
+	if (HasStateMachine(handle) == true)
 	{
 		GetEngine()->GetActiveStateMachine()->Start();
 		GetEngine()->GetActiveStateMachine()->Reset();
 	}
 
 	// reset the timer
-	GetTimeDelta();
+	GetTimeDelta(instance);
 
 	// start session
 	GetSession()->Start();
@@ -557,9 +630,11 @@ bool Start()
 
 
 // Stop the engine if it is currently running.
-bool Stop()
+bool Stop(EngineHandle handle)
 {
-	if (IsRunning() == false)
+	BIND_INSTANCE(handle, false);
+
+	if (IsRunning(handle) == false)
 	{
 		LogWarning("neuromoreEngine::Stop(): Can't stop engine. Engine was not running.");
 		return false;
@@ -569,7 +644,7 @@ bool Stop()
 	GetSession()->Stop();
 
 	// pause the start state machine
-	if (HasStateMachine() == true)
+	if (HasStateMachine(handle) == true)
 	{
 		// FIXME this will be obsolete
 		// NOTE: this is needed so that Reset() calls don't fire actions from the entry states
@@ -577,7 +652,7 @@ bool Stop()
 	}
 
 	// reset the timer
-	GetTimeDelta();
+	GetTimeDelta(instance);
 
 	LogInfo("neuromoreEngine::Stop(): Stopping engine.");
 	return true;
@@ -585,27 +660,31 @@ bool Stop()
 
 
 // Begin processing data.
-bool StartThreaded()
+bool StartThreaded(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, false);
+
 	// start engine, skip post processing if starting engine fails already
-	if (Start() == false)
+	if (Start(handle) == false)
 		return false;
 
 	// init thread
-	gNMEngineData->mThreadHandler = new EngineThreadHandler();
-	gNMEngineData->mThread = new Thread(gNMEngineData->mThreadHandler, "neuromore Engine Thread");
+	instance->mThreadHandler = new EngineThreadHandler(instance);
+	instance->mThread = new Thread(instance->mThreadHandler, "neuromore Engine Thread");
 
 	// start thread if not already running
-	gNMEngineData->mThread->Start();
+	instance->mThread->Start();
 
 	return true;
 }
 
 
 // Stop the engine if it is currently running.
-bool StopThreaded()
+bool StopThreaded(EngineHandle handle)
 {
-	if (IsRunning() == false)
+	BIND_INSTANCE(handle, false);
+
+	if (IsRunning(handle) == false)
 	{
 		LogWarning("neuromoreEngine::Stop(): Can't stop engine. Engine was not running.");
 		return false;
@@ -613,21 +692,26 @@ bool StopThreaded()
 
 	Timer stopThreadTimer;
 
-	if (gNMEngineData->mThread != NULL)
-		gNMEngineData->mThread->Stop();
+	if (instance->mThread != NULL)
+		instance->mThread->Stop();
 
-	delete gNMEngineData->mThread;
+	// the thread owns and destroys its handler
+	delete instance->mThread;
+	instance->mThread			= NULL;
+	instance->mThreadHandler	= NULL;
 
 	const double stopThreadTiming = stopThreadTimer.GetTime().InMilliseconds();
 	LogInfo( "Stopping engine thread took: %.1f ms.", stopThreadTiming );
 
-	Stop();
+	Stop(handle);
 	return true;
 }
 
 
-void Reset()
+void Reset(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, );
+
 	LogInfo("neuromoreEngine::Reset(): Resetting engine.");
 	GetEngine()->Reset();
 	GetEngine()->Update(0.0);
@@ -635,60 +719,96 @@ void Reset()
 
 
 // Check if the engine is currently running.
-bool IsRunning()
+bool IsRunning(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, false);
+
 	return GetSession()->IsRunning();
 }
 
 
 // cleanup
-void Shutdown()
+void ShutdownInstance(EngineHandle handle)
 {
-	// destroy engine data
-	LogInfo("Destroying neuromore Engine data ...");
-	delete gNMEngineData;
-	LogDetailedInfo("neuromore Engine data destroyed");
+	BIND_INSTANCE(handle, );
+
+	// make sure the update thread does not outlive the engine
+	if (instance->mThread != NULL)
+	{
+		instance->mThread->Stop();
+		delete instance->mThread;
+		instance->mThread = NULL;
+		instance->mThreadHandler = NULL;
+	}
 
 	// destroy the event handler
 	LogInfo("Removing event handler ...");
-	CORE_EVENTMANAGER.RemoveEventHandler( gEventHandler );
+	CORE_EVENTMANAGER.RemoveEventHandler( instance->mEventHandler );
 	LogDetailedInfo("Event handler removed");
 	LogInfo("Destructing event handler ...");
-	delete gEventHandler;
-	gEventHandler = NULL;
+	delete instance->mEventHandler;
+	instance->mEventHandler = NULL;
 	LogDetailedInfo("Event handler destructed");
 
+	// unregister our log callback, it points back to the instance data
+	CORE_LOGMANAGER.RemoveLogCallback( instance->mLogCallback, true );
+	instance->mLogCallback = NULL;
+
 	// destroy the callback
 	LogInfo("Destructing callback ...");
-	delete gCallback;
-	gCallback = NULL;
+	delete instance->mCallback;
+	instance->mCallback = NULL;
 	LogDetailedInfo("Callback destructed");
 
-	// shutdown the example
+	// shutdown the engine; the default one stays alive until the last instance is gone, then it takes the core helper system down
 	Core::LogInfo( "Shutting down neuromore Engine ..." );
-	EngineInitializer::Shutdown();
+	EngineManager* engine = instance->mEngine;
+	if (engine == gEngineManager)
+		engine->SetIsRunning(false);
+	else
+		EngineInitializer::DestroyInstance(engine);
+
+	// destroy engine data
+	delete instance;
+
+	gNumInstances--;
+	if (gNumInstances == 0 && gOwnsDefaultEngine == true)
+	{
+		EngineInitializer::Shutdown();
+		gOwnsDefaultEngine = false;
+	}
+}
+
+
+void Shutdown(EngineHandle handle)
+{
+	if (handle == NULL)
+		return;
+
+	gInstanceLock.Lock();
+	ShutdownInstance(handle);
+	gInstanceLock.Unlock();
 }
 
 
 // gather performance statistics from engine thread
-bool GetPerformanceStatistics(double* outFps, double* outTheoreticalFps, double* outAveragedTiming, double* outBestCaseTiming, double* outWorstCaseTiming)
+bool GetPerformanceStatistics(EngineHandle handle, double* outFps, double* outTheoreticalFps, double* outAveragedTiming, double* outBestCaseTiming, double* outWorstCaseTiming)
 {
+	BIND_INSTANCE(handle, false);
+
 	*outFps				= 0.0;
 	*outTheoreticalFps	= 0.0;
 	*outAveragedTiming	= 0.0;
 	*outBestCaseTiming	= 0.0;
 	*outWorstCaseTiming	= 0.0;
 
-	if (IsRunning() == false)
+	if (IsRunning(handle) == false)
 	{
 		LogWarning("Can't get performance statistics. Engine is not running.");
 		return false;
 	}
 
-	if (gNMEngineData == NULL)
-		return false;
-
-	PerformanceStatistics perfStats = gNMEngineData->GetPerformanceStatistics();
+	PerformanceStatistics perfStats = instance->GetPerformanceStatistics();
 
 	*outFps				= perfStats.mFps;
 	*outTheoreticalFps	= perfStats.mTheoreticalFps;
@@ -700,20 +820,83 @@ bool GetPerformanceStatistics(double* outFps, double* outTheoreticalFps, double*
 }
 
 
+// enable/disable node profiling
+void SetProfilingEnabled(EngineHandle handle, bool enabled)
+{
+	BIND_INSTANCE(handle, );
+
+	EngineManager* engine = GetEngine();
+	if (engine != NULL)
+		engine->GetNodeProfiler()->SetEnabled(enabled);
+}
+
+
+bool IsProfilingEnabled(EngineHandle handle)
+{
+	BIND_INSTANCE(handle, false);
+
+	EngineManager* engine = GetEngine();
+	if (engine == NULL)
+		return false;
+
+	return engine->GetNodeProfiler()->IsEnabled();
+}
+
+
+// export the recorded node profiling frames
+bool ExportProfilingTrace(EngineHandle handle, const char* filename)
+{
+	BIND_INSTANCE(handle, false);
+
+	EngineManager* engine = GetEngine();
+	if (engine == NULL || filename == NULL)
+		return false;
+
+	return engine->GetNodeProfiler()->ExportTrace(filename);
+}
+
+
+// heap accounting of one engine subsystem
+bool GetMemoryStatistics(EMemoryTag tag, double* outLiveBytes, double* outNumLiveAllocations, double* outNumAllocations, double* outNumRealtimeAllocations)
+{
+	if (tag < 0 || tag >= NUM_MEMORY_TAGS)
+		return false;
+
+	const Core::MemoryStatistics stats = Core::GetMemoryStatistics((Core::EMemoryTag)tag);
+
+	*outLiveBytes				= (double)stats.mNumLiveBytes;
+	*outNumLiveAllocations		= (double)stats.mNumLiveAllocations;
+	*outNumAllocations			= (double)stats.mNumAllocations;
+	*outNumRealtimeAllocations	= (double)stats.mNumRealtimeAllocations;
+
+	return true;
+}
+
+
+void SetRealtimeAllocationAssert(bool enabled)
+{
+	Core::SetRealtimeAllocationAssert(enabled);
+}
+
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helpers
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void EnableDebugLogging()
+void EnableDebugLogging(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, );
+
 	EngineManager* engine = GetEngine();
 	if (engine != NULL)
 		CORE_LOGMANAGER.SetActiveLogLevelPreset( "Debug" );
 }
 
 
-void SetAllowAssetStreaming(bool allow)
+void SetAllowAssetStreaming(EngineHandle handle, bool allow)
 {
+	BIND_INSTANCE(handle, );
+
 	EngineManager* engine = GetEngine();
 	if (engine != NULL)
 		engine->SetAllowAssetStreaming(allow);
@@ -725,8 +908,10 @@ void SetAllowAssetStreaming(bool allow)
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // check if there is a device with the given type
-bool HasDevice(EDevice type)
+bool HasDevice(EngineHandle handle, EDevice type)
 {
+	BIND_INSTANCE(handle, false);
+
 	uint32 internalType = CORE_INVALIDINDEX32;
 
 	switch (type)
@@ -768,10 +953,12 @@ bool HasDevice(EDevice type)
 
 
 // add a device of a certain type
-int AddDevice(EDevice type)
+int AddDevice(EngineHandle handle, EDevice type)
 {
+	BIND_INSTANCE(handle, -1);
+
 	// not available while running
-	if (IsRunning() == true)
+	if (IsRunning(handle) == true)
 	{
 		LogError("neuromoreEngine::AddDevice(): Cannot add new device. Engine is running.");
 		return -1;
@@ -832,17 +1019,21 @@ int AddDevice(EDevice type)
 
 
 // Get the number of active devices.
-int GetNumDevices()
+int GetNumDevices(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, -1);
+
 	return GetDeviceManager()->GetNumDevices();
 }
 
 
 // remove a device 
-bool RemoveDevice(int deviceIndex)
+bool RemoveDevice(EngineHandle handle, int deviceIndex)
 {
+	BIND_INSTANCE(handle, false);
+
 	// not available while running
-	if (IsRunning() == true)
+	if (IsRunning(handle) == true)
 	{
 		LogError( "neuromoreEngine::RemoveDevice(): Cannot remove device at position %i. Engine is running.", deviceIndex );
 		return false;
@@ -864,8 +1055,10 @@ bool RemoveDevice(int deviceIndex)
 }
 
 
-EDevice GetDevice(int deviceIndex)
+EDevice GetDevice(EngineHandle handle, int deviceIndex)
 {
+	BIND_INSTANCE(handle, (EDevice)-1);
+
 	if (deviceIndex < 0 || deviceIndex >= (int)GetDeviceManager()->GetNumDevices())
 		return (EDevice)-1;
 
@@ -907,8 +1100,10 @@ EDevice GetDevice(int deviceIndex)
 }
 
 
-bool ConnectDevice(int deviceIndex)
+bool ConnectDevice(EngineHandle handle, int deviceIndex)
 {
+	BIND_INSTANCE(handle, false);
+
     // invalid device index
     if (deviceIndex < 0 || deviceIndex >= (int)GetDeviceManager()->GetNumDevices())
         return false;
@@ -918,8 +1113,10 @@ bool ConnectDevice(int deviceIndex)
 }
 
 
-bool DisonnectDevice(int deviceIndex)
+bool DisonnectDevice(EngineHandle handle, int deviceIndex)
 {
+	BIND_INSTANCE(handle, false);
+
     // invalid device index
     if (deviceIndex < 0 || deviceIndex >= (int)GetDeviceManager()->GetNumDevices())
         return false;
@@ -930,8 +1127,10 @@ bool DisonnectDevice(int deviceIndex)
 
 
 // Get the number of inputs of a device.
-int GetNumInputs(int deviceIndex)
+int GetNumInputs(EngineHandle handle, int deviceIndex)
 {
+	BIND_INSTANCE(handle, -1);
+
 	// invalid device index
 	if (deviceIndex < 0 || deviceIndex >= (int)GetDeviceManager()->GetNumDevices())
 		return -1;
@@ -943,10 +1142,12 @@ int GetNumInputs(int deviceIndex)
 
 
 // Push a value into a device input.
-bool AddInputSample(int deviceIndex, int inputIndex, double sampleValue)
+bool AddInputSample(EngineHandle handle, int deviceIndex, int inputIndex, double sampleValue)
 {
+	BIND_INSTANCE(handle, false);
+
 	// return directly in case the engine is not running
-	if (IsRunning() == false)
+	if (IsRunning(handle) == false)
 		return false;
 
 	// invalid device index
@@ -967,8 +1168,10 @@ bool AddInputSample(int deviceIndex, int inputIndex, double sampleValue)
 
 
 // Set the battery charge level of a device.
-bool SetBatteryChargeLevel(int deviceIndex, double normalizedCharge)
+bool SetBatteryChargeLevel(EngineHandle handle, int deviceIndex, double normalizedCharge)
 {
+	BIND_INSTANCE(handle, false);
+
 	// invalid device index
 	if (deviceIndex < 0 || deviceIndex >= (int)GetDeviceManager()->GetNumDevices())
 		return false;
@@ -986,17 +1189,36 @@ bool SetBatteryChargeLevel(int deviceIndex, double normalizedCharge)
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // load the given classifier from json
-bool LoadClassifier(const char* jsonContent, const char* uuid, int revision)
+bool LoadClassifier(EngineHandle handle, const char* jsonContent, const char* uuid, int revision)
 {
+	BIND_INSTANCE(handle, false);
+
 	// make sure the engine got initialized and is not running
 	if (GetEngine() == NULL)
 		return false;
-	if (IsRunning() == true)
+	if (IsRunning(handle) == true)
 		return false;
 
-	// try to load new classifier
+	// try the binary cache first (only if we have a folder to keep it in)
+	const bool useCache = (GetEngine()->GetAppDataFolder().IsEmpty() == false);
+	const uint32 sourceHash = GraphCache::CalcSourceHash(jsonContent);
+	const String cacheFilename = GraphCache::GetFilename( GetEngine()->GetAppDataFolder().AsChar(), uuid );
+
 	Classifier* classifier = new Classifier();
-	if (GraphImporter::LoadFromString(jsonContent, classifier) == false)
+	bool loadedFromCache = false;
+	if (useCache == true)
+	{
+		loadedFromCache = GraphCache::Load( cacheFilename.AsChar(), classifier, uuid, revision, sourceHash );
+		if (loadedFromCache == false)
+		{
+			// cache missing or outdated: start over with an empty classifier
+			delete classifier;
+			classifier = new Classifier();
+		}
+	}
+
+	// fall back to the JSON importer
+	if (loadedFromCache == false && GraphImporter::LoadFromString(jsonContent, classifier) == false)
 	{
 		delete classifier;
 		classifier = NULL;
@@ -1007,17 +1229,23 @@ bool LoadClassifier(const char* jsonContent, const char* uuid, int revision)
 	classifier->SetRevision( revision );
 	classifier->CollectNodes();
 
+	// remember the loaded classifier for the next time
+	if (useCache == true && loadedFromCache == false)
+		GraphCache::Save( cacheFilename.AsChar(), classifier, sourceHash );
+
 	GetEngine()->LoadGraph(classifier);
 
-	Reset();
-	UpdateFeedbackData();
+	Reset(handle);
+	UpdateFeedbackData(instance);
 
 	return true;
 }
 
 
-bool HasClassifier()
+bool HasClassifier(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, false);
+
 	// make sure the engine got initialized
 	if (GetEngine() == NULL)
 		return false;
@@ -1028,9 +1256,11 @@ bool HasClassifier()
 
 
 // check if the given device type is required by the classifier
-bool IsDeviceRequiredByClassifier(EDevice deviceType)
+bool IsDeviceRequiredByClassifier(EngineHandle handle, EDevice deviceType)
 {
-	if (HasClassifier() == false)
+	BIND_INSTANCE(handle, false);
+
+	if (HasClassifier(handle) == false)
 		return false;
 
 	Classifier* classifier = GetEngine()->GetActiveClassifier();
@@ -1076,28 +1306,23 @@ bool IsDeviceRequiredByClassifier(EDevice deviceType)
 
 
 // get the number of custom feedback nodes
-int GetNumFeedbacks()
+int GetNumFeedbacks(EngineHandle handle)
 {
-	if (gNMEngineData == NULL)
-	{
-		LogError("GetNumFeedbacks(): No engine data present.");
-		return -1;
-	}
+	BIND_INSTANCE(handle, -1);
 
-	return gNMEngineData->mFeedbackData.GetNumFeedbacks();
+	return instance->mFeedbackData.GetNumFeedbacks();
 }
 
 
 // get the node name of a custom feedback node
-const char* GetFeedbackName(int index)
+const char* GetFeedbackName(EngineHandle handle, int index)
 {
-	if (gNMEngineData == NULL)
-		return "";
+	BIND_INSTANCE(handle, "");
 
-	if (index >= (int)gNMEngineData->mFeedbackData.GetNumFeedbacks())
+	if (index >= (int)instance->mFeedbackData.GetNumFeedbacks())
 		return "";
 
-	const char* result = gNMEngineData->mFeedbackData.GetFeedbackName(index);
+	const char* result = instance->mFeedbackData.GetFeedbackName(index);
 	if (result == NULL)
 		return "";
 
@@ -1106,52 +1331,46 @@ const char* GetFeedbackName(int index)
 
 
 // value range of this feedback
-void GetFeedbackRange(int index, double* outMinValue, double* outMaxValue)
+void GetFeedbackRange(EngineHandle handle, int index, double* outMinValue, double* outMaxValue)
 {
+	BIND_INSTANCE(handle, );
+
 	// zero outputs first
 	*outMinValue = 0.0;
 	*outMaxValue = 0.0;
 
-	if (gNMEngineData == NULL)
-		return;
-
-	if (index >= (int)gNMEngineData->mFeedbackData.GetNumFeedbacks())
+	if (index >= (int)instance->mFeedbackData.GetNumFeedbacks())
 		return;
 
 	// output values
-	*outMinValue = gNMEngineData->mFeedbackData.GetFeedbackMinValue(index);
-	*outMaxValue = gNMEngineData->mFeedbackData.GetFeedbackMaxValue(index);
+	*outMinValue = instance->mFeedbackData.GetFeedbackMinValue(index);
+	*outMaxValue = instance->mFeedbackData.GetFeedbackMaxValue(index);
 }
 
 
 // get the current feedback values
-double GetCurrentFeedbackValue(int index)
+double GetCurrentFeedbackValue(EngineHandle handle, int index)
 {
-	if (gNMEngineData == NULL)
-		return 0.0;
+	BIND_INSTANCE(handle, 0.0);
 
-	if (index >= (int)gNMEngineData->mFeedbackData.GetNumFeedbacks())
+	if (index >= (int)instance->mFeedbackData.GetNumFeedbacks())
 		return 0.0;
 
-	return gNMEngineData->mFeedbackData.GetFeedbackValue(index);
+	return instance->mFeedbackData.GetFeedbackValue(index);
 }
 
 
 // find the feedback index by name
-int FindFeedbackIndexByName(const char* name)
+int FindFeedbackIndexByName(EngineHandle handle, const char* name)
 {
-	if (gNMEngineData == NULL)
-	{
-		LogError("GetFeedbackIndexByName(): No engine data present.");
-		return -1;
-	}
+	BIND_INSTANCE(handle, -1);
 
 	// get the number of feedback nodes and iterate through them
-	const uint32 numFeedbackNodes = gNMEngineData->mFeedbackData.GetNumFeedbacks();
+	const uint32 numFeedbackNodes = instance->mFeedbackData.GetNumFeedbacks();
 	for (uint32 i=0; i<numFeedbackNodes; ++i)
 	{
 		// compare node names and return index in case they are equal
-		const char* currentName = gNMEngineData->mFeedbackData.GetFeedbackName(i);
+		const char* currentName = instance->mFeedbackData.GetFeedbackName(i);
 		if (strcmp(currentName, name) == 0)
 			return i;
 	}
@@ -1161,9 +1380,11 @@ int FindFeedbackIndexByName(const char* name)
 
 
 // construct json request string for retreiving cloud input parameters
-const char* CreateJSONRequestFindParameters(const char* userId)
+const char* CreateJSONRequestFindParameters(EngineHandle handle, const char* userId)
 {
-	if (HasClassifier() == false)
+	BIND_INSTANCE(handle, NULL);
+
+	if (HasClassifier(handle) == false)
 		return "";
 
 	Classifier* classifier = GetEngine()->GetActiveClassifier();
@@ -1180,16 +1401,18 @@ const char* CreateJSONRequestFindParameters(const char* userId)
 		return "";
 
 	// create json string and return it
-	jsonParser.WriteToString(gNMEngineData->mTempJsonString, false);
-	return gNMEngineData->mTempJsonString.AsChar();
+	jsonParser.WriteToString(instance->mTempJsonString, false);
+	return instance->mTempJsonString.AsChar();
 }
 
 
 // construct json request string for setting cloud output parameters
-const char* CreateJSONRequestSetParameters()
+const char* CreateJSONRequestSetParameters(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, NULL);
+
 	// no classifier: return NULL 
-	if (HasClassifier() == false)
+	if (HasClassifier(handle) == false)
 		return 0; // NOTE: why not use NULL here? 
 
 	Classifier* classifier = GetEngine()->GetActiveClassifier();
@@ -1209,14 +1432,16 @@ const char* CreateJSONRequestSetParameters()
 	parameters.CreateSetRequestJson(rootItem);
 
 	// create json string and return it
-	jsonParser.WriteToString(gNMEngineData->mTempJsonString, false);
-	return gNMEngineData->mTempJsonString.AsChar();
+	jsonParser.WriteToString(instance->mTempJsonString, false);
+	return instance->mTempJsonString.AsChar();
 }
 
 
-bool HandleJSONReplyFindParameters(const char* jsonString, const char* userId)
+bool HandleJSONReplyFindParameters(EngineHandle handle, const char* jsonString, const char* userId)
 {
-	if (HasClassifier() == false)
+	BIND_INSTANCE(handle, false);
+
+	if (HasClassifier(handle) == false)
 		return 0;
 
 	Json jsonParser;
@@ -1272,8 +1497,10 @@ bool HandleJSONReplyFindParameters(const char* jsonString, const char* userId)
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // calculate the number of data chunk channels
-int GetNumDataChunkChannels()
+int GetNumDataChunkChannels(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, -1);
+
 	// make sure the engine got initialized
 	if (GetEngine() == NULL)
 	{
@@ -1365,7 +1592,7 @@ bool CheckClassifierPrerequisites(const char* functionName, bool shallEngineRun)
 	}
 
 	// make sure the engine is in the right state
-	if (IsRunning() != shallEngineRun)
+	if (GetSession()->IsRunning() != shallEngineRun)
 	{
 		LogError( "%s: Engine is still running.", functionName );
 		return false;
@@ -1384,8 +1611,10 @@ bool CheckClassifierPrerequisites(const char* functionName, bool shallEngineRun)
 
 
 // get the create data chunk json for POST /api/datachunks/create
-const char* GetCreateDataChunkJson(const char* userId, const char* experienceUuid, int experienceRevision)
+const char* GetCreateDataChunkJson(EngineHandle handle, const char* userId, const char* experienceUuid, int experienceRevision)
 {
+	BIND_INSTANCE(handle, NULL);
+
 	// check if the engine is in the correct state, if the classifier is valid etc.
 	if (CheckClassifierPrerequisites("GetCreateDataChunkJson", false) == false)
 		return "";
@@ -1413,14 +1642,16 @@ const char* GetCreateDataChunkJson(const char* userId, const char* experienceUui
 	}
 
 	// write json object to string and return it
-	json.WriteToString( gNMEngineData->mTempJsonString );
-	return gNMEngineData->mTempJsonString.AsChar();
+	json.WriteToString( instance->mTempJsonString );
+	return instance->mTempJsonString.AsChar();
 }
 
 
 // get the data chunk channel json for POST /api/datachunks/upload
-const char* GetDataChunkChannelJson(const char* userId, const char* dataChunkUuid, int channelIndex)
+const char* GetDataChunkChannelJson(EngineHandle handle, const char* userId, const char* dataChunkUuid, int channelIndex)
 {
+	BIND_INSTANCE(handle, NULL);
+
 	// check if the engine is in the correct state, if the classifier is valid etc.
 	if (CheckClassifierPrerequisites("GetDataChunkChannelJson", false) == false)
 		return "";
@@ -1447,14 +1678,16 @@ const char* GetDataChunkChannelJson(const char* userId, const char* dataChunkUui
 	}
 
 	// write json object to string and return it
-	json.WriteToString( gNMEngineData->mTempJsonString );
-	return gNMEngineData->mTempJsonString.AsChar();
+	json.WriteToString( instance->mTempJsonString );
+	return instance->mTempJsonString.AsChar();
 }
 
 
 // export the data chunk channel 
-bool GenerateDataChunkChannelData(int channelIndex)
+bool GenerateDataChunkChannelData(EngineHandle handle, int channelIndex)
 {
+	BIND_INSTANCE(handle, false);
+
 	// check if the engine is in the correct state, if the classifier is valid etc.
 	if (CheckClassifierPrerequisites("GenerateDataChunkChannelData", false) == false)
 		return false;
@@ -1470,7 +1703,7 @@ bool GenerateDataChunkChannelData(int channelIndex)
 	}
 
 	// save samples to memory file
-	if (SessionExporter::SaveSamplesToMemoryFile(&gNMEngineData->mTempMemoryFile, channel) == false)
+	if (SessionExporter::SaveSamplesToMemoryFile(&instance->mTempMemoryFile, channel) == false)
 	{
 		LogError( "GenerateDataChunkChannelData: Something went wrong with serializing the channel." );
 		return false;
@@ -1480,30 +1713,27 @@ bool GenerateDataChunkChannelData(int channelIndex)
 }
 
 
-const char* GetDataChunkChannelData(int channelIndex)
+const char* GetDataChunkChannelData(EngineHandle handle, int channelIndex)
 {
-	if (gNMEngineData == NULL)
-		return NULL;
+	BIND_INSTANCE(handle, NULL);
 
-	return (const char*)gNMEngineData->mTempMemoryFile.GetData();
+	return (const char*)instance->mTempMemoryFile.GetData();
 }
 
 
-int GetDataChunkChannelDataSize(int channelIndex)
+int GetDataChunkChannelDataSize(EngineHandle handle, int channelIndex)
 {
-	if (gNMEngineData == NULL)
-		return 0;
+	BIND_INSTANCE(handle, -1);
 
-	return gNMEngineData->mTempMemoryFile.GetSize();
+	return instance->mTempMemoryFile.GetSize();
 }
 
 
-void ClearDataChunkChannelData()
+void ClearDataChunkChannelData(EngineHandle handle)
 {
-	if (gNMEngineData == NULL)
-		return;
+	BIND_INSTANCE(handle, );
 
-	return gNMEngineData->mTempMemoryFile.Close();
+	return instance->mTempMemoryFile.Close();
 }
 
 
@@ -1512,12 +1742,14 @@ void ClearDataChunkChannelData()
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // load the given state machine from json
-bool LoadStateMachine(const char* jsonContent, const char* uuid, int revision)
+bool LoadStateMachine(EngineHandle handle, const char* jsonContent, const char* uuid, int revision)
 {
+	BIND_INSTANCE(handle, false);
+
 	// make sure the engine got initialized and is not already running
 	if (GetEngine() == NULL)
 		return false;
-	if (IsRunning() == true)
+	if (IsRunning(handle) == true)
 		return false;
 
 	// load statemachine
@@ -1535,7 +1767,7 @@ bool LoadStateMachine(const char* jsonContent, const char* uuid, int revision)
 	// collect all assets the state machine uses
 	stateMachine->CollectStates();
 	stateMachine->CollectAssets();
-	gNMEngineData->mStateMachineAssets = stateMachine->GetAssets();
+	instance->mStateMachineAssets = stateMachine->GetAssets();
 
 	// load the statemachine into the engine
 	GetEngine()->LoadGraph(stateMachine);
@@ -1544,8 +1776,10 @@ bool LoadStateMachine(const char* jsonContent, const char* uuid, int revision)
 }
 
 
-bool HasStateMachine()
+bool HasStateMachine(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, false);
+
 	// make sure the engine got initialized
 	if (GetEngine() == NULL)
 		return false;
@@ -1572,8 +1806,10 @@ Action::AssetType ConvertAssetType(AssetType type)
 }
 
 
-int GetNumAssetsOfType(AssetType type)
+int GetNumAssetsOfType(EngineHandle handle, AssetType type)
 {
+	BIND_INSTANCE(handle, -1);
+
 	// make sure the engine got initialized
 	if (GetEngine() == NULL)
 		return 0;
@@ -1587,8 +1823,10 @@ int GetNumAssetsOfType(AssetType type)
 }
 
 
-const char* GetAssetLocationOfType(AssetType type, int index)
+const char* GetAssetLocationOfType(EngineHandle handle, AssetType type, int index)
 {
+	BIND_INSTANCE(handle, NULL);
+
 	// make sure the engine got initialized
 	if (GetEngine() == NULL)
 		return 0;
@@ -1602,8 +1840,10 @@ const char* GetAssetLocationOfType(AssetType type, int index)
 }
 
 
-bool GetAssetAllowStreamingOfType(AssetType type, int index)
+bool GetAssetAllowStreamingOfType(EngineHandle handle, AssetType type, int index)
 {
+	BIND_INSTANCE(handle, false);
+
 	// make sure the engine got initialized
 	if (GetEngine() == NULL)
 		return 0;
@@ -1617,8 +1857,10 @@ bool GetAssetAllowStreamingOfType(AssetType type, int index)
 }
 
 
-int GetNumAssets()
+int GetNumAssets(EngineHandle handle)
 {
+	BIND_INSTANCE(handle, -1);
+
 	// make sure the engine got initialized
 	if (GetEngine() == NULL)
 		return 0;
@@ -1632,8 +1874,10 @@ int GetNumAssets()
 }
 
 
-const char* GetAssetLocation(int index)
+const char* GetAssetLocation(EngineHandle handle, int index)
 {
+	BIND_INSTANCE(handle, NULL);
+
 	// make sure the engine got initialized
 	if (GetEngine() == NULL)
 		return 0;
@@ -1647,8 +1891,10 @@ const char* GetAssetLocation(int index)
 }
 
 
-bool GetAssetAllowStreaming(int index)
+bool GetAssetAllowStreaming(EngineHandle handle, int index)
 {
+	BIND_INSTANCE(handle, false);
+
 	// make sure the engine got initialized
 	if (GetEngine() == NULL)
 		return 0;
@@ -1666,12 +1912,14 @@ bool GetAssetAllowStreaming(int index)
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // load the given classifier from json
-bool LoadExperience(const char* jsonContent, const char* uuid, int revision)
+bool LoadExperience(EngineHandle handle, const char* jsonContent, const char* uuid, int revision)
 {
+	BIND_INSTANCE(handle, false);
+
 	// make sure the engine got initialized and is not running
 	if (GetEngine() == NULL)
 		return false;
-	if (IsRunning() == true)
+	if (IsRunning(handle) == true)
 		return false;
 
 	// try to load new classifier
@@ -1691,8 +1939,8 @@ bool LoadExperience(const char* jsonContent, const char* uuid, int revision)
 	
 	GetEngine()->LoadExperience(experience);
 
-	Reset();
-	UpdateFeedbackData();
+	Reset(handle);
+	UpdateFeedbackData(instance);
 
 	return true;
 }
@@ -1702,17 +1950,19 @@ bool LoadExperience(const char* jsonContent, const char* uuid, int revision)
 // Callback
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void SetCallback(Callback* callback)
+void SetCallback(EngineHandle handle, Callback* callback)
 {
+	BIND_INSTANCE(handle, );
+
 	// check if there already is a callback assigned
-	if (gCallback != NULL)
+	if (instance->mCallback != NULL)
 	{
 		// destroy the callback
-		delete gCallback;
-		gCallback = NULL;
+		delete instance->mCallback;
+		instance->mCallback = NULL;
 	}
 
-	gCallback = callback;
+	instance->mCallback = callback;
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1720,14 +1970,16 @@ void SetCallback(Callback* callback)
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // called when a button got clicked
-bool ButtonClicked(int buttonId)
+bool ButtonClicked(EngineHandle handle, int buttonId)
 {
+	BIND_INSTANCE(handle, false);
+
 	// skip directly in case the engine is not running
-	if (IsRunning() == false)
+	if (IsRunning(handle) == false)
 		return false;
 
 	// no state machine loaded
-	if (HasStateMachine() == false)
+	if (HasStateMachine(handle) == false)
 		return false;
 
 	// get the active state machine
@@ -1770,14 +2022,16 @@ bool ButtonClicked(int buttonId)
 
 
 // call this when an audio file looped
-bool AudioLooped(const char* url)
+bool AudioLooped(EngineHandle handle, const char* url)
 {
+	BIND_INSTANCE(handle, false);
+
 	// skip directly in case the engine is not running
-	if (IsRunning() == false)
+	if (IsRunning(handle) == false)
 		return false;
 
 	// no state machine loaded
-	if (HasStateMachine() == false)
+	if (HasStateMachine(handle) == false)
 		return false;
 
 	// get the active state machine
@@ -1822,14 +2076,16 @@ bool AudioLooped(const char* url)
 
 
 // call this when an video file looped
-bool VideoLooped(const char* url)
+bool VideoLooped(EngineHandle handle, const char* url)
 {
+	BIND_INSTANCE(handle, false);
+
 	// skip directly in case the engine is not running
-	if (IsRunning() == false)
+	if (IsRunning(handle) == false)
 		return false;
 
 	// no state machine loaded
-	if (HasStateMachine() == false)
+	if (HasStateMachine(handle) == false)
 		return false;
 
 	// get the active state machine
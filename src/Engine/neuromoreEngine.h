@@ -29,6 +29,14 @@
 namespace neuromoreEngine
 {
 
+	/**
+	 * Handle of an engine instance, returned by Init().
+	 * Every instance owns its own devices, classifier, state machine, session and callback, so a process can run several engines side by side
+	 * (e.g. one per core when processing recorded sessions). Calls into one instance must not overlap, different instances can be used from different threads concurrently.
+	 * All functions that take a handle bind the instance to the calling thread for the duration of the call.
+	 */
+	typedef struct EngineInstance* EngineHandle;
+
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	// Engine initialization
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -36,9 +44,9 @@ namespace neuromoreEngine
 	/**
 	 * Set the engine buffer length, in seconds.
 	 * Use this to adjust the buffer size of the engine. If you update the engine not often enough, or if you push too many samples in the devices at once,
-	 * the buffers will overflow and OnError() will be called and the engine will stop. Default value is 5 seconds.
+	 * the buffers will overflow and OnError() will be called and the engine will stop. Default value is 2 seconds (on top of what the graph reads at once).
 	 */
-	bool SetBufferLength(double seconds);
+	bool SetBufferLength(EngineHandle handle, double seconds);
 
 	enum EPowerLineFrequencyType
 	{
@@ -51,27 +59,28 @@ namespace neuromoreEngine
 	 * Set the power line frequency.
 	 * @param[in] powerLineFrequency The power line frequency for the current location of the device.
 	 */
-	bool SetPowerLineFrequencyType(EPowerLineFrequencyType powerLineFrequencyType);
-	double GetPowerLineFrequency();
+	bool SetPowerLineFrequencyType(EngineHandle handle, EPowerLineFrequencyType powerLineFrequencyType);
+	double GetPowerLineFrequency(EngineHandle handle);
 
 	/**
-	 * Initialize the neuromore Engine.
-	 * Call this before calling any other function from the engine.
-	 * @result True in case everything got initialized correctly, false in case something failed.
+	 * Initialize an instance of the neuromore Engine.
+	 * Call this before calling any other function from the engine. Each call creates a new, independent instance.
+	 * Instances can be created and shut down from different threads.
+	 * @result The handle of the new instance, NULL in case something failed.
 	 */
-	bool Init();
+	EngineHandle Init();
 
 	/*
 	 * Check if neuromore Engine is initialized and ready. You can call Start() only if this method returns true.
 	 * @return True in case the engine is ready for action, false in case an error happened or Init() wasn't called yet.
 	 */
-	bool IsInitialized();
+	bool IsInitialized(EngineHandle handle);
 
 	/**
-	 * Shutdown the neuromore Engine.
-	 * Call this after the last engine function call inside your application. This will destruct all used objects and cleanup memory.
+	 * Shutdown an instance of the neuromore Engine.
+	 * Call this after the last function call on the instance. This will destruct all objects of the instance and cleanup memory; the handle is invalid afterwards.
 	 */
-	void Shutdown();
+	void Shutdown(EngineHandle handle);
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	// Engine basics: Start, Stop, Cleanup, Update etc
@@ -81,13 +90,13 @@ namespace neuromoreEngine
 	 * Check if the engine is ready to start
 	 * This requires: 1) classifier/statemachine is loaded 2) required devices were added
 	 */
-	bool IsReady();
+	bool IsReady(EngineHandle handle);
 
 	/**
 	* Set the maximum duration a single session should be running.
 	* It will stop execution if the time is reached, but can also be stopped by the Statemachine (if there is one)
 	*/
-	void SetSessionLength(double seconds);
+	void SetSessionLength(EngineHandle handle, double seconds);
 
 	/**
 	 * Begin processing data.
@@ -97,37 +106,72 @@ namespace neuromoreEngine
 	 * Make sure that you clear all device sample buffers before starting, samples must NOT be older than the time where Start() was called.
 	 * @return true if engine could be started, false if not (same return value as IsInitialized())
 	 */
-	bool Start();
-	bool StartThreaded();
+	bool Start(EngineHandle handle);
+	bool StartThreaded(EngineHandle handle);
 
 	/**
 	 * Update the neuromore Engine.
 	 * The engine needs to be update regularily and close to real-time. Call this function inside your application real-time loop. Call this function as often as possible so that the time deltas are small.
 	 */
-	bool Update();
+	bool Update(EngineHandle handle);
 
 	/*
 	 **/
-	bool GetPerformanceStatistics(double* outFps, double* outTheoreticalFps, double* outAveragedTiming, double* outBestCaseTiming, double* outWorstCaseTiming);
+	bool GetPerformanceStatistics(EngineHandle handle, double* outFps, double* outTheoreticalFps, double* outAveragedTiming, double* outBestCaseTiming, double* outWorstCaseTiming);
+
+	/**
+	 * Enable or disable per-node profiling of the classifier update.
+	 * While enabled the engine records the inclusive/exclusive time, new samples and allocations of every node for the last 128 updates.
+	 */
+	void SetProfilingEnabled(EngineHandle handle, bool enabled);
+	bool IsProfilingEnabled(EngineHandle handle);
+
+	/**
+	 * Write the recorded profiling frames as trace event JSON (open with chrome://tracing or ui.perfetto.dev).
+	 * @return true if the file could be written
+	 */
+	bool ExportProfilingTrace(EngineHandle handle, const char* filename);
+
+	enum EMemoryTag
+	{
+		MEMORY_GENERAL		= 0,
+		MEMORY_DSP			= 1,
+		MEMORY_GRAPH		= 2,
+		MEMORY_NETWORKING	= 3,
+		MEMORY_STRINGS		= 4,
+		NUM_MEMORY_TAGS		= 5
+	};
+
+	/**
+	 * Get the heap accounting of one engine subsystem (process-wide, summed over all instances).
+	 * Realtime allocations are the allocations made by the classifier update while a session is running; in a well-behaved classifier this number stops growing after the first updates.
+	 * @return false if the tag is invalid
+	 */
+	bool GetMemoryStatistics(EMemoryTag tag, double* outLiveBytes, double* outNumLiveAllocations, double* outNumAllocations, double* outNumRealtimeAllocations);
+
+	/**
+	 * Assert on every heap allocation inside the running classifier update (debug builds only, allocations are counted in any case).
+	 */
+	void SetRealtimeAllocationAssert(bool enabled);
 
 	/**
 	 * Check if the engine is currently running. 
 	 * Note that you cannot modify the engine in any way during runtime.
 	 * @return true if the engine is currently processing data
 	 */
-	bool IsRunning();
+	bool IsRunning(EngineHandle handle);
 
 	/**
 	 * Stops the engine if it is currently running. 
 	 * Also resets the classifier, statemachine and devices. If you call Start() it will run from the beginning again and not continue where you left of.
 	 */
-	bool Stop();
-	bool StopThreaded();
+	bool Stop(EngineHandle handle);
+	bool StopThreaded(EngineHandle handle);
 
 	/**
 	* Resets the classifier, statemachine and clears devices inputs (but does not remove devices)
 	*/
-	void Reset();
+	void Reset(EngineHandle handle);
 
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -138,13 +182,13 @@ namespace neuromoreEngine
 	 * Enable debug logging.
 	 * Only do this for development builds and never call this for production. This might spawn your console.
 	 */
-	void EnableDebugLogging();
+	void EnableDebugLogging(EngineHandle handle);
 
 	/**
 	 * Asset streaming option.
 	 * Enable this in case the internet connection is stable enough for audio and video streaming.
 	 */
-	void SetAllowAssetStreaming(bool allow);
+	void SetAllowAssetStreaming(EngineHandle handle, bool allow);
 
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -225,54 +269,54 @@ namespace neuromoreEngine
 	 * Add a device of a certain type.
 	 * @return The index of the device in the internal device manager. -1 in case something failed.
 	 */
-	int AddDevice(EDevice type);
+	int AddDevice(EngineHandle handle, EDevice type);
 
 	/**
 	* Get the number of active devices.
 	* @return the number of devices that were added to the engine
 	*/
-	int GetNumDevices();
+	int GetNumDevices(EngineHandle handle);
 
 	/**
 	* Remove a device.
 	* This is only possible if the device exists and the engine is not running.
 	* @return true if the device was removed successfully
 	*/
-	bool RemoveDevice(int deviceIndex);
+	bool RemoveDevice(EngineHandle handle, int deviceIndex);
 
 	/**
 	* Get the type of the active device with the given index
 	* @return the number of devices that were added to the engine
 	*/
-	EDevice GetDevice(int deviceIndex);
+	EDevice GetDevice(EngineHandle handle, int deviceIndex);
 
 	/**
 	* If as at least one device was added to the engine
 	* @return true if the device was added successfully
 	*/
-	bool HasDevice(EDevice type);
+	bool HasDevice(EngineHandle handle, EDevice type);
 
-    bool ConnectDevice(int deviceIndex);
-    bool DisonnectDevice(int deviceIndex);
+    bool ConnectDevice(EngineHandle handle, int deviceIndex);
+    bool DisonnectDevice(EngineHandle handle, int deviceIndex);
 
 	/**
 	* Get the number of inputs of a device.
 	* @return the number of inputs of the device. -1 will be returned if the device does not exist.
 	*/
-	int GetNumInputs(int deviceIndex);
+	int GetNumInputs(EngineHandle handle, int deviceIndex);
 
 	/**
 	* Push a value into a device input.
 	* Use this method to forward samples from input devices to the engine. It can be called concurrent to the update loop. 
 	* Best practice: forward the input data as soon as possible and keep the latency as low as possible (especially if the sensor has high sample rates)
 	*/
-	bool AddInputSample(int deviceIndex, int inputIndex, double value);
+	bool AddInputSample(EngineHandle handle, int deviceIndex, int inputIndex, double value);
 
 	/**
 	* Set the battery charge level of a device.
 	* Forward the battery charge so it can be monitored by the engine. The engine will not start if the battery charge is too low.
 	*/
-	bool SetBatteryChargeLevel(int deviceIndex, double normalizedCharge);
+	bool SetBatteryChargeLevel(EngineHandle handle, int deviceIndex, double normalizedCharge);
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	// Classifier
@@ -285,13 +329,13 @@ namespace neuromoreEngine
 	* @param[in] revision The classifier file revision as delivered from the back-end.
 	* @return True in case the classifier got loaded correctly, false in case an error happened.
 	*/
-	bool LoadClassifier(const char* jsonContent, const char* uuid, int revision);
+	bool LoadClassifier(EngineHandle handle, const char* jsonContent, const char* uuid, int revision);
 
 	/*
 	* Check if a classifier is present.
 	* @return True in case a classifier was loaded, false if an error happened during loading OR if the engine is not initialized OR in case no classifier is declared as active
 	*/
-	bool HasClassifier();
+	bool HasClassifier(EngineHandle handle);
 
 	/**
 	 * Check if the active classifier requires the given device.
@@ -299,28 +343,28 @@ namespace neuromoreEngine
 	 * Do not allow to Start() in case a device is missing. Show and wait for all required devices on the sensor waiting screen before allowing the user to start a session.
 	 * @return true if the device was added successfully
 	 */
-	bool IsDeviceRequiredByClassifier(EDevice deviceType);
+	bool IsDeviceRequiredByClassifier(EngineHandle handle, EDevice deviceType);
 
 	/**
 	* Get the number of feedback nodes from the currently active classifier.
 	* @result The number of custom feedback nodes in the classifier. -1 will be returned in case there is no active classifier.
 	*/
-	int GetNumFeedbacks();
+	int GetNumFeedbacks(EngineHandle handle);
 
 	/**
 	* Get the name of a feedback node
 	* @result The name of the node. It can be empty.
 	*/
-	const char* GetFeedbackName(int index);
+	const char* GetFeedbackName(EngineHandle handle, int index);
 
-	int FindFeedbackIndexByName(const char* name);
+	int FindFeedbackIndexByName(EngineHandle handle, const char* name);
 
 	/**
 	* Get the current value from the given feedback node.
 	* @param[in] The index of the custom feedback node from which we want to extract data. The index has to be in range of [0, GetNumFeedbackss()].
 	* @return The current feedback value. In case no classifier is active or the index is invalid 0.0 will be returned.
 	*/
-	double GetCurrentFeedbackValue(int index);
+	double GetCurrentFeedbackValue(EngineHandle handle, int index);
 
 	/**
 	* Get the value range of a feedback
@@ -328,7 +372,7 @@ namespace neuromoreEngine
 	* @param[out] outMinValue The minimum value set in the node. In case no classifier is active or the index is invalid 0.0 will be filled.
 	* @param[out] outMaxValue The maximum value set in the node. In case no classifier is active or the index is invalid 0.0 will be filled.
 	*/
-	void GetFeedbackRange(int index, double* outMinValue, double* outMaxValue);
+	void GetFeedbackRange(EngineHandle handle, int index, double* outMinValue, double* outMaxValue);
 
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -356,22 +400,22 @@ namespace neuromoreEngine
 	 * @param experienceRevision The revision number of the experience that just got stopped.
 	 * @result The ready json string for POST /api/datachunks/create.
 	 */
-	const char* GetCreateDataChunkJson(const char* userId, const char* experienceUuid, int experienceRevision);
+	const char* GetCreateDataChunkJson(EngineHandle handle, const char* userId, const char* experienceUuid, int experienceRevision);
 
 	/**
 	 * Get the number of data chunk channels for all feedback nodes that have data upload enabled.
 	 * @result The number of data chunk channels.
 	 */
-	int GetNumDataChunkChannels();
+	int GetNumDataChunkChannels(EngineHandle handle);
 
 	// get the data chunk channel json for POST /api/datachunks/upload
-	const char* GetDataChunkChannelJson(const char* userId, const char* dataChunkUuid, int channelIndex);
+	const char* GetDataChunkChannelJson(EngineHandle handle, const char* userId, const char* dataChunkUuid, int channelIndex);
 
-	bool GenerateDataChunkChannelData(int channelIndex);
-	const char* GetDataChunkChannelData(int channelIndex);
-	int GetDataChunkChannelDataSize(int channelIndex);
+	bool GenerateDataChunkChannelData(EngineHandle handle, int channelIndex);
+	const char* GetDataChunkChannelData(EngineHandle handle, int channelIndex);
+	int GetDataChunkChannelDataSize(EngineHandle handle, int channelIndex);
 
-	void ClearDataChunkChannelData();
+	void ClearDataChunkChannelData(EngineHandle handle);
 
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -408,12 +452,12 @@ namespace neuromoreEngine
 
 	// TODO implement this in case we want to interact with the cloud parameter manually; for now we keep using the json generator methods
 	/*int GetNumCloudInputs();
-	bool GetCloudInputConfig(int index, const char* outName, int* outType, double* outTimeRange);
-	void AddCloudInputValue(int index, double value);
+	bool GetCloudInputConfig(EngineHandle handle, int index, const char* outName, int* outType, double* outTimeRange);
+	void AddCloudInputValue(EngineHandle handle, int index, double value);
 	
-	int GetNumCloudOutputs();
-	bool GetCloudOutputConfig(int index, const char* outName, int* outType, int* outNumValues);
-	double GetCloudOutputValue(int outputIndex, int valueIndex);*/
+	int GetNumCloudOutputs(EngineHandle handle);
+	bool GetCloudOutputConfig(EngineHandle handle, int index, const char* outName, int* outType, int* outNumValues);
+	double GetCloudOutputValue(EngineHandle handle, int outputIndex, int valueIndex);*/
 	
 	/**
 	* Create the JSON request string for retrieving the parameters from the backend via (POST /api/users/<id>/parameters/find)
@@ -422,7 +466,7 @@ namespace neuromoreEngine
 	* @param[in]	userId	The user ID string.
 	* @return the JSON string or an empty string. Data is valid until a CreateJSONRequest method is called again.
 	*/
-	const char* CreateJSONRequestFindParameters(const char* userId);
+	const char* CreateJSONRequestFindParameters(EngineHandle handle, const char* userId);
 	
 	/**
 	* Handle the reply of a find parameters JSON request.
@@ -430,14 +474,14 @@ namespace neuromoreEngine
 	* @param[in]	jsonString	The JSON reply from a find parameters request.
 	* @return True if the JSON was parsed successfully.
 	*/
-	bool HandleJSONReplyFindParameters(const char* jsonString, const char* userId);
+	bool HandleJSONReplyFindParameters(EngineHandle handle, const char* jsonString, const char* userId);
 
 	/**
 	* Create the JSON request string for updating the parameters in the backend via (POST /api/users/<id>/parameters/set)
 	* Parameters must be send to the backend after a session has completed successfully.  If there are no parameters, an empty string is returned and nothing has to be done.
 	* @return the JSON string (valid until a CreateJSONRequest method is called again)
 	*/
-	const char* CreateJSONRequestSetParameters();
+	const char* CreateJSONRequestSetParameters(EngineHandle handle);
 
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -451,13 +495,13 @@ namespace neuromoreEngine
 	* @param[in] revision The state machine file revision as delivered from the back-end.
 	* @return True in case the state machine got loaded correctly, false in case an error happened.
 	*/
-	bool LoadStateMachine(const char* jsonContent, const char* uuid, int revision);
+	bool LoadStateMachine(EngineHandle handle, const char* jsonContent, const char* uuid, int revision);
 
 	/**
 	* Check if a state machine is present.
 	* @return True in case a state machine was loaded, false in case an error happened during loading or in case no state machine is declared as active.
 	*/
-	bool HasStateMachine();
+	bool HasStateMachine(EngineHandle handle);
 
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -472,13 +516,13 @@ namespace neuromoreEngine
 		ASSET_IMAGE		= 3
 	};
 
-	int GetNumAssetsOfType(AssetType type);
-	const char* GetAssetLocationOfType(AssetType type, int index);
-	bool GetAssetAllowStreamingOfType(AssetType type, int index);
+	int GetNumAssetsOfType(EngineHandle handle, AssetType type);
+	const char* GetAssetLocationOfType(EngineHandle handle, AssetType type, int index);
+	bool GetAssetAllowStreamingOfType(EngineHandle handle, AssetType type, int index);
 
-	int GetNumAssets();
-	const char* GetAssetLocation(int index);
-	bool GetAssetAllowStreaming(int index);
+	int GetNumAssets(EngineHandle handle);
+	const char* GetAssetLocation(EngineHandle handle, int index);
+	bool GetAssetAllowStreaming(EngineHandle handle, int index);
 
 	/**
 	* Signal the engine that a video asset has finished playback.
@@ -503,7 +547,7 @@ namespace neuromoreEngine
 	 * Buttons created via Callback::OnShowButton() deliver a buttonId with the callback. Please feed back the button id to this input event when the given button got clicked.
 	 * @param[in] buttonId The button id of the button that got clicked.
 	 */
-	bool ButtonClicked(int buttonId);
+	bool ButtonClicked(EngineHandle handle, int buttonId);
 
 	/**
 	 * Call this when an audio file looped.
@@ -511,7 +555,7 @@ namespace neuromoreEngine
 	 * This is important for all audio files played via Callback::OnPlayAudio(). Please feed back the same audio url that got delivered for the OnPlayAudio() event.
 	 * @param[in] url The audio location of the audio file that looped.
 	 */
-	bool AudioLooped(const char* url);
+	bool AudioLooped(EngineHandle handle, const char* url);
 
 	/**
 	 * Call this when an video file looped.
@@ -519,7 +563,7 @@ namespace neuromoreEngine
 	 * This is important for all video files played via Callback::OnPlayVideo(). Please feed back the same audio url that got delivered for the OnPlayVideo() event.
 	 * @param[in] url The videolocation of the audio file that looped.
 	 */
-	bool VideoLooped(const char* url);
+	bool VideoLooped(EngineHandle handle, const char* url);
 
 	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 	// Callback
@@ -619,7 +663,7 @@ namespace neuromoreEngine
 	 * Derive the Callback class and respond to the given events.
 	 * Callback will be automatically destroyed by Shutdown().
 	 */
-	void SetCallback(Callback* callback);
+	void SetCallback(EngineHandle handle, Callback* callback);
 };
 
 
@@ -0,0 +1,510 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// headless batch processor: runs a classifier offline over a directory of recordings, one engine instance per recording
+//
+// usage: EngineBatch [options] <classifier.json> <input directory> <output directory>
+//   -jobs <n>          number of recordings processed in parallel (default: number of cores)
+//   -step <seconds>    simulated time per engine update (default 1)
+//   -maxduration <s>   stop every recording after this much simulated time (default 0 = until end of data)
+//
+// the recordings (.edf and .csv) are played back through all file reader nodes of the classifier, file writer nodes
+// write to <output directory>/<recording>_<node>.<ext> and the feedback node outputs go to <recording>_feedback_<node>.csv
+
+// include required headers
+#include <Config.h>
+#include <EngineManager.h>
+#include <OfflineRunner.h>
+#include <Core/LogManager.h>
+#include <Core/LogCallbacks.h>
+#include <Graph/Classifier.h>
+#include <Graph/GraphImporter.h>
+#include <Graph/FileReaderNode.h>
+#include <Graph/FileWriterNode.h>
+#include <Graph/FeedbackNode.h>
+#include <DSP/ChannelFileReader.h>
+#include <DSP/ChannelFileWriter.h>
+#include <Devices/DeviceInventory.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	#pragma comment(lib, "Ws2_32.lib")			// winapi: sockets
+	#pragma comment(lib, "winmm.lib")			// winapi: multimedia
+#endif
+
+using namespace Core;
+namespace fs = std::filesystem;
+
+
+// batch settings
+struct Settings
+{
+	const char*	mClassifierFile	= NULL;
+	const char*	mInputDirectory	= NULL;
+	const char*	mOutputDirectory= NULL;
+	uint32		mNumJobs		= 0;
+	double		mStepSize		= 1.0;
+	double		mMaxDuration	= 0.0;
+};
+
+
+// one recording of the input directory and the outcome of processing it
+struct Job
+{
+	fs::path	mInputFile;
+	std::string	mName;					// file name without extension, prefix of all output files
+	bool		mSuccess		= false;
+	double		mDuration		= 0.0;	// simulated seconds
+	double		mWallTime		= 0.0;	// seconds
+	uint32		mNumUpdates		= 0;
+	std::vector<std::string> mNodeErrors;
+};
+
+
+// serializes the console output of the worker threads
+static std::mutex gConsoleMutex;
+
+
+// prints engine warnings and errors to the console, prefixed with the recording the engine is working on
+class ConsoleLogCallback : public LogCallback
+{
+	public:
+		enum { TYPE_ID = 0xBA7C4 };
+		uint32 GetType() const override											{ return TYPE_ID; }
+
+		ConsoleLogCallback(const std::string& prefix) : LogCallback()			{ mPrefix = prefix; }
+
+		void Log(const char* text, ELogLevel logLevel) override
+		{
+			const char* level = NULL;
+			switch (logLevel)
+			{
+				case LOGLEVEL_CRITICAL:	level = "CRITICAL";	break;
+				case LOGLEVEL_ERROR:	level = "ERROR";	break;
+				case LOGLEVEL_WARNING:	level = "WARNING";	break;
+				default:									return;
+			}
+
+			std::lock_guard<std::mutex> lock(gConsoleMutex);
+			fprintf(stderr, "[%s] %s: %s\n", level, mPrefix.c_str(), text);
+		}
+
+	private:
+		std::string mPrefix;
+};
+
+
+// offline run that appends the new output samples of all feedback nodes to one CSV file per node after every update
+class FeedbackRecorder : public OfflineRunner
+{
+	public:
+		FeedbackRecorder(const fs::path& outputPrefix) : OfflineRunner()	{ mOutputPrefix = outputPrefix; mHasWriteError = false; }
+
+		~FeedbackRecorder()
+		{
+			for (Output& output : mOutputs)
+				if (output.mFile != NULL)
+					fclose(output.mFile);
+		}
+
+		bool HasWriteError() const												{ return mHasWriteError; }
+
+		void OnUpdate(const Time& elapsed) override
+		{
+			Classifier* classifier = GetEngine()->GetActiveClassifier();
+			const uint32 numFeedbackNodes = classifier->GetNumFeedbackNodes();
+			for (uint32 i=0; i<numFeedbackNodes; ++i)
+			{
+				FeedbackNode* node = classifier->GetFeedbackNode(i);
+				Output& output = FindOrCreateOutput(node);
+				if (output.mHasWriteError == true)
+					continue;
+
+				output.mChannels.Clear(false);
+				const uint32 numChannels = node->GetNumOutputChannels();
+				for (uint32 c=0; c<numChannels; ++c)
+					output.mChannels.Add(node->GetOutputChannel(c));
+
+				if (output.mChannels.IsEmpty() == true)
+					continue;
+
+				// number of samples added since the last update (limited to what the channels still hold)
+				uint64 sampleCounter = output.mChannels[0]->GetSampleCounter();
+				uint64 numSamples = CORE_UINT64_MAX;
+				for (uint32 c=0; c<numChannels; ++c)
+				{
+					sampleCounter = Min(sampleCounter, output.mChannels[c]->GetSampleCounter());
+					numSamples = Min(numSamples, output.mChannels[c]->GetNumSamples());
+				}
+
+				if (sampleCounter < output.mSampleCounter)
+					output.mSampleCounter = 0;
+
+				numSamples = Min(numSamples, sampleCounter - output.mSampleCounter);
+				output.mSampleCounter = sampleCounter;
+
+				if (numSamples == 0)
+					continue;
+
+				if (output.mFile == NULL && OpenOutput(node, output) == false)
+					continue;
+
+				if (mWriter.WriteSamples(ChannelFileWriter::FORMAT_CSV_TIMESTAMP, output.mChannels, numSamples, output.mFile, NULL) == false)
+				{
+					LogError("Cannot write the output of feedback node '%s'.", node->GetName());
+					output.mHasWriteError = true;
+					mHasWriteError = true;
+				}
+			}
+		}
+
+	private:
+		struct Output
+		{
+			FeedbackNode*			mNode;
+			FILE*					mFile;
+			uint64					mSampleCounter;
+			bool					mHasWriteError;
+			Array<Channel<double>*>	mChannels;
+		};
+
+		Output& FindOrCreateOutput(FeedbackNode* node)
+		{
+			for (Output& output : mOutputs)
+				if (output.mNode == node)
+					return output;
+
+			Output output;
+			output.mNode			= node;
+			output.mFile			= NULL;
+			output.mSampleCounter	= 0;
+			output.mHasWriteError	= false;
+			mOutputs.push_back(output);
+			return mOutputs.back();
+		}
+
+		bool OpenOutput(FeedbackNode* node, Output& output)
+		{
+			fs::path fileName = mOutputPrefix;
+			fileName += std::string("_feedback_") + node->GetName() + ".csv";
+
+			output.mFile = fopen(fileName.string().c_str(), "wb");
+			if (output.mFile == NULL || mWriter.WriteHeader(ChannelFileWriter::FORMAT_CSV_TIMESTAMP, output.mChannels, output.mFile) == false)
+			{
+				LogError("Cannot write '%s'.", fileName.string().c_str());
+				output.mHasWriteError = true;
+				mHasWriteError = true;
+				return false;
+			}
+
+			return true;
+		}
+
+		fs::path				mOutputPrefix;
+		std::vector<Output>		mOutputs;
+		ChannelFileWriter		mWriter;
+		bool					mHasWriteError;
+};
+
+
+static void PrintUsage()
+{
+	printf("usage: EngineBatch [options] <classifier.json> <input directory> <output directory>\n");
+	printf("  -jobs <n>          number of recordings processed in parallel (default: number of cores)\n");
+	printf("  -step <seconds>    simulated time per engine update (default 1)\n");
+	printf("  -maxduration <s>   stop every recording after this much simulated time (default 0 = until end of data)\n");
+}
+
+
+static bool ParseArguments(int argc, char** argv, Settings& settings)
+{
+	for (int i=1; i<argc; ++i)
+	{
+		const char* arg = argv[i];
+		const bool hasValue = (i+1 < argc);
+
+		if		(strcmp(arg, "-jobs") == 0 && hasValue)				settings.mNumJobs			= atoi(argv[++i]);
+		else if (strcmp(arg, "-step") == 0 && hasValue)				settings.mStepSize			= atof(argv[++i]);
+		else if (strcmp(arg, "-maxduration") == 0 && hasValue)		settings.mMaxDuration		= atof(argv[++i]);
+		else if (arg[0] != '-' && settings.mClassifierFile == NULL)	settings.mClassifierFile	= arg;
+		else if (arg[0] != '-' && settings.mInputDirectory == NULL)	settings.mInputDirectory	= arg;
+		else if (arg[0] != '-' && settings.mOutputDirectory == NULL)	settings.mOutputDirectory	= arg;
+		else
+			return false;
+	}
+
+	return (settings.mClassifierFile != NULL && settings.mInputDirectory != NULL && settings.mOutputDirectory != NULL && settings.mStepSize > 0.0);
+}
+
+
+// lower case extension of a path, without the dot
+static std::string GetExtension(const fs::path& path)
+{
+	std::string extension = path.extension().string();
+	if (extension.empty() == false)
+		extension.erase(0, 1);
+
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)tolower(c); });
+	return extension;
+}
+
+
+// node names may contain characters that are not allowed in file names
+static std::string GetFileSafeName(const char* name)
+{
+	std::string result = name;
+	for (char& c : result)
+		if (isalnum((unsigned char)c) == 0 && c != '-')
+			c = '_';
+
+	return result;
+}
+
+
+// collect the recordings in the input directory, sorted by name so the order of the report does not depend on the file system
+static bool CollectJobs(const Settings& settings, std::vector<Job>& outJobs)
+{
+	std::error_code error;
+	fs::directory_iterator iterator(settings.mInputDirectory, error);
+	if (error)
+	{
+		printf("Cannot open input directory '%s'.\n", settings.mInputDirectory);
+		return false;
+	}
+
+	for (const fs::directory_entry& entry : iterator)
+	{
+		if (entry.is_regular_file() == false)
+			continue;
+
+		const std::string extension = GetExtension(entry.path());
+		if (extension != "edf" && extension != "csv")
+			continue;
+
+		Job job;
+		job.mInputFile	= entry.path();
+		job.mName		= entry.path().stem().string();
+		outJobs.push_back(job);
+	}
+
+	std::sort(outJobs.begin(), outJobs.end(), [](const Job& a, const Job& b) { return a.mInputFile < b.mInputFile; });
+	return true;
+}
+
+
+// load the classifier into the current engine and redirect its file readers and writers to the job
+static Classifier* LoadClassifier(const Settings& settings, const Job& job)
+{
+	Classifier* classifier = new Classifier();
+	if (GraphImporter::LoadFromFile(settings.mClassifierFile, classifier) == false)
+	{
+		LogError("Cannot load classifier '%s'.", settings.mClassifierFile);
+		delete classifier;
+		return NULL;
+	}
+
+	classifier->CollectNodes();
+
+	const std::string extension = GetExtension(job.mInputFile);
+	const fs::path outputPrefix = fs::path(settings.mOutputDirectory) / job.mName;
+
+	const uint32 numNodes = classifier->GetNumNodes();
+	for (uint32 i=0; i<numNodes; ++i)
+	{
+		Node* node = classifier->GetNode(i);
+
+		// play back the recording, keep the CSV flavor selected in the classifier
+		if (node->GetType() == FileReaderNode::TYPE_ID)
+		{
+			int32 format = node->GetInt32Attribute(FileReaderNode::ATTRIB_FORMAT);
+			if (extension == "edf")
+				format = ChannelFileReader::FORMAT_EDF_PLUS;
+			else if (format == ChannelFileReader::FORMAT_EDF_PLUS)
+				format = ChannelFileReader::FORMAT_CSV_SIMPLE;
+
+			node->SetStringAttributeByIndex(FileReaderNode::ATTRIB_URL, job.mInputFile.string().c_str());
+			node->SetInt32AttributeByIndex(FileReaderNode::ATTRIB_FORMAT, format);
+			node->OnAttributesChanged();
+		}
+
+		// one output file per recording and node, replaced on every batch run
+		else if (node->GetType() == FileWriterNode::TYPE_ID)
+		{
+			const ChannelFileWriter::EFormat format = (ChannelFileWriter::EFormat)node->GetInt32Attribute(FileWriterNode::ATTRIB_FORMAT);
+
+			fs::path fileName = outputPrefix;
+			fileName += std::string("_") + GetFileSafeName(node->GetName()) + "." + ChannelFileWriter::GetFormatExtension(format);
+
+			node->SetStringAttributeByIndex(FileWriterNode::ATTRIB_FILE, fileName.string().c_str());
+			node->SetInt32AttributeByIndex(FileWriterNode::ATTRIB_WRITEMODE, FileWriterNode::WRITEMODE_OVERWRITE_ALWAYS);
+			node->OnAttributesChanged();
+		}
+	}
+
+	GetEngine()->LoadGraph(classifier);
+	return classifier;
+}
+
+
+// process one recording on a private engine instance
+static void ProcessJob(const Settings& settings, Job& job)
+{
+	const auto startTime = std::chrono::steady_clock::now();
+
+	EngineManager* engine = EngineInitializer::CreateInstance();
+	if (engine == NULL)
+	{
+		std::lock_guard<std::mutex> lock(gConsoleMutex);
+		printf("%s: failed to create an engine instance\n", job.mName.c_str());
+		return;
+	}
+
+	{
+		EngineScope scope(engine);
+
+		CORE_LOGMANAGER.AddLogCallback(new ConsoleLogCallback(job.mName));
+
+		engine->SetIsRunning(true);
+		engine->SetAutoSyncSetting(false);
+		DeviceInventory::RegisterDevices(true);
+		GetDeviceManager()->SetRemoveInactiveDevicesEnabled(false);
+
+		Classifier* classifier = LoadClassifier(settings, job);
+		if (classifier != NULL)
+		{
+			FeedbackRecorder runner(fs::path(settings.mOutputDirectory) / job.mName);
+			runner.SetStepSize(settings.mStepSize);
+			runner.SetMaxDuration(settings.mMaxDuration);
+
+			job.mSuccess		= (runner.Run() == true && runner.HasWriteError() == false);
+			job.mDuration		= runner.GetDuration().InSeconds();
+			job.mNumUpdates		= runner.GetNumUpdates();
+
+			// node errors are reported with the recording, the outputs may be incomplete
+			const uint32 numNodes = classifier->GetNumNodes();
+			for (uint32 i=0; i<numNodes; ++i)
+			{
+				Node* node = classifier->GetNode(i);
+				const uint32 numErrors = node->GetNumErrors();
+				for (uint32 e=0; e<numErrors; ++e)
+					job.mNodeErrors.push_back(std::string(node->GetName()) + " (" + node->GetReadableType() + "): " + node->GetError(e).mMessage.AsChar());
+			}
+		}
+	}
+
+	EngineInitializer::DestroyInstance(engine);
+
+	job.mWallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	std::lock_guard<std::mutex> lock(gConsoleMutex);
+	printf("%-32s %s  %10.1f s simulated  %8.3f s wall time  %8.1fx real-time  %i updates\n", job.mName.c_str(), (job.mSuccess == true ? "ok    " : "FAILED"),
+		job.mDuration, job.mWallTime, (job.mWallTime > 0.0 ? job.mDuration / job.mWallTime : 0.0), job.mNumUpdates);
+
+	for (const std::string& nodeError : job.mNodeErrors)
+		printf("    node error: %s\n", nodeError.c_str());
+}
+
+
+int main(int argc, char** argv)
+{
+	Settings settings;
+	if (ParseArguments(argc, argv, settings) == false)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	std::vector<Job> jobs;
+	if (CollectJobs(settings, jobs) == false)
+		return 1;
+
+	if (jobs.empty() == true)
+	{
+		printf("No recordings (.edf, .csv) found in '%s'.\n", settings.mInputDirectory);
+		return 1;
+	}
+
+	std::error_code error;
+	fs::create_directories(settings.mOutputDirectory, error);
+	if (error)
+	{
+		printf("Cannot create output directory '%s'.\n", settings.mOutputDirectory);
+		return 1;
+	}
+
+	// the default engine serves threads that are not bound to one of the job instances
+	if (EngineInitializer::Init() == false)
+	{
+		printf("Failed to initialize the engine.\n");
+		return 1;
+	}
+
+	uint32 numJobs = settings.mNumJobs;
+	if (numJobs == 0)
+		numJobs = Max<uint32>(1, std::thread::hardware_concurrency());
+	numJobs = Min<uint32>(numJobs, (uint32)jobs.size());
+
+	printf("Classifier:    %s\n", settings.mClassifierFile);
+	printf("Recordings:    %i (%i in parallel, %.3f s steps)\n", (uint32)jobs.size(), numJobs, settings.mStepSize);
+
+	// every worker takes the next unprocessed recording until none are left
+	const auto startTime = std::chrono::steady_clock::now();
+
+	std::atomic<uint32> nextJob(0);
+	std::vector<std::thread> workers;
+	for (uint32 i=0; i<numJobs; ++i)
+	{
+		workers.emplace_back([&]()
+		{
+			for (uint32 index = nextJob++; index < jobs.size(); index = nextJob++)
+				ProcessJob(settings, jobs[index]);
+		});
+	}
+
+	for (std::thread& worker : workers)
+		worker.join();
+
+	const double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	// report
+	uint32 numFailed = 0;
+	double simulatedTime = 0.0;
+	for (const Job& job : jobs)
+	{
+		simulatedTime += job.mDuration;
+		if (job.mSuccess == false)
+			numFailed++;
+	}
+
+	printf("Total:         %i ok, %i failed, %.1f s simulated, %.3f s wall time, %.1fx real-time\n", (uint32)jobs.size() - numFailed, numFailed, simulatedTime, wallTime, (wallTime > 0.0 ? simulatedTime / wallTime : 0.0));
+
+	EngineInitializer::Shutdown();
+	return (numFailed == 0 ? 0 : 1);
+}
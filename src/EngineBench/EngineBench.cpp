@@ -0,0 +1,389 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// headless engine benchmark: runs a classifier faster than real-time and reports latency, throughput and memory statistics
+//
+// usage: EngineBench [options] <classifier.json>
+//   -frames <n>       number of measured engine updates (default 3600)
+//   -warmup <n>       number of updates before measuring (default 60)
+//   -fps <hz>         simulated update rate, sets the time delta of each update (default 60)
+//   -input <file>     replay a recording through all file reader nodes of the classifier
+//   -samplerate <hz>  sample rate of the synthetic test device (default 128, 0 = no test device)
+//   -trace <file>     profile the nodes and write the last frames as trace event JSON
+//
+// usage: EngineBench -strings <n>
+//   runs the string micro benchmark (n iterations per case) instead of a classifier
+
+// include required headers
+#include <Config.h>
+#include <EngineManager.h>
+#include <Core/LogManager.h>
+#include <Core/LogCallbacks.h>
+#include <Graph/Classifier.h>
+#include <Graph/GraphImporter.h>
+#include <Graph/FileReaderNode.h>
+#include <Devices/DeviceInventory.h>
+#include <Devices/Test/TestDevice.h>
+#include <Devices/Test/TestDeviceDriver.h>
+#include "StringBenchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	#include <windows.h>
+	#include <psapi.h>
+	#pragma comment(lib, "Psapi.lib")			// winapi: process memory info
+	#pragma comment(lib, "Ws2_32.lib")			// winapi: sockets
+	#pragma comment(lib, "winmm.lib")			// winapi: multimedia
+#else
+	#include <sys/resource.h>
+#endif
+
+using namespace Core;
+
+
+// benchmark settings
+struct Settings
+{
+	const char*	mClassifierFile	= NULL;
+	const char*	mInputFile		= NULL;
+	const char*	mTraceFile		= NULL;
+	uint32		mNumFrames		= 3600;
+	uint32		mNumWarmupFrames= 60;
+	double		mFps			= 60.0;
+	uint32		mSampleRate		= 128;
+	uint32		mNumStringIterations = 0;
+};
+
+
+// prints engine warnings and errors to the console
+class ConsoleLogCallback : public LogCallback
+{
+	public:
+		enum { TYPE_ID = 0xBE0C4 };
+		uint32 GetType() const override											{ return TYPE_ID; }
+
+		void Log(const char* text, ELogLevel logLevel) override
+		{
+			switch (logLevel)
+			{
+				case LOGLEVEL_CRITICAL:	fprintf(stderr, "[CRITICAL]: %s\n", text);	break;
+				case LOGLEVEL_ERROR:	fprintf(stderr, "[ERROR]: %s\n", text);	break;
+				case LOGLEVEL_WARNING:	fprintf(stderr, "[WARNING]: %s\n", text);	break;
+				default:																break;
+			}
+		}
+};
+
+
+// peak resident memory of the process in bytes
+static uint64 GetPeakMemoryUsage()
+{
+#ifdef NEUROMORE_PLATFORM_WINDOWS
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0)
+		return 0;
+
+	return counters.PeakWorkingSetSize;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+
+	#ifdef NEUROMORE_PLATFORM_OSX
+		return usage.ru_maxrss;				// bytes on macOS
+	#else
+		return usage.ru_maxrss * 1024ull;	// kilobytes on linux
+	#endif
+#endif
+}
+
+
+// collect the distinct output channels of a node (multi channel ports share the channels of the single ports)
+static void CollectOutputChannels(Node* node, Array<ChannelBase*>& outChannels)
+{
+	const uint32 numPorts = node->GetNumOutputPorts();
+	for (uint32 p=0; p<numPorts; ++p)
+	{
+		MultiChannel* channels = node->GetOutputPort(p).GetChannels();
+		if (channels == NULL)
+			continue;
+
+		const uint32 numChannels = channels->GetNumChannels();
+		for (uint32 c=0; c<numChannels; ++c)
+		{
+			ChannelBase* channel = channels->GetChannel(c);
+			if (outChannels.Contains(channel) == false)
+				outChannels.Add(channel);
+		}
+	}
+}
+
+
+// number of new samples produced by the input and device input nodes during the last update
+static uint64 CalcNumInputSamples(Classifier* classifier, Array<ChannelBase*>& tempChannels)
+{
+	tempChannels.Clear(false);
+
+	const uint32 numInputNodes = classifier->GetNumInputNodes();
+	for (uint32 i=0; i<numInputNodes; ++i)
+		CollectOutputChannels(classifier->GetInputNode(i), tempChannels);
+
+	const uint32 numDeviceInputNodes = classifier->GetNumDeviceInputNodes();
+	for (uint32 i=0; i<numDeviceInputNodes; ++i)
+		CollectOutputChannels(classifier->GetDeviceInputNode(i), tempChannels);
+
+	uint64 numSamples = 0;
+	const uint32 numChannels = tempChannels.Size();
+	for (uint32 i=0; i<numChannels; ++i)
+		numSamples += tempChannels[i]->GetNumNewSamples();
+
+	return numSamples;
+}
+
+
+// value at the given percentile of a sorted array
+static double GetPercentile(const std::vector<double>& sorted, double percentile)
+{
+	if (sorted.empty() == true)
+		return 0.0;
+
+	const size_t index = (size_t)(percentile / 100.0 * (sorted.size() - 1) + 0.5);
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+
+
+static void PrintUsage()
+{
+	printf("usage: EngineBench [options] <classifier.json>\n");
+	printf("  -frames <n>       number of measured engine updates (default 3600)\n");
+	printf("  -warmup <n>       number of updates before measuring (default 60)\n");
+	printf("  -fps <hz>         simulated update rate (default 60)\n");
+	printf("  -input <file>     replay a recording through all file reader nodes\n");
+	printf("  -samplerate <hz>  sample rate of the synthetic test device (default 128, 0 = none)\n");
+	printf("  -trace <file>     write a per-node trace of the last frames (trace event JSON)\n");
+	printf("usage: EngineBench -strings <n>\n");
+	printf("  run the string micro benchmark with n iterations per case\n");
+}
+
+
+static bool ParseArguments(int argc, char** argv, Settings& settings)
+{
+	for (int i=1; i<argc; ++i)
+	{
+		const char* arg = argv[i];
+		const bool hasValue = (i+1 < argc);
+
+		if		(strcmp(arg, "-frames") == 0 && hasValue)		settings.mNumFrames			= atoi(argv[++i]);
+		else if (strcmp(arg, "-warmup") == 0 && hasValue)		settings.mNumWarmupFrames	= atoi(argv[++i]);
+		else if (strcmp(arg, "-fps") == 0 && hasValue)			settings.mFps				= atof(argv[++i]);
+		else if (strcmp(arg, "-input") == 0 && hasValue)		settings.mInputFile			= argv[++i];
+		else if (strcmp(arg, "-samplerate") == 0 && hasValue)	settings.mSampleRate		= atoi(argv[++i]);
+		else if (strcmp(arg, "-trace") == 0 && hasValue)		settings.mTraceFile			= argv[++i];
+		else if (strcmp(arg, "-strings") == 0 && hasValue)		settings.mNumStringIterations = atoi(argv[++i]);
+		else if (arg[0] != '-' && settings.mClassifierFile == NULL)	settings.mClassifierFile	= arg;
+		else
+			return false;
+	}
+
+	if (settings.mNumStringIterations > 0)
+		return true;
+
+	return (settings.mClassifierFile != NULL && settings.mNumFrames > 0 && settings.mFps > 0.0);
+}
+
+
+// load the classifier and activate it
+static Classifier* LoadClassifier(const Settings& settings)
+{
+	Classifier* classifier = new Classifier();
+	if (GraphImporter::LoadFromFile(settings.mClassifierFile, classifier) == false)
+	{
+		LogError("Cannot load classifier '%s'.", settings.mClassifierFile);
+		delete classifier;
+		return NULL;
+	}
+
+	classifier->CollectNodes();
+
+	// point all file reader nodes to the recording
+	if (settings.mInputFile != NULL)
+	{
+		const uint32 numNodes = classifier->GetNumNodes();
+		for (uint32 i=0; i<numNodes; ++i)
+		{
+			Node* node = classifier->GetNode(i);
+			if (node->GetType() != FileReaderNode::TYPE_ID)
+				continue;
+
+			node->SetStringAttributeByIndex(FileReaderNode::ATTRIB_URL, settings.mInputFile);
+			node->OnAttributesChanged();
+		}
+	}
+
+	GetEngine()->LoadGraph(classifier);
+	return classifier;
+}
+
+
+int main(int argc, char** argv)
+{
+	Settings settings;
+	if (ParseArguments(argc, argv, settings) == false)
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	// initialize the engine without any user interface
+	if (EngineInitializer::Init() == false)
+	{
+		printf("Failed to initialize the engine.\n");
+		return 1;
+	}
+
+	CORE_LOGMANAGER.AddLogCallback(new ConsoleLogCallback());
+
+	// string micro benchmark
+	if (settings.mNumStringIterations > 0)
+	{
+		Array<StringBenchmark::Result> results;
+		StringBenchmark::Run(settings.mNumStringIterations, results);
+
+		const uint32 numResults = results.Size();
+		for (uint32 i=0; i<numResults; ++i)
+			printf("Strings:       %-24s %10i ops %9.3f ms %8.1f ns/op\n", results[i].mName.AsChar(), results[i].mNumOperations, results[i].mSeconds * 1000.0, results[i].GetNanoSecondsPerOperation());
+
+		EngineInitializer::Shutdown();
+		return 0;
+	}
+
+	GetEngine()->SetIsRunning(true);
+	GetEngine()->SetAutoSyncSetting(false);
+	DeviceInventory::RegisterDevices(true);
+	GetDeviceManager()->SetRemoveInactiveDevicesEnabled(false);
+
+	// synthetic EEG source for the device input nodes
+	if (settings.mSampleRate > 0)
+	{
+		TestDeviceDriver* driver = new TestDeviceDriver();
+		driver->SetEnabled(true);
+		GetDeviceManager()->AddDeviceDriver(driver);
+		GetDeviceManager()->AddDevice(new TestDevice(driver, settings.mSampleRate));
+	}
+
+	Classifier* classifier = LoadClassifier(settings);
+	if (classifier == NULL)
+	{
+		EngineInitializer::Shutdown();
+		return 1;
+	}
+
+	NodeProfiler* profiler = GetEngine()->GetNodeProfiler();
+	profiler->SetEnabled(settings.mTraceFile != NULL);
+
+	GetEngine()->Reset();
+
+	const Time delta = 1.0 / settings.mFps;
+
+	// warm up (buffers are resized and nodes initialize during the first updates)
+	for (uint32 i=0; i<settings.mNumWarmupFrames; ++i)
+		GetEngine()->Update(delta);
+
+	// measured run
+	std::vector<double> frameTimes;
+	frameTimes.reserve(settings.mNumFrames);
+
+	uint64 numInputSamples		= 0;
+	uint64 numAllocations		= 0;
+	uint32 maxBufferMemory		= 0;
+	Array<ChannelBase*> inputChannels;
+
+	const auto startTime = std::chrono::steady_clock::now();
+	for (uint32 i=0; i<settings.mNumFrames; ++i)
+	{
+		const uint64 allocationsBefore = gNumThreadAllocations;
+		const auto frameStart = std::chrono::steady_clock::now();
+
+		{
+			// measured frames count as real-time, so the heap statistics show which subsystem allocates
+			RealtimeScope realtime;
+			GetEngine()->Update(delta);
+		}
+
+		const auto frameEnd = std::chrono::steady_clock::now();
+		frameTimes.push_back(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+		numAllocations += gNumThreadAllocations - allocationsBefore;
+
+		numInputSamples += CalcNumInputSamples(classifier, inputChannels);
+		maxBufferMemory = Max(maxBufferMemory, classifier->CalculateBufferMemoryAllocated());
+	}
+	const double wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	// report
+	std::vector<double> sorted = frameTimes;
+	std::sort(sorted.begin(), sorted.end());
+
+	double sum = 0.0;
+	for (double t : frameTimes)
+		sum += t;
+
+	const double simulatedTime = settings.mNumFrames / settings.mFps;
+
+	printf("Classifier:    %s (%i nodes)\n", settings.mClassifierFile, classifier->GetNumNodes());
+	printf("Frames:        %i (%.1f s simulated at %.1f Hz, %.3f s wall time, %.1fx real-time)\n", settings.mNumFrames, simulatedTime, settings.mFps, wallTime, (wallTime > 0.0 ? simulatedTime / wallTime : 0.0));
+	printf("Frame latency: mean %.4f ms / p50 %.4f ms / p90 %.4f ms / p99 %.4f ms / p99.9 %.4f ms / max %.4f ms\n",
+		sum / frameTimes.size(), GetPercentile(sorted, 50.0), GetPercentile(sorted, 90.0), GetPercentile(sorted, 99.0), GetPercentile(sorted, 99.9), sorted.back());
+	printf("Throughput:    %llu input samples, %.0f samples/s\n", numInputSamples, (wallTime > 0.0 ? numInputSamples / wallTime : 0.0));
+	printf("Memory:        peak %.2f MB resident, peak %.2f KB classifier buffers, %.2f allocations/frame\n", GetPeakMemoryUsage() / (1024.0 * 1024.0), maxBufferMemory / 1024.0, (double)numAllocations / settings.mNumFrames);
+
+	// live heap and allocations of the measured frames per subsystem
+	for (uint32 i=0; i<NUM_MEMORYTAGS; ++i)
+	{
+		const MemoryStatistics stats = GetMemoryStatistics((EMemoryTag)i);
+		printf("Heap:          %-10s %10.2f KB live in %lli blocks, %.2f allocations/frame\n", GetMemoryTagName((EMemoryTag)i), stats.mNumLiveBytes / 1024.0, stats.mNumLiveAllocations, (double)stats.mNumRealtimeAllocations / settings.mNumFrames);
+	}
+
+	// list node errors, the numbers are meaningless if a part of the graph was not running
+	const uint32 numNodes = classifier->GetNumNodes();
+	for (uint32 i=0; i<numNodes; ++i)
+	{
+		Node* node = classifier->GetNode(i);
+		const uint32 numErrors = node->GetNumErrors();
+		for (uint32 e=0; e<numErrors; ++e)
+			printf("Node error:    %s (%s): %s\n", node->GetName(), node->GetReadableType(), node->GetError(e).mMessage.AsChar());
+	}
+
+	// per node trace
+	if (settings.mTraceFile != NULL)
+	{
+		if (profiler->ExportTrace(settings.mTraceFile) == true)
+			printf("Trace:         %s (last %i frames)\n", settings.mTraceFile, profiler->GetNumFrames());
+		else
+			printf("Trace:         cannot write '%s'\n", settings.mTraceFile);
+	}
+
+	EngineInitializer::Shutdown();
+	return 0;
+}
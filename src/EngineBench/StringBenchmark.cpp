@@ -0,0 +1,150 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "StringBenchmark.h"
+#include <Core/FpsCounter.h>
+#include <Core/Timer.h>
+
+using namespace Core;
+
+
+// run all cases
+void StringBenchmark::Run(uint32 numIterations, Array<Result>& outResults)
+{
+	outResults.Clear();
+
+	Result result;
+
+	result.mName = "CSV formatting";
+	result.mSeconds = RunCsvFormatting(numIterations, &result.mNumOperations);
+	outResults.Add(result);
+
+	result.mName = "OSC address building";
+	result.mSeconds = RunOscAddressBuilding(numIterations, &result.mNumOperations);
+	outResults.Add(result);
+
+	result.mName = "FpsCounter text";
+	result.mSeconds = RunFpsCounterText(numIterations, &result.mNumOperations);
+	outResults.Add(result);
+}
+
+
+// ChannelFileWriter::WriteSamples: one line per sample with a timestamp and one value per channel
+double StringBenchmark::RunCsvFormatting(uint32 numIterations, uint32* outNumOperations)
+{
+	const uint32 numChannels	= 8;
+	const uint32 numDigits		= 6;
+
+	Timer timer;
+	timer.GetTimeDelta();
+
+	String tempString;
+	String line;
+	uint32 checksum = 0;
+	for (uint32 i=0; i<numIterations; ++i)
+	{
+		line.Clear();
+
+		tempString.Format("%.9f", i / 250.0);
+		line += tempString;
+		line += ',';
+
+		for (uint32 c=0; c<numChannels; ++c)
+		{
+			tempString.Format("%.*f", numDigits, (c+1) * 12.345 + i * 0.001);
+			line += tempString;
+
+			if (c < numChannels - 1)
+				line += ',';
+		}
+
+		checksum += line.GetLength();
+	}
+
+	const double seconds = timer.GetTimeDelta().InSeconds();
+
+	*outNumOperations = numIterations * (numChannels + 1);
+	return (checksum > 0 ? seconds : 0.0);
+}
+
+
+// Device::SetDeviceId and the OSC nodes: short addresses formatted into new strings
+double StringBenchmark::RunOscAddressBuilding(uint32 numIterations, uint32* outNumOperations)
+{
+	Timer timer;
+	timer.GetTimeDelta();
+
+	Array<String> addresses;
+	addresses.Reserve(16);
+
+	uint32 checksum = 0;
+	for (uint32 i=0; i<numIterations; ++i)
+	{
+		addresses.Clear(false);
+
+		String deviceAddress;
+		deviceAddress.Format("/%s/%i/*", "eeg", i & 0xff);
+		addresses.Add(deviceAddress);
+
+		for (uint32 j=0; j<8; ++j)
+		{
+			String channelAddress;
+			channelAddress.Format("/out/%i", j);
+			addresses.Add(channelAddress);
+		}
+
+		checksum += addresses.Size();
+	}
+
+	const double seconds = timer.GetTimeDelta().InSeconds();
+
+	*outNumOperations = numIterations * 9;
+	return (checksum > 0 ? seconds : 0.0);
+}
+
+
+// FpsCounter::Update formats the text which the interface copies afterwards
+double StringBenchmark::RunFpsCounterText(uint32 numIterations, uint32* outNumOperations)
+{
+	// update the statistics on every call
+	FpsCounter counter(0.0);
+
+	Timer timer;
+	timer.GetTimeDelta();
+
+	uint32 checksum = 0;
+	for (uint32 i=0; i<numIterations; ++i)
+	{
+		counter.BeginTiming();
+		counter.StopTiming();
+
+		const String text = counter.GetTextString();
+		checksum += text.GetLength();
+	}
+
+	const double seconds = timer.GetTimeDelta().InSeconds();
+
+	*outNumOperations = numIterations;
+	return (checksum > 0 ? seconds : 0.0);
+}
@@ -0,0 +1,59 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_STRINGBENCHMARK_H
+#define __NEUROMORE_STRINGBENCHMARK_H
+
+// include required headers
+#include <Core/StandardHeaders.h>
+#include <Core/Array.h>
+#include <Core/String.h>
+
+
+// micro benchmark of the string patterns that run in the engine's hot paths
+//  - CSV formatting like the ChannelFileWriter (timestamp + one formatted value per channel and line)
+//  - OSC address building like the devices and OSC nodes (short strings created and formatted on the fly)
+//  - FpsCounter text updates and copies of the text
+class StringBenchmark
+{
+	public:
+		struct Result
+		{
+			Core::String	mName;
+			uint32			mNumOperations;
+			double			mSeconds;
+
+			double GetNanoSecondsPerOperation() const								{ return (mNumOperations > 0 ? mSeconds * 1e9 / mNumOperations : 0.0); }
+		};
+
+		// run all cases
+		static void Run(uint32 numIterations, Core::Array<Result>& outResults);
+
+	private:
+		static double RunCsvFormatting(uint32 numIterations, uint32* outNumOperations);
+		static double RunOscAddressBuilding(uint32 numIterations, uint32* outNumOperations);
+		static double RunFpsCounterText(uint32 numIterations, uint32* outNumOperations);
+};
+
+
+#endif
@@ -41,100 +41,100 @@ public class Wrapper
     // Engine initialization
     ///////////////////////////////////////////////////////////////////////////////////////////////
 
-    public static native boolean SetPowerLineFrequencyType(int powerLineFrequencyType);
-    public static native double GetPowerLineFrequency();
-    public static native boolean SetBufferLength(double seconds);
-    public static native void Init(ICallback callback);
-    public static native boolean IsInitialized();
-    public static native void Shutdown();
+    public static native boolean SetPowerLineFrequencyType(long handle, int powerLineFrequencyType);
+    public static native double GetPowerLineFrequency(long handle);
+    public static native boolean SetBufferLength(long handle, double seconds);
+    public static native long Init(ICallback callback);   // returns the engine handle, 0 on failure
+    public static native boolean IsInitialized(long handle);
+    public static native void Shutdown(long handle);
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // Engine basics: Start, Stop, Cleanup, Update etc
     ///////////////////////////////////////////////////////////////////////////////////////////////
 
-    public static native boolean IsReady();
-    public static native void SetSessionLength(double seconds);
-    public static native boolean Start();
-    public static native boolean StartThreaded();
-    public static native boolean Update();
-    public static native boolean IsRunning();
-    public static native boolean Stop();
-    public static native boolean StopThreaded();
-    public static native void Reset();
+    public static native boolean IsReady(long handle);
+    public static native void SetSessionLength(long handle, double seconds);
+    public static native boolean Start(long handle);
+    public static native boolean StartThreaded(long handle);
+    public static native boolean Update(long handle);
+    public static native boolean IsRunning(long handle);
+    public static native boolean Stop(long handle);
+    public static native boolean StopThreaded(long handle);
+    public static native void Reset(long handle);
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // Helpers
     ///////////////////////////////////////////////////////////////////////////////////////////////
 
-    public static native void EnableDebugLogging();
-    public static native void SetAllowAssetStreaming(boolean allow);
+    public static native void EnableDebugLogging(long handle);
+    public static native void SetAllowAssetStreaming(long handle, boolean allow);
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // Devices
     ///////////////////////////////////////////////////////////////////////////////////////////////
 
-    public static native int AddDevice(int deviceType);  // use EDevice
-    public static native int GetNumDevices();
-    public static native boolean RemoveDevice(int deviceIndex);
-    public static native int GetDevice(int deviceIndex);     // returns EDevice
-    public static native boolean HasDevice(int deviceType);  // use EDevice
-    public static native boolean ConnectDevice(int deviceIndex);
-    public static native boolean DisconnectDevice(int deviceIndex);
-    public static native int GetNumInputs(int deviceIndex);
-    public static native boolean AddInputSample(int deviceIndex, int inputIndex, double value);
-    public static native boolean SetBatteryChargeLevel(int deviceIndex, double normalizedCharge);
+    public static native int AddDevice(long handle, int deviceType);  // use EDevice
+    public static native int GetNumDevices(long handle);
+    public static native boolean RemoveDevice(long handle, int deviceIndex);
+    public static native int GetDevice(long handle, int deviceIndex);     // returns EDevice
+    public static native boolean HasDevice(long handle, int deviceType);  // use EDevice
+    public static native boolean ConnectDevice(long handle, int deviceIndex);
+    public static native boolean DisconnectDevice(long handle, int deviceIndex);
+    public static native int GetNumInputs(long handle, int deviceIndex);
+    public static native boolean AddInputSample(long handle, int deviceIndex, int inputIndex, double value);
+    public static native boolean SetBatteryChargeLevel(long handle, int deviceIndex, double normalizedCharge);
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // Classifier
     ///////////////////////////////////////////////////////////////////////////////////////////////
 
-    public static native boolean LoadClassifier(String jsonContent, String uuid, int revision);
-    public static native boolean HasClassifier();
-    public static native boolean IsDeviceRequiredByClassifier(int deviceType); // use EDevice
-    public static native int GetNumFeedbacks();
-    public static native String GetFeedbackName(int index);
-    public static native double GetCurrentFeedbackValue(int index);
-    //public static native void GetFeedbackRange();
+    public static native boolean LoadClassifier(long handle, String jsonContent, String uuid, int revision);
+    public static native boolean HasClassifier(long handle);
+    public static native boolean IsDeviceRequiredByClassifier(long handle, int deviceType); // use EDevice
+    public static native int GetNumFeedbacks(long handle);
+    public static native String GetFeedbackName(long handle, int index);
+    public static native double GetCurrentFeedbackValue(long handle, int index);
+    //public static native void GetFeedbackRange(long handle);
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // Cloud Data Serialization
     ///////////////////////////////////////////////////////////////////////////////////////////////
 
-    public static native String GetCreateDataChunkJson(String userId, String experienceUuid, int experienceRevision);
-    public static native int GetNumDataChunkChannels();
-    public static native String GetDataChunkChannelJson(String userId, String dataChunkUuid, int channelIndex);
-    public static native byte[] GetDataChunkChannelData(int channelIndex);
+    public static native String GetCreateDataChunkJson(long handle, String userId, String experienceUuid, int experienceRevision);
+    public static native int GetNumDataChunkChannels(long handle);
+    public static native String GetDataChunkChannelJson(long handle, String userId, String dataChunkUuid, int channelIndex);
+    public static native byte[] GetDataChunkChannelData(long handle, int channelIndex);
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // Classifier Cloud Parameters
     ///////////////////////////////////////////////////////////////////////////////////////////////
 
-    public static native String CreateJSONRequestFindParameters(String userId);
-    public static native boolean HandleJSONReplyFindParameters(String jsonString, String userId);
-    public static native String CreateJSONRequestSetParameters();
+    public static native String CreateJSONRequestFindParameters(long handle, String userId);
+    public static native boolean HandleJSONReplyFindParameters(long handle, String jsonString, String userId);
+    public static native String CreateJSONRequestSetParameters(long handle);
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // State Machine
     ///////////////////////////////////////////////////////////////////////////////////////////////
 
-    public static native boolean LoadStateMachine(String jsonContent, String uuid, int revision);
-    public static native boolean HasStateMachine();
+    public static native boolean LoadStateMachine(long handle, String jsonContent, String uuid, int revision);
+    public static native boolean HasStateMachine(long handle);
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
     // Multimedia Assets
     ///////////////////////////////////////////////////////////////////////////////////////////////
 
-    public static native int GetNumAssetsOfType(int assetType); // use EAssetType
-    public static native String GetAssetLocationOfType(int assetType, int index); // use EAssetType
-    public static native boolean GetAssetAllowStreamingOfType(int assetType, int index); // use EAssetType
+    public static native int GetNumAssetsOfType(long handle, int assetType); // use EAssetType
+    public static native String GetAssetLocationOfType(long handle, int assetType, int index); // use EAssetType
+    public static native boolean GetAssetAllowStreamingOfType(long handle, int assetType, int index); // use EAssetType
 
-    public static native int GetNumAssets();
-    public static native String GetAssetLocation(int index);
-    public static native boolean GetAssetAllowStreaming(int index);
+    public static native int GetNumAssets(long handle);
+    public static native String GetAssetLocation(long handle, int index);
+    public static native boolean GetAssetAllowStreaming(long handle, int index);
 
-    public static native boolean ButtonClicked(int buttonId);
-    public static native boolean AudioLooped(String url);
-    public static native boolean VideoLooped(String url);
+    public static native boolean ButtonClicked(long handle, int buttonId);
+    public static native boolean AudioLooped(long handle, String url);
+    public static native boolean VideoLooped(long handle, String url);
 
     ///////////////////////////////////////////////////////////////////////////////////////////////
 }
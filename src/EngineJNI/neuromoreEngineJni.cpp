@@ -368,10 +368,6 @@ public:
    }
 };
 
-// stores an instance of our callback implementation
-// note: this is destroyed by the neuromore shutdown.
-static JNICallback* callback;
-
 /***********************************************************************************************************************************************************************/
 /********************************************************************    JNI API     ***********************************************************************************/
 /***********************************************************************************************************************************************************************/
@@ -398,185 +394,181 @@ extern "C"
    // Engine initialization
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_SetPowerLineFrequencyType(JNIEnv* env, jobject thiz, jint powerLineFrequencyType)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_SetPowerLineFrequencyType(JNIEnv* env, jobject thiz, jlong handle, jint powerLineFrequencyType)
    {
-      return neuromoreEngine::SetPowerLineFrequencyType((neuromoreEngine::EPowerLineFrequencyType)powerLineFrequencyType);
+      return neuromoreEngine::SetPowerLineFrequencyType((neuromoreEngine::EngineHandle)handle, (neuromoreEngine::EPowerLineFrequencyType)powerLineFrequencyType);
    }
 
-   JNIEXPORT jdouble JNICALL Java_com_neuromore_engine_Wrapper_GetPowerLineFrequency(JNIEnv* env, jobject thiz)
+   JNIEXPORT jdouble JNICALL Java_com_neuromore_engine_Wrapper_GetPowerLineFrequency(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::GetPowerLineFrequency();
+      return neuromoreEngine::GetPowerLineFrequency((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_SetBufferLength(JNIEnv* env, jobject thiz, jdouble seconds)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_SetBufferLength(JNIEnv* env, jobject thiz, jlong handle, jdouble seconds)
    {
-      return neuromoreEngine::SetBufferLength(seconds);
+      return neuromoreEngine::SetBufferLength((neuromoreEngine::EngineHandle)handle, seconds);
    }
 
-   JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_Init(JNIEnv* env, jobject thiz, jobject jcallback)
+   JNIEXPORT jlong JNICALL Java_com_neuromore_engine_Wrapper_Init(JNIEnv* env, jobject thiz, jobject jcallback)
    {
-      // no need to init twice
-      if (neuromoreEngine::IsInitialized())
-         return;
-
-      neuromoreEngine::Init();
+      // every call creates a new engine instance, the returned handle is passed to all other calls
+      neuromoreEngine::EngineHandle handle = neuromoreEngine::Init();
 
       // init didn't work :(
-      if (!neuromoreEngine::IsInitialized())
-         return;
+      if (!neuromoreEngine::IsInitialized(handle))
+         return 0;
 
       // create a callback handler and set it
-      callback = new JNICallback(env, jcallback);
-      neuromoreEngine::SetCallback(callback);
+      // note: the instance owns it and destroys it on shutdown
+      JNICallback* callback = new JNICallback(env, jcallback);
+      neuromoreEngine::SetCallback(handle, callback);
 
       // log
       callback->OnLog("Initialization successful");
+
+      return (jlong)handle;
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_IsInitialized(JNIEnv* env, jobject thiz)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_IsInitialized(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::IsInitialized();
+      return neuromoreEngine::IsInitialized((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_Shutdown(JNIEnv* env, jobject thiz)
+   JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_Shutdown(JNIEnv* env, jobject thiz, jlong handle)
    {
-      if (!neuromoreEngine::IsInitialized())
+      if (!neuromoreEngine::IsInitialized((neuromoreEngine::EngineHandle)handle))
          return;
 
-      // this is going to be destroyed by shutdown,
-      // so make sure we forget it
-      callback = NULL;
-
-      neuromoreEngine::Shutdown();
+      neuromoreEngine::Shutdown((neuromoreEngine::EngineHandle)handle);
    }
 
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    // Engine basics: Start, Stop, Cleanup, Update etc
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_IsReady(JNIEnv* env, jobject thiz)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_IsReady(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::IsReady();
+      return neuromoreEngine::IsReady((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_SetSessionLength(JNIEnv* env, jobject thiz, jdouble seconds)
+   JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_SetSessionLength(JNIEnv* env, jobject thiz, jlong handle, jdouble seconds)
    {
-      neuromoreEngine::SetSessionLength(seconds);
+      neuromoreEngine::SetSessionLength((neuromoreEngine::EngineHandle)handle, seconds);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_Start(JNIEnv* env, jobject thiz)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_Start(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::Start();
+      return neuromoreEngine::Start((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_StartThreaded(JNIEnv* env, jobject thiz)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_StartThreaded(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::StartThreaded();
+      return neuromoreEngine::StartThreaded((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_Update(JNIEnv* env, jobject thiz)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_Update(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::Update();
+      return neuromoreEngine::Update((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_IsRunning(JNIEnv* env, jobject thiz)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_IsRunning(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::IsRunning();
+      return neuromoreEngine::IsRunning((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_Stop(JNIEnv* env, jobject thiz)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_Stop(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::Stop();
+      return neuromoreEngine::Stop((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_StopThreaded(JNIEnv* env, jobject thiz)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_StopThreaded(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::StopThreaded();
+      return neuromoreEngine::StopThreaded((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_Reset(JNIEnv* env, jobject thiz)
+   JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_Reset(JNIEnv* env, jobject thiz, jlong handle)
    {
-      neuromoreEngine::Reset();
+      neuromoreEngine::Reset((neuromoreEngine::EngineHandle)handle);
    }
 
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    // Helpers
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-   JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_EnableDebugLogging(JNIEnv* env, jobject thiz)
+   JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_EnableDebugLogging(JNIEnv* env, jobject thiz, jlong handle)
    {
-      neuromoreEngine::EnableDebugLogging();
+      neuromoreEngine::EnableDebugLogging((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_SetAllowAssetStreaming(JNIEnv* env, jobject thiz, jboolean allow)
+   JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_SetAllowAssetStreaming(JNIEnv* env, jobject thiz, jlong handle, jboolean allow)
    {
-      neuromoreEngine::SetAllowAssetStreaming(allow);
+      neuromoreEngine::SetAllowAssetStreaming((neuromoreEngine::EngineHandle)handle, allow);
    }
 
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    // Devices
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_AddDevice(JNIEnv* env, jobject thiz, jint deviceType)
+   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_AddDevice(JNIEnv* env, jobject thiz, jlong handle, jint deviceType)
    {
-      return neuromoreEngine::AddDevice((neuromoreEngine::EDevice)deviceType);
+      return neuromoreEngine::AddDevice((neuromoreEngine::EngineHandle)handle, (neuromoreEngine::EDevice)deviceType);
    }
 
-   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetNumDevices(JNIEnv* env, jobject thiz)
+   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetNumDevices(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::GetNumDevices();
+      return neuromoreEngine::GetNumDevices((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_RemoveDevice(JNIEnv* env, jobject thiz, jint deviceIndex)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_RemoveDevice(JNIEnv* env, jobject thiz, jlong handle, jint deviceIndex)
    {
-      return neuromoreEngine::RemoveDevice(deviceIndex);
+      return neuromoreEngine::RemoveDevice((neuromoreEngine::EngineHandle)handle, deviceIndex);
    }
 
-   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetDevice(JNIEnv* env, jobject thiz, jint deviceIndex)
+   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetDevice(JNIEnv* env, jobject thiz, jlong handle, jint deviceIndex)
    {
-      return neuromoreEngine::GetDevice(deviceIndex);
+      return neuromoreEngine::GetDevice((neuromoreEngine::EngineHandle)handle, deviceIndex);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_HasDevice(JNIEnv* env, jobject thiz, jint deviceType)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_HasDevice(JNIEnv* env, jobject thiz, jlong handle, jint deviceType)
    {
-      return neuromoreEngine::HasDevice((neuromoreEngine::EDevice)deviceType);
+      return neuromoreEngine::HasDevice((neuromoreEngine::EngineHandle)handle, (neuromoreEngine::EDevice)deviceType);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_ConnectDevice(JNIEnv* env, jobject thiz, jint deviceIndex)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_ConnectDevice(JNIEnv* env, jobject thiz, jlong handle, jint deviceIndex)
    {
-      return neuromoreEngine::ConnectDevice(deviceIndex);
+      return neuromoreEngine::ConnectDevice((neuromoreEngine::EngineHandle)handle, deviceIndex);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_DisconnectDevice(JNIEnv* env, jobject thiz, jint deviceIndex)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_DisconnectDevice(JNIEnv* env, jobject thiz, jlong handle, jint deviceIndex)
    {
-      return neuromoreEngine::DisonnectDevice(deviceIndex);
+      return neuromoreEngine::DisonnectDevice((neuromoreEngine::EngineHandle)handle, deviceIndex);
    }
 
-   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetNumInputs(JNIEnv* env, jobject thiz, jint deviceIndex)
+   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetNumInputs(JNIEnv* env, jobject thiz, jlong handle, jint deviceIndex)
    {
-      return neuromoreEngine::GetNumInputs(deviceIndex);
+      return neuromoreEngine::GetNumInputs((neuromoreEngine::EngineHandle)handle, deviceIndex);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_AddInputSample(JNIEnv* env, jobject thiz, jint deviceIndex, jint inputIndex, jdouble value)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_AddInputSample(JNIEnv* env, jobject thiz, jlong handle, jint deviceIndex, jint inputIndex, jdouble value)
    {
-      return neuromoreEngine::AddInputSample(deviceIndex, inputIndex, value);
+      return neuromoreEngine::AddInputSample((neuromoreEngine::EngineHandle)handle, deviceIndex, inputIndex, value);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_SetBatteryChargeLevel(JNIEnv* env, jobject thiz, jint deviceIndex, jdouble normalizedCharge)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_SetBatteryChargeLevel(JNIEnv* env, jobject thiz, jlong handle, jint deviceIndex, jdouble normalizedCharge)
    {
-      return neuromoreEngine::SetBatteryChargeLevel(deviceIndex, normalizedCharge);
+      return neuromoreEngine::SetBatteryChargeLevel((neuromoreEngine::EngineHandle)handle, deviceIndex, normalizedCharge);
    }
 
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    // Classifier
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_LoadClassifier(JNIEnv* env, jobject thiz, jstring jsonContent, jstring uuid, jint revision)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_LoadClassifier(JNIEnv* env, jobject thiz, jlong handle, jstring jsonContent, jstring uuid, jint revision)
    {
       const char* cstr_jsonContent = env->GetStringUTFChars(jsonContent, NULL);
       const char* cstr_uuid = env->GetStringUTFChars(uuid, NULL);
 
-      bool ok = neuromoreEngine::LoadClassifier(cstr_jsonContent, cstr_uuid, revision);
+      bool ok = neuromoreEngine::LoadClassifier((neuromoreEngine::EngineHandle)handle, cstr_jsonContent, cstr_uuid, revision);
 
       env->ReleaseStringUTFChars(jsonContent, cstr_jsonContent);
       env->ReleaseStringUTFChars(uuid, cstr_uuid);
@@ -584,47 +576,47 @@ extern "C"
       return ok;
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_HasClassifier(JNIEnv* env, jobject thiz)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_HasClassifier(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::HasClassifier();
+      return neuromoreEngine::HasClassifier((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_IsDeviceRequiredByClassifier(JNIEnv* env, jobject thiz, jint deviceType)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_IsDeviceRequiredByClassifier(JNIEnv* env, jobject thiz, jlong handle, jint deviceType)
    {
-      return neuromoreEngine::IsDeviceRequiredByClassifier((neuromoreEngine::EDevice)deviceType);
+      return neuromoreEngine::IsDeviceRequiredByClassifier((neuromoreEngine::EngineHandle)handle, (neuromoreEngine::EDevice)deviceType);
    }
 
-   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetNumFeedbacks(JNIEnv* env, jobject thiz)
+   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetNumFeedbacks(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::GetNumFeedbacks();
+      return neuromoreEngine::GetNumFeedbacks((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_GetFeedbackName(JNIEnv* env, jobject thiz, jint index)
+   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_GetFeedbackName(JNIEnv* env, jobject thiz, jlong handle, jint index)
    {
-      return env->NewStringUTF(neuromoreEngine::GetFeedbackName(index));
+      return env->NewStringUTF(neuromoreEngine::GetFeedbackName((neuromoreEngine::EngineHandle)handle, index));
    }
 
-   JNIEXPORT jdouble JNICALL Java_com_neuromore_engine_Wrapper_GetCurrentFeedbackValue(JNIEnv* env, jobject thiz, jint index)
+   JNIEXPORT jdouble JNICALL Java_com_neuromore_engine_Wrapper_GetCurrentFeedbackValue(JNIEnv* env, jobject thiz, jlong handle, jint index)
    {
-      return neuromoreEngine::GetCurrentFeedbackValue(index);
+      return neuromoreEngine::GetCurrentFeedbackValue((neuromoreEngine::EngineHandle)handle, index);
    }
 
-   /*JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_GetFeedbackRange(JNIEnv* env, jobject thiz, jint index, jdoubleArray values)
+   /*JNIEXPORT void JNICALL Java_com_neuromore_engine_Wrapper_GetFeedbackRange(JNIEnv* env, jobject thiz, jlong handle, jint index, jdoubleArray values)
    {
       env->doublearray
-      //neuromoreEngine::GetFeedbackRange(index, values, value);
+      //neuromoreEngine::GetFeedbackRange((neuromoreEngine::EngineHandle)handle, index, values, value);
    }*/
 
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    // Cloud Data Serialization
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_GetCreateDataChunkJson(JNIEnv* env, jobject thiz, jstring userId, jstring experienceUuid, jint experienceRevision)
+   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_GetCreateDataChunkJson(JNIEnv* env, jobject thiz, jlong handle, jstring userId, jstring experienceUuid, jint experienceRevision)
    {
       const char* cstr_userId = env->GetStringUTFChars(userId, NULL);
       const char* cstr_experienceUuid = env->GetStringUTFChars(experienceUuid, NULL);
 
-      const char* cstr_req = neuromoreEngine::GetCreateDataChunkJson(cstr_userId, cstr_experienceUuid, experienceRevision);
+      const char* cstr_req = neuromoreEngine::GetCreateDataChunkJson((neuromoreEngine::EngineHandle)handle, cstr_userId, cstr_experienceUuid, experienceRevision);
 
       env->ReleaseStringUTFChars(userId, cstr_userId);
       env->ReleaseStringUTFChars(experienceUuid, cstr_experienceUuid);
@@ -632,17 +624,17 @@ extern "C"
       return env->NewStringUTF(cstr_req);
    }
 
-   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetNumDataChunkChannels(JNIEnv* env, jobject thiz)
+   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetNumDataChunkChannels(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::GetNumDataChunkChannels();
+      return neuromoreEngine::GetNumDataChunkChannels((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_GetDataChunkChannelJson(JNIEnv* env, jobject thiz, jstring userId, jstring dataChunkUuid, jint channelIndex)
+   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_GetDataChunkChannelJson(JNIEnv* env, jobject thiz, jlong handle, jstring userId, jstring dataChunkUuid, jint channelIndex)
    {
       const char* cstr_userId = env->GetStringUTFChars(userId, NULL);
       const char* cstr_dataChunkUuid = env->GetStringUTFChars(dataChunkUuid, NULL);
 
-      const char* cstr_req = neuromoreEngine::GetDataChunkChannelJson(cstr_userId, cstr_dataChunkUuid, channelIndex);
+      const char* cstr_req = neuromoreEngine::GetDataChunkChannelJson((neuromoreEngine::EngineHandle)handle, cstr_userId, cstr_dataChunkUuid, channelIndex);
 
       env->ReleaseStringUTFChars(userId, cstr_userId);
       env->ReleaseStringUTFChars(dataChunkUuid, cstr_dataChunkUuid);
@@ -650,15 +642,15 @@ extern "C"
       return env->NewStringUTF(cstr_req);
    }
 
-   JNIEXPORT jbyteArray JNICALL Java_com_neuromore_engine_Wrapper_GetDataChunkChannelData(JNIEnv* env, jobject thiz, jint channelIndex)
+   JNIEXPORT jbyteArray JNICALL Java_com_neuromore_engine_Wrapper_GetDataChunkChannelData(JNIEnv* env, jobject thiz, jlong handle, jint channelIndex)
    {
       // try generate datachunk for this channel
-      if (!neuromoreEngine::GenerateDataChunkChannelData(channelIndex))
+      if (!neuromoreEngine::GenerateDataChunkChannelData((neuromoreEngine::EngineHandle)handle, channelIndex))
          return env->NewByteArray(0);
 
       // try get size and native data
-      const int   size = neuromoreEngine::GetDataChunkChannelDataSize(channelIndex);
-      const char* data = neuromoreEngine::GetDataChunkChannelData(channelIndex);
+      const int   size = neuromoreEngine::GetDataChunkChannelDataSize((neuromoreEngine::EngineHandle)handle, channelIndex);
+      const char* data = neuromoreEngine::GetDataChunkChannelData((neuromoreEngine::EngineHandle)handle, channelIndex);
 
       // invalid size or data
       if (size <= 0 || !data)
@@ -671,7 +663,7 @@ extern "C"
       env->SetByteArrayRegion(jdata, 0, size, (jbyte*)data);
 
       // clear native data
-      neuromoreEngine::ClearDataChunkChannelData();
+      neuromoreEngine::ClearDataChunkChannelData((neuromoreEngine::EngineHandle)handle);
 
       return jdata;
    }
@@ -680,21 +672,21 @@ extern "C"
    // Classifier Cloud Parameters
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_CreateJSONRequestFindParameters(JNIEnv* env, jobject thiz, jstring userId)
+   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_CreateJSONRequestFindParameters(JNIEnv* env, jobject thiz, jlong handle, jstring userId)
    {
       const char* cstr_userId = env->GetStringUTFChars(userId, NULL);	
-      const char* cstr_req = neuromoreEngine::CreateJSONRequestFindParameters(cstr_userId);
+      const char* cstr_req = neuromoreEngine::CreateJSONRequestFindParameters((neuromoreEngine::EngineHandle)handle, cstr_userId);
       env->ReleaseStringUTFChars(userId, cstr_userId);
 
       return env->NewStringUTF(cstr_req);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_HandleJSONReplyFindParameters(JNIEnv* env, jobject thiz, jstring jsonString, jstring userId)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_HandleJSONReplyFindParameters(JNIEnv* env, jobject thiz, jlong handle, jstring jsonString, jstring userId)
    {
       const char* cstr_jsonString = env->GetStringUTFChars(jsonString, NULL);
       const char* cstr_userId = env->GetStringUTFChars(userId, NULL);
 
-      bool ok = neuromoreEngine::HandleJSONReplyFindParameters(cstr_jsonString, cstr_userId);
+      bool ok = neuromoreEngine::HandleJSONReplyFindParameters((neuromoreEngine::EngineHandle)handle, cstr_jsonString, cstr_userId);
 
       env->ReleaseStringUTFChars(jsonString, cstr_jsonString);
       env->ReleaseStringUTFChars(userId, cstr_userId);
@@ -702,21 +694,21 @@ extern "C"
       return ok;
    }
 
-   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_CreateJSONRequestSetParameters(JNIEnv* env, jobject thiz)
+   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_CreateJSONRequestSetParameters(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return env->NewStringUTF(neuromoreEngine::CreateJSONRequestSetParameters());
+      return env->NewStringUTF(neuromoreEngine::CreateJSONRequestSetParameters((neuromoreEngine::EngineHandle)handle));
    }
 
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    // State Machine
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_LoadStateMachine(JNIEnv* env, jobject thiz, jstring jsonContent, jstring uuid, jint revision)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_LoadStateMachine(JNIEnv* env, jobject thiz, jlong handle, jstring jsonContent, jstring uuid, jint revision)
    {
       const char* cstr_jsonContent = env->GetStringUTFChars(jsonContent, NULL);
       const char* cstr_uuid = env->GetStringUTFChars(uuid, NULL);
 
-      bool ok = neuromoreEngine::LoadStateMachine(cstr_jsonContent, cstr_uuid, revision);
+      bool ok = neuromoreEngine::LoadStateMachine((neuromoreEngine::EngineHandle)handle, cstr_jsonContent, cstr_uuid, revision);
 
       env->ReleaseStringUTFChars(jsonContent, cstr_jsonContent);
       env->ReleaseStringUTFChars(uuid, cstr_uuid);
@@ -724,66 +716,66 @@ extern "C"
       return ok;
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_HasStateMachine(JNIEnv* env, jobject thiz)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_HasStateMachine(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::HasStateMachine();
+      return neuromoreEngine::HasStateMachine((neuromoreEngine::EngineHandle)handle);
    }
 
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
    // Multimedia Assets
    /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetNumAssetsOfType(JNIEnv* env, jobject thiz, jint type)
+   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetNumAssetsOfType(JNIEnv* env, jobject thiz, jlong handle, jint type)
    {
-      return neuromoreEngine::GetNumAssetsOfType((neuromoreEngine::AssetType)type);
+      return neuromoreEngine::GetNumAssetsOfType((neuromoreEngine::EngineHandle)handle, (neuromoreEngine::AssetType)type);
    }
 
-   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_GetAssetLocationOfType(JNIEnv* env, jobject thiz, jint type, jint index)
+   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_GetAssetLocationOfType(JNIEnv* env, jobject thiz, jlong handle, jint type, jint index)
    {
-      return env->NewStringUTF(neuromoreEngine::GetAssetLocationOfType((neuromoreEngine::AssetType)type, index));
+      return env->NewStringUTF(neuromoreEngine::GetAssetLocationOfType((neuromoreEngine::EngineHandle)handle, (neuromoreEngine::AssetType)type, index));
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_GetAssetAllowStreamingOfType(JNIEnv* env, jobject thiz, jint type, jint index)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_GetAssetAllowStreamingOfType(JNIEnv* env, jobject thiz, jlong handle, jint type, jint index)
    {
-      return neuromoreEngine::GetAssetAllowStreamingOfType((neuromoreEngine::AssetType)type, index);
+      return neuromoreEngine::GetAssetAllowStreamingOfType((neuromoreEngine::EngineHandle)handle, (neuromoreEngine::AssetType)type, index);
    }
 
-   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetNumAssets(JNIEnv* env, jobject thiz)
+   JNIEXPORT jint JNICALL Java_com_neuromore_engine_Wrapper_GetNumAssets(JNIEnv* env, jobject thiz, jlong handle)
    {
-      return neuromoreEngine::GetNumAssets();
+      return neuromoreEngine::GetNumAssets((neuromoreEngine::EngineHandle)handle);
    }
 
-   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_GetAssetLocation(JNIEnv* env, jobject thiz, jint index)
+   JNIEXPORT jstring JNICALL Java_com_neuromore_engine_Wrapper_GetAssetLocation(JNIEnv* env, jobject thiz, jlong handle, jint index)
    {
-      return env->NewStringUTF(neuromoreEngine::GetAssetLocation(index));
+      return env->NewStringUTF(neuromoreEngine::GetAssetLocation((neuromoreEngine::EngineHandle)handle, index));
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_GetAssetAllowStreaming(JNIEnv* env, jobject thiz, jint index)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_GetAssetAllowStreaming(JNIEnv* env, jobject thiz, jlong handle, jint index)
    {
-      return neuromoreEngine::GetAssetAllowStreaming(index);
+      return neuromoreEngine::GetAssetAllowStreaming((neuromoreEngine::EngineHandle)handle, index);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_ButtonClicked(JNIEnv* env, jobject thiz, jint buttonId)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_ButtonClicked(JNIEnv* env, jobject thiz, jlong handle, jint buttonId)
    {
-      return neuromoreEngine::ButtonClicked(buttonId);
+      return neuromoreEngine::ButtonClicked((neuromoreEngine::EngineHandle)handle, buttonId);
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_AudioLooped(JNIEnv* env, jobject thiz, jstring url)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_AudioLooped(JNIEnv* env, jobject thiz, jlong handle, jstring url)
    {
       const char* cstr_url = env->GetStringUTFChars(url, NULL);
 
-      bool ok = neuromoreEngine::AudioLooped(cstr_url);
+      bool ok = neuromoreEngine::AudioLooped((neuromoreEngine::EngineHandle)handle, cstr_url);
 
       env->ReleaseStringUTFChars(url, cstr_url);
 
       return ok;
    }
 
-   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_VideoLooped(JNIEnv* env, jobject thiz, jstring url)
+   JNIEXPORT jboolean JNICALL Java_com_neuromore_engine_Wrapper_VideoLooped(JNIEnv* env, jobject thiz, jlong handle, jstring url)
    {
       const char* cstr_url = env->GetStringUTFChars(url, NULL);
 
-      bool ok = neuromoreEngine::VideoLooped(cstr_url);
+      bool ok = neuromoreEngine::VideoLooped((neuromoreEngine::EngineHandle)handle, cstr_url);
 
       env->ReleaseStringUTFChars(url, cstr_url);
 
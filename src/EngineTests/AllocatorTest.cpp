@@ -0,0 +1,314 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "AllocatorTest.h"
+#include <Core/Allocator.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <set>
+
+using namespace Core;
+
+// nothing else in the test runner allocates with this tag
+static const EMemoryTag gTestTag = MEMORYTAG_NETWORKING;
+
+// slab size of the pools (see Allocator.cpp)
+static const size_t gSlabSize = 64 * 1024;
+
+
+//////////////////////////////////////////////////////////////////////////
+// backend that counts its calls and forwards them to malloc
+
+static std::atomic<uint32> gNumBackendAllocations(0);
+static std::atomic<uint32> gNumBackendSlabs(0);
+static std::atomic<uint32> gNumBackendReallocs(0);
+static std::atomic<uint32> gNumBackendFrees(0);
+
+static void* CountingAllocate(size_t numBytes, void* userData)
+{
+	gNumBackendAllocations++;
+	if (numBytes == gSlabSize)
+		gNumBackendSlabs++;
+	return malloc(numBytes);
+}
+
+static void* CountingRealloc(void* memory, size_t numBytes, void* userData)
+{
+	gNumBackendReallocs++;
+	return realloc(memory, numBytes);
+}
+
+static void CountingFree(void* memory, void* userData)
+{
+	gNumBackendFrees++;
+	free(memory);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+
+// fill a block with a pattern that depends on the position and the seed
+static void FillPattern(void* memory, size_t numBytes, uint8 seed)
+{
+	uint8* data = static_cast<uint8*>(memory);
+	for (size_t i=0; i<numBytes; ++i)
+		data[i] = (uint8)(i * 31 + seed);
+}
+
+static bool CheckPattern(const void* memory, size_t numBytes, uint8 seed)
+{
+	const uint8* data = static_cast<const uint8*>(memory);
+	for (size_t i=0; i<numBytes; ++i)
+		if (data[i] != (uint8)(i * 31 + seed))
+			return false;
+	return true;
+}
+
+
+int64 AllocatorTest::GetNumLiveBytes() const
+{
+	return GetMemoryStatistics(gTestTag).mNumLiveBytes;
+}
+
+
+int64 AllocatorTest::GetNumLiveAllocations() const
+{
+	return GetMemoryStatistics(gTestTag).mNumLiveAllocations;
+}
+
+
+void AllocatorTest::Setup()
+{
+	AllocatorBackend backend;
+	backend.mAllocate	= CountingAllocate;
+	backend.mRealloc	= CountingRealloc;
+	backend.mFree		= CountingFree;
+	backend.mUserData	= NULL;
+	AssertTest( SetAllocatorBackend(backend) == true );
+
+	TestRealloc();
+	TestCrossThreadFree();
+	TestThreadExit();
+}
+
+
+// grow and shrink a block through the size classes, into the backend and back into a pool
+void AllocatorTest::TestRealloc()
+{
+	const int64 liveBytes = GetNumLiveBytes();
+	const int64 liveAllocations = GetNumLiveAllocations();
+	const uint32 numReallocs = gNumBackendReallocs;
+
+	// 20 bytes: 48 byte class
+	size_t numBytes = 20;
+	void* memory = Allocate(numBytes, gTestTag);
+	AssertTest( memory != NULL );
+	AssertTest( ((size_t)memory & 15) == 0 );
+	FillPattern(memory, numBytes, 1);
+	AssertTest( GetNumLiveBytes() - liveBytes == (int64)numBytes );
+
+	// 100 bytes: moves into the 128 byte class and keeps the contents
+	void* previous = memory;
+	memory = Realloc(memory, 100);
+	AssertTest( memory != previous );
+	AssertTest( CheckPattern(memory, numBytes, 1) == true );
+	numBytes = 100;
+	FillPattern(memory, numBytes, 2);
+	AssertTest( GetNumLiveBytes() - liveBytes == 100 );
+
+	// 40 bytes: still fits into the 128 byte block, so it stays in place
+	previous = memory;
+	memory = Realloc(memory, 40);
+	AssertTest( memory == previous );
+	AssertTest( CheckPattern(memory, 40, 2) == true );
+	numBytes = 40;
+	AssertTest( GetNumLiveBytes() - liveBytes == 40 );
+
+	// 500 bytes: 512 byte class is too small with the header, moves to the 640 byte class
+	memory = Realloc(memory, 500);
+	AssertTest( CheckPattern(memory, numBytes, 2) == true );
+	numBytes = 500;
+	FillPattern(memory, numBytes, 3);
+	AssertTest( GetNumLiveBytes() - liveBytes == 500 );
+
+	// 2000 bytes: leaves the pools, the block comes from the backend
+	const uint32 numAllocations = gNumBackendAllocations;
+	memory = Realloc(memory, 2000);
+	AssertTest( gNumBackendAllocations - numAllocations == 1 );
+	AssertTest( ((size_t)memory & 15) == 0 );
+	AssertTest( CheckPattern(memory, numBytes, 3) == true );
+	numBytes = 2000;
+	FillPattern(memory, numBytes, 4);
+	AssertTest( GetNumLiveBytes() - liveBytes == 2000 );
+
+	// 8000 bytes: large block is resized by its backend
+	memory = Realloc(memory, 8000);
+	AssertTest( gNumBackendReallocs - numReallocs == 1 );
+	AssertTest( CheckPattern(memory, numBytes, 4) == true );
+	numBytes = 8000;
+	FillPattern(memory, numBytes, 5);
+	AssertTest( GetNumLiveBytes() - liveBytes == 8000 );
+
+	// 300 bytes: back into the 320 byte class, the large block goes back to the backend
+	const uint32 numFrees = gNumBackendFrees;
+	memory = Realloc(memory, 300);
+	AssertTest( gNumBackendFrees - numFrees == 1 );
+	AssertTest( CheckPattern(memory, 300, 5) == true );
+	AssertTest( GetNumLiveBytes() - liveBytes == 300 );
+	AssertTest( GetNumLiveAllocations() - liveAllocations == 1 );
+
+	// large block allocated and freed without realloc goes through the backend as well
+	void* large = Allocate(5000, gTestTag);
+	AssertTest( GetNumLiveBytes() - liveBytes == 5300 );
+	Free(large);
+	AssertTest( gNumBackendFrees - numFrees == 2 );
+
+	Free(memory);
+	AssertTest( GetNumLiveBytes() == liveBytes );
+	AssertTest( GetNumLiveAllocations() == liveAllocations );
+}
+
+
+// allocate on one thread and free on another one, the accounting of both threads has to add up to zero
+void AllocatorTest::TestCrossThreadFree()
+{
+	const int64 liveBytes = GetNumLiveBytes();
+	const int64 liveAllocations = GetNumLiveAllocations();
+
+	// mix of pooled and large blocks
+	const uint32 numBlocks = 1000;
+	std::vector<void*> blocks(numBlocks);
+	int64 numBytesTotal = 0;
+	for (uint32 i=0; i<numBlocks; ++i)
+	{
+		const size_t numBytes = (i % 10 == 0) ? 4000 + i : 1 + (i * 7) % 1000;
+		blocks[i] = Allocate(numBytes, gTestTag);
+		FillPattern(blocks[i], numBytes, (uint8)i);
+		numBytesTotal += numBytes;
+	}
+
+	AssertTest( GetNumLiveBytes() - liveBytes == numBytesTotal );
+	AssertTest( GetNumLiveAllocations() - liveAllocations == numBlocks );
+
+	// free everything on a second thread and reuse the blocks there, which now sit in its cache
+	bool contentsValid = true;
+	std::thread thread([&blocks, &contentsValid, numBlocks]()
+	{
+		for (uint32 i=0; i<numBlocks; ++i)
+		{
+			const size_t numBytes = (i % 10 == 0) ? 4000 + i : 1 + (i * 7) % 1000;
+			contentsValid &= CheckPattern(blocks[i], numBytes, (uint8)i);
+			Free(blocks[i]);
+		}
+
+		for (uint32 i=0; i<numBlocks; ++i)
+		{
+			blocks[i] = Allocate(1 + (i * 7) % 1000, gTestTag);
+			FillPattern(blocks[i], 1 + (i * 7) % 1000, (uint8)(i + 1));
+		}
+	});
+	thread.join();
+
+	AssertTest( contentsValid == true );
+
+	// the second thread is gone, its counters live on in the totals
+	numBytesTotal = 0;
+	for (uint32 i=0; i<numBlocks; ++i)
+		numBytesTotal += 1 + (i * 7) % 1000;
+	AssertTest( GetNumLiveBytes() - liveBytes == numBytesTotal );
+	AssertTest( GetNumLiveAllocations() - liveAllocations == numBlocks );
+
+	// and back again: free the blocks of the exited thread here
+	for (uint32 i=0; i<numBlocks; ++i)
+	{
+		contentsValid &= CheckPattern(blocks[i], 1 + (i * 7) % 1000, (uint8)(i + 1));
+		Free(blocks[i]);
+	}
+
+	AssertTest( contentsValid == true );
+	AssertTest( GetNumLiveBytes() == liveBytes );
+	AssertTest( GetNumLiveAllocations() == liveAllocations );
+}
+
+
+// the cache of an exiting thread goes to the depot, a new thread takes its blocks from there instead of carving new slabs
+void AllocatorTest::TestThreadExit()
+{
+	const int64 liveBytes = GetNumLiveBytes();
+	const int64 liveAllocations = GetNumLiveAllocations();
+
+	// 600 bytes use the 640 byte class, more blocks than one slab and one thread cache hold
+	const size_t numBytes = 600;
+	const uint32 numBlocks = 400;
+
+	std::set<void*> addresses;
+	std::thread first([&addresses, numBytes, numBlocks]()
+	{
+		// accounted through the scope of this thread
+		MemoryTagScope tagScope(gTestTag);
+
+		std::vector<void*> blocks(numBlocks);
+		for (uint32 i=0; i<numBlocks; ++i)
+		{
+			blocks[i] = Allocate(numBytes);
+			addresses.insert(blocks[i]);
+		}
+
+		for (uint32 i=0; i<numBlocks; ++i)
+			Free(blocks[i]);
+	});
+	first.join();
+
+	AssertTest( addresses.size() == numBlocks );
+	AssertTest( GetNumLiveBytes() == liveBytes );
+	AssertTest( GetNumLiveAllocations() == liveAllocations );
+
+	uint32 numNewSlabs = 0;
+	uint32 numReused = 0;
+	std::thread second([&addresses, &numNewSlabs, &numReused, numBytes, numBlocks]()
+	{
+		const uint32 numSlabs = gNumBackendSlabs;
+
+		std::vector<void*> blocks(numBlocks);
+		for (uint32 i=0; i<numBlocks; ++i)
+		{
+			blocks[i] = Allocate(numBytes, gTestTag);
+			if (addresses.find(blocks[i]) != addresses.end())
+				numReused++;
+		}
+
+		numNewSlabs = gNumBackendSlabs - numSlabs;
+
+		for (uint32 i=0; i<numBlocks; ++i)
+			Free(blocks[i]);
+	});
+	second.join();
+
+	// the depot may hold blocks of earlier threads as well, but it never runs dry
+	AssertTest( numNewSlabs == 0 );
+	AssertTest( numReused >= numBlocks / 2 );
+	AssertTest( GetNumLiveBytes() == liveBytes );
+	AssertTest( GetNumLiveAllocations() == liveAllocations );
+}
@@ -0,0 +1,52 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_ALLOCATORTEST_H
+#define __NEUROMORE_ALLOCATORTEST_H
+
+// include required headers
+#include <Core/Test.h>
+#include <Core/StandardHeaders.h>
+
+
+// checks the pools, the backend hand-over and the per-tag accounting of the heap interface
+class AllocatorTest : public Test
+{
+	public:
+		AllocatorTest() : Test("Allocator") {}
+		virtual ~AllocatorTest() {}
+
+		void Setup() override;
+
+	private:
+		void TestRealloc();
+		void TestCrossThreadFree();
+		void TestThreadExit();
+
+		// number of live bytes and blocks of the tag used by the test
+		int64 GetNumLiveBytes() const;
+		int64 GetNumLiveAllocations() const;
+};
+
+
+#endif
@@ -0,0 +1,68 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "BufferPlannerTest.h"
+#include <EngineManager.h>
+#include <Graph/Classifier.h>
+#include <Graph/SignalGeneratorNode.h>
+#include <Graph/ViewNode.h>
+
+using namespace Core;
+
+
+void BufferPlannerTest::Setup()
+{
+	// signal generator -> view
+	Classifier* classifier = new Classifier();
+	Node* generator = static_cast<Node*>(GetGraphObjectFactory()->CreateObjectByTypeID(classifier, SignalGeneratorNode::TYPE_ID));
+	ViewNode* view = static_cast<ViewNode*>(GetGraphObjectFactory()->CreateObjectByTypeID(classifier, ViewNode::TYPE_ID));
+	classifier->AddNode(generator);
+	classifier->AddNode(view);
+	classifier->AddConnection(generator, SignalGeneratorNode::OUTPUTPORT_CHANNEL, view, ViewNode::INPUTPORT_DOUBLE);
+
+	GetEngine()->LoadGraph(classifier);
+	GetEngine()->Reset();
+	for (uint32 i=0; i<10; ++i)
+		GetEngine()->Update(0.1);
+
+	// the view widgets copy the displayed range straight out of the generator output
+	const BufferPlanner& planner = classifier->GetBufferPlanner();
+	const ChannelBase* channel = generator->GetOutputPort(SignalGeneratorNode::OUTPUTPORT_CHANNEL).GetChannels()->GetChannel(0);
+	const uint32 numViewSamples = (uint32)(view->GetMaxViewDuration() * channel->GetSampleRate());
+
+	AssertTest( planner.GetNumEntries() == 1 && planner.GetEntry(0).mNumLookbackSamples >= numViewSamples );
+	AssertTest( channel->GetBufferSize() >= numViewSamples );
+
+	// the view range is clamped to the planned lookback, changing it does not resize the buffer
+	const uint64 numSamplesBefore = channel->GetSampleCounter();
+	view->SetViewDuration(2.0 * view->GetMaxViewDuration());
+	AssertTest( view->GetViewDuration() == view->GetMaxViewDuration() );
+
+	view->SetViewDuration(1.0);
+	GetEngine()->Update(0.1);
+	AssertTest( channel->GetSampleCounter() > numSamplesBefore );
+	AssertTest( channel->GetBufferSize() >= numViewSamples );
+
+	GetEngine()->UnloadGraph(classifier);
+}
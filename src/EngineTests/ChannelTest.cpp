@@ -0,0 +1,138 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "ChannelTest.h"
+#include <DSP/Channel.h>
+#include <DSP/ChunkStore.h>
+#include <EngineManager.h>
+#include <Core/Math.h>
+#include <vector>
+
+using namespace Core;
+
+
+void ChannelTest::Setup()
+{
+	srand(50);
+
+	// small hot duration: 100 Hz storage channels have chunks of 500 samples, all but the last two chunks cool down
+	EngineManager::ChannelStorageSettings& settings = GetEngine()->GetChannelStorageSettings();
+	const EngineManager::ChannelStorageSettings oldSettings = settings;
+	settings.mHotDuration = 1.0;
+
+	AssertTest( CheckStorage(EngineManager::CHANNELSTORAGE_MEMORY, 10000) );
+	AssertTest( CheckStorage(EngineManager::CHANNELSTORAGE_COMPRESSED, 10000) );
+	AssertTest( CheckStorage(EngineManager::CHANNELSTORAGE_DISK, 10000) );
+
+	// too few samples to cool a chunk
+	AssertTest( CheckStorage(EngineManager::CHANNELSTORAGE_COMPRESSED, 1200) );
+
+	settings = oldSettings;
+}
+
+
+bool ChannelTest::CheckStorage(uint32 storageMode, uint32 numSamples)
+{
+	GetEngine()->GetChannelStorageSettings().mMode = (EngineManager::EChannelStorageMode)storageMode;
+
+	Channel<double> channel(100.0);
+	std::vector<double> values(numSamples);
+	std::vector<double> copied(numSamples);
+
+	// the channel is filled twice: cold chunks have to be dropped by the clear
+	for (uint32 pass=0; pass<2; ++pass)
+	{
+		if (pass == 1)
+		{
+			channel.Clear();
+			if (channel.GetNumSamples() != 0 || channel.GetColdChunks() != NULL)
+				return false;
+		}
+
+		// decimals (like parsed recordings) and noise, added sample by sample and in bulk
+		for (uint32 i=0; i<numSamples; ++i)
+			values[i] = (pass == 0 ? Math::RandSmallRange(-5000, 5000) / 100.0 : Math::RandD(-1.0, 1.0));
+
+		uint32 numAdded = 0;
+		while (numAdded < numSamples)
+		{
+			const uint32 num = Min<uint32>(1 + Math::RandIndex(700), numSamples - numAdded);
+			if (num < 10)
+			{
+				for (uint32 i=0; i<num; ++i)
+					channel.AddSample(values[numAdded + i]);
+			}
+			else
+			{
+				channel.AddSamples(values.data() + numAdded, num);
+			}
+			numAdded += num;
+		}
+
+		if (channel.GetNumSamples() != numSamples)
+			return false;
+
+		// chunks are only cooled with a tiered storage mode and enough samples
+		const bool hasColdChunks = (storageMode != EngineManager::CHANNELSTORAGE_MEMORY && numSamples > 2000);
+		if ((channel.GetColdChunks() != NULL) != hasColdChunks)
+			return false;
+
+		if (hasColdChunks == true && (channel.IsColdChunk(1) == false || channel.GetColdChunks()->GetMode() != (storageMode == EngineManager::CHANNELSTORAGE_DISK ? ChunkStore::MODE_DISK : ChunkStore::MODE_MEMORY)))
+			return false;
+
+		// single samples, in order and at random
+		for (uint32 i=0; i<numSamples; ++i)
+		{
+			if (channel.GetSample(i) != values[i])
+				return false;
+		}
+
+		for (uint32 i=0; i<1000; ++i)
+		{
+			const uint32 index = Math::RandIndex(numSamples);
+			if (channel.GetSample(index) != values[index])
+				return false;
+		}
+
+		// ranges across cold and hot chunks
+		for (uint32 i=0; i<100; ++i)
+		{
+			const uint32 start = Math::RandIndex(numSamples);
+			const uint32 num = Min<uint32>(1 + Math::RandIndex(2000), numSamples - start);
+			channel.CopySamples(start, num, copied.data());
+
+			for (uint32 s=0; s<num; ++s)
+			{
+				if (copied[s] != values[start + s])
+					return false;
+			}
+		}
+
+		channel.CopySamples(0, numSamples, copied.data());
+		if (copied != values)
+			return false;
+	}
+
+	return true;
+}
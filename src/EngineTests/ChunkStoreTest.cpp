@@ -0,0 +1,147 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "ChunkStoreTest.h"
+#include <DSP/ChunkStore.h>
+#include <Core/Math.h>
+#include <limits>
+#include <string.h>
+#include <vector>
+
+using namespace Core;
+
+
+// random 64 bit pattern (covers all exponents, NaN payloads and denormals)
+static double RandomBits()
+{
+	uint64 bits = 0;
+	for (uint32 i=0; i<4; ++i)
+		bits = (bits << 16) | (uint64)(rand() & 0xFFFF);
+
+	double value;
+	memcpy(&value, &bits, sizeof(double));
+	return value;
+}
+
+
+void ChunkStoreTest::Setup()
+{
+	srand(50);
+
+	const double nan = std::numeric_limits<double>::quiet_NaN();
+	const double inf = std::numeric_limits<double>::infinity();
+	const double maxInteger = 9007199254740992.0;	// 2^53
+
+	// empty and single value chunks
+	AssertTest( CheckRoundTrip(NULL, 0) );
+	const double one = 1.0;
+	AssertTest( CheckRoundTrip(&one, 1) );
+
+	// special values, alone and between decimals
+	const double specials[] = { 0.0, -0.0, nan, -nan, inf, -inf, std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+	const uint32 numSpecials = sizeof(specials) / sizeof(double);
+	AssertTest( CheckRoundTrip(specials, numSpecials) );
+	for (uint32 i=0; i<numSpecials; ++i)
+	{
+		const double values[] = { 1.25, 2.5, specials[i], 3.75 };
+		AssertTest( CheckRoundTrip(values, 4) );
+	}
+
+	// integers at the limit of the decimal format and just beyond it
+	const double bounds[] = { maxInteger - 1.0, -(maxInteger - 1.0), maxInteger, -maxInteger, maxInteger * 2.0, (maxInteger - 1.0) / 10.0, maxInteger / 1e9 };
+	AssertTest( CheckRoundTrip(bounds, 2) );
+	AssertTest( CheckRoundTrip(bounds, sizeof(bounds) / sizeof(double)) );
+
+	// decimals of parsed recordings use the decimal format
+	std::vector<double> values(5000);
+	for (uint32 i=0; i<values.size(); ++i)
+		values[i] = Math::RandSmallRange(-100000, 100000) / 100.0;
+
+	Array<uint8> bytes;
+	ChunkStore::Encode(values.data(), (uint32)values.size(), bytes);
+	AssertTest( bytes.Size() > 0 && bytes[0] == 2 && bytes.Size() < values.size() * sizeof(double) / 2 );
+	AssertTest( CheckRoundTrip(values.data(), (uint32)values.size()) );
+
+	// -0 compares equal to 0, it must not slip into the decimal format
+	values[100] = -0.0;
+	AssertTest( CheckRoundTrip(values.data(), (uint32)values.size()) );
+
+	// runs of repeating values are XOR coded
+	for (uint32 i=0; i<values.size(); ++i)
+		values[i] = Math::pi * (double)(1 + i / 1000);
+	ChunkStore::Encode(values.data(), (uint32)values.size(), bytes);
+	AssertTest( bytes.Size() > 0 && bytes[0] == 1 && bytes.Size() < values.size() );
+	AssertTest( CheckRoundTrip(values.data(), (uint32)values.size()) );
+
+	// random doubles and random bit patterns are stored uncompressed at worst
+	for (uint32 i=0; i<values.size(); ++i)
+		values[i] = Math::RandD() * 200.0 - 100.0;
+	AssertTest( CheckRoundTrip(values.data(), (uint32)values.size()) );
+
+	for (uint32 i=0; i<values.size(); ++i)
+		values[i] = RandomBits();
+	ChunkStore::Encode(values.data(), (uint32)values.size(), bytes);
+	AssertTest( bytes.Size() == 1 + values.size() * sizeof(double) );
+	AssertTest( CheckRoundTrip(values.data(), (uint32)values.size()) );
+
+	// the store in memory and on disk: more chunks than the decode cache holds, read back in random order
+	const uint32 numChunks = 10;
+	const uint32 chunkSize = 500;
+	std::vector<double> chunks(numChunks * chunkSize);
+	for (uint32 i=0; i<chunks.size(); ++i)
+		chunks[i] = (i % 3 == 0 ? RandomBits() : Math::RandSmallRange(-1000, 1000) / 10.0);
+
+	for (uint32 mode=ChunkStore::MODE_MEMORY; mode<=ChunkStore::MODE_DISK; ++mode)
+	{
+		ChunkStore store((ChunkStore::EMode)mode);
+		for (uint32 c=0; c<numChunks; ++c)
+			store.Add(chunks.data() + c * chunkSize, chunkSize);
+
+		AssertTest( store.GetNumChunks() == numChunks && store.GetNumValues() == numChunks * chunkSize );
+
+		bool isEqual = true;
+		for (uint32 i=0; i<3*numChunks; ++i)
+		{
+			const uint32 c = Math::RandIndex(numChunks);
+			isEqual &= (memcmp(store.GetChunk(c), chunks.data() + c * chunkSize, chunkSize * sizeof(double)) == 0);
+		}
+		AssertTest( isEqual == true );
+	}
+}
+
+
+bool ChunkStoreTest::CheckRoundTrip(const double* values, uint32 numValues)
+{
+	Array<uint8> bytes;
+	ChunkStore::Encode(values, numValues, bytes);
+
+	// decode into a poisoned buffer, so untouched values are noticed
+	std::vector<double> decoded(numValues + 1, 12345.0);
+	ChunkStore::Decode(bytes.GetReadPtr(), bytes.Size(), decoded.data(), numValues);
+
+	if (decoded[numValues] != 12345.0)
+		return false;
+
+	return (numValues == 0 || memcmp(decoded.data(), values, numValues * sizeof(double)) == 0);
+}
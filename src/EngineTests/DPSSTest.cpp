@@ -0,0 +1,95 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "DPSSTest.h"
+#include <DSP/DPSS.h>
+#include <Core/Math.h>
+
+using namespace Core;
+
+
+void DPSSTest::Setup()
+{
+	AssertTest( DPSS::CalcNumTapers(4.0) == 7 );
+	AssertTest( DPSS::CalcNumTapers(0.5) == 1 );
+
+	// orthonormal up to the rounding of the dot products, which grows with the taper length
+	AssertTest( CalcOrthonormalityError(64, 2.5, 5) < 1e-15 );
+	AssertTest( CalcOrthonormalityError(64, 4.0, 8) < 1e-15 );
+	AssertTest( CalcOrthonormalityError(1024, 4.0, 8) < 4e-15 );
+
+	// concentration ratios for NW=4: the leading taper is fully concentrated, the last three match the published values (Percival & Walden)
+	const uint32 numSamples = 1024;
+	AssertTest( Math::AbsD(CalcConcentration(numSamples, 4.0, 8, 0) - 1.0) < 1e-6 );
+	AssertTest( Math::AbsD(CalcConcentration(numSamples, 4.0, 8, 5) - 0.99251) < 5e-5 );
+	AssertTest( Math::AbsD(CalcConcentration(numSamples, 4.0, 8, 6) - 0.93666) < 5e-5 );
+	AssertTest( Math::AbsD(CalcConcentration(numSamples, 4.0, 8, 7) - 0.69884) < 5e-5 );
+}
+
+
+double DPSSTest::CalcOrthonormalityError(uint32 numSamples, double timeBandwidth, uint32 numTapers)
+{
+	const double* tapers = DPSS::GetTapers(numSamples, timeBandwidth, numTapers);
+
+	double maxError = 0.0;
+	for (uint32 a=0; a<numTapers; ++a)
+	{
+		for (uint32 b=0; b<numTapers; ++b)
+		{
+			double dot = 0.0;
+			for (uint32 i=0; i<numSamples; ++i)
+				dot += tapers[a*numSamples + i] * tapers[b*numSamples + i];
+
+			const double expected = (a == b ? 1.0 : 0.0);
+			maxError = Max<double>(maxError, Math::AbsD(dot - expected));
+		}
+	}
+
+	return maxError;
+}
+
+
+// v^T A v with the sinc kernel A[m][n] = sin(2 pi W (m-n)) / (pi (m-n)) of the band |f| <= W
+double DPSSTest::CalcConcentration(uint32 numSamples, double timeBandwidth, uint32 numTapers, uint32 taper)
+{
+	const double* v = DPSS::GetTapers(numSamples, timeBandwidth, numTapers) + taper * numSamples;
+	const double halfBandwidth = timeBandwidth / numSamples;
+
+	// the kernel only depends on the lag
+	double concentration = 0.0;
+	for (int32 lag=-(int32)numSamples+1; lag<(int32)numSamples; ++lag)
+	{
+		const double kernel = (lag == 0 ? 2.0 * halfBandwidth : Math::SinD(2.0 * Math::piD * halfBandwidth * lag) / (Math::piD * lag));
+
+		double sum = 0.0;
+		const uint32 start = (lag < 0 ? -lag : 0);
+		const uint32 end = (lag < 0 ? numSamples : numSamples - lag);
+		for (uint32 m=start; m<end; ++m)
+			sum += v[m] * v[m + lag];
+
+		concentration += kernel * sum;
+	}
+
+	return concentration;
+}
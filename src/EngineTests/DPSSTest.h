@@ -0,0 +1,49 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_DPSSTEST_H
+#define __NEUROMORE_DPSSTEST_H
+
+// include required headers
+#include <Core/Test.h>
+
+
+// checks the Slepian tapers: orthonormality and their spectral concentration
+class DPSSTest : public Test
+{
+	public:
+		DPSSTest() : Test("DPSS") {}
+		virtual ~DPSSTest() {}
+
+		void Setup() override;
+
+	private:
+		// largest deviation of the taper dot products from the identity
+		double CalcOrthonormalityError(uint32 numSamples, double timeBandwidth, uint32 numTapers);
+
+		// fraction of the taper energy within the band |f| <= W
+		double CalcConcentration(uint32 numSamples, double timeBandwidth, uint32 numTapers, uint32 taper);
+};
+
+
+#endif
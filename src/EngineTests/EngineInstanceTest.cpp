@@ -0,0 +1,85 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "EngineInstanceTest.h"
+#include <neuromoreEngine.h>
+#include <EngineManager.h>
+#include <atomic>
+#include <thread>
+
+using namespace Core;
+
+
+// create an instance, feed a device and update it a couple of times, then shut it down again
+static bool RunInstance(uint32 numRounds, std::atomic<uint32>* numReady)
+{
+	bool result = true;
+
+	// start both threads at the same time so that their Init() and Shutdown() calls overlap
+	(*numReady)++;
+	while (*numReady < 2)
+		std::this_thread::yield();
+
+	for (uint32 round=0; round<numRounds; ++round)
+	{
+		neuromoreEngine::EngineHandle handle = neuromoreEngine::Init();
+		if (handle == NULL || neuromoreEngine::IsInitialized(handle) == false)
+			return false;
+
+		const int deviceIndex = neuromoreEngine::AddDevice(handle, neuromoreEngine::DEVICE_GENERIC_ACCELEROMETER);
+		result &= (deviceIndex >= 0);
+		result &= (neuromoreEngine::GetNumDevices(handle) == 1);
+
+		for (uint32 i=0; i<50 && deviceIndex >= 0; ++i)
+		{
+			neuromoreEngine::AddInputSample(handle, deviceIndex, neuromoreEngine::ACCELEROMETER_INPUT_X, (double)i);
+			result &= neuromoreEngine::Update(handle);
+		}
+
+		neuromoreEngine::Shutdown(handle);
+	}
+
+	return result;
+}
+
+
+void EngineInstanceTest::Setup()
+{
+	EngineManager* defaultEngine = gEngineManager;
+
+	std::atomic<uint32> numReady(0);
+	bool resultA = false;
+	bool resultB = false;
+	std::thread threadA([&resultA, &numReady]() { resultA = RunInstance(20, &numReady); });
+	std::thread threadB([&resultB, &numReady]() { resultB = RunInstance(20, &numReady); });
+	threadA.join();
+	threadB.join();
+
+	AssertTest( resultA == true );
+	AssertTest( resultB == true );
+
+	// the default engine belongs to the host here (it was initialized before the first instance), the instances must not shut it down
+	AssertTest( gEngineManager == defaultEngine );
+	AssertTest( GetEngine() == defaultEngine );
+}
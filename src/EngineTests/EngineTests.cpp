@@ -0,0 +1,90 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// unit tests of the engine
+//
+// usage: EngineTests
+//   returns 0 if all tests passed
+//
+
+// include required headers
+#include <Config.h>
+#include <EngineManager.h>
+#include <Core/TestFacility.h>
+#include "SlidingQuantileTest.h"
+#include "FFTProcessorTest.h"
+#include "LogQueueTest.h"
+#include "SerialFramerTest.h"
+#include "ChunkStoreTest.h"
+#include "ChannelTest.h"
+#include "EpochTest.h"
+#include "BufferPlannerTest.h"
+#include "EngineInstanceTest.h"
+#include "StringTest.h"
+#include "DPSSTest.h"
+#include "SlidingDFTTest.h"
+#include "AllocatorTest.h"
+#include "LoretaSolverTest.h"
+
+
+// all engine tests
+class EngineTestFacility : public TestFacility
+{
+	public:
+		EngineTestFacility() : TestFacility("Engine")
+		{
+			AddTest( new SlidingQuantileTest() );
+			AddTest( new FFTProcessorTest() );
+			AddTest( new LogQueueTest() );
+			AddTest( new SerialFramerTest() );
+			AddTest( new ChunkStoreTest() );
+			AddTest( new ChannelTest() );
+			AddTest( new EpochTest() );
+			AddTest( new BufferPlannerTest() );
+			AddTest( new EngineInstanceTest() );
+			AddTest( new StringTest() );
+			AddTest( new DPSSTest() );
+			AddTest( new SlidingDFTTest() );
+			AddTest( new AllocatorTest() );
+			AddTest( new LoretaSolverTest() );
+		}
+};
+
+
+int main(int argc, char** argv)
+{
+	if (EngineInitializer::Init() == false)
+	{
+		printf("Failed to initialize the engine.\n");
+		return 1;
+	}
+
+	bool passed;
+	{
+		EngineTestFacility facility;
+		passed = facility.Run(argc, argv);
+	}
+
+	EngineInitializer::Shutdown();
+	return (passed == true ? 0 : 1);
+}
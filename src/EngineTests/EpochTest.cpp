@@ -0,0 +1,84 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "EpochTest.h"
+#include <DSP/Epoch.h>
+#include <DSP/Channel.h>
+#include <Core/ScratchArena.h>
+#include <Core/Math.h>
+#include <vector>
+
+using namespace Core;
+
+
+void EpochTest::Setup()
+{
+	srand(29);
+
+	// positions beyond 32 bits (long storage channels)
+	Epoch epoch;
+	epoch.SetPosition(5000000000ULL);
+	AssertTest( epoch.GetPosition() == 5000000000ULL );
+
+	// a circular buffer that wrapped around several times
+	Channel<double> channel(100.0, 128);
+	for (uint32 i=0; i<1000; ++i)
+		channel.AddSample(Math::RandD(-1.0, 1.0));
+
+	ScratchArena arena;
+	std::vector<double> copied;
+
+	bool isEqual = true;
+	for (uint32 i=0; i<200; ++i)
+	{
+		const uint32 length = 1 + Math::RandIndex(200);
+		const uint64 position = Math::RandIndex((uint32)channel.GetMaxSampleIndex() + 1);
+
+		// samples that left the buffer are zero padded
+		Epoch testEpoch(&channel, length);
+		testEpoch.SetZeroPaddingEnabled(true);
+		testEpoch.SetPosition(position);
+		isEqual &= (testEpoch.GetPosition() == position);
+
+		copied.resize(length);
+		testEpoch.CopySamples(copied.data());
+
+		std::vector<double> read(length);
+		for (uint32 s=0; s<length; ++s)
+			read[s] = testEpoch.GetSample(s);
+
+		const double* materialized = testEpoch.Materialize(arena);
+		for (uint32 s=0; s<length; ++s)
+		{
+			double expected = 0.0;
+			if (position + s + 1 >= length && channel.IsValidSample(position + s + 1 - length) == true)
+				expected = channel.GetSample(position + s + 1 - length);
+
+			isEqual &= (copied[s] == expected && read[s] == expected && materialized[s] == expected && testEpoch.GetSample(s) == expected);
+		}
+
+		arena.Reset();
+	}
+	AssertTest( isEqual == true );
+}
@@ -0,0 +1,143 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "FFTProcessorTest.h"
+#include <DSP/FFTProcessor.h>
+#include <DSP/Channel.h>
+#include <DSP/FFT.h>
+#include <Core/Math.h>
+
+using namespace Core;
+
+
+void FFTProcessorTest::Setup()
+{
+	AssertTest( CheckRectangularOutput(WindowFunction::WINDOWFUNCTION_RECTANGULAR) );
+	AssertTest( CheckRectangularOutput(WindowFunction::WINDOWFUNCTION_HANN) );
+	AssertTest( CheckRectangularOutput(WindowFunction::WINDOWFUNCTION_BLACKMAN) );
+
+	// the coherent gain of the window is compensated, so a bin centred sine keeps its amplitude (the window table is symmetric, not periodic, hence the tolerance)
+	AssertTest( Math::AbsD(CalcSineAmplitude(false) - 2.0) < 1e-3 );
+	AssertTest( Math::AbsD(CalcSineAmplitude(true) - 2.0) < 1e-3 );
+
+	// the Welch average of the segment periodograms keeps the amplitude of the tone
+	AssertTest( Math::AbsD(CalcSineAmplitude(false, FFTProcessor::FFTSettings::ESTIMATOR_WELCH) - 2.0) < 1e-3 );
+	AssertTest( Math::AbsD(CalcSineAmplitude(true, FFTProcessor::FFTSettings::ESTIMATOR_WELCH) - 2.0) < 1e-3 );
+}
+
+
+bool FFTProcessorTest::CheckRectangularOutput(uint32 windowFunction)
+{
+	const uint32 fftOrder = 6;
+	const uint32 numSamples = 1 << fftOrder;
+	const uint32 numBins = numSamples / 2 + 1;
+
+	Channel<double> input(128, 1024);
+
+	FFTProcessor processor;
+	FFTProcessor::FFTSettings settings;
+	settings.mFFTOrder = fftOrder;
+	settings.mEpochShift = 16;
+	settings.mWindowFunction.SetType((WindowFunction::EWindowFunction)windowFunction);
+	processor.SetInput(&input);
+	processor.Setup(settings);
+	processor.ReInit();
+
+	srand(30);
+	for (uint32 i=0; i<200; ++i)
+		input.AddSample(Math::RandD(-100.0, 100.0) + 10.0 * Math::SinD(i * 0.3));
+	processor.Update();
+
+	Channel<Spectrum>* output = processor.GetOutput()->AsType<Spectrum>();
+	if (output->GetNumSamples() == 0)
+		return false;
+
+	// reference: copy, FFT and scale exactly like the processor did before windowing existed
+	FFT fft;
+	fft.Init(numSamples);
+
+	for (uint64 s=output->GetMinSampleIndex(); s<=output->GetMaxSampleIndex(); ++s)
+	{
+		// the spectrum time is the time of the last sample of its epoch
+		const Spectrum& spectrum = output->GetSample(s);
+		const uint64 lastSample = input.FindIndexByTime(Time(spectrum.GetTime()), true);
+		if (lastSample + 1 < numSamples)
+			continue;
+
+		double* fftInput = fft.GetInput();
+		for (uint32 i=0; i<numSamples; ++i)
+			fftInput[i] = input.GetSample(lastSample + 1 - numSamples + i);
+		fft.CalcFFT();
+
+		const Complex* fftOutput = fft.GetOutput();
+		Spectrum reference;
+		reference.SetNumBins(numBins);
+		reference.SetBin(0, fftOutput[0].mReal / numBins / 2.0);
+		const double scalingFactor = 1.0 / (numBins-1) / 2.0 * 2.0;
+		for (uint32 b=1; b<numBins; ++b)
+			reference.SetBin(b, fftOutput[b] * scalingFactor);
+
+		if (spectrum.GetNumBins() != numBins)
+			return false;
+
+		if (memcmp(spectrum.GetBins(), reference.GetBins(), numBins * sizeof(Complex)) != 0)
+			return false;
+	}
+
+	return true;
+}
+
+
+double FFTProcessorTest::CalcSineAmplitude(bool applyWindow, uint32 estimator)
+{
+	const uint32 fftOrder = 6;
+	const uint32 numSamples = 1 << fftOrder;
+	const uint32 numSegments = 4;
+
+	Channel<double> input(128, 1024);
+
+	FFTProcessor processor;
+	FFTProcessor::FFTSettings settings;
+	settings.mFFTOrder = fftOrder;
+	settings.mEpochShift = numSamples;
+	settings.mWindowFunction.SetType(WindowFunction::WINDOWFUNCTION_HANN);
+	settings.mApplyWindow = applyWindow;
+	settings.mEstimator = (FFTProcessor::FFTSettings::EEstimator)estimator;
+	settings.mNumSegments = numSegments;
+	processor.SetInput(&input);
+	processor.Setup(settings);
+	processor.ReInit();
+
+	// 16 Hz at 128 Hz sample rate is bin 8 (periodic in the FFT length and in the half length segment shift, so every complete epoch and segment sees the same amplitude)
+	const uint32 epochLength = numSamples + (numSegments - 1) * numSamples / 2;
+	for (uint32 i=0; i<2*epochLength+1; ++i)
+		input.AddSample(2.0 * Math::SinD(2.0 * Math::pi * 8.0 * i / (double)numSamples));
+	processor.Update();
+
+	Channel<Spectrum>* output = processor.GetOutput()->AsType<Spectrum>();
+	if (output->GetNumSamples() == 0)
+		return 0.0;
+
+	return output->GetLastSample().GetBin(8);
+}
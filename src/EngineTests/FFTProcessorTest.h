@@ -0,0 +1,49 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_FFTPROCESSORTEST_H
+#define __NEUROMORE_FFTPROCESSORTEST_H
+
+// include required headers
+#include <Core/Test.h>
+
+
+// checks that FFTProcessor keeps the output of graphs that predate the window option and that the window gain is compensated (also for the Welch estimate)
+class FFTProcessorTest : public Test
+{
+	public:
+		FFTProcessorTest() : Test("FFTProcessor") {}
+		virtual ~FFTProcessorTest() {}
+
+		void Setup() override;
+
+	private:
+		// without 'Apply Window' the spectrum is bit-identical to the plain (rectangular) FFT of the last N samples, whatever window type is selected
+		bool CheckRectangularOutput(uint32 windowFunction);
+
+		// amplitude of a bin centred sine, with and without window (estimator: FFTProcessor::FFTSettings::EEstimator)
+		double CalcSineAmplitude(bool applyWindow, uint32 estimator=0);
+};
+
+
+#endif
@@ -0,0 +1,106 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "LogQueueTest.h"
+#include <Core/LogQueue.h>
+#include <EngineManager.h>
+#include <atomic>
+#include <thread>
+
+using namespace Core;
+
+
+// push a message into a queue
+static bool PushMessage(LogQueue* queue, const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	const bool result = queue->Push(LOGLEVEL_DEBUG, format, args);
+	va_end(args);
+	return result;
+}
+
+
+void LogQueueTest::Setup()
+{
+	LogQueue* queueA = new LogQueue(&CORE_LOGMANAGER);
+	LogQueue* queueB = new LogQueue(&CORE_LOGMANAGER);
+	queueA->SetMaxMessagesPerSecond(0);
+	queueB->SetMaxMessagesPerSecond(0);
+
+	// a thread that alternates between two queues keeps one ring per queue
+	for (uint32 i=0; i<100; ++i)
+	{
+		PushMessage(queueA, "LogQueueTest: queue A %i", i);
+		PushMessage(queueB, "LogQueueTest: queue B %i", i);
+	}
+	AssertTest( queueA->GetNumRings() == 1 && queueB->GetNumRings() == 1 );
+
+	// the rings of exited threads are freed once they are drained
+	for (uint32 i=0; i<20; ++i)
+	{
+		std::thread thread([queueA, i]() { PushMessage(queueA, "LogQueueTest: thread %i", i); });
+		thread.join();
+	}
+	AssertTest( queueA->GetNumRings() == 21 );
+	queueA->Flush();
+	AssertTest( queueA->GetNumRings() == 1 );
+
+	// the ring of a destroyed queue is forgotten, logging to a new queue still works
+	queueB->Flush();
+	delete queueB;
+	LogQueue* queueC = new LogQueue(&CORE_LOGMANAGER);
+	AssertTest( PushMessage(queueC, "LogQueueTest: queue C") == true );
+	AssertTest( queueC->GetNumRings() == 1 );
+
+	queueA->Flush();
+	queueC->Flush();
+	delete queueA;
+	delete queueC;
+
+	// a thread that outlives its queue
+	LogQueue* queueD = new LogQueue(&CORE_LOGMANAGER);
+	LogQueue* queueE = new LogQueue(&CORE_LOGMANAGER);
+	std::atomic<uint32> step(0);
+	std::thread thread([queueD, queueE, &step]()
+	{
+		PushMessage(queueD, "LogQueueTest: queue D");
+		step = 1;
+		while (step != 2)
+			std::this_thread::yield();
+		PushMessage(queueE, "LogQueueTest: queue E");
+	});
+
+	while (step != 1)
+		std::this_thread::yield();
+	queueD->Flush();
+	delete queueD;
+	step = 2;
+	thread.join();
+
+	AssertTest( queueE->GetNumRings() == 1 );
+	queueE->Flush();
+	AssertTest( queueE->GetNumRings() == 0 );
+	delete queueE;
+}
@@ -0,0 +1,266 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "LoretaSolverTest.h"
+#include <DSP/LoretaSolver.h>
+#include <Core/Math.h>
+
+using namespace Core;
+
+
+void LoretaSolverTest::Setup()
+{
+	// 16 electrodes on a spiral over the upper half of a 9 cm sphere
+	Array<Vector3> electrodes;
+	const uint32 numElectrodes = 16;
+	for (uint32 i=0; i<numElectrodes; ++i)
+	{
+		const double z = 1.0 - (i + 0.5) / numElectrodes;
+		const double radius = Math::SqrtD(1.0 - z*z);
+		const double angle = i * 2.39996322972865332;
+		electrodes.Add( Vector3((float)(0.09 * radius * Math::CosD(angle)), (float)(0.09 * radius * Math::SinD(angle)), (float)(0.09 * z)) );
+	}
+
+	// 1 cm voxel grid inside a 6.5 cm sphere: enough voxels for several column blocks and all worker slices
+	Array<Vector3> voxels;
+	for (int32 x=-6; x<=6; ++x)
+		for (int32 y=-6; y<=6; ++y)
+			for (int32 z=-6; z<=6; ++z)
+				if (x*x + y*y + z*z <= 42)
+					voxels.Add( Vector3(0.01f * x, 0.01f * y, 0.01f * z) );
+
+	AssertTest( 3 * voxels.Size() > 2 * 512 );
+	AssertTest( voxels.Size() > 64 * 4 );
+
+	// regularization relative to the average diagonal of K*K^t
+	const double conductivity = 0.33;
+	Array<double> leadField;
+	CalcLeadField(electrodes, voxels, conductivity, leadField);
+
+	double trace = 0.0;
+	const uint32 numColumns = 3 * voxels.Size();
+	for (uint32 i=0; i<numElectrodes*numColumns; ++i)
+		trace += leadField[i] * leadField[i];
+	const double regularization = 1e-3 * trace / numElectrodes;
+
+	LoretaSolver singleThreaded;
+	singleThreaded.SetNumThreads(1);
+	AssertTest( singleThreaded.Init(electrodes, voxels, conductivity, regularization) == true );
+
+	LoretaSolver multiThreaded;
+	multiThreaded.SetNumThreads(4);
+	AssertTest( multiThreaded.Init(electrodes, voxels, conductivity, regularization) == true );
+	AssertTest( multiThreaded.GetNumThreads() == 4 );
+
+	// a couple of frames, each one solved by both solvers and the reference
+	Array<double> electrodeValues(numElectrodes);
+	Array<double> currentDensity;
+	Array<double> power;
+	for (uint32 frame=0; frame<3; ++frame)
+	{
+		for (uint32 i=0; i<numElectrodes; ++i)
+			electrodeValues[i] = 1e-5 * Math::SinD(0.7 * i + 1.3 * frame) + 2e-6 * frame;
+
+		singleThreaded.Solve(electrodeValues.GetReadPtr());
+		multiThreaded.Solve(electrodeValues.GetReadPtr());
+		AssertTest( CalcReference(electrodes, voxels, conductivity, regularization, electrodeValues.GetReadPtr(), currentDensity, power) == true );
+
+		AssertTest( CalcRelativeError(singleThreaded.GetCurrentDensity(), currentDensity) < 1e-12 );
+		AssertTest( CalcRelativeError(singleThreaded.GetPower(), power) < 1e-12 );
+
+		// every voxel is processed by exactly one thread with the same operations, so the results are identical
+		bool isIdentical = true;
+		for (uint32 i=0; i<currentDensity.Size(); ++i)
+			isIdentical &= (singleThreaded.GetCurrentDensity()[i] == multiThreaded.GetCurrentDensity()[i]);
+		for (uint32 i=0; i<power.Size(); ++i)
+			isIdentical &= (singleThreaded.GetPower()[i] == multiThreaded.GetPower()[i]);
+		AssertTest( isIdentical == true );
+	}
+}
+
+
+bool LoretaSolverTest::CalcReference(const Array<Vector3>& electrodes, const Array<Vector3>& voxels, double conductivity, double regularization,
+									 const double* electrodeValues, Array<double>& outCurrentDensity, Array<double>& outPower)
+{
+	const uint32 n = electrodes.Size();
+	const uint32 numVoxels = voxels.Size();
+	const uint32 numColumns = 3 * numVoxels;
+
+	Array<double> leadField;
+	CalcLeadField(electrodes, voxels, conductivity, leadField);
+
+	// G = K*K^t + a*H with the centering matrix H = I - 1/n
+	Array<double> gram(n * n);
+	for (uint32 i=0; i<n; ++i)
+	{
+		for (uint32 j=0; j<n; ++j)
+		{
+			double sum = 0.0;
+			for (uint32 c=0; c<numColumns; ++c)
+				sum += leadField[i * numColumns + c] * leadField[j * numColumns + c];
+
+			gram[i * n + j] = sum + regularization * ((i == j ? 1.0 : 0.0) - 1.0 / n);
+		}
+	}
+
+	if (Invert(gram, n) == false)
+		return false;
+
+	// T = K^t * G^-1
+	Array<double> inverseOperator(numColumns * n);
+	for (uint32 r=0; r<numColumns; ++r)
+	{
+		for (uint32 j=0; j<n; ++j)
+		{
+			double sum = 0.0;
+			for (uint32 k=0; k<n; ++k)
+				sum += leadField[k * numColumns + r] * gram[k * n + j];
+			inverseOperator[r * n + j] = sum;
+		}
+	}
+
+	outCurrentDensity.Resize(numColumns);
+	outPower.Resize(numVoxels);
+	Array<double> resolution;
+	resolution.Resize(9);
+	for (uint32 v=0; v<numVoxels; ++v)
+	{
+		// J_v = T_v * phi
+		double j[3];
+		for (uint32 r=0; r<3; ++r)
+		{
+			double sum = 0.0;
+			for (uint32 k=0; k<n; ++k)
+				sum += inverseOperator[(3*v + r) * n + k] * electrodeValues[k];
+			j[r] = sum;
+			outCurrentDensity[3*v + r] = sum;
+		}
+
+		// S_v = T_v * K_v
+		for (uint32 r=0; r<3; ++r)
+		{
+			for (uint32 c=0; c<3; ++c)
+			{
+				double sum = 0.0;
+				for (uint32 k=0; k<n; ++k)
+					sum += inverseOperator[(3*v + r) * n + k] * leadField[k * numColumns + 3*v + c];
+				resolution[r * 3 + c] = sum;
+			}
+		}
+
+		if (Invert(resolution, 3) == false)
+			return false;
+
+		double power = 0.0;
+		for (uint32 r=0; r<3; ++r)
+			for (uint32 c=0; c<3; ++c)
+				power += j[r] * resolution[r * 3 + c] * j[c];
+		outPower[v] = power;
+	}
+
+	return true;
+}
+
+
+void LoretaSolverTest::CalcLeadField(const Array<Vector3>& electrodes, const Array<Vector3>& voxels, double conductivity, Array<double>& outLeadField)
+{
+	const uint32 numColumns = 3 * voxels.Size();
+	outLeadField.Resize(electrodes.Size() * numColumns);
+
+	for (uint32 e=0; e<electrodes.Size(); ++e)
+	{
+		for (uint32 v=0; v<voxels.Size(); ++v)
+		{
+			const double d[3] = { (double)electrodes[e].x - voxels[v].x, (double)electrodes[e].y - voxels[v].y, (double)electrodes[e].z - voxels[v].z };
+			const double distance = Math::SqrtD(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+
+			for (uint32 c=0; c<3; ++c)
+				outLeadField[e * numColumns + 3*v + c] = d[c] / (4.0 * Math::piD * conductivity * distance * distance * distance);
+		}
+	}
+}
+
+
+bool LoretaSolverTest::Invert(Array<double>& matrix, uint32 size)
+{
+	Array<double> inverse(size * size);
+	inverse.SetAll(0.0);
+	for (uint32 i=0; i<size; ++i)
+		inverse[i * size + i] = 1.0;
+
+	for (uint32 col=0; col<size; ++col)
+	{
+		// pivot: largest remaining element of the column
+		uint32 pivot = col;
+		for (uint32 row=col+1; row<size; ++row)
+			if (Math::AbsD(matrix[row * size + col]) > Math::AbsD(matrix[pivot * size + col]))
+				pivot = row;
+
+		if (matrix[pivot * size + col] == 0.0)
+			return false;
+
+		for (uint32 k=0; k<size; ++k)
+		{
+			Swap(matrix[col * size + k], matrix[pivot * size + k]);
+			Swap(inverse[col * size + k], inverse[pivot * size + k]);
+		}
+
+		const double scale = 1.0 / matrix[col * size + col];
+		for (uint32 k=0; k<size; ++k)
+		{
+			matrix[col * size + k] *= scale;
+			inverse[col * size + k] *= scale;
+		}
+
+		for (uint32 row=0; row<size; ++row)
+		{
+			if (row == col)
+				continue;
+
+			const double factor = matrix[row * size + col];
+			for (uint32 k=0; k<size; ++k)
+			{
+				matrix[row * size + k] -= factor * matrix[col * size + k];
+				inverse[row * size + k] -= factor * inverse[col * size + k];
+			}
+		}
+	}
+
+	matrix = inverse;
+	return true;
+}
+
+
+double LoretaSolverTest::CalcRelativeError(const double* values, const Array<double>& reference)
+{
+	double maxReference = 0.0;
+	double maxError = 0.0;
+	for (uint32 i=0; i<reference.Size(); ++i)
+	{
+		maxReference = Max<double>(maxReference, Math::AbsD(reference[i]));
+		maxError = Max<double>(maxError, Math::AbsD(values[i] - reference[i]));
+	}
+
+	return (maxReference > 0.0 ? maxError / maxReference : maxError);
+}
@@ -0,0 +1,58 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_LORETASOLVERTEST_H
+#define __NEUROMORE_LORETASOLVERTEST_H
+
+// include required headers
+#include <Core/Test.h>
+#include <Core/Array.h>
+#include <Core/Vector.h>
+
+
+// compares the blocked and multithreaded sLORETA solver with a naive implementation of the same equations
+class LoretaSolverTest : public Test
+{
+	public:
+		LoretaSolverTest() : Test("LoretaSolver") {}
+		virtual ~LoretaSolverTest() {}
+
+		void Setup() override;
+
+	private:
+		// textbook sLORETA: T = K^t * (K*K^t + a*H)^-1, J = T*phi and power_v = J_v^t * (T_v*K_v)^-1 * J_v; returns false if a matrix is singular
+		bool CalcReference(const Core::Array<Core::Vector3>& electrodes, const Core::Array<Core::Vector3>& voxels, double conductivity, double regularization,
+						   const double* electrodeValues, Core::Array<double>& outCurrentDensity, Core::Array<double>& outPower);
+
+		// lead field of a dipole in an infinite homogenous medium (numElectrodes x 3*numVoxels)
+		void CalcLeadField(const Core::Array<Core::Vector3>& electrodes, const Core::Array<Core::Vector3>& voxels, double conductivity, Core::Array<double>& outLeadField);
+
+		// gauss-jordan inverse with partial pivoting of a square matrix
+		bool Invert(Core::Array<double>& matrix, uint32 size);
+
+		// largest deviation relative to the largest reference magnitude
+		double CalcRelativeError(const double* values, const Core::Array<double>& reference);
+};
+
+
+#endif
@@ -0,0 +1,219 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "SerialFramerTest.h"
+#include <Devices/SerialFramer.h>
+#include <Core/Math.h>
+#include <string.h>
+#include <vector>
+
+using namespace Core;
+
+// test frame: header, index, two int24 values, one int16 value, footer
+#define FRAME_SIZE		11
+#define FRAME_HEADER	0xA0
+#define FRAME_FOOTER	0xC0
+
+
+// build one test frame
+static void BuildFrame(uint8* frame, uint8 index, int32 value0, int32 value1, int16 value2)
+{
+	frame[0] = FRAME_HEADER;
+	frame[1] = index;
+	frame[2] = (uint8)(value0 >> 16);	frame[3] = (uint8)(value0 >> 8);	frame[4] = (uint8)value0;
+	frame[5] = (uint8)(value1 >> 16);	frame[6] = (uint8)(value1 >> 8);	frame[7] = (uint8)value1;
+	frame[8] = (uint8)(value2 >> 8);	frame[9] = (uint8)value2;
+	frame[10] = FRAME_FOOTER;
+}
+
+
+void SerialFramerTest::Setup()
+{
+	srand(45);
+
+	// frames split across writes, down to single bytes
+	AssertTest( CheckRandomStream(1000, 1, false) );
+	AssertTest( CheckRandomStream(1000, 7, false) );
+	AssertTest( CheckRandomStream(1000, 500, false) );
+
+	// resync after garbage, false headers and truncated frames
+	AssertTest( CheckRandomStream(1000, 1, true) );
+	AssertTest( CheckRandomStream(1000, 64, true) );
+
+	SerialFramer framer;
+	framer.Init(FRAME_SIZE, FRAME_HEADER, FRAME_FOOTER);
+
+	// nothing to parse
+	AssertTest( framer.Parse() == 0 && framer.GetNumDroppedBytes() == 0 );
+
+	// garbage without a header byte is dropped completely
+	std::vector<uint8> garbage(1000);
+	for (uint32 i=0; i<garbage.size(); ++i)
+		garbage[i] = (uint8)Math::RandIndex(FRAME_HEADER);
+	framer.Write(garbage.data(), (uint32)garbage.size());
+	AssertTest( framer.Parse() == 0 );
+	AssertTest( framer.GetNumDroppedBytes() == 1000 && framer.GetNumBufferedBytes() == 0 );
+
+	// garbage with header but without footer bytes never produces a frame, only the tail that could still become one stays buffered
+	framer.Clear();
+	for (uint32 i=0; i<garbage.size(); ++i)
+	{
+		garbage[i] = (uint8)Math::RandIndex(256);
+		if (garbage[i] == FRAME_FOOTER)
+			garbage[i] = FRAME_HEADER;
+	}
+	for (uint32 i=0; i<garbage.size(); i+=100)
+		framer.Write(garbage.data() + i, 100);
+	AssertTest( framer.Parse() == 0 && framer.GetNumParsedFrames() == 0 );
+	AssertTest( framer.GetNumDroppedBytes() + framer.GetNumBufferedBytes() == 1000 && framer.GetNumBufferedBytes() < FRAME_SIZE );
+
+	// a frame right after the garbage is found again
+	uint8 frame[FRAME_SIZE];
+	BuildFrame(frame, 0, 1, 2, 3);
+	framer.Write(frame, FRAME_SIZE);
+	AssertTest( framer.Parse() == 1 && framer.GetNumDroppedBytes() == 1000 && framer.GetNumBufferedBytes() == 0 );
+
+	// decoder value ranges and scales
+	uint8 frames[4][FRAME_SIZE];
+	BuildFrame(frames[0], 0, 0, 0, 0);
+	BuildFrame(frames[1], 1, -1, 0x7FFFFF, -1);
+	BuildFrame(frames[2], 2, -0x800000, 1, 0x7FFF);
+	BuildFrame(frames[3], 3, 0x123456, -0x123456, -0x8000);
+	const uint8* framePointers[4] = { frames[0], frames[1], frames[2], frames[3] };
+
+	const double scales[2] = { 1.0, 0.5 };
+	double values24[2*4];
+	double values16[4];
+	SerialFramer::DecodeInt24(framePointers, 4, 2, 2, scales, values24, 4);
+	SerialFramer::DecodeInt16(framePointers, 4, 8, 1, scales, values16, 4);
+	AssertTest( values24[0] == 0.0 && values24[1] == -1.0 && values24[2] == -8388608.0 && values24[3] == 1193046.0 );
+	AssertTest( values24[4] == 0.0 && values24[5] == 4194303.5 && values24[6] == 0.5 && values24[7] == -596523.0 );
+	AssertTest( values16[0] == 0.0 && values16[1] == -1.0 && values16[2] == 32767.0 && values16[3] == -32768.0 );
+}
+
+
+bool SerialFramerTest::CheckRandomStream(uint32 numFrames, uint32 maxChunkSize, bool insertGarbage)
+{
+	std::vector<int32> expected(3 * numFrames);
+	std::vector<uint8> stream;
+	uint32 numGarbageBytes = 0;
+
+	for (uint32 f=0; f<numFrames; ++f)
+	{
+		// payload bytes equal to the header are fine, payload bytes equal to the footer would let garbage form valid frames (the index stays below both)
+		uint8 frame[FRAME_SIZE];
+		do
+		{
+			expected[3*f+0] = Math::RandSmallRange(-0x800000, 0x7FFFFF);
+			expected[3*f+1] = Math::RandSmallRange(-0x800000, 0x7FFFFF);
+			expected[3*f+2] = Math::RandSmallRange(-0x8000, 0x7FFF);
+			BuildFrame(frame, (uint8)(f % 128), expected[3*f+0], expected[3*f+1], (int16)expected[3*f+2]);
+		} while (memchr(frame + 2, FRAME_FOOTER, FRAME_SIZE - 3) != NULL);
+
+		if (insertGarbage == true && Math::RandIndex(10) == 0)
+		{
+			switch (Math::RandIndex(3))
+			{
+				// random bytes
+				case 0:
+				{
+					const uint32 numBytes = 1 + Math::RandIndex(20);
+					for (uint32 i=0; i<numBytes; ++i)
+					{
+						const uint8 value = (uint8)Math::RandIndex(256);
+						stream.push_back(value == FRAME_FOOTER ? FRAME_HEADER : value);
+					}
+					numGarbageBytes += numBytes;
+					break;
+				}
+
+				// false header
+				case 1:
+				{
+					stream.push_back(FRAME_HEADER);
+					stream.push_back(0x00);
+					numGarbageBytes += 2;
+					break;
+				}
+
+				// truncated frame
+				default:
+				{
+					const uint32 numBytes = 1 + Math::RandIndex(FRAME_SIZE - 1);
+					stream.insert(stream.end(), frame, frame + numBytes);
+					numGarbageBytes += numBytes;
+					break;
+				}
+			}
+		}
+
+		stream.insert(stream.end(), frame, frame + FRAME_SIZE);
+	}
+
+	SerialFramer framer;
+	framer.Init(FRAME_SIZE, FRAME_HEADER, FRAME_FOOTER);
+
+	const double scales[2] = { 1.0, 1.0 };
+	std::vector<double> values24;
+	std::vector<double> values16;
+	uint32 numReceived = 0;
+	uint32 position = 0;
+	while (position < stream.size())
+	{
+		const uint32 chunkSize = Min<uint32>(1 + Math::RandIndex(maxChunkSize), (uint32)stream.size() - position);
+
+		// alternate between the two ways of writing
+		if (Math::RandIndex(2) == 0)
+			framer.Write(stream.data() + position, chunkSize);
+		else
+		{
+			memcpy(framer.BeginWrite(chunkSize), stream.data() + position, chunkSize);
+			framer.EndWrite(chunkSize);
+		}
+		position += chunkSize;
+
+		const uint32 num = framer.Parse();
+		if (num != framer.GetNumFrames() || numReceived + num > numFrames)
+			return false;
+
+		values24.resize(2 * num);
+		values16.resize(num);
+		SerialFramer::DecodeInt24(framer.GetFrames(), num, 2, 2, scales, values24.data(), num);
+		SerialFramer::DecodeInt16(framer.GetFrames(), num, 8, 1, scales, values16.data(), num);
+
+		for (uint32 f=0; f<num; ++f)
+		{
+			const uint32 index = numReceived + f;
+			if (framer.GetFrame(f)[1] != index % 128)
+				return false;
+
+			if (values24[f] != expected[3*index+0] || values24[num+f] != expected[3*index+1] || values16[f] != expected[3*index+2])
+				return false;
+		}
+
+		numReceived += num;
+	}
+
+	return (numReceived == numFrames && framer.GetNumParsedFrames() == numFrames && framer.GetNumDroppedBytes() == numGarbageBytes && framer.GetNumBufferedBytes() == 0);
+}
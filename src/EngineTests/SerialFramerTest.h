@@ -0,0 +1,46 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_SERIALFRAMERTEST_H
+#define __NEUROMORE_SERIALFRAMERTEST_H
+
+// include required headers
+#include <Core/Test.h>
+
+
+// checks the framing of fixed-size serial packets from split, corrupted and garbage byte streams
+class SerialFramerTest : public Test
+{
+	public:
+		SerialFramerTest() : Test("SerialFramer") {}
+		virtual ~SerialFramerTest() {}
+
+		void Setup() override;
+
+	private:
+		// writes random frames (optionally with garbage in between) in random chunks and compares the parsed and decoded frames
+		bool CheckRandomStream(uint32 numFrames, uint32 maxChunkSize, bool insertGarbage);
+};
+
+
+#endif
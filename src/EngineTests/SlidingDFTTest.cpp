@@ -0,0 +1,184 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "SlidingDFTTest.h"
+#include <DSP/FFTProcessor.h>
+#include <DSP/Channel.h>
+#include <Core/Math.h>
+
+using namespace Core;
+
+
+void SlidingDFTTest::Setup()
+{
+	// every sample (a resync every 64 samples, the spectra right after it are exactly the FFT)
+	Result result = Compare(1, false, 0.0, 0.0);
+	AssertTest( result.mNumCompared > 990 );
+	AssertTest( result.mMaxError < 1e-9 );
+	AssertTest( result.mNumResyncs >= 15 );
+	AssertTest( result.mNumExact == result.mNumResyncs );
+
+	// epoch shift > 1
+	result = Compare(5, false, 0.0, 0.0);
+	AssertTest( result.mNumCompared > 190 );
+	AssertTest( result.mMaxError < 1e-9 );
+
+	// the spectra are output at the samples 1, 1+shift, ..., with a shift of 7 the resyncs after 64, 512 and 960 samples fall on an output
+	result = Compare(7, false, 0.0, 0.0);
+	AssertTest( result.mNumCompared > 135 );
+	AssertTest( result.mMaxError < 1e-9 );
+	AssertTest( result.mNumResyncs == 3 && result.mNumExact == result.mNumResyncs );
+
+	// limited bin range: 10-30Hz at 2Hz bin width are the bins 5-15, all others are zero
+	result = Compare(3, false, 10.0, 30.0);
+	AssertTest( result.mNumCompared > 320 );
+	AssertTest( result.mMaxError < 1e-9 );
+	AssertTest( result.mOutsideRangeZero == true );
+
+	// removing DC zeroes the 0Hz bin and keeps all others
+	result = Compare(2, true, 0.0, 0.0);
+	AssertTest( result.mNumCompared > 490 );
+	AssertTest( result.mMaxError < 1e-9 );
+}
+
+
+SlidingDFTTest::Result SlidingDFTTest::Compare(uint32 epochShift, bool removeDC, double minFrequency, double maxFrequency)
+{
+	const uint32 fftOrder = 6;
+	const uint32 numSamples = 1 << fftOrder;
+	const uint32 numBins = numSamples / 2 + 1;
+	const uint32 numInputSamples = 1000;
+	const double sampleRate = 128.0;
+
+	Result result;
+	result.mNumCompared = 0;
+	result.mNumExact = 0;
+	result.mNumResyncs = 0;
+	result.mMaxError = 0.0;
+	result.mOutsideRangeZero = true;
+
+	Channel<double> input(sampleRate, 2048);
+
+	FFTProcessor::FFTSettings settings;
+	settings.mFFTOrder = fftOrder;
+	settings.mEpochShift = epochShift;
+	settings.mRemoveDC = removeDC;
+
+	FFTProcessor fftProcessor;
+	fftProcessor.SetInput(&input);
+	fftProcessor.Setup(settings);
+	fftProcessor.ReInit();
+
+	settings.mSlidingDFT = true;
+	settings.mMinFrequency = minFrequency;
+	settings.mMaxFrequency = maxFrequency;
+
+	FFTProcessor slidingProcessor;
+	slidingProcessor.SetInput(&input);
+	slidingProcessor.Setup(settings);
+	slidingProcessor.ReInit();
+
+	if (slidingProcessor.IsSlidingDFT() == false)
+		return result;
+
+	Channel<Spectrum>* fftOutput = fftProcessor.GetOutput()->AsType<Spectrum>();
+	Channel<Spectrum>* slidingOutput = slidingProcessor.GetOutput()->AsType<Spectrum>();
+
+	// the bins of the range
+	const double binWidth = (sampleRate / 2.0) / (numBins - 1);
+	const uint32 firstBin = (maxFrequency > 0.0 ? (uint32)Math::CeilD(minFrequency / binWidth) : 0);
+	const uint32 lastBin = (maxFrequency > 0.0 ? (uint32)Math::FloorD(maxFrequency / binWidth) : numBins - 1);
+
+	// noise on top of a DC offset and two sines, fed in blocks of varying size
+	srand(42);
+	uint32 numAdded = 0;
+	uint64 s = 0;
+	uint64 f = 0;
+	while (numAdded < numInputSamples)
+	{
+		const uint32 blockSize = Min<uint32>(1 + rand() % 13, numInputSamples - numAdded);
+		input.BeginAddSamples();
+		for (uint32 i=0; i<blockSize; ++i, ++numAdded)
+			input.AddSample(50.0 + Math::RandD(-10.0, 10.0) + 20.0 * Math::SinD(numAdded * 0.7) + 5.0 * Math::SinD(numAdded * 2.1));
+
+		fftProcessor.Update();
+		slidingProcessor.Update();
+
+		// compare the new spectra; both outputs have the same epochs
+		for (; s<slidingOutput->GetSampleCounter(); ++s)
+		{
+			const Spectrum& sliding = slidingOutput->GetSample(s);
+			while (f < fftOutput->GetSampleCounter() && fftOutput->GetSample(f).GetTime() < sliding.GetTime())
+				++f;
+
+			// the FFT path outputs an epoch once the reader has it complete, which can be an update later
+			if (f >= fftOutput->GetSampleCounter())
+				break;
+
+			if (fftOutput->GetSample(f).GetTime() != sliding.GetTime())
+				continue;
+
+			const Spectrum& reference = fftOutput->GetSample(f);
+			result.mNumCompared++;
+
+			// number of input samples consumed when the spectrum was output; the resync happens every N samples, before the output
+			const uint64 numConsumed = input.FindIndexByTime(Time(sliding.GetTime()), true) + 1;
+			const bool isResync = (numConsumed % numSamples == 0);
+
+			bool isExact = true;
+			for (uint32 b=0; b<numBins; ++b)
+			{
+				const Complex& value = sliding.GetBins()[b];
+				if (b < firstBin || b > lastBin)
+				{
+					if (value.mReal != 0.0 || value.mImag != 0.0)
+						result.mOutsideRangeZero = false;
+					continue;
+				}
+
+				// the FFT path removes the mean, which leaves rounding noise in the 0Hz bin
+				const Complex& expected = reference.GetBins()[b];
+				if (removeDC == true && b == 0)
+				{
+					result.mMaxError = Max<double>(result.mMaxError, Math::AbsD(value.mReal) + Math::AbsD(value.mImag));
+					continue;
+				}
+
+				const double error = Math::AbsD(value.mReal - expected.mReal) + Math::AbsD(value.mImag - expected.mImag);
+				result.mMaxError = Max<double>(result.mMaxError, error);
+				if (error != 0.0)
+					isExact = false;
+			}
+
+			if (isResync == true)
+			{
+				result.mNumResyncs++;
+				if (isExact == true)
+					result.mNumExact++;
+			}
+		}
+	}
+
+	return result;
+}
@@ -0,0 +1,55 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_SLIDINGDFTTEST_H
+#define __NEUROMORE_SLIDINGDFTTEST_H
+
+// include required headers
+#include <Core/Test.h>
+
+
+// compares the sliding DFT mode of FFTProcessor bin by bin with the FFT of the same epochs (rectangular window)
+class SlidingDFTTest : public Test
+{
+	public:
+		SlidingDFTTest() : Test("SlidingDFT") {}
+		virtual ~SlidingDFTTest() {}
+
+		void Setup() override;
+
+	private:
+		struct Result
+		{
+			uint32	mNumCompared;			// spectra found in both outputs
+			uint32	mNumExact;				// spectra output right after a resync that are bit-identical to the FFT
+			uint32	mNumResyncs;			// spectra output right after a resync
+			double	mMaxError;				// largest bin difference within the bin range
+			bool	mOutsideRangeZero;		// all bins outside the bin range are zero
+		};
+
+		// run both processors over the same input and compare all spectra with the same time
+		Result Compare(uint32 epochShift, bool removeDC, double minFrequency, double maxFrequency);
+};
+
+
+#endif
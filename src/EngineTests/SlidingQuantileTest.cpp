@@ -0,0 +1,142 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "SlidingQuantileTest.h"
+#include <DSP/SlidingQuantile.h>
+#include <Core/Math.h>
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <vector>
+
+using namespace Core;
+
+
+void SlidingQuantileTest::Setup()
+{
+	srand(28);
+
+	// window sizes around the power of two node growth, plus the degenerate ones
+	AssertTest( CheckRandomStream(1, 100, false) );
+	AssertTest( CheckRandomStream(2, 100, false) );
+	AssertTest( CheckRandomStream(64, 1000, false) );
+	AssertTest( CheckRandomStream(100, 5000, false) );
+
+	// NaN and infinity must neither enter the window nor expire a valid value
+	AssertTest( CheckRandomStream(64, 1000, true) );
+
+	// empty window
+	SlidingQuantile empty;
+	AssertTest( empty.GetNumValues() == 0 && empty.CalcQuantile(0.5) == 0.0 );
+	empty.AddValue(1.0);
+	AssertTest( empty.GetNumValues() == 0 );
+
+	// only invalid values
+	SlidingQuantile invalid;
+	invalid.Init(4);
+	invalid.AddValue(std::numeric_limits<double>::quiet_NaN());
+	invalid.AddValue(std::numeric_limits<double>::infinity());
+	invalid.AddValue(-std::numeric_limits<double>::infinity());
+	AssertTest( invalid.GetNumValues() == 0 );
+
+	// a NaN between valid values does not shift the window
+	invalid.AddValue(1.0);
+	invalid.AddValue(2.0);
+	invalid.AddValue(std::numeric_limits<double>::quiet_NaN());
+	invalid.AddValue(3.0);
+	invalid.AddValue(4.0);
+	AssertTest( invalid.GetNumValues() == 4 && invalid.GetMinValue() == 1.0 && invalid.GetMaxValue() == 4.0 );
+	AssertTest( invalid.CalcSum(4) == 10.0 && invalid.CalcQuantile(0.5) == 2.5 );
+
+	// clear keeps the window size
+	invalid.Clear();
+	AssertTest( invalid.GetNumValues() == 0 && invalid.GetWindowSize() == 4 );
+	invalid.AddValue(5.0);
+	AssertTest( invalid.GetNumValues() == 1 && invalid.GetMinValue() == 5.0 && invalid.CalcQuantile(0.9) == 5.0 );
+}
+
+
+bool SlidingQuantileTest::CheckRandomStream(uint32 windowSize, uint32 numValues, bool insertInvalid)
+{
+	SlidingQuantile window;
+	window.Init(windowSize);
+
+	std::deque<double> reference;
+	std::vector<double> sorted;
+
+	for (uint32 i=0; i<numValues; ++i)
+	{
+		// small integer range produces many equal values
+		double value = (double)Math::RandSmallRange(-20, 20) * 0.5;
+		if (insertInvalid == true && Math::RandIndex(5) == 0)
+			value = (Math::RandIndex(2) == 0 ? std::numeric_limits<double>::quiet_NaN() : -std::numeric_limits<double>::infinity());
+
+		window.AddValue(value);
+
+		if (Math::IsValidNumberD(value) == true)
+		{
+			reference.push_back(value);
+			if (reference.size() > windowSize)
+				reference.pop_front();
+		}
+
+		sorted.assign(reference.begin(), reference.end());
+		std::sort(sorted.begin(), sorted.end());
+		const uint32 num = (uint32)sorted.size();
+
+		if (window.GetNumValues() != num)
+			return false;
+
+		double sum = 0.0;
+		for (uint32 r=0; r<num; ++r)
+		{
+			if (window.GetValue(r) != sorted[r])
+				return false;
+
+			// all values are multiples of 0.5, the partial sums are exact
+			sum += sorted[r];
+			if (window.CalcSum(r + 1) != sum)
+				return false;
+		}
+
+		const double probe = (double)Math::RandSmallRange(-20, 20) * 0.5;
+		const uint32 numLess = (uint32)(std::lower_bound(sorted.begin(), sorted.end(), probe) - sorted.begin());
+		const uint32 numLessEqual = (uint32)(std::upper_bound(sorted.begin(), sorted.end(), probe) - sorted.begin());
+		if (window.CountLess(probe) != numLess || window.CountLessEqual(probe) != numLessEqual)
+			return false;
+
+		if (num > 0)
+		{
+			const double quantile = Math::RandD();
+			const double position = quantile * (num - 1);
+			const uint32 lower = (uint32)position;
+			const uint32 upper = Min<uint32>(lower + 1, num - 1);
+			const double expected = sorted[lower] + (position - lower) * (sorted[upper] - sorted[lower]);
+			if (Math::AbsD(window.CalcQuantile(quantile) - expected) > 1e-9)
+				return false;
+		}
+	}
+
+	return true;
+}
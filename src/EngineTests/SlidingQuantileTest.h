@@ -0,0 +1,46 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+#ifndef __NEUROMORE_SLIDINGQUANTILETEST_H
+#define __NEUROMORE_SLIDINGQUANTILETEST_H
+
+// include required headers
+#include <Core/Test.h>
+
+
+// compares the treap of SlidingQuantile against a brute force sorted copy of the window
+class SlidingQuantileTest : public Test
+{
+	public:
+		SlidingQuantileTest() : Test("SlidingQuantile") {}
+		virtual ~SlidingQuantileTest() {}
+
+		void Setup() override;
+
+	private:
+		// feeds random values (with duplicates and optionally non-finite values) and checks all queries after every value
+		bool CheckRandomStream(uint32 windowSize, uint32 numValues, bool insertInvalid);
+};
+
+
+#endif
@@ -0,0 +1,148 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as
+** appearing in the file neuromore-class-exception.md included in the
+** packaging of this file. Please review the following information to
+** ensure the neuromore Public License requirements will be met:
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "StringTest.h"
+#include <Core/String.h>
+#include <string>
+#include <utility>
+
+using namespace Core;
+
+
+// printable test text of the given length
+static std::string MakeText(uint32 length, char first='a')
+{
+	std::string result;
+	for (uint32 i=0; i<length; ++i)
+		result += (char)(first + (i % 26));
+
+	return result;
+}
+
+
+// same length and content, including the terminator
+static bool Matches(const String& string, const std::string& expected)
+{
+	return (string.GetLength() == expected.size() && strcmp(string.AsChar(), expected.c_str()) == 0 && string.AsChar()[string.GetLength()] == '\0');
+}
+
+
+void StringTest::Setup()
+{
+	// lengths around the inline capacity (23 code units)
+	const uint32 lengths[] = { 0, 1, 22, 23, 24, 100 };
+	const uint32 numLengths = sizeof(lengths) / sizeof(uint32);
+
+	for (uint32 i=0; i<numLengths; ++i)
+	{
+		const std::string text = MakeText(lengths[i]);
+
+		// copy constructor
+		String source(text.c_str());
+		String copy(source);
+		AssertTest( Matches(source, text) && Matches(copy, text) );
+
+		// move constructor leaves an empty source behind
+		String moved(std::move(copy));
+		AssertTest( Matches(moved, text) && copy.IsEmpty() == true && Matches(copy, "") );
+
+		// the moved-from string is still usable
+		copy = "reused";
+		AssertTest( Matches(copy, "reused") );
+
+		// copy and move assignment onto targets on both sides of the boundary
+		for (uint32 j=0; j<numLengths; ++j)
+		{
+			const std::string targetText = MakeText(lengths[j], 'A');
+
+			String copyTarget(targetText.c_str());
+			copyTarget = source;
+			AssertTest( Matches(copyTarget, text) );
+
+			String moveSource(text.c_str());
+			String moveTarget(targetText.c_str());
+			moveTarget = std::move(moveSource);
+			AssertTest( Matches(moveTarget, text) && moveSource.IsEmpty() == true );
+		}
+
+		// self-assignment keeps the content
+		String self(text.c_str());
+		String& selfReference = self;
+		self = selfReference;
+		AssertTest( Matches(self, text) );
+		self = std::move(selfReference);
+		AssertTest( Matches(self, text) );
+	}
+
+	// format reaching and crossing 1024 bytes (and far beyond)
+	const uint32 formatLengths[] = { 23, 24, 1023, 1024, 1025, 5000 };
+	const uint32 numFormatLengths = sizeof(formatLengths) / sizeof(uint32);
+	for (uint32 i=0; i<numFormatLengths; ++i)
+	{
+		const std::string text = MakeText(formatLengths[i] - 4);
+
+		String formatted;
+		formatted.Format("%s%04i", text.c_str(), 42);
+		AssertTest( Matches(formatted, text + "0042") );
+
+		// formatting a shorter text into the grown buffer
+		formatted.Format("%i", 7);
+		AssertTest( Matches(formatted, "7") );
+	}
+
+	// format add on an inline string, across the boundary and onto the heap
+	String formatAdd("abc");
+	formatAdd.FormatAdd("%s", MakeText(19).c_str());
+	AssertTest( Matches(formatAdd, "abc" + MakeText(19)) );
+	formatAdd.FormatAdd("%c", 'x');
+	AssertTest( Matches(formatAdd, "abc" + MakeText(19) + "x") );
+	formatAdd.FormatAdd("%c", 'y');
+	AssertTest( Matches(formatAdd, "abc" + MakeText(19) + "xy") );
+
+	// format add on a heap string, first within and then beyond its capacity
+	const std::string heapText = MakeText(40);
+	String heapString(heapText.c_str());
+	heapString.Crop(0, 30);
+	heapString.FormatAdd("%i", 12345);
+	AssertTest( Matches(heapString, heapText.substr(0, 30) + "12345") );
+	heapString.FormatAdd("%s", MakeText(2000).c_str());
+	AssertTest( Matches(heapString, heapText.substr(0, 30) + "12345" + MakeText(2000)) );
+
+	// crop and remove a heap string back down to inline size
+	String cropped(heapText.c_str());
+	cropped.Crop(5, 10);
+	AssertTest( Matches(cropped, heapText.substr(5, 10)) );
+
+	String removed(heapText.c_str());
+	removed.Remove(3, 20);
+	AssertTest( Matches(removed, heapText.substr(0, 3) + heapText.substr(23)) );
+
+	// the shrunk strings are still fully usable
+	cropped += "!";
+	removed.FormatAdd("%i", 9);
+	String croppedCopy(cropped);
+	AssertTest( Matches(cropped, heapText.substr(5, 10) + "!") );
+	AssertTest( Matches(removed, heapText.substr(0, 3) + heapText.substr(23) + "9") );
+	AssertTest( Matches(croppedCopy, heapText.substr(5, 10) + "!") );
+}
@@ -13,6 +13,7 @@
 #include "LogsCreateRequest.h"
 #include "LogsCreateResponse.h"
 #include <QDateTime>
+#include <QThread>
 
 
 using namespace Core;
@@ -85,5 +86,13 @@ void BackendLogCallback::Log(const char* text, Core::ELogLevel logLevel)
 	if ((logLevel & LOGLEVEL_CRITICAL) == false)
 		return;
 
+	// the request has to be sent from the UI thread (the log manager may call us from its background thread)
+	if (QThread::currentThread() != thread())
+	{
+		const QString line = text;
+		QMetaObject::invokeMethod( this, [this, line, logLevel]() { ForceLog(line.toUtf8().data(), logLevel); }, Qt::QueuedConnection );
+		return;
+	}
+
 	ForceLog(text, logLevel);
 }
\ No newline at end of file
@@ -232,6 +232,9 @@ bool BackendUploader::UploadEntry(QueueEntry* entry)
 	// create the network request
 	QNetworkRequest request = mNetworkAccessManager->ConstructNetworkRequest( "datachunks/upload", urlParameters );
 
+	// uploads run in the background, session-critical requests go first
+	request.setPriority( QNetworkRequest::LowPriority );
+
 	// create the http multi part
 	QHttpMultiPart* httpMultiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
 	
@@ -9,19 +9,21 @@
 #include <Core/LogManager.h>
 #include <QNetworkRequest>
 #include <QNetworkReply>
+#include <QCoreApplication>
+#include <QFileInfo>
 
 
 using namespace Core;
 
 // constructor
-FileDownloader::FileDownloader(QUrl downloadFromUrl, const char* saveToFilename, QObject *parent) : QObject(parent)
+FileDownloader::FileDownloader(QUrl downloadFromUrl, const char* saveToFilename, QObject *parent) : QObject(parent), mContentHash(QCryptographicHash::Sha1)
 {
 	Init( downloadFromUrl, saveToFilename, MODE_SAVETOFILE );
 }
 
 
 // constructor
-FileDownloader::FileDownloader(QUrl downloadFromUrl, QObject *parent) : QObject(parent)
+FileDownloader::FileDownloader(QUrl downloadFromUrl, QObject *parent) : QObject(parent), mContentHash(QCryptographicHash::Sha1)
 {
 	Init( downloadFromUrl, NULL, MODE_KEEPINMEMORY );
 }
@@ -45,6 +47,9 @@ void FileDownloader::Init(QUrl downloadFromUrl, const char* saveToFilename, Mode
 	mNumFails			= 0;
 	mReply				= NULL;
 	mFile				= NULL;
+	mNAM				= GetSharedNetworkAccessManager();
+	mResumeOffset		= 0;
+	mResumeChecked		= false;
 	mTempBufferSize		= 100 * 1024;
 	String urlString	= mDownloadFromUrl.url().toLatin1().constData();
 
@@ -56,7 +61,9 @@ void FileDownloader::Init(QUrl downloadFromUrl, const char* saveToFilename, Mode
 
 			mSaveToTempFilename	= mSaveToFilename;
 			mSaveToTempFilename.RemoveFileExtension();
+			mSaveToValidatorFilename = mSaveToTempFilename;
 			mSaveToTempFilename += ".tmp";
+			mSaveToValidatorFilename += ".validator";
 			break;
 		}
 
@@ -64,6 +71,7 @@ void FileDownloader::Init(QUrl downloadFromUrl, const char* saveToFilename, Mode
 		{
 			mSaveToFilename.Clear();
 			mSaveToTempFilename.Clear();
+			mSaveToValidatorFilename.Clear();
 			break;
 		}
 
@@ -73,27 +81,61 @@ void FileDownloader::Init(QUrl downloadFromUrl, const char* saveToFilename, Mode
 			break;
 		}
 	}
+}
+
 
-	// connect to download finished signal
-	connect( &mNAM, SIGNAL(finished(QNetworkReply*)), this, SLOT(OnFileDownloaded(QNetworkReply*)) );
+// the network access manager shared by all downloaders (owned by the application)
+QNetworkAccessManager* FileDownloader::GetSharedNetworkAccessManager()
+{
+	static QNetworkAccessManager* networkAccessManager = new QNetworkAccessManager( QCoreApplication::instance() );
+	return networkAccessManager;
 }
 
 
 // start downloading
 void FileDownloader::Start()
 {
+	mResumeOffset = 0;
+	mResumeChecked = false;
+	mContentHash.reset();
+
+	// drop the data of an earlier failed attempt
+	if (mMode == MODE_KEEPINMEMORY)
+		mFileBuffer.clear();
+
+	QByteArray validator;
 	if (mMode == MODE_SAVETOFILE)
 	{
-		// remove temporary file before writing to it, so that we don't append
-		QFile::remove( mSaveToTempFilename.AsChar() );
+		// a partial file of an earlier attempt: append to it and only request the missing bytes (only if we know which version of the file it belongs to)
+		QFileInfo tempFileInfo( mSaveToTempFilename.AsChar() );
+		if (tempFileInfo.exists() == true)
+		{
+			validator = LoadValidator();
+			if (validator.isEmpty() == false)
+				mResumeOffset = tempFileInfo.size();
+		}
 
 		mFile = new QFile(mSaveToTempFilename.AsChar());
-		if (mFile->open(QIODevice::WriteOnly) == false)
+		if (mFile->open(mResumeOffset > 0 ? QIODevice::Append : QIODevice::WriteOnly) == false)
 		{
 			LogWarning( "FileDownloader::Start(): Cannot open file '%s' for writing.", mSaveToFilename.AsChar() );
 			mFile->close();
 			mFile->deleteLater();
 			mFile = NULL;
+			mResumeOffset = 0;
+		}
+
+		// hash the part we already have, the rest is hashed as it arrives
+		if (mFile != NULL && mResumeOffset > 0)
+		{
+			QFile partialFile(mSaveToTempFilename.AsChar());
+			if (partialFile.open(QIODevice::ReadOnly) == false || mContentHash.addData(&partialFile) == false)
+			{
+				LogWarning( "FileDownloader::Start(): Cannot read the partial file '%s', downloading it again.", mSaveToTempFilename.AsChar() );
+				mFile->resize(0);
+				mContentHash.reset();
+				mResumeOffset = 0;
+			}
 		}
 	}
 
@@ -107,8 +149,19 @@ void FileDownloader::Start()
 	QNetworkRequest request(mDownloadFromUrl);
 	request.setSslConfiguration(sslconf);
 
-	mReply = mNAM.get(request);
+	// HTTP range request for resuming, the server sends the whole file (200) in case it changed since the partial download
+	if (mResumeOffset > 0)
+	{
+		const QByteArray range = "bytes=" + QByteArray::number(mResumeOffset) + "-";
+		request.setRawHeader("Range", range);
+		request.setRawHeader("If-Range", validator);
+	}
 
+	mReply = mNAM->get(request);
+
+	// connect to the reply's finished signal (the network access manager is shared, its finished signal fires for all downloads)
+	QNetworkReply* reply = mReply;
+	connect( mReply, &QNetworkReply::finished, this, [this, reply]() { OnFileDownloaded(reply); } );
 	connect( mReply, SIGNAL(downloadProgress(qint64, qint64)), this, SLOT(OnDownloadProgressChanged(qint64, qint64)) );
 	connect( mReply, SIGNAL(readyRead()), this, SLOT(OnReadyRead()) );
 }
@@ -126,6 +179,24 @@ void FileDownloader::OnReadyRead()
 {
 	if (mReply != NULL)
 	{
+		// the server ignored the range request and sends the whole file: start over
+		if (mResumeChecked == false)
+		{
+			mResumeChecked = true;
+
+			const int statusCode = mReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+			if (mResumeOffset > 0 && statusCode != 206 && mFile != NULL)
+			{
+				mFile->resize(0);
+				mContentHash.reset();
+				mResumeOffset = 0;
+			}
+
+			// remember the version of the file we are downloading from the start
+			if (mMode == MODE_SAVETOFILE && mResumeOffset == 0)
+				SaveValidator(mReply);
+		}
+
 		mTempBuffer = mReply->read(mTempBufferSize);
 		while (mTempBuffer.size() > 0)
 		{
@@ -136,7 +207,10 @@ void FileDownloader::OnReadyRead()
 				case MODE_SAVETOFILE:
 				{
 					if (mFile != NULL)
+					{
 						mFile->write( mTempBuffer );
+						mContentHash.addData( mTempBuffer );
+					}
 
 					break;
 				}
@@ -172,15 +246,22 @@ void FileDownloader::OnFileDownloaded(QNetworkReply* reply)
 	{
 		// turn temp file into actual one
 		if (mMode == MODE_SAVETOFILE)
+		{
 			QFile::rename( mSaveToTempFilename.AsChar(), mSaveToFilename.AsChar() );
+			QFile::remove( mSaveToValidatorFilename.AsChar() );
+		}
 
 		emit FinishedDownload(this);
 	}
 	else
 	{
-		// remove temp file
-		if (mMode == MODE_SAVETOFILE)
+		// keep the partial file for resuming, unless the server rejected the request (e.g. an invalid range)
+		const int statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+		if (mMode == MODE_SAVETOFILE && statusCode >= 400)
+		{
 			QFile::remove( mSaveToTempFilename.AsChar() );
+			QFile::remove( mSaveToValidatorFilename.AsChar() );
+		}
 
 		String errorMsg;
 		errorMsg.Format( "%s (ErrorCode=%i).", reply->errorString().toLatin1().constData(), reply->error() );
@@ -192,4 +273,38 @@ void FileDownloader::OnFileDownloaded(QNetworkReply* reply)
 
 	reply->deleteLater();
 	mReply = NULL;
-}
\ No newline at end of file
+}
+
+
+// read the validator that was saved together with the partial file (empty if there is none)
+QByteArray FileDownloader::LoadValidator() const
+{
+	QFile file( mSaveToValidatorFilename.AsChar() );
+	if (file.open(QIODevice::ReadOnly) == false)
+		return QByteArray();
+
+	return file.readAll().trimmed();
+}
+
+
+// save the validator of the reply next to the partial file; weak ETags can't be used for range requests, Last-Modified is the fallback
+void FileDownloader::SaveValidator(QNetworkReply* reply)
+{
+	QByteArray validator = reply->rawHeader("ETag");
+	if (validator.startsWith("W/") == true)
+		validator.clear();
+
+	if (validator.isEmpty() == true)
+		validator = reply->rawHeader("Last-Modified");
+
+	// without validator the partial file can't be resumed safely
+	if (validator.isEmpty() == true)
+	{
+		QFile::remove( mSaveToValidatorFilename.AsChar() );
+		return;
+	}
+
+	QFile file( mSaveToValidatorFilename.AsChar() );
+	if (file.open(QIODevice::WriteOnly | QIODevice::Truncate) == true)
+		file.write(validator);
+}
@@ -13,6 +13,7 @@
 #include <QObject>
 #include <QUrl>
 #include <QFile>
+#include <QCryptographicHash>
 #include <QNetworkAccessManager>
 
 
@@ -36,10 +37,16 @@ class QTBASE_API FileDownloader : public QObject
 
 		void Start();
 
+		// all downloaders share one network access manager, so the keep-alive connections to a host are reused
+		static QNetworkAccessManager* GetSharedNetworkAccessManager();
+
 		QUrl GetUrl() const													{ return mDownloadFromUrl; }
 		uint32 GetNumFails() const											{ return mNumFails; }
 
 		const char* GetFilename()											{ return mSaveToFilename.AsChar(); }
+
+		// SHA1 of the downloaded file (save to file mode), hashed while the data arrives
+		QByteArray GetContentHash() const									{ return mContentHash.result(); }
 		const QByteArray& GetFileBuffer()									{ return mFileBuffer; }
 
 	signals:
@@ -55,19 +62,27 @@ class QTBASE_API FileDownloader : public QObject
 	private:
 		void Init(QUrl downloadFromUrl, const char* saveToFilename, Mode mode);
 
+		// the validator (strong ETag or Last-Modified) of the partial file, so a resumed download only appends to the same version of the file
+		QByteArray LoadValidator() const;
+		void SaveValidator(QNetworkReply* reply);
+
 		Mode					mMode;
 
 		QUrl					mDownloadFromUrl;
 		QNetworkReply*			mReply;
-		QNetworkAccessManager	mNAM;
+		QNetworkAccessManager*	mNAM;
 		uint32					mNumFails;
 
 		// save to file mode
 		Core::String			mSaveToFilename;
 		Core::String			mSaveToTempFilename;
+		Core::String			mSaveToValidatorFilename;
 		QFile*					mFile;
 		uint32					mTempBufferSize;
 		QByteArray				mTempBuffer;
+		qint64					mResumeOffset;
+		bool					mResumeChecked;
+		QCryptographicHash		mContentHash;
 
 		// save to memory mode
 		QByteArray				mFileBuffer;
@@ -23,6 +23,10 @@ FileSystemGetRequest::FileSystemGetRequest(const char* token, const char* userId
 	// request method
 	SetRequestMethod( REQUESTMETHOD_GET );
 
+	// the listing/file may have changed on the server: validate the cached response instead of blindly using it
+	SetCacheControl( CACHE_VALIDATE );
+	SetPriority( PRIORITY_CRITICAL );
+
 
 	// url parameters
 
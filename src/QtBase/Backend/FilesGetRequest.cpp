@@ -24,6 +24,10 @@ FilesGetRequest::FilesGetRequest(const char* token, const char* fileId, int revi
 	// request method
 	SetRequestMethod( REQUESTMETHOD_GET );
 
+	// the listing/file may have changed on the server: validate the cached response instead of blindly using it
+	SetCacheControl( CACHE_VALIDATE );
+	SetPriority( PRIORITY_CRITICAL );
+
 	// url parameters
 	AddUrlParameter( "token", token );
 	if (revision != -1)
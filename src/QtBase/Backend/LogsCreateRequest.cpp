@@ -23,6 +23,7 @@ LogsCreateRequest::LogsCreateRequest(const char* token, const char* text, ELogLe
 
 	// request method
 	SetRequestMethod( REQUESTMETHOD_POST );
+	SetPriority( PRIORITY_BACKGROUND );
 
 	// url parameters
 	AddUrlParameter( "token", token );
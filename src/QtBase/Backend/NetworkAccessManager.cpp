@@ -298,6 +298,36 @@ QUrl NetworkAccessManager::ConstructUrl(const Request& request)
 }
 
 
+// settings shared by all request methods
+void NetworkAccessManager::ConfigureNetworkRequest(QNetworkRequest& networkRequest, const Request& request)
+{
+	// configure ssl
+	networkRequest.setSslConfiguration( mSslConfig );
+
+	// all requests go through the same network access manager and share its keep-alive connections (up to six per host);
+	// queued high priority requests are sent before low priority ones once a connection becomes free
+	switch (request.GetPriority())
+	{
+		case Request::PRIORITY_CRITICAL:	{ networkRequest.setPriority( QNetworkRequest::HighPriority ); break; }
+		case Request::PRIORITY_NORMAL:		{ networkRequest.setPriority( QNetworkRequest::NormalPriority ); break; }
+		case Request::PRIORITY_BACKGROUND:	{ networkRequest.setPriority( QNetworkRequest::LowPriority ); break; }
+	}
+}
+
+
+// map the cache control of a request to the attributes of the disk cache
+void NetworkAccessManager::ConfigureCacheControl(QNetworkRequest& networkRequest, Request::CacheControl cacheControl)
+{
+	switch (cacheControl)
+	{
+		case Request::CACHE_ALWAYSLOAD:		{ networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork); break; }
+		case Request::CACHE_PREFERCACHE:	{ networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache); break; }
+		// the disk cache sends If-None-Match/If-Modified-Since for stale entries and serves the cached body on a 304 reply
+		case Request::CACHE_VALIDATE:		{ networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork); networkRequest.setAttribute(QNetworkRequest::CacheSaveControlAttribute, true); break; }
+	}
+}
+
+
 QNetworkReply* NetworkAccessManager::ProcessRequest(const Request& request, Request::UiMode uiMode, bool disableLogging)
 {
 	mTimer.GetTimeDelta();
@@ -344,10 +374,10 @@ QNetworkReply* NetworkAccessManager::ProcessRequest(const Request& request, Requ
 			QNetworkRequest networkRequest(url);
 
 			// cache control
-			networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
+			ConfigureCacheControl( networkRequest, request.GetCacheControl() );
 
-			// configure ssl
-			networkRequest.setSslConfiguration( mSslConfig );
+			// configure ssl & priority
+			ConfigureNetworkRequest( networkRequest, request );
 
 			reply = mNetworkAccessManager->get( networkRequest );
 			reply->setProperty( "uiMode", uiMode );
@@ -372,8 +402,8 @@ QNetworkReply* NetworkAccessManager::ProcessRequest(const Request& request, Requ
 			// create the network request
 			QNetworkRequest networkRequest(url);
 
-			// configure ssl
-			networkRequest.setSslConfiguration( mSslConfig );
+			// configure ssl & priority
+			ConfigureNetworkRequest( networkRequest, request );
 
 			// header & body
 			if (bodyString.IsEmpty() == false)
@@ -402,8 +432,8 @@ QNetworkReply* NetworkAccessManager::ProcessRequest(const Request& request, Requ
 			// create the network request
 			QNetworkRequest networkRequest(url);
 
-			// configure ssl
-			networkRequest.setSslConfiguration( mSslConfig );
+			// configure ssl & priority
+			ConfigureNetworkRequest( networkRequest, request );
 
 			// header & body
 			if (bodyString.IsEmpty() == false)
@@ -432,8 +462,8 @@ QNetworkReply* NetworkAccessManager::ProcessRequest(const Request& request, Requ
 			// create the network request
 			QNetworkRequest networkRequest(url);
 
-			// configure ssl
-			networkRequest.setSslConfiguration( mSslConfig );
+			// configure ssl & priority
+			ConfigureNetworkRequest( networkRequest, request );
 
 			reply = mNetworkAccessManager->deleteResource( networkRequest );
 			reply->setProperty( "uiMode", uiMode );
@@ -55,6 +55,9 @@ class QTBASE_API NetworkAccessManager : public QObject
 		QNetworkReply* ProcessRequestAsync(const Request& request)					{ return ProcessRequest(request, Request::UIMODE_ASYNC); }
 
 		QNetworkRequest ConstructNetworkRequest(const Core::String& methodName, const Core::String& parameters);
+
+		// set the disk cache attributes of the network request for the given cache control
+		static void ConfigureCacheControl(QNetworkRequest& networkRequest, Request::CacheControl cacheControl);
     
         void LogSslCertificate(QSslCertificate certificate);
 
@@ -81,6 +84,7 @@ class QTBASE_API NetworkAccessManager : public QObject
 
 		QUrl ConstructUrl(const Core::String& methodName, const Core::String& parameters="");
 		QUrl ConstructUrl(const Request& request);
+		void ConfigureNetworkRequest(QNetworkRequest& networkRequest, const Request& request);
 
 		QNetworkAccessManager*		mNetworkAccessManager;
 
@@ -22,7 +22,9 @@ Request::UrlParameter::UrlParameter(const char* name, const char* value)
 // constructor
 Request::Request()
 {
-	mRequestMethod = REQUESTMETHOD_GET;
+	mRequestMethod	= REQUESTMETHOD_GET;
+	mPriority		= PRIORITY_NORMAL;
+	mCacheControl	= CACHE_PREFERCACHE;
 }
 
 
@@ -29,7 +29,16 @@ class QTBASE_API Request
 		enum CacheControl
 		{
 			CACHE_ALWAYSLOAD,
-			CACHE_PREFERCACHE
+			CACHE_PREFERCACHE,
+			CACHE_VALIDATE			// revalidate stale cached responses via ETag/Last-Modified, a 304 reply is served from the cache
+		};
+
+		// session-critical requests are sent before background ones (e.g. uploads) on the shared host connections
+		enum Priority
+		{
+			PRIORITY_CRITICAL,
+			PRIORITY_NORMAL,
+			PRIORITY_BACKGROUND
 		};
 
 		enum UiMode
@@ -78,12 +87,20 @@ class QTBASE_API Request
 		void SetDisplayText(const char* displayText);
 		const char* GetDisplayText() const;
 
+		// scheduling & caching (GET requests only)
+		void SetPriority(Priority priority)					{ mPriority = priority; }
+		Priority GetPriority() const						{ return mPriority; }
+		void SetCacheControl(CacheControl cacheControl)		{ mCacheControl = cacheControl; }
+		CacheControl GetCacheControl() const				{ return mCacheControl; }
+
 	private:
 		Core::String		mUrl;
 		QUrlQuery			mUrlParameters;
 		Method				mRequestMethod;
 		Core::String		mDisplayText;
 		Core::Json			mBodyJson;
+		Priority			mPriority;
+		CacheControl		mCacheControl;
 };
 
 
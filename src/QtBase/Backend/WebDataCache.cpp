@@ -11,6 +11,7 @@
 #include "../QtBaseManager.h"
 #include <QCryptographicHash>
 #include <QDir>
+#include <QDateTime>
 
 
 using namespace Core;
@@ -21,6 +22,14 @@ WebDataCache::WebDataCache(const char* subfolderPath, QObject *parent) : QObject
 	mFolder = GetQtBaseManager()->GetAppDataFolder() + String(subfolderPath);
 	mFolder.ConvertToNativePath();
 
+	mBlobFolder = mFolder + "Blobs/";
+	mBlobFolder.ConvertToNativePath();
+	mDownloadFolder = mFolder + "Downloads/";
+	mDownloadFolder.ConvertToNativePath();
+	mIndexFilename = mFolder + "Index.txt";
+	mIndexFilename.ConvertToNativePath();
+	mIndexDirty = false;
+
 	// make sure the cache folder exists
 	QDir cacheDir(mFolder.AsChar());
 	if (cacheDir.mkpath(mFolder.AsChar()) == false)
@@ -29,13 +38,20 @@ WebDataCache::WebDataCache(const char* subfolderPath, QObject *parent) : QObject
     if (cacheDir.exists() == false)
         LogError("WebDataCache: Cache folder '%s' doesn't exist.", mFolder.AsChar());
 
+	cacheDir.mkpath(mBlobFolder.AsChar());
+	cacheDir.mkpath(mDownloadFolder.AsChar());
+
+	LoadIndex();
+
 	mStatusWindow					= NULL;
 	mCurrentDownload				= 0;
 	mMaxNumFails					= 4;
+	mMaxConcurrentDownloadsPerHost	= 4;
 	mMaxCacheRestrictionEnabled		= false;
 	mMaxCacheSizeInMb				= 1024; // 1GB default
 	mMaxAliveTimeRestrictionEnabled	= false;
 	mMaxAliveTimeInDays				= 90; // 3 months default
+	mMaxPartialDownloadAgeInDays	= 7;
 
 #ifndef PRODUCTION_BUILD
 	// log
@@ -47,6 +63,8 @@ WebDataCache::WebDataCache(const char* subfolderPath, QObject *parent) : QObject
 // destructor
 WebDataCache::~WebDataCache()
 {
+	if (mIndexDirty == true)
+		SaveIndex();
 }
 
 
@@ -57,7 +75,7 @@ bool WebDataCache::Download(const Core::Array<Core::String>& urls)
 
 	// in case we are already downloading
 	// don't skip in case there is no file to download here!
-	if (IsDownloading() == true)
+	if (CalcNumForegroundDownloads() > 0)
 		return false;
 
 	// we're ready here already
@@ -68,19 +86,14 @@ bool WebDataCache::Download(const Core::Array<Core::String>& urls)
 		return true;
 	}
 
-	// create a download item for each url
-	mDownloadQueue.Resize( numUrls );
-	String downloadFromUrl, saveToFilename;
+	// create a download item for each url (files that are already being prefetched become part of this download)
 	for (uint32 i=0; i<numUrls; ++i)
 	{
-		downloadFromUrl	= urls[i];
-		saveToFilename	= UrlToFilename( downloadFromUrl.AsChar() );
-
-		FileDownloader* downloader = new FileDownloader( QUrl(downloadFromUrl.AsChar()), saveToFilename.AsChar(), this );
-		connect( downloader, SIGNAL(FinishedDownload(FileDownloader*)), this, SLOT(OnFileDownloaded(FileDownloader*)) );
-		connect( downloader, SIGNAL(DownloadFailed(FileDownloader*)), this, SLOT(OnFileFailed(FileDownloader*)) );
-		connect( downloader, SIGNAL(DownloadProgressChanged(qint64, qint64)), this, SLOT(OnDownloadProgressChanged(qint64, qint64)) );
-		mDownloadQueue[i] = downloader;
+		FileDownloader* downloader = FindQueuedDownload( urls[i].AsChar() );
+		if (downloader == NULL)
+			downloader = Enqueue( urls[i].AsChar() );
+
+		downloader->setProperty( "foreground", true );
 	}
 
 	// start downloading the queue
@@ -90,6 +103,74 @@ bool WebDataCache::Download(const Core::Array<Core::String>& urls)
 }
 
 
+// queue files for downloading in the background
+void WebDataCache::Prefetch(const Core::Array<Core::String>& urls)
+{
+	bool added = false;
+
+	const uint32 numUrls = urls.Size();
+	for (uint32 i=0; i<numUrls; ++i)
+	{
+		const char* url = urls[i].AsChar();
+		if (FileExists(url) == true || FindQueuedDownload(url) != NULL)
+			continue;
+
+		Enqueue(url);
+		added = true;
+	}
+
+	if (added == true)
+		DownloadNext();
+}
+
+
+// create a download item for the url and add it to the queue
+FileDownloader* WebDataCache::Enqueue(const char* url)
+{
+	const String saveToFilename = UrlToFilename(url);
+
+	FileDownloader* downloader = new FileDownloader( QUrl(url), saveToFilename.AsChar(), this );
+	connect( downloader, SIGNAL(FinishedDownload(FileDownloader*)), this, SLOT(OnFileDownloaded(FileDownloader*)) );
+	connect( downloader, SIGNAL(DownloadFailed(FileDownloader*)), this, SLOT(OnFileFailed(FileDownloader*)) );
+	connect( downloader, SIGNAL(DownloadProgressChanged(qint64, qint64)), this, SLOT(OnDownloadProgressChanged(qint64, qint64)) );
+	mDownloadQueue.Add(downloader);
+
+	return downloader;
+}
+
+
+// find the queued download item for the url
+FileDownloader* WebDataCache::FindQueuedDownload(const char* url) const
+{
+	const QUrl qUrl(url);
+
+	const uint32 numDownloads = mDownloadQueue.Size();
+	for (uint32 i=0; i<numDownloads; ++i)
+	{
+		if (mDownloadQueue[i]->GetUrl() == qUrl)
+			return mDownloadQueue[i];
+	}
+
+	return NULL;
+}
+
+
+// number of queued files somebody is waiting for
+uint32 WebDataCache::CalcNumForegroundDownloads() const
+{
+	uint32 result = 0;
+
+	const uint32 numDownloads = mDownloadQueue.Size();
+	for (uint32 i=0; i<numDownloads; ++i)
+	{
+		if (mDownloadQueue[i]->property("foreground").toBool() == true)
+			result++;
+	}
+
+	return result;
+}
+
+
 // start downloading all items in the queue
 void WebDataCache::Start()
 {
@@ -101,7 +182,7 @@ void WebDataCache::Start()
 	mStatusWindow = GetQtBaseManager()->GetStatusPopupManager()->Create();
 
 	// store the number of items to download that are in the queue at the beginning
-	mNumDownloadItems = mDownloadQueue.Size();
+	mNumDownloadItems = CalcNumForegroundDownloads();
 	mCurrentDownload = 0;
 
 	DownloadNext();
@@ -111,6 +192,11 @@ void WebDataCache::Start()
 // called when a download status changed
 void WebDataCache::OnDownloadProgressChanged(qint64 bytesReceived, qint64 bytesTotal)
 {
+	// several files are downloaded at once: show the one that reported last
+	FileDownloader* downloader = qobject_cast<FileDownloader*>( sender() );
+	if (downloader != NULL)
+		mCurrentUrl = downloader->GetUrl().url().toLatin1().constData();
+
 	mCurrentBytesReceived	= bytesReceived;
 	mCurrentBytesTotal		= bytesTotal;
 
@@ -153,60 +239,97 @@ void WebDataCache::UpdateProgressBar()
 }
 
 
-// start downloading the next file in the queue
+// start downloading the next files in the queue (up to the max number of concurrent downloads per host)
 void WebDataCache::DownloadNext()
 {
+	// all files somebody is waiting for are there (prefetched files may still be downloading)
+	if (mStatusWindow != NULL && CalcNumForegroundDownloads() == 0)
+	{
+		// hide and destruct the status popup window
+		GetQtBaseManager()->GetStatusPopupManager()->Remove(mStatusWindow);
+		mStatusWindow = NULL;
+
+		emit FinishedDownload();
+	}
+
 	// return directly in case the download queue is empty
 	if (mDownloadQueue.IsEmpty() == true)
+		return;
+
+	uint32 i = 0;
+	while (i < mDownloadQueue.Size())
 	{
-		// hide and destruct the status popup window
-		if (mStatusWindow != NULL)
+		FileDownloader* downloader = mDownloadQueue[i];
+
+		// already downloading
+		if (mActiveDownloads.Contains(downloader) == true)
 		{
-			GetQtBaseManager()->GetStatusPopupManager()->Remove(mStatusWindow);
+			++i;
+			continue;
 		}
 
-		emit FinishedDownload();
-		return;
-	}
+		String url = downloader->GetUrl().url().toLatin1().constData();
 
-	const uint32 randomNext = Min<uint32>( Math::RandSmallRange( 0, mDownloadQueue.Size() ), mDownloadQueue.Size()-1 );
-	FileDownloader* downloader = mDownloadQueue[randomNext];
-	//LogInfo("Random next download is nr %i", randomNext);
+		// check if the download failed too often already, if yes, just remove it from the queue
+		if (downloader->GetNumFails() >= mMaxNumFails)
+		{
+			LogInfo("WebDataCache: Download failed %i times '%s'. Skipping file.", mMaxNumFails, url.AsChar() );
+			RemoveFromQueue(downloader);
+			continue;
+		}
 
-	String url = downloader->GetUrl().url().toLatin1().constData();
+		if (FileExists(url.AsChar()) == true)
+		{
+			LogInfo("WebDataCache: Skipping download for '%s'. File already downloaded.", url.AsChar() );
+			RemoveFromQueue(downloader);
+			continue;
+		}
 
-	// check if the download failed too often already, if yes, just remove it from the queue
-	if (downloader->GetNumFails() >= mMaxNumFails)
-	{
-		LogInfo("WebDataCache: Download failed %i times '%s'. Skipping file.", mMaxNumFails, url.AsChar() );
-		RemoveFromQueue(downloader);
-		DownloadNext();
-		return;
-	}
+		// the host is busy with other downloads, keep the file in the queue
+		if (CalcNumActiveDownloads(downloader->GetUrl().host()) >= mMaxConcurrentDownloadsPerHost)
+		{
+			++i;
+			continue;
+		}
 
-	mCurrentUrl				= url;
-	mCurrentBytesReceived	= 0;
-	mCurrentBytesTotal		= 0;
+		mCurrentUrl				= url;
+		mCurrentBytesReceived	= 0;
+		mCurrentBytesTotal		= 0;
 
-	UpdateProgressBar();
+		UpdateProgressBar();
 
-	if (FileExists(url.AsChar()) == true)
-	{
-		LogInfo("WebDataCache: Skipping download for '%s'. File already downloaded.", url.AsChar() );
-		RemoveFromQueue(downloader);
-		DownloadNext();
-	}
-	else
-	{
 		LogInfo("WebDataCache: Starting download '%s'", url.AsChar() );
+		mActiveDownloads.Add(downloader);
 		downloader->Start();
+		++i;
 	}
+
+	// all remaining foreground files were skipped
+	if (mStatusWindow != NULL && CalcNumForegroundDownloads() == 0)
+		DownloadNext();
+}
+
+
+// get the number of running downloads from the given host
+uint32 WebDataCache::CalcNumActiveDownloads(const QString& host) const
+{
+	uint32 result = 0;
+
+	const uint32 numActiveDownloads = mActiveDownloads.Size();
+	for (uint32 i=0; i<numActiveDownloads; ++i)
+	{
+		if (mActiveDownloads[i]->GetUrl().host() == host)
+			result++;
+	}
+
+	return result;
 }
 
 
 void WebDataCache::RemoveFromQueue(FileDownloader* downloader)
 {
 	mDownloadQueue.RemoveByValue(downloader);
+	mActiveDownloads.RemoveByValue(downloader);
 	downloader->deleteLater();
 }
 
@@ -216,8 +339,13 @@ void WebDataCache::OnFileDownloaded(FileDownloader* downloader)
 	String url = downloader->GetUrl().url().toLatin1().constData();
 	LogInfo("WebDataCache: Finished download '%s'", url.AsChar() );
 
+	// move the file into the content-addressed storage
+	if (StoreBlob(url.AsChar(), downloader->GetFilename(), downloader->GetContentHash()) == true)
+		SaveIndex();
+
 	// increase the current download
-	mCurrentDownload++;
+	if (downloader->property("foreground").toBool() == true)
+		mCurrentDownload++;
 
 	RemoveFromQueue(downloader);
 
@@ -230,29 +358,35 @@ void WebDataCache::OnFileFailed(FileDownloader* downloader)
 	String url = downloader->GetUrl().url().toLatin1().constData();
 	LogWarning("WebDataCache: Failed downloading '%s'", url.AsChar() );
 
+	// keep it in the queue, it is retried until it failed too often
+	mActiveDownloads.RemoveByValue(downloader);
+
 	DownloadNext();
 }
 
 
 bool WebDataCache::FileExists(const char* url)
 {
-	return QFile::exists( UrlToFilename(url).AsChar() );
+	const uint32 index = FindIndexEntry(url);
+	if (index == CORE_INVALIDINDEX32)
+		return false;
+
+	return QFile::exists( GetBlobFilename(mIndex[index].mBlob).AsChar() );
 }
 
 
+// the download file is named after the hash of the url, so an interrupted download is resumed on the next attempt
 String WebDataCache::UrlToFilename(const char* url)
 {
-	QByteArray base64Data = url;
-	String safeBase64String = base64Data.toBase64().constData();
-	safeBase64String.Replace( StringCharacter('/'), StringCharacter('_') );
-
 	mTempString = url;
 
+	const QByteArray urlHash = QCryptographicHash::hash( QByteArray(url), QCryptographicHash::Sha1 ).toHex();
+
 	String result;
 	result.Reserve( 4096 );
 
-	result = mFolder;
-	result += safeBase64String;
+	result = mDownloadFolder;
+	result += urlHash.constData();
 	result += ".";
 	result += mTempString.ExtractFileExtension();
 	
@@ -260,113 +394,260 @@ String WebDataCache::UrlToFilename(const char* url)
 }
 
 
-String WebDataCache::FilenameToUrl(const char* filename)
+// checks if the file is cached and returns the cache file name in this case, otherwise the url is returned
+Core::String WebDataCache::GetCacheFilenameForUrl(const char* url)
 {
-	String result = QByteArray::fromBase64( filename ).constData();
-	result.Replace( StringCharacter('_'), StringCharacter('/') );
-	return result;
+	const uint32 index = FindIndexEntry(url);
+	if (index == CORE_INVALIDINDEX32)
+		return url;
+
+	String filename = GetBlobFilename(mIndex[index].mBlob);
+	if (QFile::exists(filename.AsChar()) == false)
+		return url;
+
+	// least recently used eviction
+	mIndex[index].mLastAccess = QDateTime::currentSecsSinceEpoch();
+	mIndexDirty = true;
+
+	return filename;
 }
 
 
-// checks if the file is cached and returns the cache file name in this case, otherwise the url is returned
-Core::String WebDataCache::GetCacheFilenameForUrl(const char* url)
+// find the index entry of the url
+uint32 WebDataCache::FindIndexEntry(const char* url) const
+{
+	const uint32 numEntries = mIndex.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		if (mIndex[i].mUrl.IsEqual(url) == true)
+			return i;
+	}
+
+	return CORE_INVALIDINDEX32;
+}
+
+
+// move a downloaded file to the blob storage, named by its content hash (identical files of different urls are only stored once)
+bool WebDataCache::StoreBlob(const char* url, const char* downloadedFilename, const QByteArray& contentHash)
 {
-	if (FileExists(url) == true)
-		return UrlToFilename(url);
+	QFileInfo fileInfo(downloadedFilename);
+	if (fileInfo.exists() == false)
+	{
+		LogError( "WebDataCache: Cannot find downloaded file '%s'.", downloadedFilename );
+		return false;
+	}
 
-	return url;
+	const uint64 size = fileInfo.size();
+
+	mTempString = downloadedFilename;
+	String blob = contentHash.toHex().constData();
+	blob += ".";
+	blob += mTempString.ExtractFileExtension();
+
+	// the content is already stored (for another url)
+	const String blobFilename = GetBlobFilename(blob);
+	if (QFile::exists(blobFilename.AsChar()) == true)
+		QFile::remove(downloadedFilename);
+	else if (QFile::rename(downloadedFilename, blobFilename.AsChar()) == false)
+	{
+		LogError( "WebDataCache: Cannot move downloaded file '%s' to '%s'.", downloadedFilename, blobFilename.AsChar() );
+		return false;
+	}
+
+	// add or update the index entry
+	uint32 index = FindIndexEntry(url);
+	if (index == CORE_INVALIDINDEX32)
+	{
+		index = mIndex.Size();
+		mIndex.AddEmpty();
+		mIndex[index].mUrl = url;
+	}
+
+	IndexEntry& entry = mIndex[index];
+	entry.mBlob			= blob;
+	entry.mSize			= size;
+	entry.mLastAccess	= QDateTime::currentSecsSinceEpoch();
+
+	mIndexDirty = true;
+	return true;
+}
+
+
+// remove a blob and all index entries that refer to it
+void WebDataCache::RemoveBlob(const String& blob)
+{
+	const String blobFilename = GetBlobFilename(blob);
+	if (QFile::remove(blobFilename.AsChar()) == true)
+		LogInfo( "Removing file '%s' from cache.", blobFilename.AsChar() );
+	else if (QFile::exists(blobFilename.AsChar()) == true)
+		LogError( "Failed to remove file '%s' from cache.", blobFilename.AsChar() );
+
+	for (int32 i=mIndex.Size()-1; i>=0; --i)
+	{
+		if (mIndex[i].mBlob == blob)
+			mIndex.Remove(i);
+	}
+
+	mIndexDirty = true;
+}
+
+
+// read the index file (one line per url: blob, size, last access, url)
+void WebDataCache::LoadIndex()
+{
+	mIndex.Clear();
+	mIndexDirty = false;
+
+	QFile file(mIndexFilename.AsChar());
+	if (file.open(QIODevice::ReadOnly | QIODevice::Text) == false)
+		return;
+
+	while (file.atEnd() == false)
+	{
+		const QList<QByteArray> fields = file.readLine().trimmed().split('\t');
+		if (fields.size() != 4)
+			continue;
+
+		IndexEntry entry;
+		entry.mBlob			= fields[0].constData();
+		entry.mSize			= fields[1].toULongLong();
+		entry.mLastAccess	= fields[2].toLongLong();
+		entry.mUrl			= fields[3].constData();
+		mIndex.Add(entry);
+	}
+}
+
+
+// write the index file
+void WebDataCache::SaveIndex()
+{
+	QFile file(mIndexFilename.AsChar());
+	if (file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate) == false)
+	{
+		LogError( "WebDataCache: Cannot write index file '%s'.", mIndexFilename.AsChar() );
+		return;
+	}
+
+	String line;
+	const uint32 numEntries = mIndex.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		const IndexEntry& entry = mIndex[i];
+		line.Format( "%s\t%llu\t%lld\t%s\n", entry.mBlob.AsChar(), (unsigned long long)entry.mSize, (long long)entry.mLastAccess, entry.mUrl.AsChar() );
+		file.write( line.AsChar(), line.GetLength() );
+	}
+
+	mIndexDirty = false;
 }
 
 
 // clean cache
 bool WebDataCache::CleanCache()
 {
-	// remove files based on the max cache size restriction
-	if (mMaxCacheRestrictionEnabled == true)
+	// forget urls whose file is gone
+	for (int32 i=mIndex.Size()-1; i>=0; --i)
 	{
-		// calculate the currently used and the exceeded cache sizes
-		const uint64 usedCacheSizeInMb	= CalcUsedCacheSizeInBytes() / 1024 / 1024;
-		const int64 exceededCacheSize	= usedCacheSizeInMb - mMaxCacheSizeInMb;
-
-		// check if the cache exceeded the limit
-		if (exceededCacheSize > 0)
+		if (QFile::exists(GetBlobFilename(mIndex[i].mBlob).AsChar()) == false)
 		{
-			// cache exceeded the limit, remove files!
+			mIndex.Remove(i);
+			mIndexDirty = true;
+		}
+	}
 
-			// date sorted cache folder (oldest on top)
-			QDir cacheFolder( mFolder.AsChar() );
-			cacheFolder.setSorting( QDir::Time | QDir::Reversed );
-	
-			// get the filenames of all files in our directory
-			QList<QFileInfo>	fileInfos	= cacheFolder.entryInfoList(QDir::NoDotAndDotDot | QDir::Files);
-			const uint32		numFiles	= fileInfos.count();
+	// remove files that are not in the index (interrupted moves, files of the old url based cache layout)
+	QDir blobFolder( mBlobFolder.AsChar() );
+	QList<QFileInfo> blobInfos = blobFolder.entryInfoList(QDir::NoDotAndDotDot | QDir::Files);
+	for (const QFileInfo& fileInfo : blobInfos)
+	{
+		String blob = FromQtString( fileInfo.fileName() );
+
+		bool referenced = false;
+		const uint32 numEntries = mIndex.Size();
+		for (uint32 i=0; i<numEntries && referenced == false; ++i)
+			referenced = (mIndex[i].mBlob == blob);
+
+		if (referenced == false)
+			QFile::remove( fileInfo.filePath() );
+	}
+
+	QDir cacheFolder( mFolder.AsChar() );
+	QList<QFileInfo> legacyInfos = cacheFolder.entryInfoList(QDir::NoDotAndDotDot | QDir::Files);
+	for (const QFileInfo& fileInfo : legacyInfos)
+	{
+		if (fileInfo.filePath() != QFileInfo(mIndexFilename.AsChar()).filePath())
+			QFile::remove( fileInfo.filePath() );
+	}
+
+	// remove partial downloads (and their validators) that were not resumed for too long, running downloads keep writing to them
+	const QDateTime partialDeadline = QDateTime::currentDateTime().addDays( -(qint64)mMaxPartialDownloadAgeInDays );
+	QDir downloadFolder( mDownloadFolder.AsChar() );
+	QList<QFileInfo> downloadInfos = downloadFolder.entryInfoList(QDir::NoDotAndDotDot | QDir::Files);
+	for (const QFileInfo& fileInfo : downloadInfos)
+	{
+		if (fileInfo.lastModified() < partialDeadline)
+			QFile::remove( fileInfo.filePath() );
+	}
+
+	// remove files based on the max alive time restriction (files that were not used for too long)
+	if (mMaxAliveTimeRestrictionEnabled == true)
+	{
+		const int64 deadline = QDateTime::currentSecsSinceEpoch() - (int64)mMaxAliveTimeInDays * 24 * 60 * 60;
 
-			// iterate until we removed enough files to be under the max cache size limit
-			float removedFileSizeInMb = 0.0f;
-			for (uint32 i=0; i<numFiles; ++i)
+		for (int32 i=mIndex.Size()-1; i>=0; --i)
+		{
+			if (i >= (int32)mIndex.Size())
+				continue;
+
+			// a blob is kept as long as any of its urls was used recently
+			const String blob = mIndex[i].mBlob;
+			int64 lastAccess = 0;
+			const uint32 numEntries = mIndex.Size();
+			for (uint32 j=0; j<numEntries; ++j)
 			{
-				const QFileInfo& fileInfo = fileInfos[i];
-
-				if (QFile::remove(fileInfo.filePath()) == true)
-				{
-					LogInfo( "Removing file '%s' from cache.", FromQtString( fileInfo.filePath() ).AsChar() );
-					removedFileSizeInMb += fileInfo.size() / 1024 / 1024;
-				}
-				else
-					LogError( "Failed to remove file '%s' from cache.", FromQtString( fileInfo.filePath() ).AsChar() );
-
-				// stop removing files in case we're under the the limit again
-				if (removedFileSizeInMb > exceededCacheSize)
-					break;
+				if (mIndex[j].mBlob == blob)
+					lastAccess = Max<int64>(lastAccess, mIndex[j].mLastAccess);
 			}
 
-			#ifndef PRODUCTION_BUILD
-				const uint64 newUsedCacheSizeInMb = CalcUsedCacheSizeInBytes() / 1024 / 1024;
-				LogInfo("New Cache Size: %d", newUsedCacheSizeInMb);
-			#endif
+			if (lastAccess < deadline)
+			{
+				LogInfo( "WebDataCache: '%s' was not used for %i days.", mIndex[i].mUrl.AsChar(), mMaxAliveTimeInDays );
+				RemoveBlob(blob);
+			}
 		}
 	}
 
-	// remove files based on the max alive time restriction
-	if (mMaxAliveTimeRestrictionEnabled == true)
+	// remove the least recently used files based on the max cache size restriction
+	if (mMaxCacheRestrictionEnabled == true)
 	{
-			// remove all files older than XX days
-
-			// date sorted cache folder (oldest on top)
-			QDir cacheFolder( mFolder.AsChar() );
-			cacheFolder.setSorting( QDir::Time | QDir::Reversed );
-	
-			// get the filenames of all files in our directory
-			QList<QFileInfo>	fileInfos	= cacheFolder.entryInfoList(QDir::NoDotAndDotDot | QDir::Files);
-			const uint32		numFiles	= fileInfos.count();
+		const uint64 maxCacheSize = mMaxCacheSizeInMb * 1024 * 1024;
+		uint64 usedCacheSize = CalcUsedCacheSizeInBytes();
 
-			// iterate until we found a file newer than our deadline
-			for (uint32 i=0; i<numFiles; ++i)
+		while (usedCacheSize > maxCacheSize && mIndex.IsEmpty() == false)
+		{
+			// find the least recently used entry
+			uint32 lruIndex = 0;
+			const uint32 numEntries = mIndex.Size();
+			for (uint32 i=1; i<numEntries; ++i)
 			{
-				const QFileInfo& fileInfo = fileInfos[i];
-
-				QDateTime currentDateTime = QDateTime::currentDateTime();
-				QDateTime lastModifiedDate = fileInfo.lastModified();
-
-				// check if a given file is too old
-				if (lastModifiedDate.daysTo(currentDateTime) > mMaxAliveTimeInDays)
-				{
-					if (QFile::remove(fileInfo.filePath()) == true)
-					{
-						LogInfo( "Removing file '%s' from cache (too old).", FromQtString( fileInfo.filePath() ).AsChar() );
-					}
-					else
-						LogError( "Failed to remove file '%s' from cache.", FromQtString( fileInfo.filePath() ).AsChar() );
-				}
-				else
-				{
-					// break the loop as soon as we reach a file younger than our deadline
-					// we can do that cause we sorted the files from old to new
-					break;
-				}
+				if (mIndex[i].mLastAccess < mIndex[lruIndex].mLastAccess)
+					lruIndex = i;
 			}
+
+			const String blob = mIndex[lruIndex].mBlob;
+			const uint64 blobSize = mIndex[lruIndex].mSize;
+			RemoveBlob(blob);
+
+			usedCacheSize = (usedCacheSize > blobSize ? usedCacheSize - blobSize : 0);
+		}
+
+		#ifndef PRODUCTION_BUILD
+			LogInfo("New Cache Size: %.1f MB", (float)usedCacheSize / 1024.0f / 1024.0f);
+		#endif
 	}
 
+	if (mIndexDirty == true)
+		SaveIndex();
+
 	return true;
 }
 
@@ -374,16 +655,19 @@ bool WebDataCache::CleanCache()
 // gather the total size in bytes from all files that are currently cached
 uint64 WebDataCache::CalcUsedCacheSizeInBytes()
 {
-	QDir cacheFolder( mFolder.AsChar() );
+	// each blob is counted once, even if several urls refer to it
+	Array<String> blobs;
+	uint64 result = 0;
 
-	// get the filenames of all files in our directory
-	QList<QFileInfo>	fileInfos	= cacheFolder.entryInfoList(QDir::NoDotAndDotDot | QDir::Files);
-	const uint32		numFiles	= fileInfos.count();
+	const uint32 numEntries = mIndex.Size();
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		if (blobs.Contains(mIndex[i].mBlob) == true)
+			continue;
 
-	// iterate through all files and accumulate the file sizes
-	uint64 result = 0;
-	for (uint32 i=0; i<numFiles; ++i)
-		result += fileInfos[i].size();
+		blobs.Add( mIndex[i].mBlob );
+		result += mIndex[i].mSize;
+	}
 
 	return result;
 }
@@ -392,17 +676,9 @@ uint64 WebDataCache::CalcUsedCacheSizeInBytes()
 // log all files in the cache
 void WebDataCache::Log()
 {
-	QDir cacheFolder( mFolder.AsChar() );
-
-	// sort by date
-	cacheFolder.setSorting(QDir::Time);
-	
-	// get the filenames of all files in our directory
-	QList<QFileInfo>	fileInfos	= cacheFolder.entryInfoList(QDir::NoDotAndDotDot | QDir::Files);
-	const uint32		numFiles	= fileInfos.count();
-	
-	// return directly in case there are no files in the given directory
-	if (numFiles == 0)
+	// return directly in case there are no files in the cache
+	const uint32 numEntries = mIndex.Size();
+	if (numEntries == 0)
 		return;
 
 	LogInfo("================================================================================================================================================================================================================================");
@@ -410,23 +686,21 @@ void WebDataCache::Log()
 	LogInfo("================================================================================================================================================================================================================================");
 
 	// gather some general cache statistics
-	const float usedCacheSizeInMb = CalcUsedCacheSizeInBytes() / 1024 / 1024;
+	const float usedCacheSizeInMb = (float)CalcUsedCacheSizeInBytes() / 1024.0f / 1024.0f;
 
 	LogInfo("Used Cache Size:     %.1f MB", usedCacheSizeInMb);
 
 	// iterate through all files
-	LogInfo("Files: %i", numFiles);
-	for (uint32 i=0; i<numFiles; ++i)
+	LogInfo("Files: %i", numEntries);
+	for (uint32 i=0; i<numEntries; ++i)
 	{
-		const QFileInfo& fileInfo = fileInfos[i];
+		const IndexEntry& entry = mIndex[i];
 
-		float		fileSizeInMb		= (float)fileInfo.size() / 1024.0f / 1024.0f;
-		String		filePath			= FromQtString( fileInfo.filePath() );
-		QDateTime	lastModifiedDate	= fileInfo.lastModified();
-		String		lastModifiedString	= FromQtString( lastModifiedDate.toString("yyyy-MM-dd hh:mm:ss") );
+		float		fileSizeInMb		= (float)entry.mSize / 1024.0f / 1024.0f;
+		String		lastAccessString	= FromQtString( QDateTime::fromSecsSinceEpoch(entry.mLastAccess).toString("yyyy-MM-dd hh:mm:ss") );
 
-		LogInfo( "%s\t\t%.1f MB\t\t%s", lastModifiedString.AsChar(), fileSizeInMb, filePath.AsChar() );
+		LogInfo( "%s\t\t%.1f MB\t\t%s\t\t%s", lastAccessString.AsChar(), fileSizeInMb, entry.mBlob.AsChar(), entry.mUrl.AsChar() );
 	}
 	
 	LogInfo("================================================================================================================================================================================================================================");
-}
\ No newline at end of file
+}
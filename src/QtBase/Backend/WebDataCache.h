@@ -29,9 +29,15 @@ class QTBASE_API WebDataCache : public QObject
 		void RestrictCacheSize(uint64 maxCacheSizeInMb)				{ mMaxCacheRestrictionEnabled = true; mMaxCacheSizeInMb = maxCacheSizeInMb; }
 		void RestrictAliveTime(uint32 maxAliveTimeInDays)			{ mMaxAliveTimeRestrictionEnabled = true; mMaxAliveTimeInDays = maxAliveTimeInDays; }
 
+		// number of files downloaded in parallel from the same host (Qt opens at most six connections per host)
+		void SetMaxConcurrentDownloadsPerHost(uint32 maxDownloads)	{ mMaxConcurrentDownloadsPerHost = Core::Max<uint32>(1, maxDownloads); }
+
+		// download the given files and emit FinishedDownload when they are all cached (shows a status window)
 		bool Download(const Core::Array<Core::String>& urls);
+		// download the given files in the background (e.g. the assets of the next states while a session runs)
+		void Prefetch(const Core::Array<Core::String>& urls);
 
-		// restrict cache to max size and alive time
+		// evict cached files: partial downloads older than a week, files not accessed for longer than the max alive time, then the least recently used ones until the cache fits the max size
 		bool CleanCache();
 
 		void Log();
@@ -43,11 +49,11 @@ class QTBASE_API WebDataCache : public QObject
 
 		bool FileExists(const char* url);
 
+		// returns the cached file for the url (and marks it as used) or the url itself in case it is not cached
 		Core::String GetCacheFilenameForUrl(const char* url);
-		bool IsCached(const char* url);
 
+		// temporary file a url gets downloaded to (partial downloads are resumed from it)
 		Core::String UrlToFilename(const char* url);
-		Core::String FilenameToUrl(const char* filename);
 
 	signals:
 		void FinishedDownload();
@@ -61,9 +67,37 @@ class QTBASE_API WebDataCache : public QObject
 		void Start();
 		void DownloadNext();
 		void RemoveFromQueue(FileDownloader* downloader);
+		FileDownloader* FindQueuedDownload(const char* url) const;
+		FileDownloader* Enqueue(const char* url);
+		uint32 CalcNumForegroundDownloads() const;
+		uint32 CalcNumActiveDownloads(const QString& host) const;
 		void UpdateProgressBar();
 
+		// content-addressed storage: the files are stored under the hash of their content, the index maps the urls to them
+		struct IndexEntry
+		{
+			Core::String	mUrl;
+			Core::String	mBlob;			// '<content hash>.<extension>'
+			uint64			mSize;
+			int64			mLastAccess;	// seconds since epoch
+		};
+
+		uint32 FindIndexEntry(const char* url) const;
+		Core::String GetBlobFilename(const Core::String& blob) const		{ return mBlobFolder + blob; }
+		bool StoreBlob(const char* url, const char* downloadedFilename, const QByteArray& contentHash);
+		void RemoveBlob(const Core::String& blob);
+		void LoadIndex();
+		void SaveIndex();
+
+		Core::Array<IndexEntry>			mIndex;
+		bool							mIndexDirty;
+		Core::String					mBlobFolder;
+		Core::String					mDownloadFolder;
+		Core::String					mIndexFilename;
+
 		Core::Array<FileDownloader*>	mDownloadQueue;
+		Core::Array<FileDownloader*>	mActiveDownloads;
+		uint32							mMaxConcurrentDownloadsPerHost;
 		Core::String					mFolder;
 		Core::String					mTempString;
 		uint32							mMaxNumFails;
@@ -74,6 +108,8 @@ class QTBASE_API WebDataCache : public QObject
 		bool							mMaxAliveTimeRestrictionEnabled;
 		uint32							mMaxAliveTimeInDays;
 
+		uint32							mMaxPartialDownloadAgeInDays;
+
 		// current download status
 		StatusPopupWindow*				mStatusWindow;
 		uint32							mNumDownloadItems;
@@ -0,0 +1,266 @@
+/*
+ * Qt Base
+ * Copyright (c) 2012-2016 neuromore Inc.
+ * All Rights Reserved.
+ */
+
+// include the required headers
+#include "EngineThread.h"
+#include "QtBaseManager.h"
+#include "MainWindowBase.h"
+#include <EngineManager.h>
+#include <QCoreApplication>
+#include <QAbstractEventDispatcher>
+
+
+using namespace Core;
+
+// constructor
+EngineThread::EngineThread()
+{
+	mThread			= NULL;
+	mUpdateRate		= 100.0;
+	mUiHoldsLock	= false;
+	mEventFilter	= NULL;
+}
+
+
+// destructor
+EngineThread::~EngineThread()
+{
+	Stop();
+}
+
+
+// start the engine thread
+void EngineThread::Start(double updateRate)
+{
+	mUpdateRate = updateRate;
+
+	if (IsRunning() == true)
+		return;
+
+	EngineManager* engine = GetEngine();
+
+	// engine events are passed to the UI handlers on the UI thread, devices are added/removed there as well (both emit events the UI reacts to directly)
+	engine->GetEventManager().SetQueueThreadEvents(true);
+	engine->GetDeviceManager()->SetDeferDeviceListUpdate(true);
+
+	// the UI thread owns the engine lock while it is processing events
+	QAbstractEventDispatcher* dispatcher = QAbstractEventDispatcher::instance(qApp->thread());
+	mAwakeConnection		= QObject::connect( dispatcher, &QAbstractEventDispatcher::awake,			[this]() { AcquireUiLock(true); } );
+	mAboutToBlockConnection	= QObject::connect( dispatcher, &QAbstractEventDispatcher::aboutToBlock,	[this]() { ReleaseUiLock(); } );
+
+	// resizing, layouting and painting runs without the lock
+	mEventFilter = new EventFilter(this);
+	qApp->installEventFilter(mEventFilter);
+
+	// we are called from an event handler
+	mDeviceUpdateTimer.GetTimeDelta();
+	AcquireUiLock(false);
+
+	mThread = new Thread( new Handler(this), "Studio Engine Thread" );
+	mThread->Start();
+}
+
+
+// stop the engine thread
+void EngineThread::Stop()
+{
+	if (IsRunning() == false)
+		return;
+
+	// the engine thread may be waiting for the lock
+	ReleaseUiLock();
+
+	// stops and joins the thread, destroys the handler
+	delete mThread;
+	mThread = NULL;
+
+	QObject::disconnect(mAwakeConnection);
+	QObject::disconnect(mAboutToBlockConnection);
+
+	qApp->removeEventFilter(mEventFilter);
+	delete mEventFilter;
+	mEventFilter = NULL;
+
+	// back to single-threaded operation: pass the remaining events and let the engine update the device list again
+	EngineManager* engine = GetEngine();
+	engine->GetEventManager().SetQueueThreadEvents(false);
+	engine->GetDeviceManager()->SetDeferDeviceListUpdate(false);
+}
+
+
+// lock the engine for the UI thread
+void EngineThread::AcquireUiLock(bool updateDevices)
+{
+	if (mUiHoldsLock == true)
+		return;
+
+	GetEngine()->Lock();
+	mUiHoldsLock = true;
+
+	// apply the device changes and update the drivers and devices that live on the UI thread, pass the events the engine thread emitted meanwhile
+	if (updateDevices == true)
+	{
+		DeviceManager* deviceManager = GetDeviceManager();
+		deviceManager->UpdateDeviceList();
+		deviceManager->UpdateThreadAffine(GetEngine()->GetElapsedTime(), mDeviceUpdateTimer.GetTimeDelta());
+	}
+
+	GetEngine()->GetEventManager().DispatchQueuedEvents();
+}
+
+
+// unlock the engine, the engine thread can update again
+void EngineThread::ReleaseUiLock()
+{
+	if (mUiHoldsLock == false)
+		return;
+
+	mUiHoldsLock = false;
+	GetEngine()->Unlock();
+}
+
+
+// engine thread main loop
+void EngineThread::Handler::Execute()
+{
+	mIsFinished = false;
+
+	EngineManager* engine = GetEngine();
+
+	// reset the timer
+	mUpdateTimer.GetTimeDelta();
+
+	// a large time delta indicates that the process was halted for some time (e.g. PC was put in standby)
+	const double maxAllowedLag = 10.0;
+
+	Timer frameTimer;
+	while (mBreak == false)
+	{
+		frameTimer.GetTimeDelta();
+
+		engine->Lock();
+
+		const Time timeDelta = mUpdateTimer.GetTimeDelta();
+		if (GetQtBaseManager()->IsInterfacePaused() == false)
+		{
+			if (timeDelta.InSeconds() > maxAllowedLag)
+			{
+				LogError("EngineThread: Detected a large jump in the realtime timer (%.2f s).", timeDelta.InSeconds());
+				engine->SyncAsync();
+			}
+			else
+			{
+				engine->Update(timeDelta);
+			}
+		}
+
+		engine->Unlock();
+
+		// update rate control
+		const double sleepTime = 1.0 / mEngineThread->GetUpdateRate() - frameTimer.GetTimeDelta().InSeconds();
+		if (mBreak == false && sleepTime > 0.0)
+			Thread::Sleep(sleepTime * 1000.0);
+	}
+
+	mIsFinished = true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// release the engine lock of the UI thread
+EngineThread::YieldScope::YieldScope()
+{
+	mEngineThread = NULL;
+
+	MainWindowBase* mainWindow = GetQtBaseManager()->GetMainWindow();
+	if (mainWindow == NULL)
+		return;
+
+	EngineThread* engineThread = mainWindow->GetEngineThread();
+	if (engineThread->IsRunning() == false || engineThread->mUiHoldsLock == false)
+		return;
+
+	mEngineThread = engineThread;
+	mEngineThread->ReleaseUiLock();
+}
+
+
+// lock the engine again
+EngineThread::YieldScope::~YieldScope()
+{
+	// NOTE: devices are not added/removed here, the caller may still hold device pointers
+	if (mEngineThread != NULL)
+		mEngineThread->AcquireUiLock(false);
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// lock the engine for the UI thread, if it does not hold the lock already (e.g. inside a yield scope)
+EngineThread::LockScope::LockScope()
+{
+	mEngineThread = NULL;
+
+	MainWindowBase* mainWindow = GetQtBaseManager()->GetMainWindow();
+	if (mainWindow == NULL)
+		return;
+
+	EngineThread* engineThread = mainWindow->GetEngineThread();
+	if (engineThread->IsRunning() == false || engineThread->mUiHoldsLock == true)
+		return;
+
+	mEngineThread = engineThread;
+	mEngineThread->AcquireUiLock(false);
+}
+
+
+// give the lock back if this scope took it
+EngineThread::LockScope::~LockScope()
+{
+	if (mEngineThread != NULL)
+		mEngineThread->ReleaseUiLock();
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// deliver window system, layout and paint events without the engine lock
+bool EngineThread::EventFilter::eventFilter(QObject* object, QEvent* event)
+{
+	// the nested delivery below (and events inside of it) pass through
+	if (mEngineThread->mUiHoldsLock == false || IsYieldingEvent(event) == false)
+		return false;
+
+	mEngineThread->ReleaseUiLock();
+	QCoreApplication::sendEvent(object, event);
+
+	// NOTE: devices are not added/removed here, the event loop may still be inside a handler that holds device pointers
+	mEngineThread->AcquireUiLock(false);
+
+	return true;
+}
+
+
+// only events the event loop delivers (posted or coming from the window system), events sent from inside other handlers keep the lock of the handler
+bool EngineThread::EventFilter::IsYieldingEvent(QEvent* event)
+{
+	switch (event->type())
+	{
+		case QEvent::UpdateRequest:
+		case QEvent::LayoutRequest:
+			return true;
+
+		case QEvent::Resize:
+		case QEvent::Move:
+		case QEvent::Paint:
+		case QEvent::Expose:
+			return event->spontaneous();
+
+		default:
+			return false;
+	}
+}
@@ -0,0 +1,106 @@
+/*
+ * Qt Base
+ * Copyright (c) 2012-2016 neuromore Inc.
+ * All Rights Reserved.
+ */
+
+#ifndef __NEUROMORE_ENGINETHREAD_H
+#define __NEUROMORE_ENGINETHREAD_H
+
+// include required headers
+#include "QtBaseConfig.h"
+#include <Core/StandardHeaders.h>
+#include <Core/Thread.h>
+#include <Core/Timer.h>
+#include <atomic>
+#include <QObject>
+#include <QMetaObject>
+
+
+// runs the engine update on a separate thread, so repaints, layouting and modal dialogs on the UI thread can't stall the signal processing
+//  - the engine thread holds the engine lock (EngineManager::Lock()) during each update
+//  - the UI thread holds the engine lock while it processes events and releases it while it waits for new events
+//  - window system, layout and paint events are handled without the lock, handlers that read engine state take a LockScope
+//  - drivers and devices that own Qt objects are updated on the UI thread (DeviceManager::UpdateThreadAffine())
+//  - events emitted by the engine thread are queued and dispatched on the UI thread, devices are added/removed on the UI thread as well
+//  - render code that only reads channel snapshots can release the lock of the UI thread with a YieldScope
+class QTBASE_API EngineThread
+{
+	public:
+		// constructor & destructor
+		EngineThread();
+		~EngineThread();
+
+		// start/stop the engine thread (call from the UI thread)
+		void Start(double updateRate);
+		void Stop();
+		bool IsRunning() const													{ return mThread != NULL; }
+
+		void SetUpdateRate(double updateRate)									{ mUpdateRate = updateRate; }
+		double GetUpdateRate() const											{ return mUpdateRate; }
+
+		// lets the engine thread run while the UI thread executes the scope (only access channel snapshots inside the scope)
+		class QTBASE_API YieldScope
+		{
+			public:
+				YieldScope();
+				~YieldScope();
+
+			private:
+				EngineThread*	mEngineThread;
+		};
+
+		// makes sure the UI thread holds the engine lock during the scope (write state the engine thread reads inside the scope)
+		class QTBASE_API LockScope
+		{
+			public:
+				LockScope();
+				~LockScope();
+
+			private:
+				EngineThread*	mEngineThread;
+		};
+
+	private:
+		class Handler : public Core::ThreadHandler
+		{
+			public:
+				Handler(EngineThread* engineThread) : ThreadHandler()			{ mEngineThread = engineThread; mBreak = false; }
+				void Execute() override;
+				void Terminate() override										{ mBreak = true; }
+
+			private:
+				EngineThread*		mEngineThread;
+				Core::Timer			mUpdateTimer;
+				std::atomic<bool>	mBreak;
+		};
+
+		// delivers the yielding events without the engine lock
+		class EventFilter : public QObject
+		{
+			public:
+				EventFilter(EngineThread* engineThread) : QObject()				{ mEngineThread = engineThread; }
+				bool eventFilter(QObject* object, QEvent* event) override;
+
+			private:
+				static bool IsYieldingEvent(QEvent* event);
+
+				EngineThread*		mEngineThread;
+		};
+
+		// engine lock of the UI thread
+		void AcquireUiLock(bool updateDevices);
+		void ReleaseUiLock();
+
+		Core::Thread*				mThread;
+		std::atomic<double>			mUpdateRate;
+		bool						mUiHoldsLock;
+		EventFilter*				mEventFilter;
+		Core::Timer					mDeviceUpdateTimer;
+
+		QMetaObject::Connection		mAwakeConnection;
+		QMetaObject::Connection		mAboutToBlockConnection;
+};
+
+
+#endif
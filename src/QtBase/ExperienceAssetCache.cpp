@@ -7,6 +7,7 @@
 // include the required headers
 #include "ExperienceAssetCache.h"
 #include "QtBaseManager.h"
+#include "EngineThread.h"
 #include <EngineManager.h>
 #include <Graph/StateMachine.h>
 
@@ -27,6 +28,12 @@ ExperienceAssetCache::ExperienceAssetCache(QObject* parent) : QObject(parent)
 	mCache->RestrictAliveTime( 90 );
 	mCache->CleanCache();
 	//mCache->Log();
+
+	// prefetch-ahead
+	mPrefetchAheadEnabled	= true;
+	mNumStatesAhead			= 2;
+	mPrefetchTimer			= new QTimer(this);
+	connect(mPrefetchTimer, SIGNAL(timeout()), this, SLOT(OnPrefetchTimer()));
 }
 
 
@@ -56,12 +63,62 @@ void ExperienceAssetCache::PreloadAssets()
 		stateMachine->CollectStates();
 		stateMachine->CollectAssets();
 		Core::Array<StateMachine::Asset> assets = stateMachine->GetAssets();
+
+		// assets that must not be streamed are always needed up front, the others only if they are used by the first states
+		Core::Array<StateMachine::Asset> upcomingAssets;
+		if (mPrefetchAheadEnabled == true)
+			stateMachine->CollectUpcomingAssets( upcomingAssets, mNumStatesAhead );
+
 		const uint32 numAssets = assets.Size();
 		for (uint32 i=0; i<numAssets; ++i)
-			assetUrls.Add( assets[i].mLocation );
+		{
+			bool upFront = (mPrefetchAheadEnabled == false || assets[i].mAllowStreaming == false);
+			for (uint32 j=0; j<upcomingAssets.Size() && upFront == false; ++j)
+				upFront = upcomingAssets[j].mLocation.IsEqual( assets[i].mLocation );
+
+			if (upFront == true)
+				assetUrls.Add( assets[i].mLocation );
+		}
 	}
 
 	mCache->Download(assetUrls);
+
+	// keep loading the assets of the upcoming states while the session runs
+	if (mPrefetchAheadEnabled == true)
+		mPrefetchTimer->start(1000);
+}
+
+
+// prefetch the assets of the states that can be reached next
+void ExperienceAssetCache::OnPrefetchTimer()
+{
+	mTempUrls.Clear(false);
+
+	StateMachine* stateMachine;
+	{
+		// the state machine is updated by the engine thread
+		EngineThread::LockScope lockScope;
+
+		stateMachine = GetEngine()->GetActiveStateMachine();
+		if (stateMachine != NULL)
+		{
+			Core::Array<StateMachine::Asset> upcomingAssets;
+			stateMachine->CollectUpcomingAssets( upcomingAssets, mNumStatesAhead );
+
+			const uint32 numAssets = upcomingAssets.Size();
+			for (uint32 i=0; i<numAssets; ++i)
+				mTempUrls.Add( upcomingAssets[i].mLocation );
+		}
+	}
+
+	// the experience was closed
+	if (stateMachine == NULL)
+	{
+		mPrefetchTimer->stop();
+		return;
+	}
+
+	mCache->Prefetch(mTempUrls);
 }
 
 
@@ -13,6 +13,7 @@
 #include <Core/Color.h>
 #include "Backend/WebDataCache.h"
 #include <QObject>
+#include <QTimer>
 
 
 class QTBASE_API ExperienceAssetCache : public QObject
@@ -24,6 +25,11 @@ class QTBASE_API ExperienceAssetCache : public QObject
 
 		WebDataCache* GetCache()			{ return mCache; }
 
+		// prefetch-ahead: only wait for the assets of the first states before the session starts, the assets of the upcoming states are downloaded in the background while it runs
+		void SetPrefetchAheadEnabled(bool enabled)				{ mPrefetchAheadEnabled = enabled; }
+		bool IsPrefetchAheadEnabled() const						{ return mPrefetchAheadEnabled; }
+		void SetNumStatesAhead(uint32 numStates)				{ mNumStatesAhead = numStates; }
+
 	signals:
 		void FinishedPreloading();
 
@@ -32,10 +38,17 @@ class QTBASE_API ExperienceAssetCache : public QObject
 
 	private slots:
 		void OnFinishedPreloading();
+		void OnPrefetchTimer();
 
 	private:
 		// web data cache
 		WebDataCache* mCache;
+
+		// prefetch-ahead
+		QTimer*						mPrefetchTimer;
+		bool						mPrefetchAheadEnabled;
+		uint32						mNumStatesAhead;
+		Core::Array<Core::String>	mTempUrls;
 };
 
 
@@ -56,6 +56,8 @@ MainWindowBase::MainWindowBase(QWidget* parent, Qt::WindowFlags flags) : QMainWi
 	mInterfaceTimer			= NULL;
 	mShowFPS				= false;
 	mShowPerformanceInfo	= false;
+	mEngineUpdateEnabled	= false;
+	mEngineThreadEnabled	= false;
 
 	mEngineUpdateRate		= 100.0;
 	mRealtimeUIUpdateRate	= 60.0;
@@ -66,6 +68,7 @@ MainWindowBase::MainWindowBase(QWidget* parent, Qt::WindowFlags flags) : QMainWi
 // destructor
 MainWindowBase::~MainWindowBase()
 {
+	mEngineThread.Stop();
 	mEngineTimer->stop();
 	mRealtimeUITimer->stop();
 	mInterfaceTimer->stop();
@@ -115,19 +118,42 @@ void MainWindowBase::Init()
 
 void MainWindowBase::SetEngineTimerEnabled(bool isEnabled)
 {
-	if (isEnabled == true)
+	mEngineUpdateEnabled = isEnabled;
+
+	// the engine is either updated by the timer or by the engine thread
+	if (isEnabled == true && mEngineThreadEnabled == true)
 	{
+		mEngineTimer->stop();
+		mEngineThread.Start(mEngineUpdateRate);
+	}
+	else if (isEnabled == true)
+	{
+		mEngineThread.Stop();
 		mEngineTimer->setTimerType( Qt::PreciseTimer );
 		mEngineTimer->start(1000 / mEngineUpdateRate);
 		mEngineUpdateTimer.GetTimeDelta();
 	}
 	else
 	{
+		mEngineThread.Stop();
 		mEngineTimer->stop();
 	}
 }
 
 
+void MainWindowBase::SetEngineThreadEnabled(bool isEnabled)
+{
+	if (mEngineThreadEnabled == isEnabled)
+		return;
+
+	mEngineThreadEnabled = isEnabled;
+
+	// switch over in case the engine is running
+	if (mEngineTimer != NULL && mEngineUpdateEnabled == true)
+		SetEngineTimerEnabled(true);
+}
+
+
 void MainWindowBase::SetRealtimeUITimerEnabled(bool isEnabled)
 {
 	if (isEnabled == true)
@@ -163,6 +189,8 @@ void MainWindowBase::SetEngineUpdateRate(double updateFPS)
 
 	if (mEngineTimer != NULL)
 		mEngineTimer->setInterval(1000.0 / updateFPS);
+
+	mEngineThread.SetUpdateRate(updateFPS);
 }
 
 
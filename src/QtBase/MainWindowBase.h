@@ -14,6 +14,7 @@
 #include <QMainWindow>
 #include <Core/Timer.h>
 #include <Core/FpsCounter.h>
+#include "EngineThread.h"
 
 
 class QTBASE_API MainWindowBase : public QMainWindow
@@ -37,6 +38,11 @@ class QTBASE_API MainWindowBase : public QMainWindow
 		void SetShowPerformanceInfo(bool show)									{ mShowPerformanceInfo = show; }
 		bool GetShowPerformanceInfo() const										{ return mShowPerformanceInfo; }
 
+		// run the engine update on a separate thread instead of the engine timer
+		void SetEngineThreadEnabled(bool isEnabled);
+		bool GetEngineThreadEnabled() const										{ return mEngineThreadEnabled; }
+		EngineThread* GetEngineThread()											{ return &mEngineThread; }
+
 		void SetEngineTimerEnabled(bool isEnabled);
 		void SetRealtimeUITimerEnabled(bool isEnabled);
 		void SetInterfaceTimerEnabled(bool isEnabled);
@@ -59,6 +65,9 @@ class QTBASE_API MainWindowBase : public QMainWindow
 		QTimer*							mEngineTimer;
 		double							mEngineUpdateRate;
 		Core::Timer						mEngineUpdateTimer;
+		bool							mEngineUpdateEnabled;
+		bool							mEngineThreadEnabled;
+		EngineThread					mEngineThread;
 
 		QTimer*							mRealtimeUITimer;
 		double							mRealtimeUIUpdateRate;
@@ -109,21 +109,22 @@ void OscServer::OnRealtimeUpdate()
 	OnReceiveUdpDatagram();
 
 
-	// send outgoing packets
-	Array<OscPacket*>& packetQueue = GetOscMessageRouter()->GetOutputPacketQueue();
-	const uint32 numPackets = packetQueue.Size();
+	// send outgoing packets (the queue is filled by the engine, which may run on its own thread)
+	OscMessageRouter* router = GetOscMessageRouter();
+	router->TakeOutputPackets(mOutputPackets);
+	const uint32 numPackets = mOutputPackets.Size();
 	for (uint32 i = 0; i < numPackets; ++i)
 	{
 		// get packet
-		OscPacket* packet = packetQueue[i];
+		OscPacket* packet = mOutputPackets[i];
 
-		// send packet out to client
+		// send packet out to client (a bundle is sent as a single datagram)
 		SendUdpDatagram(packet->GetData(), packet->GetSize());
-
-		// mark all messages in packet as processed
-		packet->SetIsReady();
 	}
-	packetQueue.Clear();
+
+	// hand the sent packets back to the router
+	router->ReleaseOutputPackets(mOutputPackets);
+	mOutputPackets.Clear(false);
 }
 
 
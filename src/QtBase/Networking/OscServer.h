@@ -81,6 +81,7 @@ class QTBASE_API OscServer : public QObject
 		QHostAddress			mLocalEndpoint;					// local end point to bind to
 		
 		OscPacketPool			mPacketPool;					// packet memory pool for received and transmitted packets
+		Core::Array<OscPacket*>	mOutputPackets;					// outgoing packets taken from the message router
 
 		QTimer*					mTimer;
 
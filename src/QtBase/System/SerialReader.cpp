@@ -0,0 +1,159 @@
+/*
+ * Qt Base
+ * Copyright (c) 2012-2016 neuromore Inc.
+ * All Rights Reserved.
+ */
+
+// include required headers
+#include "SerialReader.h"
+#include <Core/Math.h>
+#include <string.h>
+
+
+using namespace Core;
+
+// constructor
+SerialReader::SerialReader(uint32 ringSize, QObject* parent) : QThread(parent)
+{
+	mPort			= NULL;
+	mOwnerThread	= NULL;
+
+	// the ring size must be a power of two so the counters can wrap around
+	const uint32 size = Math::NextPowerOfTwo(Max<uint32>(ringSize, 4096));
+	mRing.Resize(size);
+	mRingMask		= size - 1;
+
+	mWriteCount			= 0;
+	mReadCount			= 0;
+	mNumOverflowBytes	= 0;
+	mStopRequested		= false;
+}
+
+
+// destructor
+SerialReader::~SerialReader()
+{
+	Stop();
+}
+
+
+// hand the port over to the reader thread and start draining it
+bool SerialReader::Start(SerialPort* port)
+{
+	if (port == NULL || port->IsOpen() == false || IsReading() == true)
+		return false;
+
+	mWriteCount			= 0;
+	mReadCount			= 0;
+	mNumOverflowBytes	= 0;
+	mStopRequested		= false;
+
+	// the port (and the wrapped QSerialPort) may only be used from the thread it lives in
+	mPort = port;
+	mOwnerThread = port->thread();
+	port->moveToThread(this);
+
+	start(QThread::TimeCriticalPriority);
+	return true;
+}
+
+
+// stop the reader thread; the port is moved back to its previous thread before this returns
+void SerialReader::Stop()
+{
+	if (IsReading() == false)
+		return;
+
+	mStopRequested = true;
+	wait();
+
+	mPort = NULL;
+	mOwnerThread = NULL;
+}
+
+
+// reader thread: block on the port and move everything that arrives into the ring
+void SerialReader::run()
+{
+	const uint32 ringSize = mRing.Size();
+	uint8 overflow[256];
+
+	while (mStopRequested == false)
+	{
+		if (mPort->WaitForRead(10) == false && mPort->GetNumBytesAvailable() == 0)
+			continue;
+
+		uint32 numAvailable = mPort->GetNumBytesAvailable();
+		while (numAvailable > 0)
+		{
+			const uint32 writeCount = mWriteCount.load(std::memory_order_relaxed);
+			const uint32 numFree = ringSize - (writeCount - mReadCount.load(std::memory_order_acquire));
+
+			// ring is full: drain the port anyway so the driver buffer does not overflow, and count the lost bytes
+			if (numFree == 0)
+			{
+				const int numRead = mPort->Read((char*)overflow, Min<uint32>(numAvailable, sizeof(overflow)));
+				if (numRead <= 0)
+					break;
+
+				mNumOverflowBytes += numRead;
+				numAvailable -= Min<uint32>(numAvailable, numRead);
+				continue;
+			}
+
+			// read into the contiguous part of the free space
+			const uint32 offset = writeCount & mRingMask;
+			const uint32 numBytes = Min(Min(numAvailable, numFree), ringSize - offset);
+			const int numRead = mPort->Read((char*)mRing.GetPtr() + offset, numBytes);
+			if (numRead <= 0)
+				break;
+
+			mWriteCount.store(writeCount + numRead, std::memory_order_release);
+			numAvailable -= Min<uint32>(numAvailable, numRead);
+		}
+	}
+
+	// return the port to its owner
+	mPort->moveToThread(mOwnerThread);
+}
+
+
+void SerialReader::CopyFromRing(uint32 readCount, uint8* outData, uint32 numBytes) const
+{
+	const uint32 offset = readCount & mRingMask;
+	const uint32 numFirst = Min(numBytes, mRing.Size() - offset);
+
+	memcpy(outData, mRing.GetReadPtr() + offset, numFirst);
+	if (numFirst < numBytes)
+		memcpy(outData + numFirst, mRing.GetReadPtr(), numBytes - numFirst);
+}
+
+
+// consumer: copy up to maxNumBytes out of the ring
+uint32 SerialReader::Read(uint8* outData, uint32 maxNumBytes)
+{
+	const uint32 readCount = mReadCount.load(std::memory_order_relaxed);
+	const uint32 numBytes = Min(GetNumBytesAvailable(), maxNumBytes);
+	if (numBytes == 0)
+		return 0;
+
+	CopyFromRing(readCount, outData, numBytes);
+	mReadCount.store(readCount + numBytes, std::memory_order_release);
+	return numBytes;
+}
+
+
+// consumer: move all available bytes into the framer in one go
+uint32 SerialReader::Read(SerialFramer& framer)
+{
+	const uint32 readCount = mReadCount.load(std::memory_order_relaxed);
+	const uint32 numBytes = GetNumBytesAvailable();
+	if (numBytes == 0)
+		return 0;
+
+	CopyFromRing(readCount, framer.BeginWrite(numBytes), numBytes);
+	framer.EndWrite(numBytes);
+
+	mReadCount.store(readCount + numBytes, std::memory_order_release);
+	return numBytes;
+}
@@ -0,0 +1,62 @@
+/*
+ * Qt Base
+ * Copyright (c) 2012-2016 neuromore Inc.
+ * All Rights Reserved.
+ */
+
+#ifndef __NEUROMORE_SERIALREADER_H
+#define __NEUROMORE_SERIALREADER_H
+
+// include required headers
+#include "../QtBaseConfig.h"
+#include "SerialPort.h"
+#include <Core/Array.h>
+#include <Devices/SerialFramer.h>
+
+#include <QThread>
+#include <atomic>
+
+
+// drains a serial port on a dedicated thread into a large lock-free single-producer/single-consumer ring buffer
+//  - Start() hands the opened port over to the reader thread; the caller must not touch the port until Stop() has returned it
+//  - the consumer pulls the bytes in bulk with Read(), e.g. directly into a SerialFramer
+//  - works with any port name QSerialPort can open, including the slave side of a pseudo-terminal that emulates a device
+class QTBASE_API SerialReader : public QThread
+{
+	public:
+		SerialReader(uint32 ringSize = 1024*1024, QObject* parent = NULL);
+		virtual ~SerialReader();
+
+		// start/stop reading (call both from the thread that owns the port)
+		bool Start(SerialPort* port);
+		void Stop();
+		bool IsReading() const											{ return mPort != NULL; }
+
+		// consumer side
+		uint32 GetNumBytesAvailable() const								{ return mWriteCount.load(std::memory_order_acquire) - mReadCount.load(std::memory_order_relaxed); }
+		uint32 Read(uint8* outData, uint32 maxNumBytes);
+		uint32 Read(SerialFramer& framer);
+
+		// number of bytes that were dropped because the consumer did not keep up
+		uint64 GetNumOverflowBytes() const								{ return mNumOverflowBytes.load(std::memory_order_relaxed); }
+
+	protected:
+		void run() override;
+
+	private:
+		// copy numBytes from the ring (starting at the read count) to outData
+		void CopyFromRing(uint32 readCount, uint8* outData, uint32 numBytes) const;
+
+		SerialPort*					mPort;
+		QThread*					mOwnerThread;
+
+		Core::Array<uint8>			mRing;
+		uint32						mRingMask;
+		std::atomic<uint32>			mWriteCount;			// total number of bytes written (wraps around, only the difference matters)
+		std::atomic<uint32>			mReadCount;				// total number of bytes read
+		std::atomic<uint64>			mNumOverflowBytes;
+		std::atomic<bool>			mStopRequested;
+};
+
+
+#endif
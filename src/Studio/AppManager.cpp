@@ -103,6 +103,9 @@ AppManager::AppManager(int argc, char* argv[])
 	String logFilename = GetLogFilename();
 	CORE_LOGMANAGER.CreateLogFile( logFilename.AsChar() );
 
+	// format and write the log lines on a background thread, so logging never blocks the engine update
+	CORE_LOGMANAGER.SetAsyncLogging(true);
+
 	// log header
 	LogInfo();
 	LogDetailedInfo("Log file '%s' created ...", logFilename.AsChar());
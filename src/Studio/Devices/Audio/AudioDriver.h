@@ -58,6 +58,7 @@ class AudioDriver : public QObject, public DeviceDriver, public Core::EventHandl
 
 		// main update function
 		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+		bool HasThreadAffinity() const override							{ return true; }
 
 		bool HasAutoDetectionSupport() const override		{ return false; }
 		void DetectDevices() override;
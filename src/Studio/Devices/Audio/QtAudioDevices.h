@@ -114,6 +114,7 @@ class QtAudioOutputDevice : public QObject, public AudioOutputDevice
         
 
 		void Update(const Core::Time& elapsed, const Core::Time& delta) override final;
+		bool HasThreadAffinity() const override			{ return true; }
 
 		void SetUpdateRate(double fps)					{ if (mAudioOutput != NULL) mAudioOutput->setNotifyInterval(1000.0 / fps); }
 
@@ -55,6 +55,7 @@ class BluetoothDriver : public QObject, public DeviceDriver, public Core::EventH
 
 		// main update function
         void Update(const Core::Time& elapsed, const Core::Time& delta) override    {}
+        bool HasThreadAffinity() const override                                      { return true; }
 
 		bool HasAutoDetectionSupport() const override                               { return true; }
 		void SetAutoDetectionEnabled(bool enable = true) override;
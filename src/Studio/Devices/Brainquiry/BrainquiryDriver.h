@@ -64,6 +64,7 @@ class BrainquiryDriver : public QObject, public DeviceDriver, public Core::Event
 
 		// main update function
 		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+		bool HasThreadAffinity() const override							{ return true; }
 
 		bool HasAutoDetectionSupport() const override								{ return true; }
 		void SetAutoDetectionEnabled(bool enable = true) override;
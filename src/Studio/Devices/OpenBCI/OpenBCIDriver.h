@@ -62,6 +62,7 @@ class OpenBCIDriver : public QObject, public DeviceDriver, public Core::EventHan
 
 		// main update function
 		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+		bool HasThreadAffinity() const override							{ return true; }
 
 		bool HasAutoDetectionSupport() const override						{ return true; }
 		void SetAutoDetectionEnabled(bool enable = true) override;
@@ -27,6 +27,7 @@
 #include <EngineManager.h>
 #include <QCoreApplication>
 #include <QTimer>
+#include <stddef.h>
 
 #ifdef INCLUDE_DEVICE_OPENBCI
 
@@ -45,6 +46,7 @@ OpenBCISerialHandler::OpenBCISerialHandler(SerialPort* port, OpenBCIDeviceBase*
 
 	mLastPacketIndex = 0;
 	mNumPackets = 0;
+	mNumLostPackets = 0;
 	mSampleRate = mDevice->GetSampleRate();
 
 	mTimer = new QTimer();
@@ -52,6 +54,10 @@ OpenBCISerialHandler::OpenBCISerialHandler(SerialPort* port, OpenBCIDeviceBase*
 	mTimer->setTimerType( Qt::PreciseTimer );
 	mTimer->setInterval(2*1000/mSampleRate);
 
+	// stream packets are fixed-size and framed by header and footer byte
+	mReader = new SerialReader();
+	mFramer.Init(sizeof(OpenBCIStreamPacket), (uint8)OpenBCIStreamPacket::GetProtocolHeader(), (uint8)OpenBCIStreamPacket::GetProtocolFooter());
+
 	mIsConnected = false;
 
 	mAccValueLeft    = 0.0;
@@ -63,6 +69,10 @@ OpenBCISerialHandler::OpenBCISerialHandler(SerialPort* port, OpenBCIDeviceBase*
 // destructor
 OpenBCISerialHandler::~OpenBCISerialHandler()
 {
+	// give the port back before it is closed
+	mReader->Stop();
+	delete mReader;
+
 	if (mSerialPort != NULL)
 	{
 		// if device has timed out, it means the bluetooth connection is gone
@@ -149,7 +159,16 @@ bool OpenBCISerialHandler::Connect()
 	}
 
 	
-	// start data receive thread
+	// start draining the port on the reader thread, the timer then only has to parse what has arrived
+	mFramer.Clear();
+	if (mReader->Start(mSerialPort) == false)
+	{
+		LogError("OpenBCI: failed to start the serial reader");
+		Disconnect();
+		return false;
+	}
+
+	// start data receive timer
 	mTimer->start();
 
 	return true;
@@ -162,6 +181,9 @@ void OpenBCISerialHandler::Disconnect()
 	if (mSerialPort == NULL)
 		return;
 
+	// the port has to be back on this thread before we can send the stop command
+	mReader->Stop();
+
 	if (mSerialPort->IsOpen() == true)
 	{
 		if (SendStopCommand() == true)
@@ -518,7 +540,8 @@ bool OpenBCISerialHandler::SendResetCommand()
 }
 
 
-void OpenBCISerialHandler::ProcessStreamPacket(const OpenBCIStreamPacket& packet)
+// decode a batch of stream packets
+void OpenBCISerialHandler::ProcessStreamPackets(const uint8* const* packets, uint32 numPackets)
 {
 	if (mDevice->IsEnabled() == false)
 		return;
@@ -530,196 +553,106 @@ void OpenBCISerialHandler::ProcessStreamPacket(const OpenBCIStreamPacket& packet
 		LogInfo("OpenBCI connected");
 	}
 
-	// get current packet index and check for lost packets
-	const uint32 currentPacketIndex = (uint32)packet.GetSampleNumber();
-	const uint32 expectedPacketIndex = (mLastPacketIndex + 1) % 256;
-	if (currentPacketIndex != expectedPacketIndex)
+	// check the packet indices for lost packets (remember: index is modulo 256!)
+	for (uint32 i = 0; i < numPackets; ++i)
 	{
-	
-		// we lost packets -> calculate how many (remember: index is modulo 256!)
-		uint32 numLostPackets = 0;
-		if (currentPacketIndex > expectedPacketIndex)
-			numLostPackets = currentPacketIndex - expectedPacketIndex;
-		else
-			numLostPackets = (currentPacketIndex + 256) - expectedPacketIndex;
-		
-		//LogDetailedInfo("OpenBCISerialHandler: missing %i packets (index is %i, should be %i)", numLostPackets, currentPacketIndex, expectedPacketIndex);
-		// TODO: First two packets contains obsolete data. This causes an exception at this point. Has to be handled
-		// add zero values to compensate for lost samples
-		/*for (uint32 i=0; i<mDevice->GetNumElectrodes(); ++i)
-			mDevice->GetSensor(i)->HandleLostSamples(numLostPackets);*/
+		const uint32 currentPacketIndex = packets[i][offsetof(OpenBCIStreamPacket, mSampleNumber)];
+		const uint32 expectedPacketIndex = (mLastPacketIndex + 1) % 256;
+		if (currentPacketIndex != expectedPacketIndex)
+			mNumLostPackets += (currentPacketIndex + 256 - expectedPacketIndex) % 256;
 
+		mLastPacketIndex = currentPacketIndex;
 	}
-	mLastPacketIndex = currentPacketIndex;
-
-	
-	// read out streampacket and feed raw samples into sensor channels
-	const OpenBCIStreamEEGData* sensors = packet.mSensors;
 
 	// if this is a openbci + daisy device the 16 channels come in two successive packets (effective samplerate is halfed)
 	if (mDevice->GetType() == OpenBCIDaisyDevice::TYPE_ID)
-	{ 
-		const uint32 numElectrodes = 8;
-		// first or second half? (offset is either 0 (main board packets) or 7 (daisy packets)
-		const bool isFromDaisy = (currentPacketIndex % 2 == 0) ? true : false;
-		const uint32 sensorIndexOffset = (isFromDaisy ? numElectrodes : 0);
-		for (uint32 i = 0; i < numElectrodes; ++i)
+	{
+		// main board packets have odd, daisy packets have even indices
+		mBoardPackets.Clear(false);
+		mDaisyPackets.Clear(false);
+		for (uint32 i = 0; i < numPackets; ++i)
 		{
-			const double gain = mElectrodeGainSettings[i];
-			const uint32 base = Math::PowD(2,23) - 1.0;
-			const double scale = 4.5 / gain / base;
-
-			const double sampleValue = sensors[i].GetValue() * scale;
-			mDevice->GetSensor(i + sensorIndexOffset)->AddQueuedSample((double)sampleValue);
+			if (packets[i][offsetof(OpenBCIStreamPacket, mSampleNumber)] % 2 == 0)
+				mDaisyPackets.Add(packets[i]);
+			else
+				mBoardPackets.Add(packets[i]);
 		}
+
+		PushEEGSamples(mBoardPackets.GetReadPtr(), mBoardPackets.Size(), 8, 0);
+		PushEEGSamples(mDaisyPackets.GetReadPtr(), mDaisyPackets.Size(), 8, 8);
 	}
 	else
 	{
 		// 8 channel device (and maybe ganglion)
-		const uint32 numElectrodes = mDevice->GetNumNeuroSensors();
-		for (uint32 i = 0; i < numElectrodes; ++i)
-		{
-			const double gain = mElectrodeGainSettings[i];
-			const uint32 base = Math::PowD(2,23) - 1.0;
-			const double scale = 4.5 / gain / base;
-
-			const double sampleValue = sensors[i].GetValue() * scale;
-			mDevice->GetSensor(i)->AddQueuedSample((double)sampleValue);
-		}
+		PushEEGSamples(packets, numPackets, Min<uint32>(mDevice->GetNumNeuroSensors(), 8), 0);
 	}
 
-	// read out acceleration streampacket and feed them into the sensor channels
-	const OpenBCIStreamAccData* accSensor = packet.mAcceleration;
-	double accValueLeftDelta    = accSensor[0].GetValue();
-	double accValueForwardDelta = accSensor[1].GetValue();
-	double accValueUpDelta = accSensor[2].GetValue();
-
+	// read out the acceleration values of all packets
 	const uint32 scaleFactor = 8500;
-	accValueLeftDelta    /= scaleFactor;
-	accValueUpDelta      /= scaleFactor;
-	accValueForwardDelta /= scaleFactor;
+	mScales.Resize(3);
+	mScales.SetAll(1.0 / scaleFactor);
+	mSamples.Resize(3 * numPackets);
+	SerialFramer::DecodeInt16(packets, numPackets, offsetof(OpenBCIStreamPacket, mAcceleration), 3, mScales.GetReadPtr(), mSamples.GetPtr(), numPackets);
+
+	// the accelerometer is sampled slower than the EEG: hold the last non-zero value of each axis
+	double* accLeft    = mSamples.GetPtr();
+	double* accForward = mSamples.GetPtr() + numPackets;
+	double* accUp      = mSamples.GetPtr() + 2 * numPackets;
+	for (uint32 i = 0; i < numPackets; ++i)
+	{
+		if (accLeft[i] != 0)
+			mAccValueLeft = accLeft[i];
 
-	if (accValueLeftDelta != 0)
-	    mAccValueLeft    = accValueLeftDelta;
+		if (accUp[i] != 0)
+			mAccValueUp = accUp[i];
 
-	if (accValueUpDelta != 0)
-	    mAccValueUp      = accValueUpDelta;
+		if (accForward[i] != 0)
+			mAccValueForward = accForward[i];
 
-	if (accValueForwardDelta != 0)
-	    mAccValueForward = accValueForwardDelta;
+		accLeft[i]    = mAccValueLeft;
+		accUp[i]      = mAccValueUp;
+		accForward[i] = mAccValueForward;
+	}
 
 	// set values for acceleration
-    mDevice->GetAccLeftSensor()->AddQueuedSample((double)mAccValueLeft);
-    mDevice->GetAccUpSensor()->AddQueuedSample((double)mAccValueUp);
-    mDevice->GetAccForwardSensor()->AddQueuedSample((double)mAccValueForward);
+	mDevice->GetAccLeftSensor()->AddQueuedSamples(accLeft, numPackets);
+	mDevice->GetAccUpSensor()->AddQueuedSamples(accUp, numPackets);
+	mDevice->GetAccForwardSensor()->AddQueuedSamples(accForward, numPackets);
 }
 
 
-// read one stream packet from serial port into data struct
-bool OpenBCISerialHandler::ReadStreamPacket(OpenBCIStreamPacket* data)
+// decode the 24 bit EEG values of the packets and push them into the sensors (one call per sensor)
+void OpenBCISerialHandler::PushEEGSamples(const uint8* const* packets, uint32 numPackets, uint32 numElectrodes, uint32 sensorIndexOffset)
 {
-	if (mSerialPort == NULL)
-		return false;
-
-	// no data -> return (probably does not happen?)
-	if (mSerialPort->GetNumBytesAvailable() == 0)
-		return false;
-
-	// check if first byte is a stream packet header char
-	char header;
-	mSerialPort->GetChar(&header);
-	if (header != OpenBCIStreamPacket::GetProtocolHeader())
-	{
-		// first byte is not the header of a stream packet 
-		
-		// if we received an 's', the openbci was disconnected
-		if (header == 's' && mDevice->IsStreaming() == true)
-		{
-			Disconnect();
-			return false;
-		}	
-		else
-		{
-			// forward until header char is found
-			while (mSerialPort->GetNumBytesAvailable() > 0 && header != OpenBCIStreamPacket::GetProtocolHeader())
-			{
-				mSerialPort->GetChar(&header);
-#ifdef CORE_DEBUG
-				LogDebug("OpenBCI: dropped rx byte %c", header);
-#endif
-			}
-
-			// put back header char (if any)
-			if (header == OpenBCIStreamPacket::GetProtocolHeader())
-				mSerialPort->UngetChar(header);
-			else
-				return false;
-		}
-	}
-	else
-	{
-		mSerialPort->UngetChar(header);
-	}
-
-	// check if the buffer has enough bytes are present to read the rest
-	//const uint32 packetSize = sizeof(data);
-	// FIXME: Why is sizeof(data) = 4 bytes? This doesn't make any sense
-	const uint32 packetSize = sizeof(data->mHeader) + sizeof(data->mSampleNumber) +
-		                      sizeof(data->mSensors) + sizeof(data->mAcceleration) +
-						      sizeof(data->mFooter);
-
-	if (mSerialPort->GetNumBytesAvailable() < packetSize)
-		return false;
-
-	// try to read the stream packet
-	const uint32 result = mSerialPort->Read((char*)data, packetSize);
+	if (numPackets == 0)
+		return;
 
-	CORE_ASSERT (result == packetSize);
+	// raw value to volts
+	const double base = Math::PowD(2, 23) - 1.0;
+	mScales.Resize(numElectrodes);
+	for (uint32 i = 0; i < numElectrodes; ++i)
+		mScales[i] = 4.5 / mElectrodeGainSettings[i + sensorIndexOffset] / base;
 
-	// debug : print received data bytes as hex to console
-	//String tmp;
-	//unsigned char* bdata = reinterpret_cast<unsigned char*>(data);
-	//for (uint32 i=0; i<result; i++)
-	//{
-	//	tmp.Format("%x ",(int)bdata[i]);
-	//	OutputDebugStringA(tmp.AsChar());
-	//}
+	mSamples.Resize(numElectrodes * numPackets);
+	SerialFramer::DecodeInt24(packets, numPackets, offsetof(OpenBCIStreamPacket, mSensors), numElectrodes, mScales.GetReadPtr(), mSamples.GetPtr(), numPackets);
 
-	return true;
+	for (uint32 i = 0; i < numElectrodes; ++i)
+		mDevice->GetSensor(i + sensorIndexOffset)->AddQueuedSamples(mSamples.GetReadPtr() + i * numPackets, numPackets);
 }
 
+
+// parse everything the reader thread has received since the last call
 void OpenBCISerialHandler::ReadStream()
 {
-	//// DEBUG: flush serial instream do debug log
-	//const uint32 numBytes = mSerialPort->GetNumBytesAvailable();
-	//if (mSerialPort != NULL && numBytes > 0)
-	//{
-	//	String str; str.Resize(numBytes);
-	//	const uint32 numBytesRead = mSerialPort->Read(str.AsChar(), numBytes);
-	//	str.Resize(numBytesRead);
-	//	LogDebug(str.AsChar());
-	//}
-
-
-	 //try to read stream packets
-	while(ReadStreamPacket(&mStreamPacket) == true)
-	{
-		if (mStreamPacket.Verify() == true)
-		{
-			ProcessStreamPacket(mStreamPacket);
-			mNumPackets++;
+	if (mReader->Read(mFramer) == 0)
+		return;
 
-			//String tmp;
-			//tmp.Format("Read %i stream packets", mNumPackets);
-			//LogDetailedInfo(tmp.AsChar());
-		}
-		else
-		{
-			LogWarning("OpenBCISerialHandler: received invalid stream packet:");
-		}
-	}
+	const uint32 numPackets = mFramer.Parse();
+	if (numPackets == 0)
+		return;
 
-	
+	ProcessStreamPackets(mFramer.GetFrames(), numPackets);
+	mNumPackets += numPackets;
 }
 
 #endif
@@ -28,6 +28,8 @@
 #include <Config.h>
 #include "OpenBCICommands.h"
 #include <System/SerialPort.h>
+#include <System/SerialReader.h>
+#include <Devices/SerialFramer.h>
 #include <Devices/OpenBCI/OpenBCIDevices.h>
 #include <Device.h>
 #include <QObject>
@@ -65,9 +67,9 @@ class OpenBCISerialHandler : public QObject
 		bool SendStopCommand();
 		bool SendResetCommand();
 
-		// process data from an incoming stream packet
-		void ProcessStreamPacket(const OpenBCIStreamPacket& packet);
-		bool ReadStreamPacket(OpenBCIStreamPacket* data);
+		// decode all stream packets found by the framer and push them into the sensors in bulk
+		void ProcessStreamPackets(const uint8* const* packets, uint32 numPackets);
+		void PushEEGSamples(const uint8* const* packets, uint32 numPackets, uint32 numElectrodes, uint32 sensorIndexOffset);
 
 	private:
 		OpenBCIDeviceBase*		mDevice;
@@ -75,16 +77,24 @@ class OpenBCISerialHandler : public QObject
 		bool					mIsConnected;
 		QTimer*					mTimer;
 
+		// stream ingestion: the reader thread drains the port, the framer cuts the bytes into stream packets
+		SerialReader*			mReader;
+		SerialFramer			mFramer;
+		Core::Array<const uint8*> mBoardPackets;
+		Core::Array<const uint8*> mDaisyPackets;
+		Core::Array<double>		mScales;
+		Core::Array<double>		mSamples;
+
 		uint32					mLastPacketIndex;
 		double					mSampleRate;
 
-		OpenBCIStreamPacket		mStreamPacket;
 		Core::Array<uint32>		mElectrodeGainSettings;
 		double                  mAccValueLeft;
 		double                  mAccValueUp;
 		double                  mAccValueForward;
 
 		uint32					mNumPackets;
+		uint32					mNumLostPackets;
 
 };
 
@@ -64,6 +64,7 @@ class VersusDriver : public QObject, public DeviceDriver, public Core::EventHand
 
 		// main update function
 		void Update(const Core::Time& elapsed, const Core::Time& delta) override;
+		bool HasThreadAffinity() const override							{ return true; }
 
 		bool HasAutoDetectionSupport() const override		{ return true; }
 		void SetAutoDetectionEnabled(bool enable = true) override;
@@ -27,6 +27,7 @@
 #include <Devices/Versus/VersusDevice.h>
 #include <QCoreApplication>
 #include <QTimer>
+#include <string.h>
 
 #ifdef INCLUDE_DEVICE_SENSELABS_VERSUS
 
@@ -46,6 +47,10 @@ VersusSerialHandler::VersusSerialHandler(SerialPort* port, VersusDevice* headset
 	mTimer->setTimerType(Qt::PreciseTimer);
 	mTimer->setInterval(2 * 1000 / mSampleRate);
 
+	// stream packets are fixed-size and framed by the '@' header and the '\r' footer
+	mReader = new SerialReader();
+	mFramer.Init(mStreamPacket.GetSize(), '@', '\r');
+
 	mIsConnected = false;
 }
 
@@ -53,6 +58,10 @@ VersusSerialHandler::VersusSerialHandler(SerialPort* port, VersusDevice* headset
 // destructor
 VersusSerialHandler::~VersusSerialHandler()
 {
+	// give the port back before it is closed
+	mReader->Stop();
+	delete mReader;
+
 	if (mSerialPort != NULL)
 	{
 		// FIXME serial port close() hangs 15 secs if bluetooth device is disconnected
@@ -115,7 +124,16 @@ bool VersusSerialHandler::Connect()
 		return false;
 	}
 
-	// start data receive thread
+	// start draining the port on the reader thread, the timer then only has to parse what has arrived
+	mFramer.Clear();
+	if (mReader->Start(mSerialPort) == false)
+	{
+		LogError("Versus: failed to start the serial reader");
+		Disconnect();
+		return false;
+	}
+
+	// start data receive timer
 	mTimer->start();
 
 	return true;
@@ -128,6 +146,9 @@ void VersusSerialHandler::Disconnect()
 	if (mSerialPort == NULL)
 		return;
 
+	// the port has to be back on this thread before we can send the stop command
+	mReader->Stop();
+
 	if (mSerialPort->IsOpen() == true)
 	{
 		SendCommand(STOP_STREAM);
@@ -254,102 +275,28 @@ bool VersusSerialHandler::ReadCommandPacket(VersusCommandPacket* data)
 }
 
 
-// read one stream packet
-bool VersusSerialHandler::ReadStreamPacket(VersusStreamPacket* data)
+// parse all stream packets that have arrived since the last call
+void VersusSerialHandler::ReadStream()
 {
-	if (mSerialPort == NULL)
-		return false;
-
-	// no data -> return (probably does not happen?)
-	if (mSerialPort->GetNumBytesAvailable() == 0)
-		return false;
-
-	// check if first byte is a stream packet header char
-	char header;
-	mSerialPort->GetChar(&header);
-	if (header != '@')
-	{
-		// first byte is not the header of a stream packet 
-		//  -> skip chars up to (and including) the next '\r', and check the header again
-		char c = 'X';
-		while (header != '@')
-		{
-			LogDetailedInfo("Warning: Serial stream contains unknown header '%c', skipping until end of line", header);
-
-			// seek for next '\r'
-			c = 'X';
-			bool success = true;
-			while (c != '\r')
-			{
-				const uint32 result = mSerialPort->Read(&c, 1);
-				if (result != 1)
-				{
-					// no more data in buffer
-					success = false;
-					break;
-				}
-			}
-
-			if (success == false)
-				break;
-
-			// try to read header
-			const uint32 result = mSerialPort->Read(&header, 1);
-			if (result != 1)
-			{
-				// no more data in buffer
-				return false;
-			}
-		}
-
-	}
-
-	// put back the header char
-	mSerialPort->UngetChar(header);
-
-	// check if the buffer has enough bytes are present to read the rest
-	const uint32 packetSize = data->GetSize();
-	if (mSerialPort->GetNumBytesAvailable() < packetSize)
-		return false;
-
-	// try to read the stream packet
-	const uint32 result = mSerialPort->Read((char*)data, packetSize);
-
-	CORE_ASSERT(result == packetSize);
+	if (mReader->Read(mFramer) == 0)
+		return;
 
-	// debug : print received data bytes as hex to console
-	/*String tmp;
-	unsigned char* bdata = reinterpret_cast<unsigned char*>(data);
-	for (uint32 i=0; i<result; i++)
+	const uint32 numPackets = mFramer.Parse();
+	const uint32 packetSize = mStreamPacket.GetSize();
+	for (uint32 i=0; i<numPackets; ++i)
 	{
-	tmp.Format("%x ",(int)bdata[i]);
-	OutputDebugStringA(tmp.AsChar());
-	} */
+		// the frames are not aligned, copy them into the packet struct
+		memcpy(&mStreamPacket, mFramer.GetFrame(i), packetSize);
 
-	return true;
-}
-
-void VersusSerialHandler::ReadStream()
-{
-	//uint numPackets = 0;
-	//try to read stream packets
-	while (ReadStreamPacket(&mStreamPacket) == true)
-	{
+		// the framer only checks header and footer, the remaining fields tell command answers apart from stream packets
 		if (mStreamPacket.Verify() == true)
-		{
 			ProcessStreamPacket(mStreamPacket);
-			//numPackets++;
-		}
 		else
 		{
 			LogError("VersusSerialHandler: received invalid stream packet:");
 			mStreamPacket.Print();
 		}
 	}
-
-	//String tmp;
-	//tmp.Format("Read %i stream packets", numPackets);
-	//LogDetailedInfo(tmp.AsChar());
 }
 
 #endif
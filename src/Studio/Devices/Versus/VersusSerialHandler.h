@@ -30,6 +30,8 @@
 #include "VersusCommands.h"
 
 #include <System/SerialPort.h>
+#include <System/SerialReader.h>
+#include <Devices/SerialFramer.h>
 #include <QObject>
 #include <QThread>
 #include <QTimer>
@@ -69,12 +71,13 @@ private:
 	uint32					mLastPacketIndex;
 	double					mSampleRate;
 
+	SerialReader*			mReader;
+	SerialFramer			mFramer;
 	VersusStreamPacket		mStreamPacket;
 
 	// command and stream read/write functions
 	bool WriteCommandPacket(VersusCommandPacket* packet);			// write one command data packet
 	bool ReadCommandPacket(VersusCommandPacket* inOutPacket);		// read one command data packet
-	bool ReadStreamPacket(VersusStreamPacket* inOutPacket);			// read one stream data packet
 
 };
 
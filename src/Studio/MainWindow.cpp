@@ -1220,8 +1220,18 @@ void MainWindow::OnSettings()
 
 		// performance
 		mEngineUpdateRateProperty = generalPropertyWidget->GetPropertyManager()->AddFloatSpinnerProperty("Performance", "Engine Update Rate (Hz)", GetEngineUpdateRate(), GetEngineUpdateRate(), FLT_MIN, FLT_MAX);
+		mEngineThreadProperty = generalPropertyWidget->GetPropertyManager()->AddBoolProperty("Performance", "Update Engine On Separate Thread", GetEngineThreadEnabled(), false);
 		mInterfaceUpdateRateProperty = generalPropertyWidget->GetPropertyManager()->AddFloatSpinnerProperty("Performance", "Interface Update Rate (Hz)", GetInterfaceUpdateRate(), GetInterfaceUpdateRate(), FLT_MIN, FLT_MAX);
 		mRealtimeInterfaceUpdateRateProperty = generalPropertyWidget->GetPropertyManager()->AddFloatSpinnerProperty("Performance", "Realtime Interface Update Rate (Hz)", GetRealtimeUIUpdateRate(), GetRealtimeUIUpdateRate(), FLT_MIN, FLT_MAX);
+
+		// recording storage
+		Array<String> channelStorageComboValues;
+		channelStorageComboValues.Add("Memory");
+		channelStorageComboValues.Add("Compressed");
+		channelStorageComboValues.Add("Compressed On Disk");
+		EngineManager::ChannelStorageSettings& channelStorageSettings = GetEngine()->GetChannelStorageSettings();
+		mChannelStorageModeProperty = generalPropertyWidget->GetPropertyManager()->AddComboBoxProperty("Performance", "Recording Storage", channelStorageComboValues, channelStorageSettings.mMode, false);
+		mChannelStorageHotDurationProperty = generalPropertyWidget->GetPropertyManager()->AddFloatSpinnerProperty("Performance", "Uncompressed Recording Duration (s)", channelStorageSettings.mHotDuration, 60.0f, 5.0f, FLT_MAX);
 	
 		//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 		// Devices category
@@ -1358,10 +1368,24 @@ void MainWindow::OnValueChanged(Property* property)
 	// performance
 	if (property == mEngineUpdateRateProperty)
 		SetEngineUpdateRate(property->AsFloat());
+	if (property == mEngineThreadProperty)
+		SetEngineThreadEnabled(property->AsBool());
 	if (property == mInterfaceUpdateRateProperty)
 		SetInterfaceUpdateRate(property->AsFloat());
 	if (property == mRealtimeInterfaceUpdateRateProperty)
 		SetRealtimeUIUpdateRate(property->AsFloat());
+
+	// recording storage (the engine thread reads the settings while it adds samples)
+	if (property == mChannelStorageModeProperty || property == mChannelStorageHotDurationProperty)
+	{
+		EngineThread::LockScope lockScope;
+
+		EngineManager::ChannelStorageSettings& channelStorageSettings = GetEngine()->GetChannelStorageSettings();
+		if (property == mChannelStorageModeProperty)
+			channelStorageSettings.mMode = (EngineManager::EChannelStorageMode)property->AsInt();
+		else
+			channelStorageSettings.mHotDuration = property->AsFloat();
+	}
 	
 	// global device autodetection
 	if (property == mAutoDetectionProperty)
@@ -1541,6 +1565,8 @@ void MainWindow::OnLoadSettings()
 	// performance
 	const float engineUpdateRate = settings.value("engineUpdateRate", GetEngineUpdateRate()).toFloat();
 	SetEngineUpdateRate(engineUpdateRate);
+	const bool engineThreadEnabled = settings.value("engineThread", GetEngineThreadEnabled()).toBool();
+	SetEngineThreadEnabled(engineThreadEnabled);
 	const float interfaceUpdateRate = settings.value("interfaceUpdateRate", GetInterfaceUpdateRate()).toFloat();
 	SetInterfaceUpdateRate(interfaceUpdateRate);
 	const float realtimeInterfaceUpdateRate = settings.value("realtimeInterfaceUpdateRate", GetRealtimeUIUpdateRate()).toFloat();
@@ -1560,6 +1586,15 @@ void MainWindow::OnLoadSettings()
 	driftSettings.mMaxDriftUntilSync		= settings.value("driftCorrectionMaxDriftUntilSync",	driftSettings.mMaxDriftUntilSync).toFloat();
 	driftSettings.mMaxForwardDrift			= settings.value("driftCorrectionMaxForwardDrift",		driftSettings.mMaxForwardDrift).toFloat();
 	driftSettings.mMaxBackwardDrift			= settings.value("driftCorrectionMaxBackwardDrift",		driftSettings.mMaxBackwardDrift).toFloat();
+
+	// recording storage settings (the engine thread may already run)
+	{
+		EngineThread::LockScope lockScope;
+
+		EngineManager::ChannelStorageSettings& channelStorageSettings = GetEngine()->GetChannelStorageSettings();
+		channelStorageSettings.mMode			= (EngineManager::EChannelStorageMode)settings.value("channelStorageMode", channelStorageSettings.mMode).toInt();
+		channelStorageSettings.mHotDuration		= settings.value("channelStorageHotDuration", channelStorageSettings.mHotDuration).toDouble();
+	}
 	
 	// enable/disable device system
 	const uint32 numDevices = GetDeviceManager()->GetNumDeviceDrivers();
@@ -1650,6 +1685,7 @@ void MainWindow::OnSaveSettings()
 	
 	// performance
 	settings.setValue("engineUpdateRate", GetEngineUpdateRate());
+	settings.setValue("engineThread", GetEngineThreadEnabled());
 	settings.setValue("interfaceUpdateRate", GetInterfaceUpdateRate());
 	settings.setValue("realtimeInterfaceUpdateRate", GetRealtimeUIUpdateRate());
 
@@ -1666,6 +1702,11 @@ void MainWindow::OnSaveSettings()
 	settings.setValue("driftCorrectionMaxForwardDrift",		driftSettings.mMaxForwardDrift);
 	settings.setValue("driftCorrectionMaxBackwardDrift",	driftSettings.mMaxBackwardDrift);
 
+	// recording storage settings
+	EngineManager::ChannelStorageSettings& channelStorageSettings = GetEngine()->GetChannelStorageSettings();
+	settings.setValue("channelStorageMode",				channelStorageSettings.mMode);
+	settings.setValue("channelStorageHotDuration",		channelStorageSettings.mHotDuration);
+
 	const uint32 numDeviceAutoDetectionProperties = GetDeviceManager()->GetNumDeviceDrivers();
 	for (uint32 i = 0; i < numDeviceAutoDetectionProperties; ++i)
 	{
@@ -116,7 +116,10 @@ class MainWindow : public MainWindowBase, public Core::EventHandler
 
 		// performance
 		Property*					mEngineUpdateRateProperty;
+		Property*					mEngineThreadProperty;
 		Property*					mRealtimeInterfaceUpdateRateProperty;
+		Property*					mChannelStorageModeProperty;
+		Property*					mChannelStorageHotDurationProperty;
 		Property*					mInterfaceUpdateRateProperty;
 
 		// devices
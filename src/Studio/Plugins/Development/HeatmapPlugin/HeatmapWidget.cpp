@@ -35,112 +35,86 @@ using namespace Core;
 HeatmapWidget::HeatmapWidget(HeatmapPlugin* plugin, QWidget* parent) : OpenGLWidget(parent)
 {
 	mPlugin		= plugin;
-	mEmptyText	= "This is the text shown in case no split view is rendered (e.g. in case no classifier or device is active)";
+	mEmptyText	= "Add a topographic map node to the classifier to see the scalp map.";
+
+	mColorMapper.SetColorMapping(ColorMapper::COLORMAPPING_ISOLUMINANTBLUERED);
 }
 
 
 // destructor
 HeatmapWidget::~HeatmapWidget()
 {
-    mProgram->release();
-	delete mProgram;
-}
-
-
-void HeatmapWidget::initializeGL()
-{
-    // base class initialize
-	OpenGLWidget::initializeGL();
-	InitShader();
 }
 
 
 // render frame
 void HeatmapWidget::paintGL()
 {
-    // get the time delta since the last render call
-	//const double timeDelta = GetTimeDelta();
-    //int timeSinceRenderStart = QTime::currentTime().msec();
-
-	if (GetDeviceManager()->GetNumDevices() == 0)
+	QPainter painter(this);
+	painter.setRenderHint(QPainter::Antialiasing);
+	painter.setRenderHint(QPainter::SmoothPixmapTransform);
+	painter.fillRect(rect(), Qt::black);
+
+	// the map is interpolated by the engine, we only colorize it here
+	TopographicMapNode* node = FindTopographicMapNode();
+	if (node == NULL || node->IsInitialized() == false || node->GetResolution() == 0)
+	{
+		painter.setPen(Qt::white);
+		painter.drawText(rect(), Qt::AlignCenter, mEmptyText.AsChar());
+		update();
 		return;
+	}
+
+	// symmetric value range around zero
+	const uint32 resolution = node->GetResolution();
+	const uint32 numPixels = resolution * resolution;
+	const double* map = node->GetScalpMap();
+
+	double maxValue = 0.0;
+	for (uint32 i = 0; i < numPixels; ++i)
+		maxValue = Max(maxValue, Math::AbsD(map[i]));
+	if (maxValue <= 0.0)
+		maxValue = 1.0;
+
+	if (mImage.width() != (int32)resolution)
+		mImage = QImage(resolution, resolution, QImage::Format_ARGB32);
+
+	for (uint32 row = 0; row < resolution; ++row)
+	{
+		QRgb* line = reinterpret_cast<QRgb*>(mImage.scanLine(row));
+		for (uint32 col = 0; col < resolution; ++col)
+		{
+			const uint32 pixel = row * resolution + col;
+			if (node->IsInsideHead(pixel) == false)
+			{
+				line[col] = qRgba(0, 0, 0, 0);
+				continue;
+			}
+
+			const Color color = mColorMapper.CalcColor(0.5 + 0.5 * map[pixel] / maxValue);
+			line[col] = ToQColor(color).rgba();
+		}
+	}
+
+	// draw the map into a centered square with the head outline on top
+	const int32 size = Min(width(), height()) - 20;
+	const QRect target((width() - size) / 2, (height() - size) / 2, size, size);
+	painter.drawImage(target, mImage);
+
+	painter.setPen(QPen(Qt::white, 2));
+	painter.setBrush(Qt::NoBrush);
+	painter.drawEllipse(target);
 
-    Device* device = GetDeviceManager()->GetDevice(0);
-    BciDevice* headset = static_cast<BciDevice*>(device);
-    const uint32 numElectrodes = headset->GetNumSensors();
-    
-	// FIXME: dynamic allocation or usage of electrode.max()
-    QVector2D electrodeAngles[8];
-	GLfloat electrodeSignals[8];
-
-	// set colorcode
-	QVector3D colorcodeRGBA = QVector3D(1.0, 0.0, 0.0);
-	GLint exponent          = 30;
-
-    for (uint32 i = 0; i < numElectrodes; ++i)
-    {
-        Sensor* sensor = headset->GetNeuroSensor(i);
-		// get coordinates of signals
-		// TODO: normalize this
-        EEGElectrodes::Electrode electrode = GetEEGElectrodes()->GetElectrodeByID(sensor->GetName());
-        const float theta = electrode.GetTheta();
-		const float phi   = electrode.GetPhi();
-        // set electrode angles
-        electrodeAngles[i] = QVector2D(theta, phi);
-
-		electrodeSignals[i] = 0.0;
-		// set signal strength
-		electrodeSignals[0] = 1.0;
-		//electrodeSignals[1] = 1.0;
-		electrodeSignals[2] = 1.0;
-		electrodeSignals[5] = 1.0;
-    }
-
-    // pass attributes to shader
-    mProgram->setAttributeValue("width", width());
-    mProgram->setAttributeValue("height", height());
-	mProgram->setAttributeValue("numElectrodes", numElectrodes);
-	// pass uniforms to shader
-    mProgram->setUniformValueArray("electrodeAngles", electrodeAngles, 8);
-    mProgram->setUniformValueArray("electrodeSignals", electrodeSignals, 8, 1);
-	mProgram->setUniformValue("colorcode", colorcodeRGBA);
-	mProgram->setUniformValue("exponent", exponent);
-
-    glEnable(GL_BLEND);
-	glBegin(GL_TRIANGLES);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	// first triangle
-	glVertex3f(-1.0, -1.0, 0.0);
-	glVertex3f(-1.0,  1.0, 0.0);
-	glVertex3f( 1.0,  1.0, 0.0);
-	// second triangle
-	glVertex3f(-1.0, -1.0, 0.0);
-	glVertex3f( 1.0, -1.0, 0.0);
-	glVertex3f( 1.0,  1.0, 0.0);
-	glEnd();
 	update();
-	glDisable(GL_BLEND);
 }
 
 
-void HeatmapWidget::InitShader()
+// the first topographic map node of the active classifier
+TopographicMapNode* HeatmapWidget::FindTopographicMapNode() const
 {
+	Classifier* classifier = GetEngine()->GetActiveClassifier();
+	if (classifier == NULL || classifier->GetNumTopographicMapNodes() == 0)
+		return NULL;
 
-	mProgram = new QOpenGLShaderProgram();
-
-	// Compile vertex shader
-	if (!mProgram->addShaderFromSourceFile(QOpenGLShader::Vertex, GetAppDir() + "../Source/Resources/Assets/Shaders/HeatmapVertexShader.glsl"))
-		close();
-
-	// Compile fragment shader
-	if (!mProgram->addShaderFromSourceFile(QOpenGLShader::Fragment, GetAppDir() + "../Source/Resources/Assets/Shaders/HeatmapFragmentShader.glsl"))
-		close();
-
-    // Link shader pipeline
-    if (!mProgram->link())
-        close();
-
-    // Bind shader pipeline for use
-    if (!mProgram->bind())
-        close();
+	return classifier->GetTopographicMapNode(0);
 }
@@ -27,8 +27,9 @@
 // include required headers
 #include "../../../Config.h"
 #include "../../../Rendering/OpenGLWidget2DHelpers.h"
-#include "qopenglshaderprogram.h"
 #include <Engine/EngineManager.h>
+#include <Engine/ColorMapper.h>
+#include <QImage>
 
 
 // forward declaration
@@ -44,15 +45,14 @@ class HeatmapWidget : public OpenGLWidget
 
 		// render frame
 		void paintGL() override final;
-        void initializeGL() override final;
 
 	private:
+		// find the scalp map to render (first topographic map node of the active classifier)
+		TopographicMapNode* FindTopographicMapNode() const;
 
-        void GetSensorRenderInfo(Sensor* sensor, float halfHeadWidth, float halfHeadHeight, const Core::Vector2& screenCenter, QColor* outBrushColor, QColor* outPenColor, QRectF* outRectF, QRect* outRect);
-        void InitShader();
-
-		HeatmapPlugin*	                mPlugin;
-        QOpenGLShaderProgram*           mProgram;
+		HeatmapPlugin*					mPlugin;
+		ColorMapper						mColorMapper;
+		QImage							mImage;
 };
 
 
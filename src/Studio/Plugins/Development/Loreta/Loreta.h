@@ -32,6 +32,7 @@
 #include "../../../../../Engine/Source/Core/FpsCounter.h"
 #include "../../../Rendering/Mesh.h"
 #include "EngineManager.h"
+#include <DSP/LoretaSolver.h>
 #include "Voxel.h"
 #include "LoretaThreadHandler.h"
 
@@ -46,35 +47,22 @@ class Loreta
 		~Loreta();
 
 		// setter
-		inline void									SetMatrixS(const Core::Array<cv::Mat>& matrixS)							 { mMatrixS = matrixS; }
 		inline void									SetMatrixPhi(const cv::Mat& matrixPhi)									 { mMatrixPhi = matrixPhi; }
-		inline void									SetMatrixJCaret(const cv::Mat& matrixJCaret)							 { mMatrixJCaret = matrixJCaret; }
-		inline void									SetLoretaResult(const cv::Mat& loretaResult)							 { mLoretaResult = loretaResult; }
 
 		// getter
 		inline cv::Mat&								GetMatrixJCaret()														 { return mMatrixJCaret; }
 		inline cv::Mat&								GetLoretaResult()														 { return mLoretaResult; }
 
-
-		cv::Mat										CalcLeadField();
 		void										PrecalculateLoretaMatrices();
 		void										CalcLoreta();
-		cv::Mat										GetCenteringMatrix(const uint32 size);
 
 	private:
 		LoretaThreadHandler*						mLoretaThreadHandler;
+		LoretaSolver								mSolver;				// precalculated inverse operator, does the actual work
 
-		cv::Mat										mLeadField;				// input lead matrix, as single matrix storing vec3ds
-		cv::Mat										mMatrixPhi;
-		cv::Mat										mMatrixT;				// matrix T, storing the defined lead fields
-		Core::Array<cv::Mat>						mMatrixS;				// matrix S, storing the correlation between every dipole moment
+		cv::Mat										mMatrixPhi;				// input phi (E x 1)
 		cv::Mat										mMatrixJCaret;			// output J^ = T*Phi
 		cv::Mat										mLoretaResult;			// resultset from loreta by multiplying the SMatrix with JCaret
-		cv::Mat 									mSummedResult;
-		cv::Mat										mVoxelResult;
-		cv::Mat										mTransposedJCaret;
-		Core::Array<cv::Mat>						mMatrixTs;
-		Core::Array<cv::Mat>						mMatrixJCarets;
 
 		// helper
 		void    PrintMatrixToFile(cv::Mat matrix, const char* filename);
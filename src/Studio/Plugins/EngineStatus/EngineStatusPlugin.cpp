@@ -53,6 +53,8 @@ EngineStatusPlugin::EngineStatusPlugin() : Plugin(GetStaticTypeUuid())
 	mLastNumAllocs = 0;
 	mLastNumReallocs = 0;
 	mLastNumFrees = 0;
+	for (uint32 i=0; i<Core::NUM_MEMORYTAGS; ++i)
+		mLastNumTagAllocs[i] = 0;
 	mLastNumOscPacketsReceived = 0;
 	mLastNumOscPacketsSent = 0;
 
@@ -118,6 +120,9 @@ bool EngineStatusPlugin::Init()
 	mMemoryAllocsLabel = new QLabel("N/A");
 	mMemoryReallocsLabel = new QLabel("N/A");
 	mMemoryFreesLabel = new QLabel("N/A");
+	mMemoryRealtimeAllocsLabel = new QLabel("N/A");
+	for (uint32 i=0; i<Core::NUM_MEMORYTAGS; ++i)
+		mMemoryTagLabels[i] = new QLabel("N/A");
 	QGridLayout* perfLayout = new QGridLayout(mDock);
 	perfLayout->setMargin(0);
 	row = 0;
@@ -155,6 +160,18 @@ bool EngineStatusPlugin::Init()
 	row++;
 	perfLayout->addWidget(new QLabel("Total Frees"), row, 0);
 	perfLayout->addWidget(mMemoryFreesLabel, row, 1);
+	row++;
+	perfLayout->addWidget(new QLabel("Realtime Allocations"), row, 0);
+	perfLayout->addWidget(mMemoryRealtimeAllocsLabel, row, 1);
+
+	// memory per subsystem
+	for (uint32 i=0; i<Core::NUM_MEMORYTAGS; ++i)
+	{
+		row++;
+		mTempString.Format("Memory (%s)", Core::GetMemoryTagName((Core::EMemoryTag)i));
+		perfLayout->addWidget(new QLabel(mTempString.AsChar()), row, 0);
+		perfLayout->addWidget(mMemoryTagLabels[i], row, 1);
+	}
 
 	mainLayout->addWidget( new QLabel("") );
 	mainLayout->addWidget( new QLabel("Performance") );
@@ -320,61 +337,73 @@ void EngineStatusPlugin::UpdateInterface()
 
 	// 1) studio and engine performance
 
-#ifdef CORE_DEBUG
-
-	// get values from memory manager
-	const uint32 numAllocs = 0;//CORE_MEMORYINFORMATION->mNumAllocs;			// current number of allocations
-	const uint32 totalNumAllocs = 0;//CORE_MEMORYINFORMATION->mTotalAllocs;		// total number of allocations since start
-	const uint32 totalNumReallocs = 0;//CORE_MEMORYINFORMATION->mTotalReallocs;	// total number of reallocs since start
-	const uint32 totalNumFrees = 0;//CORE_MEMORYINFORMATION->mTotalFrees;		// total number of frees since start
+	// get values from the allocator
+	const Core::MemoryStatistics memoryStats = Core::GetMemoryStatistics();
+	const int64 numAllocs = memoryStats.mNumLiveAllocations;			// current number of allocations
+	const uint64 totalNumAllocs = memoryStats.mNumAllocations;			// total number of allocations since start
+	const uint64 totalNumReallocs = memoryStats.mNumReallocations;		// total number of reallocs since start
+	const uint64 totalNumFrees = memoryStats.mNumFrees;					// total number of frees since start
 
 	// total memory used
-	uint32 totalNumBytes = 0;
-	for (uint32 i=0; i<numAllocs; ++i) 
-		totalNumBytes += 0;//CORE_MEMORYINFORMATION->mAllocs[i].mNumBytes;
+	const int64 totalNumBytes = memoryStats.mNumLiveBytes;
 	
 	// differences and rates (per second)
 
 	// rate of memory change in bytes / second
-	const int32 numBytesDiff = totalNumBytes - (int32)mLastMemoryUsed;
+	const int64 numBytesDiff = totalNumBytes - mLastMemoryUsed;
 	mLastMemoryUsed = totalNumBytes;
 	const double memoryRate = numBytesDiff / timeElapsed;
 	
 	// current alloc rate
-	const int32 numNewAllocs = numAllocs - mLastNumAllocs;
+	const int64 numNewAllocs = numAllocs - mLastNumAllocs;
 	mLastNumAllocs = numAllocs;
 	const double allocRate = numNewAllocs / timeElapsed;
 
 	// total alloc rate
-	const uint32 numNewTotalAllocs = totalNumAllocs - mLastNumTotalAllocs;
+	const uint64 numNewTotalAllocs = totalNumAllocs - mLastNumTotalAllocs;
 	mLastNumTotalAllocs = totalNumAllocs;
 	const double totalAllocRate = numNewTotalAllocs / timeElapsed;
 
 	// total realloc rate
-	const uint32 numNewReallocs = totalNumReallocs - mLastNumReallocs;
+	const uint64 numNewReallocs = totalNumReallocs - mLastNumReallocs;
 	mLastNumReallocs = totalNumReallocs;
 	const double reallocRate = numNewReallocs / timeElapsed;
 
 	// total free rate
-	const uint32 numNewFrees = totalNumFrees - mLastNumFrees;
+	const uint64 numNewFrees = totalNumFrees - mLastNumFrees;
 	mLastNumFrees = totalNumFrees;
 	const double freeRate = numNewFrees / timeElapsed;
 
 	// update ui elements
-	mTempString.Format("%i \t(%.1f/s)", numAllocs, allocRate);
+	mTempString.Format("%lli \t(%.1f/s)", numAllocs, allocRate);
 	mMemoryCurrentAllocsLabel->setText(mTempString.AsChar());
 
 	mTempString.Format("%.1fMB \t(%.2fKB/s)", (double)totalNumBytes / (1024.0*1024.0), memoryRate / (1024.0));
 	mMemoryUsedLabel->setText(mTempString.AsChar());
 
 	// total allocs/reallocs/frees
-	mTempString.Format("%i \t(%.1f/s)", totalNumAllocs, totalAllocRate);
+	mTempString.Format("%llu \t(%.1f/s)", totalNumAllocs, totalAllocRate);
 	mMemoryAllocsLabel->setText(mTempString.AsChar());
-	mTempString.Format("%i \t(%.1f/s)", totalNumReallocs, reallocRate);
+	mTempString.Format("%llu \t(%.1f/s)", totalNumReallocs, reallocRate);
 	mMemoryReallocsLabel->setText(mTempString.AsChar());
-	mTempString.Format("%i \t(%.1f/s)", totalNumFrees, freeRate);
+	mTempString.Format("%llu \t(%.1f/s)", totalNumFrees, freeRate);
 	mMemoryFreesLabel->setText(mTempString.AsChar());
-#endif
+
+	// allocations inside the running classifier update
+	mTempString.Format("%llu", memoryStats.mNumRealtimeAllocations);
+	mMemoryRealtimeAllocsLabel->setText(mTempString.AsChar());
+
+	// live memory and allocation rate per subsystem
+	for (uint32 i=0; i<Core::NUM_MEMORYTAGS; ++i)
+	{
+		const Core::MemoryStatistics tagStats = Core::GetMemoryStatistics((Core::EMemoryTag)i);
+		const uint64 numTagAllocs = tagStats.mNumAllocations + tagStats.mNumReallocations;
+		const double tagAllocRate = (numTagAllocs - mLastNumTagAllocs[i]) / timeElapsed;
+		mLastNumTagAllocs[i] = numTagAllocs;
+
+		mTempString.Format("%.2fMB \t(%.1f allocs/s)", (double)tagStats.mNumLiveBytes / (1024.0*1024.0), tagAllocRate);
+		mMemoryTagLabels[i]->setText(mTempString.AsChar());
+	}
 
 	// interface performance timing
 	mTempString.Format("%.0f (%.0f) FPS - %.2f ms", GetMainWindow()->GetOpenGLFpsCounter().GetFps(), GetMainWindow()->GetOpenGLFpsCounter().GetTheoreticalFps(), GetMainWindow()->GetOpenGLFpsCounter().GetAveragedTimeDelta()*1000.0);
@@ -57,7 +57,8 @@ class EngineStatusPlugin : public Plugin
 		void UpdateInterface() override;
 
 		// log one line to the console textedit (used by log callback)
-		void LogLine( const char* text )												{ if (mLogOutput != NULL) mLogOutput->append( text ); }
+		// NOTE: may be called from the log thread, the line is appended on the UI thread
+		void LogLine( const char* text )												{ if (mLogOutput != NULL) QMetaObject::invokeMethod( mLogOutput, "append", Qt::AutoConnection, Q_ARG(QString, text) ); }
 
 	private slots:
 		void OnTimerTimeout();
@@ -77,6 +78,8 @@ class EngineStatusPlugin : public Plugin
 		QLabel*				mMemoryAllocsLabel;
 		QLabel*				mMemoryReallocsLabel;
 		QLabel*				mMemoryFreesLabel;
+		QLabel*				mMemoryRealtimeAllocsLabel;
+		QLabel*				mMemoryTagLabels[Core::NUM_MEMORYTAGS];
 
 		// network server information
 		QLabel*				mServerStatusLabel;
@@ -103,11 +106,12 @@ class EngineStatusPlugin : public Plugin
 
 		QTimer				mUpdateTimer;
 		Core::Timer			mUpdateDeltaTimer;
-		uint32				mLastMemoryUsed;
-		uint32				mLastNumTotalAllocs;
-		uint32				mLastNumAllocs;
-		uint32				mLastNumReallocs;
-		uint32				mLastNumFrees;
+		int64				mLastMemoryUsed;
+		uint64				mLastNumTotalAllocs;
+		int64				mLastNumAllocs;
+		uint64				mLastNumReallocs;
+		uint64				mLastNumFrees;
+		uint64				mLastNumTagAllocs[Core::NUM_MEMORYTAGS];
 		uint32				mLastNumOscPacketsReceived;
 		uint32				mLastNumOscPacketsSent;
 
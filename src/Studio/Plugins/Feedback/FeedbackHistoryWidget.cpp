@@ -28,6 +28,7 @@
 #include <Core/LogManager.h>
 #include <Core/EventManager.h>
 #include <EngineManager.h>
+#include <EngineThread.h>
 #include <ColorPalette.h>
 #include "../../Rendering/OpenGLWidget2DHelpers.h"
 #include <QPainter>
@@ -114,6 +115,9 @@ void FeedbackHistoryWidget::paintGL()
 
 	RenderSplitViews( numCustomFeedbackNodes );
 
+	// release the snapshots of feedback nodes that are not displayed anymore
+	mSnapshots.ReleaseUnused();
+
 	// post rendering
 	PostRendering();
 }
@@ -173,6 +177,14 @@ void FeedbackHistoryWidget::RenderCallback::Render(uint32 index, bool isHighligh
 	
 	bool drawLatencyMarker = mFeedbackWidget->GetPlugin()->GetShowLatencyMarker();
 
+	// get the snapshot of the feedback channel (it has to hold all samples within the time range) and the name while the engine is locked
+	const uint32 maxNumSamples = (uint32)(timeRange * channel->GetSampleRate()) + 2;
+	ChannelSnapshot* snapshot = mFeedbackWidget->mSnapshots.Get(channel, maxNumSamples);
+	mFeedbackName = feedbackNode->GetName();
+
+	// from here on only the snapshot is accessed, so the engine thread can keep running while we render
+	EngineThread::YieldScope yieldScope;
+
 	// RENDER CHART
 
 	// draw horizontal line (only) grid
@@ -182,7 +194,8 @@ void FeedbackHistoryWidget::RenderCallback::Render(uint32 index, bool isHighligh
 
 	// render feedback signal
 	const OpenGLWidget2DHelpers::EChartRenderStyle style = (OpenGLWidget2DHelpers::EChartRenderStyle)mFeedbackWidget->GetPlugin()->GetSampleStyle();
-	OpenGLWidget2DHelpers::RenderChart( this, channel, FromQtColor(feedbackColor), style, timeRange, maxTime, rangeMin, rangeMax, areaStartX, width, height, height,  drawLatencyMarker);
+	if (snapshot->Read(mFrame) == true)
+		OpenGLWidget2DHelpers::RenderChart( this, mFrame, FromQtColor(feedbackColor), style, timeRange, maxTime, rangeMin, rangeMax, areaStartX, width, height, height,  drawLatencyMarker);
 
 	// use thicker lines if styles with lines are selected
 	if (style == OpenGLWidget2DHelpers::LINE || style == OpenGLWidget2DHelpers::LOLLIPOP || style == OpenGLWidget2DHelpers::CROSS)
@@ -216,8 +229,7 @@ void FeedbackHistoryWidget::RenderCallback::Render(uint32 index, bool isHighligh
 	}
 
 	// render feedback name
-	mTempString.Format("%s", feedbackNode->GetName());
-	RenderText( mTempString.AsChar(), mParent->GetDefaultFontSize(), feedbackNameColor, areaStartX+textMarginX, 0, OpenGLWidget::ALIGN_TOP | OpenGLWidget::ALIGN_LEFT );
+	RenderText( mFeedbackName.AsChar(), mParent->GetDefaultFontSize(), feedbackNameColor, areaStartX+textMarginX, 0, OpenGLWidget::ALIGN_TOP | OpenGLWidget::ALIGN_LEFT );
 }
 
 
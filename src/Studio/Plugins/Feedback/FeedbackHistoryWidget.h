@@ -29,6 +29,7 @@
 #include <DSP/Channel.h>
 #include <Graph/Classifier.h>
 #include "../../Rendering/OpenGLWidget.h"
+#include <ChannelSnapshotManager.h>
 
 
 // forward declaration
@@ -57,6 +58,8 @@ class FeedbackHistoryWidget : public OpenGLWidget
 			private:
 				FeedbackHistoryWidget*	mFeedbackWidget;
 				Core::String			mTempString;
+				Core::String			mFeedbackName;
+				ChannelSnapshot::Frame	mFrame;
 		};
 
 		friend class RenderCallback;
@@ -64,6 +67,7 @@ class FeedbackHistoryWidget : public OpenGLWidget
 		FeedbackPlugin*		mPlugin;
 		RenderCallback*		mRenderCallback;
 		double				mLeftTextWidth;
+		ChannelSnapshotSet	mSnapshots;
 
 		QColor				mGridColor;
 		QColor				mSubGridColor;
@@ -24,9 +24,14 @@
 // include required headers
 #include "GraphInfoWidget.h"
 #include <EngineManager.h>
+#include <QtBaseConfig.h>
 #include <QVBoxLayout>
 #include <QHeaderView>
 #include <QTableWidget>
+#include <QHBoxLayout>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <algorithm>
 
 using namespace Core;
 
@@ -88,6 +93,23 @@ void GraphInfoWidget::Init()
 
 	// add tree
 	layout->addWidget(mInfoTree);
+
+	// node profiling controls
+	QHBoxLayout* profilingLayout = new QHBoxLayout();
+	profilingLayout->setMargin(0);
+
+	mProfilingCheckbox = new QCheckBox("Profile Nodes");
+	mProfilingCheckbox->setToolTip("Measure the update time, samples and allocations of every node");
+	mProfilingCheckbox->setChecked(GetEngine()->GetNodeProfiler()->IsEnabled());
+	connect(mProfilingCheckbox, SIGNAL(stateChanged(int)), this, SLOT(OnProfilingToggled(int)));
+	profilingLayout->addWidget(mProfilingCheckbox);
+
+	mExportTraceButton = new QPushButton("Export Trace");
+	mExportTraceButton->setToolTip("Save the last recorded updates as trace event JSON (chrome://tracing, ui.perfetto.dev)");
+	connect(mExportTraceButton, SIGNAL(clicked()), this, SLOT(OnExportTrace()));
+	profilingLayout->addWidget(mExportTraceButton);
+
+	layout->addLayout(profilingLayout);
 	
 	setLayout(layout);
 }
@@ -107,6 +129,8 @@ void GraphInfoWidget::UpdateInterface()
 	UpdateClassifierSectionItems(mInfoTree);
 	UpdateInputsSectionItems(mInputsSection);
 	UpdateOutputsSectionItems(mOutputsSection);
+	UpdateProfilingSectionItems(mProfilingSection);
+	UpdateBufferPlanSectionItems(mBufferPlanSection);
 }
 
 // add all items to the tree
@@ -131,6 +155,17 @@ void GraphInfoWidget::AddItems()
 	AddOutputsSectionItems(mOutputsSection);
 	mOutputsSection->setExpanded(true);
 
+	// profiling section (filled during the update)
+	mProfilingSection = new QTreeWidgetItem();
+	mProfilingSection->setText(0, "Profiling");
+	mInfoTree->addTopLevelItem(mProfilingSection);
+	mProfilingSection->setExpanded(true);
+
+	// buffer plan section (filled during the update)
+	mBufferPlanSection = new QTreeWidgetItem();
+	mBufferPlanSection->setText(0, "Buffer Plan");
+	mInfoTree->addTopLevelItem(mBufferPlanSection);
+	mBufferPlanSection->setExpanded(false);
 }
 
 // fill the classifier section with items
@@ -393,3 +428,141 @@ void GraphInfoWidget::UpdateOutputsSectionItems(QTreeWidgetItem* parent)
 		item->setText(1, mTempString.AsChar());
 	}
 }
+
+
+// udpate the profiling results of all nodes
+void GraphInfoWidget::UpdateProfilingSectionItems(QTreeWidgetItem* parent)
+{
+	NodeProfiler* profiler = GetEngine()->GetNodeProfiler();
+	if (mClassifier == NULL || profiler->IsEnabled() == false)
+	{
+		parent->setText(1, "Disabled");
+		while (parent->childCount() > 0)
+			delete parent->takeChild(0);
+
+		return;
+	}
+
+	// skip update if parent is collapsed
+	if (parent->isExpanded() == false)
+		return;
+
+	// collect all profiled nodes, most expensive first
+	mProfiledNodes.Clear(false);
+	const uint32 numNodes = mClassifier->GetNumNodes();
+	for (uint32 i=0; i<numNodes; ++i)
+	{
+		Node* node = mClassifier->GetNode(i);
+		if (node->GetProfilerStatistics().mNumUpdates > 0)
+			mProfiledNodes.Add(node);
+	}
+
+	std::sort(mProfiledNodes.GetPtr(), mProfiledNodes.GetPtr() + mProfiledNodes.Size(), [](const Node* a, const Node* b) { return a->GetProfilerStatistics().mExclusiveTime > b->GetProfilerStatistics().mExclusiveTime; });
+
+	const uint32 numProfiledNodes = mProfiledNodes.Size();
+	mTempString.Format("%i nodes", numProfiledNodes);
+	parent->setText(1, mTempString.AsChar());
+
+	// match the number of rows
+	while ((uint32)parent->childCount() > numProfiledNodes)
+		delete parent->takeChild(parent->childCount() - 1);
+	while ((uint32)parent->childCount() < numProfiledNodes)
+		new QTreeWidgetItem(parent);
+
+	// heatmap: scale colors relative to the most expensive node
+	const double maxTime = (numProfiledNodes > 0 ? mProfiledNodes[0]->GetProfilerStatistics().mExclusiveTime : 0.0);
+
+	for (uint32 i=0; i<numProfiledNodes; ++i)
+	{
+		const NodeProfiler::Statistics& stats = mProfiledNodes[i]->GetProfilerStatistics();
+		QTreeWidgetItem* item = parent->child(i);
+
+		item->setText(0, mProfiledNodes[i]->GetName());
+
+		mTempString.Format("%.1f us (%.1f us incl) / %.0f in / %.0f out / %.1f allocs", stats.mExclusiveTime, stats.mUpdateTime, stats.mNumSamplesIn, stats.mNumSamplesOut, stats.mNumAllocations);
+		item->setText(1, mTempString.AsChar());
+
+		const double heat = (maxTime > 0.0 ? stats.mExclusiveTime / maxTime : 0.0);
+		item->setBackground(1, QColor::fromHsvF(0.33 * (1.0 - heat), 0.8, 0.6, 0.5 + 0.5 * heat));
+	}
+}
+
+
+// update the planned output buffer sizes of the classifier
+void GraphInfoWidget::UpdateBufferPlanSectionItems(QTreeWidgetItem* parent)
+{
+	if (mClassifier == NULL)
+	{
+		parent->setText(1, "");
+		while (parent->childCount() > 0)
+			delete parent->takeChild(0);
+
+		return;
+	}
+
+	const BufferPlanner& planner = mClassifier->GetBufferPlanner();
+	const uint32 numEntries = planner.GetNumEntries();
+
+	mTempString.Format("%i buffers / %.2f KB (%.2f KB lookback), %.1f s headroom", numEntries, planner.CalcNumBytes() / 1024.0, planner.CalcNumLookbackBytes() / 1024.0, planner.GetHeadroomDuration());
+	parent->setText(1, mTempString.AsChar());
+
+	// skip update if parent is collapsed
+	if (parent->isExpanded() == false)
+		return;
+
+	// largest buffers first
+	mBufferPlanOrder.Resize(numEntries);
+	for (uint32 i=0; i<numEntries; ++i)
+		mBufferPlanOrder[i] = i;
+
+	std::sort(mBufferPlanOrder.GetPtr(), mBufferPlanOrder.GetPtr() + numEntries, [&planner](uint32 a, uint32 b) { return planner.GetEntry(a).mNumBytes > planner.GetEntry(b).mNumBytes; });
+
+	// match the number of rows
+	while ((uint32)parent->childCount() > numEntries)
+		delete parent->takeChild(parent->childCount() - 1);
+	while ((uint32)parent->childCount() < numEntries)
+		new QTreeWidgetItem(parent);
+
+	for (uint32 i=0; i<numEntries; ++i)
+	{
+		const BufferPlanner::Entry& entry = planner.GetEntry(mBufferPlanOrder[i]);
+		QTreeWidgetItem* item = parent->child(i);
+
+		mTempString.Format("%s: %s", entry.mNodeName.AsChar(), entry.mPortName.AsChar());
+		item->setText(0, mTempString.AsChar());
+
+		mTempString.Format("%i x %i samples (%i lookback + %i headroom) / %.2f KB", entry.mNumChannels, entry.mBufferSize, entry.mNumLookbackSamples, entry.mNumHeadroomSamples, entry.mNumBytes / 1024.0);
+		if (entry.mConsumerName.IsEmpty() == false)
+			mTempString.FormatAdd(" / read by %s", entry.mConsumerName.AsChar());
+		if (entry.mIsGrowOnly == true)
+			mTempString += " / sensor (grow only)";
+		item->setText(1, mTempString.AsChar());
+	}
+}
+
+
+// enable/disable the node profiler
+void GraphInfoWidget::OnProfilingToggled(int state)
+{
+	// takes effect with the next engine update
+	GetEngine()->GetNodeProfiler()->SetEnabled(state == Qt::Checked);
+}
+
+
+// export the recorded frames as trace event json
+void GraphInfoWidget::OnExportTrace()
+{
+	NodeProfiler* profiler = GetEngine()->GetNodeProfiler();
+	if (profiler->GetNumFrames() == 0)
+	{
+		QMessageBox::information(this, "Export Trace", "No profiling data recorded yet. Enable 'Profile Nodes' first.");
+		return;
+	}
+
+	const QString filename = QFileDialog::getSaveFileName(this, "Export Profiling Trace", "", "Trace Event JSON (*.json)");
+	if (filename.isEmpty() == true)
+		return;
+
+	if (profiler->ExportTrace(FromQtString(filename).AsChar()) == false)
+		QMessageBox::warning(this, "Export Trace", "Cannot write the trace file.");
+}
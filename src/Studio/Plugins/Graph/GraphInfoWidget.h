@@ -29,6 +29,8 @@
 #include <Core/EventHandler.h>
 #include <QWidget>
 #include <QTreeWidget>
+#include <QCheckBox>
+#include <QPushButton>
 
 // shows realtime information of the running classifier
 class GraphInfoWidget : public QWidget, public Core::EventHandler
@@ -51,6 +53,10 @@ class GraphInfoWidget : public QWidget, public Core::EventHandler
 		void OnActiveClassifierChanged(Classifier* classifier) override			{ SetClassifier(classifier); ReInit(); }
 		void OnGraphModified(Graph* graph, GraphObject* object) override		{ ReInit(); }
 	
+	private slots:
+		void OnProfilingToggled(int state);
+		void OnExportTrace();
+
 	private:
 
 		// UI elements
@@ -61,6 +67,8 @@ class GraphInfoWidget : public QWidget, public Core::EventHandler
 		QTreeWidgetItem*		mClassifierSection;				// subsection item "Classifier"
 		QTreeWidgetItem*		mInputsSection;					// subsection item "Inputs"
 		QTreeWidgetItem*		mOutputsSection;				// subsection item "Outputs"
+		QTreeWidgetItem*		mProfilingSection;				// subsection item "Profiling"
+		QTreeWidgetItem*		mBufferPlanSection;				// subsection item "Buffer Plan"
 
 		void AddClassifierSectionItems(QTreeWidget* parent);
 		void UpdateClassifierSectionItems(QTreeWidget* parent);
@@ -71,6 +79,18 @@ class GraphInfoWidget : public QWidget, public Core::EventHandler
 		void AddOutputsSectionItems(QTreeWidgetItem* parent);
 		void UpdateOutputsSectionItems(QTreeWidgetItem* parent);
 
+		// per node profiling results, sorted by exclusive time and colored as a heatmap
+		void UpdateProfilingSectionItems(QTreeWidgetItem* parent);
+
+		QCheckBox*				mProfilingCheckbox;
+		QPushButton*			mExportTraceButton;
+		Core::Array<Node*>		mProfiledNodes;
+
+		// planned output buffer sizes, largest first
+		void UpdateBufferPlanSectionItems(QTreeWidgetItem* parent);
+
+		Core::Array<uint32>		mBufferPlanOrder;
+
 
 		// helpers
 		Core::String			mTempString;
@@ -123,6 +123,9 @@ GraphWidget::~GraphWidget()
 
 void GraphWidget::paintGL()
 {
+	// the graph is rendered straight from the engine objects
+	EngineThread::LockScope lockScope;
+
 	GetQtBaseManager()->GetMainWindow()->GetOpenGLFpsCounter().UnPause();
 
 	mFpsCounter.BeginTiming();
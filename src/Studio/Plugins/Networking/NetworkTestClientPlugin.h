@@ -63,7 +63,8 @@ class NetworkTestClientPlugin : public Plugin
 		void UpdateInterface() override;
 
 		// log one line to the console textedit (used by log callback)
-		void LogLine( const char* text )												{ if (mLogOutput != NULL) mLogOutput->append( text ); }
+		// NOTE: may be called from the log thread, the line is appended on the UI thread
+		void LogLine( const char* text )												{ if (mLogOutput != NULL) QMetaObject::invokeMethod( mLogOutput, "append", Qt::AutoConnection, Q_ARG(QString, text) ); }
 
 		// resize message and update timestamp
 		void PreparePacket(bool resize=false);
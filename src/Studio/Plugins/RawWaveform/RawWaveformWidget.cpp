@@ -26,6 +26,7 @@
 #include "RawWaveformPlugin.h"
 #include <Core/LogManager.h>
 #include <ColorPalette.h>
+#include <EngineThread.h>
 #include "../../Rendering/OpenGLWidget2DHelpers.h"
 #include <QPainter>
 
@@ -179,18 +180,11 @@ void RawWaveformWidget::RenderCallback::Render(BciDevice* headset, Sensor* senso
 	const double xStart	= 0;
 	const double xEnd	= windowWidth;
 
-	// render the grid
-	RenderGrid(numVisibleSensors, (uint32)numVerticalDivs, waveCellHeight, xStart, xEnd, windowHeight, mGridColor, mGridSubColor, timeRange, elapsedTime);
-
-	// return directly after rendering the grid in case there is no neuro headset
-	if (headset == NULL)
-		return;
-
 	// get the sensor index whose checkbox is on mouse overed
 	const uint32 highlightedSensorIndex = channelSelectionWidget->GetHighlightedIndex();
-	uint32 numActuallyRendered = 0;
 
-	// get the number of sensors and iterate through them
+	// collect the visible waves while the engine is locked
+	uint32 numWaves = 0;
 	for (uint32 i = 0; i < numSensors; ++i)
 	{
 		// get the current sensor and skip it in case it is no valid neuro sensor
@@ -207,23 +201,51 @@ void RawWaveformWidget::RenderCallback::Render(BciDevice* headset, Sensor* senso
 		if (channel->IsEmpty() == true)
 			continue;
 
+		if (numWaves == mWaves.Size())
+			mWaves.AddEmpty();
+
+		// the snapshot has to hold all samples within the time range
+		const uint32 maxNumSamples = (uint32)(timeRange * channel->GetSampleRate()) + 2;
+
+		Wave& wave = mWaves[numWaves++];
+		wave.mSnapshot		= mSnapshots.Get(channel, maxNumSamples);
+		wave.mName			= channel->GetName();
+		wave.mColor			= channel->GetColor();
+		wave.mIsHighlighted	= channel->IsHighlighted();
+		wave.mSensorIndex	= i;
+	}
+
+	mSnapshots.ReleaseUnused();
+
+	// from here on only the snapshots are accessed, so the engine thread can keep running while we render
+	EngineThread::YieldScope yieldScope;
+
+	// render the grid
+	RenderGrid(numVisibleSensors, (uint32)numVerticalDivs, waveCellHeight, xStart, xEnd, windowHeight, mGridColor, mGridSubColor, timeRange, elapsedTime);
+
+	for (uint32 i = 0; i < numWaves; ++i)
+	{
+		Wave& wave = mWaves[i];
+
 		// calculate the row offset so that we don't render the waves all over each other but distribute them nicely over the screen
-		double yOffset = numActuallyRendered * waveCellHeight + gridSpacing * numVerticalDivs / 2.0;
-		numActuallyRendered++;
+		double yOffset = i * waveCellHeight + gridSpacing * numVerticalDivs / 2.0;
+
+		// copy the samples published by the engine
+		if (wave.mSnapshot->Read(wave.mFrame) == false || wave.mFrame.IsEmpty() == true)
+			continue;
 
 		// absolute value range that must fit in wave cell, calculated from units/division
 		const double amplitudeScale = settingsAmplitudeScale * numVerticalDivs;
 
-
 		// render the signal
 		const double circleLeftShift = 10;
-		RenderWave2D(channel, useAutoScale, amplitudeScale, timeRange, waveCellHeight, yOffset, xStart, xEnd - circleLeftShift, windowHeight);
+		RenderWave2D(wave.mFrame, wave.mColor, useAutoScale, amplitudeScale, timeRange, waveCellHeight, yOffset, xStart, xEnd - circleLeftShift, windowHeight);
 
 		// highlight the wave in case:
 		// 1. the checkbox is hovered
 		// 2. the channel highlight flag is set
 		// 3. the mouse is inside the corresponding wave cell
-		if (highlightedSensorIndex == i || channel->IsHighlighted() == true ||
+		if (highlightedSensorIndex == wave.mSensorIndex || wave.mIsHighlighted == true ||
 			(localCursorPos.x() >= 0 && localCursorPos.x() < windowWidth && (localCursorPos.y() > yOffset - 0.5f * waveCellHeight) && (localCursorPos.y() < yOffset + 0.5f * waveCellHeight)))
 			RenderLines(2.0 * mLineWidth);
 		else
@@ -233,18 +255,15 @@ void RawWaveformWidget::RenderCallback::Render(BciDevice* headset, Sensor* senso
 		if (showSignalName == true)
 		{ 
 			// draw the value of the last sample
-			RenderText( channel->GetName(), mParent->GetDefaultFontSize(), channel->GetColor(), 5, yOffset, OpenGLWidget::ALIGN_BOTTOM | OpenGLWidget::ALIGN_LEFT);
+			RenderText( wave.mName.AsChar(), mParent->GetDefaultFontSize(), wave.mColor, 5, yOffset, OpenGLWidget::ALIGN_BOTTOM | OpenGLWidget::ALIGN_LEFT);
 		}
 
 		// render voltage
 		if (showVoltages == true)
 		{ 
 			// draw the value of the last sample
-			if (channel->GetNumSamples() > 0)
-			{
-				mTempString.Format("%.2f uV", channel->GetLastSample());
-				RenderText( mTempString.AsChar(), mParent->GetDefaultFontSize(), mTextColor, windowWidth, yOffset, OpenGLWidget::ALIGN_BOTTOM | OpenGLWidget::ALIGN_RIGHT );
-			}
+			mTempString.Format("%.2f uV", wave.mFrame.GetLastSample());
+			RenderText( mTempString.AsChar(), mParent->GetDefaultFontSize(), mTextColor, windowWidth, yOffset, OpenGLWidget::ALIGN_BOTTOM | OpenGLWidget::ALIGN_RIGHT );
 		}
 	}
 
@@ -255,7 +274,7 @@ void RawWaveformWidget::RenderCallback::Render(BciDevice* headset, Sensor* senso
 
 
 // render 2D wave for the given channel										   
-void RawWaveformWidget::RenderCallback::RenderWave2D(Channel<double>* channel, bool useAutoScale, double amplitudeScale, double timeRange, double height, double yCenter, double xStart, double xEnd, double windowHeight)
+void RawWaveformWidget::RenderCallback::RenderWave2D(const ChannelSnapshot::Frame& frame, const Color& color, bool useAutoScale, double amplitudeScale, double timeRange, double height, double yCenter, double xStart, double xEnd, double windowHeight)
 {
 	//const int32 xStartPixel = xStart;
 	//const int32 xEndPixel = xEnd - 10; // TODO: because of the circle so that we see the latest sample being added at that point
@@ -353,23 +372,21 @@ void RawWaveformWidget::RenderCallback::RenderWave2D(Channel<double>* channel, b
 	////RenderText( mTempString, ToQColor(sensorColor), QPoint( (windowWidth - 81), textPosY ) );
 
 	// draw only if the parameters are valid 
-	if (channel == NULL || xEnd < xStart)
+	if (xEnd < xStart)
 		return;
 
 	// FIXME drawing should also work with a single sample (e.g. very low sample rate)
-	if (channel->GetNumSamples() == 0)
+	if (frame.IsEmpty() == true)
 		return;
 
-	//const double sampleRate = channel->GetSampleRate();
-
 	// calc remaining parameters
-	const uint32	maxSampleIndex	= channel->GetMaxSampleIndex();			// index of last sample
+	const uint64	maxSampleIndex	= frame.GetMaxSampleIndex();				// index of last sample
 
-	const double	maxTime			= channel->GetElapsedTime().InSeconds();
+	const double	maxTime			= frame.GetElapsedTime();
 	//const int32		numPixels		= xEnd - xStart;							// width of the chart area in pixels
 
 	double			minTime			= maxTime - timeRange;						// time of first pixel
-	uint32			minSampleIndex	= channel->FindIndexByTime(minTime);		// index of first sample (clamped to valid index and rounded downwards -> may lie outside of left border)
+	uint64			minSampleIndex	= frame.FindIndexByTime(minTime);			// index of first sample (clamped to valid index and rounded downwards -> may lie outside of left border)
 
 	CORE_ASSERT(maxSampleIndex >= minSampleIndex);
 
@@ -378,12 +395,12 @@ void RawWaveformWidget::RenderCallback::RenderWave2D(Channel<double>* channel, b
 	double rawMax = -DBL_MAX;
 	double mean = 0;
 	uint32 numVals = 0;
-	for (uint32 i=minSampleIndex; i<=maxSampleIndex; ++i)
+	for (uint64 i=minSampleIndex; i<=maxSampleIndex; ++i)
 	{
-		double* rawValue = channel->GetSampleRef(i);
-		rawMin = (*rawValue) < rawMin ? (*rawValue) : rawMin;
-		rawMax = (*rawValue) > rawMax ? (*rawValue) : rawMax;
-		mean += (*rawValue);
+		const double rawValue = frame.GetSample(i);
+		rawMin = rawValue < rawMin ? rawValue : rawMin;
+		rawMax = rawValue > rawMax ? rawValue : rawMax;
+		mean += rawValue;
 		numVals++;
 	}
 	if (numVals != 0)
@@ -413,7 +430,6 @@ void RawWaveformWidget::RenderCallback::RenderWave2D(Channel<double>* channel, b
 	double previousX, previousY;
 
 	// color range
-	const Color& color = channel->GetColor();
 	Color lighterColor = FromQtColor( ToQColor(color).lighter(110) );
 	Color darkerColor = FromQtColor( ToQColor(color).darker(170) );
 	Color previousColor, valueColor;		// color of the pixel at the value position, interpolated between lighter/darker color
@@ -426,13 +442,13 @@ void RawWaveformWidget::RenderCallback::RenderWave2D(Channel<double>* channel, b
 	////
 	{ // modified copy of loop body of 2)
 		// get time of the sample at minSampleIndex-1 (which may lie outside of the drawing area)
-		time = channel->GetSampleTime(minSampleIndex).InSeconds() - 1.0 / channel->GetSampleRate();
+		time = frame.GetSampleTime(minSampleIndex) - 1.0 / frame.GetSampleRate();
 
 		// map time to pixel x-coordinate
 		previousX = RemapRange(time, minTime, maxTime, xStart,  xEnd);
 
 		// clamp and remap value to y coordinate
-		value = channel->GetSample(minSampleIndex);
+		value = frame.GetSample(minSampleIndex);
 		previousY = yCenter + valueScale * (value - mean);
 
 		// calculate the color for the top point (value) of the line
@@ -446,16 +462,16 @@ void RawWaveformWidget::RenderCallback::RenderWave2D(Channel<double>* channel, b
 
 	//////////////////////////////////////////////////////////////////
 	// 1) draw all middle samples
-	for (uint32 i = minSampleIndex; i <= maxSampleIndex; i++)
+	for (uint64 i = minSampleIndex; i <= maxSampleIndex; i++)
 	{
 		// get time of sample
-		time = channel->GetSampleTime(i).InSeconds();
+		time = frame.GetSampleTime(i);
 
 		// map time to pixel x-coordinate
 		x = RemapRange(time, minTime, maxTime, xStart,  xEnd);
 
 		// clamp and remap value to y coordinate
-		value = channel->GetSample(i);
+		value = frame.GetSample(i);
 		y = yCenter + valueScale * (value - mean);
 
 		// FIX due to antialiasing problems : round the coords to int and add the twiddle factor
@@ -28,6 +28,7 @@
 #include "../../Config.h"
 #include "../../Rendering/OpenGLWidget.h"
 #include <BciDevice.h>
+#include <ChannelSnapshotManager.h>
 
 
 // forward declaration
@@ -53,7 +54,7 @@ class RawWaveformWidget : public OpenGLWidget
 
 				// waveform
 				void Render(BciDevice* headset, Sensor* sensor, double windowWidth, double windowHeight);
-				void RenderWave2D(Channel<double>* channel, bool useAutoScale, double amplitudeScale, double timeRange, double height, double yCenter, double xStart, double xEnd, double windowHeight);
+				void RenderWave2D(const ChannelSnapshot::Frame& frame, const Core::Color& color, bool useAutoScale, double amplitudeScale, double timeRange, double height, double yCenter, double xStart, double xEnd, double windowHeight);
 				void Render2DCircle(double posX, double posY, double radius, uint32 numSteps, const Core::Color& color);
 
 				// grid
@@ -63,9 +64,23 @@ class RawWaveformWidget : public OpenGLWidget
 				void RenderTimeAxis(uint32 xEnd, uint32 xStart, uint32 windowHeight, double maxTime, double timeRange);
 
 			private:
+				// a visible wave, collected while the engine is locked and rendered from the channel snapshot afterwards
+				struct Wave
+				{
+					ChannelSnapshot*		mSnapshot;
+					ChannelSnapshot::Frame	mFrame;
+					Core::String			mName;
+					Core::Color				mColor;
+					bool					mIsHighlighted;
+					uint32					mSensorIndex;
+				};
+
 				RawWaveformWidget*	mParent;
 				Core::String		mTempString;
 
+				ChannelSnapshotSet	mSnapshots;
+				Core::Array<Wave>	mWaves;				// only grows, so the frame buffers are reused
+
 				// style
 				float				mLineWidth;
 				Core::Color		mTextColor;
@@ -250,6 +250,16 @@ void SpectrogramBandsPlugin::ChannelBandsDataProxy::Update()
 	mMinValue = DBL_MAX;
 	mMaxValue = -DBL_MAX;
 
+	// sync the band plan with the configured frequency bands (only invalidates the bin ranges if a band changed)
+	const uint32 numBands = GetNumBins();
+	mBandPlan.SetNumBands(numBands);
+	for (uint32 b = 0; b < numBands; b++)
+	{
+		FrequencyBand* band = settings->GetFrequencyBand(b);
+		mBandPlan.SetBand(b, band->GetMinFrequency(), band->GetMaxFrequency());
+	}
+	mBandValues.Resize(numBands);
+
 	// copy over the spectrum magnitudes of each channel and find the min/max values
 	for (int c = 0; c < numChannels; c++)
 	{
@@ -263,17 +273,16 @@ void SpectrogramBandsPlugin::ChannelBandsDataProxy::Update()
 
 		QBarDataRow* row = mData->at(c);
 		
-		// calculate magnitude for each band in the channel
+		// calculate the magnitudes of all bands in the channel at once
+		mBandPlan.Calc(spectrum, BandPlan::VALUE_MAGNITUDE, mBandValues.GetPtr());
+
 		float bandMagnitude;
-		const uint32 numBins = GetNumBins();
-		for (uint32 b = 0; b < GetNumBins(); b++)
+		for (uint32 b = 0; b < numBands; b++)
 		{
-			FrequencyBand* band = GetEngine()->GetSpectrumAnalyzerSettings()->GetFrequencyBand(b);
-
 			if (mConvertToDezibel == true)
-				bandMagnitude = spectrum->GetFrequencyDecibels(band->CalcMagnitude(spectrum) / numBins);
+				bandMagnitude = spectrum->GetFrequencyDecibels(mBandValues[b] / numBands);
 			else
-				bandMagnitude = band->CalcMagnitude(spectrum) / numBins;
+				bandMagnitude = mBandValues[b] / numBands;
 
 			(*row)[b].setValue(bandMagnitude);
 
@@ -31,6 +31,7 @@
 #include <Core/String.h>
 #include <Sensor.h>
 #include <DSP/FFTProcessor.h>
+#include <DSP/BandPlan.h>
 
 #ifdef USE_QTDATAVISUALIZATION
 
@@ -86,6 +87,8 @@ class SpectrogramBandsPlugin : public SpectrogramPlugin
 			uint32								mNumBins;			// number of frequency bins (size of mesh in frequency direction)
 			uint32								mNumShiftSamples;			
 			uint32								mWindowFunctionType;		
+			BandPlan							mBandPlan;			// all frequency bands of the spectrum analyzer settings
+			Core::Array<double>					mBandValues;
 
 	};
 
@@ -28,6 +28,7 @@
 #include <Core/LogManager.h>
 #include <Core/EventManager.h>
 #include <EngineManager.h>
+#include <EngineThread.h>
 #include "../../Rendering/OpenGLWidget2DHelpers.h"
 #include <QPainter>
 #include <ColorPalette.h>
@@ -112,6 +113,9 @@ void ViewWidget::paintGL()
 
 	RenderSplitViews(numMultiChannels);
 
+	// release the snapshots of channels that are not displayed anymore
+	mSnapshots.ReleaseUnused();
+
 	// post rendering
 	PostRendering();
 }
@@ -180,6 +184,37 @@ void ViewWidget::RenderCallback::Render(uint32 index, bool isHighlighted, double
 	
 	bool drawLatencyMarker = plugin->GetShowLatencyMarker();
 
+	// collect the displayed channels and their legend while the engine is locked
+	const uint32 numChannels = channels.GetNumChannels();
+	if (mCharts.Size() < numChannels)
+		mCharts.Resize(numChannels);
+
+	for (uint32 i=0; i<numChannels; ++i )
+	{
+		Channel<double>* channel = channels.GetChannel(i)->AsType<double>();
+
+		// the snapshot has to hold all samples within the time range
+		const uint32 maxNumSamples = (uint32)(timeRange * channel->GetSampleRate()) + 2;
+
+		Chart& chart = mCharts[i];
+		chart.mSnapshot	= mViewWidget->mSnapshots.Get(channel, maxNumSamples);
+		chart.mColor	= mViewWidget->mPlugin->GetChannelColor(index, i);
+	}
+
+	// FIXME: for multichannels, we have to render the whole legend for all signals in the set including name and color, not just only the text name
+	mLegend.Clear();
+	if (numChannels > 0)
+	{
+		Channel<double>* channel = channels.GetChannel(0)->AsType<double>();
+		if (channel->GetSourceNameString().IsEmpty() == false)
+			mLegend.Format("%s - %s", channel->GetSourceName(), channel->GetName());
+		else
+			mLegend.Format("%s", channel->GetName());
+	}
+
+	// from here on only the snapshots are accessed, so the engine thread can keep running while we render
+	EngineThread::YieldScope yieldScope;
+
 	// RENDER CHART
 
 	// draw horizontal line (only) grid
@@ -192,12 +227,14 @@ void ViewWidget::RenderCallback::Render(uint32 index, bool isHighlighted, double
 	// render the multichannel signals
 	const OpenGLWidget2DHelpers::EChartRenderStyle style = (OpenGLWidget2DHelpers::EChartRenderStyle)plugin->GetSampleStyle();
 
-	const uint32 numChannels = channels.GetNumChannels();
 	for (uint32 i=0; i<numChannels; ++i )
 	{
-		Channel<double>* channel = channels.GetChannel(i)->AsType<double>();
-		const Color& color = mViewWidget->mPlugin->GetChannelColor(index, i);
-		OpenGLWidget2DHelpers::RenderChart( this, channel, color, style, timeRange, maxTime, rangeMin, rangeMax, areaStartX, width, height, height,  drawLatencyMarker);
+		// copy the samples published by the engine
+		Chart& chart = mCharts[i];
+		if (chart.mSnapshot->Read(chart.mFrame) == false)
+			continue;
+
+		OpenGLWidget2DHelpers::RenderChart( this, chart.mFrame, chart.mColor, style, timeRange, maxTime, rangeMin, rangeMax, areaStartX, width, height, height,  drawLatencyMarker);
 	}
 
 	// Now Render all lines at once
@@ -233,17 +270,8 @@ void ViewWidget::RenderCallback::Render(uint32 index, bool isHighlighted, double
 	}
 
 
-	if (numChannels > 0)
-	{
-		// FIXME: for multichannels, we have to render the whole legend for all signals in the set including name and color, not just only the text name
-		Channel<double>* channel = channels.GetChannel(0)->AsType<double>();
-		if (channel->GetSourceNameString().IsEmpty() == false)
-			mTempString.Format("%s - %s", channel->GetSourceName(), channel->GetName());
-		else
-			mTempString.Format("%s", channel->GetName());
-
-		RenderText( mTempString.AsChar(), GetOpenGLWidget()->GetDefaultFontSize(), channelLabelColor, areaStartX+textMargin, 0, OpenGLWidget::ALIGN_TOP | OpenGLWidget::ALIGN_LEFT );
-	}
+	if (mLegend.IsEmpty() == false)
+		RenderText( mLegend.AsChar(), GetOpenGLWidget()->GetDefaultFontSize(), channelLabelColor, areaStartX+textMargin, 0, OpenGLWidget::ALIGN_TOP | OpenGLWidget::ALIGN_LEFT );
 }
 
 
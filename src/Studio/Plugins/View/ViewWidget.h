@@ -29,6 +29,7 @@
 #include <DSP/Channel.h>
 #include <Graph/Classifier.h>
 #include "../../Rendering/OpenGLWidget.h"
+#include <ChannelSnapshotManager.h>
 
 
 // forward declaration
@@ -55,8 +56,18 @@ class ViewWidget : public OpenGLWidget
 				void RenderTimeline(double x, double y, double width, double height) override;
 
 			private:
-				ViewWidget*		mViewWidget;
-				Core::String	mTempString;
+				// a displayed channel, collected while the engine is locked and rendered from the channel snapshot afterwards
+				struct Chart
+				{
+					ChannelSnapshot*		mSnapshot;
+					ChannelSnapshot::Frame	mFrame;
+					Core::Color				mColor;
+				};
+
+				ViewWidget*					mViewWidget;
+				Core::String				mTempString;
+				Core::String				mLegend;
+				Core::Array<Chart>			mCharts;
 		};
 
 		friend class RenderCallback;
@@ -64,6 +75,7 @@ class ViewWidget : public OpenGLWidget
 		ViewPlugin*			mPlugin;
 		RenderCallback*		mRenderCallback;
 		double				mLeftTextWidth;
+		ChannelSnapshotSet	mSnapshots;
 };
 
 
@@ -206,6 +206,14 @@ void OpenGLWidget::resizeGL(int width, int height)
 }
 
 
+// paint events are delivered without the engine lock, but the widgets render engine state
+void OpenGLWidget::paintEvent(QPaintEvent* event)
+{
+	EngineThread::LockScope lockScope;
+	QOpenGLWidget::paintEvent(event);
+}
+
+
 // called when the mouse moved
 void OpenGLWidget::mouseMoveEvent(QMouseEvent* event)
 {
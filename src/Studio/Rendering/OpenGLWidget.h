@@ -97,6 +97,9 @@ class OpenGLWidget : public QOpenGLWidget, protected QOpenGLFunctions
 		void ResetPerformanceStatsPos();
 
 	protected:
+		// locks the engine around paintGL() of the derived widgets
+		void paintEvent(QPaintEvent* event) override;
+
 		// input handling
 		void mouseMoveEvent(QMouseEvent* event) override;
 		void mousePressEvent(QMouseEvent* event) override;
@@ -248,27 +248,44 @@ void OpenGLWidget2DHelpers::AutoCalcChartSplits(double height, uint32* outNumSpl
 }
 
 
-// render a channel
-void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<double>* channel, const Color& color, EChartRenderStyle style, double timeRange, double maxTime, double rangeMin, double rangeMax, int32 xStart, int32 xEnd, int32 yStart, int32 height, bool drawLatencyMarker)
+// uniform sample access for RenderChartSamples()
+class ChannelChartSource
+{
+	public:
+		ChannelChartSource(Channel<double>* channel) : mChannel(channel)		{}
+		uint64 GetNumSamples() const											{ return mChannel->GetNumSamples(); }
+		double GetSampleRate() const											{ return mChannel->GetSampleRate(); }
+		double GetLatency() const												{ return mChannel->GetLatency(); }
+		uint64 GetMaxSampleIndex() const										{ return mChannel->GetMaxSampleIndex(); }
+		uint64 FindIndexByTime(double time) const								{ return mChannel->FindIndexByTime(time); }
+		double GetSampleTime(uint64 index) const								{ return mChannel->GetSampleTime(index).InSeconds(); }
+		double GetSample(uint64 index) const									{ return mChannel->GetSample(index); }
+
+	private:
+		Channel<double>* mChannel;
+};
+
+
+// render the samples of a channel or of a channel snapshot
+template <class SOURCE>
+void OpenGLWidget2DHelpers::RenderChartSamples(OpenGLWidgetCallback* callback, const SOURCE& source, const Color& color, EChartRenderStyle style, double timeRange, double maxTime, double rangeMin, double rangeMax, int32 xStart, int32 xEnd, int32 yStart, int32 height, bool drawLatencyMarker)
 {
 	// draw only if the parameters are valid 
-	if (channel == NULL || xEnd < xStart)
+	if (xEnd < xStart)
 		return;
 
-	if (channel->GetNumSamples() == 0 || channel->GetSampleRate() <= 0)
+	if (source.GetNumSamples() == 0 || source.GetSampleRate() <= 0)
 		return;
 
 	//
 	// Sample / Pixel / Timeranges
 	//
 
-	//const double sampleRate = channel->GetSampleRate();
-
 	// calc remaining parameters
 	//const int32 numPixels = xEnd - xStart;					// width of the chart area in pixels
 	double minTime = maxTime - timeRange;						// time of first pixel
-	const uint32 maxSampleIndex = channel->GetMaxSampleIndex();	// index of last sample
-	uint32 minSampleIndex = channel->FindIndexByTime(minTime);	// index of first sample (clamped to valid index and rounded downwards -> may lie outside of left border)
+	const uint64 maxSampleIndex = source.GetMaxSampleIndex();	// index of last sample
+	uint64 minSampleIndex = source.FindIndexByTime(minTime);	// index of first sample (clamped to valid index and rounded downwards -> may lie outside of left border)
 
 	CORE_ASSERT(maxSampleIndex >= minSampleIndex);
 
@@ -276,7 +293,7 @@ void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<
 	//
 	// Latency calculations for latency marker and clipping
 	//
-	const double latency = channel->GetLatency();
+	const double latency = source.GetLatency();
 	uint32 markerX = xEnd;
 	uint32 xClippingEnd = xEnd; // place clip edge to the most right by default
 	if (latency != 0 && drawLatencyMarker == true)
@@ -302,8 +319,8 @@ void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<
 	double previousX, previousY;
 
 	// sample size
-	const uint32 numSamples = maxSampleIndex - minSampleIndex;
-	const double displayedTimeRange = numSamples / channel->GetSampleRate();
+	const uint32 numSamples = (uint32)(maxSampleIndex - minSampleIndex);
+	const double displayedTimeRange = numSamples / source.GetSampleRate();
 	const double usedPixels = displayedTimeRange * (xEnd - xStart) / timeRange;
 	double size = GetSampleSize(style, usedPixels, height, numSamples);
 
@@ -317,13 +334,13 @@ void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<
 	////
 	{ // modified copy of loop body of 2)
 		// get time of the sample at minSampleIndex-1 (which may lie outside of the drawing area)
-		time = channel->GetSampleTime(minSampleIndex).InSeconds() - 1.0 / channel->GetSampleRate();
+		time = source.GetSampleTime(minSampleIndex) - 1.0 / source.GetSampleRate();
 
 		// map time to pixel x-coordinate
 		previousX = RemapRange(time, minTime, maxTime, xStart,  xEnd);
 
 		// clamp and remap value to y coordinate
-		value = channel->GetSample(minSampleIndex);
+		value = source.GetSample(minSampleIndex);
 		previousY = ClampedRemapRange(value, rangeMin, rangeMax, yStart, 0);
 
 		// FIX due to antialiasing problems : round the coords to int and add the twiddle factor
@@ -333,17 +350,17 @@ void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<
 
 	//////////////////////////////////////////////////////////////////
 	// 1) draw the first two visible sample 
-	for (uint32 i=minSampleIndex; (i < minSampleIndex + 2) && (i <= maxSampleIndex); ++i)
+	for (uint64 i=minSampleIndex; (i < minSampleIndex + 2) && (i <= maxSampleIndex); ++i)
 	{ // copy of loop body of 2)
 		
 		// get time of sample
-		time = channel->GetSampleTime(i).InSeconds();
+		time = source.GetSampleTime(i);
 
 		// map time to pixel x-coordinate
 		x = RemapRange(time, minTime, maxTime, xStart,  xEnd);
 
 		// clamp and remap value to y coordinate
-		value = channel->GetSample(i);
+		value = source.GetSample(i);
 		y = ClampedRemapRange(value, rangeMin, rangeMax, yStart, 0);
 
 		y = (int32)y + 0.375;
@@ -363,10 +380,10 @@ void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<
 	//////////////////////////////////////////////////////////////////
 	// 2) draw all middle samples
 	if (maxSampleIndex > 0)
-	for (uint32 i = minSampleIndex + 2; i < maxSampleIndex-1; i++)
+	for (uint64 i = minSampleIndex + 2; i < maxSampleIndex-1; i++)
 	{
 		// get time of sample
-		time = channel->GetSampleTime(i).InSeconds();
+		time = source.GetSampleTime(i);
 
 		// map time to pixel x-coordinate
 		x = RemapRange(time, minTime, maxTime, xStart,  xEnd);
@@ -376,7 +393,7 @@ void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<
 			break;
 
 		// clamp and remap value to y coordinate
-		value = channel->GetSample(i);
+		value = source.GetSample(i);
 		y = ClampedRemapRange(value, rangeMin, rangeMax, yStart, 0);
 
 		y = (int32)y + 0.375;
@@ -398,17 +415,17 @@ void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<
 	//////////////////////////////////////////////////////////////////
 	// 3) draw the last sample clipped (mostly a copy of loop body)
 	if (maxSampleIndex > 0)
-	for (uint32 i = maxSampleIndex-1; i <= maxSampleIndex; i++)
+	for (uint64 i = maxSampleIndex-1; i <= maxSampleIndex; i++)
 	{ // copy of loop body of 2)
 
 		// get time of very first sample (which lies outside of the drawing area)
-		time = channel->GetSampleTime(i).InSeconds();
+		time = source.GetSampleTime(i);
 
 		// map time to pixel x-coordinate
 		x = RemapRange(time, minTime, maxTime, xStart,  xEnd);
 
 		// clamp and remap value to y coordinate
-		value = channel->GetSample(i);
+		value = source.GetSample(i);
 		y = ClampedRemapRange(value, rangeMin, rangeMax, yStart, 0);
 
 		y = (int32)y + 0.375;
@@ -440,6 +457,23 @@ void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<
 }
 
 
+// render a channel
+void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, Channel<double>* channel, const Color& color, EChartRenderStyle style, double timeRange, double maxTime, double rangeMin, double rangeMax, int32 xStart, int32 xEnd, int32 yStart, int32 height, bool drawLatencyMarker)
+{
+	if (channel == NULL)
+		return;
+
+	RenderChartSamples(callback, ChannelChartSource(channel), color, style, timeRange, maxTime, rangeMin, rangeMax, xStart, xEnd, yStart, height, drawLatencyMarker);
+}
+
+
+// render a channel snapshot
+void OpenGLWidget2DHelpers::RenderChart(OpenGLWidgetCallback* callback, const ChannelSnapshot::Frame& frame, const Color& color, EChartRenderStyle style, double timeRange, double maxTime, double rangeMin, double rangeMax, int32 xStart, int32 xEnd, int32 yStart, int32 height, bool drawLatencyMarker)
+{
+	RenderChartSamples(callback, frame, color, style, timeRange, maxTime, rangeMin, rangeMax, xStart, xEnd, yStart, height, drawLatencyMarker);
+}
+
+
 
 //
 //// render 2D wave for the given channel										   
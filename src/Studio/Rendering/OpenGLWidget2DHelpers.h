@@ -26,6 +26,7 @@
 
 #include "../Config.h"
 #include "OpenGLWidget.h"
+#include <DSP/ChannelSnapshot.h>
 
 
 class OpenGLWidget2DHelpers
@@ -64,6 +65,7 @@ class OpenGLWidget2DHelpers
 		// NOTE: used for feedback plugin
 		static void AutoCalcChartSplits(double height, uint32* outNumSplits, uint32* outNumSubSplits);
 		static void RenderChart(OpenGLWidgetCallback* callback, Channel<double>* channel, const Core::Color& color, EChartRenderStyle style, double timeRange, double maxTime, double rangeMin, double rangeMax, int32 xStart, int32 xEnd, int32 yStart, int32 height, bool drawLatencyMarker = false);
+		static void RenderChart(OpenGLWidgetCallback* callback, const ChannelSnapshot::Frame& frame, const Core::Color& color, EChartRenderStyle style, double timeRange, double maxTime, double rangeMin, double rangeMax, int32 xStart, int32 xEnd, int32 yStart, int32 height, bool drawLatencyMarker = false);
 		
 		// sample render functions
 		typedef void (CORE_CDECL *RenderSampleFunction)(OpenGLWidgetCallback* callback, double value, double xPos, double yPos, double previousXPos, double previousYPos, double xStart, double xEnd, double yStart, double yEnd, double size, const Core::Color& lighterColor, Core::Color& darkerColor, Core::Color& valueColor);
@@ -93,6 +95,10 @@ class OpenGLWidget2DHelpers
 
 	private:
 		static RenderSampleFunction SelectSampleRenderFunction(EChartRenderStyle style, bool clipped = false);
+
+		// shared implementation of the RenderChart() overloads
+		template <class SOURCE>
+		static void RenderChartSamples(OpenGLWidgetCallback* callback, const SOURCE& source, const Core::Color& color, EChartRenderStyle style, double timeRange, double maxTime, double rangeMin, double rangeMax, int32 xStart, int32 xEnd, int32 yStart, int32 height, bool drawLatencyMarker);
 };
 
 
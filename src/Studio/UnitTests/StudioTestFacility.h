@@ -26,12 +26,17 @@
 
 #include <Core/TestFacility.h>
 #include <Core/Test.h>
+#include "WebDataCacheTest.h"
 
 
+// all studio tests (run them by starting the studio with -unittests)
 class StudioTestFacility : public TestFacility
 {
 	public:
-		StudioTestFacility() : TestFacility("Studio") {}
+		StudioTestFacility() : TestFacility("Studio")
+		{
+			AddTest( new WebDataCacheTest() );
+		}
 		virtual ~StudioTestFacility() {}
 
 		// add all testsuites
@@ -0,0 +1,249 @@
+/****************************************************************************
+**
+** Copyright 2019 neuromore co
+** Contact: https://neuromore.com/contact
+**
+** Commercial License Usage
+** Licensees holding valid commercial neuromore licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and neuromore. For licensing terms
+** and conditions see https://neuromore.com/licensing. For further
+** information use the contact form at https://neuromore.com/contact.
+**
+** neuromore Public License Usage
+** Alternatively, this file may be used under the terms of the neuromore
+** Public License version 1 as published by neuromore co with exceptions as 
+** appearing in the file neuromore-class-exception.md included in the 
+** packaging of this file. Please review the following information to 
+** ensure the neuromore Public License requirements will be met: 
+** https://neuromore.com/npl
+**
+****************************************************************************/
+
+// include required headers
+#include "WebDataCacheTest.h"
+#include <QtBaseManager.h>
+#include <Backend/WebDataCache.h>
+#include <Backend/NetworkAccessManager.h>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QNetworkAccessManager>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTimer>
+#include <QDir>
+#include <functional>
+
+using namespace Core;
+
+
+// minimal http server on localhost: passes every complete request header to the handler which answers it on the socket
+class StubHttpServer
+{
+	public:
+		typedef std::function<void(QTcpSocket* socket, const QByteArray& header)> Handler;
+
+		StubHttpServer(const Handler& handler) : mHandler(handler)
+		{
+			QObject::connect( &mServer, &QTcpServer::newConnection, [this]()
+			{
+				while (mServer.hasPendingConnections() == true)
+				{
+					QTcpSocket* socket = mServer.nextPendingConnection();
+					QObject::connect( socket, &QTcpSocket::readyRead, [this, socket]()
+					{
+						// the clients don't pipeline, so there is at most one request header in the buffer
+						QByteArray& buffer = mBuffers[socket];
+						buffer += socket->readAll();
+
+						const int headerEnd = buffer.indexOf("\r\n\r\n");
+						if (headerEnd < 0)
+							return;
+
+						const QByteArray header = buffer.left(headerEnd + 4);
+						buffer.remove(0, headerEnd + 4);
+						mHandler(socket, header);
+					});
+				}
+			});
+
+			mServer.listen( QHostAddress::LocalHost );
+		}
+
+		QString GetUrl(const QString& path) const	{ return QString("http://127.0.0.1:%1/%2").arg(mServer.serverPort()).arg(path); }
+		bool IsListening() const					{ return mServer.isListening(); }
+
+		static void Respond(QTcpSocket* socket, const char* status, const QByteArray& headers, const QByteArray& body)
+		{
+			QByteArray response = QByteArray("HTTP/1.1 ") + status + "\r\n";
+			response += headers;
+			response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n\r\n";
+			response += body;
+			socket->write(response);
+		}
+
+		// case insensitive lookup of a header field value
+		static QByteArray GetHeaderField(const QByteArray& header, const char* name)
+		{
+			const QList<QByteArray> lines = header.split('\n');
+			const QByteArray prefix = QByteArray(name).toLower() + ":";
+			for (const QByteArray& line : lines)
+			{
+				if (line.toLower().startsWith(prefix) == true)
+					return line.mid(prefix.size()).trimmed();
+			}
+
+			return QByteArray();
+		}
+
+	private:
+		QTcpServer						mServer;
+		QHash<QTcpSocket*, QByteArray>	mBuffers;
+		Handler							mHandler;
+};
+
+
+// run the event loop until the condition is met or the timeout passed
+static bool WaitFor(const std::function<bool()>& condition, int timeoutInMs)
+{
+	QElapsedTimer timer;
+	timer.start();
+
+	QEventLoop loop;
+	QTimer poll;
+	QObject::connect( &poll, &QTimer::timeout, [&]()
+	{
+		if (condition() == true || timer.elapsed() > timeoutInMs)
+			loop.quit();
+	});
+
+	poll.start(10);
+	if (condition() == false)
+		loop.exec();
+
+	return condition();
+}
+
+
+// prefetch more files than the limit from one host and track how many requests are open on the server at once
+static void TestConcurrentDownloads(uint32 maxDownloadsPerHost, uint32 numFiles, uint32* outMaxOpenRequests, uint32* outNumCached)
+{
+	uint32 numOpenRequests = 0;
+	*outMaxOpenRequests = 0;
+	*outNumCached = 0;
+
+	// hold every response for a while so that the downloads overlap
+	StubHttpServer server( [&](QTcpSocket* socket, const QByteArray& header)
+	{
+		numOpenRequests++;
+		*outMaxOpenRequests = Max<uint32>(*outMaxOpenRequests, numOpenRequests);
+
+		const QByteArray path = header.split(' ').value(1);
+		QTimer::singleShot( 100, socket, [socket, path, &numOpenRequests]()
+		{
+			numOpenRequests--;
+			StubHttpServer::Respond( socket, "200 OK", "Content-Type: application/octet-stream\r\n", "content of " + path );
+		});
+	});
+
+	if (server.IsListening() == false)
+		return;
+
+	// start with an empty cache so that no file is skipped
+	const String folder = GetQtBaseManager()->GetAppDataFolder() + "UnitTests/WebDataCache/";
+	QDir(folder.AsChar()).removeRecursively();
+
+	Array<String> urls;
+	for (uint32 i=0; i<numFiles; ++i)
+		urls.Add( FromQtString(server.GetUrl(QString("file%1.bin").arg(i))) );
+
+	WebDataCache cache("UnitTests/WebDataCache/");
+	cache.SetMaxConcurrentDownloadsPerHost(maxDownloadsPerHost);
+	cache.Prefetch(urls);
+
+	WaitFor( [&]() { return cache.IsDownloading() == false; }, 10000 );
+
+	for (uint32 i=0; i<numFiles; ++i)
+	{
+		if (cache.FileExists(urls[i].AsChar()) == true)
+			(*outNumCached)++;
+	}
+}
+
+
+// fetch a file twice with the validate cache control: the second request has to be conditional and the 304 reply is answered from the disk cache
+static void TestCacheValidation(bool* outConditionalRequest, QByteArray* outBody, bool* outFromCache)
+{
+	*outConditionalRequest = false;
+	*outFromCache = false;
+
+	const QByteArray cachedBody = "cached body";
+	const QByteArray etag = "\"v1\"";
+	uint32 numRequests = 0;
+
+	StubHttpServer server( [&](QTcpSocket* socket, const QByteArray& header)
+	{
+		numRequests++;
+
+		const QByteArray ifNoneMatch = StubHttpServer::GetHeaderField(header, "If-None-Match");
+		const QByteArray ifModifiedSince = StubHttpServer::GetHeaderField(header, "If-Modified-Since");
+		if (numRequests > 1)
+			*outConditionalRequest = (ifNoneMatch == etag && ifModifiedSince.isEmpty() == false);
+
+		// no-cache: the response may be stored but has to be revalidated before each use
+		const QByteArray validators = "ETag: " + etag + "\r\nLast-Modified: Mon, 01 Jan 2018 00:00:00 GMT\r\nCache-Control: no-cache\r\n";
+		if (ifNoneMatch == etag)
+			StubHttpServer::Respond( socket, "304 Not Modified", validators, QByteArray() );
+		else
+			StubHttpServer::Respond( socket, "200 OK", validators + "Content-Type: text/plain\r\n", numRequests == 1 ? cachedBody : QByteArray("fresh body") );
+	});
+
+	if (server.IsListening() == false)
+		return;
+
+	QTemporaryDir cacheDir;
+	QNetworkAccessManager networkAccessManager;
+	QNetworkDiskCache* diskCache = new QNetworkDiskCache(&networkAccessManager);
+	diskCache->setCacheDirectory( cacheDir.path() );
+	networkAccessManager.setCache(diskCache);
+
+	for (uint32 i=0; i<2; ++i)
+	{
+		QNetworkRequest networkRequest( QUrl(server.GetUrl("data.json")) );
+		NetworkAccessManager::ConfigureCacheControl( networkRequest, Request::CACHE_VALIDATE );
+
+		QNetworkReply* reply = networkAccessManager.get(networkRequest);
+		WaitFor( [reply]() { return reply->isFinished(); }, 5000 );
+
+		*outBody		= reply->readAll();
+		*outFromCache	= reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+		reply->deleteLater();
+	}
+}
+
+
+void WebDataCacheTest::Setup()
+{
+	// concurrent downloads from one host stay within the configured limit (and actually run in parallel)
+	const uint32 maxDownloadsPerHost = 3;
+	const uint32 numFiles = 10;
+	uint32 maxOpenRequests, numCached;
+	TestConcurrentDownloads(maxDownloadsPerHost, numFiles, &maxOpenRequests, &numCached);
+
+	AssertTest( maxOpenRequests > 1 );
+	AssertTest( maxOpenRequests <= maxDownloadsPerHost );
+	AssertTest( numCached == numFiles );
+
+	// CACHE_VALIDATE revalidates with If-None-Match/If-Modified-Since and serves the cached body on a 304
+	bool conditionalRequest, fromCache;
+	QByteArray body;
+	TestCacheValidation(&conditionalRequest, &body, &fromCache);
+
+	AssertTest( conditionalRequest == true );
+	AssertTest( body == "cached body" );
+	AssertTest( fromCache == true );
+}
@@ -32,6 +32,7 @@
 #include <AutoUpdate/AutoUpdate.h>
 #include "AppManager.h"
 #include "CrashReporter.h"
+#include "UnitTests/StudioTestFacility.h"
 #include <QtPlugin>
 
 // Library Linking
@@ -297,6 +298,27 @@ int main(int argc, char *argv[])
 		return -1;
 	}
     
+	// run the unit tests that need the Qt application instead of the studio
+	for (int i=1; i<argc; ++i)
+	{
+		if (strcmp(argv[i], "-unittests") != 0)
+			continue;
+
+		bool passed;
+		{
+			StudioTestFacility facility;
+			passed = facility.Run(argc, argv);
+		}
+
+		AppInitializer::Shutdown();
+		QtBaseInitializer::Shutdown();
+		EngineInitializer::Shutdown();
+		#ifdef USE_CRASHREPORTER
+			CrashReporterShutdown();
+		#endif
+		return (passed == true ? 0 : 1);
+	}
+
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // auto updater
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////